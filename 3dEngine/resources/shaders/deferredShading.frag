@@ -21,24 +21,39 @@ uniform bool hasShadow;
 uniform bool hasAmbientOcclusion;
 uniform vec3 viewPosition;
 
-//lights and shadows:
+//sun lights and shadows:
 struct StructLightInfo{
 	bool isExist;
 	bool produceShadow;
-	bool hasParallelBeams;
-	vec3 positionOrDirection;
-	
-	float exponentialAttenuation;
+	vec3 direction;
 	vec3 lightAmbient;
 	
 	sampler2DArray shadowMapTex;
 
 	mat4 mLightProjectionView[#NUMBER_SHADOW_MAPS#];
 };
-uniform StructLightInfo lightsInfo[#MAX_LIGHTS#];
+uniform StructLightInfo lightsInfo[#MAX_SUN_LIGHTS#];
 uniform float depthSplitDistance[#NUMBER_SHADOW_MAPS#];
 uniform vec4 globalAmbient;
 
+//omnidirectional lights assigned to clusters of the view frustum:
+struct StructOmnidirectionalLight{
+	vec4 positionAndAttenuation; //xyz: position, w: exponential attenuation
+	vec4 lightAmbient;
+};
+layout(std430, binding = 0) readonly buffer OmnidirectionalLights{
+	StructOmnidirectionalLight omnidirectionalLights[];
+};
+layout(std430, binding = 1) readonly buffer LightClusters{
+	uvec2 lightClusters[]; //x: offset in light indices, y: number of lights
+};
+layout(std430, binding = 2) readonly buffer LightIndices{
+	uint lightIndices[];
+};
+uniform mat4 mView;
+uniform uvec3 clusterGridSize;
+uniform vec2 clusterDepthParams; //x: near plane, y: number of slices / log(far plane / near plane)
+
 //fog
 uniform bool hasFog;
 uniform float fogDensity;
@@ -103,6 +118,13 @@ float computeShadowContribution(int lightIndex, float depthValue, vec4 position,
 	return shadowContribution;
 }
 
+uint computeClusterIndex(vec4 position){
+	float viewDepth = -(mView * position).z;
+	uint slice = uint(clamp(log(viewDepth / clusterDepthParams.x) * clusterDepthParams.y, 0.0f, float(clusterGridSize.z - 1u)));
+	uvec2 tile = min(uvec2(textCoordinates * vec2(clusterGridSize.xy)), clusterGridSize.xy - 1u);
+	return (slice * clusterGridSize.y + tile.y) * clusterGridSize.x + tile.x;
+}
+
 vec4 addFog(vec4 baseColor, vec4 position){
     if(!hasFog || viewPosition.y > fogMaxHeight){
         return baseColor;
@@ -141,21 +163,9 @@ void main(){
 		fragColor -= vec4(ambientOcclusionFactor, ambientOcclusionFactor, ambientOcclusionFactor, 0.0f);
 	}
 
-    for(int i=0; i<#MAX_LIGHTS#;++i){
+    for(int i=0; i<#MAX_SUN_LIGHTS#;++i){
         if(lightsInfo[i].isExist){
-            vec3 vertexToLightNormalized;
-            float lightAttenuation;
-
-            if(lightsInfo[i].hasParallelBeams){ //sun light
-                vec3 vertexToLight = -lightsInfo[i].positionOrDirection;
-                vertexToLightNormalized = normalize(vertexToLight);
-                lightAttenuation = 1.0f;
-            }else{ //omnidirectional light
-                vec3 vertexToLight = lightsInfo[i].positionOrDirection - vec3(position);
-                float dist = length(vertexToLight);
-                vertexToLightNormalized = normalize(vertexToLight);
-                lightAttenuation = exp(-dist * lightsInfo[i].exponentialAttenuation);
-            }
+            vec3 vertexToLightNormalized = normalize(-lightsInfo[i].direction);
 
             float NdotL = max(dot(normal, vertexToLightNormalized), 0.0f);
             vec4 ambient = vec4(lightsInfo[i].lightAmbient, 0.0f) * modelAmbient;
@@ -165,12 +175,27 @@ void main(){
                 percentLit = computeShadowContribution(i, depthValue, position, NdotL);
             }
 
-            fragColor += lightAttenuation * (percentLit * (diffuse * NdotL) + ambient);
+            fragColor += percentLit * (diffuse * NdotL) + ambient;
         }else{
             break; //no more light
         }
     }
 
+    uvec2 lightCluster = lightClusters[computeClusterIndex(position)];
+    for(uint i=lightCluster.x; i<lightCluster.x + lightCluster.y; ++i){
+        StructOmnidirectionalLight omnidirectionalLight = omnidirectionalLights[lightIndices[i]];
+
+        vec3 vertexToLight = omnidirectionalLight.positionAndAttenuation.xyz - vec3(position);
+        float dist = length(vertexToLight);
+        vec3 vertexToLightNormalized = normalize(vertexToLight);
+        float lightAttenuation = exp(-dist * omnidirectionalLight.positionAndAttenuation.w);
+
+        float NdotL = max(dot(normal, vertexToLightNormalized), 0.0f);
+        vec4 ambient = vec4(omnidirectionalLight.lightAmbient.xyz, 0.0f) * modelAmbient;
+
+        fragColor += lightAttenuation * (diffuse * NdotL + ambient);
+    }
+
 	fragColor = addFog(fragColor, position);
 
 	//DEBUG: add color to shadow map splits
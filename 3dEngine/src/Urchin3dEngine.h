@@ -30,6 +30,8 @@
 #include "scene/GUI/widget/textbox/TextBox.h"
 #include "scene/GUI/widget/slider/Slider.h"
 
+#include "resources/MediaManager.h"
+
 #include "texture/TextureManager.h"
 
 #include "utils/shader/ShaderManager.h"
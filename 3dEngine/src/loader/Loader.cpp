@@ -1,5 +1,15 @@
+#include "loader/Loader.h"
 
 namespace urchin
 {
-	
+
+	/**
+	 * @return True when the loader can be used concurrently by several threads: it must not have any loading state and must
+	 * not use the graphic API. Thread-safe loaders are used by MediaManager to load the resources in background.
+	 */
+	bool LoaderInterface::isThreadSafe() const
+	{
+		return false;
+	}
+
 }
@@ -4,12 +4,18 @@
 #include <string>
 #include <stdexcept>
 
+#include "resources/Resource.h"
+
 namespace urchin
 {
 
 	class LoaderInterface
 	{
+		public:
+			virtual ~LoaderInterface() = default;
 
+			virtual Resource *loadResource(const std::string &) = 0;
+			virtual bool isThreadSafe() const;
 	};
 
 	template<class T> class Loader : public LoaderInterface
@@ -17,6 +23,8 @@ namespace urchin
 		public:
 			virtual ~Loader();
 		
+			Resource *loadResource(const std::string &) override;
+
 			virtual T *loadFromFile(const std::string &filename);
 			virtual void saveToFile(const T *object, const std::string& filename);
 	};
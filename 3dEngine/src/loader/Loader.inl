@@ -3,6 +3,11 @@ template<class T> Loader<T>::~Loader()
 
 }
 
+template<class T> Resource *Loader<T>::loadResource(const std::string &filename)
+{
+	return loadFromFile(filename);
+}
+
 template<class T> T *Loader<T>::loadFromFile(const std::string &filename)
 {
 	throw std::runtime_error("Impossible to import this type of file, filename: " + filename + ".");
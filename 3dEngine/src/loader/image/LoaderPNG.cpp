@@ -1,4 +1,3 @@
-#include <bitset>
 #include "UrchinCommon.h"
 
 #include "LoaderPNG.h"
@@ -13,122 +12,81 @@ namespace urchin
     Image *LoaderPNG::loadFromFile(const std::string &filename)
     {
         std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
-        std::vector<unsigned char> png;
-        unsigned int errorLoad = lodepng::load_file(png, filenamePath);
-        if(errorLoad!=0)
-        {
-            throw std::invalid_argument("Cannot load the file " + filenamePath + ": " + lodepng_error_text(errorLoad));
-        }
+        MemoryMappedFile pngFile(filenamePath);
+        auto png = reinterpret_cast<const unsigned char *>(pngFile.getData());
 
         unsigned int width, height;
         lodepng::State state;
-        state.info_raw.bitdepth=16;
-        std::vector<unsigned char> pixelsRGBA16bits;
-        unsigned int errorRead = lodepng::decode(pixelsRGBA16bits, width, height, state, png);
-        if(errorRead!=0)
+        unsigned int errorInspect = lodepng_inspect(&width, &height, &state, png, pngFile.getSize());
+        if(errorInspect!=0)
         {
-            throw std::invalid_argument("Cannot read the file " + filenamePath + ": " + lodepng_error_text(errorLoad));
+            throw std::invalid_argument("Cannot read the file " + filenamePath + ": " + lodepng_error_text(errorInspect));
         }
 
+        //decodes directly in the channels and precision of the image: no conversion needed after decoding
         unsigned int bitDepth = state.info_png.color.bitdepth;
         LodePNGColorType colorType = state.info_png.color.colortype;
+        Image::ImageFormat imageFormat;
         if(colorType==LodePNGColorType::LCT_GREY)
         {
-            if(bitDepth==8)
-            {
-                return new Image(width, height, Image::IMAGE_GRAYSCALE, extract8BitsChannels(pixelsRGBA16bits, 1));
-            }else if(bitDepth==16)
-            {
-                return new Image(width, height, Image::IMAGE_GRAYSCALE, extract16BitsChannels(pixelsRGBA16bits, 1));
-            }else
+            if(bitDepth!=8 && bitDepth!=16)
             {
                 throw std::invalid_argument("Unsupported number of bits for PNG image (grayscale): " + std::to_string(bitDepth));
             }
+            imageFormat = Image::IMAGE_GRAYSCALE;
         }else if(colorType==LodePNGColorType::LCT_RGB)
         {
-            if(bitDepth==8)
-            {
-                return new Image(width, height, Image::IMAGE_RGB, extract8BitsChannels(pixelsRGBA16bits, 7));
-            }else
+            if(bitDepth!=8)
             {
                 throw std::invalid_argument("Unsupported number of bits for PNG image (RGB): " + std::to_string(bitDepth));
             }
+            imageFormat = Image::IMAGE_RGB;
         }else if(colorType==LodePNGColorType::LCT_RGBA)
         {
-            if(bitDepth==8)
-            {
-                return new Image(width, height, Image::IMAGE_RGBA, extract8BitsChannels(pixelsRGBA16bits, 15));
-            }else
+            if(bitDepth!=8)
             {
                 throw std::invalid_argument("Unsupported number of bits for PNG image (RGBA): " + std::to_string(bitDepth));
             }
+            imageFormat = Image::IMAGE_RGBA;
         }else
         {
             throw std::invalid_argument("Unsupported color type for PNG image: " + std::to_string(colorType));
         }
-    }
 
-    /**
-     * @param channelsMask Channel to extract where bit 0: R, bit 1: G, bit 2: B,  bit 3: A
-     */
-    std::vector<unsigned char> LoaderPNG::extract8BitsChannels(const std::vector<unsigned char> &pixelsRGBA16bits, unsigned int channelsMask)
-    {
+        state.info_raw.colortype = colorType;
+        state.info_raw.bitdepth = bitDepth;
         std::vector<unsigned char> pixels;
-        size_t nbChannels = std::bitset<8>(channelsMask).count();
-        pixels.reserve((pixelsRGBA16bits.size()/(4*2))*nbChannels);
+        unsigned int errorRead = lodepng::decode(pixels, width, height, state, png, pngFile.getSize());
+        if(errorRead!=0)
+        {
+            throw std::invalid_argument("Cannot read the file " + filenamePath + ": " + lodepng_error_text(errorRead));
+        }
 
-        for(unsigned int i=7; i<pixelsRGBA16bits.size(); i+=8)
+        if(bitDepth==16)
         {
-            if(channelsMask & 1)
-            { //red
-                pixels.push_back(pixelsRGBA16bits[i-6]);
-            }
-            if(channelsMask & 2)
-            { //green
-                pixels.push_back(pixelsRGBA16bits[i-4]);
-            }
-            if(channelsMask & 4)
-            { //blue
-                pixels.push_back(pixelsRGBA16bits[i-2]);
-            }
-            if(channelsMask & 8)
-            { //alpha
-                pixels.push_back(pixelsRGBA16bits[i-0]);
-            }
+            return new Image(width, height, imageFormat, toTexels16Bits(pixels));
         }
+        return new Image(width, height, imageFormat, std::move(pixels));
+    }
 
-        return pixels;
+    bool LoaderPNG::isThreadSafe() const
+    {
+        return true;
     }
 
     /**
-     * @param channelsMask Channel to extract where bit 0: R, bit 1: G, bit 2: B,  bit 3: A
+     * @param pixels16Bits Pixels where each channel is stored on two bytes in big-endian order
      */
-    std::vector<uint16_t> LoaderPNG::extract16BitsChannels(const std::vector<unsigned char> &pixelsRGBA16bits, unsigned int channelsMask)
+    std::vector<uint16_t> LoaderPNG::toTexels16Bits(const std::vector<unsigned char> &pixels16Bits) const
     {
-        std::vector<uint16_t> pixels;
-        size_t nbChannels = std::bitset<8>(channelsMask).count();
-        pixels.reserve((pixelsRGBA16bits.size()/(4*2))*nbChannels);
-
-        for(unsigned int i=7; i<pixelsRGBA16bits.size(); i+=8)
+        std::vector<uint16_t> texels(pixels16Bits.size() / 2);
+        const unsigned char *pixels = pixels16Bits.data();
+        uint16_t *texelsData = texels.data();
+        for(std::size_t i=0, texelsSize=texels.size(); i<texelsSize; ++i)
         {
-            if(channelsMask & 1)
-            { //red
-                pixels.push_back((static_cast<uint16_t>(pixelsRGBA16bits[i-7]) << 8) | static_cast<uint16_t>(pixelsRGBA16bits[i-6]));
-            }
-            if(channelsMask & 2)
-            { //green
-                pixels.push_back((static_cast<uint16_t>(pixelsRGBA16bits[i-5]) << 8) | static_cast<uint16_t>(pixelsRGBA16bits[i-4]));
-            }
-            if(channelsMask & 4)
-            { //blue
-                pixels.push_back((static_cast<uint16_t>(pixelsRGBA16bits[i-3]) << 8) | static_cast<uint16_t>(pixelsRGBA16bits[i-2]));
-            }
-            if(channelsMask & 8)
-            { //alpha
-                pixels.push_back((static_cast<uint16_t>(pixelsRGBA16bits[i-1]) << 8) | static_cast<uint16_t>(pixelsRGBA16bits[i-0]));
-            }
+            texelsData[i] = static_cast<uint16_t>((pixels[i*2] << 8) | pixels[i*2 + 1]);
         }
 
-        return pixels;
+        return texels;
     }
 }
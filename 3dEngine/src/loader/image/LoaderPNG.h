@@ -16,10 +16,10 @@ namespace urchin
             ~LoaderPNG() override = default;
 
             Image *loadFromFile(const std::string &) override;
+            bool isThreadSafe() const override;
 
         private:
-            std::vector<unsigned char> extract8BitsChannels(const std::vector<unsigned char> &, unsigned int);
-            std::vector<uint16_t> extract16BitsChannels(const std::vector<unsigned char> &, unsigned int);
+            std::vector<uint16_t> toTexels16Bits(const std::vector<unsigned char> &) const;
     };
 
 }
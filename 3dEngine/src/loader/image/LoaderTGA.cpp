@@ -1,469 +1,319 @@
 #include <stdexcept>
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include "UrchinCommon.h"
 
 #include "loader/image/LoaderTGA.h"
 
+#define TGA_COLOR_MAP_MAX_ENTRIES 256
+
 namespace urchin
 {
 	
-	LoaderTGA::LoaderTGA() : Loader<Image>(),
-			colorMap(nullptr),
-			data(nullptr),
-			width(0),
-			height(0),
-			componentsCount(0),
-			format(Image::IMAGE_RGB)
+	LoaderTGA::LoaderTGA() : Loader<Image>()
 	{
 
 	}
 
 	Image *LoaderTGA::loadFromFile(const std::string &filename)
 	{
-		//opens file
-		std::ifstream file;
 		std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
-		file.open(filenamePath, std::ios::in | std::ios::binary);
-		if(file.fail())
-		{
-			throw std::invalid_argument("Cannot open the file " + filenamePath + ".");
-		}
+		MemoryMappedFile tgaFile(filenamePath);
+		auto fileData = reinterpret_cast<const unsigned char *>(tgaFile.getData());
+		std::size_t fileSize = tgaFile.getSize();
 
-		//gets file length
-		file.seekg(0, std::ios::end);
-		int length = file.tellg();
-		file.seekg(0, std::ios::beg);
-		
 		//extracts header
 		TgaHeader header{};
-		file.read((char *)&header, sizeof(TgaHeader));
-		file.seekg(header.idLenght, std::ios::cur);
-			
-		//extracts color map (color map is stored in BGR format)
-		if(header.colormapType)
+		if(fileSize < sizeof(TgaHeader))
 		{
-			colorMap = new unsigned char[header.cmLength*(header.cmSize>>3)];
-			file.read((char *)colorMap, header.cmLength*(header.cmSize>>3));
+			throw std::runtime_error("TGA file is corrupted, filename: " + filenamePath + ".");
 		}
+		std::memcpy(&header, fileData, sizeof(TgaHeader));
+		std::size_t offset = sizeof(TgaHeader) + header.idLenght;
 
-		//memory allocation for rough pixel data
-		int lengthData = length - file.tellg();
-		data = new unsigned char[lengthData];
-		file.read((char *)data, lengthData);
-
-		//memory allocation for pixel data
-		getImageInfo(header);
-		texels.resize(width*height*componentsCount, 0);
+		PixelEncoding pixelEncoding = retrievePixelEncoding(header);
+		unsigned int componentsCount = retrieveComponentsCount(pixelEncoding);
+		auto width = static_cast<unsigned int>(header.width);
+		auto height = static_cast<unsigned int>(header.height);
 
-		//reads image data
-		switch(header.imageType)
+		//extracts color map
+		std::vector<unsigned char> colorMap;
+		if(header.colormapType)
 		{
-			case 1:
-				//uncompressed 8 bits color index
-				readTGA8bits();
-				break;
-
-			case 2:
-				//uncompressed 16-24-32 bits
-				switch(header.pixelDepth)
-				{
-					case 16:
-						readTGA16bits();
-						break;
-
-					case 24:
-						readTGA24bits();
-						break;
-
-					case 32:
-						readTGA32bits();
-						break;
-					default:
-						break;
-				}
-				break;
-
-			case 3:
-				//uncompressed 8 bits grayscale
-				if(header.pixelDepth==8)
-				{
-					readTGAgray8bits();
-				}else
-				{
-					throw std::runtime_error("Wrong number of bits for grayscale: " + std::to_string(header.pixelDepth));
-				}
-				break;
-
-			case 9:
-				//RLE compressed 8 bits color index
-				readTGA8bitsRLE();
-				break;
-
-			case 10:
-				//RLE compressed 16-24-32 bits
-				switch(header.pixelDepth)
-				{
-					case 16:
-						readTGA16bitsRLE();
-						break;
-
-					case 24:
-						readTGA24bitsRLE();
-						break;
-
-					case 32:
-						readTGA32bitsRLE();
-						break;
-					default:
-						break;
-				}
-				break;
-
-			case 11:
-				//RLE compressed 8bits grayscale
-				if(header.pixelDepth == 8)
-				{
-					readTGAgray8bitsRLE();
-				}else
-				{
-					throw std::runtime_error("Wrong number of bits for grayscale: " + std::to_string(header.pixelDepth));
-				}
-				break;
-
-			default:
-				if(header.colormapType)
-				{
-					delete [] colorMap;
-				}
-				delete [] data;
-				//image type is not correct
-				throw std::runtime_error("Unknown TGA image type, filename: " + filenamePath + ".");
+			std::size_t colorMapSize = static_cast<std::size_t>(std::max((short)0, header.cmLength)) * (header.cmSize>>3);
+			if(offset + colorMapSize > fileSize)
+			{
+				throw std::runtime_error("TGA file is corrupted, filename: " + filenamePath + ".");
+			}
+			colorMap = readColorMap(header, fileData + offset, colorMapSize);
+			offset += colorMapSize;
+		}else if(pixelEncoding==COLOR_INDEX_8)
+		{
+			throw std::runtime_error("TGA color index image without color map, filename: " + filenamePath + ".");
 		}
-		
-		if(header.colormapType)
+
+		//reads image data directly in the texels of the image
+		const unsigned char *data = fileData + std::min(offset, fileSize);
+		std::size_t dataSize = fileSize - std::min(offset, fileSize);
+		std::vector<unsigned char> texels(static_cast<std::size_t>(width) * height * componentsCount);
+		if(header.imageType < 8)
+		{
+			readUncompressed(data, dataSize, pixelEncoding, colorMap.data(), width*height, texels.data());
+		}else
 		{
-			delete [] colorMap;
+			readRLE(data, dataSize, pixelEncoding, colorMap.data(), width*height, texels.data());
 		}
-		delete [] data;
-		
-		
+
 		short origin = ((int)header.imageDescriptor & 0x20)>>5; //0:origin bottom, 1:origin top
 		if(origin==0)
-		{ //inverses the texels
-			std::vector<unsigned char> texelsInverse(width*height*componentsCount, 0);
-			
-			for(unsigned int i=0, iInverse=height-1;i<height;i++, iInverse--)
-			{
-				for(unsigned int j=0;j<width*componentsCount;j++)
-				{
-					texelsInverse[i*(width*componentsCount) + j] = texels[iInverse*(width*componentsCount) + j];
-				}
-			}
-
-			return new Image(width, height, format, std::move(texelsInverse));
+		{
+			flipVertically(texels, width*componentsCount, height);
 		}
 
+		Image::ImageFormat format = componentsCount==1 ? Image::IMAGE_GRAYSCALE : (componentsCount==3 ? Image::IMAGE_RGB : Image::IMAGE_RGBA);
 		return new Image(width, height, format, std::move(texels));
 	}
 
-	void LoaderTGA::getImageInfo(const TgaHeader &header)
+	bool LoaderTGA::isThreadSafe() const
 	{
-		width = static_cast<unsigned int>(header.width);
-		height = static_cast<unsigned int>(header.height);
+		return true;
+	}
 
+	LoaderTGA::PixelEncoding LoaderTGA::retrievePixelEncoding(const TgaHeader &header) const
+	{
 		switch(header.imageType)
 		{
-			case 3:  //grayscale 8 bits
-			case 11: //grayscale 8 bits (RLE)
-			{
+			case 1: //8 bits color index
+			case 9: //8 bits color index (RLE)
 				if(header.pixelDepth==8)
 				{
-					format = Image::IMAGE_GRAYSCALE;
-					componentsCount = 1;
-				}else
-				{
-					throw std::runtime_error("Wrong number of bits for grayscale: " + std::to_string(header.pixelDepth));
+					return COLOR_INDEX_8;
 				}
+				throw std::runtime_error("Wrong number of bits for color index: " + std::to_string(header.pixelDepth));
 
-				break;
-			}
-
-			case 1:  //8 bits color index
 			case 2:  //BGR 16-24-32 bits
-			case 9:  //8 bits color index (RLE)
 			case 10: //BGR 16-24-32 bits (RLE)
-			{
-				//8 bits and 16 bits images will be converted to 24 bits
-				if(header.pixelDepth<=24)
+				if(header.pixelDepth==16)
+				{
+					return BGR_16;
+				}else if(header.pixelDepth==24)
 				{
-					format = Image::IMAGE_RGB;
-					componentsCount = 3;
-				}else //32 bits
+					return BGR_24;
+				}else if(header.pixelDepth==32)
 				{
-					format = Image::IMAGE_RGBA;
-					componentsCount = 4;
+					return BGRA_32;
 				}
+				throw std::runtime_error("Wrong number of bits for BGR: " + std::to_string(header.pixelDepth));
+
+			case 3:  //grayscale 8 bits
+			case 11: //grayscale 8 bits (RLE)
+				if(header.pixelDepth==8)
+				{
+					return GRAYSCALE_8;
+				}
+				throw std::runtime_error("Wrong number of bits for grayscale: " + std::to_string(header.pixelDepth));
 
-				break;
-			}
 			default:
-				break;
+				throw std::runtime_error("Unknown TGA image type: " + std::to_string(header.imageType));
 		}
 	}
 
-	void LoaderTGA::readTGA8bits()
+	/**
+	 * @return Number of bytes of a pixel in the TGA file
+	 */
+	unsigned int LoaderTGA::retrievePixelSize(PixelEncoding pixelEncoding) const
 	{
-		unsigned char color;
-
-		for(unsigned int i=0; i < width*height;++i)
+		if(pixelEncoding==BGRA_32)
 		{
-			//reads index color byte
-			color = data[i];
-
-			//converts to RGB 24 bits
-			texels[(i*3)+2] = colorMap[(color*3)+0];
-			texels[(i*3)+1] = colorMap[(color*3)+1];
-			texels[(i*3)+0] = colorMap[(color*3)+2];
-		}
-	}
-
-	void LoaderTGA::readTGA16bits()
-	{
-		unsigned short color;
-
-		for(unsigned int i=0, j=0;i<width*height;++i, j+=2)
+			return 4;
+		}else if(pixelEncoding==BGR_24)
 		{
-			//reads color word
-			color = data[j] + (data[j+1] << 8);
-
-			//converts BGR to RGB
-			texels[(i*3)+0] = (unsigned char)(((color & 0x7C00) >> 10) << 3);
-			texels[(i*3)+1] = (unsigned char)(((color & 0x03E0) >>  5) << 3);
-			texels[(i*3)+2] = (unsigned char)(((color & 0x001F) >>  0) << 3);
+			return 3;
+		}else if(pixelEncoding==BGR_16)
+		{
+			return 2;
 		}
+		return 1;
 	}
 
-	void LoaderTGA::readTGA24bits()
+	/**
+	 * @return Number of components in texels. 8 bits and 16 bits images are converted to 24 bits.
+	 */
+	unsigned int LoaderTGA::retrieveComponentsCount(PixelEncoding pixelEncoding) const
 	{
-		for(unsigned int i=0, j=0; i<width*height; ++i, j+=3)
+		if(pixelEncoding==GRAYSCALE_8)
 		{
-			//reads and converts BGR to RGB
-			texels[(i*3)+2] = data[j+0];
-			texels[(i*3)+1] = data[j+1];
-			texels[(i*3)+0] = data[j+2];
+			return 1;
+		}else if(pixelEncoding==BGRA_32)
+		{
+			return 4;
 		}
+		return 3;
 	}
 
-	void LoaderTGA::readTGA32bits()
+	/**
+	 * @return Color map converted to RGB and extended to 256 entries: all the color indices can be read without bounds check
+	 */
+	std::vector<unsigned char> LoaderTGA::readColorMap(const TgaHeader &header, const unsigned char *colorMapData, std::size_t colorMapSize) const
 	{
-		for(unsigned int i=0,j=0;i<width*height;++i, j+=4)
+		std::vector<unsigned char> colorMap(TGA_COLOR_MAP_MAX_ENTRIES * 3, 0);
+		if(header.cmSize!=24)
 		{
-			//reads and converts BGRA to RGBA
-			texels[(i*4)+2] = data[j+0];
-			texels[(i*4)+1] = data[j+1];
-			texels[(i*4)+0] = data[j+2];
-			texels[(i*4)+3] = data[j+3];
+			throw std::runtime_error("Wrong number of bits for color map: " + std::to_string(header.cmSize));
 		}
+
+		unsigned int entriesCount = std::min((unsigned int)(colorMapSize / 3), (unsigned int)TGA_COLOR_MAP_MAX_ENTRIES);
+		convertPixels(colorMapData, entriesCount, BGR_24, nullptr, colorMap.data());
+
+		return colorMap;
 	}
 
-	void LoaderTGA::readTGAgray8bits()
+	void LoaderTGA::readUncompressed(const unsigned char *data, std::size_t dataSize, PixelEncoding pixelEncoding,
+			const unsigned char *colorMap, unsigned int pixelsCount, unsigned char *texels) const
 	{
-		for(unsigned int i=0; i<width*height; ++i)
+		unsigned int pixelSize = retrievePixelSize(pixelEncoding);
+		if(static_cast<std::size_t>(pixelsCount) * pixelSize > dataSize)
 		{
-			texels[i] = data[i];
+			throw std::runtime_error("TGA image data is truncated.");
 		}
+
+		convertPixels(data, pixelsCount, pixelEncoding, colorMap, texels);
 	}
 
-	void LoaderTGA::readTGA8bitsRLE()
+	/**
+	 * Raw packets are converted in one pass. Run-length packets convert their pixel once and duplicate it.
+	 */
+	void LoaderTGA::readRLE(const unsigned char *data, std::size_t dataSize, PixelEncoding pixelEncoding,
+			const unsigned char *colorMap, unsigned int pixelsCount, unsigned char *texels) const
 	{
-		int j = 0;
-		unsigned char color;
-		unsigned char packetHeader;
-		unsigned int ptrIndex = 0;
+		unsigned int pixelSize = retrievePixelSize(pixelEncoding);
+		unsigned int texelSize = retrieveComponentsCount(pixelEncoding);
+		std::size_t j = 0;
+		unsigned int pixelIndex = 0;
 
-		while(ptrIndex < width*height*3)
+		while(pixelIndex < pixelsCount)
 		{
-			//reads first byte
-			packetHeader = data[j++];
-			int size = 1 + (packetHeader & 0x7f);
-
-			if(packetHeader & 0x80)
+			if(j >= dataSize)
 			{
-				//run-length packet
-				color = data[j++];
-
-				for(int i=0;i<size;++i, ptrIndex+=3)
-				{
-					texels[ptrIndex] = colorMap[(color * 3) + 2];
-					texels[ptrIndex+1] = colorMap[(color * 3) + 1];
-					texels[ptrIndex+2] = colorMap[(color * 3) + 0];
-				}
-			}else
-			{
-				//non run-length packet
-				for(int i=0;i<size;++i,ptrIndex+=3)
-				{
-					color = data[j++];
-
-					texels[ptrIndex] = colorMap[(color * 3) + 2];
-					texels[ptrIndex+1] = colorMap[(color * 3) + 1];
-					texels[ptrIndex+2] = colorMap[(color * 3) + 0];
-				}
+				throw std::runtime_error("TGA image data is truncated.");
 			}
-		}
-	}
 
-	void LoaderTGA::readTGA16bitsRLE()
-	{
-		int j = 0;
-		unsigned short color;
-		unsigned char packetHeader;
-		unsigned int ptrIndex = 0;
-
-		while(ptrIndex < width*height*3)
-		{
 			//reads first byte
-			packetHeader = data[j++];
-			int size = 1 + (packetHeader & 0x7f);
+			unsigned char packetHeader = data[j++];
+			unsigned int size = std::min(1u + (packetHeader & 0x7f), pixelsCount - pixelIndex);
+			unsigned char *packetTexels = texels + static_cast<std::size_t>(pixelIndex) * texelSize;
 
 			if(packetHeader & 0x80)
-			{
-				//run-length packet
-				color = data[j] + (data[j + 1] << 8);
-				j+=2;
-
-				for(int i=0; i<size; ++i,ptrIndex+=3)
+			{ //run-length packet
+				if(j + pixelSize > dataSize)
 				{
-					texels[ptrIndex] = (unsigned char)(((color & 0x7C00) >> 10) << 3);
-					texels[ptrIndex+1] = (unsigned char)(((color & 0x03E0) >>  5) << 3);
-					texels[ptrIndex+2] = (unsigned char)(((color & 0x001F) >>  0) << 3);
+					throw std::runtime_error("TGA image data is truncated.");
 				}
+				unsigned char texel[4];
+				convertPixels(data + j, 1, pixelEncoding, colorMap, texel);
+				j += pixelSize;
+				fillTexels(texel, texelSize, size, packetTexels);
 			}else
-			{
-				//non run-length packet
-				for(int i=0; i<size; ++i,ptrIndex+=3,j+=2)
+			{ //non run-length packet
+				if(j + static_cast<std::size_t>(size) * pixelSize > dataSize)
 				{
-					color = data[j] + (data[j + 1] << 8);
-
-					texels[ptrIndex] = (unsigned char)(((color & 0x7C00) >> 10) << 3);
-					texels[ptrIndex+1] = (unsigned char)(((color & 0x03E0) >> 5) << 3);
-					texels[ptrIndex+2] = (unsigned char)(((color & 0x001F) >> 0) << 3);
+					throw std::runtime_error("TGA image data is truncated.");
 				}
+				convertPixels(data + j, size, pixelEncoding, colorMap, packetTexels);
+				j += static_cast<std::size_t>(size) * pixelSize;
 			}
+
+			pixelIndex += size;
 		}
 	}
 
-	void LoaderTGA::readTGA24bitsRLE()
+	/**
+	 * Duplicates a texel: each texel size has its own loop without dependency between iterations.
+	 */
+	void LoaderTGA::fillTexels(const unsigned char *texel, unsigned int texelSize, unsigned int texelsCount, unsigned char *__restrict texels) const
 	{
-		int j = 0;
-		unsigned char *rgb;
-		unsigned char packetHeader;
-		unsigned int ptrIndex = 0;
-
-		while(ptrIndex < width*height*3)
+		if(texelSize==1)
 		{
-			//reads first byte
-			packetHeader = data[j++];
-			int size = 1 + (packetHeader & 0x7f);
-
-			if(packetHeader & 0x80)
+			std::memset(texels, texel[0], texelsCount);
+		}else if(texelSize==3)
+		{
+			for(unsigned int i=0; i<texelsCount; ++i)
 			{
-				//run-length packet
-				rgb = &data[j];
-				j += 3;
-
-				for(int i=0; i<size; ++i,ptrIndex+=3)
-				{
-					texels[ptrIndex] = rgb[2];
-					texels[ptrIndex+1] = rgb[1];
-					texels[ptrIndex+2] = rgb[0];
-				}
-			}else
+				texels[(i*3)+0] = texel[0];
+				texels[(i*3)+1] = texel[1];
+				texels[(i*3)+2] = texel[2];
+			}
+		}else
+		{
+			uint32_t texelWord;
+			std::memcpy(&texelWord, texel, 4);
+			for(unsigned int i=0; i<texelsCount; ++i)
 			{
-				//non run-length packet
-				for(int i=0; i<size; ++i,ptrIndex+=3,j+=3)
-				{
-					texels[ptrIndex+2] = data[j + 0];
-					texels[ptrIndex+1] = data[j + 1];
-					texels[ptrIndex] = data[j + 2];
-				}
+				std::memcpy(texels + i*4, &texelWord, 4);
 			}
 		}
 	}
 
-	void LoaderTGA::readTGA32bitsRLE()
+	/**
+	 * Converts pixels to RGB/RGBA/grayscale texels. Each encoding has its own loop without branch: loops can be vectorized by
+	 * the compiler.
+	 * @param colorMap RGB color map of 256 entries (color index encoding only)
+	 */
+	void LoaderTGA::convertPixels(const unsigned char *__restrict source, unsigned int pixelsCount, PixelEncoding pixelEncoding,
+			const unsigned char *__restrict colorMap, unsigned char *__restrict texels) const
 	{
-		int j = 0;
-		unsigned char *rgba;
-		unsigned char packetHeader;
-		unsigned int ptrIndex = 0;
-
-		while(ptrIndex < width*height*4)
+		switch(pixelEncoding)
 		{
-			//reads first byte
-			packetHeader = data[j++];
-			int size = 1 + (packetHeader & 0x7f);
+			case COLOR_INDEX_8:
+				for(unsigned int i=0; i<pixelsCount; ++i)
+				{
+					const unsigned char *color = colorMap + source[i] * 3;
+					texels[(i*3)+0] = color[0];
+					texels[(i*3)+1] = color[1];
+					texels[(i*3)+2] = color[2];
+				}
+				break;
 
-			if(packetHeader & 0x80)
-			{
-				//run-length packet
-				rgba = &data[j];
-				j += 4;
+			case GRAYSCALE_8:
+				std::memcpy(texels, source, pixelsCount);
+				break;
 
-				for(int i=0; i<size; ++i,ptrIndex+=4)
+			case BGR_16:
+				for(unsigned int i=0; i<pixelsCount; ++i)
 				{
-					texels[ptrIndex] = rgba[2];
-					texels[ptrIndex+1] = rgba[1];
-					texels[ptrIndex+2] = rgba[0];
-					texels[ptrIndex+3] = rgba[3];
+					auto color = static_cast<unsigned short>(source[i*2] | (source[(i*2)+1] << 8));
+					texels[(i*3)+0] = (unsigned char)(((color & 0x7C00) >> 10) << 3);
+					texels[(i*3)+1] = (unsigned char)(((color & 0x03E0) >>  5) << 3);
+					texels[(i*3)+2] = (unsigned char)(((color & 0x001F) >>  0) << 3);
 				}
-			}else
-			{
-				//non run-length packet
-				for(int i=0; i<size; ++i,ptrIndex+=4,j+=4)
+				break;
+
+			case BGR_24:
+				for(unsigned int i=0; i<pixelsCount; ++i)
 				{
-					texels[ptrIndex+2] = data[j + 0];
-					texels[ptrIndex+1] = data[j + 1];
-					texels[ptrIndex] = data[j + 2];
-					texels[ptrIndex+3] = data[j + 3];
+					texels[(i*3)+0] = source[(i*3)+2];
+					texels[(i*3)+1] = source[(i*3)+1];
+					texels[(i*3)+2] = source[(i*3)+0];
 				}
-			}
+				break;
+
+			case BGRA_32:
+				for(unsigned int i=0; i<pixelsCount; ++i)
+				{ //swaps blue and red bytes of each 32 bits word
+					uint32_t bgra;
+					std::memcpy(&bgra, source + i*4, 4);
+					uint32_t rgba = (bgra & 0xFF00FF00u) | ((bgra >> 16) & 0x000000FFu) | ((bgra & 0x000000FFu) << 16);
+					std::memcpy(texels + i*4, &rgba, 4);
+				}
+				break;
 		}
 	}
 
-	void LoaderTGA::readTGAgray8bitsRLE()
+	void LoaderTGA::flipVertically(std::vector<unsigned char> &texels, unsigned int rowSize, unsigned int height) const
 	{
-		int j = 0;
-		unsigned char color;
-		unsigned char packetHeader;
-		unsigned int ptrIndex = 0;
-
-		while(ptrIndex < width*height)
+		for(unsigned int i=0, iInverse=height-1; i<height/2; ++i, --iInverse)
 		{
-			//reads first byte
-			packetHeader = data[j++];
-			int size = 1+(packetHeader & 0x7f);
-
-			if(packetHeader & 0x80)
-			{
-				//run-length packet
-				color = data[j++];
-
-				for(int i=0; i<size; ++i,ptrIndex++)
-				{
-					texels[ptrIndex]=color;
-				}
-			}else
-			{
-				//non run-length packet
-				for(unsigned int i=0; i<size; ++i)
-				{
-					texels[ptrIndex+i] = data[j+i];
-				}
-
-				ptrIndex+=size;
-				j+=size;
-			}
+			std::swap_ranges(texels.begin() + i*rowSize, texels.begin() + (i+1)*rowSize, texels.begin() + iInverse*rowSize);
 		}
 	}
 
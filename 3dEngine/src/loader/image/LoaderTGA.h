@@ -2,6 +2,7 @@
 #define URCHINENGINE_LOADERTGA_H
 
 #include <string>
+#include <vector>
 
 #include "resources/image/Image.h"
 #include "loader/Loader.h"
@@ -31,6 +32,9 @@ namespace urchin
 	};
 	#pragma pack(pop)
 
+	/**
+	 * Loader of TGA images. Loader doesn't keep any state between two loads: images can be loaded in parallel.
+	 */
 	class LoaderTGA : public Loader<Image>
 	{
 		public:
@@ -38,28 +42,28 @@ namespace urchin
 			~LoaderTGA() override = default;
 
 			Image *loadFromFile(const std::string &) override;
+			bool isThreadSafe() const override;
 
 		private:
-			void getImageInfo(const TgaHeader &);
-			void readTGA8bits();
-			void readTGA16bits();
-			void readTGA24bits();
-			void readTGA32bits();
-			void readTGAgray8bits();
-			void readTGA8bitsRLE();
-			void readTGA16bitsRLE();
-			void readTGA24bitsRLE();
-			void readTGA32bitsRLE();
-			void readTGAgray8bitsRLE();
+			enum PixelEncoding
+			{
+				COLOR_INDEX_8,
+				GRAYSCALE_8,
+				BGR_16,
+				BGR_24,
+				BGRA_32
+			};
 
-			//temporary attributes
-			unsigned char *colorMap, *data;
-		
-			//attributes for Image
-			unsigned int width, height;
-			unsigned int componentsCount;
-			Image::ImageFormat format;
-			std::vector<unsigned char> texels;
+			PixelEncoding retrievePixelEncoding(const TgaHeader &) const;
+			unsigned int retrievePixelSize(PixelEncoding) const;
+			unsigned int retrieveComponentsCount(PixelEncoding) const;
+			std::vector<unsigned char> readColorMap(const TgaHeader &, const unsigned char *, std::size_t) const;
+
+			void readUncompressed(const unsigned char *, std::size_t, PixelEncoding, const unsigned char *, unsigned int, unsigned char *) const;
+			void readRLE(const unsigned char *, std::size_t, PixelEncoding, const unsigned char *, unsigned int, unsigned char *) const;
+			void fillTexels(const unsigned char *, unsigned int, unsigned int, unsigned char *) const;
+			void convertPixels(const unsigned char *, unsigned int, PixelEncoding, const unsigned char *, unsigned char *) const;
+			void flipVertically(std::vector<unsigned char> &, unsigned int, unsigned int) const;
 	};
 
 }
@@ -4,19 +4,52 @@
 
 #include "loader/model/LoaderUrchinAnim.h"
 
+#define ANIM_FRL_FILE_VERSION 1
+
 namespace urchin
 {
 
+	static_assert(sizeof(QuantizedQuaternion<float>)==3*sizeof(unsigned short), "Unexpected quantized quaternion layout");
+
+	/**
+	 * Animation is loaded from a binary FRL file (saved in the save directory) containing the compressed bone tracks when it
+	 * is up to date. Otherwise, the text file is parsed, the bone tracks are compressed and the FRL file is written for the next loadings.
+	 */
 	ConstAnimation *LoaderUrchinAnim::loadFromFile(const std::string &filename)
 	{
-		std::locale::global(std::locale("C")); //for float
-		
+		std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
+		std::string frlFilePath = FrlFileReader::buildFrlFilePath(filename);
+		std::string md5Sum = std::string(MD5().digestFile(filenamePath.c_str()));
+
+		FrlFileReader frlFileReader(frlFilePath);
+		if(frlFileReader.checkHeader(ANIM_FRL_FILE_VERSION, md5Sum))
+		{
+			return loadFromFrlFile(filename, frlFileReader);
+		}
+
+		ConstAnimation *constAnimation = loadFromTextFile(filename, filenamePath);
+
+		FrlFileWriter frlFileWriter(frlFilePath, ANIM_FRL_FILE_VERSION, md5Sum);
+		writeFrlFile(constAnimation, frlFileWriter);
+		frlFileWriter.commit();
+
+		return constAnimation;
+	}
+
+	bool LoaderUrchinAnim::isThreadSafe() const
+	{
+		return true;
+	}
+
+	ConstAnimation *LoaderUrchinAnim::loadFromTextFile(const std::string &filename, const std::string &filenamePath)
+	{
 		std::ifstream file;
 		std::istringstream iss;
+		file.imbue(std::locale::classic()); //for float
+		iss.imbue(std::locale::classic());
 		std::string buffer;
 		std::string sdata;
-		
-		std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
+
 		file.open(filenamePath, std::ios::in);
 		if(file.fail())
 		{
@@ -60,7 +93,8 @@ namespace urchin
         FileReaderUtil::nextLine(file, buffer); //buffer = "}"
 		
 		//bounds
-		auto **bboxes = new AABBox<float>*[numFrames];
+		std::vector<AABBox<float>> bboxes;
+		bboxes.reserve(numFrames);
         FileReaderUtil::nextLine(file, buffer); //buffer = "bounds {"
 		for(unsigned int i=0;i<numFrames;i++)
 		{
@@ -69,7 +103,7 @@ namespace urchin
 
 			Point3<float> min, max;
 			iss >> sdata >> min.X >> min.Y >> min.Z >> sdata >> sdata >> max.X >> max.Y >> max.Z;
-			bboxes[i] = new AABBox<float>(min, max);
+			bboxes.emplace_back(min, max);
 		}
         FileReaderUtil::nextLine(file, buffer); //buffer = "}"
 		
@@ -86,11 +120,11 @@ namespace urchin
         FileReaderUtil::nextLine(file, buffer); //buffer = "}"
 		
 		//frames
-		auto **skeletonFrames = new Bone*[numFrames];
+		std::vector<std::vector<Bone>> skeletonFrames(numFrames);
 		auto *animFrameData = new float[numAnimatedComponents];
 		for(unsigned int frameIndex=0;frameIndex<numFrames;++frameIndex)
 		{
-			skeletonFrames[frameIndex] = new Bone[numBones];
+			skeletonFrames[frameIndex].resize(numBones);
 
             FileReaderUtil::nextLine(file, buffer); // buffer = "frame ? {"
 			for(unsigned int j=0;j<numAnimatedComponents;j++)
@@ -150,7 +184,10 @@ namespace urchin
 
 				int parent = boneInfos[i].parent;
 				thisBone->parent = parent;
-				thisBone->name = boneInfos[i].name;
+				if(frameIndex==0)
+				{ //bone names are only read from the first frame
+					thisBone->name = boneInfos[i].name;
+				}
 
 				//has parent ?
 				if(thisBone->parent < 0)
@@ -180,6 +217,76 @@ namespace urchin
 		delete [] animFrameData;
 
 		file.close();
-		return (new ConstAnimation(filename, numFrames, numBones, frameRate, skeletonFrames, bboxes));
+
+		auto *constAnimation = new ConstAnimation(filename, numFrames, numBones, frameRate, skeletonFrames, bboxes);
+
+		std::stringstream logStream;
+		logStream<<"Animation "<<filename<<" loaded: "<<constAnimation->getUncompressedMemorySize()<<" bytes before compression, "
+				<<constAnimation->getMemorySize()<<" bytes after compression.";
+		Logger::logger().logInfo(logStream.str());
+
+		return constAnimation;
+	}
+
+	ConstAnimation *LoaderUrchinAnim::loadFromFrlFile(const std::string &filename, FrlFileReader &frlFileReader)
+	{
+		auto numFrames = frlFileReader.readValue<unsigned int>();
+		auto frameRate = frlFileReader.readValue<unsigned int>();
+		auto uncompressedMemorySize = frlFileReader.readValue<unsigned int>();
+		auto globalBBoxMin = frlFileReader.readValue<Point3<float>>();
+		auto globalBBoxMax = frlFileReader.readValue<Point3<float>>();
+
+		auto numBones = frlFileReader.readValue<unsigned int>();
+		std::vector<std::string> boneNames(numBones);
+		std::vector<int> boneParents(numBones);
+		std::vector<BoneTrack> boneTracks(numBones);
+		for(unsigned int i=0; i<numBones; ++i)
+		{
+			boneNames[i] = frlFileReader.readString();
+			boneParents[i] = frlFileReader.readValue<int>();
+
+			BoneTrack &track = boneTracks[i];
+			unsigned int numKeyFrames, numKeys;
+			const auto *positionKeyFrames = frlFileReader.readArray<unsigned short>(numKeyFrames);
+			track.positionKeyFrames.assign(positionKeyFrames, positionKeyFrames + numKeyFrames);
+			const auto *positionKeys = frlFileReader.readArray<unsigned short>(numKeys);
+			track.positionKeys.assign(positionKeys, positionKeys + numKeys);
+			track.positionMin = frlFileReader.readValue<Point3<float>>();
+			track.positionStep = frlFileReader.readValue<Vector3<float>>();
+
+			const auto *orientationKeyFrames = frlFileReader.readArray<unsigned short>(numKeyFrames);
+			track.orientationKeyFrames.assign(orientationKeyFrames, orientationKeyFrames + numKeyFrames);
+			const auto *orientationKeys = frlFileReader.readArray<QuantizedQuaternion<float>>(numKeys);
+			track.orientationKeys.assign(orientationKeys, orientationKeys + numKeys);
+		}
+
+		return new ConstAnimation(filename, numFrames, frameRate, boneNames, boneParents, std::move(boneTracks),
+				AABBox<float>(globalBBoxMin, globalBBoxMax), uncompressedMemorySize);
+	}
+
+	void LoaderUrchinAnim::writeFrlFile(const ConstAnimation *constAnimation, FrlFileWriter &frlFileWriter)
+	{
+		frlFileWriter.writeValue(constAnimation->getNumberFrames());
+		frlFileWriter.writeValue(constAnimation->getFrameRate());
+		frlFileWriter.writeValue(constAnimation->getUncompressedMemorySize());
+		frlFileWriter.writeValue(constAnimation->getOriginalGlobalAABBox().getMin());
+		frlFileWriter.writeValue(constAnimation->getOriginalGlobalAABBox().getMax());
+
+		frlFileWriter.writeValue(constAnimation->getNumberBones());
+		for(unsigned int i=0; i<constAnimation->getNumberBones(); ++i)
+		{
+			frlFileWriter.writeString(constAnimation->getBoneName(i));
+			frlFileWriter.writeValue(constAnimation->getBoneParent(i));
+
+			const BoneTrack &track = constAnimation->getBoneTrack(i);
+			frlFileWriter.writeArray(track.positionKeyFrames.data(), static_cast<unsigned int>(track.positionKeyFrames.size()));
+			frlFileWriter.writeArray(track.positionKeys.data(), static_cast<unsigned int>(track.positionKeys.size()));
+			frlFileWriter.writeValue(track.positionMin);
+			frlFileWriter.writeValue(track.positionStep);
+
+			frlFileWriter.writeArray(track.orientationKeyFrames.data(), static_cast<unsigned int>(track.orientationKeyFrames.size()));
+			frlFileWriter.writeArray(track.orientationKeys.data(), static_cast<unsigned int>(track.orientationKeys.size()));
+		}
 	}
+
 }
@@ -29,6 +29,12 @@ namespace urchin
 			~LoaderUrchinAnim() override = default;
 
 			ConstAnimation *loadFromFile(const std::string &) override;
+			bool isThreadSafe() const override;
+
+		private:
+			ConstAnimation *loadFromTextFile(const std::string &, const std::string &);
+			ConstAnimation *loadFromFrlFile(const std::string &, FrlFileReader &);
+			void writeFrlFile(const ConstAnimation *, FrlFileWriter &);
 	};
 
 }
@@ -1,24 +1,61 @@
 #include <locale>
 #include <stdexcept>
 #include <memory>
+#include <numeric>
 #include "UrchinCommon.h"
 
 #include "loader/model/LoaderUrchinMesh.h"
 
+#define MESH_FRL_FILE_VERSION 2
+#define MESH_MAX_COARSE_LODS 3 //Levels of detail are stored in FRL files: FRL file version must be increased when LOD parameters change
+#define MESH_LOD_TRIANGLES_RATIO 0.5f
+
 namespace urchin
 {
 
+	//arrays of the FRL file are used directly by the meshes: their layout must not change without a new file version
+	static_assert(sizeof(Vertex)==3*sizeof(int), "Unexpected vertex layout");
+	static_assert(sizeof(TextureCoordinate)==2*sizeof(float), "Unexpected texture coordinate layout");
+	static_assert(sizeof(Triangle)==3*sizeof(int), "Unexpected triangle layout");
+	static_assert(sizeof(Weight)==5*sizeof(float), "Unexpected weight layout");
+
+	/**
+	 * Meshes are loaded from a binary FRL file (saved in the save directory) when it is up to date. Otherwise, the text file is
+	 * parsed, the levels of detail are built and the FRL file is written for the next loadings.
+	 */
 	ConstMeshes *LoaderUrchinMesh::loadFromFile(const std::string &filename)
-	{	
-		std::locale::global(std::locale("C")); //for float
-		
+	{
+		std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
+		std::string frlFilePath = FrlFileReader::buildFrlFilePath(filename);
+		std::string md5Sum = std::string(MD5().digestFile(filenamePath.c_str()));
+
+		FrlFileReader frlFileReader(frlFilePath);
+		if(frlFileReader.checkHeader(MESH_FRL_FILE_VERSION, md5Sum))
+		{
+			return loadFromFrlFile(filename, frlFileReader);
+		}
+
+		FrlFileWriter frlFileWriter(frlFilePath, MESH_FRL_FILE_VERSION, md5Sum);
+		ConstMeshes *constMeshes = loadFromTextFile(filename, filenamePath, frlFileWriter);
+		frlFileWriter.commit();
+
+		return constMeshes;
+	}
+
+	bool LoaderUrchinMesh::isThreadSafe() const
+	{
+		return true;
+	}
+
+	ConstMeshes *LoaderUrchinMesh::loadFromTextFile(const std::string &filename, const std::string &filenamePath, FrlFileWriter &frlFileWriter)
+	{
 		std::ifstream file;
 		std::istringstream iss;
+		iss.imbue(std::locale::classic()); //for float
 		std::string buffer;
 		std::string sdata;
 		int idata;
 
-		std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
 		file.open(filenamePath, std::ios::in);
 		if(file.fail())
 		{
@@ -51,6 +88,16 @@ namespace urchin
 		}
 		FileReaderUtil::nextLine(file, buffer); //buffer = "}"
 
+		frlFileWriter.writeValue(numMeshes);
+		frlFileWriter.writeValue(numBones);
+		for(const auto &bone : baseSkeleton)
+		{
+			frlFileWriter.writeString(bone.name);
+			frlFileWriter.writeValue(bone.parent);
+			frlFileWriter.writeValue(bone.pos);
+			frlFileWriter.writeValue(bone.orient);
+		}
+
 		//mesh
 		std::vector<const ConstMesh *> constMeshes;
 		for(unsigned int ii=0; ii<numMeshes; ii++)
@@ -110,8 +157,22 @@ namespace urchin
 				iss >> sdata >> idata >> weights[i].bone >> weights[i].bias >> sdata >> weights[i].pos.X >> weights[i].pos.Y >> weights[i].pos.Z;
 			}
 			FileReaderUtil::nextLine(file, buffer); //buffer= "}"
-			
-			constMeshes.push_back(new ConstMesh(materialFilename, vertices, textureCoordinates, triangles, weights, baseSkeleton));
+
+			frlFileWriter.writeString(materialFilename);
+			frlFileWriter.writeArray(vertices.data(), numVertices);
+			frlFileWriter.writeArray(textureCoordinates.data(), numVertices);
+			frlFileWriter.writeArray(triangles.data(), numTriangles);
+			frlFileWriter.writeArray(weights.data(), numWeights);
+
+			auto *constMesh = new ConstMesh(materialFilename, vertices, textureCoordinates, triangles, weights, baseSkeleton);
+			constMesh->buildLods(MESH_MAX_COARSE_LODS, MESH_LOD_TRIANGLES_RATIO);
+
+			const std::vector<unsigned int> &coarseLodsNumberTriangles = constMesh->getCoarseLodsNumberTriangles();
+			unsigned int numCoarseLodsTriangles = std::accumulate(coarseLodsNumberTriangles.begin(), coarseLodsNumberTriangles.end(), 0u);
+			frlFileWriter.writeArray(constMesh->getCoarseLodsTriangles(), numCoarseLodsTriangles);
+			frlFileWriter.writeArray(coarseLodsNumberTriangles.data(), static_cast<unsigned int>(coarseLodsNumberTriangles.size()));
+
+			constMeshes.push_back(constMesh);
 		}
 		
 		file.close();
@@ -119,4 +180,53 @@ namespace urchin
 		return new ConstMeshes(filename, constMeshes);
 	}
 
+	ConstMeshes *LoaderUrchinMesh::loadFromFrlFile(const std::string &filename, FrlFileReader &frlFileReader)
+	{
+		auto numMeshes = frlFileReader.readValue<unsigned int>();
+
+		//bones
+		auto numBones = frlFileReader.readValue<unsigned int>();
+		std::vector<Bone> baseSkeleton(numBones);
+		for(auto &bone : baseSkeleton)
+		{
+			bone.name = frlFileReader.readString();
+			bone.parent = frlFileReader.readValue<int>();
+			bone.pos = frlFileReader.readValue<Point3<float>>();
+			bone.orient = frlFileReader.readValue<Quaternion<float>>();
+		}
+
+		//mesh: arrays are not copied
+		std::vector<const ConstMesh *> constMeshes;
+		for(unsigned int i=0; i<numMeshes; ++i)
+		{
+			std::string materialFilename = frlFileReader.readString();
+
+			unsigned int numVertices, numTextureCoordinates, numTriangles, numWeights;
+			const auto *vertices = frlFileReader.readArray<Vertex>(numVertices);
+			const auto *textureCoordinates = frlFileReader.readArray<TextureCoordinate>(numTextureCoordinates);
+			const auto *triangles = frlFileReader.readArray<Triangle>(numTriangles);
+			const auto *weights = frlFileReader.readArray<Weight>(numWeights);
+			if(numTextureCoordinates!=numVertices)
+			{
+				throw std::runtime_error("File " + frlFileReader.getMappedFile()->getFilenamePath() + " is corrupted.");
+			}
+
+			unsigned int numCoarseLodsTriangles, numCoarseLods;
+			const auto *coarseLodsTriangles = frlFileReader.readArray<Triangle>(numCoarseLodsTriangles);
+			const auto *coarseLodsNumberTriangles = frlFileReader.readArray<unsigned int>(numCoarseLods);
+			std::vector<unsigned int> coarseLodsNumberTrianglesVector(coarseLodsNumberTriangles, coarseLodsNumberTriangles + numCoarseLods);
+			if(std::accumulate(coarseLodsNumberTrianglesVector.begin(), coarseLodsNumberTrianglesVector.end(), 0u)!=numCoarseLodsTriangles)
+			{
+				throw std::runtime_error("File " + frlFileReader.getMappedFile()->getFilenamePath() + " is corrupted.");
+			}
+
+			auto *constMesh = new ConstMesh(materialFilename, numVertices, vertices, textureCoordinates, numTriangles, triangles,
+					numWeights, weights, baseSkeleton, frlFileReader.getMappedFile());
+			constMesh->setLods(coarseLodsTriangles, coarseLodsNumberTrianglesVector);
+			constMeshes.push_back(constMesh);
+		}
+
+		return new ConstMeshes(filename, constMeshes);
+	}
+
 }
@@ -2,6 +2,7 @@
 #define URCHINENGINE_LOADERURCHINMESH_H
 
 #include <string>
+#include <vector>
 
 #include "resources/model/ConstMeshes.h"
 #include "loader/Loader.h"
@@ -15,6 +16,11 @@ namespace urchin
 			~LoaderUrchinMesh() override = default;
 
 			ConstMeshes *loadFromFile(const std::string &) override;
+			bool isThreadSafe() const override;
+
+		private:
+			ConstMeshes *loadFromTextFile(const std::string &, const std::string &, FrlFileWriter &);
+			ConstMeshes *loadFromFrlFile(const std::string &, FrlFileReader &);
 	};
 
 }
@@ -1,4 +1,5 @@
 #include "resources/MediaManager.h"
+#include "resources/model/MeshService.h"
 #include "loader/image/LoaderTGA.h"
 #include "loader/image/LoaderPNG.h"
 #include "loader/model/LoaderUrchinMesh.h"
@@ -20,14 +21,130 @@ namespace urchin
 		loadersRegistry.insert(std::pair<std::string, LoaderInterface*>("mtr", new LoaderMTR));
 
 		loadersRegistry.insert(std::pair<std::string, LoaderInterface*>("fnt", new LoaderFNT));
+
+		std::promise<void> noPreloadingPromise;
+		noPreloadingPromise.set_value();
+		noPreloading = noPreloadingPromise.get_future().share();
 	}
 	
 	MediaManager::~MediaManager()
 	{
+		releasePreloadedMedias();
+		preloadingPool.reset();
+
 		for(const auto &loaderRegistry : loadersRegistry)
 		{
 			delete loaderRegistry.second;
 		}
 	}
 
+	/**
+	 * Load the resource in background when its loader is thread-safe. Other resources are loaded by getMedia().
+	 * The preloaded resources are kept until releasePreloadedMedias() is called. This method and getMedia() must be
+	 * called by the same thread.
+	 * @return Future ready when the preloading is finished. Several preloadings of the same resource share the same future.
+	 */
+	std::shared_future<void> MediaManager::preloadMedia(const std::string &filename)
+	{
+		std::lock_guard<std::mutex> lock(preloadingMutex);
+
+		auto itPreloading = preloadingMedias.find(filename);
+		if(itPreloading!=preloadingMedias.end())
+		{
+			return itPreloading->second;
+		}
+
+		LoaderInterface *loader = findLoader(filename);
+		if(!loader || !loader->isThreadSafe())
+		{
+			return noPreloading;
+		}
+
+		Resource *resource = ResourceManager::instance()->getResource<Resource>(filename);
+		if(resource)
+		{ //already charged: keep it until the release of the preloaded resources
+			preloadedMedias.push_back(resource);
+			return noPreloading;
+		}
+
+		if(!preloadingPool)
+		{ //singletons are not thread-safe: create the singletons used by the loaders before starting the loading threads
+			ResourceManager::instance();
+			FileSystem::instance();
+			ConfigService::instance();
+			MeshService::instance();
+
+			preloadingPool = std::make_unique<TaskPool>();
+		}
+
+		std::shared_future<void> preloading = preloadingPool->submit([this, loader, filename]() {
+			Resource *loadedResource = loader->loadResource(filename);
+			ResourceManager::instance()->addResource(filename, loadedResource);
+
+			std::lock_guard<std::mutex> lock(preloadingMutex);
+			preloadedMedias.push_back(loadedResource);
+		}).share();
+		preloadingMedias[filename] = preloading;
+
+		return preloading;
+	}
+
+	/**
+	 * Wait the end of the preloadings and release the preloaded resources: resources not requested by getMedia() are destroyed.
+	 */
+	void MediaManager::releasePreloadedMedias()
+	{
+		std::map<std::string, std::shared_future<void>> preloadings;
+		{
+			std::lock_guard<std::mutex> lock(preloadingMutex);
+			preloadings.swap(preloadingMedias);
+		}
+		for(const auto &preloading : preloadings)
+		{
+			preloading.second.wait();
+		}
+
+		std::vector<Resource *> resources;
+		{
+			std::lock_guard<std::mutex> lock(preloadingMutex);
+			resources.swap(preloadedMedias);
+		}
+		for(Resource *resource : resources)
+		{
+			resource->release();
+		}
+	}
+
+	LoaderInterface *MediaManager::findLoader(const std::string &filename) const
+	{
+		std::string extension = filename.substr(filename.find_last_of('.')+1);
+
+		auto it = loadersRegistry.find(extension);
+		if(it==loadersRegistry.end())
+		{
+			return nullptr;
+		}
+		return it->second;
+	}
+
+	/**
+	 * Wait the end of the preloading of the resource when it is preloaded. A preloading failure is ignored: the resource
+	 * will be loaded again by the calling thread in order to report the error.
+	 */
+	void MediaManager::waitPreloading(const std::string &filename)
+	{
+		std::shared_future<void> preloading;
+		{
+			std::lock_guard<std::mutex> lock(preloadingMutex);
+			auto itPreloading = preloadingMedias.find(filename);
+			if(itPreloading==preloadingMedias.end())
+			{
+				return;
+			}
+			preloading = itPreloading->second;
+		}
+
+		preloading.wait();
+	}
+
 }
@@ -2,7 +2,11 @@
 #define URCHINENGINE_MEDIAMANAGER_H
 
 #include <map>
+#include <vector>
 #include <string>
+#include <memory>
+#include <mutex>
+#include <future>
 #include <stdexcept>
 #include "UrchinCommon.h"
 
@@ -18,7 +22,9 @@ namespace urchin
 {
 
 	/**
-	 * Find the appropriate loader according to the extension of the file and load the resource
+	 * Find the appropriate loader according to the extension of the file and load the resource.
+	 * Resources having a thread-safe loader can be preloaded in background: a resource requested by getMedia() while it
+	 * is preloaded is returned once its preloading is finished.
 	 */
 	class MediaManager : public Singleton<MediaManager>
 	{
@@ -26,12 +32,24 @@ namespace urchin
 			friend class Singleton<MediaManager>;
 			
 			template<class T> T* getMedia(const std::string &);
+
+			std::shared_future<void> preloadMedia(const std::string &);
+			void releasePreloadedMedias();
 			
 		private:
 			MediaManager();
 			~MediaManager() override;
 
+			LoaderInterface *findLoader(const std::string &) const;
+			void waitPreloading(const std::string &);
+
 			std::map<std::string, LoaderInterface *> loadersRegistry;
+
+			std::shared_future<void> noPreloading;
+			std::unique_ptr<TaskPool> preloadingPool;
+			std::mutex preloadingMutex;
+			std::map<std::string, std::shared_future<void>> preloadingMedias;
+			std::vector<Resource *> preloadedMedias;
 	};
 
 	#include "MediaManager.inl"
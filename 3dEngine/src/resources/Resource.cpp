@@ -38,13 +38,27 @@ namespace urchin
 	}
 
 	void Resource::release()
-	{	
-		if(--refCount==0)
+	{
+		if(name.empty())
 		{
-			delete this;
+			if(--refCount==0)
+			{
+				delete this;
+			}
+		}else
+		{ //resource managed: could be kept in cache
+			ResourceManager::instance()->releaseResource(this);
 		}
 	}
 
+	/**
+	 * @return Memory size (in bytes) used by the resource. Used to respect the cache budget of the resource manager.
+	 */
+	unsigned int Resource::getMemorySize() const
+	{
+		return 0;
+	}
+
 	/**
 	 * Deleter for std::shared_ptr
 	 */
@@ -2,6 +2,7 @@
 #define URCHINENGINE_RESOURCE_H
 
 #include <string>
+#include <atomic>
 
 namespace urchin
 {
@@ -9,6 +10,8 @@ namespace urchin
 	class Resource
 	{
 		public:
+			friend class ResourceManager;
+
 			Resource();
 			virtual ~Resource();
 		
@@ -19,6 +22,8 @@ namespace urchin
 			void addRef();
 			void release();
 
+			virtual unsigned int getMemorySize() const;
+
 			class ResourceDeleter
 			{
 				public:
@@ -27,7 +32,7 @@ namespace urchin
 
 		private:
 			std::string name;
-			unsigned int refCount;
+			std::atomic<unsigned int> refCount;
 	};
 
 }
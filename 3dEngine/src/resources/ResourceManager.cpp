@@ -2,42 +2,147 @@
 #include "UrchinCommon.h"
 
 #include "resources/ResourceManager.h"
+#include "resources/image/Image.h"
+#include "resources/model/ConstMeshes.h"
+#include "resources/model/ConstAnimation.h"
 
 namespace urchin
 {
-	
+
 	ResourceManager::ResourceManager() :
 			Singleton<ResourceManager>()
 	{
-		
+		setCacheBudget<Image>(static_cast<std::size_t>(ConfigService::instance()->getUnsignedIntValue("resource.imageCacheBudget")) * 1024);
+		setCacheBudget<ConstMeshes>(static_cast<std::size_t>(ConfigService::instance()->getUnsignedIntValue("resource.meshCacheBudget")) * 1024);
+		setCacheBudget<ConstAnimation>(static_cast<std::size_t>(ConfigService::instance()->getUnsignedIntValue("resource.animationCacheBudget")) * 1024);
 	}
 
 	ResourceManager::~ResourceManager()
 	{
-		if (!mResources.empty())
+		purgeCache();
+
+		std::vector<std::string> resourceNames = resourceCache.getResourceNames();
+		if (!resourceNames.empty())
 		{
 			std::stringstream logStream;
 			logStream<<"Resources not released:"<<std::endl;
-			for (std::map<std::string, Resource *>::const_iterator i = mResources.begin(); i != mResources.end(); ++i)
+			for (const auto &resourceName : resourceNames)
 			{
-				logStream<< " - " << i->second->getName() << std::endl;
+				logStream<< " - " << resourceName << std::endl;
 			}
 			Logger::logger().logError(logStream.str());
 		}
 	}
 
+	/**
+	 * @return Resource with a new reference or null if the resource is not loaded
+	 */
+	Resource *ResourceManager::findResource(const std::string &name)
+	{
+		std::lock_guard<std::mutex> lock(resourcesMutex);
+
+		Resource *resource = resourceCache.acquire(name);
+		if(resource)
+		{
+			resource->addRef();
+		}
+
+		return resource;
+	}
+
+	/**
+	 * Add a resource in the manager. A resource of the same name is replaced: it is destroyed when it is kept in cache,
+	 * otherwise it is destroyed on its last release.
+	 */
 	void ResourceManager::addResource(const std::string &name, Resource *resource)
 	{
-		mResources[name] = resource;
-		resource->setName(name);
+		std::vector<Resource *> replacedResources;
+		{
+			std::lock_guard<std::mutex> lock(resourcesMutex);
+			resourceCache.add(name, resource, std::type_index(typeid(*resource)), replacedResources);
+			resource->setName(name);
+		}
+
+		destroyResources(replacedResources);
 	}
 
 	void ResourceManager::removeResource(const std::string &name)
 	{
-		auto it = mResources.find(name);
-		if(it!=mResources.end())
+		std::lock_guard<std::mutex> lock(resourcesMutex);
+		resourceCache.remove(name);
+	}
+
+	/**
+	 * Destroy all the unreferenced resources kept in cache. Resources can use the graphic API: this method should be called
+	 * before the destruction of the graphic context.
+	 */
+	void ResourceManager::purgeCache()
+	{
+		std::vector<Resource *> evictedResources;
+		do
+		{ //destroyed resources can release other resources (e.g.: material releases its images)
+			evictedResources.clear();
+			{
+				std::lock_guard<std::mutex> lock(resourcesMutex);
+				resourceCache.purge(evictedResources);
+			}
+
+			destroyResources(evictedResources);
+		}while(!evictedResources.empty());
+	}
+
+	/**
+	 * @return Statistics of all types of resources
+	 */
+	ResourceCacheStatistics ResourceManager::getStatistics() const
+	{
+		std::lock_guard<std::mutex> lock(resourcesMutex);
+		return resourceCache.getStatistics();
+	}
+
+	void ResourceManager::setCacheBudget(std::type_index type, std::size_t budget)
+	{
+		std::vector<Resource *> evictedResources;
+		{
+			std::lock_guard<std::mutex> lock(resourcesMutex);
+			resourceCache.setBudget(type, budget, evictedResources);
+		}
+
+		destroyResources(evictedResources);
+	}
+
+	ResourceCacheStatistics ResourceManager::getStatistics(std::type_index type) const
+	{
+		std::lock_guard<std::mutex> lock(resourcesMutex);
+		return resourceCache.getStatistics(type);
+	}
+
+	/**
+	 * Release a reference on a managed resource. The reference count is decreased under the lock: a resource cannot be
+	 * requested by another thread while it is cached or destroyed.
+	 */
+	void ResourceManager::releaseResource(Resource *resource)
+	{
+		std::vector<Resource *> evictedResources;
+		{
+			std::lock_guard<std::mutex> lock(resourcesMutex);
+			if(--resource->refCount > 0)
+			{
+				return;
+			}
+
+			resourceCache.release(resource->getName(), resource, evictedResources);
+		}
+
+		destroyResources(evictedResources);
+	}
+
+	void ResourceManager::destroyResources(const std::vector<Resource *> &resources) const
+	{
+		for(Resource *resource : resources)
 		{
-			mResources.erase(it);
+			resource->setName(""); //already removed from the manager
+			delete resource;
 		}
 	}
 
@@ -1,8 +1,10 @@
 #ifndef URCHINENGINE_RESOURCEMANAGER_H
 #define URCHINENGINE_RESOURCEMANAGER_H
 
-#include <map>
+#include <vector>
 #include <string>
+#include <mutex>
+#include <typeindex>
 #include "UrchinCommon.h"
 
 #include "resources/Resource.h"
@@ -10,20 +12,39 @@
 namespace urchin
 {
 
+	/**
+	 * Manager of the loaded resources. A resource which is not referenced anymore is kept in cache when its type has a
+	 * cache budget: it can be requested again without being reloaded. When the memory of the cached resources of a type
+	 * exceeds its budget, the least recently used resources are destroyed.
+	 */
 	class ResourceManager : public Singleton<ResourceManager>
 	{
 		public:
 			friend class Singleton<ResourceManager>;
+			friend class Resource;
 			
-			template<class T> T* getResource(const std::string &) const;
+			template<class T> T* getResource(const std::string &);
 			void addResource(const std::string &, Resource *);
 			void removeResource(const std::string &);
-			
+
+			template<class T> void setCacheBudget(std::size_t);
+			void purgeCache();
+
+			ResourceCacheStatistics getStatistics() const;
+			template<class T> ResourceCacheStatistics getStatistics() const;
+
 		private:
 			ResourceManager();
-			virtual ~ResourceManager();
+			~ResourceManager() override;
+
+			Resource *findResource(const std::string &);
+			void setCacheBudget(std::type_index, std::size_t);
+			ResourceCacheStatistics getStatistics(std::type_index) const;
+			void releaseResource(Resource *);
+			void destroyResources(const std::vector<Resource *> &) const;
 
-			std::map<std::string, Resource *> mResources;
+			mutable std::mutex resourcesMutex; //resources can be added by the loading threads
+			ResourceCache<Resource *> resourceCache;
 	};
 
 	#include "ResourceManager.inl"
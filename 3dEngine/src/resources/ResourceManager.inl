@@ -1,11 +1,17 @@
-template<class T> T* ResourceManager::getResource(const std::string &name) const
+template<class T> T* ResourceManager::getResource(const std::string &name)
 {
-	std::map<std::string, Resource*>::const_iterator it = mResources.find(name);
-	if(it!=mResources.end())
-	{
-		it->second->addRef();
-		return static_cast<T*>(it->second);
-	}
-	
-	return nullptr;
+	return static_cast<T*>(findResource(name));
+}
+
+/**
+ * @param budget Memory (in bytes) of the unreferenced resources of type T kept in cache. Zero disables the cache.
+ */
+template<class T> void ResourceManager::setCacheBudget(std::size_t budget)
+{
+	setCacheBudget(std::type_index(typeid(T)), budget);
+}
+
+template<class T> ResourceCacheStatistics ResourceManager::getStatistics() const
+{
+	return getStatistics(std::type_index(typeid(T)));
 }
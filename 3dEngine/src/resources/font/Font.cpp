@@ -8,7 +8,8 @@ namespace urchin
 		glyph(glyph),
 		spaceBetweenLetters(spaceBetweenLetters),
 		spaceBetweenLines(spaceBetweenLines),
-		height(height)
+		height(height),
+		glyphRunCache(buildFontMetrics(), ConfigService::instance()->getUnsignedIntValue("gui.glyphRunCacheSize"))
 	{
 		
 	}
@@ -49,4 +50,27 @@ namespace urchin
 		return height;
 	}
 
+	/**
+	* @return Text laid out with the letters of the font texture. Glyph runs of the most recently used texts are cached.
+	*/
+	std::shared_ptr<const GlyphRun> Font::getGlyphRun(const std::string &text, int maxLength)
+	{
+		return glyphRunCache.getGlyphRun(text, maxLength);
+	}
+
+	FontMetrics Font::buildFontMetrics() const
+	{
+		FontMetrics fontMetrics;
+		fontMetrics.glyphs.reserve(256);
+		for(unsigned int i=0; i<256; ++i)
+		{
+			fontMetrics.glyphs.push_back({glyph[i].width, glyph[i].height, glyph[i].shift});
+		}
+		fontMetrics.spaceBetweenLetters = spaceBetweenLetters;
+		fontMetrics.spaceBetweenLines = spaceBetweenLines;
+		fontMetrics.height = height;
+		fontMetrics.atlasDimension = getDimensionTexture();
+		return fontMetrics;
+	}
+
 }
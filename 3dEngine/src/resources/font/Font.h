@@ -1,6 +1,8 @@
 #ifndef URCHINENGINE_FONT_H
 #define URCHINENGINE_FONT_H
 
+#include <string>
+#include <memory>
 #include "UrchinCommon.h"
 
 #include "resources/Resource.h"
@@ -29,12 +31,18 @@ namespace urchin
 			unsigned int getSpaceBetweenLetters() const;
 			unsigned int getSpaceBetweenLines() const;
 			unsigned int getHeight() const;
+
+			std::shared_ptr<const GlyphRun> getGlyphRun(const std::string &, int maxLength = -1);
 		
 		private:
+			FontMetrics buildFontMetrics() const;
+
 			Image *texAlphabet;
 		
 			Glyph *glyph;
 			unsigned int spaceBetweenLetters, spaceBetweenLines, height;
+
+			GlyphRunCache glyphRunCache;
 	};
 
 }
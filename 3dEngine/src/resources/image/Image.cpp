@@ -1,4 +1,6 @@
 #include <stdexcept>
+#include <utility>
+#include <memory>
 
 #include "resources/image/Image.h"
 #include "texture/TextureManager.h"
@@ -11,9 +13,10 @@ namespace urchin
 			height(height),
 			format(format),
             channelPrecision(ChannelPrecision::CHANNEL_8),
-            texels8(texels8),
+            texels8(std::move(texels8)),
 			isTexture(false),
-			textureID(0)
+			textureID(0),
+			textureMemorySize(0)
 	{
 
 	}
@@ -23,9 +26,10 @@ namespace urchin
 			height(height),
 			format(format),
             channelPrecision(ChannelPrecision::CHANNEL_16),
-            texels16(texels16),
+            texels16(std::move(texels16)),
 			isTexture(false),
-			textureID(0)
+			textureID(0),
+			textureMemorySize(0)
 	{
 
 	}
@@ -170,19 +174,50 @@ namespace urchin
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, needRepeat ? GL_REPEAT : GL_CLAMP_TO_EDGE);
 		glTexParameterf(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, needRepeat ? GL_REPEAT : GL_CLAMP_TO_EDGE);
 		glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
-		glTexImage2D(GL_TEXTURE_2D, 0, retrieveInternalFormat(), width, height, 0, retrieveFormat(), GL_UNSIGNED_BYTE, &texels8[0]);
 
-		if(needMipMaps)
+		std::unique_ptr<BakedTexture> bakedTexture = needMipMaps ? TextureManager::instance()->loadBakedTexture(*this) : nullptr;
+		if(bakedTexture)
+		{ //mipmap levels computed and compressed on CPU
+			GLenum compressedFormat = bakedTexture->getBlockFormat()==BlockCompressor::BC3 ? GL_COMPRESSED_RGBA_S3TC_DXT5_EXT : GL_COMPRESSED_RGB_S3TC_DXT1_EXT;
+			for(unsigned int level=0; level<bakedTexture->getLevelsCount(); ++level)
+			{
+				glCompressedTexImage2D(GL_TEXTURE_2D, level, compressedFormat, bakedTexture->getLevelWidth(level), bakedTexture->getLevelHeight(level),
+						0, bakedTexture->getLevelSize(level), bakedTexture->getLevelData(level));
+			}
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, bakedTexture->getLevelsCount() - 1);
+			textureMemorySize = static_cast<unsigned int>(bakedTexture->getMemorySize());
+		}else
 		{
-			glGenerateMipmap(GL_TEXTURE_2D);
+			glTexImage2D(GL_TEXTURE_2D, 0, retrieveInternalFormat(), width, height, 0, retrieveFormat(), GL_UNSIGNED_BYTE, &texels8[0]);
+			textureMemorySize = width * height * retrieveComponentsCount();
+
+			if(needMipMaps)
+			{
+				glGenerateMipmap(GL_TEXTURE_2D);
+				textureMemorySize += textureMemorySize / 3;
+			}
 		}
 
 		texels8.clear(); //the API has its own copy
+		texels8.shrink_to_fit();
 		isTexture=true;
 
 		return textureID;
 	}
 
+	/**
+	 * @return Memory size of the texels (in bytes). Once transformed into a texture, the memory size is the estimated size
+	 * of the texture on the graphic card.
+	 */
+	unsigned int Image::getMemorySize() const
+	{
+		if(isTexture)
+		{
+			return textureMemorySize;
+		}
+		return static_cast<unsigned int>(texels8.capacity() + texels16.capacity() * sizeof(uint16_t));
+	}
+
 	unsigned int Image::getTextureID() const
 	{
 		if(!isTexture)
@@ -41,6 +41,8 @@ namespace urchin
 		
 			unsigned int toTexture(bool, bool, bool);
 			unsigned int getTextureID() const;
+
+			unsigned int getMemorySize() const override;
 			
 		private:
 			unsigned int width;
@@ -52,6 +54,7 @@ namespace urchin
 			
 			bool isTexture;
 			unsigned int textureID;
+			unsigned int textureMemorySize;
 	};
 
 }
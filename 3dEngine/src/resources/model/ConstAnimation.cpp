@@ -1,39 +1,254 @@
 #include <limits>
+#include <algorithm>
+#include <stdexcept>
+#include <cmath>
 
 #include "resources/model/ConstAnimation.h"
 #include "resources/model/boundingbox/SplitBoundingBox.h"
 
 namespace urchin
 {
-	
+
+	constexpr float ConstAnimation::POSITION_TOLERANCE_FACTOR;
+	constexpr float ConstAnimation::ORIENTATION_TOLERANCE;
+	constexpr unsigned int ConstAnimation::MAX_KEY_INTERVAL;
+
+	constexpr unsigned int BoneTrackCursor::NO_KEY;
+
+	BoneTrackCursor::BoneTrackCursor() :
+		positionKeyIndex(NO_KEY),
+		positionStartFrame(1.0f),
+		positionEndFrame(0.0f),
+		positionInvFrameLength(0.0f),
+		orientationKeyIndex(NO_KEY),
+		orientationStartFrame(1.0f),
+		orientationEndFrame(0.0f),
+		orientationInvFrameLength(0.0f)
+	{ //empty segments: decoded at first sampling
+
+	}
+
+	/**
+	 * @param skeletonFrames Skeleton of each frame. Bones are compressed: the data are not kept.
+	 * @param bboxes Bounding boxes of each animation frames (not transformed)
+	 */
 	ConstAnimation::ConstAnimation(const std::string &animationFilename, unsigned int numFrames, unsigned int numBones,
-			unsigned int frameRate,	const Bone *const * skeletonFrames, const AABBox<float>*const * bboxes) :
+			unsigned int frameRate,	const std::vector<std::vector<Bone>> &skeletonFrames, const std::vector<AABBox<float>> &bboxes) :
 		animationFilename(animationFilename),
 		numFrames(numFrames),
 		numBones(numBones),
 		frameRate(frameRate),
-		skeletonFrames(skeletonFrames),
-		bboxes(bboxes)
+		uncompressedMemorySize(numFrames * numBones * sizeof(Bone))
 	{
+		if(numFrames==0 || numFrames > std::numeric_limits<unsigned short>::max())
+		{
+			throw std::invalid_argument("Invalid number of frames (" + std::to_string(numFrames) + ") for animation: " + animationFilename);
+		}
+
 		//determines the bounding box
-		originalGlobalBBox = AABBox<float>(bboxes[0]->getMin(), bboxes[0]->getMax());
+		originalGlobalBBox = AABBox<float>(bboxes[0].getMin(), bboxes[0].getMax());
 		for(unsigned int i=0; i<numFrames; ++i)
 		{
-			originalGlobalBBox = originalGlobalBBox.merge(*bboxes[i]);
+			originalGlobalBBox = originalGlobalBBox.merge(bboxes[i]);
 		}
 		originalGlobalSplitBBoxes = SplitBoundingBox().split(originalGlobalBBox);
+
+		//bone names and parents are identical in all frames
+		boneNames.reserve(numBones);
+		boneParents.reserve(numBones);
+		for(const auto &bone : skeletonFrames[0])
+		{
+			boneNames.push_back(bone.name);
+			boneParents.push_back(bone.parent);
+		}
+
+		//compress bone tracks
+		float positionTolerance = POSITION_TOLERANCE_FACTOR * std::max(originalGlobalBBox.getMaxHalfSize(), std::numeric_limits<float>::epsilon());
+		boneTracks.resize(numBones);
+		for(unsigned int boneIndex=0; boneIndex<numBones; ++boneIndex)
+		{
+			compressPositionTrack(skeletonFrames, boneIndex, positionTolerance, boneTracks[boneIndex]);
+			compressOrientationTrack(skeletonFrames, boneIndex, ORIENTATION_TOLERANCE, boneTracks[boneIndex]);
+		}
 	}
 
-	ConstAnimation::~ConstAnimation()
+	/**
+	 * Constructor for bone tracks already compressed.
+	 * @param boneTracks Compressed track of each bone
+	 * @param originalGlobalBBox Bounding box of all animation frames (not transformed)
+	 * @param uncompressedMemorySize Memory size of the bones before compression (in bytes)
+	 */
+	ConstAnimation::ConstAnimation(const std::string &animationFilename, unsigned int numFrames, unsigned int frameRate,
+			const std::vector<std::string> &boneNames, const std::vector<int> &boneParents, std::vector<BoneTrack> &&boneTracks,
+			const AABBox<float> &originalGlobalBBox, unsigned int uncompressedMemorySize) :
+		animationFilename(animationFilename),
+		numFrames(numFrames),
+		numBones(static_cast<unsigned int>(boneTracks.size())),
+		frameRate(frameRate),
+		boneNames(boneNames),
+		boneParents(boneParents),
+		boneTracks(std::move(boneTracks)),
+		originalGlobalBBox(originalGlobalBBox),
+		originalGlobalSplitBBoxes(SplitBoundingBox().split(originalGlobalBBox)),
+		uncompressedMemorySize(uncompressedMemorySize)
 	{
-		for(unsigned int i=0;i<numFrames;i++)
+		if(numFrames==0 || numFrames > std::numeric_limits<unsigned short>::max())
+		{
+			throw std::invalid_argument("Invalid number of frames (" + std::to_string(numFrames) + ") for animation: " + animationFilename);
+		}
+		if(this->boneNames.size()!=numBones || this->boneParents.size()!=numBones)
 		{
-			delete [] skeletonFrames[i];
-			delete bboxes[i];
+			throw std::invalid_argument("Invalid number of bone names or parents for animation: " + animationFilename);
 		}
+	}
+
+	void ConstAnimation::compressPositionTrack(const std::vector<std::vector<Bone>> &skeletonFrames, unsigned int boneIndex, float tolerance, BoneTrack &track) const
+	{
+		//quantize all positions in the track bounds
+		Point3<float> positionMin = skeletonFrames[0][boneIndex].pos;
+		Point3<float> positionMax = skeletonFrames[0][boneIndex].pos;
+		for(unsigned int frame=1; frame<numFrames; ++frame)
+		{
+			const Point3<float> &position = skeletonFrames[frame][boneIndex].pos;
+			for(unsigned int i=0; i<3; ++i)
+			{
+				positionMin[i] = std::min(positionMin[i], position[i]);
+				positionMax[i] = std::max(positionMax[i], position[i]);
+			}
+		}
+
+		track.positionMin = positionMin;
+		auto quantizationMax = static_cast<float>(std::numeric_limits<unsigned short>::max());
+		track.positionStep = positionMin.vector(positionMax) / quantizationMax;
 
-		delete [] skeletonFrames;
-		delete [] bboxes;
+		std::vector<unsigned short> quantizedPositions(numFrames * 3);
+		for(unsigned int frame=0; frame<numFrames; ++frame)
+		{
+			for(unsigned int i=0; i<3; ++i)
+			{
+				float normalizedValue = track.positionStep[i] > 0.0f ? (skeletonFrames[frame][boneIndex].pos[i] - positionMin[i]) / track.positionStep[i] : 0.0f;
+				quantizedPositions[frame * 3 + i] = static_cast<unsigned short>(std::lround(std::min(normalizedValue, quantizationMax)));
+			}
+		}
+
+		track.positionKeyFrames.clear();
+		track.positionKeys.clear();
+		track.positionKeys.insert(track.positionKeys.end(), quantizedPositions.begin(), quantizedPositions.begin() + 3);
+		track.positionKeyFrames.push_back(0);
+
+		//constant track: a single key
+		Point3<float> firstPosition = decodePosition(track, 0);
+		bool isConstant = true;
+		for(unsigned int frame=1; frame<numFrames && isConstant; ++frame)
+		{
+			isConstant = firstPosition.squareDistance(skeletonFrames[frame][boneIndex].pos) <= tolerance * tolerance;
+		}
+		if(isConstant)
+		{
+			return;
+		}
+
+		//keep the key frames which cannot be linearly interpolated
+		for(unsigned int startFrame=0, endFrame=1; endFrame<numFrames;)
+		{
+			unsigned int candidateEndFrame = endFrame + 1;
+			bool canExtend = candidateEndFrame < numFrames && candidateEndFrame - startFrame <= MAX_KEY_INTERVAL;
+			if(canExtend)
+			{
+				Point3<float> startPosition = track.positionMin.translate(track.positionStep * Vector3<float>(quantizedPositions[startFrame * 3], quantizedPositions[startFrame * 3 + 1], quantizedPositions[startFrame * 3 + 2]));
+				Point3<float> endPosition = track.positionMin.translate(track.positionStep * Vector3<float>(quantizedPositions[candidateEndFrame * 3], quantizedPositions[candidateEndFrame * 3 + 1], quantizedPositions[candidateEndFrame * 3 + 2]));
+				for(unsigned int frame=startFrame+1; frame<candidateEndFrame && canExtend; ++frame)
+				{
+					float t = static_cast<float>(frame - startFrame) / static_cast<float>(candidateEndFrame - startFrame);
+					Point3<float> interpolatedPosition = startPosition.translate(startPosition.vector(endPosition) * t);
+					canExtend = interpolatedPosition.squareDistance(skeletonFrames[frame][boneIndex].pos) <= tolerance * tolerance;
+				}
+			}
+
+			if(canExtend)
+			{
+				endFrame = candidateEndFrame;
+			}else
+			{
+				track.positionKeyFrames.push_back(static_cast<unsigned short>(endFrame));
+				track.positionKeys.insert(track.positionKeys.end(), quantizedPositions.begin() + endFrame * 3, quantizedPositions.begin() + endFrame * 3 + 3);
+				startFrame = endFrame;
+				endFrame = startFrame + 1;
+			}
+		}
+	}
+
+	void ConstAnimation::compressOrientationTrack(const std::vector<std::vector<Bone>> &skeletonFrames, unsigned int boneIndex, float tolerance, BoneTrack &track) const
+	{
+		const float minAbsDotProduct = std::cos(tolerance / 2.0f);
+
+		std::vector<QuantizedQuaternion<float>> quantizedOrientations;
+		quantizedOrientations.reserve(numFrames);
+		for(unsigned int frame=0; frame<numFrames; ++frame)
+		{
+			quantizedOrientations.emplace_back(skeletonFrames[frame][boneIndex].orient);
+		}
+
+		track.orientationKeyFrames.clear();
+		track.orientationKeys.clear();
+		track.orientationKeyFrames.push_back(0);
+		track.orientationKeys.push_back(quantizedOrientations[0]);
+
+		//constant track: a single key
+		Quaternion<float> firstOrientation = quantizedOrientations[0].toQuaternion();
+		bool isConstant = true;
+		for(unsigned int frame=1; frame<numFrames && isConstant; ++frame)
+		{
+			isConstant = std::abs(firstOrientation.dotProduct(skeletonFrames[frame][boneIndex].orient)) >= minAbsDotProduct;
+		}
+		if(isConstant)
+		{
+			return;
+		}
+
+		//keep the key frames which cannot be linearly interpolated
+		for(unsigned int startFrame=0, endFrame=1; endFrame<numFrames;)
+		{
+			unsigned int candidateEndFrame = endFrame + 1;
+			bool canExtend = candidateEndFrame < numFrames && candidateEndFrame - startFrame <= MAX_KEY_INTERVAL;
+			if(canExtend)
+			{
+				Quaternion<float> startOrientation = quantizedOrientations[startFrame].toQuaternion();
+				Quaternion<float> endOrientation = quantizedOrientations[candidateEndFrame].toQuaternion();
+				for(unsigned int frame=startFrame+1; frame<candidateEndFrame && canExtend; ++frame)
+				{
+					float t = static_cast<float>(frame - startFrame) / static_cast<float>(candidateEndFrame - startFrame);
+					Quaternion<float> interpolatedOrientation = startOrientation.lerp(endOrientation, t);
+					canExtend = std::abs(interpolatedOrientation.dotProduct(skeletonFrames[frame][boneIndex].orient)) >= minAbsDotProduct;
+				}
+			}
+
+			if(canExtend)
+			{
+				endFrame = candidateEndFrame;
+			}else
+			{
+				track.orientationKeyFrames.push_back(static_cast<unsigned short>(endFrame));
+				track.orientationKeys.push_back(quantizedOrientations[endFrame]);
+				startFrame = endFrame;
+				endFrame = startFrame + 1;
+			}
+		}
+	}
+
+	Point3<float> ConstAnimation::decodePosition(const BoneTrack &track, unsigned int keyIndex) const
+	{
+		const unsigned short *key = &track.positionKeys[keyIndex * 3];
+		return track.positionMin.translate(track.positionStep * Vector3<float>(key[0], key[1], key[2]));
+	}
+
+	/**
+	 * @return Index of the last key frame lower or equal to the frame
+	 */
+	unsigned int ConstAnimation::findKeyIndex(const std::vector<unsigned short> &keyFrames, unsigned int frame) const
+	{
+		auto itKeyFrame = std::upper_bound(keyFrames.begin(), keyFrames.end(), frame);
+		return static_cast<unsigned int>(std::distance(keyFrames.begin(), itKeyFrame)) - 1;
 	}
 
 	const std::string &ConstAnimation::getAnimationFilename() const
@@ -56,9 +271,138 @@ namespace urchin
 		return frameRate;
 	}
 
-	const Bone &ConstAnimation::getBone(int frameNumber, int boneNumber) const
+	const std::string &ConstAnimation::getBoneName(unsigned int boneIndex) const
+	{
+		return boneNames[boneIndex];
+	}
+
+	int ConstAnimation::getBoneParent(unsigned int boneIndex) const
+	{
+		return boneParents[boneIndex];
+	}
+
+	Point3<float> ConstAnimation::getBonePosition(unsigned int frame, unsigned int boneIndex) const
+	{
+		const BoneTrack &track = boneTracks[boneIndex];
+		unsigned int keyIndex = findKeyIndex(track.positionKeyFrames, frame);
+		if(keyIndex + 1 == track.positionKeyFrames.size() || track.positionKeyFrames[keyIndex]==frame)
+		{
+			return decodePosition(track, keyIndex);
+		}
+
+		float t = static_cast<float>(frame - track.positionKeyFrames[keyIndex])
+				/ static_cast<float>(track.positionKeyFrames[keyIndex + 1] - track.positionKeyFrames[keyIndex]);
+		Point3<float> startPosition = decodePosition(track, keyIndex);
+		return startPosition.translate(startPosition.vector(decodePosition(track, keyIndex + 1)) * t);
+	}
+
+	Quaternion<float> ConstAnimation::getBoneOrientation(unsigned int frame, unsigned int boneIndex) const
+	{
+		const BoneTrack &track = boneTracks[boneIndex];
+		unsigned int keyIndex = findKeyIndex(track.orientationKeyFrames, frame);
+		if(keyIndex + 1 == track.orientationKeyFrames.size() || track.orientationKeyFrames[keyIndex]==frame)
+		{
+			return track.orientationKeys[keyIndex].toQuaternion();
+		}
+
+		float t = static_cast<float>(frame - track.orientationKeyFrames[keyIndex])
+				/ static_cast<float>(track.orientationKeyFrames[keyIndex + 1] - track.orientationKeyFrames[keyIndex]);
+		return track.orientationKeys[keyIndex].toQuaternion().lerp(track.orientationKeys[keyIndex + 1].toQuaternion(), t);
+	}
+
+	const BoneTrack &ConstAnimation::getBoneTrack(unsigned int boneIndex) const
 	{
-		return skeletonFrames[frameNumber][boneNumber];
+		return boneTracks[boneIndex];
+	}
+
+	/**
+	 * Sample the bone at a fractional frame. The frame is interpolated between the key frames of the tracks: linear interpolation
+	 * for the position and normalized linear interpolation for the orientation.
+	 * @param frame Frame included in [0, number of frames - 1]
+	 * @param cursor [in,out] Cursor of the bone: the same cursor must be used to sample a given bone
+	 */
+	void ConstAnimation::sampleBone(float frame, unsigned int boneIndex, BoneTrackCursor &cursor, Point3<float> &position, Quaternion<float> &orientation) const
+	{
+		const BoneTrack &track = boneTracks[boneIndex];
+
+		if(frame < cursor.positionStartFrame || frame > cursor.positionEndFrame)
+		{
+			const std::vector<unsigned short> &keyFrames = track.positionKeyFrames;
+			unsigned int nextKeyIndex = cursor.positionKeyIndex + 1;
+			if(cursor.positionKeyIndex!=BoneTrackCursor::NO_KEY && frame > cursor.positionEndFrame
+					&& (nextKeyIndex + 1 == keyFrames.size() || frame <= keyFrames[nextKeyIndex + 1]))
+			{ //animation played forward: next segment starts with the end key already decoded
+				cursor.positionKeyIndex = nextKeyIndex;
+				cursor.positionStart = cursor.positionEnd;
+			}else
+			{
+				cursor.positionKeyIndex = findKeyIndex(keyFrames, static_cast<unsigned int>(frame));
+				cursor.positionStart = decodePosition(track, cursor.positionKeyIndex);
+			}
+
+			cursor.positionStartFrame = keyFrames[cursor.positionKeyIndex];
+			if(cursor.positionKeyIndex + 1 == keyFrames.size())
+			{ //last key: constant until the end
+				cursor.positionEnd = cursor.positionStart;
+				cursor.positionEndFrame = static_cast<float>(numFrames);
+			}else
+			{
+				cursor.positionEnd = decodePosition(track, cursor.positionKeyIndex + 1);
+				cursor.positionEndFrame = keyFrames[cursor.positionKeyIndex + 1];
+			}
+			cursor.positionInvFrameLength = 1.0f / (cursor.positionEndFrame - cursor.positionStartFrame);
+		}
+
+		if(frame < cursor.orientationStartFrame || frame > cursor.orientationEndFrame)
+		{
+			const std::vector<unsigned short> &keyFrames = track.orientationKeyFrames;
+			unsigned int nextKeyIndex = cursor.orientationKeyIndex + 1;
+			if(cursor.orientationKeyIndex!=BoneTrackCursor::NO_KEY && frame > cursor.orientationEndFrame
+					&& (nextKeyIndex + 1 == keyFrames.size() || frame <= keyFrames[nextKeyIndex + 1]))
+			{ //animation played forward: next segment starts with the end key already decoded
+				cursor.orientationKeyIndex = nextKeyIndex;
+				cursor.orientationStart = cursor.orientationEnd;
+			}else
+			{
+				cursor.orientationKeyIndex = findKeyIndex(keyFrames, static_cast<unsigned int>(frame));
+				cursor.orientationStart = track.orientationKeys[cursor.orientationKeyIndex].toQuaternion();
+			}
+
+			cursor.orientationStartFrame = keyFrames[cursor.orientationKeyIndex];
+			if(cursor.orientationKeyIndex + 1 == keyFrames.size())
+			{ //last key: constant until the end
+				cursor.orientationEnd = cursor.orientationStart;
+				cursor.orientationEndFrame = static_cast<float>(numFrames);
+			}else
+			{
+				cursor.orientationEnd = track.orientationKeys[cursor.orientationKeyIndex + 1].toQuaternion();
+				if(cursor.orientationStart.dotProduct(cursor.orientationEnd) < 0.0f)
+				{ //shortest path
+					cursor.orientationEnd = cursor.orientationEnd * -1.0f;
+				}
+				cursor.orientationEndFrame = keyFrames[cursor.orientationKeyIndex + 1];
+			}
+			cursor.orientationInvFrameLength = 1.0f / (cursor.orientationEndFrame - cursor.orientationStartFrame);
+		}
+
+		//interpolations are written component by component: this method is called for each bone at each frame
+		float positionT = (frame - cursor.positionStartFrame) * cursor.positionInvFrameLength;
+		position.X = cursor.positionStart.X + (cursor.positionEnd.X - cursor.positionStart.X) * positionT;
+		position.Y = cursor.positionStart.Y + (cursor.positionEnd.Y - cursor.positionStart.Y) * positionT;
+		position.Z = cursor.positionStart.Z + (cursor.positionEnd.Z - cursor.positionStart.Z) * positionT;
+
+		float orientationT = (frame - cursor.orientationStartFrame) * cursor.orientationInvFrameLength;
+		const Quaternion<float> &start = cursor.orientationStart;
+		const Quaternion<float> &end = cursor.orientationEnd;
+		orientation.X = start.X + (end.X - start.X) * orientationT;
+		orientation.Y = start.Y + (end.Y - start.Y) * orientationT;
+		orientation.Z = start.Z + (end.Z - start.Z) * orientationT;
+		orientation.W = start.W + (end.W - start.W) * orientationT;
+		float invNorm = 1.0f / std::sqrt(orientation.X * orientation.X + orientation.Y * orientation.Y + orientation.Z * orientation.Z + orientation.W * orientation.W);
+		orientation.X *= invNorm;
+		orientation.Y *= invNorm;
+		orientation.Z *= invNorm;
+		orientation.W *= invNorm;
 	}
 
 	const AABBox<float> &ConstAnimation::getOriginalGlobalAABBox() const
@@ -71,4 +415,30 @@ namespace urchin
 		return originalGlobalSplitBBoxes;
 	}
 
+	/**
+	 * @return Memory size of the compressed bones (in bytes)
+	 */
+	unsigned int ConstAnimation::getMemorySize() const
+	{
+		std::size_t memorySize = boneParents.size() * sizeof(int) + boneTracks.size() * sizeof(BoneTrack);
+		for(const auto &boneName : boneNames)
+		{
+			memorySize += sizeof(std::string) + boneName.capacity();
+		}
+		for(const auto &track : boneTracks)
+		{
+			memorySize += (track.positionKeyFrames.size() + track.positionKeys.size() + track.orientationKeyFrames.size()) * sizeof(unsigned short);
+			memorySize += track.orientationKeys.size() * sizeof(QuantizedQuaternion<float>);
+		}
+		return static_cast<unsigned int>(memorySize);
+	}
+
+	/**
+	 * @return Memory size of the bones before compression (in bytes): one bone structure per bone and per frame
+	 */
+	unsigned int ConstAnimation::getUncompressedMemorySize() const
+	{
+		return uncompressedMemorySize;
+	}
+
 }
@@ -1,6 +1,9 @@
 #ifndef URCHINENGINE_CONSTANIMATION_H
 #define URCHINENGINE_CONSTANIMATION_H
 
+#include <string>
+#include <vector>
+#include <limits>
 #include "UrchinCommon.h"
 
 #include "resources/Resource.h"
@@ -17,6 +20,39 @@ namespace urchin
 		float maxTime;
 	};
 
+	/**
+	 * Compressed animation track of a bone. Only the key frames are stored: frames between two keys are linearly interpolated
+	 * and a constant track has a single key. Positions are quantized on 16 bits in the bounds of the track.
+	 */
+	struct BoneTrack
+	{
+		std::vector<unsigned short> positionKeyFrames;
+		std::vector<unsigned short> positionKeys; //3 values per key
+		Point3<float> positionMin;
+		Vector3<float> positionStep;
+
+		std::vector<unsigned short> orientationKeyFrames;
+		std::vector<QuantizedQuaternion<float>> orientationKeys;
+	};
+
+	/**
+	 * Key frames segments of a bone track decoded by the last sampling. Consecutive samplings in the same segments don't decode the keys again.
+	 */
+	struct BoneTrackCursor
+	{
+		BoneTrackCursor();
+
+		static constexpr unsigned int NO_KEY = std::numeric_limits<unsigned int>::max();
+
+		unsigned int positionKeyIndex;
+		float positionStartFrame, positionEndFrame, positionInvFrameLength;
+		Point3<float> positionStart, positionEnd;
+
+		unsigned int orientationKeyIndex;
+		float orientationStartFrame, orientationEndFrame, orientationInvFrameLength;
+		Quaternion<float> orientationStart, orientationEnd;
+	};
+
 	/**
 	 * Contains all the constant/common data for an animation.
 	 * Two identical models can use the instance of this class.
@@ -24,25 +60,48 @@ namespace urchin
 	class ConstAnimation : public Resource
 	{
 		public:
-			ConstAnimation(const std::string &, unsigned int, unsigned int, unsigned int, const Bone *const *, const AABBox<float> *const *);
-			~ConstAnimation() override;
+			ConstAnimation(const std::string &, unsigned int, unsigned int, unsigned int, const std::vector<std::vector<Bone>> &, const std::vector<AABBox<float>> &);
+			ConstAnimation(const std::string &, unsigned int, unsigned int, const std::vector<std::string> &, const std::vector<int> &,
+					std::vector<BoneTrack> &&, const AABBox<float> &, unsigned int);
+			~ConstAnimation() override = default;
 			
 			const std::string &getAnimationFilename() const;
 			unsigned int getNumberFrames() const;
 			unsigned int getNumberBones() const;
 			unsigned int getFrameRate() const;
-			const Bone &getBone(int, int) const;
+			const std::string &getBoneName(unsigned int) const;
+			int getBoneParent(unsigned int) const;
+			Point3<float> getBonePosition(unsigned int, unsigned int) const;
+			Quaternion<float> getBoneOrientation(unsigned int, unsigned int) const;
+			const BoneTrack &getBoneTrack(unsigned int) const;
+			void sampleBone(float, unsigned int, BoneTrackCursor &, Point3<float> &, Quaternion<float> &) const;
 
 			const AABBox<float> &getOriginalGlobalAABBox() const;
 			const std::vector<AABBox<float>> &getOriginalGlobalSplitAABBoxes() const;
 
+			unsigned int getMemorySize() const override;
+			unsigned int getUncompressedMemorySize() const;
+
 		private:
+			void compressPositionTrack(const std::vector<std::vector<Bone>> &, unsigned int, float, BoneTrack &) const;
+			void compressOrientationTrack(const std::vector<std::vector<Bone>> &, unsigned int, float, BoneTrack &) const;
+			Point3<float> decodePosition(const BoneTrack &, unsigned int) const;
+			unsigned int findKeyIndex(const std::vector<unsigned short> &, unsigned int) const;
+
+			static constexpr float POSITION_TOLERANCE_FACTOR = 0.0002f; //tolerance relative to the size of the animation bounding box
+			static constexpr float ORIENTATION_TOLERANCE = 0.001f; //tolerance in radian
+			static constexpr unsigned int MAX_KEY_INTERVAL = 64; //limit the cost of the key frames reduction
+
 			std::string animationFilename;
 			const unsigned int numFrames, numBones, frameRate;
-			const Bone *const *const skeletonFrames;
-			const AABBox<float> *const *const bboxes; //bounding boxes of each animation frames (not transformed)
+
+			std::vector<std::string> boneNames;
+			std::vector<int> boneParents;
+			std::vector<BoneTrack> boneTracks;
+
 			AABBox<float> originalGlobalBBox; //original global bounding box (not transformed)
 			std::vector<AABBox<float>> originalGlobalSplitBBoxes;
+			unsigned int uncompressedMemorySize;
 	};
 
 }
@@ -1,54 +1,132 @@
-#include <GL/glew.h>
 #include <stdexcept>
 #include <limits>
 
 #include "resources/model/ConstMesh.h"
 #include "resources/model/MeshService.h"
-#include "resources/MediaManager.h"
 
 namespace urchin
 {
 
 	ConstMesh::ConstMesh(const std::string &materialFilename, const std::vector<Vertex> &vertices, const std::vector<TextureCoordinate> &textureCoordinates,
 			const std::vector<Triangle> &triangles, const std::vector<Weight> &weights, const std::vector<Bone> &baseSkeleton) :
+		materialFilename(materialFilename),
+		verticesStorage(vertices),
+		textureCoordinatesStorage(textureCoordinates),
+		trianglesStorage(triangles),
+		weightsStorage(weights),
+		numberVertices(static_cast<unsigned int>(vertices.size())),
+		vertices(verticesStorage.data()),
+		textureCoordinates(textureCoordinatesStorage.data()),
+		numberTriangles(static_cast<unsigned int>(triangles.size())),
+		triangles(trianglesStorage.data()),
+		coarseLodsTriangles(nullptr),
+		numberWeights(static_cast<unsigned int>(weights.size())),
+		weights(weightsStorage.data()),
+		baseSkeleton(baseSkeleton),
+		baseVertices(new Point3<float>[vertices.size()]),
+		baseDataVertices(new DataVertex[vertices.size()])
+	{
+		initialize();
+	}
+
+	/**
+	 * Constructor for arrays stored in a mapped file: the arrays are not copied.
+	 * @param mappedFile Mapped file containing the arrays. It stays mapped as long as the mesh exists.
+	 */
+	ConstMesh::ConstMesh(const std::string &materialFilename, unsigned int numberVertices, const Vertex *vertices, const TextureCoordinate *textureCoordinates,
+			unsigned int numberTriangles, const Triangle *triangles, unsigned int numberWeights, const Weight *weights,
+			const std::vector<Bone> &baseSkeleton, std::shared_ptr<MemoryMappedFile> mappedFile) :
+		materialFilename(materialFilename),
+		mappedFile(std::move(mappedFile)),
+		numberVertices(numberVertices),
 		vertices(vertices),
 		textureCoordinates(textureCoordinates),
+		numberTriangles(numberTriangles),
 		triangles(triangles),
+		coarseLodsTriangles(nullptr),
+		numberWeights(numberWeights),
 		weights(weights),
 		baseSkeleton(baseSkeleton),
-		baseVertices(new Point3<float>[vertices.size()]),
-		baseDataVertices(new DataVertex[vertices.size()])
+		baseVertices(new Point3<float>[numberVertices]),
+		baseDataVertices(new DataVertex[numberVertices])
+	{
+		initialize();
+	}
+
+	ConstMesh::~ConstMesh()
+	{
+		delete [] baseVertices;
+		delete [] baseDataVertices;
+	}
+
+	/**
+	 * Build the data of the mesh. The graphic API is not used: the mesh can be loaded by any thread.
+	 */
+	void ConstMesh::initialize()
+	{
+		buildTopology();
+		buildWeightGroups();
+
+		//compute vertices and normals based on bind-pose skeleton
+		std::vector<Vector3<float>> linkedGroupNormals;
+		MeshService::instance()->computeVertices(this, baseSkeleton, baseVertices);
+		MeshService::instance()->computeNormals(this, baseVertices, linkedGroupNormals, baseDataVertices);
+	}
+
+	void ConstMesh::buildTopology()
 	{
 		//regroup duplicate vertex due to their different texture coordinates
-		for(unsigned int i=0;i<vertices.size();++i)
+		std::map<unsigned int, std::vector<unsigned int>> linkedVertices;
+		for(unsigned int i=0;i<numberVertices;++i)
 		{
 			linkedVertices[vertices[i].linkedVerticesGroupId].push_back(i);
 		}
 
-		//compute vertices and normals based on bind-pose skeleton
-		MeshService::instance()->computeVertices(this, baseSkeleton, baseVertices);
-		MeshService::instance()->computeNormals(this, baseVertices, baseDataVertices);
+		std::vector<unsigned int> vertexGroups(numberVertices);
+		topology.groupOffsets.reserve(linkedVertices.size() + 1);
+		topology.groupVertices.reserve(numberVertices);
+		for(const auto &linkedVerticesOfGroup : linkedVertices)
+		{
+			auto group = static_cast<unsigned int>(topology.groupOffsets.size());
+			topology.groupOffsets.push_back(static_cast<unsigned int>(topology.groupVertices.size()));
+			for(unsigned int vertexIndex : linkedVerticesOfGroup.second)
+			{
+				topology.groupVertices.push_back(vertexIndex);
+				vertexGroups[vertexIndex] = group;
+			}
+		}
+		topology.groupOffsets.push_back(static_cast<unsigned int>(topology.groupVertices.size()));
 
-		//load material
-		material = MediaManager::instance()->getMedia<Material>(materialFilename);
+		topology.cornerGroups.reserve(numberTriangles * 3);
+		for(unsigned int triangleIndex=0; triangleIndex<numberTriangles; ++triangleIndex)
+		{
+			for(int vertexIndex : triangles[triangleIndex].index)
+			{
+				topology.cornerGroups.push_back(vertexGroups[vertexIndex]);
+			}
+		}
 	}
 
-	ConstMesh::~ConstMesh()
+	void ConstMesh::buildWeightGroups()
 	{
-		delete [] baseVertices;
-		delete [] baseDataVertices;
+		std::vector<std::pair<unsigned int, unsigned int>> verticesWeights;
+		verticesWeights.reserve(numberVertices);
+		for(unsigned int i=0;i<numberVertices;++i)
+		{
+			verticesWeights.emplace_back(static_cast<unsigned int>(vertices[i].weightStart), static_cast<unsigned int>(vertices[i].weightCount));
+		}
 
-		material->release();
+		weightGroups = MeshSkinning::buildWeightGroups(verticesWeights, weights);
 	}
 
-	const Material *ConstMesh::getMaterial() const
+	const std::string &ConstMesh::getMaterialFilename() const
 	{
-		return material;
+		return materialFilename;
 	}
 
 	unsigned int ConstMesh::getNumberVertices() const
 	{
-		return vertices.size();
+		return numberVertices;
 	}
 
 	const Vertex &ConstMesh::getStructVertex(unsigned int index) const
@@ -56,32 +134,26 @@ namespace urchin
 		return vertices[index];
 	}
 
-	const std::vector<TextureCoordinate> &ConstMesh::getTextureCoordinates() const
+	const TextureCoordinate *ConstMesh::getTextureCoordinates() const
 	{
 		return textureCoordinates;
 	}
 
 	/**
 	 * Vertices can be duplicated because they have different texture coordinates.
-	 * This method returns all duplicates vertices thanks to 'linked vertices group ID' stored on each vertex.
+	 * The topology regroups all duplicates vertices thanks to 'linked vertices group ID' stored on each vertex.
 	 */
-	const std::vector<unsigned int> &ConstMesh::getLinkedVertices(unsigned int linkedVerticesGroupId) const
+	const MeshTopology &ConstMesh::getTopology() const
 	{
-		auto it = linkedVertices.find(linkedVerticesGroupId);
-		if(it!=linkedVertices.end())
-		{
-			return it->second;
-		}
-
-		throw std::runtime_error("Impossible to find linked vertices for group ID: " + std::to_string(linkedVerticesGroupId));
+		return topology;
 	}
 
 	unsigned int ConstMesh::getNumberTriangles() const
 	{
-		return triangles.size();
+		return numberTriangles;
 	}
 
-	const std::vector<Triangle> &ConstMesh::getTriangles() const
+	const Triangle *ConstMesh::getTriangles() const
 	{
 		return triangles;
 	}
@@ -91,9 +163,100 @@ namespace urchin
 		return triangles[index];
 	}
 
+	/**
+	 * Builds the levels of detail by simplification of the bind-pose mesh. Each level keeps a ratio of the triangles of the previous
+	 * level. Building stops when the simplification cannot reduce significantly the number of triangles.
+	 * @param maxCoarseLods Maximum number of levels of detail in addition to the mesh itself
+	 * @param trianglesRatio Ratio of triangles kept from a level to the next one
+	 */
+	void ConstMesh::buildLods(unsigned int maxCoarseLods, float trianglesRatio)
+	{
+		constexpr float MIN_REDUCTION_RATIO = 0.9f;
+
+		coarseLodsTrianglesStorage.clear();
+		std::vector<unsigned int> lodsNumberTriangles;
+
+		static_assert(sizeof(Triangle)==3*sizeof(unsigned int), "Triangle indices must be contiguous");
+		MeshSimplifier meshSimplifier(baseVertices, numberVertices, reinterpret_cast<const unsigned int *>(triangles), numberTriangles * 3);
+		unsigned int previousNumberTriangles = numberTriangles;
+		for(unsigned int lod=1; lod<=maxCoarseLods; ++lod)
+		{
+			auto targetNumberTriangles = static_cast<unsigned int>((float)previousNumberTriangles * trianglesRatio);
+			std::vector<unsigned int> lodIndices = meshSimplifier.simplify(targetNumberTriangles);
+
+			auto lodNumberTriangles = static_cast<unsigned int>(lodIndices.size() / 3);
+			if(lodNumberTriangles==0 || (float)lodNumberTriangles > (float)previousNumberTriangles * MIN_REDUCTION_RATIO)
+			{
+				break;
+			}
+
+			for(unsigned int i=0; i<lodIndices.size(); i+=3)
+			{
+				coarseLodsTrianglesStorage.push_back({{(int)lodIndices[i], (int)lodIndices[i+1], (int)lodIndices[i+2]}});
+			}
+			lodsNumberTriangles.push_back(lodNumberTriangles);
+			previousNumberTriangles = lodNumberTriangles;
+		}
+
+		setLods(coarseLodsTrianglesStorage.data(), lodsNumberTriangles);
+	}
+
+	/**
+	 * @param coarseLodsTriangles Triangles of the levels of detail 1 to N stored one after the other. Array must stay valid as long as the mesh exists.
+	 * @param coarseLodsNumberTriangles Number of triangles of the levels of detail 1 to N
+	 */
+	void ConstMesh::setLods(const Triangle *coarseLodsTriangles, const std::vector<unsigned int> &coarseLodsNumberTriangles)
+	{
+		this->coarseLodsTriangles = coarseLodsTriangles;
+		this->coarseLodsNumberTriangles = coarseLodsNumberTriangles;
+	}
+
+	/**
+	 * @return Number of levels of detail: level 0 is the mesh itself
+	 */
+	unsigned int ConstMesh::getNumberLods() const
+	{
+		return static_cast<unsigned int>(coarseLodsNumberTriangles.size()) + 1;
+	}
+
+	unsigned int ConstMesh::getLodNumberTriangles(unsigned int lod) const
+	{
+		if(lod==0)
+		{
+			return numberTriangles;
+		}
+		return coarseLodsNumberTriangles[lod - 1];
+	}
+
+	/**
+	 * @return Index of the first triangle of the level of detail in an array containing the mesh triangles followed by the coarse levels triangles
+	 */
+	unsigned int ConstMesh::getLodFirstTriangle(unsigned int lod) const
+	{
+		unsigned int lodFirstTriangle = 0;
+		for(unsigned int previousLod=0; previousLod<lod; ++previousLod)
+		{
+			lodFirstTriangle += getLodNumberTriangles(previousLod);
+		}
+		return lodFirstTriangle;
+	}
+
+	/**
+	 * @return Triangles of the levels of detail 1 to N stored one after the other
+	 */
+	const Triangle *ConstMesh::getCoarseLodsTriangles() const
+	{
+		return coarseLodsTriangles;
+	}
+
+	const std::vector<unsigned int> &ConstMesh::getCoarseLodsNumberTriangles() const
+	{
+		return coarseLodsNumberTriangles;
+	}
+
 	unsigned int ConstMesh::getNumberWeights() const
 	{
-		return weights.size();
+		return numberWeights;
 	}
 
 	const Weight &ConstMesh::getWeight(unsigned int index) const
@@ -101,6 +264,14 @@ namespace urchin
 		return weights[index];
 	}
 
+	/**
+	 * @return Weights grouped by number of weights per vertex: used for skinning
+	 */
+	const std::vector<WeightGroup> &ConstMesh::getWeightGroups() const
+	{
+		return weightGroups;
+	}
+
 	unsigned int ConstMesh::getNumberBones() const
 	{
 		return baseSkeleton.size();
@@ -126,4 +297,24 @@ namespace urchin
 		return baseDataVertices;
 	}
 
+	/**
+	 * @return Memory size of the mesh data (in bytes). Arrays read from a mapped file are counted: they are loaded in memory
+	 * once accessed.
+	 */
+	unsigned int ConstMesh::getMemorySize() const
+	{
+		std::size_t memorySize = numberVertices * (sizeof(Vertex) + sizeof(TextureCoordinate) + sizeof(Point3<float>) + sizeof(DataVertex))
+				+ getLodFirstTriangle(getNumberLods()) * sizeof(Triangle) + numberWeights * sizeof(Weight)
+				+ baseSkeleton.size() * sizeof(Bone);
+
+		memorySize += (topology.groupOffsets.size() + topology.groupVertices.size() + topology.cornerGroups.size()) * sizeof(unsigned int);
+		for(const auto &weightGroup : weightGroups)
+		{
+			memorySize += (weightGroup.vertexIndices.size() + weightGroup.bones.size()) * sizeof(unsigned int);
+			memorySize += (weightGroup.biases.size() + weightGroup.biasedPosX.size() + weightGroup.biasedPosY.size() + weightGroup.biasedPosZ.size()) * sizeof(float);
+		}
+
+		return static_cast<unsigned int>(memorySize);
+	}
+
 }
@@ -4,10 +4,9 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
 #include "UrchinCommon.h"
 
-#include "resources/material/Material.h"
-
 namespace urchin
 {
 
@@ -28,11 +27,16 @@ namespace urchin
 		int index[3]; //indices vertices
 	};
 
-	struct Weight
+	/**
+	 * Topology of the mesh used to compute the normals. Vertices duplicated because of their different texture coordinates are
+	 * regrouped in linked groups. Vertices of the linked group 'g' are stored in 'groupVertices' from index 'groupOffsets[g]'
+	 * (included) to index 'groupOffsets[g+1]' (excluded).
+	 */
+	struct MeshTopology
 	{
-		int bone; //index of the bone
-		float bias; //contribution of the vertex weight
-		Point3<float> pos; //coordinates of the vertex weight
+		std::vector<unsigned int> groupOffsets;
+		std::vector<unsigned int> groupVertices;
+		std::vector<unsigned int> cornerGroups; //linked group of each triangle corner (3 corners per triangle)
 	};
 
 	struct DataVertex
@@ -58,21 +62,32 @@ namespace urchin
 		public:
 			ConstMesh(const std::string &, const std::vector<Vertex> &, const std::vector<TextureCoordinate> &,
 					const std::vector<Triangle> &, const std::vector<Weight> &, const std::vector<Bone> &);
+			ConstMesh(const std::string &, unsigned int, const Vertex *, const TextureCoordinate *, unsigned int, const Triangle *,
+					unsigned int, const Weight *, const std::vector<Bone> &, std::shared_ptr<MemoryMappedFile>);
 			~ConstMesh();
 
-			const Material *getMaterial() const;
+			const std::string &getMaterialFilename() const;
 
 			unsigned int getNumberVertices() const;
 			const Vertex &getStructVertex(unsigned int) const;
-			const std::vector<TextureCoordinate> &getTextureCoordinates() const;
-			const std::vector<unsigned int> &getLinkedVertices(unsigned int) const;
+			const TextureCoordinate *getTextureCoordinates() const;
+			const MeshTopology &getTopology() const;
 
 			unsigned int getNumberTriangles() const;
-			const std::vector<Triangle> &getTriangles() const;
+			const Triangle *getTriangles() const;
 			const Triangle &getTriangle(unsigned int) const;
 
+			void buildLods(unsigned int, float);
+			void setLods(const Triangle *, const std::vector<unsigned int> &);
+			unsigned int getNumberLods() const;
+			unsigned int getLodNumberTriangles(unsigned int) const;
+			unsigned int getLodFirstTriangle(unsigned int) const;
+			const Triangle *getCoarseLodsTriangles() const;
+			const std::vector<unsigned int> &getCoarseLodsNumberTriangles() const;
+
 			unsigned int getNumberWeights() const;
 			const Weight &getWeight(unsigned int) const;
+			const std::vector<WeightGroup> &getWeightGroups() const;
 
 			unsigned int getNumberBones() const;
 			const std::vector<Bone> &getBaseSkeleton() const;
@@ -80,16 +95,38 @@ namespace urchin
 			const Point3<float> *getBaseVertices() const;
 			const DataVertex *getBaseDataVertices() const;
 
-		private:
-			Material *material;
-
-			std::vector<Vertex> vertices;
-			std::vector<TextureCoordinate> textureCoordinates;
-			std::map<unsigned int, std::vector<unsigned int>> linkedVertices;
+			unsigned int getMemorySize() const;
 
-			std::vector<Triangle> triangles;
-
-			std::vector<Weight> weights;
+		private:
+			void initialize();
+			void buildTopology();
+			void buildWeightGroups();
+
+			std::string materialFilename;
+
+			//arrays are stored in the vectors or in the mapped file
+			std::vector<Vertex> verticesStorage;
+			std::vector<TextureCoordinate> textureCoordinatesStorage;
+			std::vector<Triangle> trianglesStorage;
+			std::vector<Weight> weightsStorage;
+			std::shared_ptr<MemoryMappedFile> mappedFile;
+
+			const unsigned int numberVertices;
+			const Vertex *const vertices;
+			const TextureCoordinate *const textureCoordinates;
+
+			const unsigned int numberTriangles;
+			const Triangle *const triangles;
+			MeshTopology topology;
+
+			//levels of detail: triangles of LOD 0 are the mesh triangles, triangles of coarser LODs are stored one after the other
+			std::vector<Triangle> coarseLodsTrianglesStorage;
+			const Triangle *coarseLodsTriangles;
+			std::vector<unsigned int> coarseLodsNumberTriangles;
+
+			const unsigned int numberWeights;
+			const Weight *const weights;
+			std::vector<WeightGroup> weightGroups;
 
 			//mesh information in bind-pose
 			std::vector<Bone> baseSkeleton; //bind-pose skeleton
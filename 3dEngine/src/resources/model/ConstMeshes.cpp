@@ -88,4 +88,17 @@ namespace urchin
 		return originalSplitBBoxes;
 	}
 
+	/**
+	 * @return Memory size of all the meshes (in bytes)
+	 */
+	unsigned int ConstMeshes::getMemorySize() const
+	{
+		unsigned int memorySize = 0;
+		for(auto constMesh : constMeshes)
+		{
+			memorySize += constMesh->getMemorySize();
+		}
+		return memorySize;
+	}
+
 }
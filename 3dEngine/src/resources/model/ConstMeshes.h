@@ -28,6 +28,8 @@ namespace urchin
 
 			const AABBox<float> &getOriginalAABBox() const;
 			const std::vector<AABBox<float>> &getOriginalSplitAABBoxes() const;
+
+			unsigned int getMemorySize() const override;
 		
 		private:
 			std::string meshFilename;
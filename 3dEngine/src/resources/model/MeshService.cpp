@@ -1,5 +1,7 @@
 #include <limits>
 #include <chrono>
+#include <cmath>
+#include <algorithm>
 
 #include "resources/model/MeshService.h"
 #include "resources/model/ConstAnimation.h"
@@ -12,116 +14,88 @@ namespace urchin
 
 	}
 
+	/**
+	 * @param boneMatrices [out] Transformation matrix of each bone: rotation and translation of the bone
+	 */
+	void MeshService::computeBoneMatrices(const std::vector<Bone> &skeleton, std::vector<Matrix4<float>> &boneMatrices) const
+	{
+		boneMatrices.resize(skeleton.size());
+		for(unsigned int i=0; i<skeleton.size(); ++i)
+		{
+			boneMatrices[i] = MeshSkinning::computeBoneMatrix(skeleton[i].pos, skeleton[i].orient);
+		}
+	}
+
 	void MeshService::computeVertices(const ConstMesh *const constMesh, const std::vector<Bone> &skeleton, Point3<float> *const vertices)
 	{
-		//setup vertices
-		for(unsigned int i=0;i<constMesh->getNumberVertices();++i)
+		std::vector<Matrix4<float>> boneMatrices;
+		computeBoneMatrices(skeleton, boneMatrices);
+
+		computeVertices(constMesh, boneMatrices, vertices);
+	}
+
+	/**
+	 * Compute the skinned vertices. This method is thread-safe.
+	 * @param boneMatrices Bone matrices computed by computeBoneMatrices()
+	 */
+	void MeshService::computeVertices(const ConstMesh *const constMesh, const std::vector<Matrix4<float>> &boneMatrices, Point3<float> *const vertices) const
+	{
+		MeshSkinning::computeVertices(constMesh->getWeightGroups(), boneMatrices, vertices);
+	}
+
+	/**
+	 * Compute the normals and tangents of the vertices. This method is thread-safe when each thread uses its own scratch buffer.
+	 * @param linkedGroupNormals [in,out] Scratch buffer used to accumulate the normals of each linked vertices group
+	 */
+	void MeshService::computeNormals(const ConstMesh *const constMesh, const Point3<float> *const vertices,
+			std::vector<Vector3<float>> &linkedGroupNormals, DataVertex *const dataVertices) const
+	{
+		const MeshTopology &topology = constMesh->getTopology();
+		const auto nbGroups = static_cast<unsigned int>(topology.groupOffsets.size() - 1);
+		linkedGroupNormals.assign(nbGroups, Vector3<float>(0.0f, 0.0f, 0.0f));
+
+		//sum normals of each triangle weighted by its angle on each corner
+		const Triangle *triangles = constMesh->getTriangles();
+		const unsigned int *cornerGroups = topology.cornerGroups.data();
+		for(unsigned int triIndex=0; triIndex<constMesh->getNumberTriangles(); ++triIndex)
 		{
-			vertices[i].setNull();
+			const Triangle &tri = triangles[triIndex];
+			const Point3<float> &a = vertices[tri.index[0]];
+			const Point3<float> &b = vertices[tri.index[1]];
+			const Point3<float> &c = vertices[tri.index[2]];
+
+			Vector3<float> ab = a.vector(b), ac = a.vector(c), bc = b.vector(c);
+			Vector3<float> faceNormal = ac.crossProduct(ab);
+			float faceNormalLength = faceNormal.length(); //same value for the cross product of two edges of any corner
+			faceNormal *= 1.0f / std::max(faceNormalLength, std::numeric_limits<float>::min());
+
+			float angleA = std::atan2(faceNormalLength, ab.dotProduct(ac));
+			float angleB = std::atan2(faceNormalLength, -ab.dotProduct(bc));
+			float angleC = (float)PI_VALUE - angleA - angleB;
+
+			const unsigned int *triCornerGroups = cornerGroups + triIndex * 3;
+			linkedGroupNormals[triCornerGroups[0]] += faceNormal * angleA;
+			linkedGroupNormals[triCornerGroups[1]] += faceNormal * angleB;
+			linkedGroupNormals[triCornerGroups[2]] += faceNormal * angleC;
+		}
 
-			//calculate final vertex to draw with weights
-			for(int j=0;j<constMesh->getStructVertex(i).weightCount;++j)
-			{
-				const Weight *weight = &constMesh->getWeight(static_cast<unsigned int>(constMesh->getStructVertex(i).weightStart + j));
-				const Bone &bone = skeleton[weight->bone];
+		//normalize normals and compute tangents once per linked group
+		for(unsigned int group=0; group<nbGroups; ++group)
+		{
+			Vector3<float> normal = linkedGroupNormals[group].normalize();
 
-				//calculate transformed vertex for this weight
-				Point3<float> wv = bone.orient.rotatePoint(weight->pos);
+			//tangent: cross product of the normal with axis Z or axis Y, the longest is kept
+			Vector3<float> c1(normal.Y, -normal.X, 0.0f);
+			Vector3<float> c2(-normal.Z, 0.0f, normal.X);
+			Vector3<float> tangent = (c1.squareLength() > c2.squareLength() ? c1 : c2).normalize();
 
-				//the sum of all weight->bias should be 1.0
-				vertices[i].X += (bone.pos.X + wv.X) * weight->bias;
-				vertices[i].Y += (bone.pos.Y + wv.Y) * weight->bias;
-				vertices[i].Z += (bone.pos.Z + wv.Z) * weight->bias;
+			for(unsigned int i=topology.groupOffsets[group]; i<topology.groupOffsets[group+1]; ++i)
+			{
+				DataVertex &dataVertex = dataVertices[topology.groupVertices[i]];
+				dataVertex.normal = normal;
+				dataVertex.tangent = tangent;
 			}
 		}
 	}
 
-	void MeshService::computeNormals(const ConstMesh *const constMesh, const Point3<float> *const vertices, DataVertex *const dataVertices)
-    {
-        //compute weighted normals
-        static std::vector<Vector3<float>> vertexNormals;
-        vertexNormals.clear();
-        vertexNormals.resize(constMesh->getNumberVertices(), Vector3<float>(0.0f, 0.0f, 0.0f));
-
-        for(unsigned int triIndex=0; triIndex<constMesh->getNumberTriangles(); ++triIndex)
-        {
-            const Triangle &tri = constMesh->getTriangle(triIndex);
-            for(unsigned int triVertexIndex=0; triVertexIndex<3; ++triVertexIndex)
-            {
-                auto vertexIndex = static_cast<unsigned int>(tri.index[triVertexIndex]);
-
-                Vector3<float> weightedNormal = computeWeightedVertexNormal(tri, triVertexIndex, vertices);
-                vertexNormals[vertexIndex] += weightedNormal;
-            }
-        }
-
-        //sum weighted normals of same vertex
-        for (unsigned int vertexIndex = 0; vertexIndex < constMesh->getNumberVertices(); ++vertexIndex)
-        {
-            unsigned int linkedVerticesGroupId = constMesh->getStructVertex(vertexIndex).linkedVerticesGroupId;
-            for(unsigned int linkedVertex : constMesh->getLinkedVertices(linkedVerticesGroupId))
-            {
-                dataVertices[vertexIndex].normal += vertexNormals[linkedVertex];
-            }
-        }
-
-        for (unsigned int vertexIndex = 0; vertexIndex < constMesh->getNumberVertices(); ++vertexIndex)
-        {
-            //normal normalization
-            dataVertices[vertexIndex].normal = dataVertices[vertexIndex].normal.normalize();
-
-            //computes tangent
-            const Vector3<float> &c1 = dataVertices[vertexIndex].normal.crossProduct(Vector3<float>(0.0f, 0.0f, 1.0f));
-            const Vector3<float> &c2 = dataVertices[vertexIndex].normal.crossProduct(Vector3<float>(0.0f, 1.0f, 0.0f));
-            if(c1.squareLength() > c2.squareLength())
-            {
-                dataVertices[vertexIndex].tangent = c1.normalize();
-            }else
-            {
-                dataVertices[vertexIndex].tangent = c2.normalize();
-            }
-        }
-	}
-
-    int MeshService::indexOfVertexInTriangle(const Triangle &triangle, unsigned int vertexIndex, const ConstMesh *const constMesh)
-    {
-        for(unsigned int i=0; i<3; ++i)
-        {
-            auto triVertexIndex = static_cast<unsigned int>(triangle.index[i]);
-
-            //classic
-            if(triVertexIndex==vertexIndex)
-            {
-                return i;
-            }
-
-            //by group id
-            unsigned int linkedVerticesGroupId = constMesh->getStructVertex(triVertexIndex).linkedVerticesGroupId;
-            for (unsigned int linkedVertexIndex : constMesh->getLinkedVertices(linkedVerticesGroupId))
-            {
-                if (linkedVertexIndex == vertexIndex)
-                {
-                    return i;
-                }
-            }
-        }
-
-        return -1;
-    }
-
-    Vector3<float> MeshService::computeWeightedVertexNormal(const Triangle &triangle, unsigned int vertexIndex, const Point3<float> *const vertices)
-    { //see https://stackoverflow.com/questions/18519586/calculate-normal-per-vertex-opengl
-        Point3<float> a = vertices[triangle.index[vertexIndex]];
-        Point3<float> b = vertices[triangle.index[(vertexIndex+1)%3]];
-        Point3<float> c = vertices[triangle.index[(vertexIndex+2)%3]];
-
-        Vector3<float> ab = a.vector(b);
-        Vector3<float> ac = a.vector(c);
-
-        Vector3<float> normal = ac.crossProduct(ab);
-        float sinAlpha = normal.length() / (ab.length() * ac.length());
-        sinAlpha = MathAlgorithm::clamp(sinAlpha, -1.0f + std::numeric_limits<float>::epsilon(), 1.0f - std::numeric_limits<float>::epsilon()); //because of rounding error
-
-        return normal.normalize() * std::asin(sinAlpha);
-    }
 }
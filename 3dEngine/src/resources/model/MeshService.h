@@ -8,22 +8,20 @@ namespace urchin
 	class ConstMesh;
 	struct Bone;
 	struct DataVertex;
-	struct Triangle;
 
 	class MeshService : public Singleton<MeshService>
 	{
 		public:
 			friend class Singleton<MeshService>;
 
+			void computeBoneMatrices(const std::vector<Bone> &, std::vector<Matrix4<float>> &) const;
 			void computeVertices(const ConstMesh *, const std::vector<Bone> &, Point3<float> *);
-			void computeNormals(const ConstMesh *, const Point3<float> *,  DataVertex *);
+			void computeVertices(const ConstMesh *, const std::vector<Matrix4<float>> &, Point3<float> *) const;
+			void computeNormals(const ConstMesh *, const Point3<float> *, std::vector<Vector3<float>> &, DataVertex *) const;
 
 		private:
 			MeshService();
 			~MeshService() override = default;
-
-			int indexOfVertexInTriangle(const Triangle &, unsigned int, const ConstMesh *const);
-			Vector3<float> computeWeightedVertexNormal(const Triangle &, unsigned int, const Point3<float> *const );
 	};
 
 }
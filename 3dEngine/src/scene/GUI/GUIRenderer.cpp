@@ -4,6 +4,7 @@
 
 #include "scene/GUI/GUIRenderer.h"
 #include "scene/GUI/GUISkinService.h"
+#include "scene/GUI/widget/text/Text.h"
 #include "resources/font/Font.h"
 #include "resources/MediaManager.h"
 #include "utils/shader/ShaderManager.h"
@@ -16,7 +17,9 @@ namespace urchin
 		GUIShader(0),
 		mProjectionLoc(0),
 		translateDistanceLoc(0),
-		diffuseTexSamplerLoc(0)
+		diffuseTexSamplerLoc(0),
+		textDrawRangeIndex(0),
+		textBufferVerticesCapacity(0)
 	{
 		GUIShader = ShaderManager::instance()->createProgram("gui.vert", "", "gui.frag");
 
@@ -24,6 +27,15 @@ namespace urchin
 		mProjectionLoc  = glGetUniformLocation(GUIShader, "mProjection");
 		translateDistanceLoc = glGetUniformLocation(GUIShader, "translateDistance");
 		diffuseTexSamplerLoc = glGetUniformLocation(GUIShader, "diffuseTexture");
+
+		glGenVertexArrays(1, &textVertexArrayObject);
+		glGenBuffers(1, &textBufferID);
+		glBindVertexArray(textVertexArrayObject);
+		glBindBuffer(GL_ARRAY_BUFFER, textBufferID);
+		glEnableVertexAttribArray(SHADER_VERTEX_POSITION);
+		glVertexAttribPointer(SHADER_VERTEX_POSITION, 2, GL_FLOAT, GL_FALSE, sizeof(float)*4, nullptr);
+		glEnableVertexAttribArray(SHADER_TEX_COORD);
+		glVertexAttribPointer(SHADER_TEX_COORD, 2, GL_FLOAT, GL_FALSE, sizeof(float)*4, (char*)(sizeof(float)*2));
 	}
 
 	GUIRenderer::~GUIRenderer()
@@ -33,6 +45,9 @@ namespace urchin
 			delete widgets[i];
 		}
 
+		glDeleteVertexArrays(1, &textVertexArrayObject);
+		glDeleteBuffers(1, &textBufferID);
+
 		ShaderManager::instance()->removeProgram(GUIShader);
 	}
 
@@ -174,14 +189,19 @@ namespace urchin
 
 		glActiveTexture(GL_TEXTURE0);
 
-		for (auto &widget : widgets)
+		buildTextBatch();
+
+		textDrawRangeIndex = 0;
+		for(unsigned int i=0; i<widgets.size(); ++i)
 		{
-			if(widget->isVisible())
+			if(widgets[i]->isVisible())
 			{
-				Vector2<int> translateVector(widget->getGlobalPositionX(), widget->getGlobalPositionY());
+				Vector2<int> translateVector(widgets[i]->getGlobalPositionX(), widgets[i]->getGlobalPositionY());
 				glUniform2iv(translateDistanceLoc, 1, (const int*)translateVector);
 
-				widget->display(translateDistanceLoc, dt);
+				widgets[i]->display(translateDistanceLoc, dt);
+
+				displayTexts(widgetsTextSegment[i]);
 			}
 		}
 
@@ -198,4 +218,74 @@ namespace urchin
 		#endif
 	}
 
+	/**
+	* Gather the texts of the visible widgets in the text batch. Texts of a widget are in a segment drawn over the widget.
+	* Consecutive text widgets draw nothing else: they share a segment.
+	*/
+	void GUIRenderer::buildTextBatch()
+	{
+		textBatch.beginFrame();
+		widgetsTextSegment.resize(widgets.size());
+
+		unsigned int segment = 0;
+		bool previousIsText = false;
+		for(unsigned int i=0; i<widgets.size(); ++i)
+		{
+			if(widgets[i]->isVisible())
+			{
+				bool isText = dynamic_cast<Text *>(widgets[i])!=nullptr;
+				if(!isText || !previousIsText)
+				{
+					segment = textBatch.beginSegment();
+				}
+				widgetsTextSegment[i] = segment;
+
+				widgets[i]->addToTextBatch(textBatch);
+				previousIsText = isText;
+			}
+		}
+
+		textBatch.build();
+
+		//upload the vertices of the modified texts only
+		glBindBuffer(GL_ARRAY_BUFFER, textBufferID);
+		if(textBatch.getVerticesCount() > textBufferVerticesCapacity)
+		{
+			textBufferVerticesCapacity = textBatch.getVerticesCount();
+			glBufferData(GL_ARRAY_BUFFER, textBatch.getVertices().size() * sizeof(float), &textBatch.getVertices()[0], GL_DYNAMIC_DRAW);
+		}else if(textBatch.hasDirtyVertices())
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, textBatch.getFirstDirtyVertex() * sizeof(float) * 4, textBatch.getDirtyVerticesCount() * sizeof(float) * 4,
+					&textBatch.getVertices()[textBatch.getFirstDirtyVertex() * 4]);
+		}
+	}
+
+	/**
+	* Display the texts of the segments up to the given segment
+	*/
+	void GUIRenderer::displayTexts(unsigned int segment)
+	{
+		const std::vector<TextBatchDrawRange> &drawRanges = textBatch.getDrawRanges();
+		if(textDrawRangeIndex >= drawRanges.size() || drawRanges[textDrawRangeIndex].segment > segment)
+		{
+			return;
+		}
+
+		Vector2<int> translateVector(0, 0); //texts are positioned in the batch
+		glUniform2iv(translateDistanceLoc, 1, (const int*)translateVector);
+
+		glEnable(GL_BLEND);
+		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+		glBindVertexArray(textVertexArrayObject);
+
+		for(; textDrawRangeIndex < drawRanges.size() && drawRanges[textDrawRangeIndex].segment <= segment; ++textDrawRangeIndex)
+		{
+			const TextBatchDrawRange &drawRange = drawRanges[textDrawRangeIndex];
+			glBindTexture(GL_TEXTURE_2D, drawRange.textureId);
+			glDrawArrays(GL_TRIANGLES, drawRange.firstVertex, drawRange.verticesCount);
+		}
+
+		glDisable(GL_BLEND);
+	}
+
 }
@@ -32,11 +32,26 @@ namespace urchin
 			void display(float) override;
 			
 		private:
+			void buildTextBatch();
+			void displayTexts(unsigned int);
+
 			std::vector<Widget *> widgets;
 
 			Matrix3<float> mProjection, mModelView;
 			unsigned int GUIShader;
 			int mProjectionLoc, translateDistanceLoc, diffuseTexSamplerLoc;
+
+			//texts of all widgets in one vertex stream
+			TextBatch textBatch;
+			std::vector<unsigned int> widgetsTextSegment;
+			unsigned int textDrawRangeIndex;
+			unsigned int textVertexArrayObject, textBufferID;
+			unsigned int textBufferVerticesCapacity;
+			enum //shader input
+			{
+				SHADER_VERTEX_POSITION = 0,
+				SHADER_TEX_COORD
+			};
 	};
 	
 }
@@ -419,4 +419,18 @@ namespace urchin
 		}
 	}
 
+	/**
+	* Add the texts of the widget and of its visible children in display order
+	*/
+	void Widget::addToTextBatch(TextBatch &textBatch) const
+	{
+		for (const auto &child : children)
+		{
+			if(child->isVisible())
+			{
+				child->addToTextBatch(textBatch);
+			}
+		}
+	}
+
 }
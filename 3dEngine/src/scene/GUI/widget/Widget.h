@@ -72,6 +72,7 @@ namespace urchin
 			void onDisable();
 
 			virtual void display(int, float);
+			virtual void addToTextBatch(TextBatch &) const;
 
 		protected:
 			unsigned int getSceneWidth() const;
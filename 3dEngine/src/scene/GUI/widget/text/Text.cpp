@@ -1,12 +1,8 @@
-#include <GL/glew.h>
-#include <sstream>
 #include <memory>
 
 #include "scene/GUI/widget/text/Text.h"
-#include "scene/GUI/GUISkinService.h"
 #include "scene/GUI/widget/Size.h"
 #include "resources/MediaManager.h"
-#include "utils/display/quad/QuadDisplayerBuilder.h"
 
 namespace urchin
 {
@@ -17,8 +13,6 @@ namespace urchin
 		maxLength(-1)
 	{
 		font = MediaManager::instance()->getMedia<Font>(fontFilename);
-		quadDisplayerBuilder = std::make_unique<QuadDisplayerBuilder>();
-		quadDisplayer = quadDisplayerBuilder->numberOfQuad(0)->build();
 
 		setText(text);
 	}
@@ -38,107 +32,8 @@ namespace urchin
 		this->text = text;
 		this->maxLength = maxLength;
 
-		//cut the text if needed
-		unsigned int numLetters = 0;
-		std::stringstream cuttedTextStream((maxLength>0) ? cutText(text, maxLength) : text);
-		std::string item;
-		cutTextLines.clear();
-		while (std::getline(cuttedTextStream, item, '\n'))
-		{
-			cutTextLines.push_back(item);
-			numLetters += item.size();
-		}
-
-		//creates the vertex array and texture array
-		vertexData.resize(numLetters*8);
-		textureData.resize(numLetters*8);
-		unsigned int vertexIndex = 0, stIndex = 0;
-		unsigned int width = 0;
-		int offsetY = 0;
-		for (auto &cutTextLine : cutTextLines)
-		{ //each lines
-			unsigned int offsetX = 0;
-			for (char charLetter : cutTextLine)
-			{ //each letters
-				auto letter = static_cast<unsigned char>(charLetter);
-
-				float t = (float)((letter)>>4) / 16.0f;
-				float s = (float)((letter)%16) / 16.0f;
-
-				vertexData[vertexIndex++] = offsetX;
-				vertexData[vertexIndex++] = -font->getGlyph(letter).shift + offsetY;
-				vertexData[vertexIndex++] = font->getGlyph(letter).width + offsetX;
-				vertexData[vertexIndex++] = -font->getGlyph(letter).shift + offsetY;
-				vertexData[vertexIndex++] = font->getGlyph(letter).width + offsetX;
-				vertexData[vertexIndex++] = font->getGlyph(letter).height - font->getGlyph(letter).shift + offsetY;
-				vertexData[vertexIndex++] = offsetX;
-				vertexData[vertexIndex++] = font->getGlyph(letter).height - font->getGlyph(letter).shift + offsetY;
-
-				textureData[stIndex++] = s;
-				textureData[stIndex++] = t;
-				textureData[stIndex++] = s+((float)font->getGlyph(letter).width/font->getDimensionTexture());
-				textureData[stIndex++] = t;
-				textureData[stIndex++] = s+((float)font->getGlyph(letter).width/font->getDimensionTexture());
-				textureData[stIndex++] = t+((float)font->getGlyph(letter).height/font->getDimensionTexture());
-				textureData[stIndex++] = s;
-				textureData[stIndex++] = t+((float)font->getGlyph(letter).height/font->getDimensionTexture());
-
-				offsetX += font->getGlyph(letter).width + font->getSpaceBetweenLetters();
-
-				width = std::max(width, offsetX - font->getSpaceBetweenLetters());
-			}
-			offsetY += font->getSpaceBetweenLines();
-		}
-
-        if(cutTextLines.empty())
-        { //add fake line to compute height
-            cutTextLines.emplace_back("");
-        }
-		unsigned int numberOfInterLines = cutTextLines.size() - 1;
-		setSize(Size(width, cutTextLines.size()*font->getHeight() + numberOfInterLines*font->getSpaceBetweenLines(), Size::SizeType::PIXEL));
-
-		quadDisplayerBuilder
-				->numberOfQuad(numLetters)
-				->vertexData(GL_INT, &vertexData[0], false)
-				->textureData(GL_FLOAT, &textureData[0], false);
-		quadDisplayer->update(quadDisplayerBuilder.get());
-	}
-
-	std::string Text::cutText(const std::string &constText, int maxLength)
-	{
-		std::string text(constText);
-
-		int lineLength = 0;
-		int indexLastSpace = 0;
-		int lengthFromLastSpace = 0;
-
-		for(int numLetter=0; text[numLetter]!=0; numLetter++)
-		{ //each letters
-			auto letter = static_cast<unsigned char>(text[numLetter]);
-
-			if(letter=='\n')
-			{
-				lineLength = 0;
-				lengthFromLastSpace = 0;
-			}else	if(letter==' ')
-			{
-				indexLastSpace = numLetter;
-				lengthFromLastSpace = 0;
-			}
-
-			int lengthLetter = font->getGlyph(letter).width + font->getSpaceBetweenLetters();
-			if(lineLength+lengthLetter >= maxLength)
-			{ //cut line
-				text[indexLastSpace] = '\n';
-				lineLength = lengthFromLastSpace;
-			}else
-			{
-				lineLength += lengthLetter;
-				lengthFromLastSpace += lengthLetter;
-			}
-		}
-
-		return text;
+		glyphRun = font->getGlyphRun(text, maxLength);
+		setSize(Size(glyphRun->width, glyphRun->height, Size::SizeType::PIXEL));
 	}
 
 	const std::string &Text::getText() const
@@ -151,18 +46,14 @@ namespace urchin
 		return font;
 	}
 
-	void Text::display(int translateDistanceLoc, float dt)
+	/**
+	* Text is not displayed by itself: its glyph run is added to the text batch of its root widget
+	*/
+	void Text::addToTextBatch(TextBatch &textBatch) const
 	{
-		glEnable(GL_BLEND);
-		glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
-
-		glBindTexture(GL_TEXTURE_2D, font->getTextureID());
-
-		quadDisplayer->display();
-		
-		glDisable(GL_BLEND);
+		textBatch.addGlyphRun(font->getTextureID(), glyphRun, Point2<int>(getGlobalPositionX(), getGlobalPositionY()));
 
-		Widget::display(translateDistanceLoc, dt);
+		Widget::addToTextBatch(textBatch);
 	}
 
 }
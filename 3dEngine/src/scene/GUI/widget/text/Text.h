@@ -7,7 +7,6 @@
 #include "scene/GUI/widget/Widget.h"
 #include "scene/GUI/widget/Position.h"
 #include "resources/font/Font.h"
-#include "utils/display/quad/QuadDisplayer.h"
 
 namespace urchin
 {
@@ -23,25 +22,17 @@ namespace urchin
 			void setText(const std::string &, int maxLength=-1);
 			const std::string &getText() const;
 			const Font *getFont();
-			
-			void display(int, float) override;
 
-		private:
-			std::string cutText(const std::string &, int);
+			void addToTextBatch(TextBatch &) const override;
 
+		private:
 			//properties
 			std::string text;
 			int maxLength;
 
-			//data
-			std::vector<std::string> cutTextLines;
-			std::vector<int> vertexData;
-			std::vector<float> textureData;
-
 			//visual
 			Font *font;
-			std::unique_ptr<QuadDisplayerBuilder> quadDisplayerBuilder;
-			std::shared_ptr<QuadDisplayer> quadDisplayer;
+			std::shared_ptr<const GlyphRun> glyphRun;
 	};
 	
 }
@@ -4,6 +4,7 @@
 #include <iostream>
 
 #include "SceneManager.h"
+#include "resources/MediaManager.h"
 
 #define START_FPS 1000.0f //high number of FPS to avoid pass through the ground at startup
 #define RENDERER_3D 0
@@ -46,6 +47,10 @@ namespace urchin
 			delete guiRenderer;
 		}
 
+		//cached resources could use the graphic API: destroy them while the context is alive
+		MediaManager::instance()->releasePreloadedMedias();
+		ResourceManager::instance()->purgeCache();
+
 		Profiler::getInstance("3d")->log();
 	}
 
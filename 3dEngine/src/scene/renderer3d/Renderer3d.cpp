@@ -15,6 +15,7 @@ namespace urchin
 			width(0),
 			height(0),
 			modelDisplayer(nullptr),
+			lodSelector(nullptr),
 			fogManager(nullptr),
 			terrainManager(nullptr),
 			waterManager(nullptr),
@@ -32,6 +33,7 @@ namespace urchin
 		textureIDs = new unsigned int[4];
 		modelDisplayer = new ModelDisplayer(ModelDisplayer::DEFAULT_MODE);
 		modelDisplayer->initialize();
+		lodSelector = new LodSelector();
 		glGenFramebuffers(1, fboIDs);
 		glGenTextures(4, textureIDs);
 
@@ -61,6 +63,9 @@ namespace urchin
 		antiAliasingManager = new AntiAliasingManager();
 		isAntiAliasingActivated = true;
 
+		occlusionCuller = new OcclusionCuller();
+		isOcclusionCullingActivated = false;
+
 		//default black skybox
 		skybox = new Skybox();
 	}
@@ -75,6 +80,7 @@ namespace urchin
 
 		//managers
 		delete modelDisplayer;
+		delete lodSelector;
 		delete waterManager;
 		delete terrainManager;
 		delete fogManager;
@@ -84,6 +90,7 @@ namespace urchin
 		delete lightManager;
 		delete ambientOcclusionManager;
 		delete antiAliasingManager;
+		delete occlusionCuller;
 
 		//skybox
 		delete skybox;
@@ -109,7 +116,7 @@ namespace urchin
 		std::locale::global(std::locale("C")); //for float
 
 		std::map<std::string, std::string> tokens;
-		tokens["MAX_LIGHTS"] = std::to_string(lightManager->getMaxLights());
+		tokens["MAX_SUN_LIGHTS"] = std::to_string(lightManager->getMaxSunLights());
 		tokens["NUMBER_SHADOW_MAPS"] = std::to_string(shadowManager->getNumberShadowMaps());
 		tokens["SHADOW_MAP_BIAS"] = std::to_string(shadowManager->getShadowMapBias());
 		tokens["OUTPUT_LOCATION"] = "0"; // isAntiAliasingActivated ? "0" /*TEX_LIGHTING_PASS*/ : "0" /*Screen*/;
@@ -279,6 +286,19 @@ namespace urchin
 		this->isAntiAliasingActivated = isAntiAliasingActivated;
 	}
 
+	void Renderer3d::activateOcclusionCulling(bool isOcclusionCullingActivated)
+	{
+		this->isOcclusionCullingActivated = isOcclusionCullingActivated;
+	}
+
+	/**
+	 * @return Statistics of the occlusion culling of the last frame
+	 */
+	const OcclusionStatistics &Renderer3d::getOcclusionStatistics() const
+	{
+		return occlusionCuller->getStatistics();
+	}
+
 	void Renderer3d::setCamera(Camera *camera)
 	{
 		this->camera = camera;
@@ -294,6 +314,8 @@ namespace urchin
 
 		modelDisplayer->onCameraProjectionUpdate(camera);
 
+		lightManager->onCameraProjectionUpdate(camera);
+
 		terrainManager->onCameraProjectionUpdate(camera);
 
 		waterManager->onCameraProjectionUpdate(camera);
@@ -350,6 +372,22 @@ namespace urchin
 		return std::find(allOctreeables.begin(), allOctreeables.end(), model) != allOctreeables.end();
 	}
 
+	/**
+	 * @return Statistics on the skinning performed and skipped in the last frame
+	 */
+	const AnimationStatistics &Renderer3d::getAnimationStatistics() const
+	{
+		return modelDisplayer->getAnimationStatistics();
+	}
+
+	/**
+	 * @return Statistics on the levels of detail selected in the last frame
+	 */
+	const LodStatistics &Renderer3d::getLodStatistics() const
+	{
+		return lodSelector->getStatistics();
+	}
+
 	bool Renderer3d::onKeyDown(unsigned int key)
 	{
 		if(camera && key<260)
@@ -473,29 +511,43 @@ namespace urchin
 		modelOctreeManager->refreshOctreeables();
 
 		//determine visible lights on scene
-		lightManager->updateLights(camera->getFrustum());
+		lightManager->updateLights(camera);
 
-		//determine models producing shadow on scene
+		//determine models producing shadow on scene and models visible on scene
 		if(isShadowActivated)
 		{
 			shadowManager->updateVisibleModels(camera->getFrustum());
+			modelsInFrustum = shadowManager->getModelsInFrustum();
+		}else
+		{
+			updateModelsInFrustum();
 		}
 
-		//animate models (only those visible to scene OR producing shadow on scene)
-		if(isShadowActivated)
+		//remove models hidden by occluders: culling is executed in parallel of the animation and the shadow maps update
+		if(isOcclusionCullingActivated)
 		{
-			modelDisplayer->setModels(shadowManager->computeVisibleModels());
-		}else
-		{
-            updateModelsInFrustum();
-			modelDisplayer->setModels(modelsInFrustum);
+			occlusionCuller->startCulling(camera, modelsInFrustum);
+			if(!isShadowActivated)
+			{ //models hidden by occluders and not producing shadow don't need to be animated
+				modelsInFrustum = occlusionCuller->waitVisibleModels();
+			}
 		}
-		modelDisplayer->updateAnimation(dt);
+
+		//select level of detail and animate models (only those visible to scene OR producing shadow on scene)
+		const std::vector<Model *> &displayedModels = isShadowActivated ? shadowManager->computeVisibleModels() : modelsInFrustum;
+		lodSelector->selectLods(displayedModels, camera);
+		modelDisplayer->setModels(displayedModels);
+		modelDisplayer->updateAnimation(dt, modelsInFrustum, camera);
 
 		//update shadow maps
 		if(isShadowActivated)
 		{
 			shadowManager->updateShadowMaps();
+
+			if(isOcclusionCullingActivated)
+			{
+				modelsInFrustum = occlusionCuller->waitVisibleModels();
+			}
 		}
 	}
 
@@ -511,7 +563,6 @@ namespace urchin
 
 		skybox->display(camera->getViewMatrix(), camera->getPosition());
 
-        updateModelsInFrustum();
         modelDisplayer->setModels(modelsInFrustum);
 
 		modelDisplayer->display(camera->getViewMatrix());
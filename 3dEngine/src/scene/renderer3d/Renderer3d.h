@@ -9,9 +9,11 @@
 #include "scene/Renderer.h"
 #include "scene/renderer3d/camera/Camera.h"
 #include "scene/renderer3d/model/displayer/ModelDisplayer.h"
+#include "scene/renderer3d/model/displayer/LodSelector.h"
 #include "scene/renderer3d/antialiasing/AntiAliasingManager.h"
 #include "scene/renderer3d/octree/OctreeManager.h"
 #include "scene/renderer3d/shadow/ShadowManager.h"
+#include "scene/renderer3d/occlusion/OcclusionCuller.h"
 #include "scene/renderer3d/ambientocclusion/AmbientOcclusionManager.h"
 #include "scene/renderer3d/model/Model.h"
 #include "scene/renderer3d/model/displayer/ModelDisplayer.h"
@@ -58,6 +60,9 @@ namespace urchin
 			AntiAliasingManager *getAntiAliasingManager() const;
 			void activateAntiAliasing(bool);
 
+			void activateOcclusionCulling(bool);
+			const OcclusionStatistics &getOcclusionStatistics() const;
+
 			//camera
 			void setCamera(Camera *);
 			Camera *getCamera() const;
@@ -70,6 +75,8 @@ namespace urchin
 			void addModel(Model *);
 			void removeModel(Model *);
 			bool isModelExist(Model *);
+			const AnimationStatistics &getAnimationStatistics() const;
+			const LodStatistics &getLodStatistics() const;
 
 			//events
 			bool onKeyDown(unsigned int) override;
@@ -99,6 +106,7 @@ namespace urchin
 
 			//managers
 			ModelDisplayer *modelDisplayer;
+			LodSelector *lodSelector;
 			OctreeManager<Model> *modelOctreeManager;
 			std::vector<Model *> modelsInFrustum;
 
@@ -121,6 +129,9 @@ namespace urchin
 			AntiAliasingManager *antiAliasingManager;
 			bool isAntiAliasingActivated;
 
+			OcclusionCuller *occlusionCuller;
+			bool isOcclusionCullingActivated;
+
 			//camera
 			Camera *camera;
 
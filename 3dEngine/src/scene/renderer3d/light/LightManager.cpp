@@ -1,5 +1,6 @@
 #include <GL/glew.h>
 #include <stdexcept>
+#include <cmath>
 
 #include "LightManager.h"
 #include "scene/renderer3d/light/sun/SunLight.h"
@@ -12,12 +13,21 @@ namespace urchin
 
 	LightManager::LightManager() :
 			lastUpdatedLight(nullptr),
-			maxLights(ConfigService::instance()->getUnsignedIntValue("light.maxLights")),
+			maxSunLights(ConfigService::instance()->getUnsignedIntValue("light.maxSunLights")),
+			lightClusterBuilder(ConfigService::instance()->getUnsignedIntValue("light.clusterGridSizeX"),
+					ConfigService::instance()->getUnsignedIntValue("light.clusterGridSizeY"),
+					ConfigService::instance()->getUnsignedIntValue("light.clusterGridSizeZ")),
+			storageBufferIDs(),
+			mViewLoc(0),
+			clusterGridSizeLoc(0),
+			clusterDepthParamsLoc(0),
 			globalAmbientColorLoc(0),
 			globalAmbientColor(Point4<float>(0.0, 0.0, 0.0, 0.0))
 	{
-		lightsInfo = new LightInfo[maxLights];
+		lightsInfo = new LightInfo[maxSunLights];
 		lightOctreeManager = new OctreeManager<Light>(DEFAULT_OCTREE_MIN_SIZE);
+
+		glGenBuffers(3, storageBufferIDs);
 	}
 
 	LightManager::~LightManager()
@@ -35,13 +45,14 @@ namespace urchin
 
 		delete lightOctreeManager;
 		delete [] lightsInfo;
+
+		glDeleteBuffers(3, storageBufferIDs);
 	}
 
 	void LightManager::loadUniformLocationFor(unsigned int deferredShaderID)
 	{
-		std::ostringstream isExistLocName, produceShadowLocName, hasParallelBeamsName, positionOrDirectionLocName;
-		std::ostringstream exponentialAttName, lightAmbientName;
-		for(unsigned int i=0;i<maxLights;++i)
+		std::ostringstream isExistLocName, produceShadowLocName, directionLocName, lightAmbientName;
+		for(unsigned int i=0;i<maxSunLights;++i)
 		{
 			isExistLocName.str("");
 			isExistLocName << "lightsInfo[" << i << "].isExist";
@@ -49,30 +60,30 @@ namespace urchin
 			produceShadowLocName.str("");
 			produceShadowLocName << "lightsInfo[" << i << "].produceShadow";
 
-			hasParallelBeamsName.str("");
-			hasParallelBeamsName << "lightsInfo[" << i << "].hasParallelBeams";
-
-			positionOrDirectionLocName.str("");
-			positionOrDirectionLocName << "lightsInfo[" << i << "].positionOrDirection";
-
-			exponentialAttName.str("");
-			exponentialAttName << "lightsInfo[" << i << "].exponentialAttenuation";
+			directionLocName.str("");
+			directionLocName << "lightsInfo[" << i << "].direction";
 
 			lightAmbientName.str("");
 			lightAmbientName << "lightsInfo[" << i << "].lightAmbient";
 
 			lightsInfo[i].isExistLoc = glGetUniformLocation(deferredShaderID, isExistLocName.str().c_str());
 			lightsInfo[i].produceShadowLoc = glGetUniformLocation(deferredShaderID, produceShadowLocName.str().c_str());
-			lightsInfo[i].hasParallelBeamsLoc = glGetUniformLocation(deferredShaderID, hasParallelBeamsName.str().c_str());
-			lightsInfo[i].positionOrDirectionLoc = glGetUniformLocation(deferredShaderID, positionOrDirectionLocName.str().c_str());
-
-			lightsInfo[i].exponentialAttLoc = glGetUniformLocation(deferredShaderID, exponentialAttName.str().c_str());
+			lightsInfo[i].directionLoc = glGetUniformLocation(deferredShaderID, directionLocName.str().c_str());
 			lightsInfo[i].lightAmbientLoc = glGetUniformLocation(deferredShaderID, lightAmbientName.str().c_str());
 		}
 
+		mViewLoc = glGetUniformLocation(deferredShaderID, "mView");
+		clusterGridSizeLoc = glGetUniformLocation(deferredShaderID, "clusterGridSize");
+		clusterDepthParamsLoc = glGetUniformLocation(deferredShaderID, "clusterDepthParams");
+
 		globalAmbientColorLoc = glGetUniformLocation(deferredShaderID, "globalAmbient");
 	}
 
+	void LightManager::onCameraProjectionUpdate(const Camera *camera)
+	{
+		lightClusterBuilder.onProjectionUpdate(camera->getProjectionMatrix(), camera->getNearPlane(), camera->getFarPlane());
+	}
+
 	OctreeManager<Light> *LightManager::getLightOctreeManager() const
 	{
 		return lightOctreeManager;
@@ -90,11 +101,11 @@ namespace urchin
 	}
 
 	/**
-	 * @return Maximum of lights authorized to affect the scene in the same time
+	 * @return Maximum of sun lights authorized to affect the scene in the same time
 	 */
-	unsigned int LightManager::getMaxLights() const
+	unsigned int LightManager::getMaxSunLights() const
 	{
-		return maxLights;
+		return maxSunLights;
 	}
 
 	const std::vector<Light *> &LightManager::getVisibleLights() const
@@ -147,48 +158,65 @@ namespace urchin
 		return globalAmbientColor;
 	}
 
-	void LightManager::updateLights(const Frustum<float> &frustum)
+	void LightManager::updateLights(const Camera *camera)
 	{
 		ScopeProfiler profiler("3d", "updateLights");
 
 		lightOctreeManager->refreshOctreeables();
         lightsInFrustum.clear();
-		lightOctreeManager->getOctreeablesIn(frustum, lightsInFrustum);
+		lightOctreeManager->getOctreeablesIn(camera->getFrustum(), lightsInFrustum);
 
 		visibleLights.clear();
 		visibleLights = parallelBeamsLights;
 		visibleLights.insert(visibleLights.end(), lightsInFrustum.begin(), lightsInFrustum.end());
+
+		clusterOmnidirectionalLights(camera->getViewMatrix());
+	}
+
+	/**
+	 * Assign the omnidirectional lights in frustum to the clusters of the camera frustum
+	 */
+	void LightManager::clusterOmnidirectionalLights(const Matrix4<float> &viewMatrix)
+	{
+		ScopeProfiler profiler("3d", "clusterLights");
+
+		this->viewMatrix = viewMatrix;
+		viewSpaceLightSpheres.clear();
+		omnidirectionalLightsData.clear();
+		for(auto lightInFrustum : lightsInFrustum)
+		{
+			if(lightInFrustum->getLightType()!=Light::OMNIDIRECTIONAL)
+			{
+				throw std::invalid_argument("Unknown light type to cluster: " + std::to_string(lightInFrustum->getLightType()));
+			}
+			const auto *omnidirectionalLight = dynamic_cast<const OmnidirectionalLight *>(lightInFrustum);
+
+			const Sphere<float> &sphereScope = omnidirectionalLight->getSphereScope();
+			Point3<float> viewSpaceCenter = (viewMatrix * Point4<float>(sphereScope.getCenterOfMass(), 1.0f)).toPoint3();
+			viewSpaceLightSpheres.emplace_back(Sphere<float>(sphereScope.getRadius(), viewSpaceCenter));
+
+			const Point3<float> &position = omnidirectionalLight->getPosition();
+			const Point3<float> &ambientColor = omnidirectionalLight->getAmbientColor();
+			omnidirectionalLightsData.push_back({
+				Point4<float>(position.X, position.Y, position.Z, omnidirectionalLight->getExponentialAttenuation()),
+				Point4<float>(ambientColor.X, ambientColor.Y, ambientColor.Z, 0.0f)});
+		}
+
+		lightClusterBuilder.buildClusters(viewSpaceLightSpheres);
 	}
 
 	void LightManager::loadLights()
 	{
-		const std::vector<Light *> &lights = getVisibleLights();
-		for(unsigned int i=0; i < maxLights; ++i)
+		for(unsigned int i=0; i < maxSunLights; ++i)
 		{
-			if(lights.size() > i)
+			if(parallelBeamsLights.size() > i)
 			{
-				const Light *light = lights[i];
+				const auto *sunLight = dynamic_cast<const SunLight *>(parallelBeamsLights[i]);
 
 				glUniform1i(lightsInfo[i].isExistLoc, true);
-				glUniform1i(lightsInfo[i].produceShadowLoc, light->isProduceShadow());
-				glUniform1i(lightsInfo[i].hasParallelBeamsLoc, light->hasParallelBeams());
-				if(lights[i]->getLightType()==Light::SUN)
-				{
-					const auto *sunLight = dynamic_cast<const SunLight *>(light);
-
-					glUniform3fv(lightsInfo[i].positionOrDirectionLoc, 1, (const float *)sunLight->getDirections()[0]);
-				}else if(lights[i]->getLightType()==Light::OMNIDIRECTIONAL)
-				{
-					const auto *omnidirectionalLight = dynamic_cast<const OmnidirectionalLight *>(light);
-
-					glUniform3fv(lightsInfo[i].positionOrDirectionLoc, 1, (const float *)omnidirectionalLight->getPosition());
-					glUniform1f(lightsInfo[i].exponentialAttLoc, omnidirectionalLight->getExponentialAttenuation());
-				}else
-				{
-					throw std::invalid_argument("Unknown light type to load uniform: " + std::to_string(light->getLightType()));
-				}
-
-				glUniform3fv(lightsInfo[i].lightAmbientLoc, 1, (const float *)light->getAmbientColor());
+				glUniform1i(lightsInfo[i].produceShadowLoc, sunLight->isProduceShadow());
+				glUniform3fv(lightsInfo[i].directionLoc, 1, (const float *)sunLight->getDirections()[0]);
+				glUniform3fv(lightsInfo[i].lightAmbientLoc, 1, (const float *)sunLight->getAmbientColor());
 			}else
 			{
 				glUniform1i(lightsInfo[i].isExistLoc, false);
@@ -196,14 +224,47 @@ namespace urchin
 			}
 		}
 
+		glUniformMatrix4fv(mViewLoc, 1, GL_FALSE, (const float *)viewMatrix);
+		glUniform3ui(clusterGridSizeLoc, lightClusterBuilder.getGridSizeX(), lightClusterBuilder.getGridSizeY(), lightClusterBuilder.getGridSizeZ());
+		glUniform2f(clusterDepthParamsLoc, lightClusterBuilder.getNearPlane(),
+				(float)lightClusterBuilder.getGridSizeZ() / std::log(lightClusterBuilder.getFarPlane() / lightClusterBuilder.getNearPlane()));
+
+		const std::vector<LightCluster> &clusters = lightClusterBuilder.getClusters();
+		const std::vector<unsigned int> &lightIndices = lightClusterBuilder.getLightIndices();
+		loadStorageBuffer(OMNIDIRECTIONAL_LIGHTS_BUFFER, omnidirectionalLightsData.size() * sizeof(OmnidirectionalLightData), omnidirectionalLightsData.data());
+		loadStorageBuffer(LIGHT_CLUSTERS_BUFFER, clusters.size() * sizeof(LightCluster), clusters.data());
+		loadStorageBuffer(LIGHT_INDICES_BUFFER, lightIndices.size() * sizeof(unsigned int), lightIndices.data());
+
 		glUniform4fv(globalAmbientColorLoc, 1, (const float *)getGlobalAmbientColor());
 	}
 
+	void LightManager::loadStorageBuffer(unsigned int bufferIndex, std::size_t size, const void *data)
+	{
+		glBindBuffer(GL_SHADER_STORAGE_BUFFER, storageBufferIDs[bufferIndex]);
+		if(size==0)
+		{ //buffer without data cannot be bound
+			unsigned int emptyData = 0;
+			glBufferData(GL_SHADER_STORAGE_BUFFER, sizeof(emptyData), &emptyData, GL_STREAM_DRAW);
+		}else
+		{
+			glBufferData(GL_SHADER_STORAGE_BUFFER, size, data, GL_STREAM_DRAW);
+		}
+		glBindBufferBase(GL_SHADER_STORAGE_BUFFER, bufferIndex, storageBufferIDs[bufferIndex]);
+	}
+
 	void LightManager::postUpdateLights()
 	{
 		lightOctreeManager->postRefreshOctreeables();
 	}
 
+	/**
+	 * @return Statistics of the omnidirectional lights assignment to the clusters in the last frame
+	 */
+	const LightClusterStatistics &LightManager::getClusterStatistics() const
+	{
+		return lightClusterBuilder.getStatistics();
+	}
+
 #ifdef _DEBUG
 	void LightManager::drawLightOctree(const Matrix4<float> &projectionMatrix, const Matrix4<float> &viewMatrix) const
 	{
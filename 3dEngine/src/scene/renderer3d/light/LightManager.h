@@ -6,10 +6,15 @@
 
 #include "Light.h"
 #include "scene/renderer3d/octree/OctreeManager.h"
+#include "scene/renderer3d/camera/Camera.h"
 
 namespace urchin
 {
 
+	/**
+	* Manage the lights of the scene. Sun lights are loaded in uniforms. Omnidirectional lights are assigned to the clusters
+	* of the camera frustum and loaded in storage buffers: their number is not limited.
+	*/
 	class LightManager : public Observable
 	{
 		public:
@@ -23,10 +28,11 @@ namespace urchin
 			};
 
 			void loadUniformLocationFor(unsigned int);
+			void onCameraProjectionUpdate(const Camera *);
 			OctreeManager<Light> *getLightOctreeManager() const;
 			Light *getLastUpdatedLight();
 
-			unsigned int getMaxLights() const;
+			unsigned int getMaxSunLights() const;
 			const std::vector<Light *> &getVisibleLights() const;
 			void addLight(Light *);
 			void removeLight(Light *);
@@ -34,9 +40,10 @@ namespace urchin
 			void setGlobalAmbientColor(const Point4<float> &);
 			const Point4<float> &getGlobalAmbientColor() const;
 
-			void updateLights(const Frustum<float> &);
+			void updateLights(const Camera *);
 			void loadLights();
 			void postUpdateLights();
+			const LightClusterStatistics &getClusterStatistics() const;
 
 			#ifdef _DEBUG
 				void drawLightOctree(const Matrix4<float> &, const Matrix4<float> &) const;
@@ -44,6 +51,8 @@ namespace urchin
 
 		private:
 			void onLightEvent(Light *, NotificationType);
+			void clusterOmnidirectionalLights(const Matrix4<float> &);
+			void loadStorageBuffer(unsigned int, std::size_t, const void *);
 
 			//lights container
 			std::vector<Light *> parallelBeamsLights; //sun lights
@@ -53,19 +62,35 @@ namespace urchin
 
 			Light *lastUpdatedLight;
 
-			const unsigned int maxLights; //maximum of lights authorized to affect the scene in the same time
+			const unsigned int maxSunLights; //maximum of sun lights authorized to affect the scene in the same time
 			struct LightInfo
 			{
 				int isExistLoc;
 				int produceShadowLoc;
-				int hasParallelBeamsLoc;
-				int positionOrDirectionLoc;
-
-				int exponentialAttLoc;
+				int directionLoc;
 				int lightAmbientLoc;
 			};
 			LightInfo *lightsInfo;
 
+			//omnidirectional lights assigned to clusters
+			struct OmnidirectionalLightData
+			{
+				Point4<float> positionAndAttenuation; //xyz: position, w: exponential attenuation
+				Point4<float> lightAmbient;
+			};
+			enum //storage buffer IDs indices: same values as the binding points in shader
+			{
+				OMNIDIRECTIONAL_LIGHTS_BUFFER = 0,
+				LIGHT_CLUSTERS_BUFFER,
+				LIGHT_INDICES_BUFFER
+			};
+			LightClusterBuilder lightClusterBuilder;
+			std::vector<Sphere<float>> viewSpaceLightSpheres;
+			std::vector<OmnidirectionalLightData> omnidirectionalLightsData;
+			unsigned int storageBufferIDs[3];
+			int mViewLoc, clusterGridSizeLoc, clusterDepthParamsLoc;
+			Matrix4<float> viewMatrix;
+
 			int globalAmbientColorLoc;
 			Point4<float> globalAmbientColor;
 	};
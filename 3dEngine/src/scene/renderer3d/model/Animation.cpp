@@ -1,4 +1,5 @@
 #include "Animation.h"
+#include "resources/model/MeshService.h"
 
 namespace urchin
 {
@@ -8,6 +9,7 @@ namespace urchin
 		meshes(meshes)
 	{
 		skeleton.resize(constAnimation->getNumberBones());
+		boneTrackCursors.resize(constAnimation->getNumberBones());
 
 		animationInformation.currFrame = 0;
 		animationInformation.nextFrame = 1;
@@ -69,9 +71,9 @@ namespace urchin
 	{
 		//calculate current and next frames
 		animationInformation.lastTime += dt;
-		if(animationInformation.lastTime >= animationInformation.maxTime) //move to next frame
+		while(animationInformation.lastTime >= animationInformation.maxTime) //move to next frame (several frames when the model is not animated at each rendering frame)
 		{
-			animationInformation.lastTime = 0.0f;
+			animationInformation.lastTime -= animationInformation.maxTime;
 			animationInformation.currFrame = animationInformation.nextFrame;
 			animationInformation.nextFrame++;
 
@@ -79,32 +81,60 @@ namespace urchin
 			{
 				animationInformation.nextFrame = 0;
 			}
+
+			if(animationInformation.currFrame==0)
+			{ //stop on first frame to allow the animation to be stopped at its last frame
+				animationInformation.lastTime = 0.0f;
+			}
 		}
 
 		//interpolate skeletons between two frames
 		float interp = animationInformation.lastTime * constAnimation->getFrameRate();
+		bool isConsecutiveFrames = animationInformation.nextFrame == animationInformation.currFrame + 1;
 		for(unsigned int i = 0; i < constAnimation->getNumberBones(); ++i)
 		{
-			//shortcut
-			const Bone &currentFrameBone = constAnimation->getBone(animationInformation.currFrame, i);
-			const Bone &nextFrameBone = constAnimation->getBone(animationInformation.nextFrame, i);
-
 			//copy parent index
-			skeleton[i].parent = currentFrameBone.parent;
+			skeleton[i].parent = constAnimation->getBoneParent(i);
+
+			if(isConsecutiveFrames)
+			{ //sample the compressed tracks directly between the two frames
+				constAnimation->sampleBone(static_cast<float>(animationInformation.currFrame) + interp, i, boneTrackCursors[i], skeleton[i].pos, skeleton[i].orient);
+			}else
+			{ //loop from last frame to first frame
+				Point3<float> currentFramePos = constAnimation->getBonePosition(animationInformation.currFrame, i);
+				Point3<float> nextFramePos = constAnimation->getBonePosition(animationInformation.nextFrame, i);
+
+				//linear interpolation for position
+				skeleton[i].pos.X = currentFramePos.X + interp * (nextFramePos.X - currentFramePos.X);
+				skeleton[i].pos.Y = currentFramePos.Y + interp * (nextFramePos.Y - currentFramePos.Y);
+				skeleton[i].pos.Z = currentFramePos.Z + interp * (nextFramePos.Z - currentFramePos.Z);
+
+				//spherical linear interpolation for orientation
+				Quaternion<float> currentFrameOrient = constAnimation->getBoneOrientation(animationInformation.currFrame, i);
+				skeleton[i].orient = currentFrameOrient.slerp(constAnimation->getBoneOrientation(animationInformation.nextFrame, i), interp);
+			}
+		}
 
-			//linear interpolation for position
-			skeleton[i].pos.X = currentFrameBone.pos.X + interp * (nextFrameBone.pos.X - currentFrameBone.pos.X);
-			skeleton[i].pos.Y = currentFrameBone.pos.Y + interp * (nextFrameBone.pos.Y - currentFrameBone.pos.Y);
-			skeleton[i].pos.Z = currentFrameBone.pos.Z + interp * (nextFrameBone.pos.Z - currentFrameBone.pos.Z);
+		//bones are converted in matrices once for all meshes
+		MeshService::instance()->computeBoneMatrices(skeleton, boneMatrices);
+	}
 
-			//spherical linear interpolation for orientation
-			skeleton[i].orient = currentFrameBone.orient.slerp(nextFrameBone.orient, interp);
+	/**
+	 * Update the vertices and normals of the meshes according to the current skeleton. This method can be executed in any thread.
+	 */
+	void Animation::updateSkinning()
+	{
+		for(unsigned m=0; m<meshes->getNumberMeshes(); ++m)
+		{
+			meshes->getMesh(m)->updateSkinning(boneMatrices);
 		}
+	}
 
-		//update the vertex and normals
+	void Animation::updateVertexBuffers()
+	{
 		for(unsigned m=0; m<meshes->getNumberMeshes(); ++m)
 		{
-			meshes->getMesh(m)->update(skeleton);
+			meshes->getMesh(m)->updateVertexBuffers();
 		}
 	}
 
@@ -25,6 +25,8 @@ namespace urchin
 			int getCurrFrame() const;
 
 			void animate(float);
+			void updateSkinning();
+			void updateVertexBuffers();
 
 			void onMoving(const Transform<float> &);
 
@@ -34,6 +36,8 @@ namespace urchin
 			
 			AnimationInformation animationInformation;
 			std::vector<Bone> skeleton;
+			std::vector<BoneTrackCursor> boneTrackCursors;
+			std::vector<Matrix4<float>> boneMatrices;
 			AABBox<float> globalBBox; //bounding box transformed by the transformation of the model
 			std::vector<AABBox<float>> globalSplitBBoxes;
 	};
@@ -1,7 +1,9 @@
 #include <GL/glew.h>
+#include <algorithm>
 
 #include "Mesh.h"
 #include "resources/model/MeshService.h"
+#include "resources/MediaManager.h"
 #include "utils/display/geometry/points/PointsModel.h"
 
 namespace urchin
@@ -9,6 +11,7 @@ namespace urchin
 
 	Mesh::Mesh(const ConstMesh *constMesh) :
 		constMesh(constMesh),
+		material(MediaManager::instance()->getMedia<Material>(constMesh->getMaterialFilename())),
 		vertices(new Point3<float>[constMesh->getNumberVertices()]),
 		dataVertices(new DataVertex[constMesh->getNumberVertices()])
 	{
@@ -23,7 +26,7 @@ namespace urchin
 		glVertexAttribPointer(SHADER_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 
 		glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[VAO_TEX_COORD]);
-		glBufferData(GL_ARRAY_BUFFER, constMesh->getNumberVertices()*sizeof(float)*2, &constMesh->getTextureCoordinates()[0], GL_STATIC_DRAW);
+		glBufferData(GL_ARRAY_BUFFER, constMesh->getNumberVertices()*sizeof(float)*2, constMesh->getTextureCoordinates(), GL_STATIC_DRAW);
 		glEnableVertexAttribArray(SHADER_TEX_COORD);
 		glVertexAttribPointer(SHADER_TEX_COORD, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
 
@@ -34,8 +37,25 @@ namespace urchin
 		glEnableVertexAttribArray(SHADER_TANGENT);
 		glVertexAttribPointer(SHADER_TANGENT, 3, GL_FLOAT, GL_FALSE, sizeof(DataVertex), (char*)(sizeof(float)*3));
 
+		//indices of all levels of detail: triangles of the mesh followed by the triangles of coarser levels
+		unsigned int numberLodsTriangles = constMesh->getLodFirstTriangle(constMesh->getNumberLods());
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferIDs[VAO_INDEX]);
-		glBufferData(GL_ELEMENT_ARRAY_BUFFER, constMesh->getNumberTriangles()*3*sizeof(int),  &constMesh->getTriangles()[0], GL_STATIC_DRAW);
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, numberLodsTriangles*3*sizeof(int), nullptr, GL_STATIC_DRAW);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, constMesh->getNumberTriangles()*3*sizeof(int), constMesh->getTriangles());
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, constMesh->getNumberTriangles()*3*sizeof(int),
+				(numberLodsTriangles - constMesh->getNumberTriangles())*3*sizeof(int), constMesh->getCoarseLodsTriangles());
+
+		//instance data: buffer is provided when vertex array is bound
+		for(unsigned int column=0; column<4; ++column)
+		{
+			glEnableVertexAttribArray(SHADER_MODEL_MATRIX + column);
+			glVertexAttribDivisor(SHADER_MODEL_MATRIX + column, 1);
+		}
+		for(unsigned int column=0; column<3; ++column)
+		{
+			glEnableVertexAttribArray(SHADER_NORMAL_MATRIX + column);
+			glVertexAttribDivisor(SHADER_NORMAL_MATRIX + column, 1);
+		}
 	}
 
 	Mesh::~Mesh()
@@ -45,41 +65,89 @@ namespace urchin
 
 		glDeleteVertexArrays(1, &vertexArrayObject);
 		glDeleteBuffers(4, bufferIDs);
+
+		material->release();
 	}
 
-	void Mesh::update(const std::vector<Bone> &skeleton)
+	/**
+	 * Recompute the vertices and normals. This method doesn't use graphic API and can be executed in any thread.
+	 * @param boneMatrices Bone matrices of the current animation frame
+	 */
+	void Mesh::updateSkinning(const std::vector<Matrix4<float>> &boneMatrices)
 	{
-		//recompute the vertices and normals
-		MeshService::instance()->computeVertices(constMesh, skeleton, vertices);
-		MeshService::instance()->computeNormals(constMesh, vertices, dataVertices);
+		MeshService::instance()->computeVertices(constMesh, boneMatrices, vertices);
+		MeshService::instance()->computeNormals(constMesh, vertices, linkedGroupNormals, dataVertices);
+	}
 
+	/**
+	 * Send the vertices and normals computed by updateSkinning() to the graphic card
+	 */
+	void Mesh::updateVertexBuffers()
+	{
 		glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[VAO_VERTEX_POSITION]);
 		glBufferData(GL_ARRAY_BUFFER, constMesh->getNumberVertices()*sizeof(float)*3, vertices, GL_DYNAMIC_DRAW);
 		glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[VAO_NORMAL_TANGENT]);
 		glBufferData(GL_ARRAY_BUFFER, constMesh->getNumberVertices()*sizeof(DataVertex), dataVertices, GL_DYNAMIC_DRAW);
 	}
 
-	void Mesh::display(const MeshParameter &meshParameter) const
+	const ConstMesh *Mesh::getConstMesh() const
+	{
+		return constMesh;
+	}
+
+	const Material *Mesh::getMaterial() const
+	{
+		return material;
+	}
+
+	void Mesh::bindMaterial(const MeshParameter &meshParameter) const
 	{
 		if(meshParameter.getDiffuseTextureUnit()!=-1)
 		{
 			glActiveTexture(static_cast<GLenum>(meshParameter.getDiffuseTextureUnit()));
-			glBindTexture(GL_TEXTURE_2D, constMesh->getMaterial()->getDiffuseTexture()->getTextureID());
+			glBindTexture(GL_TEXTURE_2D, material->getDiffuseTexture()->getTextureID());
 		}
 
 		if(meshParameter.getNormalTextureUnit()!=-1)
 		{
 			glActiveTexture(static_cast<GLenum>(meshParameter.getNormalTextureUnit()));
-			glBindTexture(GL_TEXTURE_2D, constMesh->getMaterial()->getNormalTexture()->getTextureID());
+			glBindTexture(GL_TEXTURE_2D, material->getNormalTexture()->getTextureID());
 		}
 
 		if(meshParameter.getAmbientFactorLoc()!=-1)
 		{
-			glUniform1f(meshParameter.getAmbientFactorLoc(), constMesh->getMaterial()->getAmbientFactor());
+			glUniform1f(meshParameter.getAmbientFactorLoc(), material->getAmbientFactor());
 		}
+	}
 
+	/**
+	 * @param instanceBufferID Buffer of MeshInstance used by the next draws
+	 */
+	void Mesh::bindVertexArray(unsigned int instanceBufferID) const
+	{
 		glBindVertexArray(vertexArrayObject);
-		glDrawElements(GL_TRIANGLES, constMesh->getNumberTriangles()*3, GL_UNSIGNED_INT, nullptr);
+
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBufferID);
+		for(unsigned int column=0; column<4; ++column)
+		{
+			glVertexAttribPointer(SHADER_MODEL_MATRIX + column, 4, GL_FLOAT, GL_FALSE, sizeof(MeshInstance), (char*)(sizeof(float)*4*column));
+		}
+		for(unsigned int column=0; column<3; ++column)
+		{
+			glVertexAttribPointer(SHADER_NORMAL_MATRIX + column, 3, GL_FLOAT, GL_FALSE, sizeof(MeshInstance), (char*)(sizeof(Matrix4<float>) + sizeof(float)*3*column));
+		}
+	}
+
+	/**
+	 * Draw the mesh bound by bindVertexArray() for the instances [firstInstance, firstInstance + instancesCount[ of the instance buffer
+	 * @param lod Level of detail: coarsest level is used when the mesh has less levels of detail
+	 */
+	void Mesh::drawInstances(unsigned int lod, unsigned int firstInstance, unsigned int instancesCount) const
+	{
+		lod = std::min(lod, constMesh->getNumberLods() - 1);
+		auto firstIndexOffset = reinterpret_cast<const void *>(constMesh->getLodFirstTriangle(lod)*3*sizeof(int));
+
+		glDrawElementsInstancedBaseInstance(GL_TRIANGLES, constMesh->getLodNumberTriangles(lod)*3, GL_UNSIGNED_INT, firstIndexOffset, instancesCount, firstInstance);
 	}
 
 #ifdef _DEBUG
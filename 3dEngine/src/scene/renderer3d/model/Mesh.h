@@ -4,20 +4,36 @@
 #include "UrchinCommon.h"
 
 #include "resources/model/ConstMesh.h"
+#include "resources/material/Material.h"
 #include "scene/renderer3d/model/displayer/MeshParameter.h"
 
 namespace urchin
 {
 
+	/**
+	* Data of one mesh instance in the instance buffer
+	*/
+	struct MeshInstance
+	{
+		Matrix4<float> modelMatrix;
+		Matrix3<float> normalMatrix;
+	};
+
 	class Mesh
 	{
 		public:
 			explicit Mesh(const ConstMesh *);
 			~Mesh();
 
-			void update(const std::vector<Bone> &);
+			void updateSkinning(const std::vector<Matrix4<float>> &);
+			void updateVertexBuffers();
+
+			const ConstMesh *getConstMesh() const;
+			const Material *getMaterial() const;
 
-			void display(const MeshParameter &) const;
+			void bindMaterial(const MeshParameter &) const;
+			void bindVertexArray(unsigned int) const;
+			void drawInstances(unsigned int, unsigned int, unsigned int) const;
 
 			#ifdef _DEBUG
 				void drawBaseBones(const Matrix4<float> &, const Matrix4<float> &) const;
@@ -25,9 +41,11 @@ namespace urchin
 
 		private:
 			const ConstMesh *const constMesh;
+			Material *material;
 
 			Point3<float> *const vertices;
 			DataVertex *const dataVertices; //additional information for the vertex
+			std::vector<Vector3<float>> linkedGroupNormals; //scratch buffer for normals computation
 
 			unsigned int bufferIDs[4], vertexArrayObject;
 			enum //buffer IDs indices
@@ -42,7 +60,9 @@ namespace urchin
 				SHADER_VERTEX_POSITION = 0,
 				SHADER_TEX_COORD,
 				SHADER_NORMAL,
-				SHADER_TANGENT
+				SHADER_TANGENT,
+				SHADER_MODEL_MATRIX, //4 locations: one by column
+				SHADER_NORMAL_MATRIX = SHADER_MODEL_MATRIX + 4 //3 locations: one by column
 			};
 
 	};
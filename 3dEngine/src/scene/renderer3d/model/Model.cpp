@@ -1,4 +1,5 @@
 #include <limits>
+#include <algorithm>
 #include <stdexcept>
 
 #include "Model.h"
@@ -14,7 +15,10 @@ namespace urchin
 			meshes(nullptr),
 			currAnimation(nullptr),
 			stopAnimationAtLastFrame(false),
-			bIsProduceShadow(true)
+			bIsProduceShadow(true),
+			bIsOccluder(false),
+			lod(0),
+			bLodUpdated(false)
 	{
         initialize(meshFilename);
 	}
@@ -22,13 +26,16 @@ namespace urchin
     Model::Model(const Model &model) : Octreeable(model),
             meshes(nullptr),
 			currAnimation(nullptr),
-			stopAnimationAtLastFrame(false)
+			stopAnimationAtLastFrame(false),
+			lod(0),
+			bLodUpdated(false)
     {
         std::string meshFilename = model.getMeshes()!=nullptr ? model.getMeshes()->getName() : "";
         initialize(meshFilename);
 
         setTransform(model.getTransform());
         setProduceShadow(model.isProduceShadow());
+        setOccluder(model.isOccluder());
     }
 
 	Model::~Model()
@@ -74,13 +81,13 @@ namespace urchin
 		for(unsigned int i = 0; i<meshes->getConstMeshes()->getConstMesh(0)->getNumberBones(); ++i)
 		{
 			//bones must have the same parent index
-			if(meshes->getConstMeshes()->getConstMesh(0)->getBaseBone(i).parent != constAnimation->getBone(0, i).parent)
+			if(meshes->getConstMeshes()->getConstMesh(0)->getBaseBone(i).parent != constAnimation->getBoneParent(i))
 			{
 				throw std::runtime_error("Bones haven't the same parent index. Meshes filename: " + meshes->getConstMeshes()->getName() + ", Animation filename: " + constAnimation->getName() + ".");
 			}
 
 			//bones must have the same name
-			if(meshes->getConstMeshes()->getConstMesh(0)->getBaseBone(i).name != constAnimation->getBone(0, i).name)
+			if(meshes->getConstMeshes()->getConstMesh(0)->getBaseBone(i).name != constAnimation->getBoneName(i))
 			{
 				throw std::runtime_error("Bones haven't the same name. Meshes filename: " + meshes->getConstMeshes()->getName() + ", Animation filename: " + constAnimation->getName() + ".");
 			}
@@ -112,6 +119,14 @@ namespace urchin
 		return currAnimation != nullptr;
 	}
 
+	/**
+	 * @return True when an animation has been loaded: vertex buffers of the meshes can differ from the base vertices
+	 */
+	bool Model::hasAnimation() const
+	{
+		return !animations.empty();
+	}
+
 	void Model::onMoving(const Transform<float> &newTransform)
 	{
 		//inform the OctreeManager that the model should be updated in the octree
@@ -220,7 +235,7 @@ namespace urchin
 	void Model::setTransform(const Transform<float> &transform)
 	{
 		this->transform = transform;
-		onMoving(transform);
+		onMoving(this->transform);
 	}
 
 	const Transform<float> &Model::getTransform() const
@@ -241,6 +256,58 @@ namespace urchin
 		return bIsProduceShadow;
 	}
 
+	/**
+	 * @param bIsOccluder Indicate whether model hides the models behind it in occlusion culling. The value should be set to true for
+	 * big static models (buildings, walls...). Triangles of the meshes in bind-pose are used as occluder: models should have few triangles.
+	 */
+	void Model::setOccluder(bool bIsOccluder)
+	{
+		this->bIsOccluder = bIsOccluder;
+	}
+
+	bool Model::isOccluder() const
+	{
+		return bIsOccluder;
+	}
+
+	/**
+	 * @return Number of levels of detail of the model: maximum number of levels of detail of its meshes
+	 */
+	unsigned int Model::getNumberLods() const
+	{
+		unsigned int numberLods = 1;
+		if(meshes)
+		{
+			for (auto constMesh : meshes->getConstMeshes()->getConstMeshes())
+			{
+				numberLods = std::max(numberLods, constMesh->getNumberLods());
+			}
+		}
+		return numberLods;
+	}
+
+	/**
+	 * @param lod Level of detail of the model. Meshes having less levels of detail use their coarsest level.
+	 */
+	void Model::setLod(unsigned int lod)
+	{
+		bLodUpdated = this->lod!=lod;
+		this->lod = lod;
+	}
+
+	unsigned int Model::getLod() const
+	{
+		return lod;
+	}
+
+	/**
+	 * @return True when the level of detail changed at last selection
+	 */
+	bool Model::isLodUpdated() const
+	{
+		return bLodUpdated;
+	}
+
 	void Model::updateAnimation(float dt)
 	{
 		//animate model
@@ -257,15 +324,40 @@ namespace urchin
 		}
 	}
 
-	void Model::display(const MeshParameter &meshParameter) const
+	/**
+	 * Update the meshes vertices according to the current animation. This method can be executed in any thread.
+	 */
+	void Model::updateSkinning()
 	{
-        if(meshes)
-        {
-            for (unsigned int m = 0; m < meshes->getNumberMeshes(); ++m)
-            {
-                meshes->getMesh(m)->display(meshParameter);
-            }
-        }
+		if(isAnimate())
+		{
+			currAnimation->updateSkinning();
+		}
+	}
+
+	/**
+	 * Send the meshes vertices computed by updateSkinning() to the graphic card
+	 */
+	void Model::updateVertexBuffers()
+	{
+		if(isAnimate())
+		{
+			currAnimation->updateVertexBuffers();
+		}
+	}
+
+	unsigned int Model::getNumberMeshes() const
+	{
+		if(meshes)
+		{
+			return meshes->getNumberMeshes();
+		}
+		return 0;
+	}
+
+	const Mesh *Model::getMesh(unsigned int index) const
+	{
+		return meshes->getMesh(index);
 	}
 
 #ifdef _DEBUG
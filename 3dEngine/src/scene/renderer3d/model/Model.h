@@ -26,6 +26,7 @@ namespace urchin
 			void animate(const std::string &);
 			void stopAnimation(bool);
 			bool isAnimate() const;
+			bool hasAnimation() const;
 		
 			const ConstMeshes *getMeshes() const;
 			std::map<std::string, const ConstAnimation *> getAnimations() const;
@@ -42,9 +43,19 @@ namespace urchin
 
 			void setProduceShadow(bool);
 			bool isProduceShadow() const;
+			void setOccluder(bool);
+			bool isOccluder() const;
+
+			unsigned int getNumberLods() const;
+			void setLod(unsigned int);
+			unsigned int getLod() const;
+			bool isLodUpdated() const;
 
 			void updateAnimation(float);
-			void display(const MeshParameter &) const;
+			void updateSkinning();
+			void updateVertexBuffers();
+			unsigned int getNumberMeshes() const;
+			const Mesh *getMesh(unsigned int) const;
 
 			#ifdef _DEBUG
 				void drawBaseBones(const Matrix4<float> &, const Matrix4<float> &) const;
@@ -69,6 +80,11 @@ namespace urchin
 
 			//properties
 			bool bIsProduceShadow;
+			bool bIsOccluder;
+
+			//level of detail
+			unsigned int lod;
+			bool bLodUpdated;
 	};
 
 }
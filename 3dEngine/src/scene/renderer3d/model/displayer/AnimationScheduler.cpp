@@ -0,0 +1,125 @@
+#include <algorithm>
+#include <functional>
+
+#include "AnimationScheduler.h"
+
+namespace urchin
+{
+
+	AnimationScheduler::AnimationScheduler() :
+			fullRateScreenCoverage(ConfigService::instance()->getFloatValue("model.animationFullRateScreenCoverage")),
+			maxUpdateInterval(std::max(1u, ConfigService::instance()->getUnsignedIntValue("model.animationMaxUpdateInterval"))),
+			shadowOnlyUpdateInterval(std::max(1u, ConfigService::instance()->getUnsignedIntValue("model.animationShadowOnlyUpdateInterval"))),
+			frameIndex(0),
+			statistics()
+	{
+
+	}
+
+	/**
+	* Animate the models which must be updated in this frame. Models to skin are available through getScheduledModels().
+	* @param models Models visible on scene or producing shadow on scene
+	* @param visibleModels Models inside the camera frustum. Others models are considered as visible only through their shadow.
+	*/
+	void AnimationScheduler::schedule(float dt, const std::vector<Model *> &models, const std::vector<Model *> &visibleModels, const Camera *camera)
+	{
+		frameIndex++;
+		scheduledModels.clear();
+		statistics = AnimationStatistics();
+
+		visibleModelsSet.clear();
+		visibleModelsSet.insert(visibleModels.begin(), visibleModels.end());
+
+		//models not given anymore are forgotten: their animation is frozen as before
+		nextPendingAnimationTimes.clear();
+		for(auto model : models)
+		{
+			if(!model->isAnimate())
+			{
+				continue;
+			}
+
+			bool isVisible = visibleModelsSet.find(model)!=visibleModelsSet.end();
+			statistics.nbAnimatedModels++;
+			statistics.nbShadowOnlyModels += isVisible ? 0 : 1;
+
+			auto itPendingTime = pendingAnimationTimes.find(model);
+			float animationTime = dt + (itPendingTime!=pendingAnimationTimes.end() ? itPendingTime->second : 0.0f);
+
+			//spread the updates of models having the same interval over the frames
+			unsigned int updateInterval = computeUpdateInterval(model, isVisible, camera);
+			auto phase = static_cast<unsigned int>(std::hash<const Model *>()(model) >> 4u);
+			if((frameIndex + phase) % updateInterval == 0)
+			{
+				model->updateAnimation(animationTime);
+				if(model->isAnimate())
+				{
+					scheduledModels.push_back(model);
+					statistics.nbSkinnedModels++;
+					statistics.nbSkinnedVertices += computeNumberVertices(model);
+				}
+			}else
+			{
+				nextPendingAnimationTimes[model] = animationTime;
+				statistics.nbSkippedModels++;
+				statistics.nbSkippedVertices += computeNumberVertices(model);
+			}
+		}
+		pendingAnimationTimes.swap(nextPendingAnimationTimes);
+	}
+
+	/**
+	* @return Models animated in the last frame which must be skinned
+	*/
+	const std::vector<Model *> &AnimationScheduler::getScheduledModels() const
+	{
+		return scheduledModels;
+	}
+
+	const AnimationStatistics &AnimationScheduler::getStatistics() const
+	{
+		return statistics;
+	}
+
+	/**
+	* @return Number of frames between two updates of the model: a power of two based on the screen coverage of the model
+	*/
+	unsigned int AnimationScheduler::computeUpdateInterval(const Model *model, bool isVisible, const Camera *camera) const
+	{
+		const AABBox<float> &aabbox = model->getAABBox();
+		float radius = aabbox.getHalfSizes().length();
+		float distance = camera->getPosition().distance(aabbox.getCenterOfMass());
+
+		unsigned int updateInterval = 1;
+		if(distance > radius)
+		{
+			//ratio between projected diameter of the bounding sphere and screen height
+			float screenCoverage = radius * camera->getProjectionMatrix().a22 / distance;
+			while(updateInterval < maxUpdateInterval && screenCoverage * (float)(updateInterval * 2) <= fullRateScreenCoverage)
+			{
+				updateInterval *= 2;
+			}
+		}
+
+		if(!isVisible)
+		{
+			updateInterval = std::max(updateInterval, shadowOnlyUpdateInterval);
+		}
+
+		return updateInterval;
+	}
+
+	unsigned int AnimationScheduler::computeNumberVertices(const Model *model) const
+	{
+		unsigned int nbVertices = 0;
+		if(model->getMeshes())
+		{
+			for(auto constMesh : model->getMeshes()->getConstMeshes())
+			{
+				nbVertices += constMesh->getNumberVertices();
+			}
+		}
+		return nbVertices;
+	}
+
+}
@@ -0,0 +1,61 @@
+#ifndef URCHINENGINE_ANIMATIONSCHEDULER_H
+#define URCHINENGINE_ANIMATIONSCHEDULER_H
+
+#include <vector>
+#include <unordered_map>
+#include <unordered_set>
+#include "UrchinCommon.h"
+
+#include "scene/renderer3d/model/Model.h"
+#include "scene/renderer3d/camera/Camera.h"
+
+namespace urchin
+{
+
+	/**
+	* Statistics of the last scheduled frame
+	*/
+	struct AnimationStatistics
+	{
+		unsigned int nbAnimatedModels; //models having an animation in progress
+		unsigned int nbShadowOnlyModels; //animated models outside the camera frustum but producing shadow
+		unsigned int nbSkinnedModels;
+		unsigned int nbSkippedModels;
+		unsigned int nbSkinnedVertices;
+		unsigned int nbSkippedVertices;
+	};
+
+	/**
+	* Decide which animated models must be updated in the current frame. Models are bucketed by their screen coverage:
+	* small models on screen are updated every 2, 4, 8... frames. The animation time elapsed between two updates is
+	* accumulated so the skeleton is interpolated at the right time when the model is updated.
+	*/
+	class AnimationScheduler
+	{
+		public:
+			AnimationScheduler();
+
+			void schedule(float, const std::vector<Model *> &, const std::vector<Model *> &, const Camera *);
+			const std::vector<Model *> &getScheduledModels() const;
+
+			const AnimationStatistics &getStatistics() const;
+
+		private:
+			unsigned int computeUpdateInterval(const Model *, bool, const Camera *) const;
+			unsigned int computeNumberVertices(const Model *) const;
+
+			const float fullRateScreenCoverage;
+			const unsigned int maxUpdateInterval;
+			const unsigned int shadowOnlyUpdateInterval;
+
+			unsigned int frameIndex;
+			std::unordered_map<const Model *, float> pendingAnimationTimes, nextPendingAnimationTimes;
+			std::unordered_set<const Model *> visibleModelsSet;
+			std::vector<Model *> scheduledModels;
+
+			AnimationStatistics statistics;
+	};
+
+}
+
+#endif
@@ -0,0 +1,101 @@
+#include <algorithm>
+#include <limits>
+
+#include "LodSelector.h"
+
+namespace urchin
+{
+
+	LodSelector::LodSelector() :
+			lodScreenCoverage(ConfigService::instance()->getFloatValue("model.lodScreenCoverage")),
+			lodHysteresis(ConfigService::instance()->getFloatValue("model.lodHysteresis")),
+			statistics()
+	{
+
+	}
+
+	/**
+	* Update the level of detail of the models
+	* @param models Models visible on scene or producing shadow on scene
+	*/
+	void LodSelector::selectLods(const std::vector<Model *> &models, const Camera *camera)
+	{
+		ScopeProfiler profiler("3d", "selectLods");
+
+		statistics = LodStatistics();
+		statistics.nbModels = models.size();
+
+		for(auto model : models)
+		{
+			unsigned int numberLods = model->getNumberLods();
+			unsigned int lod = std::min(model->getLod(), numberLods - 1);
+
+			if(numberLods > 1)
+			{
+				float screenCoverage = computeScreenCoverage(model, camera);
+				if(computeLod(screenCoverage * (1.0f + lodHysteresis), numberLods) > lod)
+				{ //coarser level of detail
+					lod = computeLod(screenCoverage * (1.0f + lodHysteresis), numberLods);
+				}else if(computeLod(screenCoverage * (1.0f - lodHysteresis), numberLods) < lod)
+				{ //finer level of detail
+					lod = computeLod(screenCoverage * (1.0f - lodHysteresis), numberLods);
+				}
+			}
+			model->setLod(lod);
+
+			statistics.nbCoarseModels += lod > 0 ? 1 : 0;
+			statistics.nbFullDetailTriangles += computeNumberTriangles(model, 0);
+			statistics.nbSelectedTriangles += computeNumberTriangles(model, lod);
+		}
+	}
+
+	/**
+	* @return Ratio between projected diameter of the bounding sphere and screen height
+	*/
+	float LodSelector::computeScreenCoverage(const Model *model, const Camera *camera) const
+	{
+		const AABBox<float> &aabbox = model->getAABBox();
+		float radius = aabbox.getHalfSizes().length();
+		float distance = camera->getPosition().distance(aabbox.getCenterOfMass());
+
+		if(distance <= radius)
+		{ //camera inside the bounding sphere
+			return std::numeric_limits<float>::max();
+		}
+		return radius * camera->getProjectionMatrix().a22 / distance;
+	}
+
+	unsigned int LodSelector::computeLod(float screenCoverage, unsigned int numberLods) const
+	{
+		unsigned int lod = 0;
+		float screenCoverageLimit = lodScreenCoverage;
+		while(lod + 1 < numberLods && screenCoverage < screenCoverageLimit)
+		{
+			lod++;
+			screenCoverageLimit /= 2.0f;
+		}
+		return lod;
+	}
+
+	unsigned int LodSelector::computeNumberTriangles(const Model *model, unsigned int lod) const
+	{
+		unsigned int nbTriangles = 0;
+		if(model->getMeshes())
+		{
+			for(auto constMesh : model->getMeshes()->getConstMeshes())
+			{
+				nbTriangles += constMesh->getLodNumberTriangles(std::min(lod, constMesh->getNumberLods() - 1));
+			}
+		}
+		return nbTriangles;
+	}
+
+	/**
+	* @return Statistics of the last selection
+	*/
+	const LodStatistics &LodSelector::getStatistics() const
+	{
+		return statistics;
+	}
+
+}
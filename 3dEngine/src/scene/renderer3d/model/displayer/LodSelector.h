@@ -0,0 +1,51 @@
+#ifndef URCHINENGINE_LODSELECTOR_H
+#define URCHINENGINE_LODSELECTOR_H
+
+#include <vector>
+#include "UrchinCommon.h"
+
+#include "scene/renderer3d/model/Model.h"
+#include "scene/renderer3d/camera/Camera.h"
+
+namespace urchin
+{
+
+	/**
+	* Statistics of the last selection
+	*/
+	struct LodStatistics
+	{
+		unsigned int nbModels;
+		unsigned int nbCoarseModels; //models using a coarser level of detail than the first one
+		unsigned int nbFullDetailTriangles; //triangles of the models at their first level of detail
+		unsigned int nbSelectedTriangles; //triangles of the models at their selected level of detail
+	};
+
+	/**
+	* Select the level of detail of the models based on their screen coverage. A model uses its level of detail 'n' when its
+	* screen coverage is below the limit 'lodScreenCoverage / 2^(n-1)'. The hysteresis keeps the current level of detail while
+	* the screen coverage stays close to a limit.
+	*/
+	class LodSelector
+	{
+		public:
+			LodSelector();
+
+			void selectLods(const std::vector<Model *> &, const Camera *);
+
+			const LodStatistics &getStatistics() const;
+
+		private:
+			float computeScreenCoverage(const Model *, const Camera *) const;
+			unsigned int computeLod(float, unsigned int) const;
+			unsigned int computeNumberTriangles(const Model *, unsigned int) const;
+
+			const float lodScreenCoverage;
+			const float lodHysteresis;
+
+			LodStatistics statistics;
+	};
+
+}
+
+#endif
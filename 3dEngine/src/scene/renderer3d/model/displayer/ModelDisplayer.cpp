@@ -24,12 +24,12 @@ namespace urchin
 		displayMode(displayMode),
 		modelShader(0),
 		mProjectionLoc(0),
-		mModelLoc(0),
 		mViewLoc(0),
-		mNormalLoc(0),
 		ambientFactorLoc(0),
 		customUniform(nullptr),
-		customModelUniform(nullptr)
+		customModelUniform(nullptr),
+		lodBias(0),
+		instanceBufferID(0)
 	{
 
 	}
@@ -37,6 +37,7 @@ namespace urchin
 	ModelDisplayer::~ModelDisplayer()
 	{
 		ShaderManager::instance()->removeProgram(modelShader);
+		glDeleteBuffers(1, &instanceBufferID);
 	}
 
 	void ModelDisplayer::initialize()
@@ -56,7 +57,6 @@ namespace urchin
 			}
 			createShader(vertexShaderName, geometryShaderName, fragmentShaderName);
 
-			mNormalLoc = glGetUniformLocation(modelShader, "mNormal");
 			ambientFactorLoc = glGetUniformLocation(modelShader, "ambientFactor");
 			int diffuseTexLoc = glGetUniformLocation(modelShader, "diffuseTex");
 			int normalTexLoc = glGetUniformLocation(modelShader, "normalTex");
@@ -81,7 +81,6 @@ namespace urchin
 			}
 			createShader(vertexShaderName, geometryShaderName, fragmentShaderName);
 
-			mNormalLoc = 0;
 			ambientFactorLoc = 0;
 
 			//setup mesh parameters
@@ -98,6 +97,8 @@ namespace urchin
 		ShaderManager::instance()->bind(modelShader);
 		glUniformMatrix4fv(mProjectionLoc, 1, GL_FALSE, (const float*)projectionMatrix);
 
+		glGenBuffers(1, &instanceBufferID);
+
 		isInitialized=true;
 	}
 
@@ -111,7 +112,6 @@ namespace urchin
 		ShaderManager::instance()->bind(modelShader);
 
 		mProjectionLoc = glGetUniformLocation(modelShader, "mProjection");
-		mModelLoc = glGetUniformLocation(modelShader, "mModel");
 		mViewLoc = glGetUniformLocation(modelShader, "mView");
 	}
 
@@ -165,16 +165,53 @@ namespace urchin
 		this->models = models;
 	}
 
-	void ModelDisplayer::updateAnimation(float dt)
+	/**
+	 * @param lodBias Number of levels of detail added to the level of detail of the models (e.g.: coarser models for the shadow maps)
+	 */
+	void ModelDisplayer::setLodBias(unsigned int lodBias)
+	{
+		this->lodBias = lodBias;
+	}
+
+	/**
+	 * Animate the models. Distant models and models only visible through their shadow are animated at a reduced rate.
+	 * @param visibleModels Models inside the camera frustum
+	 */
+	void ModelDisplayer::updateAnimation(float dt, const std::vector<Model *> &visibleModels, const Camera *camera)
 	{
 		ScopeProfiler profiler("3d", "updateAnimation");
 
-		for (auto model : models)
+		animationScheduler.schedule(dt, models, visibleModels, camera);
+		const std::vector<Model *> &animatedModels = animationScheduler.getScheduledModels();
+
+		if(!animatedModels.empty())
 		{
-			model->updateAnimation(dt);
+			if(!skinningJobPool)
+			{ //created on first need because several model displayers exist and most of them don't animate models
+				skinningJobPool = std::make_unique<JobPool>();
+			}
+
+			//skinning of animated models in parallel
+			skinningJobPool->run(static_cast<unsigned int>(animatedModels.size()), [&](unsigned int modelIndex) {
+				animatedModels[modelIndex]->updateSkinning();
+			});
+
+			//graphic API calls must be done in the current thread
+			for (auto animatedModel : animatedModels)
+			{
+				animatedModel->updateVertexBuffers();
+			}
 		}
 	}
 
+	/**
+	 * @return Statistics of the last animation update
+	 */
+	const AnimationStatistics &ModelDisplayer::getAnimationStatistics() const
+	{
+		return animationScheduler.getStatistics();
+	}
+
 	void ModelDisplayer::display(const Matrix4<float> &viewMatrix)
 	{
 		ScopeProfiler profiler("3d", "modelDisplay");
@@ -191,20 +228,88 @@ namespace urchin
 			customUniform->loadCustomUniforms();
 		}
 
-		for (const auto &model : models)
+		buildDrawList();
+		sendMeshInstances();
+
+		const std::vector<DrawCommand> &drawCommands = drawListBuilder.getDrawCommands();
+		for(const auto &drawCommand : drawCommands)
 		{
-			glUniformMatrix4fv(mModelLoc, 1, GL_FALSE, (const float*) model->getTransform().getTransformMatrix());
-			if(displayMode==DEFAULT_MODE)
+			const MeshItem &meshItem = meshItems[drawCommand.itemId];
+			switch(drawCommand.type)
 			{
-				glUniformMatrix3fv(mNormalLoc, 1, GL_TRUE, (const float*) model->getTransform().getTransformMatrix().toMatrix3().inverse());
+				case DrawCommand::BIND_SHADER:
+					break; //one shader by model displayer: already bound
+				case DrawCommand::BIND_MATERIAL:
+					meshItem.mesh->bindMaterial(meshParameter);
+					break;
+				case DrawCommand::BIND_MESH:
+					meshItem.mesh->bindVertexArray(instanceBufferID);
+					break;
+				case DrawCommand::DRAW_INSTANCES:
+					if(customModelUniform)
+					{ //items are not instanceable with custom model uniforms: one instance by draw
+						customModelUniform->loadCustomUniforms(meshItem.model);
+					}
+					meshItem.mesh->drawInstances(meshItem.lod, drawCommand.firstInstance, drawCommand.instancesCount);
+					break;
+				default:
+					throw std::invalid_argument("Unknown draw command type: " + std::to_string(drawCommand.type));
 			}
-			if(customModelUniform)
+		}
+	}
+
+	/**
+	 * Meshes of static models sharing the same geometry are drawn in one instanced draw call. Meshes of models having an animation
+	 * own their vertex buffers and are drawn one by one.
+	 */
+	void ModelDisplayer::buildDrawList()
+	{
+		meshItems.clear();
+		drawListBuilder.clear();
+
+		for (const auto &model : models)
+		{
+			bool instanceable = !model->hasAnimation() && !customModelUniform;
+			for(unsigned int m=0; m<model->getNumberMeshes(); ++m)
 			{
-				customModelUniform->loadCustomUniforms(model);
+				const Mesh *mesh = model->getMesh(m);
+				unsigned int lod = std::min(model->getLod() + lodBias, mesh->getConstMesh()->getNumberLods() - 1);
+				auto materialKey = displayMode==DEFAULT_MODE ? reinterpret_cast<std::size_t>(mesh->getMaterial()) : 0; //material not used in depth only mode
+				auto meshKey = instanceable ? reinterpret_cast<std::size_t>(mesh->getConstMesh()) : reinterpret_cast<std::size_t>(mesh);
+
+				//levels of detail share the vertex data of the mesh: they are drawn as variants of the mesh
+				drawListBuilder.addItem(modelShader, materialKey, meshKey, lod, model->getTransform().getTransformMatrix(), meshItems.size(), instanceable);
+				meshItems.push_back({model, mesh, lod});
 			}
+		}
 
-			model->display(meshParameter);
+		drawListBuilder.build();
+	}
+
+	void ModelDisplayer::sendMeshInstances()
+	{
+		const std::vector<Matrix4<float>> &instancesTransform = drawListBuilder.getInstancesTransform();
+
+		meshInstances.resize(instancesTransform.size());
+		for(unsigned int i=0; i<instancesTransform.size(); ++i)
+		{
+			meshInstances[i].modelMatrix = instancesTransform[i];
+			if(displayMode==DEFAULT_MODE)
+			{
+				meshInstances[i].normalMatrix = instancesTransform[i].toMatrix3().inverse().transpose();
+			}
 		}
+
+		glBindBuffer(GL_ARRAY_BUFFER, instanceBufferID);
+		glBufferData(GL_ARRAY_BUFFER, meshInstances.size()*sizeof(MeshInstance), meshInstances.data(), GL_STREAM_DRAW);
+	}
+
+	/**
+	 * @return Statistics of the last displayed draw list
+	 */
+	const DrawListStatistics &ModelDisplayer::getDrawListStatistics() const
+	{
+		return drawListBuilder.getStatistics();
 	}
 
 #ifdef _DEBUG
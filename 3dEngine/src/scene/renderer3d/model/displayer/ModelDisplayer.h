@@ -4,11 +4,13 @@
 #include <vector>
 #include <map>
 #include <string>
+#include <memory>
 #include "UrchinCommon.h"
 
 #include "MeshParameter.h"
 #include "CustomUniform.h"
 #include "CustomModelUniform.h"
+#include "AnimationScheduler.h"
 #include "scene/renderer3d/model/Model.h"
 #include "scene/renderer3d/camera/Camera.h"
 
@@ -39,9 +41,12 @@ namespace urchin
 			void setCustomUniform(CustomUniform *);
 			void setCustomModelUniform(CustomModelUniform *);
 			void setModels(const std::vector<Model *> &);
+			void setLodBias(unsigned int);
 
-			void updateAnimation(float);
+			void updateAnimation(float, const std::vector<Model *> &, const Camera *);
+			const AnimationStatistics &getAnimationStatistics() const;
 			void display(const Matrix4<float> &);
+			const DrawListStatistics &getDrawListStatistics() const;
 
 			#ifdef _DEBUG
 				void drawBBox(const Matrix4<float> &, const Matrix4<float> &) const;
@@ -50,6 +55,8 @@ namespace urchin
 
 		private:
 			void createShader(const std::string &, const std::string &, const std::string &);
+			void buildDrawList();
+			void sendMeshInstances();
 
 			bool isInitialized;
 
@@ -60,12 +67,26 @@ namespace urchin
 			MeshParameter meshParameter;
 			unsigned int modelShader;
 			Matrix4<float> projectionMatrix;
-			int mProjectionLoc, mModelLoc, mViewLoc, mNormalLoc, ambientFactorLoc;
+			int mProjectionLoc, mViewLoc, ambientFactorLoc;
 
 			CustomUniform *customUniform;
 			CustomModelUniform *customModelUniform;
 
 			std::vector<Model *> models;
+			unsigned int lodBias;
+			AnimationScheduler animationScheduler;
+
+			struct MeshItem
+			{
+				Model *model;
+				const Mesh *mesh;
+				unsigned int lod;
+			};
+			std::vector<MeshItem> meshItems;
+			DrawListBuilder drawListBuilder;
+			std::vector<MeshInstance> meshInstances;
+			unsigned int instanceBufferID;
+			std::unique_ptr<JobPool> skinningJobPool;
 	};
 
 }
@@ -0,0 +1,169 @@
+#include <stdexcept>
+#include <limits>
+
+#include "OcclusionCuller.h"
+
+#define NO_NODE_INDEX std::numeric_limits<unsigned int>::max()
+
+namespace urchin
+{
+
+	OcclusionCuller::OcclusionCuller() :
+			occlusionBuffer(ConfigService::instance()->getUnsignedIntValue("occlusion.bufferWidth"),
+					ConfigService::instance()->getUnsignedIntValue("occlusion.bufferHeight")),
+			cullingTaskPool(1),
+			statistics()
+	{
+
+	}
+
+	OcclusionCuller::~OcclusionCuller()
+	{
+		if(cullingResult.valid())
+		{
+			cullingResult.wait();
+		}
+	}
+
+	/**
+	* Starts the culling on the worker thread. The models, the occluders and the camera are copied: they can be updated
+	* before the call to waitVisibleModels().
+	* @param models Models in camera frustum
+	*/
+	void OcclusionCuller::startCulling(const Camera *camera, const std::vector<Model *> &models)
+	{
+		if(cullingResult.valid())
+		{
+			throw std::runtime_error("Occlusion culling already started: visible models must be waited before to start a new culling.");
+		}
+
+		viewProjectionMatrix = camera->getProjectionMatrix() * camera->getViewMatrix();
+
+		occluders.clear();
+		this->models = models;
+		modelsAABBox.clear();
+		modelsNodeIndex.clear();
+		nodesAABBox.clear();
+		nodesIndex.clear();
+
+		for(const auto model : models)
+		{
+			if(model->isOccluder() && !model->isAnimate() && model->getMeshes())
+			{ //animated models are not used as occluder: triangles in bind pose could hide visible models
+				occluders.push_back({model->getMeshes(), model->getTransform().getTransformMatrix()});
+			}
+
+			const AABBox<float> &modelAABBox = model->getAABBox();
+			modelsAABBox.push_back(modelAABBox);
+
+			//a model is not always inside the loose box of its node (e.g.: model outside the octree): node test is skipped in this case
+			unsigned int nodeIndex = NO_NODE_INDEX;
+			const Octree<Model> *node = model->getOctree();
+			if(node && node->getLooseAABBox().include(modelAABBox))
+			{
+				auto itNode = nodesIndex.find(node);
+				if(itNode==nodesIndex.end())
+				{
+					nodeIndex = nodesAABBox.size();
+					nodesIndex[node] = nodeIndex;
+					nodesAABBox.push_back(node->getLooseAABBox());
+				}else
+				{
+					nodeIndex = itNode->second;
+				}
+			}
+			modelsNodeIndex.push_back(nodeIndex);
+		}
+
+		cullingResult = cullingTaskPool.submit([this](){cull();});
+	}
+
+	/**
+	* @return Models in camera frustum which are not hidden by the occluders
+	*/
+	const std::vector<Model *> &OcclusionCuller::waitVisibleModels()
+	{
+		waitCulling();
+
+		return visibleModels;
+	}
+
+	void OcclusionCuller::waitCulling()
+	{
+		if(!cullingResult.valid())
+		{
+			throw std::runtime_error("Occlusion culling must be started before to wait the visible models.");
+		}
+
+		cullingResult.get(); //rethrow exception of the worker thread
+	}
+
+	/**
+	 * @return Statistics of the last culling. Statistics are updated by the worker thread: they must be read once the visible models waited.
+	 */
+	const OcclusionStatistics &OcclusionCuller::getStatistics() const
+	{
+		return statistics;
+	}
+
+	void OcclusionCuller::cull()
+	{
+		visibleModels.clear();
+		statistics = OcclusionStatistics();
+		statistics.nbTestedModels = models.size();
+
+		rasterizeOccluders();
+		if(!occlusionBuffer.hasOccluder())
+		{
+			visibleModels = models;
+			return;
+		}
+		occlusionBuffer.buildHierarchicalDepth();
+
+		visibleNodes.resize(nodesAABBox.size());
+		for(unsigned int nodeIndex=0; nodeIndex<nodesAABBox.size(); ++nodeIndex)
+		{
+			visibleNodes[nodeIndex] = occlusionBuffer.isVisible(nodesAABBox[nodeIndex]);
+			statistics.nbOccludedNodes += visibleNodes[nodeIndex] ? 0 : 1;
+		}
+		statistics.nbTestedNodes = nodesAABBox.size();
+
+		for(unsigned int i=0; i<models.size(); ++i)
+		{
+			unsigned int nodeIndex = modelsNodeIndex[i];
+			if(nodeIndex!=NO_NODE_INDEX && !visibleNodes[nodeIndex])
+			{ //all models of the node are hidden
+				statistics.nbOccludedModels++;
+				continue;
+			}
+
+			if(occlusionBuffer.isVisible(modelsAABBox[i]))
+			{
+				visibleModels.push_back(models[i]);
+			}else
+			{
+				statistics.nbOccludedModels++;
+			}
+		}
+	}
+
+	void OcclusionCuller::rasterizeOccluders()
+	{
+		occlusionBuffer.clear(viewProjectionMatrix);
+
+		for(const auto &occluder : occluders)
+		{
+			for(auto constMesh : occluder.constMeshes->getConstMeshes())
+			{
+				//triangles are contiguous vertex indices (same layout than the index buffer sent to OpenGL)
+				const auto *indices = reinterpret_cast<const unsigned int *>(constMesh->getTriangles());
+				unsigned int indicesCount = constMesh->getNumberTriangles() * 3;
+
+				occlusionBuffer.rasterizeTriangles(occluder.modelMatrix, constMesh->getBaseVertices(), constMesh->getNumberVertices(), indices, indicesCount);
+				statistics.nbOccluderTriangles += constMesh->getNumberTriangles();
+			}
+			statistics.nbOccluders++;
+		}
+	}
+
+}
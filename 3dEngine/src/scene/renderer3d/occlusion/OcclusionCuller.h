@@ -0,0 +1,77 @@
+#ifndef URCHINENGINE_OCCLUSIONCULLER_H
+#define URCHINENGINE_OCCLUSIONCULLER_H
+
+#include <vector>
+#include <future>
+#include <unordered_map>
+#include "UrchinCommon.h"
+
+#include "scene/renderer3d/model/Model.h"
+#include "scene/renderer3d/camera/Camera.h"
+#include "scene/renderer3d/octree/Octree.h"
+
+namespace urchin
+{
+
+	/**
+	* Statistics of the last culling
+	*/
+	struct OcclusionStatistics
+	{
+		unsigned int nbOccluders; //occluder models rasterized in the occlusion buffer
+		unsigned int nbOccluderTriangles;
+		unsigned int nbTestedNodes; //octree nodes containing the tested models
+		unsigned int nbOccludedNodes;
+		unsigned int nbTestedModels; //models in camera frustum
+		unsigned int nbOccludedModels;
+	};
+
+	/**
+	* Remove the models hidden by the occluder models. Occluders in the camera frustum are rasterized on a worker thread
+	* in a low resolution depth buffer. Octree nodes of the models and then the models themselves are tested against the
+	* hierarchical depths of this buffer.
+	* Data read by the worker thread are copied when the culling starts: the scene can be animated until the result is waited.
+	*/
+	class OcclusionCuller
+	{
+		public:
+			OcclusionCuller();
+			~OcclusionCuller();
+
+			void startCulling(const Camera *, const std::vector<Model *> &);
+			const std::vector<Model *> &waitVisibleModels();
+
+			const OcclusionStatistics &getStatistics() const;
+
+		private:
+			struct Occluder
+			{
+				const ConstMeshes *constMeshes;
+				Matrix4<float> modelMatrix;
+			};
+
+			void cull();
+			void rasterizeOccluders();
+			void waitCulling();
+
+			OcclusionBuffer occlusionBuffer;
+			TaskPool cullingTaskPool;
+			std::future<void> cullingResult;
+
+			//data copied for the worker thread
+			Matrix4<float> viewProjectionMatrix;
+			std::vector<Occluder> occluders;
+			std::vector<Model *> models;
+			std::vector<AABBox<float>> modelsAABBox;
+			std::vector<unsigned int> modelsNodeIndex;
+			std::vector<AABBox<float>> nodesAABBox;
+			std::unordered_map<const Octree<Model> *, unsigned int> nodesIndex;
+
+			std::vector<bool> visibleNodes;
+			std::vector<Model *> visibleModels;
+			OcclusionStatistics statistics;
+	};
+
+}
+
+#endif
@@ -12,32 +12,49 @@
 
 namespace urchin
 {
-	
+
 	/**
-	* Represents a node of the octree
+	* Represents a node of a loose octree. The loose bounding box of a node is twice bigger than its bounding box: an octreeable is stored
+	* in one node only (the deepest node where its bounding box fits in the loose bounding box). Children are created on demand.
 	*/
 	template<class TOctreeable> class Octree
 	{
 		public:
-			Octree(const Point3<float> &, const Vector3<float> &, float);
+			Octree(const Point3<float> &, const Vector3<float> &, float, Octree<TOctreeable> *);
 			~Octree();
-		
+
 			const AABBox<float> &getAABBox() const;
+			const AABBox<float> &getLooseAABBox() const;
+			Octree<TOctreeable> *getParent() const;
 
 			bool isLeaf() const;
+			bool isEmpty() const;
 
 			const std::vector<Octree<TOctreeable> *> &getChildren() const;
+			Octree<TOctreeable> *findChild(const AABBox<float> &);
+			bool removeEmptyChildren();
 
-            const std::vector<TOctreeable *> &getOctreeables() const;
-			void addOctreeable(TOctreeable *, bool addRef);
-			void removeOctreeable(TOctreeable *, bool removeRef);
+			bool fit(const AABBox<float> &) const;
+			bool fitInChild(const AABBox<float> &) const;
+
+			const std::vector<TOctreeable *> &getOctreeables() const;
+			void addOctreeable(TOctreeable *);
+			void removeOctreeable(TOctreeable *);
 
 		private:
-			std::vector<Octree *> children;
+			int computeChildIndex(const AABBox<float> &) const;
+			void createChildren();
+
+			Octree<TOctreeable> *parent;
+			float minSize;
+			std::vector<Octree<TOctreeable> *> children;
 			std::vector<TOctreeable *> octreeables;
 
 			AABBox<float> bbox;
-			bool bIsLeaf;
+			AABBox<float> looseBbox;
+			Vector3<float> sizeChild;
+			bool splitAxis[3];
+			bool bCanSubdivide;
 	};
 
 	#include "Octree.inl"
@@ -1,63 +1,34 @@
-template<class TOctreeable> Octree<TOctreeable>::Octree(const Point3<float> &position, const Vector3<float> &size, float minSize) :
-	bbox(AABBox<float>(position, size))
-{
-    Vector3<float> sizeChild = size;
-    std::vector<float> splitX = {position.X};
-    std::vector<float> splitY = {position.Y};
-    std::vector<float> splitZ = {position.Z};
-    if(size.X/2.0f > minSize)
-    {
-        sizeChild.X /= 2.0f;
-        splitX.push_back(position.X + sizeChild.X);
-    }
-    if(size.Y/2.0f > minSize)
-    {
-        sizeChild.Y /= 2.0f;
-        splitY.push_back(position.Y + sizeChild.Y);
-    }
-    if(size.Z/2.0f > minSize)
-    {
-        sizeChild.Z /= 2.0f;
-        splitZ.push_back(position.Z + sizeChild.Z);
-    }
-
-    if(splitX.size()==1 && splitY.size()==1 && splitZ.size()==1)
-    {
-        bIsLeaf = true;
-    }else
-    {
-        bIsLeaf = false;
-
-        for (float xValue : splitX)
-        {
-            for (float yValue : splitY)
-            {
-                for (float zValue : splitZ)
-                {
-                    Point3<float> positionChild(xValue, yValue, zValue);
-                    children.push_back(new Octree(positionChild, sizeChild, minSize));
-                }
-            }
-        }
-    }
+template<class TOctreeable> Octree<TOctreeable>::Octree(const Point3<float> &position, const Vector3<float> &size, float minSize, Octree<TOctreeable> *parent) :
+	parent(parent),
+	minSize(minSize),
+	bbox(AABBox<float>(position, size)),
+	looseBbox(bbox.enlarge(bbox.getHalfSizes(), bbox.getHalfSizes())),
+	sizeChild(size)
+{
+	for(unsigned int axis=0; axis<3; ++axis)
+	{
+		splitAxis[axis] = size[axis]/2.0f > minSize;
+		if(splitAxis[axis])
+		{
+			sizeChild[axis] /= 2.0f;
+		}
+	}
+
+	bCanSubdivide = splitAxis[0] || splitAxis[1] || splitAxis[2];
 }
 
 template<class TOctreeable> Octree<TOctreeable>::~Octree()
 {
-	if(bIsLeaf)
+	//remove references to this octree
+	for(auto &octreeable : octreeables)
 	{
-		//remove references to this octree
-		for(auto &octreeable : octreeables)
-		{
-            octreeable->removeRefOctree(this);
-		}
-	}else
+		octreeable->setOctree(nullptr, 0);
+	}
+
+	//delete children
+	for(auto &child : children)
 	{
-		//delete children
-		for(auto &child : children)
-		{
-			delete child;
-		}
+		delete child;
 	}
 }
 
@@ -66,9 +37,27 @@ template<class TOctreeable> const AABBox<float> &Octree<TOctreeable>::getAABBox(
 	return bbox;
 }
 
+/**
+ * @return Bounding box which includes all the octreeables of this node and of its children
+ */
+template<class TOctreeable> const AABBox<float> &Octree<TOctreeable>::getLooseAABBox() const
+{
+	return looseBbox;
+}
+
+template<class TOctreeable> Octree<TOctreeable> *Octree<TOctreeable>::getParent() const
+{
+	return parent;
+}
+
 template<class TOctreeable> bool Octree<TOctreeable>::isLeaf() const
 {
-    return bIsLeaf;
+	return children.empty();
+}
+
+template<class TOctreeable> bool Octree<TOctreeable>::isEmpty() const
+{
+	return children.empty() && octreeables.empty();
 }
 
 template<class TOctreeable> const std::vector<Octree<TOctreeable> *> &Octree<TOctreeable>::getChildren() const
@@ -76,37 +65,148 @@ template<class TOctreeable> const std::vector<Octree<TOctreeable> *> &Octree<TOc
 	return children;
 }
 
+/**
+ * @return Child where the bounding box fits (children are created when necessary) or null if the bounding box doesn't fit in any child
+ */
+template<class TOctreeable> Octree<TOctreeable> *Octree<TOctreeable>::findChild(const AABBox<float> &aabbox)
+{
+	int childIndex = computeChildIndex(aabbox);
+	if(childIndex==-1)
+	{
+		return nullptr;
+	}
+
+	if(children.empty())
+	{
+		createChildren();
+	}
+	return children[childIndex];
+}
+
+/**
+ * Delete the children when they are all empty
+ * @return True if children have been deleted
+ */
+template<class TOctreeable> bool Octree<TOctreeable>::removeEmptyChildren()
+{
+	if(children.empty() || !std::all_of(children.begin(), children.end(), [](const Octree<TOctreeable> *child){return child->isEmpty();}))
+	{
+		return false;
+	}
+
+	for(auto &child : children)
+	{
+		delete child;
+	}
+	children.clear();
+
+	return true;
+}
+
+/**
+ * @return True if the bounding box is inside the loose bounding box of this node
+ */
+template<class TOctreeable> bool Octree<TOctreeable>::fit(const AABBox<float> &aabbox) const
+{
+	return aabbox.getMin().X >= looseBbox.getMin().X && aabbox.getMax().X <= looseBbox.getMax().X
+		&& aabbox.getMin().Y >= looseBbox.getMin().Y && aabbox.getMax().Y <= looseBbox.getMax().Y
+		&& aabbox.getMin().Z >= looseBbox.getMin().Z && aabbox.getMax().Z <= looseBbox.getMax().Z;
+}
+
+template<class TOctreeable> bool Octree<TOctreeable>::fitInChild(const AABBox<float> &aabbox) const
+{
+	return computeChildIndex(aabbox)!=-1;
+}
+
 template<class TOctreeable> const std::vector<TOctreeable *> &Octree<TOctreeable>::getOctreeables() const
 {
 	return octreeables;
 }
 
-template<class TOctreeable> void Octree<TOctreeable>::addOctreeable(TOctreeable *octreeable, bool addRef)
+template<class TOctreeable> void Octree<TOctreeable>::addOctreeable(TOctreeable *octreeable)
+{
+	octreeables.push_back(octreeable);
+	octreeable->setOctree(this, octreeables.size() - 1);
+}
+
+template<class TOctreeable> void Octree<TOctreeable>::removeOctreeable(TOctreeable *octreeable)
 {
-    #ifdef _DEBUG
-        assert(bIsLeaf);
-    #endif
+	#ifdef _DEBUG
+		assert(octreeable->getOctree()==this);
+	#endif
+
+	//replace the removed octreeable by the last one: no shift of the octreeables
+	unsigned int octreeableIndex = octreeable->getOctreeIndex();
+	octreeables[octreeableIndex] = octreeables.back();
+	octreeables[octreeableIndex]->setOctree(this, octreeableIndex);
+	octreeables.pop_back();
+
+	octreeable->setOctree(nullptr, 0);
+}
+
+/**
+ * The child is selected thanks to the center of the bounding box. Children are ordered by X, Y and then Z.
+ * @return Index of the child where the bounding box fits in the loose bounding box or -1 if there is no such child
+ */
+template<class TOctreeable> int Octree<TOctreeable>::computeChildIndex(const AABBox<float> &aabbox) const
+{
+	if(!bCanSubdivide)
+	{
+		return -1;
+	}
+
+	int childIndex = 0;
+	for(unsigned int axis=0; axis<3; ++axis)
+	{
+		float childMin = bbox.getMin()[axis];
+		int axisIndex = 0;
+		if(splitAxis[axis])
+		{
+			float aabboxCenter = (aabbox.getMin()[axis] + aabbox.getMax()[axis]) / 2.0f;
+			axisIndex = aabboxCenter >= childMin + sizeChild[axis] ? 1 : 0;
+			childMin += sizeChild[axis] * axisIndex;
+		}
 
-    octreeables.push_back(octreeable);
-    if(addRef)
-    {
-        octreeable->addRefOctree(this);
-    }
+		float childLooseMin = childMin - sizeChild[axis] / 2.0f;
+		float childLooseMax = childMin + sizeChild[axis] * 1.5f;
+		if(aabbox.getMin()[axis] < childLooseMin || aabbox.getMax()[axis] > childLooseMax)
+		{
+			return -1;
+		}
+
+		childIndex = childIndex * (splitAxis[axis] ? 2 : 1) + axisIndex;
+	}
+
+	return childIndex;
 }
 
-template<class TOctreeable> void Octree<TOctreeable>::removeOctreeable(TOctreeable *octreeable, bool removeRef)
+template<class TOctreeable> void Octree<TOctreeable>::createChildren()
 {
-    #ifdef _DEBUG
-        assert(bIsLeaf);
-    #endif
+	std::vector<float> splitX = {bbox.getMin().X};
+	std::vector<float> splitY = {bbox.getMin().Y};
+	std::vector<float> splitZ = {bbox.getMin().Z};
+	if(splitAxis[0])
+	{
+		splitX.push_back(bbox.getMin().X + sizeChild.X);
+	}
+	if(splitAxis[1])
+	{
+		splitY.push_back(bbox.getMin().Y + sizeChild.Y);
+	}
+	if(splitAxis[2])
+	{
+		splitZ.push_back(bbox.getMin().Z + sizeChild.Z);
+	}
 
-    auto it = std::find(octreeables.begin(), octreeables.end(), octreeable);
-    if(it!=octreeables.end())
-    {
-        VectorEraser::erase(octreeables, it);
-        if(removeRef)
-        {
-            octreeable->removeRefOctree(this);
-        }
-    }
+	for(float xValue : splitX)
+	{
+		for(float yValue : splitY)
+		{
+			for(float zValue : splitZ)
+			{
+				Point3<float> positionChild(xValue, yValue, zValue);
+				children.push_back(new Octree(positionChild, sizeChild, minSize, this));
+			}
+		}
+	}
 }
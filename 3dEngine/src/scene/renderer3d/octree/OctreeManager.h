@@ -15,6 +15,10 @@
 namespace urchin
 {
 	
+	/**
+	* Manager of a loose octree. Octreeables outside the octree bounds are stored in an overflow node: the octree is rebuilt
+	* only when the overflow node contains more octreeables than the octree.
+	*/
 	template<class TOctreeable> class OctreeManager : public Observable, public Observer
 	{
 		public:
@@ -24,6 +28,7 @@ namespace urchin
 			enum NotificationType
 			{
 				OCTREE_BUILT,
+				OCTREEABLE_REMOVED
 			};
 
 			void notify(Observable *, int) override;
@@ -34,27 +39,52 @@ namespace urchin
 			void updateMinSize(float);
 			void refreshOctreeables();
 			void postRefreshOctreeables();
+			const std::vector<TOctreeable *> &getMovingOctreeables() const;
 
 			const Octree<TOctreeable> &getMainOctree() const;
 
 			std::vector<TOctreeable *> getAllOctreeables() const;
 			void getOctreeablesIn(const ConvexObject3D<float> &, std::vector<TOctreeable *> &) const;
 			void getOctreeablesIn(const ConvexObject3D<float> &, std::vector<TOctreeable *> &, const OctreeableFilter<TOctreeable> &) const;
+			void getOctreeablesIn(const std::vector<const ConvexObject3D<float> *> &, std::vector<TOctreeable *> &, std::vector<unsigned int> &) const;
+			void getOctreeablesIn(const std::vector<const ConvexObject3D<float> *> &, std::vector<TOctreeable *> &, std::vector<unsigned int> &,
+					const OctreeableFilter<TOctreeable> &) const;
 		
 			#ifdef _DEBUG
 				void drawOctree(const Matrix4<float> &, const Matrix4<float> &) const;
 			#endif
 		
 		private:
-			void buildOctree(std::vector<TOctreeable *> &);
-			bool resizeOctree(TOctreeable *);
+			void buildOctree(const std::vector<TOctreeable *> &);
+			bool needRebuildOctree() const;
+			Octree<TOctreeable> *findTargetOctree(TOctreeable *);
+			void insertOctreeable(TOctreeable *);
+			void detachOctreeable(TOctreeable *);
+			void removeEmptyOctrees(Octree<TOctreeable> *);
+			void collideWithConvexObjects(const std::vector<const ConvexObject3D<float> *> &, const std::vector<unsigned int> &) const;
 		
 			float overflowSize;
-			int minSize;
+			float minSize;
 			Octree<TOctreeable> *mainOctree;
+			Octree<TOctreeable> *overflowOctree;
+			unsigned int mainOctreeablesCount;
 
 			std::vector<TOctreeable *> movingOctreeables;
 			mutable std::vector<Octree<TOctreeable> *> browseNodes;
+			mutable std::vector<Octree<TOctreeable> *> nextBrowseNodes;
+			mutable AABBoxArray<float> browseNodesAABBoxes;
+			mutable std::vector<unsigned int> collideNodeIndices;
+			mutable std::vector<TOctreeable *> browseOctreeables;
+			mutable AABBoxArray<float> browseOctreeablesAABBoxes;
+			mutable std::vector<unsigned int> collideOctreeableIndices;
+			mutable std::vector<unsigned int> browseNodesMasks;
+			mutable std::vector<unsigned int> nextBrowseNodesMasks;
+			mutable std::vector<unsigned int> browseOctreeablesMasks;
+			mutable std::vector<const AABBox<float> *> browseAABBoxes;
+			mutable AABBoxArray<float> testAABBoxes;
+			mutable std::vector<unsigned int> testIndices;
+			mutable std::vector<unsigned int> collideTestIndices;
+			mutable std::vector<unsigned int> collideMasks;
 
 			#ifdef _DEBUG
 				unsigned int refreshModCount, postRefreshModCount;
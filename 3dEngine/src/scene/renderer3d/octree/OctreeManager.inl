@@ -1,7 +1,9 @@
 template<class TOctreeable> OctreeManager<TOctreeable>::OctreeManager(float minSize) :
 		overflowSize(ConfigService::instance()->getFloatValue("octree.overflowSize")),
-        minSize(minSize),
-		mainOctree(nullptr)
+		minSize(minSize),
+		mainOctree(nullptr),
+		overflowOctree(nullptr),
+		mainOctreeablesCount(0)
 {
 	if(overflowSize < -std::numeric_limits<float>::epsilon())
 	{
@@ -10,8 +12,7 @@ template<class TOctreeable> OctreeManager<TOctreeable>::OctreeManager(float minS
 	
 	overflowSize += 0.001f; //add offset to avoid rounding problem when overflow size is 0.0f.
 	
-	std::vector<TOctreeable *> emptyOctreeable;
-	buildOctree(emptyOctreeable);
+	buildOctree(std::vector<TOctreeable *>());
 	
 	#ifdef _DEBUG
 		refreshModCount = postRefreshModCount = 0;
@@ -28,6 +29,7 @@ template<class TOctreeable> OctreeManager<TOctreeable>::~OctreeManager()
 		}
 		
 		delete mainOctree;
+		delete overflowOctree;
 	}
 }
 
@@ -46,8 +48,13 @@ template<class TOctreeable> void OctreeManager<TOctreeable>::notify(Observable *
 	}
 }
 
-template<class TOctreeable> void OctreeManager<TOctreeable>::buildOctree(std::vector<TOctreeable *> &octreeables)
+template<class TOctreeable> void OctreeManager<TOctreeable>::buildOctree(const std::vector<TOctreeable *> &octreeables)
 {
+	delete mainOctree;
+	delete overflowOctree;
+	overflowOctree = new Octree<TOctreeable>(Point3<float>(0.0, 0.0, 0.0), Vector3<float>(0.0, 0.0, 0.0), minSize, nullptr);
+	mainOctreeablesCount = 0;
+
 	if(!octreeables.empty())
 	{
 		Point3<float> minScene(std::numeric_limits<float>::max(), std::numeric_limits<float>::max(), std::numeric_limits<float>::max());
@@ -94,76 +101,121 @@ template<class TOctreeable> void OctreeManager<TOctreeable>::buildOctree(std::ve
 		position.Y -= overflowSize;
 		position.Z -= overflowSize;
 
-		delete mainOctree;
-		mainOctree = new Octree<TOctreeable>(position, size, minSize);
+		mainOctree = new Octree<TOctreeable>(position, size, minSize, nullptr);
 
 		for(auto &octreeable : octreeables)
 		{
-			addOctreeable(octreeable);
+			insertOctreeable(octreeable);
 		}
 	}else
 	{
-		delete mainOctree;
-		mainOctree = new Octree<TOctreeable>(Point3<float>(0.0, 0.0, 0.0), Vector3<float>(1.0, 1.0, 1.0), minSize);
+		mainOctree = new Octree<TOctreeable>(Point3<float>(0.0, 0.0, 0.0), Vector3<float>(1.0, 1.0, 1.0), minSize, nullptr);
 	}
 
 	notifyObservers(this, OCTREE_BUILT);
 }
 
-template<class TOctreeable> void OctreeManager<TOctreeable>::addOctreeable(TOctreeable *octreeable)
-{		
-	bool resized = resizeOctree(octreeable);
-	if(!resized)
+/**
+ * The octree is rebuilt only when most of the octreeables are outside its bounds: objects falling in nothingness don't imply a rebuild
+ */
+template<class TOctreeable> bool OctreeManager<TOctreeable>::needRebuildOctree() const
+{
+	return overflowOctree->getOctreeables().size() > mainOctreeablesCount;
+}
+
+/**
+ * @return Deepest octree node where the octreeable fits. Search starts from the current node of the octreeable.
+ */
+template<class TOctreeable> Octree<TOctreeable> *OctreeManager<TOctreeable>::findTargetOctree(TOctreeable *octreeable)
+{
+	const AABBox<float> &aabbox = octreeable->getAABBox();
+
+	//go up until the octreeable fits
+	Octree<TOctreeable> *octree = octreeable->getOctree();
+	if(octree==nullptr || octree==overflowOctree)
 	{
-        browseNodes.clear();
-        browseNodes.push_back(mainOctree);
-        for (unsigned int i = 0; i < browseNodes.size(); ++i)
-        {
-            Octree<TOctreeable> *octree = browseNodes[i];
-
-            if (octreeable->getAABBox().collideWithAABBox(octree->getAABBox()))
-            {
-                if (octree->isLeaf())
-                {
-                    octree->addOctreeable(octreeable, true);
-                } else
-                {
-                    browseNodes.insert(browseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
-                }
-            }
-        }
+		octree = mainOctree;
 	}
-	
-	octreeable->addObserver(this, TOctreeable::MOVE);
+	while(octree!=nullptr && !octree->fit(aabbox))
+	{
+		octree = octree->getParent();
+	}
+	if(octree==nullptr)
+	{
+		return overflowOctree;
+	}
+
+	//go down until the octreeable doesn't fit in a child
+	for(Octree<TOctreeable> *child = octree->findChild(aabbox); child!=nullptr; child = octree->findChild(aabbox))
+	{
+		octree = child;
+	}
+	return octree;
 }
 
-template<class TOctreeable> void OctreeManager<TOctreeable>::removeOctreeable(TOctreeable *octreeable)
+template<class TOctreeable> void OctreeManager<TOctreeable>::insertOctreeable(TOctreeable *octreeable)
 {
-	//keep size in variable because we remove references during looping
-	int refOctreeSize = octreeable->getRefOctree().size();
-	
-	//delete from end to start: more faster for a vector
-	for(int i=refOctreeSize-1; i>=0; --i)
+	Octree<TOctreeable> *targetOctree = findTargetOctree(octreeable);
+	targetOctree->addOctreeable(octreeable);
+
+	if(targetOctree!=overflowOctree)
 	{
-		octreeable->getRefOctree()[i]->removeOctreeable(octreeable, true);
+		mainOctreeablesCount++;
 	}
-	
-	octreeable->removeObserver(this, TOctreeable::MOVE);
 }
 
-template<class TOctreeable> void OctreeManager<TOctreeable>::updateMinSize(float minSize)
+template<class TOctreeable> void OctreeManager<TOctreeable>::detachOctreeable(TOctreeable *octreeable)
 {
-	this->minSize = minSize;
+	Octree<TOctreeable> *octree = octreeable->getOctree();
+	if(octree!=nullptr)
+	{
+		octree->removeOctreeable(octreeable);
 
-	//gets all octreeables from the current octree
-	std::vector<TOctreeable *> allOctreeables;
-	if(mainOctree)
+		if(octree!=overflowOctree)
+		{
+			mainOctreeablesCount--;
+			removeEmptyOctrees(octree);
+		}
+	}
+}
+
+/**
+ * Remove the empty nodes from the specified node up to the root node
+ */
+template<class TOctreeable> void OctreeManager<TOctreeable>::removeEmptyOctrees(Octree<TOctreeable> *octree)
+{
+	Octree<TOctreeable> *parent = octree->getParent();
+	while(parent!=nullptr && parent->removeEmptyChildren())
 	{
-		mainOctree->getAllOctreeables(allOctreeables);
+		parent = parent->getParent();
 	}
+}
+
+template<class TOctreeable> void OctreeManager<TOctreeable>::addOctreeable(TOctreeable *octreeable)
+{
+	insertOctreeable(octreeable);
+
+	octreeable->addObserver(this, TOctreeable::MOVE);
+	octreeable->notifyOctreeableMove(); //added octreeable is handled as a moving octreeable until the post refresh
+}
+
+template<class TOctreeable> void OctreeManager<TOctreeable>::removeOctreeable(TOctreeable *octreeable)
+{
+	detachOctreeable(octreeable);
+
+	octreeable->removeObserver(this, TOctreeable::MOVE);
+	movingOctreeables.erase(std::remove(movingOctreeables.begin(), movingOctreeables.end(), octreeable), movingOctreeables.end());
+	octreeable->onMoveDone();
+
+	notifyObservers(this, OCTREEABLE_REMOVED);
+}
+
+template<class TOctreeable> void OctreeManager<TOctreeable>::updateMinSize(float minSize)
+{
+	this->minSize = minSize;
 
 	//rebuild the octree
-	buildOctree(allOctreeables);
+	buildOctree(getAllOctreeables());
 }
 
 template<class TOctreeable> void OctreeManager<TOctreeable>::refreshOctreeables()
@@ -172,16 +224,35 @@ template<class TOctreeable> void OctreeManager<TOctreeable>::refreshOctreeables(
 
 	if(mainOctree)
 	{
-        movingOctreeables.erase(std::unique(movingOctreeables.begin(), movingOctreeables.end() ), movingOctreeables.end());
-
-        for(auto &movingOctreeable : movingOctreeables)
+		for(auto &movingOctreeable : movingOctreeables)
 		{
-			removeOctreeable(movingOctreeable);
+			Octree<TOctreeable> *octree = movingOctreeable->getOctree();
+			if(octree==nullptr)
+			{ //octreeable removed from the octree since its move
+				continue;
+			}
+
+			Octree<TOctreeable> *targetOctree = findTargetOctree(movingOctreeable);
+			if(targetOctree!=octree)
+			{ //relink the octreeable before removing the empty nodes: the target node could be empty and removed otherwise
+				octree->removeOctreeable(movingOctreeable);
+				targetOctree->addOctreeable(movingOctreeable);
+				if(targetOctree!=overflowOctree)
+				{
+					mainOctreeablesCount++;
+				}
+
+				if(octree!=overflowOctree)
+				{
+					mainOctreeablesCount--;
+					removeEmptyOctrees(octree);
+				}
+			}
 		}
 
-        for(auto &movingOctreeable : movingOctreeables)
+		if(needRebuildOctree())
 		{
-			addOctreeable(movingOctreeable);
+			buildOctree(getAllOctreeables());
 		}
 	}
 	
@@ -209,6 +280,14 @@ template<class TOctreeable> void OctreeManager<TOctreeable>::postRefreshOctreeab
 	#endif
 }
 
+/**
+ * @return Octreeables moved or added since the last post refresh. An octreeable can be present several times.
+ */
+template<class TOctreeable> const std::vector<TOctreeable *> &OctreeManager<TOctreeable>::getMovingOctreeables() const
+{
+	return movingOctreeables;
+}
+
 template<class TOctreeable> const Octree<TOctreeable> &OctreeManager<TOctreeable>::getMainOctree() const
 {
 	return *mainOctree;
@@ -219,33 +298,19 @@ template<class TOctreeable> std::vector<TOctreeable *> OctreeManager<TOctreeable
 	std::vector<TOctreeable *> allOctreeables;
 
 	if(mainOctree)
-    {
-        browseNodes.clear();
-        browseNodes.push_back(mainOctree);
-        for (unsigned int i = 0; i < browseNodes.size(); ++i)
-        {
-            const Octree<TOctreeable> *octree = browseNodes[i];
-
-            if (octree->isLeaf())
-            {
-                for(unsigned int octreeableI=0; octreeableI<octree->getOctreeables().size(); octreeableI++)
-                {
-                    TOctreeable *octreeable = octree->getOctreeables()[octreeableI];
-
-                    if(!octreeable->isProcessed())
-                    {
-                        octreeable->setProcessed(true);
-                        allOctreeables.emplace_back(octreeable);
-                    }
-                }
-            } else
-            {
-                browseNodes.insert(browseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
-            }
-        }
-    }
-
-    std::for_each(allOctreeables.begin(), allOctreeables.end(), [](TOctreeable *o){o->setProcessed(false);});
+	{
+		allOctreeables.insert(allOctreeables.end(), overflowOctree->getOctreeables().begin(), overflowOctree->getOctreeables().end());
+
+		browseNodes.clear();
+		browseNodes.push_back(mainOctree);
+		for(unsigned int i = 0; i < browseNodes.size(); ++i)
+		{
+			const Octree<TOctreeable> *octree = browseNodes[i];
+
+			allOctreeables.insert(allOctreeables.end(), octree->getOctreeables().begin(), octree->getOctreeables().end());
+			browseNodes.insert(browseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
+		}
+	}
 
 	return allOctreeables;
 }
@@ -259,84 +324,227 @@ template<class TOctreeable> void OctreeManager<TOctreeable>::getOctreeablesIn(co
 template<class TOctreeable> void OctreeManager<TOctreeable>::getOctreeablesIn(const ConvexObject3D<float> &convexObject,
         std::vector<TOctreeable *> &visibleOctreeables, const OctreeableFilter<TOctreeable> &filter) const
 {
-    ScopeProfiler profiler("3d", "getOctreeables");
+	ScopeProfiler profiler("3d", "getOctreeables");
 
+	//octreeables outside the octree bounds are always tested
+	browseOctreeables.clear();
+	browseOctreeablesAABBoxes.clear();
+	for(const auto &octreeable : overflowOctree->getOctreeables())
+	{
+		if(octreeable->isVisible())
+		{
+			browseOctreeables.push_back(octreeable);
+			browseOctreeablesAABBoxes.addAABBox(octreeable->getAABBox());
+		}
+	}
+
+	//browse the octree level by level: the loose bounding boxes of a level are tested together against the convex object
 	browseNodes.clear();
 	browseNodes.push_back(mainOctree);
-	for(unsigned int i=0; i<browseNodes.size(); ++i)
+	while(!browseNodes.empty())
 	{
-		const Octree<TOctreeable> *octree = browseNodes[i];
+		browseNodesAABBoxes.clear();
+		for(const auto &octree : browseNodes)
+		{
+			browseNodesAABBoxes.addAABBox(octree->getLooseAABBox());
+		}
 
-		if(convexObject.collideWithAABBox(octree->getAABBox()))
+		collideNodeIndices.clear();
+		convexObject.collideWithAABBoxes(browseNodesAABBoxes, collideNodeIndices);
+
+		nextBrowseNodes.clear();
+		for(unsigned int collideNodeIndex : collideNodeIndices)
 		{
-			if(octree->isLeaf())
+			const Octree<TOctreeable> *octree = browseNodes[collideNodeIndex];
+
+			for(const auto &octreeable : octree->getOctreeables())
 			{
-				for(unsigned int octreeableI=0; octreeableI<octree->getOctreeables().size(); octreeableI++)
+				if(octreeable->isVisible())
 				{
-					TOctreeable *octreeable = octree->getOctreeables()[octreeableI];
-
-					if(octreeable->isVisible() && !octreeable->isProcessed() && filter.isAccepted(octreeable, convexObject))
-					{
-						octreeable->setProcessed(true);
-						visibleOctreeables.push_back(octreeable);
-					}
+					browseOctreeables.push_back(octreeable);
+					browseOctreeablesAABBoxes.addAABBox(octreeable->getAABBox());
 				}
-			}else
-			{
-                browseNodes.insert(browseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
 			}
+
+			nextBrowseNodes.insert(nextBrowseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
 		}
+
+		browseNodes.swap(nextBrowseNodes);
 	}
 
-	std::for_each(visibleOctreeables.begin(), visibleOctreeables.end(), [](TOctreeable *o){o->setProcessed(false);});
+	//an octreeable belongs to one node only: there is no duplicate
+	collideOctreeableIndices.clear();
+	convexObject.collideWithAABBoxes(browseOctreeablesAABBoxes, collideOctreeableIndices);
+	for(unsigned int collideOctreeableIndex : collideOctreeableIndices)
+	{
+		TOctreeable *octreeable = browseOctreeables[collideOctreeableIndex];
+		if(filter.isAccepted(octreeable, convexObject))
+		{
+			visibleOctreeables.push_back(octreeable);
+		}
+	}
 }
 
-template<class TOctreeable> bool OctreeManager<TOctreeable>::resizeOctree(TOctreeable *newOctreeable)
+template<class TOctreeable> void OctreeManager<TOctreeable>::getOctreeablesIn(const std::vector<const ConvexObject3D<float> *> &convexObjects,
+		std::vector<TOctreeable *> &octreeables, std::vector<unsigned int> &visibilityMasks) const
 {
-	if(mainOctree)
+	getOctreeablesIn(convexObjects, octreeables, visibilityMasks, AcceptAllFilter<TOctreeable>());
+}
+
+/**
+ * Returns octreeables colliding with at least one convex object. The octree is browsed once for all the convex objects.
+ * @param convexObjects Convex objects (32 maximum)
+ * @param visibilityMasks [out] Visibility mask of each returned octreeable: bit i is set when the octreeable collides with the convex object i
+ * @param filter Filter applied with the first convex object colliding with the octreeable
+ */
+template<class TOctreeable> void OctreeManager<TOctreeable>::getOctreeablesIn(const std::vector<const ConvexObject3D<float> *> &convexObjects,
+		std::vector<TOctreeable *> &visibleOctreeables, std::vector<unsigned int> &visibilityMasks, const OctreeableFilter<TOctreeable> &filter) const
+{
+	ScopeProfiler profiler("3d", "getOctreeables");
+
+	constexpr unsigned int MAX_CONVEX_OBJECTS = std::numeric_limits<unsigned int>::digits;
+	if(convexObjects.size() > MAX_CONVEX_OBJECTS)
+	{
+		throw std::invalid_argument("Number of convex objects must be lower or equal to " + std::to_string(MAX_CONVEX_OBJECTS) + ": " + std::to_string(convexObjects.size()));
+	}
+	unsigned int allConvexObjectsMask = (convexObjects.size()==MAX_CONVEX_OBJECTS) ? ~0u : (1u << convexObjects.size()) - 1u;
+
+	//octreeables outside the octree bounds are tested against all convex objects
+	browseOctreeables.clear();
+	browseOctreeablesMasks.clear();
+	for(const auto &octreeable : overflowOctree->getOctreeables())
 	{
-		//need to resize ?
-		const Point3<float> &minOctree = mainOctree->getAABBox().getMin();
-		const Point3<float> &maxOctree = mainOctree->getAABBox().getMax();
-
-		if(	newOctreeable->getAABBox().getMin().X >= minOctree.X && newOctreeable->getAABBox().getMin().Y >= minOctree.Y &&
-			newOctreeable->getAABBox().getMin().Z >= minOctree.Z && newOctreeable->getAABBox().getMax().X <= maxOctree.X &&
-			newOctreeable->getAABBox().getMax().Y <= maxOctree.Y && newOctreeable->getAABBox().getMax().Z <= maxOctree.Z
-		)
-		{ //there is no need to resize
-			return false;
+		if(octreeable->isVisible())
+		{
+			browseOctreeables.push_back(octreeable);
+			browseOctreeablesMasks.push_back(allConvexObjectsMask);
 		}
 	}
 
-	//gets all octreeables from the current octree
-	std::vector<TOctreeable *> allOctreeables = getAllOctreeables();
-	allOctreeables.emplace_back(newOctreeable);
+	//browse the octree level by level: a node is tested only against the convex objects colliding with its parent
+	browseNodes.clear();
+	browseNodesMasks.clear();
+	browseNodes.push_back(mainOctree);
+	browseNodesMasks.push_back(allConvexObjectsMask);
+	while(!browseNodes.empty())
+	{
+		browseAABBoxes.clear();
+		for(const auto &octree : browseNodes)
+		{
+			browseAABBoxes.push_back(&octree->getLooseAABBox());
+		}
+		collideWithConvexObjects(convexObjects, browseNodesMasks);
 
-	//rebuild the octree
-	buildOctree(allOctreeables);
+		nextBrowseNodes.clear();
+		nextBrowseNodesMasks.clear();
+		for(unsigned int i=0; i<browseNodes.size(); ++i)
+		{
+			if(collideMasks[i]==0)
+			{
+				continue;
+			}
+
+			const Octree<TOctreeable> *octree = browseNodes[i];
+			for(const auto &octreeable : octree->getOctreeables())
+			{
+				if(octreeable->isVisible())
+				{
+					browseOctreeables.push_back(octreeable);
+					browseOctreeablesMasks.push_back(collideMasks[i]);
+				}
+			}
+
+			nextBrowseNodes.insert(nextBrowseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
+			nextBrowseNodesMasks.insert(nextBrowseNodesMasks.end(), octree->getChildren().size(), collideMasks[i]);
+		}
+
+		browseNodes.swap(nextBrowseNodes);
+		browseNodesMasks.swap(nextBrowseNodesMasks);
+	}
+
+	//an octreeable is tested only against the convex objects colliding with its node
+	browseAABBoxes.clear();
+	for(const auto &octreeable : browseOctreeables)
+	{
+		browseAABBoxes.push_back(&octreeable->getAABBox());
+	}
+	collideWithConvexObjects(convexObjects, browseOctreeablesMasks);
+
+	for(unsigned int i=0; i<browseOctreeables.size(); ++i)
+	{
+		unsigned int visibilityMask = collideMasks[i];
+		if(visibilityMask!=0)
+		{
+			unsigned int firstConvexObjectIndex = 0;
+			while((visibilityMask & (1u << firstConvexObjectIndex))==0)
+			{
+				firstConvexObjectIndex++;
+			}
+
+			if(filter.isAccepted(browseOctreeables[i], *convexObjects[firstConvexObjectIndex]))
+			{
+				visibleOctreeables.push_back(browseOctreeables[i]);
+				visibilityMasks.push_back(visibilityMask);
+			}
+		}
+	}
+}
+
+/**
+ * Tests the bounding boxes to browse against the convex objects. The result is stored in collide masks.
+ * @param testMasks Convex objects to test for each bounding box
+ */
+template<class TOctreeable> void OctreeManager<TOctreeable>::collideWithConvexObjects(const std::vector<const ConvexObject3D<float> *> &convexObjects,
+		const std::vector<unsigned int> &testMasks) const
+{
+	collideMasks.assign(browseAABBoxes.size(), 0);
+
+	for(unsigned int convexObjectIndex=0; convexObjectIndex<convexObjects.size(); ++convexObjectIndex)
+	{
+		unsigned int convexObjectMask = 1u << convexObjectIndex;
 
-	return true;
+		testAABBoxes.clear();
+		testIndices.clear();
+		for(unsigned int i=0; i<browseAABBoxes.size(); ++i)
+		{
+			if(testMasks[i] & convexObjectMask)
+			{
+				testAABBoxes.addAABBox(*browseAABBoxes[i]);
+				testIndices.push_back(i);
+			}
+		}
+
+		if(!testIndices.empty())
+		{
+			collideTestIndices.clear();
+			convexObjects[convexObjectIndex]->collideWithAABBoxes(testAABBoxes, collideTestIndices);
+			for(unsigned int collideTestIndex : collideTestIndices)
+			{
+				collideMasks[testIndices[collideTestIndex]] |= convexObjectMask;
+			}
+		}
+	}
 }
 
 #ifdef _DEBUG
 	template<class TOctreeable> void OctreeManager<TOctreeable>::drawOctree(const Matrix4<float> &projectionMatrix, const Matrix4<float> &viewMatrix) const
 	{
-        std::vector<const Octree<TOctreeable> *> leafOctrees;
-
-        browseNodes.clear();
-        browseNodes.push_back(mainOctree);
-        for(unsigned int i=0; i<browseNodes.size(); ++i)
-        {
-            const Octree<TOctreeable> *octree = browseNodes[i];
-
-            if(octree->isLeaf())
-            {
-                leafOctrees.push_back(octree);
-            }else
-            {
-                browseNodes.insert(browseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
-            }
-        }
+		std::vector<const Octree<TOctreeable> *> leafOctrees;
+
+		browseNodes.clear();
+		browseNodes.push_back(mainOctree);
+		for(unsigned int i=0; i<browseNodes.size(); ++i)
+		{
+			const Octree<TOctreeable> *octree = browseNodes[i];
+
+			if(octree->isLeaf())
+			{
+				leafOctrees.push_back(octree);
+			}else
+			{
+				browseNodes.insert(browseNodes.end(), octree->getChildren().begin(), octree->getChildren().end());
+			}
+		}
 
 		std::vector<AABBox<float>> aabboxes;
 		aabboxes.reserve(leafOctrees.size());
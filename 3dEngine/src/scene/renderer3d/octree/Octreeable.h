@@ -36,9 +36,9 @@ namespace urchin
 			void setProcessed(bool);
 			bool isProcessed() const;
 		
-			const std::vector<Octree<TOctreeable> *> &getRefOctree() const;
-			void addRefOctree(Octree<TOctreeable> *);
-			void removeRefOctree(Octree<TOctreeable> *);
+			Octree<TOctreeable> *getOctree() const;
+			unsigned int getOctreeIndex() const;
+			void setOctree(Octree<TOctreeable> *, unsigned int);
 
 			virtual const AABBox<float> &getAABBox() const = 0;
 			virtual const Transform<float> &getTransform() const = 0;
@@ -48,7 +48,8 @@ namespace urchin
 			#endif
 		
 		private:
-			std::vector<Octree<TOctreeable> *> refOctree;
+			Octree<TOctreeable> *octree;
+			unsigned int octreeIndex;
 
 			bool bIsMovingInOctree;
 			bool bIsVisible;
@@ -1,4 +1,6 @@
 template<class TOctreeable> Octreeable<TOctreeable>::Octreeable() :
+	octree(nullptr),
+	octreeIndex(0),
 	bIsMovingInOctree(false),
 	bIsVisible(true),
 	bIsProcessed(false)
@@ -7,6 +9,8 @@ template<class TOctreeable> Octreeable<TOctreeable>::Octreeable() :
 }
 
 template<class TOctreeable> Octreeable<TOctreeable>::Octreeable(const Octreeable<TOctreeable> &octreeable) :
+	octree(nullptr),
+	octreeIndex(0),
 	bIsMovingInOctree(false),
 	bIsVisible(octreeable.isVisible()),
 	bIsProcessed(octreeable.isProcessed())
@@ -16,11 +20,10 @@ template<class TOctreeable> Octreeable<TOctreeable>::Octreeable(const Octreeable
 
 template<class TOctreeable> Octreeable<TOctreeable>::~Octreeable()
 {
-	//remove references to this octreeable
-	for(auto it = refOctree.begin(); it!=refOctree.end(); ++it)
+	//remove reference to this octreeable
+	if(octree)
 	{
-		TOctreeable *toctreeable = static_cast<TOctreeable *>(this);
-		(*it)->removeOctreeable(toctreeable, false);
+		octree->removeOctreeable(static_cast<TOctreeable *>(this));
 	}
 }
 
@@ -31,7 +34,7 @@ template<class TOctreeable> void Octreeable<TOctreeable>::notifyOctreeableMove()
 {
 	notifyObservers(this, Octreeable::MOVE);
 
-	if (refOctree.size() > 0)
+	if (octree)
 	{ //octreeable can move in an octree only if it's attached to an octree
 		bIsMovingInOctree = true;
 	}
@@ -46,7 +49,7 @@ template<class TOctreeable> void Octreeable<TOctreeable>::onMoveDone()
 }
 
 /**
- * Return true when octreeable moves in an octree. True is even returned if octreeable doesn't change of leaf octree.
+ * Return true when octreeable moves in an octree. True is even returned if octreeable doesn't change of octree node.
  * If octreeable is not attached to an octree: false is always returned.
  */
 template<class TOctreeable> bool Octreeable<TOctreeable>::isMovingInOctree() const
@@ -74,26 +77,26 @@ template<class TOctreeable> bool Octreeable<TOctreeable>::isProcessed() const
 	return bIsProcessed;
 }
 
-template<class TOctreeable> const std::vector<Octree<TOctreeable> *> &Octreeable<TOctreeable>::getRefOctree() const
+/**
+ * @return Octree node which contains this octreeable or null if not attached to an octree
+ */
+template<class TOctreeable> Octree<TOctreeable> *Octreeable<TOctreeable>::getOctree() const
 {
-	return refOctree;
+	return octree;
 }
 
-template<class TOctreeable> void Octreeable<TOctreeable>::addRefOctree(Octree<TOctreeable> *octree)
+/**
+ * @return Index of this octreeable in the octreeables of its octree node
+ */
+template<class TOctreeable> unsigned int Octreeable<TOctreeable>::getOctreeIndex() const
 {
-	refOctree.push_back(octree);
+	return octreeIndex;
 }
 
-template<class TOctreeable> void Octreeable<TOctreeable>::removeRefOctree(Octree<TOctreeable> *octree)
+template<class TOctreeable> void Octreeable<TOctreeable>::setOctree(Octree<TOctreeable> *octree, unsigned int octreeIndex)
 {
-	auto it = std::find(refOctree.begin(), refOctree.end(), octree);
-	if(it!=refOctree.end())
-	{
-		VectorEraser::erase(refOctree, it);
-	}else
-	{
-		throw std::invalid_argument("Impossible to find the reference octree to remove.");
-	}
+	this->octree = octree;
+	this->octreeIndex = octreeIndex;
 }
 
 #ifdef _DEBUG
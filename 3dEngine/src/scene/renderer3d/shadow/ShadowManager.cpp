@@ -27,6 +27,7 @@ namespace urchin
 			shadowMapBias(ConfigService::instance()->getFloatValue("shadow.shadowMapBias")),
 			percentageUniformSplit(ConfigService::instance()->getFloatValue("shadow.frustumUniformSplitAgainstLogSplit")),
 			lightViewOverflowStepSize(ConfigService::instance()->getFloatValue("shadow.lightViewOverflowStepSize")),
+			lodBias(ConfigService::instance()->getUnsignedIntValue("shadow.lodBias")),
 			shadowMapResolution(DEFAULT_SHADOW_MAP_RESOLUTION),
 			nbShadowMaps(DEFAULT_NUMBER_SHADOW_MAPS),
 			viewingShadowDistance(DEFAULT_VIEWING_SHADOW_DISTANCE),
@@ -65,12 +66,15 @@ namespace urchin
 
 		lightManager->addObserver(this, LightManager::ADD_LIGHT);
 		lightManager->addObserver(this, LightManager::REMOVE_LIGHT);
+		modelOctreeManager->addObserver(this, OctreeManager<Model>::OCTREEABLE_REMOVED);
 
 		createOrUpdateShadowModelDisplayer();
 	}
 
 	ShadowManager::~ShadowManager()
 	{
+		modelOctreeManager->removeObserver(this, OctreeManager<Model>::OCTREEABLE_REMOVED);
+
 		for (auto &shadowData : shadowDatas)
 		{
 			removeShadowMaps(shadowData.first);
@@ -93,9 +97,9 @@ namespace urchin
 
 		//light information
 		deleteLightsLocation();
-		lightsLocation = new LightLocation[lightManager->getMaxLights()];
+		lightsLocation = new LightLocation[lightManager->getMaxSunLights()];
 		std::ostringstream shadowMapTextureLocName, mLightProjectionViewLocName;
-		for(unsigned int i=0;i<lightManager->getMaxLights();++i)
+		for(unsigned int i=0;i<lightManager->getMaxSunLights();++i)
 		{
 			//depth shadow texture
 			shadowMapTextureLocName.str("");
@@ -123,6 +127,7 @@ namespace urchin
 		shadowModelDisplayer->setCustomGeometryShader("modelShadowMap.geo", geometryTokens);
 		shadowModelDisplayer->setCustomFragmentShader("modelShadowMap.frag", fragmentTokens);
 		shadowModelDisplayer->initialize();
+		shadowModelDisplayer->setLodBias(lodBias);
 
 		delete shadowUniform;
 		shadowUniform = new ShadowUniform();
@@ -139,7 +144,7 @@ namespace urchin
 	{
 		if(lightsLocation)
 		{
-			for(unsigned int i=0;i<lightManager->getMaxLights();++i)
+			for(unsigned int i=0;i<lightManager->getMaxSunLights();++i)
 			{
 				delete [] lightsLocation[i].mLightProjectionViewLoc;
 			}
@@ -197,6 +202,15 @@ namespace urchin
 				default:
 					;
 			}
+		}else if(dynamic_cast<OctreeManager<Model> *>(observable))
+		{
+			if(notificationType==OctreeManager<Model>::OCTREEABLE_REMOVED)
+			{ //removed model could be referenced in shadow casters of frustum splits
+				for(auto &shadowData : shadowDatas)
+				{
+					shadowData.second->invalidateFrustumShadowData();
+				}
+			}
 		}else if(auto *light = dynamic_cast<Light *>(observable))
 		{
 			switch(notificationType)
@@ -245,6 +259,9 @@ namespace urchin
 		if(nbShadowMaps <= 1)
 		{ //note: shadow maps texture array with depth=1 generate error in GLSL texture2DArray function
 			throw std::runtime_error("Number of shadow maps must be greater than one. Value: " + std::to_string(nbShadowMaps));
+		}else if(nbShadowMaps >= std::numeric_limits<unsigned int>::digits)
+		{ //note: shadow maps and camera frustum are identified by a bit in visibility masks of models
+			throw std::runtime_error("Number of shadow maps must be lower than " + std::to_string(std::numeric_limits<unsigned int>::digits) + ". Value: " + std::to_string(nbShadowMaps));
 		}
 
 		this->nbShadowMaps = nbShadowMaps;
@@ -312,17 +329,27 @@ namespace urchin
 
 		visibleModels.clear();
 		for (const auto &shadowData : shadowDatas)
-        {
-			for(unsigned int i=0; i<nbShadowMaps; ++i)
+		{ //models of a light are already unique for all frustum splits: merge only required for several lights
+			if(visibleModels.empty())
 			{
-				const std::vector<Model *> &visibleModelsForLightInFrustumSplit = shadowData.second->getFrustumShadowData(i)->getModels();
-				OctreeableHelper<Model>::merge(visibleModels, visibleModelsForLightInFrustumSplit);
+				visibleModels = shadowData.second->getModels();
+			}else
+			{
+				OctreeableHelper<Model>::merge(visibleModels, shadowData.second->getModels());
 			}
 		}
 
 		return visibleModels;
 	}
 
+	/**
+	 * @return Models visible in camera frustum. Models are determined by the same octree browsing than the shadow casters.
+	 */
+	const std::vector<Model *> &ShadowManager::getModelsInFrustum() const
+	{
+		return modelsInFrustum;
+	}
+
 	void ShadowManager::addShadowLight(const Light *light)
 	{
 		light->addObserver(this, Light::LIGHT_MOVE);
@@ -384,6 +411,7 @@ namespace urchin
 			Matrix4<float> mViewShadow = M * eye;
 
 			shadowData->setLightViewMatrix(mViewShadow);
+			shadowData->invalidateFrustumShadowData();
 		}else
 		{
 			throw std::runtime_error("Shadow currently not supported on omnidirectional light.");
@@ -391,34 +419,176 @@ namespace urchin
 	}
 
 	/**
-	 * Updates frustum shadow data (models, shadow caster/receiver box, projection matrix)
+	 * Updates frustum shadow data (models, shadow caster/receiver box, projection matrix).
+	 * Octree is browsed once for all frustum splits to update. Data of other frustum splits are kept from previous frame.
+	 * @param frustum Camera frustum to test in the same octree browsing or null. Models inside are stored in models in frustum.
 	 */
-	void ShadowManager::updateFrustumShadowData(const Light *light, ShadowData *shadowData)
+	void ShadowManager::updateFrustumShadowData(const Light *light, ShadowData *shadowData, const Frustum<float> *frustum)
 	{
 		ScopeProfiler profiler("3d", "upFrustumShadow");
 
 		if(light->hasParallelBeams())
 		{ //sun light
-            Matrix4<float> lightViewMatrixInverse = shadowData->getLightViewMatrix().inverse();
+			Matrix4<float> lightViewMatrixInverse = shadowData->getLightViewMatrix().inverse();
+			aabboxesSceneIndependent.clear();
+			obboxesSceneIndependentViewSpace.clear();
+			for(const auto &splitFrustum : splitFrustums)
+			{
+				aabboxesSceneIndependent.push_back(createSceneIndependentBox(splitFrustum, shadowData->getLightViewMatrix()));
+				obboxesSceneIndependentViewSpace.push_back(lightViewMatrixInverse * OBBox<float>(aabboxesSceneIndependent.back()));
+			}
+
+			unsigned int frustumSplitsToUpdate = computeFrustumSplitsToUpdate(shadowData);
+
+			cullingVolumes.clear();
+			cullingVolumesSplitIndices.clear();
 			for(unsigned int i=0; i<splitFrustums.size(); ++i)
 			{
-				AABBox<float> aabboxSceneIndependent = createSceneIndependentBox(splitFrustums[i], shadowData->getLightViewMatrix());
-				OBBox<float> obboxSceneIndependentViewSpace = lightViewMatrixInverse * OBBox<float>(aabboxSceneIndependent);
+				if(frustumSplitsToUpdate & (1u << i))
+				{
+					cullingVolumes.push_back(&obboxesSceneIndependentViewSpace[i]);
+					cullingVolumesSplitIndices.push_back(i);
+				}
+			}
+			unsigned int frustumMask = 0;
+			if(frustum)
+			{
+				frustumMask = 1u << cullingVolumes.size();
+				cullingVolumes.push_back(frustum);
+			}
 
-                obboxModels.clear();
-				modelOctreeManager->getOctreeablesIn(obboxSceneIndependentViewSpace, obboxModels, ModelProduceShadowFilter());
-				shadowData->getFrustumShadowData(i)->updateModels(obboxModels);
+			lightModels.clear();
+			lightModelsMasks.clear();
+			if(!cullingVolumes.empty())
+			{
+				modelOctreeManager->getOctreeablesIn(cullingVolumes, lightModels, lightModelsMasks);
+			}
 
-				AABBox<float> aabboxSceneDependent = createSceneDependentBox(aabboxSceneIndependent, obboxSceneIndependentViewSpace,
-                                                                             obboxModels, shadowData->getLightViewMatrix());
-				shadowData->getFrustumShadowData(i)->updateShadowCasterReceiverBox(aabboxSceneDependent, bForceUpdateAllShadowMaps);
+			//shadow casters of frustum splits kept from previous frame
+			shadowCasterModels.clear();
+			shadowCasterModelsMasks.clear();
+			shadowCasterModelsIndices.clear();
+			for(unsigned int i=0; i<shadowData->getModels().size(); ++i)
+			{
+				unsigned int keptFrustumSplitsMask = shadowData->getModelsMasks()[i] & ~frustumSplitsToUpdate;
+				if(keptFrustumSplitsMask!=0)
+				{
+					shadowCasterModelsIndices[shadowData->getModels()[i]] = shadowCasterModels.size();
+					shadowCasterModels.push_back(shadowData->getModels()[i]);
+					shadowCasterModelsMasks.push_back(keptFrustumSplitsMask);
+				}
+			}
+
+			//shadow casters of updated frustum splits
+			for(unsigned int i=0; i<lightModels.size(); ++i)
+			{
+				if(lightModelsMasks[i] & frustumMask)
+				{
+					modelsInFrustum.push_back(lightModels[i]);
+				}
+
+				unsigned int frustumSplitsMask = 0;
+				for(unsigned int j=0; j<cullingVolumesSplitIndices.size(); ++j)
+				{ //bit of culling volume 'j' to bit of its frustum split
+					frustumSplitsMask |= ((lightModelsMasks[i] >> j) & 1u) << cullingVolumesSplitIndices[j];
+				}
+
+				if(frustumSplitsMask!=0 && lightModels[i]->isProduceShadow())
+				{
+					auto itIndex = shadowCasterModelsIndices.find(lightModels[i]);
+					if(itIndex!=shadowCasterModelsIndices.end())
+					{
+						shadowCasterModelsMasks[itIndex->second] |= frustumSplitsMask;
+					}else
+					{
+						shadowCasterModels.push_back(lightModels[i]);
+						shadowCasterModelsMasks.push_back(frustumSplitsMask);
+					}
+				}
+			}
+			shadowData->updateModels(shadowCasterModels, shadowCasterModelsMasks);
+
+			for(unsigned int i=0; i<splitFrustums.size(); ++i)
+			{
+				FrustumShadowData *frustumShadowData = shadowData->getFrustumShadowData(i);
+				if((frustumSplitsToUpdate & (1u << i))==0)
+				{
+					frustumShadowData->updateFromCache();
+					continue;
+				}
+
+				frustumSplitModels.clear();
+				for(unsigned int j=0; j<shadowCasterModels.size(); ++j)
+				{
+					if(shadowCasterModelsMasks[j] & (1u << i))
+					{
+						frustumSplitModels.push_back(shadowCasterModels[j]);
+					}
+				}
+				frustumShadowData->updateModels(frustumSplitModels);
+
+				AABBox<float> aabboxSceneDependent = createSceneDependentBox(aabboxesSceneIndependent[i], obboxesSceneIndependentViewSpace[i],
+						frustumSplitModels, shadowData->getLightViewMatrix());
+				frustumShadowData->updateShadowCasterReceiverBox(aabboxSceneDependent, bForceUpdateAllShadowMaps);
+				frustumShadowData->updateSceneIndependentBox(aabboxesSceneIndependent[i]);
 			}
 		}else
 		{
 			throw std::runtime_error("Shadow not supported on omnidirectional light.");
 		}
+	}
 
-		bForceUpdateAllShadowMaps = false;
+	/**
+	 * A frustum split must be updated when it is invalidated, when its scene independent box changes or when a model moves in/out of it.
+	 * @return Frustum splits mask: bit i is set when the frustum split i must be updated
+	 */
+	unsigned int ShadowManager::computeFrustumSplitsToUpdate(const ShadowData *shadowData) const
+	{
+		unsigned int allFrustumSplits = (1u << splitFrustums.size()) - 1;
+		if(bForceUpdateAllShadowMaps)
+		{
+			return allFrustumSplits;
+		}
+
+		unsigned int frustumSplitsToUpdate = 0;
+		for(unsigned int i=0; i<splitFrustums.size(); ++i)
+		{
+			const FrustumShadowData *frustumShadowData = shadowData->getFrustumShadowData(i);
+			if(!frustumShadowData->isValid() || !frustumShadowData->isSceneIndependentBoxIdentical(aabboxesSceneIndependent[i]))
+			{
+				frustumSplitsToUpdate |= 1u << i;
+			}
+		}
+		if(frustumSplitsToUpdate==allFrustumSplits)
+		{ //models of previous frame could be removed models: they cannot be used
+			return allFrustumSplits;
+		}
+
+		//shadow casters moving inside or out of frustum splits
+		for(unsigned int i=0; i<shadowData->getModels().size(); ++i)
+		{
+			if(shadowData->getModels()[i]->isMovingInOctree())
+			{
+				frustumSplitsToUpdate |= shadowData->getModelsMasks()[i];
+			}
+		}
+
+		//models moving (or added) into frustum splits
+		for(const auto &movingModel : modelOctreeManager->getMovingOctreeables())
+		{
+			if(movingModel->isProduceShadow())
+			{
+				for(unsigned int i=0; i<splitFrustums.size(); ++i)
+				{
+					if((frustumSplitsToUpdate & (1u << i))==0 && obboxesSceneIndependentViewSpace[i].collideWithAABBox(movingModel->getAABBox()))
+					{
+						frustumSplitsToUpdate |= 1u << i;
+					}
+				}
+			}
+		}
+
+		return frustumSplitsToUpdate;
 	}
 
 	/**
@@ -444,8 +614,9 @@ namespace urchin
 			shadowReceiverAndCasterVertex[i*2 + 1] = Point3<float>(frustumPoint.X, frustumPoint.Y, nearCapZ);
 		}
 
-		//build shadow receiver/caster bounding box from points
-		return AABBox<float>(shadowReceiverAndCasterVertex, 16);
+		//build shadow receiver/caster bounding box from points: box is enlarged to the overflow step to stay identical on small camera moves
+		AABBox<float> aabboxSceneIndependent(shadowReceiverAndCasterVertex, 16);
+		return enlargeToOverflowStep(aabboxSceneIndependent.getMin(), aabboxSceneIndependent.getMax());
 	}
 
 	float ShadowManager::computeNearZForSceneIndependentBox(const Frustum<float> &splittedFrustumLightSpace) const
@@ -502,14 +673,23 @@ namespace urchin
                 std::max(std::min(aabboxSceneDependent.getMax().Y, aabboxSceneIndependent.getMax().Y), aabboxSceneIndependent.getMin().Y),
                 std::max(std::min(aabboxSceneDependent.getMax().Z, aabboxSceneIndependent.getMax().Z), aabboxSceneIndependent.getMin().Z));
 
-		cutMin.X = (cutMin.X < 0.0f) ? cutMin.X - (lightViewOverflowStepSize + fmod(cutMin.X, lightViewOverflowStepSize)) : cutMin.X - fmod(cutMin.X, lightViewOverflowStepSize);
-		cutMin.Y = (cutMin.Y < 0.0f) ? cutMin.Y - (lightViewOverflowStepSize + fmod(cutMin.Y, lightViewOverflowStepSize)) : cutMin.Y - fmod(cutMin.Y, lightViewOverflowStepSize);
-		cutMin.Z = (cutMin.Z < 0.0f) ? cutMin.Z - (lightViewOverflowStepSize + fmod(cutMin.Z, lightViewOverflowStepSize)) : cutMin.Z - fmod(cutMin.Z, lightViewOverflowStepSize);
-		cutMax.X = (cutMax.X < 0.0f) ? cutMax.X - fmod(cutMax.X, lightViewOverflowStepSize) : cutMax.X + (lightViewOverflowStepSize - fmod(cutMax.X, lightViewOverflowStepSize));
-		cutMax.Y = (cutMax.Y < 0.0f) ? cutMax.Y - fmod(cutMax.Y, lightViewOverflowStepSize) : cutMax.Y + (lightViewOverflowStepSize - fmod(cutMax.Y, lightViewOverflowStepSize));
-		cutMax.Z = (cutMax.Z < 0.0f) ? cutMax.Z - fmod(cutMax.Z, lightViewOverflowStepSize) : cutMax.Z + (lightViewOverflowStepSize - fmod(cutMax.Z, lightViewOverflowStepSize));
+		return enlargeToOverflowStep(cutMin, cutMax);
+	}
 
-		return AABBox<float>(cutMin, cutMax);
+	/**
+	 * @return Box enlarged to be a multiple of light view overflow step size
+	 */
+	AABBox<float> ShadowManager::enlargeToOverflowStep(const Point3<float> &boxMin, const Point3<float> &boxMax) const
+	{
+		Point3<float> min(boxMin), max(boxMax);
+		min.X = (min.X < 0.0f) ? min.X - (lightViewOverflowStepSize + fmod(min.X, lightViewOverflowStepSize)) : min.X - fmod(min.X, lightViewOverflowStepSize);
+		min.Y = (min.Y < 0.0f) ? min.Y - (lightViewOverflowStepSize + fmod(min.Y, lightViewOverflowStepSize)) : min.Y - fmod(min.Y, lightViewOverflowStepSize);
+		min.Z = (min.Z < 0.0f) ? min.Z - (lightViewOverflowStepSize + fmod(min.Z, lightViewOverflowStepSize)) : min.Z - fmod(min.Z, lightViewOverflowStepSize);
+		max.X = (max.X < 0.0f) ? max.X - fmod(max.X, lightViewOverflowStepSize) : max.X + (lightViewOverflowStepSize - fmod(max.X, lightViewOverflowStepSize));
+		max.Y = (max.Y < 0.0f) ? max.Y - fmod(max.Y, lightViewOverflowStepSize) : max.Y + (lightViewOverflowStepSize - fmod(max.Y, lightViewOverflowStepSize));
+		max.Z = (max.Z < 0.0f) ? max.Z - fmod(max.Z, lightViewOverflowStepSize) : max.Z + (lightViewOverflowStepSize - fmod(max.Z, lightViewOverflowStepSize));
+
+		return AABBox<float>(min, max);
 	}
 
 	void ShadowManager::splitFrustum(const Frustum<float> &frustum)
@@ -639,9 +819,19 @@ namespace urchin
 
 		splitFrustum(frustum);
 
+		//camera frustum is tested in the same octree browsing than the frustum splits of the first light
+		modelsInFrustum.clear();
+		const Frustum<float> *cameraFrustum = &frustum;
 		for(std::map<const Light *, ShadowData *>::const_iterator it = shadowDatas.begin(); it!=shadowDatas.end(); ++it)
 		{
-			updateFrustumShadowData(it->first, it->second);
+			updateFrustumShadowData(it->first, it->second, cameraFrustum);
+			cameraFrustum = nullptr;
+		}
+		bForceUpdateAllShadowMaps = false;
+
+		if(cameraFrustum)
+		{ //no light producing shadow
+			modelOctreeManager->getOctreeablesIn(frustum, modelsInFrustum);
 		}
 	}
 
@@ -659,6 +849,10 @@ namespace urchin
 		for(std::map<const Light *, ShadowData *>::const_iterator it = shadowDatas.begin(); it!=shadowDatas.end(); ++it)
 		{
 			ShadowData *shadowData = it->second;
+			if(!shadowData->needShadowMapsUpdate())
+			{ //shadow maps of previous frame are still valid
+				continue;
+			}
 
 			glViewport(0, 0, shadowMapResolution, shadowMapResolution);
 			glBindFramebuffer(GL_FRAMEBUFFER, shadowData->getFboID());
@@ -1,6 +1,7 @@
 #ifndef URCHINENGINE_SHADOWMANAGER_H
 #define URCHINENGINE_SHADOWMANAGER_H
 
+#include <unordered_map>
 #include "UrchinCommon.h"
 
 #include "scene/renderer3d/shadow/data/ShadowData.h"
@@ -17,7 +18,9 @@ namespace urchin
 {
 
 	/**
-	* Manager for shadow mapping (parallel-split shadow maps & variance shadow maps)
+	* Manager for shadow mapping (parallel-split shadow maps & variance shadow maps).
+	* Shadow casters of a frustum split are selected again only when the frustum split moves in light space or when a model moves
+	* in/out of it: shadow map of a frustum split without change is not rendered again.
 	*/
 	class ShadowManager : public Observer, public Observable
 	{
@@ -56,6 +59,7 @@ namespace urchin
 			const std::vector<Frustum<float>> &getSplitFrustums() const;
 			const ShadowData &getShadowData(const Light *) const;
 			const std::vector<Model *> &computeVisibleModels();
+			const std::vector<Model *> &getModelsInFrustum() const;
 
 			void updateVisibleModels(const Frustum<float> &);
 			void forceUpdateAllShadowMaps();
@@ -78,11 +82,13 @@ namespace urchin
 
 			//splits handling
 			void updateViewMatrix(const Light *);
-			void updateFrustumShadowData(const Light *, ShadowData *);
+			void updateFrustumShadowData(const Light *, ShadowData *, const Frustum<float> *);
+			unsigned int computeFrustumSplitsToUpdate(const ShadowData *) const;
 			AABBox<float> createSceneIndependentBox(const Frustum<float> &, const Matrix4<float> &) const;
 			float computeNearZForSceneIndependentBox(const Frustum<float> &) const;
 			AABBox<float> createSceneDependentBox(const AABBox<float> &, const OBBox<float> &,
 					const std::vector<Model *> &, const Matrix4<float> &) const;
+			AABBox<float> enlargeToOverflowStep(const Point3<float> &, const Point3<float> &) const;
 			void splitFrustum(const Frustum<float> &);
 
 			//shadow map handling
@@ -93,6 +99,7 @@ namespace urchin
 			const float shadowMapBias;
 			const float percentageUniformSplit; //percentage of uniform split against the logarithmic split to split frustum
 			float lightViewOverflowStepSize;
+			const unsigned int lodBias; //shadow maps use coarser levels of detail of the models
 			unsigned int shadowMapResolution;
 			unsigned int nbShadowMaps;
 			float viewingShadowDistance;
@@ -103,7 +110,17 @@ namespace urchin
 			ModelDisplayer *shadowModelDisplayer;
 			LightManager *lightManager;
 			OctreeManager<Model> *modelOctreeManager;
-			std::vector<Model *> obboxModels;
+			std::vector<AABBox<float>> aabboxesSceneIndependent;
+			std::vector<OBBox<float>> obboxesSceneIndependentViewSpace;
+			std::vector<const ConvexObject3D<float> *> cullingVolumes;
+			std::vector<unsigned int> cullingVolumesSplitIndices;
+			std::vector<Model *> lightModels;
+			std::vector<unsigned int> lightModelsMasks;
+			std::vector<Model *> shadowCasterModels;
+			std::vector<unsigned int> shadowCasterModelsMasks;
+			std::unordered_map<Model *, unsigned int> shadowCasterModelsIndices;
+			std::vector<Model *> frustumSplitModels;
+			std::vector<Model *> modelsInFrustum;
 			Matrix4<float> projectionMatrix;
 			ShadowUniform *shadowUniform;
 			ShadowModelUniform *shadowModelUniform;
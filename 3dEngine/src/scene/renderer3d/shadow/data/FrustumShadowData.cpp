@@ -3,14 +3,59 @@
 namespace urchin
 {
 
+	FrustumShadowStatistics::FrustumShadowStatistics() :
+			updatesCount(0),
+			casterSelectionsCount(0),
+			shadowMapUpdatesCount(0)
+	{
+
+	}
+
 	FrustumShadowData::FrustumShadowData(unsigned int frustumSplitIndex) :
 			frustumSplitIndex(frustumSplitIndex),
+			bIsValid(false),
 			shadowCasterReceiverBoxUpdated(false),
             modelsRequireUpdate(false)
 	{
 
 	}
 
+	/**
+	 * Invalidates the shadow casters and the shadow caster/receiver box: they will be computed again at next update
+	 */
+	void FrustumShadowData::invalidate()
+	{
+		bIsValid = false;
+	}
+
+	/**
+	 * @return True when the shadow casters and the shadow caster/receiver box of previous frame can be reused
+	 */
+	bool FrustumShadowData::isValid() const
+	{
+		return bIsValid;
+	}
+
+	/**
+	 * @return True when the scene independent box is identical to the one used to select the shadow casters
+	 */
+	bool FrustumShadowData::isSceneIndependentBoxIdentical(const AABBox<float> &sceneIndependentBox) const
+	{
+		return areIdenticalAABBox(sceneIndependentBox, this->sceneIndependentBox);
+	}
+
+	/**
+	 * @param sceneIndependentBox Box in light space used to select the shadow casters
+	 */
+	void FrustumShadowData::updateSceneIndependentBox(const AABBox<float> &sceneIndependentBox)
+	{
+		this->sceneIndependentBox = sceneIndependentBox;
+		this->bIsValid = true;
+	}
+
+	/**
+	 * Must be called after the update of the models
+	 */
 	void FrustumShadowData::updateShadowCasterReceiverBox(const AABBox<float> &shadowCasterReceiverBox, bool forceUpdateAllShadowMap)
 	{
 		if(areIdenticalAABBox(shadowCasterReceiverBox, this->shadowCasterReceiverBox) && !forceUpdateAllShadowMap)
@@ -23,6 +68,8 @@ namespace urchin
 
 			this->shadowCasterReceiverBoxUpdated = true;
 		}
+
+		onUpdateDone();
 	}
 
 	bool FrustumShadowData::areIdenticalAABBox(const AABBox<float> &shadowCasterReceiverBox1, const AABBox<float> &shadowCasterReceiverBox2) const
@@ -65,7 +112,7 @@ namespace urchin
         {
             for (auto model : models)
             {
-                if(model->isMovingInOctree() || model->isAnimate())
+                if(model->isMovingInOctree() || model->isAnimate() || model->isLodUpdated())
                 {
                     modelsRequireUpdate = true;
                     break;
@@ -74,6 +121,7 @@ namespace urchin
         }
 
 		this->models = models;
+		statistics.casterSelectionsCount++;
 	}
 
 	/**
@@ -84,8 +132,45 @@ namespace urchin
 		return models;
 	}
 
+	/**
+	 * Keeps the models and the shadow caster/receiver box of previous frame. Shadow map is updated only when a model is animated or changes its level of detail.
+	 */
+	void FrustumShadowData::updateFromCache()
+	{
+		shadowCasterReceiverBoxUpdated = false;
+
+		modelsRequireUpdate = false;
+		for (auto model : models)
+		{
+			if(model->isAnimate() || model->isLodUpdated())
+			{
+				modelsRequireUpdate = true;
+				break;
+			}
+		}
+
+		onUpdateDone();
+	}
+
+	void FrustumShadowData::onUpdateDone()
+	{
+		statistics.updatesCount++;
+		if(needShadowMapUpdate())
+		{
+			statistics.shadowMapUpdatesCount++;
+		}
+	}
+
 	bool FrustumShadowData::needShadowMapUpdate() const
 	{
 		return shadowCasterReceiverBoxUpdated || modelsRequireUpdate;
 	}
+
+	/**
+	 * @return Number of updates of the frustum split data, shadow casters selections and shadow map renderings
+	 */
+	const FrustumShadowStatistics &FrustumShadowData::getStatistics() const
+	{
+		return statistics;
+	}
 }
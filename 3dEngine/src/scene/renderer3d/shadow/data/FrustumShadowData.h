@@ -8,14 +8,29 @@
 namespace urchin
 {
 
+	struct FrustumShadowStatistics
+	{
+		FrustumShadowStatistics();
+
+		unsigned long updatesCount; //frames where the frustum split data have been updated
+		unsigned long casterSelectionsCount; //frames where the shadow casters have been selected in the octree
+		unsigned long shadowMapUpdatesCount; //frames where the shadow map has been rendered
+	};
+
 	/**
-	* Shadow execution data for a light and a split frustum
+	* Shadow execution data for a light and a split frustum. Shadow casters and shadow caster/receiver box are kept from a frame
+	* to another: they are computed again only when the frustum split is invalidated.
 	*/
 	class FrustumShadowData
 	{
 		public:
 			explicit FrustumShadowData(unsigned int);
 
+			void invalidate();
+			bool isValid() const;
+			bool isSceneIndependentBoxIdentical(const AABBox<float> &) const;
+			void updateSceneIndependentBox(const AABBox<float> &);
+
 			void updateShadowCasterReceiverBox(const AABBox<float> &, bool);
 			const AABBox<float> &getShadowCasterReceiverBox() const;
 			const Matrix4<float> &getLightProjectionMatrix() const;
@@ -24,20 +39,28 @@ namespace urchin
 			void updateModels(const std::vector<Model *> &);
 			const std::vector<Model *> &getModels() const;
 
+			void updateFromCache();
+
 			bool needShadowMapUpdate() const;
+			const FrustumShadowStatistics &getStatistics() const;
 
 		private:
 			bool areIdenticalAABBox(const AABBox<float> &, const AABBox<float> &) const;
+			void onUpdateDone();
 
 			unsigned int frustumSplitIndex; //index of frustum split (0: frustum split nearest to eye)
             bool isFarFrustumSplit;
+			bool bIsValid;
 
+			AABBox<float> sceneIndependentBox;
 			Matrix4<float> lightProjectionMatrix;
 			AABBox<float> shadowCasterReceiverBox;
 			bool shadowCasterReceiverBoxUpdated;
 
 			std::vector<Model *> models;
 			bool modelsRequireUpdate;
+
+			FrustumShadowStatistics statistics;
 	};
 
 }
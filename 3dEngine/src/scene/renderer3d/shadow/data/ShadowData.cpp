@@ -3,7 +3,6 @@
 #include <stdexcept>
 
 #include "ShadowData.h"
-#include "scene/renderer3d/octree/helper/OctreeableHelper.h"
 
 namespace urchin
 {
@@ -75,14 +74,7 @@ namespace urchin
 
 	void ShadowData::applyTextureFilters()
 	{
-		unsigned int layersToUpdate = 0;
-		for(unsigned int i=0; i<getNbFrustumShadowData(); ++i)
-		{
-			if(getFrustumShadowData(i)->needShadowMapUpdate())
-			{
-				layersToUpdate = layersToUpdate | MathAlgorithm::powerOfTwo(i);
-			}
-		}
+		unsigned int layersToUpdate = computeFrustumSplitsToUpdate();
 
 		unsigned int textureId = shadowMapTextureID;
 		for(auto &textureFilter : textureFilters)
@@ -134,19 +126,81 @@ namespace urchin
 		return frustumShadowData[index];
 	}
 
+	/**
+	 * @param models Models visible from light in at least one frustum split
+	 * @param modelsMasks Frustum splits mask of each model: bit i is set when the model is visible in the frustum split i
+	 */
+	void ShadowData::updateModels(const std::vector<Model *> &models, const std::vector<unsigned int> &modelsMasks)
+	{
+		this->models = models;
+		this->modelsMasks = modelsMasks;
+	}
+
+	/**
+	 * @return Models visible from light in at least one frustum split
+	 */
+	const std::vector<Model *> &ShadowData::getModels() const
+	{
+		return models;
+	}
+
+	/**
+	 * @return Frustum splits mask of each model visible from light
+	 */
+	const std::vector<unsigned int> &ShadowData::getModelsMasks() const
+	{
+		return modelsMasks;
+	}
+
+	/**
+	 * Invalidates the data of all frustum splits: shadow casters will be selected again at next update
+	 */
+	void ShadowData::invalidateFrustumShadowData()
+	{
+		for(auto &fsd : frustumShadowData)
+		{
+			fsd->invalidate();
+		}
+	}
+
+	/**
+	 * @return Models visible from light in frustum splits requiring an update of the shadow map
+	 */
 	const std::vector<Model *> &ShadowData::retrieveModels() const
 	{
-        models.clear();
+		modelsToUpdate.clear();
+
+		unsigned int frustumSplitsToUpdate = computeFrustumSplitsToUpdate();
 
+		for(unsigned int i=0; i<models.size(); ++i)
+		{
+			if(modelsMasks[i] & frustumSplitsToUpdate)
+			{
+				modelsToUpdate.push_back(models[i]);
+			}
+		}
+
+		return modelsToUpdate;
+	}
+
+	/**
+	 * @return True when the shadow map of at least one frustum split requires an update
+	 */
+	bool ShadowData::needShadowMapsUpdate() const
+	{
+		return computeFrustumSplitsToUpdate()!=0;
+	}
+
+	unsigned int ShadowData::computeFrustumSplitsToUpdate() const
+	{
+		unsigned int frustumSplitsToUpdate = 0;
 		for(unsigned int i=0; i<getNbFrustumShadowData(); ++i)
 		{
 			if(getFrustumShadowData(i)->needShadowMapUpdate())
 			{
-				const std::vector<Model *> &frustumSplitModels = getFrustumShadowData(i)->getModels();
-				OctreeableHelper<Model>::merge(models, frustumSplitModels);
+				frustumSplitsToUpdate = frustumSplitsToUpdate | MathAlgorithm::powerOfTwo(i);
 			}
 		}
-
-		return models;
+		return frustumSplitsToUpdate;
 	}
 }
@@ -41,9 +41,16 @@ namespace urchin
 			FrustumShadowData *getFrustumShadowData(unsigned int);
 			const FrustumShadowData *getFrustumShadowData(unsigned int) const;
 
+			void updateModels(const std::vector<Model *> &, const std::vector<unsigned int> &);
+			const std::vector<Model *> &getModels() const;
+			const std::vector<unsigned int> &getModelsMasks() const;
+			void invalidateFrustumShadowData();
 			const std::vector<Model *> &retrieveModels() const;
+			bool needShadowMapsUpdate() const;
 
 		private:
+			unsigned int computeFrustumSplitsToUpdate() const;
+
 			const Light *const light;
 
 			unsigned int fboID; //frame buffer object ID containing shadow map(s)
@@ -54,7 +61,9 @@ namespace urchin
 
 			Matrix4<float> lightViewMatrix;
 			std::vector<FrustumShadowData *> frustumShadowData;
-			mutable std::vector<Model *> models;
+			std::vector<Model *> models;
+			std::vector<unsigned int> modelsMasks;
+			mutable std::vector<Model *> modelsToUpdate;
 	};
 
 }
@@ -9,7 +9,8 @@
 
 namespace urchin
 {
-    Terrain::Terrain(std::shared_ptr<TerrainMesh> &mesh, std::unique_ptr<TerrainMaterial> &material, const Point3<float> &position)
+    Terrain::Terrain(std::shared_ptr<TerrainMesh> &mesh, std::unique_ptr<TerrainMaterial> &material, const Point3<float> &position) :
+            lodDistance(ConfigService::instance()->getFloatValue("terrain.lodDistance"))
     {
         glGenBuffers(4, bufferIDs);
         glGenVertexArrays(1, &vertexArrayObject);
@@ -71,18 +72,28 @@ namespace urchin
 
         glBindVertexArray(vertexArrayObject);
 
+        //vertices are duplicated by chunk: chunk vertex attributes are copied from the terrain vertex attributes
+        const HeightfieldChunkTree *chunkTree = mesh->getChunkTree();
+        const std::vector<unsigned int> &chunksVerticesSource = chunkTree->getChunksVerticesSource();
+        std::vector<Vector3<float>> chunksNormals;
+        chunksNormals.reserve(chunksVerticesSource.size());
+        for(unsigned int vertexSource : chunksVerticesSource)
+        {
+            chunksNormals.push_back(mesh->getNormals()[vertexSource]);
+        }
+
         glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[VAO_VERTEX_POSITION]);
-        glBufferData(GL_ARRAY_BUFFER, mesh->getVertices().size()*sizeof(float)*3, &mesh->getVertices()[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, chunkTree->getChunksVertices().size()*sizeof(float)*3, &chunkTree->getChunksVertices()[0], GL_STATIC_DRAW);
         glEnableVertexAttribArray(SHADER_VERTEX_POSITION);
         glVertexAttribPointer(SHADER_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 
         glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[VAO_NORMAL]);
-        glBufferData(GL_ARRAY_BUFFER, mesh->getNormals().size()*sizeof(float)*3, &mesh->getNormals()[0], GL_STATIC_DRAW);
+        glBufferData(GL_ARRAY_BUFFER, chunksNormals.size()*sizeof(float)*3, &chunksNormals[0], GL_STATIC_DRAW);
         glEnableVertexAttribArray(SHADER_NORMAL);
         glVertexAttribPointer(SHADER_NORMAL, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
 
         glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, bufferIDs[VAO_INDEX]);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, mesh->getIndices().size()*sizeof(unsigned int), &mesh->getIndices()[0], GL_STATIC_DRAW);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, chunkTree->getLodsIndices().size()*sizeof(unsigned int), &chunkTree->getLodsIndices()[0], GL_STATIC_DRAW);
 
         refreshMaterial(); //material uses mesh info: refresh is required
         refreshGrassMesh(); //grass uses mesh info: refresh is required
@@ -113,9 +124,16 @@ namespace urchin
             glUniform1f(sRepeatLoc, material->getSRepeat());
             glUniform1f(tRepeatLoc, material->getTRepeat());
 
+            std::vector<Point2<float>> chunksTexCoordinates;
+            chunksTexCoordinates.reserve(mesh->getChunkTree()->getChunksVerticesSource().size());
+            for(unsigned int vertexSource : mesh->getChunkTree()->getChunksVerticesSource())
+            {
+                chunksTexCoordinates.push_back(material->getTexCoordinates()[vertexSource]);
+            }
+
             glBindVertexArray(vertexArrayObject);
             glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[VAO_TEX_COORD]);
-            glBufferData(GL_ARRAY_BUFFER, material->getTexCoordinates().size() * sizeof(float) * 2, &material->getTexCoordinates()[0], GL_STATIC_DRAW);
+            glBufferData(GL_ARRAY_BUFFER, chunksTexCoordinates.size() * sizeof(float) * 2, &chunksTexCoordinates[0], GL_STATIC_DRAW);
             glEnableVertexAttribArray(SHADER_TEX_COORD);
             glVertexAttribPointer(SHADER_TEX_COORD, 2, GL_FLOAT, GL_FALSE, 0, nullptr);
         }
@@ -187,6 +205,31 @@ namespace urchin
         return mesh->findHeightAt(localCoordinate) + position.Y;
     }
 
+    /**
+     * @param lod Level of detail of the terrain geometry
+     */
+    float Terrain::findHeightAt(const Point2<float> &globalXzCoordinate, unsigned int lod) const
+    {
+        Point2<float> localCoordinate = Point2<float>(globalXzCoordinate.X - position.X, globalXzCoordinate.Y - position.Z);
+        return mesh->findHeightAt(localCoordinate, lod) + position.Y;
+    }
+
+    /**
+     * @param lod Level of detail of the terrain geometry
+     * @param triangles [out] Points of the triangles (three points by triangle) overlapping the X/Z area
+     */
+    void Terrain::findTrianglesIn(const Point2<float> &globalMinXzCoordinate, const Point2<float> &globalMaxXzCoordinate, unsigned int lod,
+                                  std::vector<Point3<float>> &triangles) const
+    {
+        unsigned int firstPoint = triangles.size();
+        mesh->findTrianglesIn(Point2<float>(globalMinXzCoordinate.X - position.X, globalMinXzCoordinate.Y - position.Z),
+                              Point2<float>(globalMaxXzCoordinate.X - position.X, globalMaxXzCoordinate.Y - position.Z), lod, triangles);
+        for(unsigned int i=firstPoint; i<triangles.size(); ++i)
+        {
+            triangles[i] += position;
+        }
+    }
+
     void Terrain::display(const Camera *camera, float dt) const
     {
         ShaderManager::instance()->bind(terrainShader);
@@ -194,8 +237,28 @@ namespace urchin
         glUniformMatrix4fv(mViewLoc, 1, GL_FALSE, (const float*)camera->getViewMatrix());
         material->loadTextures();
 
-        glBindVertexArray(vertexArrayObject);
-        glDrawElements(GL_TRIANGLE_STRIP, mesh->getIndices().size(), GL_UNSIGNED_INT, nullptr);
+        //chunks selection in terrain space
+        Matrix4<float> terrainTranslation;
+        terrainTranslation.buildTranslation(-position.X, -position.Y, -position.Z);
+        Point3<float> localCameraPosition(camera->getPosition().X - position.X, camera->getPosition().Y - position.Y, camera->getPosition().Z - position.Z);
+        const HeightfieldChunkTree *chunkTree = mesh->getChunkTree();
+        chunkTree->selectChunks(terrainTranslation * camera->getFrustum(), localCameraPosition, lodDistance, selectedChunks);
+
+        chunksIndicesCount.clear();
+        chunksIndicesOffset.clear();
+        chunksBaseVertex.clear();
+        for(const auto &selectedChunk : selectedChunks)
+        {
+            chunksIndicesCount.push_back(chunkTree->getLodIndicesCount(selectedChunk.lod));
+            chunksIndicesOffset.push_back(reinterpret_cast<const void *>(chunkTree->getLodIndicesOffset(selectedChunk.lod) * sizeof(unsigned int)));
+            chunksBaseVertex.push_back(selectedChunk.chunkIndex * chunkTree->getChunkVerticesCount());
+        }
+
+        if(!selectedChunks.empty())
+        {
+            glBindVertexArray(vertexArrayObject);
+            glMultiDrawElementsBaseVertex(GL_TRIANGLES, &chunksIndicesCount[0], GL_UNSIGNED_INT, &chunksIndicesOffset[0], chunksIndicesCount.size(), &chunksBaseVertex[0]);
+        }
 
         if(grass)
         {
@@ -37,6 +37,8 @@ namespace urchin
 
             Point3<float> findPointAt(const Point2<float> &) const;
             float findHeightAt(const Point2<float> &) const;
+            float findHeightAt(const Point2<float> &, unsigned int) const;
+            void findTrianglesIn(const Point2<float> &, const Point2<float> &, unsigned int, std::vector<Point3<float>> &) const;
 
             void display(const Camera *, float invFrameRate) const;
 
@@ -66,6 +68,11 @@ namespace urchin
 
             Matrix4<float> projectionMatrix;
 
+            const float lodDistance;
+            mutable std::vector<HeightfieldChunkSelection> selectedChunks;
+            mutable std::vector<int> chunksIndicesCount, chunksBaseVertex;
+            mutable std::vector<const void *> chunksIndicesOffset;
+
             std::shared_ptr<TerrainMesh> mesh;
             std::unique_ptr<TerrainMaterial> material;
             std::unique_ptr<TerrainGrass> grass;
@@ -60,14 +60,9 @@ namespace urchin
     {
         ScopeProfiler profiler("3d", "terrainDisplay");
 
-        glEnable(GL_PRIMITIVE_RESTART);
-        glPrimitiveRestartIndex(RESTART_INDEX);
-
         for(const auto terrain : terrains)
         {
             terrain->display(camera, dt);
         }
-
-        glDisable(GL_PRIMITIVE_RESTART);
     }
 }
@@ -1,13 +1,11 @@
-#include <thread>
-#include <algorithm>
-#include <functional>
+#include <array>
 #include <fstream>
 
 #include "TerrainMesh.h"
 #include "resources/MediaManager.h"
 
 #define FRL_FILE_EXTENSION ".frl" //Extension for FRL files (Fast Resource Loading)
-#define TERRAIN_FRL_FILE_VERSION 1
+#define TERRAIN_FRL_FILE_VERSION 2
 
 namespace urchin
 {
@@ -42,13 +40,14 @@ namespace urchin
             terrainFrlFile.close();
 
             buildVertices(imgTerrain);
-            buildIndices();
             buildNormals();
 
             writeTerrainMeshFile(terrainFrlFilePath, terrainMd5Sum);
         }
 
         heightfieldPointHelper = std::make_unique<HeightfieldPointHelper<float>>(vertices, xSize);
+        chunkTree = std::make_unique<HeightfieldChunkTree>(vertices, xSize, zSize, ConfigService::instance()->getUnsignedIntValue("terrain.chunkSize"),
+                ConfigService::instance()->getUnsignedIntValue("terrain.chunkLods"));
 
         imgTerrain->release();
     }
@@ -88,9 +87,12 @@ namespace urchin
         return normals;
     }
 
-    const std::vector<unsigned int> &TerrainMesh::getIndices() const
+    /**
+     * @return Chunks of the terrain with their levels of detail
+     */
+    const HeightfieldChunkTree *TerrainMesh::getChunkTree() const
     {
-        return indices;
+        return chunkTree.get();
     }
 
     Point3<float> TerrainMesh::findPointAt(const Point2<float> &xzCoordinate) const
@@ -103,14 +105,27 @@ namespace urchin
         return heightfieldPointHelper->findHeightAt(xzCoordinate);
     }
 
-    unsigned int TerrainMesh::computeNumberVertices() const
+    /**
+     * @param lod Level of detail of the terrain geometry: results match the geometry displayed for this level of detail
+     */
+    float TerrainMesh::findHeightAt(const Point2<float> &xzCoordinate, unsigned int lod) const
     {
-        return xSize * zSize;
+        return chunkTree->findHeightAt(xzCoordinate, lod);
+    }
+
+    /**
+     * @param lod Level of detail of the terrain geometry: results match the geometry displayed for this level of detail
+     * @param triangles [out] Points of the triangles (three points by triangle) overlapping the X/Z area
+     */
+    void TerrainMesh::findTrianglesIn(const Point2<float> &minXzCoordinate, const Point2<float> &maxXzCoordinate, unsigned int lod,
+                                      std::vector<Point3<float>> &triangles) const
+    {
+        chunkTree->findTrianglesIn(minXzCoordinate, maxXzCoordinate, lod, triangles);
     }
 
-    unsigned int TerrainMesh::computeNumberIndices() const
+    unsigned int TerrainMesh::computeNumberVertices() const
     {
-        return ((zSize-1) * xSize * 2) + (zSize-1);
+        return xSize * zSize;
     }
 
     unsigned int TerrainMesh::computeNumberNormals() const
@@ -118,14 +133,15 @@ namespace urchin
         return xSize * zSize;
     }
 
-    std::vector<Point3<float>> TerrainMesh::buildVertices(const Image *imgTerrain)
+    void TerrainMesh::buildVertices(const Image *imgTerrain)
     {
-        vertices.reserve(computeNumberVertices());
+        vertices.resize(computeNumberVertices());
 
         float xStart = (-(xSize * xzScale) / 2.0) + (xzScale / 2.0);
         float zStart = (-(zSize * xzScale) / 2.0) + (xzScale / 2.0);
 
-        for(unsigned int z=0; z<zSize; ++z)
+        //one job by row
+        JobService::instance()->run(zSize, [&](unsigned int z)
         {
             float zFloat = zStart + static_cast<float>(z) * xzScale;
             for (unsigned int x = 0; x < xSize; ++x)
@@ -141,110 +157,69 @@ namespace urchin
                 }
 
                 float xFloat = xStart + static_cast<float>(x) * xzScale;
-                vertices.emplace_back(Point3<float>(xFloat, elevation, zFloat));
+                vertices[x + xSize * z] = Point3<float>(xFloat, elevation, zFloat);
             }
-        }
-
-        return vertices;
+        });
     }
 
-    std::vector<unsigned int> TerrainMesh::buildIndices()
+    void TerrainMesh::buildNormals()
     {
-        indices.reserve(computeNumberIndices());
-
-        for(unsigned int z = 0; z < zSize - 1; ++z)
+        //1. compute normal of triangles: one job by row of quads. Triangles of a row are ordered as in a triangle strip
+        //alternating the vertices of the rows z+1 and z
+        unsigned int rowTriangles = (xSize - 1) * 2;
+        auto stripVertex = [&](unsigned int z, unsigned int stripIndex) -> const Point3<float> &
         {
-            for (unsigned int x = 0; x < xSize; ++x)
-            {
-                indices.push_back(x + xSize * (z + 1));
-                indices.push_back(x + xSize * z);
-            }
-
-            indices.push_back(RESTART_INDEX);
-        }
-        return indices;
-    }
-
-    std::vector<Vector3<float>> TerrainMesh::buildNormals()
-    {
-        const unsigned int NUM_THREADS = std::max(2u, std::thread::hardware_concurrency());
-
-        //1. compute normal of triangles
-        unsigned int totalTriangles = ((zSize - 1) * (xSize - 1)) * 2;
-        unsigned int xLineQuantity = (xSize * 2) + 1;
+            return vertices[(stripIndex / 2) + xSize * (z + 1 - (stripIndex % 2))];
+        };
         std::vector<Vector3<float>> normalTriangles;
-        normalTriangles.resize(totalTriangles);
-        unsigned int numLoopNormalTriangle = indices.size() - 2;
-        std::vector<std::thread> threadsNormalTriangle(NUM_THREADS);
-        for(unsigned int threadI=0; threadI<NUM_THREADS; threadI++)
+        normalTriangles.resize(rowTriangles * (zSize - 1));
+        JobService::instance()->run(zSize - 1, [&](unsigned int z)
         {
-            unsigned int beginI = threadI * numLoopNormalTriangle / NUM_THREADS;
-            unsigned int endI = (threadI + 1)==NUM_THREADS ? numLoopNormalTriangle : (threadI + 1) * numLoopNormalTriangle / NUM_THREADS;
-            threadsNormalTriangle[threadI] = std::thread(std::bind([&](unsigned int beginI, unsigned int endI)
+            for(unsigned int i = 0; i < rowTriangles; i++)
             {
-                for(unsigned int i = beginI; i<endI; i++)
+                const Point3<float> &point1 = stripVertex(z, i);
+                const Point3<float> &point2 = stripVertex(z, i + 1);
+                const Point3<float> &point3 = stripVertex(z, i + 2);
+
+                bool isCwTriangle = i % 2 == 0;
+                Vector3<float> normal;
+                if(isCwTriangle)
                 {
-                    if(indices[i+2] != RESTART_INDEX)
-                    {
-                        Point3<float> point1 = vertices[indices[i]];
-                        Point3<float> point2 = vertices[indices[i+1]];
-                        Point3<float> point3 = vertices[indices[i+2]];
-
-                        bool isCwTriangle = (i % xLineQuantity) % 2 == 0;
-                        Vector3<float> normal;
-                        if(isCwTriangle)
-                        {
-                            normal = (point1.vector(point2).crossProduct(point3.vector(point1)));
-                        }else
-                        {
-                            normal = (point1.vector(point2).crossProduct(point1.vector(point3)));
-                        }
-
-                        unsigned int normalTriangleIndex = i - ((i / xLineQuantity) * 3);
-                        normalTriangles[normalTriangleIndex] = normal.normalize();
-                    }else
-                    {
-                        i += 2;
-                    }
+                    normal = (point1.vector(point2).crossProduct(point3.vector(point1)));
+                }else
+                {
+                    normal = (point1.vector(point2).crossProduct(point1.vector(point3)));
                 }
-            }, beginI, endI));
-        }
-        std::for_each(threadsNormalTriangle.begin(), threadsNormalTriangle.end(), [](std::thread& x){x.join();});
-        #ifdef _DEBUG
-            assert(totalTriangles == normalTriangles.size());
-        #endif
 
-        //2. compute normal of vertex
+                normalTriangles[z * rowTriangles + i] = normal.normalize();
+            }
+        });
+
+        //2. compute normal of vertex: one job by row of vertices
         normals.resize(computeNumberNormals());
-        unsigned int numLoopNormalVertex = vertices.size();
-        std::vector<std::thread> threadsNormalVertex(NUM_THREADS);
-        for(unsigned int threadI=0; threadI<NUM_THREADS; threadI++)
+        JobService::instance()->run(zSize, [&](unsigned int z)
         {
-            unsigned int beginI = threadI * numLoopNormalVertex / NUM_THREADS;
-            unsigned int endI = (threadI + 1)==NUM_THREADS ? numLoopNormalVertex : (threadI + 1) * numLoopNormalVertex / NUM_THREADS;
-
-            threadsNormalVertex[threadI] = std::thread(std::bind([&](unsigned int beginI, unsigned int endI)
+            std::array<unsigned int, 6> triangleIndices;
+            for(unsigned int i = z * xSize; i < (z + 1) * xSize; i++)
             {
-                for(unsigned int i = beginI; i<endI; i++)
+                Vector3<float> vertexNormal(0.0, 0.0, 0.0);
+                unsigned int trianglesCount = findTriangleIndices(i, triangleIndices);
+                for(unsigned int triangle = 0; triangle < trianglesCount; ++triangle)
                 {
-                    Vector3<float> vertexNormal(0.0, 0.0, 0.0);
-                    for(unsigned int triangleIndex : findTriangleIndices(i))
-                    {
-                        vertexNormal += normalTriangles[triangleIndex];
-                    }
-                    normals[i] = vertexNormal.normalize();
+                    vertexNormal += normalTriangles[triangleIndices[triangle]];
                 }
-            }, beginI, endI));
-        }
-        std::for_each(threadsNormalVertex.begin(), threadsNormalVertex.end(), [](std::thread& x){x.join();});
-
-        return normals;
+                normals[i] = vertexNormal.normalize();
+            }
+        });
     }
 
-    std::vector<unsigned int> TerrainMesh::findTriangleIndices(unsigned int vertexIndex) const
+    /**
+     * @param triangleIndices [out] Indices of the triangles sharing the vertex
+     * @return Number of triangles sharing the vertex
+     */
+    unsigned int TerrainMesh::findTriangleIndices(unsigned int vertexIndex, std::array<unsigned int, 6> &triangleIndices) const
     {
-        std::vector<unsigned int> triangleIndices;
-        triangleIndices.reserve(6);
+        unsigned int trianglesCount = 0;
 
         unsigned int rowNum = vertexIndex / xSize;
         int squareIndex = vertexIndex - xSize - rowNum;
@@ -262,14 +237,14 @@ namespace urchin
             //left triangle
             if (!isLeftBorderVertex)
             {
-                triangleIndices.emplace_back(firstLeftTopTriangle);
+                triangleIndices[trianglesCount++] = firstLeftTopTriangle;
             }
 
             //right triangles
             if (!isRightBorderVertex)
             {
-                triangleIndices.emplace_back(firstLeftTopTriangle + 1);
-                triangleIndices.emplace_back(firstLeftTopTriangle + 2);
+                triangleIndices[trianglesCount++] = firstLeftTopTriangle + 1;
+                triangleIndices[trianglesCount++] = firstLeftTopTriangle + 2;
             }
         }
 
@@ -281,18 +256,18 @@ namespace urchin
             //left triangles
             if (!isLeftBorderVertex)
             {
-                triangleIndices.emplace_back(firstLeftBottomTriangle);
-                triangleIndices.emplace_back(firstLeftBottomTriangle + 1);
+                triangleIndices[trianglesCount++] = firstLeftBottomTriangle;
+                triangleIndices[trianglesCount++] = firstLeftBottomTriangle + 1;
             }
 
             //right triangle
             if (!isRightBorderVertex)
             {
-                triangleIndices.emplace_back(firstLeftBottomTriangle + 2);
+                triangleIndices[trianglesCount++] = firstLeftBottomTriangle + 2;
             }
         }
 
-        return triangleIndices;
+        return trianglesCount;
     }
 
     void TerrainMesh::writeTerrainMeshFile(const std::string &filePath, const std::string &md5) const
@@ -304,7 +279,6 @@ namespace urchin
         writeMd5(file, md5);
 
         file.write(reinterpret_cast<const char*>(&vertices[0]), vertices.size()*sizeof(float)*3);
-        file.write(reinterpret_cast<const char*>(&indices[0]), indices.size()*sizeof(unsigned int));
         file.write(reinterpret_cast<const char*>(&normals[0]), normals.size()*sizeof(float)*3);
 
         file.close();
@@ -325,9 +299,6 @@ namespace urchin
         vertices.resize(computeNumberVertices());
         file.read(reinterpret_cast<char*>(&vertices[0]), vertices.size()*sizeof(float)*3);
 
-        indices.resize(computeNumberIndices());
-        file.read(reinterpret_cast<char*>(&indices[0]), indices.size()*sizeof(unsigned int));
-
         normals.resize(computeNumberNormals());
         file.read(reinterpret_cast<char*>(&normals[0]), normals.size()*sizeof(float)*3);
 
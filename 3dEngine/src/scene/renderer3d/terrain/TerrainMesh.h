@@ -2,12 +2,11 @@
 #define URCHINENGINE_TERRAINMESH_H
 
 #include <vector>
+#include <array>
 #include "UrchinCommon.h"
 
 #include "resources/image/Image.h"
 
-#define RESTART_INDEX 4294967295 //(2^32)-1
-
 namespace urchin
 {
 
@@ -24,20 +23,20 @@ namespace urchin
 
             const std::vector<Point3<float>> &getVertices() const;
             const std::vector<Vector3<float>> &getNormals() const;
-            const std::vector<unsigned int> &getIndices() const;
+            const HeightfieldChunkTree *getChunkTree() const;
 
             Point3<float> findPointAt(const Point2<float> &) const;
             float findHeightAt(const Point2<float> &) const;
+            float findHeightAt(const Point2<float> &, unsigned int) const;
+            void findTrianglesIn(const Point2<float> &, const Point2<float> &, unsigned int, std::vector<Point3<float>> &) const;
 
         private:
             unsigned int computeNumberVertices() const;
-            unsigned int computeNumberIndices() const;
             unsigned int computeNumberNormals() const;
 
-            std::vector<Point3<float>> buildVertices(const Image *);
-            std::vector<unsigned int> buildIndices();
-            std::vector<Vector3<float>> buildNormals();
-            std::vector<unsigned int> findTriangleIndices(unsigned int) const;
+            void buildVertices(const Image *);
+            void buildNormals();
+            unsigned int findTriangleIndices(unsigned int, std::array<unsigned int, 6> &) const;
 
             void writeTerrainMeshFile(const std::string &, const std::string &) const;
             void writeVersion(std::ofstream &file, unsigned int) const;
@@ -56,8 +55,8 @@ namespace urchin
 
             std::vector<Point3<float>> vertices;
             std::vector<Vector3<float>> normals;
-            std::vector<unsigned int> indices;
             std::unique_ptr<HeightfieldPointHelper<float>> heightfieldPointHelper;
+            std::unique_ptr<HeightfieldChunkTree> chunkTree;
     };
 
 }
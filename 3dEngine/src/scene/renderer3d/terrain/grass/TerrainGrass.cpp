@@ -2,10 +2,8 @@
 #include <random>
 #include <stack>
 #include <cassert>
-#include <thread>
 #include <algorithm>
-#include <functional>
-#include <mutex>
+#include <chrono>
 
 #include "TerrainGrass.h"
 #include "resources/MediaManager.h"
@@ -25,11 +23,17 @@ namespace urchin
             grassPositionRandomPercentage(ConfigService::instance()->getFloatValue("terrain.grassPositionRandomPercentage")),
             grassPatchSize(ConfigService::instance()->getFloatValue("terrain.grassPatchSize")),
             grassQuadtreeDepth(ConfigService::instance()->getUnsignedIntValue("terrain.grassQuadtreeDepth")),
+            grassStreaming(ConfigService::instance()->getBoolValue("terrain.grassStreaming")),
             sumTimeStep(0.0f),
             grassTexture(nullptr),
             grassMaskTexture(nullptr),
             mainGrassQuadtree(nullptr),
-            grassDisplayDistance(0.0f)
+            grassDisplayDistance(0.0f),
+            grassXQuantity(0),
+            grassZQuantity(0),
+            patchQuantityX(0),
+            patchQuantityZ(0),
+            streamingTaskPool(grassStreaming ? std::make_unique<TaskPool>(1) : nullptr)
     {
         std::map<std::string, std::string> tokens;
         tokens["GRASS_ALPHA_TEST"] = ConfigService::instance()->getStringValue("terrain.grassAlphaTest");
@@ -73,6 +77,7 @@ namespace urchin
 
     TerrainGrass::~TerrainGrass()
     {
+        clearStreamedPatches();
         clearVBO();
         ShaderManager::instance()->removeProgram(terrainGrassShader);
 
@@ -112,70 +117,94 @@ namespace urchin
 
     void TerrainGrass::generateGrass(const std::shared_ptr<TerrainMesh> &mesh, const Point3<float> &terrainPosition)
     {
-        const unsigned int NUM_THREADS = std::max(2u, std::thread::hardware_concurrency());
-
         if(mesh)
         {
+            clearStreamedPatches();
+
             this->mesh = mesh;
             this->terrainPosition = terrainPosition;
 
-            unsigned int seed = 0; //no need to generate different random numbers at each start
-            std::default_random_engine generator(seed);
-            std::uniform_real_distribution<float> distribution(-grassPositionRandomPercentage / grassQuantity, grassPositionRandomPercentage/grassQuantity);
+            grassXQuantity = static_cast<unsigned int>(mesh->getXZScale() * mesh->getXSize() * grassQuantity);
+            grassZQuantity = static_cast<unsigned int>(mesh->getXZScale() * mesh->getZSize() * grassQuantity);
 
-            auto grassXQuantity = static_cast<unsigned int>(mesh->getXZScale() * mesh->getXSize() * grassQuantity);
-            auto grassZQuantity = static_cast<unsigned int>(mesh->getXZScale() * mesh->getZSize() * grassQuantity);
+            patchQuantityX = std::max(1u, static_cast<unsigned int>(mesh->getXZScale() * mesh->getXSize() / grassPatchSize));
+            patchQuantityZ = std::max(1u, static_cast<unsigned int>(mesh->getXZScale() * mesh->getZSize() / grassPatchSize));
 
-            auto patchQuantityX = static_cast<unsigned int>(mesh->getXZScale() * mesh->getXSize() / grassPatchSize);
-            auto patchQuantityZ = static_cast<unsigned int>(mesh->getXZScale() * mesh->getZSize() / grassPatchSize);
-            float adjustedPatchSizeX = mesh->getXZScale() * mesh->getXSize() / patchQuantityX;
-            float adjustedPatchSizeZ = mesh->getXZScale() * mesh->getZSize() / patchQuantityZ;
+            if(grassStreaming)
+            { //patches generated on display around the camera
+                return;
+            }
 
-            std::vector<TerrainGrassQuadtree *> leafGrassPatches;
-            leafGrassPatches.reserve(patchQuantityX * patchQuantityZ);
-            for (unsigned int i = 0; i < patchQuantityX * patchQuantityZ; ++i)
+            std::vector<TerrainGrassQuadtree *> leafGrassPatches(patchQuantityX * patchQuantityZ, nullptr);
+            JobService::instance()->run(patchQuantityX * patchQuantityZ, [&](unsigned int patchIndex)
             {
-                leafGrassPatches.push_back(new TerrainGrassQuadtree());
-            }
+                std::vector<Point3<float>> grassVertices;
+                std::vector<Vector3<float>> grassNormals;
+                generatePatch(patchIndex, grassVertices, grassNormals);
+
+                if(!grassVertices.empty())
+                { //patch not fully discarded by the mask
+                    auto *leafGrassPatch = new TerrainGrassQuadtree();
+                    for(unsigned int i=0; i<grassVertices.size(); ++i)
+                    {
+                        leafGrassPatch->addVertex(grassVertices[i], grassNormals[i]);
+                    }
+                    leafGrassPatch->getBox(); //compute the box in the job
 
-            float startX = mesh->getVertices()[0].X;
-            float startZ = mesh->getVertices()[0].Z;
+                    leafGrassPatches[patchIndex] = leafGrassPatch;
+                }
+            });
 
-            std::vector<std::thread> threads(NUM_THREADS);
-            for(unsigned int threadI=0; threadI<NUM_THREADS; threadI++)
-            {
-                unsigned int beginX = threadI * grassXQuantity / NUM_THREADS;
-                unsigned int endX = (threadI + 1) == NUM_THREADS ? grassXQuantity : (threadI + 1) * grassXQuantity / NUM_THREADS;
+            buildGrassQuadtree(leafGrassPatches, patchQuantityX, patchQuantityZ);
 
-                threads[threadI] = std::thread(std::bind([&](unsigned int beginX, unsigned int endX)
-                {
-                    for (unsigned int xIndex = beginX; xIndex < endX; ++xIndex)
-                    {
-                        const float xFixedValue = startX + xIndex / grassQuantity;
+            leafGrassPatches.erase(std::remove(leafGrassPatches.begin(), leafGrassPatches.end(), nullptr), leafGrassPatches.end());
+            createVBO(leafGrassPatches);
+        }
+    }
 
-                        for (unsigned int zIndex = 0; zIndex < grassZQuantity; ++zIndex)
-                        {
-                            float xValue = xFixedValue + distribution(generator);
-                            float zValue = (startZ + zIndex / grassQuantity) + distribution(generator);
-                            unsigned int vertexIndex = retrieveVertexIndex(Point2<float>(xValue, zValue));
-                            float yValue = (mesh->getVertices()[vertexIndex] + terrainPosition).Y;
+    /**
+     * Generate the grass of a patch. Each patch has its own random generator: same grass is produced whatever the generation order
+     * of the patches and whatever the thread generating it.
+     * @param grassVertices [out] Global position of the grass
+     * @param grassNormals [out] Normal of the grass encoded in [0, 1]
+     */
+    void TerrainGrass::generatePatch(unsigned int patchIndex, std::vector<Point3<float>> &grassVertices, std::vector<Vector3<float>> &grassNormals) const
+    {
+        grassVertices.clear();
+        grassNormals.clear();
 
-                            Point3<float> globalGrassVertex(xValue + terrainPosition.X, yValue, zValue + terrainPosition.Z);
-                            Vector3<float> grassNormal = (mesh->getNormals()[vertexIndex] / 2.0f) + Vector3<float>(0.5f, 0.5f, 0.5f);
+        unsigned int patchXIndex = patchIndex % patchQuantityX;
+        unsigned int patchZIndex = patchIndex / patchQuantityX;
+        unsigned int beginX = patchXIndex * grassXQuantity / patchQuantityX;
+        unsigned int endX = (patchXIndex + 1) * grassXQuantity / patchQuantityX;
+        unsigned int beginZ = patchZIndex * grassZQuantity / patchQuantityZ;
+        unsigned int endZ = (patchZIndex + 1) * grassZQuantity / patchQuantityZ;
 
-                            unsigned int patchXIndex = std::min(static_cast<unsigned int>((xValue - startX) / adjustedPatchSizeX), patchQuantityX);
-                            unsigned int patchZIndex = std::min(static_cast<unsigned int>((zValue - startZ) / adjustedPatchSizeZ), patchQuantityZ);
-                            unsigned int patchIndex = (patchZIndex * patchQuantityX) + patchXIndex;
+        float startX = mesh->getVertices()[0].X;
+        float startZ = mesh->getVertices()[0].Z;
 
-                            leafGrassPatches[patchIndex]->addVertex(globalGrassVertex, grassNormal);
-                        }
-                    }
-                }, beginX, endX));
-            }
-            std::for_each(threads.begin(), threads.end(), [](std::thread& x){x.join();});
+        std::default_random_engine generator(patchIndex);
+        std::uniform_real_distribution<float> distribution(-grassPositionRandomPercentage / grassQuantity, grassPositionRandomPercentage / grassQuantity);
 
-            buildGrassQuadtree(leafGrassPatches, patchQuantityX, patchQuantityZ);
-            createVBO(leafGrassPatches);
+        for (unsigned int xIndex = beginX; xIndex < endX; ++xIndex)
+        {
+            const float xFixedValue = startX + xIndex / grassQuantity;
+
+            for (unsigned int zIndex = beginZ; zIndex < endZ; ++zIndex)
+            {
+                float xValue = xFixedValue + distribution(generator);
+                float zValue = (startZ + zIndex / grassQuantity) + distribution(generator);
+                if(isDiscardedByMask(Point2<float>(xValue, zValue)))
+                {
+                    continue;
+                }
+
+                unsigned int vertexIndex = retrieveVertexIndex(Point2<float>(xValue, zValue));
+                float yValue = (mesh->getVertices()[vertexIndex] + terrainPosition).Y;
+
+                grassVertices.emplace_back(Point3<float>(xValue + terrainPosition.X, yValue, zValue + terrainPosition.Z));
+                grassNormals.emplace_back((mesh->getNormals()[vertexIndex] / 2.0f) + Vector3<float>(0.5f, 0.5f, 0.5f));
+            }
         }
     }
 
@@ -193,6 +222,45 @@ namespace urchin
         return xIndex + zIndex*mesh->getXSize();
     }
 
+    /**
+     * @return True when the grass is never displayed because of the mask. Mask texture is linearly filtered in the shader: grass is
+     * discarded when the four texels around its position discard it.
+     */
+    bool TerrainGrass::isDiscardedByMask(const Point2<float> &localXzCoordinate) const
+    {
+        if(grassMaskTexture->getChannelPrecision()!=Image::CHANNEL_8)
+        {
+            return false;
+        }
+
+        const Point3<float> &terrainMinPoint = mesh->getVertices()[0];
+        const Point3<float> &terrainMaxPoint = mesh->getVertices()[mesh->getXSize() * mesh->getZSize() - 1];
+        float s = (localXzCoordinate.X - terrainMinPoint.X) / (terrainMaxPoint.X - terrainMinPoint.X);
+        float t = (localXzCoordinate.Y - terrainMinPoint.Z) / (terrainMaxPoint.Z - terrainMinPoint.Z);
+
+        auto maskWidth = static_cast<int>(grassMaskTexture->getWidth());
+        auto maskHeight = static_cast<int>(grassMaskTexture->getHeight());
+        auto texelX = static_cast<int>(std::floor(s * maskWidth - 0.5f));
+        auto texelY = static_cast<int>(std::floor(t * maskHeight - 0.5f));
+
+        unsigned int componentsCount = grassMaskTexture->retrieveComponentsCount();
+        for(int y = texelY; y <= texelY + 1; ++y)
+        {
+            for(int x = texelX; x <= texelX + 1; ++x)
+            {
+                int texelIndex = MathAlgorithm::clamp(x, 0, maskWidth - 1) + maskWidth * MathAlgorithm::clamp(y, 0, maskHeight - 1);
+                if(grassMaskTexture->getTexels()[texelIndex * componentsCount] <= 127) //red component below 0.5: grass displayed
+                {
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
+
+    /**
+     * @param leafGrassPatches Grass patches ordered by row. Patches without grass are null.
+     */
     void TerrainGrass::buildGrassQuadtree(const std::vector<TerrainGrassQuadtree *> &leafGrassPatches, unsigned int leafQuantityX, unsigned int leafQuantityZ)
     {
         std::vector<TerrainGrassQuadtree *> childrenGrassQuadtree = leafGrassPatches;
@@ -222,9 +290,21 @@ namespace urchin
                         auto zQuadtreeIndex = static_cast<int>((depthNbQuadtreeZ/static_cast<float>(childrenNbQuadtreeZ)) * (childZ + 0.5f));
 
                         unsigned int quadtreeIndex = (zQuadtreeIndex * depthNbQuadtreeX) + xQuadtreeIndex;
-                        unsigned int childQuadtreeIndex = (childZ * childrenNbQuadtreeZ) + childX;
+                        unsigned int childQuadtreeIndex = (childZ * childrenNbQuadtreeX) + childX;
 
-                        depthGrassQuadtree[quadtreeIndex]->addChild(childrenGrassQuadtree[childQuadtreeIndex]);
+                        if(childrenGrassQuadtree[childQuadtreeIndex])
+                        {
+                            depthGrassQuadtree[quadtreeIndex]->addChild(childrenGrassQuadtree[childQuadtreeIndex]);
+                        }
+                    }
+                }
+
+                for(auto &grassQuadtree : depthGrassQuadtree)
+                {
+                    if(grassQuadtree->getChildren().empty())
+                    {
+                        delete grassQuadtree;
+                        grassQuadtree = nullptr;
                     }
                 }
 
@@ -236,6 +316,7 @@ namespace urchin
             depth--;
         }
 
+        childrenGrassQuadtree.erase(std::remove(childrenGrassQuadtree.begin(), childrenGrassQuadtree.end(), nullptr), childrenGrassQuadtree.end());
         delete mainGrassQuadtree;
         mainGrassQuadtree = new TerrainGrassQuadtree(childrenGrassQuadtree);
     }
@@ -244,6 +325,11 @@ namespace urchin
     {
         clearVBO();
 
+        if(leafGrassPatches.empty())
+        {
+            return;
+        }
+
         vertexArrayObjects.resize(leafGrassPatches.size());
         glGenVertexArrays(leafGrassPatches.size(), &vertexArrayObjects[0]);
         bufferIDs.resize(leafGrassPatches.size());
@@ -278,11 +364,130 @@ namespace urchin
 
         if(!bufferIDs.empty())
         {
-            glDeleteBuffers(bufferIDs.size(), &bufferIDs[0][0]);
+            glDeleteBuffers(bufferIDs.size() * 2, &bufferIDs[0][0]);
             bufferIDs.clear();
         }
     }
 
+    /**
+     * Create the slots of the patches streamed around the camera. Each slot has buffers able to contain the biggest patch:
+     * memory depends on the grass display distance and not on the terrain size.
+     */
+    void TerrainGrass::createStreamedPatches()
+    {
+        if(!mesh || grassXQuantity==0 || grassZQuantity==0)
+        {
+            return;
+        }
+
+        Point2<float> gridOrigin(mesh->getVertices()[0].X, mesh->getVertices()[0].Z);
+        Point2<float> patchSize(grassXQuantity / (patchQuantityX * grassQuantity), grassZQuantity / (patchQuantityZ * grassQuantity));
+        float maxPositionRandom = grassPositionRandomPercentage / grassQuantity; //grass can be outside its patch
+        streamingGrid = std::make_unique<StreamingPatchGrid>(gridOrigin, patchSize, patchQuantityX, patchQuantityZ, grassDisplayDistance + maxPositionRandom);
+
+        unsigned int patchMaxVertices = ((grassXQuantity + patchQuantityX - 1) / patchQuantityX) * ((grassZQuantity + patchQuantityZ - 1) / patchQuantityZ);
+        unsigned int slotsCount = streamingGrid->getSlotsCount();
+
+        streamedPatches.resize(slotsCount);
+        for(auto &streamedPatch : streamedPatches)
+        {
+            streamedPatch.grassVertices.reserve(patchMaxVertices);
+            streamedPatch.grassNormals.reserve(patchMaxVertices);
+            streamedPatch.verticesCount = 0;
+        }
+
+        vertexArrayObjects.resize(slotsCount);
+        glGenVertexArrays(slotsCount, &vertexArrayObjects[0]);
+        bufferIDs.resize(slotsCount);
+        glGenBuffers(slotsCount * 2, &bufferIDs[0][0]);
+
+        for(unsigned int slotIndex=0; slotIndex<slotsCount; ++slotIndex)
+        {
+            glBindVertexArray(vertexArrayObjects[slotIndex]);
+
+            glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[slotIndex][VAO_VERTEX_POSITION]);
+            glEnableVertexAttribArray(SHADER_VERTEX_POSITION);
+            glVertexAttribPointer(SHADER_VERTEX_POSITION, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glBufferData(GL_ARRAY_BUFFER, patchMaxVertices * sizeof(float) * 3, nullptr, GL_DYNAMIC_DRAW);
+
+            glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[slotIndex][VAO_NORMAL]);
+            glEnableVertexAttribArray(SHADER_NORMAL);
+            glVertexAttribPointer(SHADER_NORMAL, 3, GL_FLOAT, GL_FALSE, 0, nullptr);
+            glBufferData(GL_ARRAY_BUFFER, patchMaxVertices * sizeof(float) * 3, nullptr, GL_DYNAMIC_DRAW);
+        }
+    }
+
+    /**
+     * Upload the patches built since the last call and request the patches missing around the camera. Patches are built
+     * asynchronously: the display doesn't wait for them.
+     */
+    void TerrainGrass::updateStreamedPatches(const Point3<float> &cameraPosition)
+    {
+        for(unsigned int slotIndex=0; slotIndex<streamedPatches.size(); ++slotIndex)
+        {
+            StreamedGrassPatch &streamedPatch = streamedPatches[slotIndex];
+            if(streamedPatch.build.valid() && streamedPatch.build.wait_for(std::chrono::seconds(0))==std::future_status::ready)
+            {
+                streamedPatch.build.get();
+                streamedPatch.verticesCount = streamedPatch.grassVertices.size();
+
+                if(streamedPatch.verticesCount > 0)
+                {
+                    glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[slotIndex][VAO_VERTEX_POSITION]);
+                    glBufferSubData(GL_ARRAY_BUFFER, 0, streamedPatch.verticesCount * sizeof(float) * 3, &streamedPatch.grassVertices[0]);
+                    glBindBuffer(GL_ARRAY_BUFFER, bufferIDs[slotIndex][VAO_NORMAL]);
+                    glBufferSubData(GL_ARRAY_BUFFER, 0, streamedPatch.verticesCount * sizeof(float) * 3, &streamedPatch.grassNormals[0]);
+                }
+
+                streamingGrid->onPatchBuilt(slotIndex);
+            }
+        }
+
+        Point3<float> localCameraPosition = cameraPosition - terrainPosition;
+        streamingGrid->update(Point2<float>(localCameraPosition.X, localCameraPosition.Z), streamingRequests);
+
+        for(const auto &streamingRequest : streamingRequests)
+        {
+            unsigned int slotIndex = streamingRequest.slotIndex;
+            unsigned int patchIndex = streamingRequest.patchIndex;
+            streamedPatches[slotIndex].build = streamingTaskPool->submit([this, slotIndex, patchIndex]()
+            {
+                StreamedGrassPatch &streamedPatch = streamedPatches[slotIndex];
+                generatePatch(patchIndex, streamedPatch.grassVertices, streamedPatch.grassNormals);
+                if(!streamedPatch.grassVertices.empty())
+                {
+                    streamedPatch.box = AABBox<float>(streamedPatch.grassVertices);
+                }
+            });
+        }
+    }
+
+    /**
+     * Wait the end of the patches in build: they read the mesh, the mask and the grass properties
+     */
+    void TerrainGrass::waitStreamedPatches()
+    {
+        for(auto &streamedPatch : streamedPatches)
+        {
+            if(streamedPatch.build.valid())
+            {
+                streamedPatch.build.wait();
+            }
+        }
+    }
+
+    void TerrainGrass::clearStreamedPatches()
+    {
+        waitStreamedPatches();
+
+        if(streamingGrid)
+        {
+            streamingGrid.reset();
+            streamedPatches.clear();
+            clearVBO();
+        }
+    }
+
     const std::string &TerrainGrass::getGrassTexture() const
     {
         return grassTextureFilename;
@@ -314,6 +519,7 @@ namespace urchin
 
     void TerrainGrass::setMaskTexture(const std::string &grassMaskFilename)
     {
+        waitStreamedPatches();
         this->grassMaskFilename = grassMaskFilename;
 
         if(grassMaskTexture)
@@ -330,6 +536,8 @@ namespace urchin
             grassMaskTexture = MediaManager::instance()->getMedia<Image>(grassMaskFilename);
             grassMaskTexture->toTexture(false, false, false);
         }
+
+        generateGrass(mesh, terrainPosition); //grass discarded by the mask are not generated: generation is required
     }
 
     float TerrainGrass::getGrassDisplayDistance() const
@@ -339,6 +547,10 @@ namespace urchin
 
     void TerrainGrass::setGrassDisplayDistance(float grassDisplayDistance)
     {
+        if(grassDisplayDistance!=this->grassDisplayDistance)
+        { //number of streamed patches depends on the display distance
+            clearStreamedPatches();
+        }
         this->grassDisplayDistance = grassDisplayDistance;
 
         ShaderManager::instance()->bind(terrainGrassShader);
@@ -391,6 +603,7 @@ namespace urchin
 
     void TerrainGrass::setGrassQuantity(float grassQuantity)
     {
+        waitStreamedPatches();
         this->grassQuantity = grassQuantity;
 
         generateGrass(mesh, terrainPosition);
@@ -447,31 +660,72 @@ namespace urchin
             glUniformMatrix4fv(mViewLoc, 1, GL_FALSE, (const float *) camera->getViewMatrix());
             glUniform3fv(cameraPositionLoc, 1, (const float *)camera->getPosition());
 
-            grassQuadtrees.clear();
+            if(grassStreaming)
+            {
+                displayStreamedPatches(camera);
+            }else
+            {
+                displayGrassQuadtree(camera);
+            }
+
+            glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
+            glEnable(GL_CULL_FACE);
+        }
+    }
+
+    void TerrainGrass::displayGrassQuadtree(const Camera *camera)
+    {
+        Frustum<float> grassFrustum = camera->getFrustum().cutFrustum(grassDisplayDistance);
+
+        grassQuadtrees.clear();
+        if(mainGrassQuadtree && !mainGrassQuadtree->isLeaf())
+        { //main quadtree without children: no grass
             grassQuadtrees.push_back(mainGrassQuadtree);
+        }
 
-            for(unsigned int i=0; i<grassQuadtrees.size(); ++i)
-            {
-                const TerrainGrassQuadtree *grassQuadtree = grassQuadtrees[i];
+        for(unsigned int i=0; i<grassQuadtrees.size(); ++i)
+        {
+            const TerrainGrassQuadtree *grassQuadtree = grassQuadtrees[i];
 
-                if (camera->getFrustum().cutFrustum(grassDisplayDistance).collideWithAABBox(*grassQuadtree->getBox()))
+            if (grassFrustum.collideWithAABBox(*grassQuadtree->getBox()))
+            {
+                if (grassQuadtree->isLeaf())
                 {
-                    if (grassQuadtree->isLeaf())
-                    {
-                        glBindVertexArray(vertexArrayObjects[grassQuadtree->getVertexArrayObjectId()]);
-                        glDrawArrays(GL_POINTS, 0, grassQuadtree->getGrassVertices().size());
-                    } else
+                    glBindVertexArray(vertexArrayObjects[grassQuadtree->getVertexArrayObjectId()]);
+                    glDrawArrays(GL_POINTS, 0, grassQuadtree->getGrassVertices().size());
+                } else
+                {
+                    for (const auto *child : grassQuadtree->getChildren())
                     {
-                        for (const auto *child : grassQuadtree->getChildren())
-                        {
-                            grassQuadtrees.push_back(child);
-                        }
+                        grassQuadtrees.push_back(child);
                     }
                 }
             }
+        }
+    }
 
-            glDisable(GL_SAMPLE_ALPHA_TO_COVERAGE);
-            glEnable(GL_CULL_FACE);
+    void TerrainGrass::displayStreamedPatches(const Camera *camera)
+    {
+        if(!streamingGrid)
+        {
+            createStreamedPatches();
+            if(!streamingGrid)
+            { //no grass
+                return;
+            }
+        }
+
+        updateStreamedPatches(camera->getPosition());
+
+        Frustum<float> grassFrustum = camera->getFrustum().cutFrustum(grassDisplayDistance);
+        for(unsigned int slotIndex=0; slotIndex<streamedPatches.size(); ++slotIndex)
+        {
+            const StreamedGrassPatch &streamedPatch = streamedPatches[slotIndex];
+            if(streamingGrid->isSlotReady(slotIndex) && streamedPatch.verticesCount > 0 && grassFrustum.collideWithAABBox(streamedPatch.box))
+            {
+                glBindVertexArray(vertexArrayObjects[slotIndex]);
+                glDrawArrays(GL_POINTS, 0, streamedPatch.verticesCount);
+            }
         }
     }
 
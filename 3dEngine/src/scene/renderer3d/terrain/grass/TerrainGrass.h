@@ -3,6 +3,8 @@
 
 #include <string>
 #include <vector>
+#include <memory>
+#include <future>
 #include "UrchinCommon.h"
 
 #include "scene/renderer3d/terrain/grass/TerrainGrassQuadtree.h"
@@ -53,15 +55,35 @@ namespace urchin
             void display(const Camera *, float);
 
         private:
+            struct StreamedGrassPatch
+            {
+                std::future<void> build;
+                std::vector<Point3<float>> grassVertices;
+                std::vector<Vector3<float>> grassNormals;
+                AABBox<float> box;
+                unsigned int verticesCount;
+            };
+
             void generateGrass(const std::shared_ptr<TerrainMesh> &, const Point3<float> &);
+            void generatePatch(unsigned int, std::vector<Point3<float>> &, std::vector<Vector3<float>> &) const;
             unsigned int retrieveVertexIndex(const Point2<float> &) const;
+            bool isDiscardedByMask(const Point2<float> &) const;
             void buildGrassQuadtree(const std::vector<TerrainGrassQuadtree *> &, unsigned int, unsigned int);
             void createVBO(const std::vector<TerrainGrassQuadtree *> &);
             void clearVBO();
 
+            void createStreamedPatches();
+            void updateStreamedPatches(const Point3<float> &);
+            void waitStreamedPatches();
+            void clearStreamedPatches();
+
+            void displayGrassQuadtree(const Camera *);
+            void displayStreamedPatches(const Camera *);
+
             const float grassPositionRandomPercentage;
             const float grassPatchSize;
             const unsigned int grassQuadtreeDepth;
+            const bool grassStreaming;
 
             std::vector<unsigned int> vertexArrayObjects;
             std::vector<std::array<unsigned int, 2>> bufferIDs;
@@ -96,6 +118,13 @@ namespace urchin
             float grassDisplayDistance;
             float grassHeight, grassLength;
             float grassQuantity;
+            unsigned int grassXQuantity, grassZQuantity;
+            unsigned int patchQuantityX, patchQuantityZ;
+
+            std::unique_ptr<StreamingPatchGrid> streamingGrid;
+            std::vector<StreamedGrassPatch> streamedPatches; //by slot of the streaming grid
+            std::vector<StreamingPatchRequest> streamingRequests;
+            std::unique_ptr<TaskPool> streamingTaskPool;
 
             Vector3<float> windDirection;
             float windStrength;
@@ -2,12 +2,14 @@
 #include "UrchinCommon.h"
 
 #include "TextureManager.h"
+#include "resources/image/Image.h"
 
 namespace urchin
 {
 
 	TextureManager::TextureManager() : Singleton<TextureManager>(),
-		anisotropy(getMaxSupportedAnisotropy())
+		anisotropy(getMaxSupportedAnisotropy()),
+		compressionEnabled(ConfigService::instance()->getBoolValue("texture.compression"))
 	{
 
 	}
@@ -36,6 +38,46 @@ namespace urchin
 		return 0.0;
 	}
 
+	bool TextureManager::isCompressionEnabled() const
+	{
+		return compressionEnabled;
+	}
+
+	void TextureManager::setCompressionEnabled(bool compressionEnabled)
+	{
+		this->compressionEnabled = compressionEnabled;
+	}
+
+	/**
+	 * Loads the mipmap levels compressed in blocks of the image. Levels are baked at first loading and cached in the
+	 * save directory: following loadings read them from the cache as long as the image file is unchanged.
+	 * @return Baked texture or null when the image cannot be compressed (compression disabled or not supported, image not
+	 * loaded from a file, grayscale image)
+	 */
+	std::unique_ptr<BakedTexture> TextureManager::loadBakedTexture(const Image &image) const
+	{
+		if(!compressionEnabled || !GLEW_EXT_texture_compression_s3tc || image.getName().empty()
+				|| image.getChannelPrecision()!=Image::CHANNEL_8 || image.getImageFormat()==Image::IMAGE_GRAYSCALE)
+		{
+			return nullptr;
+		}
+
+		BlockCompressor::BlockFormat blockFormat = image.getImageFormat()==Image::IMAGE_RGBA ? BlockCompressor::BC3 : BlockCompressor::BC1;
+		std::string imageFilePath = FileSystem::instance()->getResourcesDirectory() + image.getName();
+		std::string frlFilePath = FrlFileReader::buildFrlFilePath(image.getName());
+		std::string md5Sum = std::string(MD5().digestFile(imageFilePath.c_str()));
+
+		TextureBaker textureBaker;
+		std::unique_ptr<BakedTexture> bakedTexture = textureBaker.loadBakedTexture(frlFilePath, md5Sum, blockFormat);
+		if(!bakedTexture)
+		{
+			bakedTexture = textureBaker.bake(blockFormat, image.getWidth(), image.getHeight(), image.retrieveComponentsCount(), image.getTexels());
+			textureBaker.writeBakedTexture(frlFilePath, md5Sum, *bakedTexture);
+		}
+
+		return bakedTexture;
+	}
+
 	void TextureManager::clampToMaxAnisotropy()
 	{
 		if(anisotropy > getMaxSupportedAnisotropy())
@@ -2,11 +2,14 @@
 #define URCHINENGINE_TEXTUREMANAGER_H
 
 #include <list>
+#include <memory>
 #include "UrchinCommon.h"
 
 namespace urchin
 {
 
+	class Image;
+
 	/**
 	* A texture manager global to all renderer
 	*/
@@ -18,6 +21,10 @@ namespace urchin
 			float getAnisotropy() const;
 			void setAnisotropy(float);
 			float getMaxSupportedAnisotropy() const;
+
+			bool isCompressionEnabled() const;
+			void setCompressionEnabled(bool);
+			std::unique_ptr<BakedTexture> loadBakedTexture(const Image &) const;
 		
 		private:
 			TextureManager();
@@ -26,6 +33,7 @@ namespace urchin
 			void clampToMaxAnisotropy();
 
 			float anisotropy;
+			bool compressionEnabled;
 	};
 
 }
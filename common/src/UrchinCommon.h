@@ -15,13 +15,34 @@
 #include "tools/svg/shape/SVGLine.h"
 #include "tools/svg/shape/SVGCircle.h"
 #include "tools/ConfigService.h"
+#include "tools/ConfigKey.h"
+#include "tools/file/MemoryMappedFile.h"
+#include "tools/file/FrlFileReader.h"
+#include "tools/file/FrlFileWriter.h"
+#include "tools/image/MipMapGenerator.h"
+#include "tools/image/BlockCompressor.h"
+#include "tools/image/BakedTexture.h"
+#include "tools/image/TextureBaker.h"
+#include "tools/render/DrawListBuilder.h"
+#include "tools/render/GlyphRunCache.h"
+#include "tools/render/LightClusterBuilder.h"
+#include "tools/render/MeshSkinning.h"
+#include "tools/render/StreamingPatchGrid.h"
+#include "tools/render/TextBatch.h"
+#include "tools/resource/ResourceCache.h"
 #include "tools/xml/XmlParser.h"
+#include "tools/xml/XmlStreamParser.h"
 #include "tools/xml/XmlWriter.h"
 #include "tools/xml/XmlAttribute.h"
 #include "tools/xml/XmlChunk.h"
+#include "tools/xml/XmlBinaryDocument.h"
+#include "tools/xml/XmlBinaryConverter.h"
 #include "tools/vector/VectorEraser.h"
+#include "tools/thread/JobPool.h"
+#include "tools/thread/JobService.h"
 #include "tools/thread/LockById.h"
 #include "tools/thread/ScopeLockById.h"
+#include "tools/thread/TaskPool.h"
 
 #include "pattern/observer/Observable.h"
 #include "pattern/observer/Observer.h"
@@ -45,6 +66,7 @@
 #include "math/algebra/vector/Vector3.h"
 #include "math/algebra/vector/Vector4.h"
 #include "math/algebra/Quaternion.h"
+#include "math/algebra/QuantizedQuaternion.h"
 #include "math/algebra/Transform.h"
 #include "math/algebra/MathValue.h"
 #include "math/geometry/2d/Line2D.h"
@@ -70,6 +92,7 @@
 #include "math/geometry/3d/shape/ConeShape.h"
 #include "math/geometry/3d/object/ConvexObject3D.h"
 #include "math/geometry/3d/object/AABBox.h"
+#include "math/geometry/3d/object/AABBoxArray.h"
 #include "math/geometry/3d/object/ConvexHull3D.h"
 #include "math/geometry/3d/object/Frustum.h"
 #include "math/geometry/3d/object/LineSegment3D.h"
@@ -83,6 +106,9 @@
 #include "math/geometry/3d/util/SortPointsService.h"
 #include "math/geometry/3d/util/ResizeConvexHull3DService.h"
 #include "math/geometry/3d/util/HeightfieldPointHelper.h"
+#include "math/geometry/3d/util/OcclusionBuffer.h"
+#include "math/geometry/3d/util/MeshSimplifier.h"
+#include "math/geometry/3d/util/HeightfieldChunkTree.h"
 #include "math/algorithm/MathAlgorithm.h"
 #include "math/algorithm/PascalTriangle.h"
 #include "math/trigonometry/AngleConverter.h"
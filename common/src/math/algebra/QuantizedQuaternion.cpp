@@ -0,0 +1,79 @@
+#include <cmath>
+#include <algorithm>
+
+#include "math/algebra/QuantizedQuaternion.h"
+#include "math/algorithm/MathAlgorithm.h"
+
+namespace urchin
+{
+
+	template<class T> constexpr unsigned int QuantizedQuaternion<T>::QUANTIZATION_MAX;
+
+	/**
+	* Construct an identity quaternion
+	*/
+	template<class T> QuantizedQuaternion<T>::QuantizedQuaternion() :
+		QuantizedQuaternion(Quaternion<T>())
+	{
+
+	}
+
+	/**
+	* @param quaternion Normalized quaternion to quantize
+	*/
+	template<class T> QuantizedQuaternion<T>::QuantizedQuaternion(const Quaternion<T> &quaternion)
+	{
+		const T values[4] = {quaternion.X, quaternion.Y, quaternion.Z, quaternion.W};
+
+		unsigned int largestIndex = 0;
+		for(unsigned int i=1; i<4; ++i)
+		{
+			if(std::abs(values[i]) > std::abs(values[largestIndex]))
+			{
+				largestIndex = i;
+			}
+		}
+
+		//quaternions q and -q represent the same rotation: the dropped component is always positive
+		const T sign = values[largestIndex] < 0.0 ? -1.0 : 1.0;
+		const T range = 1.0 / std::sqrt((T)2.0);
+
+		for(unsigned int i=0, componentIndex=0; i<4; ++i)
+		{
+			if(i!=largestIndex)
+			{
+				T normalizedValue = MathAlgorithm::clamp((values[i] * sign + range) / ((T)2.0 * range), (T)0.0, (T)1.0);
+				components[componentIndex++] = static_cast<unsigned short>(std::lround(normalizedValue * QUANTIZATION_MAX));
+			}
+		}
+
+		components[0] |= static_cast<unsigned short>((largestIndex & 2u) << 14u);
+		components[1] |= static_cast<unsigned short>((largestIndex & 1u) << 15u);
+	}
+
+	template<class T> Quaternion<T> QuantizedQuaternion<T>::toQuaternion() const
+	{
+		const unsigned int largestIndex = ((components[0] >> 14u) & 2u) | ((components[1] >> 15u) & 1u);
+		constexpr T range = 0.70710678118654752440; //1 / sqrt(2)
+		constexpr T scale = (2.0 * range) / (T)QUANTIZATION_MAX;
+
+		T values[4];
+		T squareSum = 0.0;
+		for(unsigned int i=0, componentIndex=0; i<4; ++i)
+		{
+			if(i!=largestIndex)
+			{
+				values[i] = (T)(components[componentIndex++] & QUANTIZATION_MAX) * scale - range;
+				squareSum += values[i] * values[i];
+			}
+		}
+		values[largestIndex] = std::sqrt(std::max((T)0.0, (T)1.0 - squareSum));
+
+		return Quaternion<T>(values[0], values[1], values[2], values[3]);
+	}
+
+	//explicit template
+	template class QuantizedQuaternion<float>;
+	template class QuantizedQuaternion<double>;
+
+}
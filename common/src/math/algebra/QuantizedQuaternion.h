@@ -0,0 +1,30 @@
+#ifndef URCHINENGINE_QUANTIZEDQUATERNION_H
+#define URCHINENGINE_QUANTIZEDQUATERNION_H
+
+#include "math/algebra/Quaternion.h"
+
+namespace urchin
+{
+
+	/**
+	* Unit quaternion stored on 6 bytes with the "smallest three" encoding: the largest component is dropped (it can be
+	* recomputed from the three others) and the three others, included in [-1/sqrt(2), 1/sqrt(2)], are quantized on 15 bits.
+	* The index of the dropped component is stored in the unused bits.
+	*/
+	template<class T> class QuantizedQuaternion
+	{
+		public:
+			QuantizedQuaternion();
+			explicit QuantizedQuaternion(const Quaternion<T> &);
+
+			Quaternion<T> toQuaternion() const;
+
+		private:
+			static constexpr unsigned int QUANTIZATION_MAX = 0x7FFF;
+
+			unsigned short components[3];
+	};
+
+}
+
+#endif
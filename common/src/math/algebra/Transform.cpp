@@ -3,7 +3,8 @@
 namespace urchin
 {
 	
-	template<class T> Transform<T>::Transform()
+	template<class T> Transform<T>::Transform() :
+		dirtyMatrices(0)
 	{
 		pPosition.setNull();
 		qOrientation.setIdentity();
@@ -15,20 +16,17 @@ namespace urchin
 	template<class T> Transform<T>::Transform(const Point3<T> &position, const Quaternion<T> &orientation, T scale) :
 		pPosition(position),
 		qOrientation(orientation),
-		fScale(scale)
+		fScale(scale),
+		dirtyMatrices(ALL_MATRICES)
 	{
-		mPosition.buildTranslation(pPosition.X, pPosition.Y, pPosition.Z);
-		mOrientation = qOrientation.toMatrix4();
-		mScale.buildScale(fScale, fScale, fScale);
-		mTransform = mPosition * mScale * mOrientation;
+
 	}
 
 	template<class T> void Transform<T>::setPosition(const Point3<T> &position)
 	{
 		pPosition = position;
 
-		mPosition.buildTranslation(pPosition.X, pPosition.Y, pPosition.Z);
-		mTransform = mPosition * mScale * mOrientation;
+		dirtyMatrices |= POSITION_MATRIX | TRANSFORM_TRANSLATION;
 	}
 
 	template<class T> const Point3<T> &Transform<T>::getPosition() const
@@ -40,8 +38,7 @@ namespace urchin
 	{
 		qOrientation = orientation;
 
-		mOrientation = qOrientation.toMatrix4();
-		mTransform =  mPosition * mScale * mOrientation;
+		dirtyMatrices |= ORIENTATION_MATRIX | TRANSFORM_LINEAR_PART;
 	}
 
 	template<class T> const Quaternion<T> &Transform<T>::getOrientation() const
@@ -53,8 +50,7 @@ namespace urchin
 	{
 		fScale = scale;
 
-		mScale.buildScale(fScale, fScale, fScale);
-		mTransform = mPosition * mScale * mOrientation;
+		dirtyMatrices |= SCALE_MATRIX | TRANSFORM_LINEAR_PART;
 	}
 
 	template<class T> T Transform<T>::getScale() const
@@ -64,27 +60,84 @@ namespace urchin
 
 	template<class T> const Matrix4<T> &Transform<T>::getPositionMatrix() const
 	{
+		if(dirtyMatrices & POSITION_MATRIX)
+		{
+			mPosition.buildTranslation(pPosition.X, pPosition.Y, pPosition.Z);
+			dirtyMatrices &= ~POSITION_MATRIX;
+		}
+
 		return mPosition;
 	}
 
 	template<class T> const Matrix4<T> &Transform<T>::getOrientationMatrix() const
 	{
+		if(dirtyMatrices & ORIENTATION_MATRIX)
+		{
+			mOrientation = qOrientation.toMatrix4();
+			dirtyMatrices &= ~ORIENTATION_MATRIX;
+		}
+
 		return mOrientation;
 	}
 
 	template<class T> const Matrix4<T> &Transform<T>::getScaleMatrix() const
 	{
+		if(dirtyMatrices & SCALE_MATRIX)
+		{
+			mScale.buildScale(fScale, fScale, fScale);
+			dirtyMatrices &= ~SCALE_MATRIX;
+		}
+
 		return mScale;
 	}
 
+	/**
+	* @return Transform matrix equals to: position matrix * scale matrix * orientation matrix. The matrix is an affine matrix:
+	* the upper left 3x3 part (orientation and scale) and the translation column are rebuilt independently.
+	*/
 	template<class T> const Matrix4<T> &Transform<T>::getTransformMatrix() const
 	{
+		if(dirtyMatrices & TRANSFORM_LINEAR_PART)
+		{
+			Matrix3<T> orientationMatrix = qOrientation.toMatrix3();
+			mTransform.a11 = orientationMatrix.a11 * fScale; mTransform.a12 = orientationMatrix.a12 * fScale; mTransform.a13 = orientationMatrix.a13 * fScale;
+			mTransform.a21 = orientationMatrix.a21 * fScale; mTransform.a22 = orientationMatrix.a22 * fScale; mTransform.a23 = orientationMatrix.a23 * fScale;
+			mTransform.a31 = orientationMatrix.a31 * fScale; mTransform.a32 = orientationMatrix.a32 * fScale; mTransform.a33 = orientationMatrix.a33 * fScale;
+			mTransform.a41 = 0.0; mTransform.a42 = 0.0; mTransform.a43 = 0.0; mTransform.a44 = 1.0;
+
+			dirtyMatrices &= ~TRANSFORM_LINEAR_PART;
+		}
+
+		if(dirtyMatrices & TRANSFORM_TRANSLATION)
+		{
+			mTransform.a14 = pPosition.X;
+			mTransform.a24 = pPosition.Y;
+			mTransform.a34 = pPosition.Z;
+
+			dirtyMatrices &= ~TRANSFORM_TRANSLATION;
+		}
+
 		return mTransform;
 	}
 
+	/**
+	* @return Inverse transform computed from the orientation, position and scale (no matrix inversion)
+	*/
+	template<class T> Transform<T> Transform<T>::inverse() const
+	{
+		Quaternion<T> inverseOrientation = qOrientation.conjugate();
+		T inverseScale = (T)1.0 / fScale;
+		Point3<T> inversePosition = inverseOrientation.rotatePoint(-pPosition) * inverseScale;
+
+		return Transform<T>(inversePosition, inverseOrientation, inverseScale);
+	}
+
+	/**
+	* @return Composed transform which is equivalent to the product of both transform matrices (no matrix multiplication)
+	*/
 	template<class T> Transform<T> Transform<T>::operator *(const Transform<T> &transform) const
 	{
-		return Transform<T>(pPosition + qOrientation.rotatePoint(transform.getPosition()),
+		return Transform<T>(pPosition + qOrientation.rotatePoint(transform.getPosition()) * fScale,
 						 qOrientation * transform.getOrientation(),
 						 fScale * transform.getScale());
 	}
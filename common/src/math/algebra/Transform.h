@@ -9,7 +9,8 @@ namespace urchin
 {
 	
 	/**
-	* Class allow to create transform matrix from a given position, orientation and scale
+	* Class allow to create transform matrix from a given position, orientation and scale.
+	* Matrices are computed lazily: a modification only marks them as dirty and they are rebuilt on first access.
 	*/
 	template<class T> class Transform
 	{
@@ -31,15 +32,28 @@ namespace urchin
 			const Matrix4<T> &getScaleMatrix() const;
 			const Matrix4<T> &getTransformMatrix() const;
 
+			Transform<T> inverse() const;
+
 			Transform<T> operator *(const Transform<T> &) const;
 			const Transform<T>& operator *=(const Transform<T> &);
 		
 		private:
+			enum DirtyMatrix
+			{
+				POSITION_MATRIX = 1,
+				ORIENTATION_MATRIX = 2,
+				SCALE_MATRIX = 4,
+				TRANSFORM_TRANSLATION = 8,
+				TRANSFORM_LINEAR_PART = 16,
+				ALL_MATRICES = POSITION_MATRIX | ORIENTATION_MATRIX | SCALE_MATRIX | TRANSFORM_TRANSLATION | TRANSFORM_LINEAR_PART
+			};
+
 			Point3<T> pPosition;
 			Quaternion<T> qOrientation;
 			T fScale;
 
-			Matrix4<T> mPosition, mOrientation, mScale, mTransform;
+			mutable Matrix4<T> mPosition, mOrientation, mScale, mTransform;
+			mutable unsigned int dirtyMatrices;
 	};
 
 }
@@ -2,6 +2,7 @@
 #include <limits>
 
 #include "AABBox.h"
+#include "math/geometry/3d/object/AABBoxArray.h"
 
 namespace urchin
 {
@@ -306,6 +307,14 @@ namespace urchin
 		return lengthToMinPlane < ray.getLength() && lengthToMaxPlane > 0.0;
 	}
 
+	/**
+	* @param collideIndices [out] Indices of the bounding boxes which collide or are inside this bounding box
+	*/
+	template<class T> void AABBox<T>::collideWithAABBoxes(const AABBoxArray<T> &aabboxes, std::vector<unsigned int> &collideIndices) const
+	{
+		aabboxes.collideWithAABBox(*this, collideIndices);
+	}
+
 	/**
 	 * Allow to access to min and max value as an array (const).
 	 */
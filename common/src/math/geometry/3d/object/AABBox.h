@@ -54,6 +54,7 @@ namespace urchin
 			bool collideWithPoint(const Point3<T> &) const;
 			bool collideWithAABBox(const AABBox<T> &) const;
 			bool collideWithRay(const Ray<T> &) const;
+			void collideWithAABBoxes(const AABBoxArray<T> &, std::vector<unsigned int> &) const override;
 
 			const Point3<T>& operator [](std::size_t) const;
 			Point3<T>& operator [](std::size_t);
@@ -0,0 +1,283 @@
+#include <algorithm>
+#include <cmath>
+
+#include "AABBoxArray.h"
+
+namespace urchin
+{
+
+	template<class T> constexpr unsigned int AABBoxArray<T>::BATCH_SIZE;
+
+	template<class T> AABBoxArray<T>::AABBoxArray(const std::vector<AABBox<T>> &aabboxes)
+	{
+		reserve(aabboxes.size());
+		for(const auto &aabbox : aabboxes)
+		{
+			addAABBox(aabbox);
+		}
+	}
+
+	template<class T> void AABBoxArray<T>::reserve(unsigned int size)
+	{
+		minX.reserve(size);
+		minY.reserve(size);
+		minZ.reserve(size);
+		maxX.reserve(size);
+		maxY.reserve(size);
+		maxZ.reserve(size);
+	}
+
+	template<class T> void AABBoxArray<T>::clear()
+	{
+		minX.clear();
+		minY.clear();
+		minZ.clear();
+		maxX.clear();
+		maxY.clear();
+		maxZ.clear();
+	}
+
+	/**
+	* @return Index of the added bounding box
+	*/
+	template<class T> unsigned int AABBoxArray<T>::addAABBox(const AABBox<T> &aabbox)
+	{
+		minX.push_back(aabbox.getMin().X);
+		minY.push_back(aabbox.getMin().Y);
+		minZ.push_back(aabbox.getMin().Z);
+		maxX.push_back(aabbox.getMax().X);
+		maxY.push_back(aabbox.getMax().Y);
+		maxZ.push_back(aabbox.getMax().Z);
+
+		return getSize() - 1;
+	}
+
+	template<class T> void AABBoxArray<T>::setAABBox(unsigned int index, const AABBox<T> &aabbox)
+	{
+		minX[index] = aabbox.getMin().X;
+		minY[index] = aabbox.getMin().Y;
+		minZ[index] = aabbox.getMin().Z;
+		maxX[index] = aabbox.getMax().X;
+		maxY[index] = aabbox.getMax().Y;
+		maxZ[index] = aabbox.getMax().Z;
+	}
+
+	template<class T> unsigned int AABBoxArray<T>::getSize() const
+	{
+		return minX.size();
+	}
+
+	template<class T> bool AABBoxArray<T>::isEmpty() const
+	{
+		return minX.empty();
+	}
+
+	template<class T> AABBox<T> AABBoxArray<T>::getAABBox(unsigned int index) const
+	{
+		return AABBox<T>(Point3<T>(minX[index], minY[index], minZ[index]), Point3<T>(maxX[index], maxY[index], maxZ[index]));
+	}
+
+	/**
+	* Bounding boxes in the negative side of all planes (or intersecting them) are considered as colliding.
+	* This test is the batch version of Frustum::collideWithAABBox.
+	* @param collideIndices [out] Indices of the colliding bounding boxes (appended in ascending order)
+	*/
+	template<class T> void AABBoxArray<T>::collideWithPlanes(const Plane<T> *planes, unsigned int nbPlanes, std::vector<unsigned int> &collideIndices) const
+	{
+		unsigned int collide[BATCH_SIZE];
+
+		for(unsigned int batchStart=0; batchStart<getSize(); batchStart+=BATCH_SIZE)
+		{
+			unsigned int batchCount = std::min(BATCH_SIZE, getSize() - batchStart);
+			std::fill(collide, collide + batchCount, 1);
+
+			for(unsigned int planeIndex=0; planeIndex<nbPlanes; ++planeIndex)
+			{
+				const Vector3<T> &normal = planes[planeIndex].getNormal();
+				T d = planes[planeIndex].getDistanceToOrigin();
+
+				//the nearest box vertex in the normal direction only depends on the plane: choose it once for all boxes
+				const T *nVertexX = (normal.X >= 0.0 ? minX.data() : maxX.data()) + batchStart;
+				const T *nVertexY = (normal.Y >= 0.0 ? minY.data() : maxY.data()) + batchStart;
+				const T *nVertexZ = (normal.Z >= 0.0 ? minZ.data() : maxZ.data()) + batchStart;
+
+				for(unsigned int i=0; i<batchCount; ++i)
+				{
+					T distance = normal.X*nVertexX[i] + normal.Y*nVertexY[i] + normal.Z*nVertexZ[i] + d;
+					collide[i] &= (unsigned int)(distance <= 0.0);
+				}
+			}
+
+			for(unsigned int i=0; i<batchCount; ++i)
+			{
+				if(collide[i])
+				{
+					collideIndices.push_back(batchStart + i);
+				}
+			}
+		}
+	}
+
+	/**
+	* This test is the batch version of AABBox::collideWithAABBox.
+	* @param collideIndices [out] Indices of the colliding bounding boxes (appended in ascending order)
+	*/
+	template<class T> void AABBoxArray<T>::collideWithAABBox(const AABBox<T> &aabbox, std::vector<unsigned int> &collideIndices) const
+	{
+		unsigned int collide[BATCH_SIZE];
+		const Point3<T> &min = aabbox.getMin();
+		const Point3<T> &max = aabbox.getMax();
+
+		for(unsigned int batchStart=0; batchStart<getSize(); batchStart+=BATCH_SIZE)
+		{
+			unsigned int batchCount = std::min(BATCH_SIZE, getSize() - batchStart);
+
+			for(unsigned int i=0, j=batchStart; i<batchCount; ++i, ++j)
+			{
+				collide[i] = (unsigned int)(min.X < maxX[j]) & (unsigned int)(max.X > minX[j])
+						& (unsigned int)(min.Y < maxY[j]) & (unsigned int)(max.Y > minY[j])
+						& (unsigned int)(min.Z < maxZ[j]) & (unsigned int)(max.Z > minZ[j]);
+			}
+
+			for(unsigned int i=0; i<batchCount; ++i)
+			{
+				if(collide[i])
+				{
+					collideIndices.push_back(batchStart + i);
+				}
+			}
+		}
+	}
+
+	/**
+	* This test is the batch version of OBBox::collideWithAABBox (separating axis theorem).
+	* @param collideIndices [out] Indices of the colliding bounding boxes (appended in ascending order)
+	*/
+	template<class T> void AABBoxArray<T>::collideWithOBBox(const OBBox<T> &obbox, std::vector<unsigned int> &collideIndices) const
+	{
+		unsigned int collide[BATCH_SIZE];
+		const Point3<T> &center = obbox.getCenterOfMass();
+		const Vector3<T> &halfSizes = obbox.getHalfSizes();
+		constexpr T epsilon = (T)0.00001; //projection axis could be near to zero: need epsilon to avoid rounding error
+
+		//axes of bounding boxes are world axes: dot products between axes are the components of the oriented box axes
+		T axis[3][3], absAxis[3][3];
+		for(unsigned int r=0; r<3; ++r)
+		{
+			for(unsigned int c=0; c<3; ++c)
+			{
+				axis[r][c] = obbox.getAxis(r)[c];
+				absAxis[r][c] = std::abs(axis[r][c]);
+			}
+		}
+
+		//projection of the oriented box on world axes doesn't depend on the bounding boxes
+		T obboxExtent[3];
+		for(unsigned int c=0; c<3; ++c)
+		{
+			obboxExtent[c] = halfSizes[0]*absAxis[0][c] + halfSizes[1]*absAxis[1][c] + halfSizes[2]*absAxis[2][c];
+		}
+
+		for(unsigned int batchStart=0; batchStart<getSize(); batchStart+=BATCH_SIZE)
+		{
+			unsigned int batchCount = std::min(BATCH_SIZE, getSize() - batchStart);
+
+			for(unsigned int i=0, j=batchStart; i<batchCount; ++i, ++j)
+			{
+				const T boxHalfSizes[3] = {(maxX[j] - minX[j]) * (T)0.5, (maxY[j] - minY[j]) * (T)0.5, (maxZ[j] - minZ[j]) * (T)0.5};
+				const T distCenter[3] = {(minX[j] + maxX[j]) * (T)0.5 - center.X, (minY[j] + maxY[j]) * (T)0.5 - center.Y, (minZ[j] + maxZ[j]) * (T)0.5 - center.Z};
+				unsigned int noSeparatingAxis = 1;
+
+				//projection axis: oriented box axes
+				for(unsigned int r=0; r<3; ++r)
+				{
+					T distance = distCenter[0]*axis[r][0] + distCenter[1]*axis[r][1] + distCenter[2]*axis[r][2];
+					T radius = halfSizes[r] + boxHalfSizes[0]*absAxis[r][0] + boxHalfSizes[1]*absAxis[r][1] + boxHalfSizes[2]*absAxis[r][2];
+					noSeparatingAxis &= (unsigned int)(std::abs(distance) <= radius);
+				}
+
+				//projection axis: world axes
+				for(unsigned int c=0; c<3; ++c)
+				{
+					noSeparatingAxis &= (unsigned int)(std::abs(distCenter[c]) <= obboxExtent[c] + boxHalfSizes[c]);
+				}
+
+				//projection axis: cross product of oriented box axis 'r' with world axis 'c'
+				for(unsigned int r=0; r<3; ++r)
+				{
+					unsigned int r1 = (r + 1) % 3, r2 = (r + 2) % 3;
+					for(unsigned int c=0; c<3; ++c)
+					{
+						unsigned int c1 = (c + 1) % 3, c2 = (c + 2) % 3;
+						T distance = distCenter[c1]*axis[r][c2] - distCenter[c2]*axis[r][c1];
+						T radius = halfSizes[r1]*absAxis[r2][c] + halfSizes[r2]*absAxis[r1][c] + boxHalfSizes[c1]*absAxis[r][c2] + boxHalfSizes[c2]*absAxis[r][c1];
+						noSeparatingAxis &= (unsigned int)(std::abs(distance) - epsilon <= radius);
+					}
+				}
+
+				collide[i] = noSeparatingAxis;
+			}
+
+			for(unsigned int i=0; i<batchCount; ++i)
+			{
+				if(collide[i])
+				{
+					collideIndices.push_back(batchStart + i);
+				}
+			}
+		}
+	}
+
+	/**
+	* This test is the batch version of AABBox::collideWithRay.
+	* @param collideIndices [out] Indices of the bounding boxes which are inside or partially inside the ray (appended in ascending order)
+	*/
+	template<class T> void AABBoxArray<T>::collideWithRay(const Ray<T> &ray, std::vector<unsigned int> &collideIndices) const
+	{
+		unsigned int collide[BATCH_SIZE];
+		const Point3<T> &origin = ray.getOrigin();
+		const Vector3<T> &inverseDirection = ray.getInverseDirection();
+		T rayLength = ray.getLength();
+
+		for(unsigned int batchStart=0; batchStart<getSize(); batchStart+=BATCH_SIZE)
+		{
+			unsigned int batchCount = std::min(BATCH_SIZE, getSize() - batchStart);
+
+			//entry and exit planes only depend on the ray direction signs: choose them once for all boxes
+			const T *entryX = (ray.getDirectionSign(0)==0 ? minX.data() : maxX.data()) + batchStart;
+			const T *exitX = (ray.getDirectionSign(0)==0 ? maxX.data() : minX.data()) + batchStart;
+			const T *entryY = (ray.getDirectionSign(1)==0 ? minY.data() : maxY.data()) + batchStart;
+			const T *exitY = (ray.getDirectionSign(1)==0 ? maxY.data() : minY.data()) + batchStart;
+			const T *entryZ = (ray.getDirectionSign(2)==0 ? minZ.data() : maxZ.data()) + batchStart;
+			const T *exitZ = (ray.getDirectionSign(2)==0 ? maxZ.data() : minZ.data()) + batchStart;
+
+			for(unsigned int i=0; i<batchCount; ++i)
+			{
+				T lengthToEntryPlane = std::max(std::max(
+						(entryX[i] - origin.X) * inverseDirection.X,
+						(entryY[i] - origin.Y) * inverseDirection.Y),
+						(entryZ[i] - origin.Z) * inverseDirection.Z);
+				T lengthToExitPlane = std::min(std::min(
+						(exitX[i] - origin.X) * inverseDirection.X,
+						(exitY[i] - origin.Y) * inverseDirection.Y),
+						(exitZ[i] - origin.Z) * inverseDirection.Z);
+
+				collide[i] = (unsigned int)(lengthToEntryPlane <= lengthToExitPlane)
+						& (unsigned int)(lengthToEntryPlane < rayLength) & (unsigned int)(lengthToExitPlane > 0.0);
+			}
+
+			for(unsigned int i=0; i<batchCount; ++i)
+			{
+				if(collide[i])
+				{
+					collideIndices.push_back(batchStart + i);
+				}
+			}
+		}
+	}
+
+	//explicit template
+	template class AABBoxArray<float>;
+	template class AABBoxArray<double>;
+
+}
@@ -0,0 +1,47 @@
+#ifndef URCHINENGINE_AABBOXARRAY_H
+#define URCHINENGINE_AABBOXARRAY_H
+
+#include <vector>
+
+#include "math/geometry/3d/object/AABBox.h"
+#include "math/geometry/3d/object/OBBox.h"
+#include "math/geometry/3d/Plane.h"
+#include "math/geometry/3d/Ray.h"
+
+namespace urchin
+{
+
+	/**
+	* Array of axis aligned bounding boxes stored in a structure of arrays (SoA) layout.
+	* Collision methods test all the boxes in one pass: loops are branch free in order to be vectorized by the compiler.
+	*/
+	template<class T> class AABBoxArray
+	{
+		public:
+			AABBoxArray() = default;
+			explicit AABBoxArray(const std::vector<AABBox<T>> &);
+
+			void reserve(unsigned int);
+			void clear();
+			unsigned int addAABBox(const AABBox<T> &);
+			void setAABBox(unsigned int, const AABBox<T> &);
+
+			unsigned int getSize() const;
+			bool isEmpty() const;
+			AABBox<T> getAABBox(unsigned int) const;
+
+			void collideWithPlanes(const Plane<T> *, unsigned int, std::vector<unsigned int> &) const;
+			void collideWithAABBox(const AABBox<T> &, std::vector<unsigned int> &) const;
+			void collideWithOBBox(const OBBox<T> &, std::vector<unsigned int> &) const;
+			void collideWithRay(const Ray<T> &, std::vector<unsigned int> &) const;
+
+		private:
+			static constexpr unsigned int BATCH_SIZE = 64;
+
+			std::vector<T> minX, minY, minZ;
+			std::vector<T> maxX, maxY, maxZ;
+	};
+
+}
+
+#endif
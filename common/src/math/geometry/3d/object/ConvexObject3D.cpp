@@ -1,4 +1,5 @@
 #include "ConvexObject3D.h"
+#include "math/geometry/3d/object/AABBoxArray.h"
 
 namespace urchin
 {
@@ -24,6 +25,21 @@ namespace urchin
 		throw std::runtime_error("Collision test unsupported.");
 	}
 
+	/**
+	* Default implementation testing bounding boxes one by one. Sub-classes should override it with a batch test when possible.
+	* @param collideIndices [out] Indices of the bounding boxes which collide or are inside this convex object
+	*/
+	template<class T> void ConvexObject3D<T>::collideWithAABBoxes(const AABBoxArray<T> &aabboxes, std::vector<unsigned int> &collideIndices) const
+	{
+		for(unsigned int i=0; i<aabboxes.getSize(); ++i)
+		{
+			if(collideWithAABBox(aabboxes.getAABBox(i)))
+			{
+				collideIndices.push_back(i);
+			}
+		}
+	}
+
 	//explicit template
 	template class ConvexObject3D<float>;
 	template class ConvexObject3D<double>;
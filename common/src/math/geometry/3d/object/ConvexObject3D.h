@@ -2,6 +2,7 @@
 #define URCHINENGINE_CONVEXOBJECT3D_H
 
 #include <stdexcept>
+#include <vector>
 
 #include "math/algebra/point/Point3.h"
 #include "math/algebra/vector/Vector3.h"
@@ -10,6 +11,7 @@ namespace urchin
 {
 	template<class T> class Point3;
 	template<class T> class AABBox;
+	template<class T> class AABBoxArray;
 	template<class T> class Sphere;
 
 	template<class T> class ConvexObject3D
@@ -20,6 +22,7 @@ namespace urchin
 			virtual bool collideWithPoint(const Point3<T> &) const;
 			virtual bool collideWithAABBox(const AABBox<T> &) const;
 			virtual bool collideWithSphere(const Sphere<T> &) const;
+			virtual void collideWithAABBoxes(const AABBoxArray<T> &, std::vector<unsigned int> &) const;
 
 			virtual Point3<T> getSupportPoint(const Vector3<T> &) const = 0;
 	};
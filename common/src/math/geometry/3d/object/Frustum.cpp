@@ -131,6 +131,14 @@ namespace urchin
 		return position;
 	}
 
+	/**
+	* @return Six planes of the frustum. Normals are oriented to the outside of the frustum.
+	*/
+	template<class T> const Plane<T> *Frustum<T>::getPlanes() const
+	{
+		return planes;
+	}
+
 	template<class T> Point3<T> Frustum<T>::getSupportPoint(const Vector3<T> &direction) const
 	{
 		T maxPointDotDirection = frustumPoints[0].toVector().dotProduct(direction);
@@ -282,6 +290,14 @@ namespace urchin
 		return true;
 	}
 
+	/**
+	* @param collideIndices [out] Indices of the bounding boxes which collide or are inside this frustum
+	*/
+	template<class T> void Frustum<T>::collideWithAABBoxes(const AABBoxArray<T> &aabboxes, std::vector<unsigned int> &collideIndices) const
+	{
+		aabboxes.collideWithPlanes(planes, 6, collideIndices);
+	}
+
 	template<class T> Frustum<T> operator *(const Matrix4<T> &m, const Frustum<T> &frustum)
 	{
 		Point4<T> ntl = m * Point4<T>(frustum.getFrustumPoint(Frustum<T>::NTL));
@@ -6,6 +6,7 @@
 #include "math/geometry/3d/object/ConvexObject3D.h"
 #include "math/geometry/3d/object/Sphere.h"
 #include "math/geometry/3d/object/AABBox.h"
+#include "math/geometry/3d/object/AABBoxArray.h"
 #include "math/geometry/3d/Plane.h"
 #include "math/algebra/matrix/Matrix4.h"
 #include "math/algebra/vector/Vector3.h"
@@ -42,6 +43,7 @@ namespace urchin
 			const Point3<T> *getFrustumPoints() const;
 			const Point3<T> &getFrustumPoint(FrustumPoint frustumPoint) const;
 			const Point3<T> &getPosition() const;
+			const Plane<T> *getPlanes() const;
 			
 			Point3<T> getSupportPoint(const Vector3<T> &) const;
 			T computeNearDistance() const;
@@ -52,6 +54,7 @@ namespace urchin
 			bool collideWithPoint(const Point3<T> &) const;
 			bool collideWithAABBox(const AABBox<T> &) const;
 			bool collideWithSphere(const Sphere<T> &) const;
+			void collideWithAABBoxes(const AABBoxArray<T> &, std::vector<unsigned int> &) const override;
 
 		private:
 			void buildData();
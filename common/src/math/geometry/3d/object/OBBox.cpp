@@ -4,6 +4,7 @@
 #include <stdexcept>
 
 #include "OBBox.h"
+#include "math/geometry/3d/object/AABBoxArray.h"
 #include "math/algebra/point/Point4.h"
 
 namespace urchin
@@ -327,6 +328,11 @@ namespace urchin
 		return collideWithOBBox(OBBox<T>(bbox));
 	}
 
+	template<class T> void OBBox<T>::collideWithAABBoxes(const AABBoxArray<T> &aabboxes, std::vector<unsigned int> &collideIndices) const
+	{
+		aabboxes.collideWithOBBox(*this, collideIndices);
+	}
+
 	template<class T> OBBox<T> operator *(const Matrix4<T> &m, const OBBox<T> &obb)
 	{
 		//projection matrix not accepted because result will not an oriented bounding box
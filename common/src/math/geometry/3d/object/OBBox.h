@@ -44,6 +44,7 @@ namespace urchin
 
 			bool collideWithOBBox(const OBBox<T> &) const;
 			bool collideWithAABBox(const AABBox<T> &) const;
+			void collideWithAABBoxes(const AABBoxArray<T> &, std::vector<unsigned int> &) const override;
 
 		private:
 			BoxShape<T> boxShape;
@@ -0,0 +1,505 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "HeightfieldChunkTree.h"
+#include "math/algorithm/MathAlgorithm.h"
+#include "tools/thread/JobService.h"
+
+namespace urchin
+{
+
+	/**
+	* @param heightfieldPoints Points of the heightfield ordered by row (index: x + xSize * z). Reference is kept: points must outlive the chunk tree.
+	* @param chunkSize Number of quads on X and Z axis of a chunk (power of two)
+	* @param numberLods Number of levels of detail. Value is reduced when chunks are too small to have so many levels of detail.
+	*/
+	HeightfieldChunkTree::HeightfieldChunkTree(const std::vector<Point3<float>> &heightfieldPoints, unsigned int xSize, unsigned int zSize,
+			unsigned int chunkSize, unsigned int numberLods) :
+			heightfieldPoints(heightfieldPoints),
+			xSize(xSize),
+			zSize(zSize),
+			chunkSize(chunkSize),
+			numberLods(numberLods),
+			skirtDepth(0.0f)
+	{
+		if(xSize < 2 || zSize < 2 || heightfieldPoints.size()!=xSize * zSize)
+		{
+			throw std::invalid_argument("Invalid heightfield size: " + std::to_string(xSize) + "x" + std::to_string(zSize)
+					+ " with " + std::to_string(heightfieldPoints.size()) + " points");
+		}
+		if(chunkSize==0 || (chunkSize & (chunkSize - 1))!=0)
+		{
+			throw std::invalid_argument("Heightfield chunk size must be a power of two: " + std::to_string(chunkSize));
+		}
+		if(numberLods==0)
+		{
+			throw std::invalid_argument("Heightfield chunks require at least one level of detail");
+		}
+
+		unsigned int maxNumberLods = 1;
+		while((1u << maxNumberLods) <= chunkSize)
+		{
+			maxNumberLods++;
+		}
+		this->numberLods = std::min(numberLods, maxNumberLods);
+
+		xChunksCount = (xSize - 1 + chunkSize - 1) / chunkSize;
+		zChunksCount = (zSize - 1 + chunkSize - 1) / chunkSize;
+		xInterval = heightfieldPoints[1].X - heightfieldPoints[0].X;
+		zInterval = heightfieldPoints[xSize].Z - heightfieldPoints[0].Z;
+
+		computeLodErrors();
+		buildChunksVertices();
+		buildLodsIndices();
+
+		nodes.resize(1);
+		buildQuadtree(0, 0, 0, xChunksCount, zChunksCount);
+	}
+
+	unsigned int HeightfieldChunkTree::getChunkSize() const
+	{
+		return chunkSize;
+	}
+
+	unsigned int HeightfieldChunkTree::getNumberLods() const
+	{
+		return numberLods;
+	}
+
+	unsigned int HeightfieldChunkTree::getXChunksCount() const
+	{
+		return xChunksCount;
+	}
+
+	unsigned int HeightfieldChunkTree::getZChunksCount() const
+	{
+		return zChunksCount;
+	}
+
+	/**
+	* @return Number of chunks. Chunk index is: xChunk + xChunksCount * zChunk.
+	*/
+	unsigned int HeightfieldChunkTree::getChunksCount() const
+	{
+		return xChunksCount * zChunksCount;
+	}
+
+	/**
+	* @return Number of vertices of a chunk: a grid of (chunkSize + 1)^2 vertices followed by the skirt vertices of the four borders
+	*/
+	unsigned int HeightfieldChunkTree::getChunkVerticesCount() const
+	{
+		unsigned int borderVerticesCount = chunkSize + 1;
+		return borderVerticesCount * borderVerticesCount + 4 * borderVerticesCount;
+	}
+
+	/**
+	* @return Vertices of all chunks. Vertices of a chunk start at chunkIndex * getChunkVerticesCount().
+	*/
+	const std::vector<Point3<float>> &HeightfieldChunkTree::getChunksVertices() const
+	{
+		return chunksVertices;
+	}
+
+	/**
+	* @return Index of the heightfield point used by each chunk vertex: allow to copy the vertex attributes (normals, texture coordinates...)
+	*/
+	const std::vector<unsigned int> &HeightfieldChunkTree::getChunksVerticesSource() const
+	{
+		return chunksVerticesSource;
+	}
+
+	const AABBox<float> &HeightfieldChunkTree::getChunkBox(unsigned int chunkIndex) const
+	{
+		return chunksBox[chunkIndex];
+	}
+
+	/**
+	* @return Triangles indices (three indices by triangle) of all levels of detail. Indices are relative to the first vertex of a chunk.
+	*/
+	const std::vector<unsigned int> &HeightfieldChunkTree::getLodsIndices() const
+	{
+		return lodsIndices;
+	}
+
+	unsigned int HeightfieldChunkTree::getLodIndicesOffset(unsigned int lod) const
+	{
+		return lodsIndicesOffset[lod];
+	}
+
+	unsigned int HeightfieldChunkTree::getLodIndicesCount(unsigned int lod) const
+	{
+		return lodsIndicesCount[lod];
+	}
+
+	/**
+	* @return Maximum vertical distance between the heightfield and its geometry at the level of detail
+	*/
+	float HeightfieldChunkTree::getLodError(unsigned int lod) const
+	{
+		return lodErrors[lod];
+	}
+
+	float HeightfieldChunkTree::getSkirtDepth() const
+	{
+		return skirtDepth;
+	}
+
+	void HeightfieldChunkTree::computeLodErrors()
+	{
+		//one job by row and level of detail
+		std::vector<float> rowsError(zSize * numberLods, 0.0f);
+		JobService::instance()->run(zSize * (numberLods - 1), [&](unsigned int jobIndex) {
+			unsigned int z = jobIndex % zSize;
+			unsigned int lod = jobIndex / zSize + 1;
+			for(unsigned int x=0; x<xSize; ++x)
+			{
+				float error = std::abs(computeHeight(x, z, lod) - heightfieldPoints[x + xSize * z].Y);
+				rowsError[z + zSize * lod] = std::max(rowsError[z + zSize * lod], error);
+			}
+		});
+
+		lodErrors.assign(numberLods, 0.0f);
+		for(unsigned int lod=1; lod<numberLods; ++lod)
+		{
+			lodErrors[lod] = *std::max_element(rowsError.begin() + zSize * lod, rowsError.begin() + zSize * (lod + 1));
+		}
+
+		//skirts must cover the biggest crack between two levels of detail. Minimum depth hides the gaps due to float precision.
+		skirtDepth = std::max(*std::max_element(lodErrors.begin(), lodErrors.end()), 0.01f * std::max(xInterval, zInterval));
+	}
+
+	/**
+	* @return Height of the heightfield point (x, z) on the geometry of the level of detail
+	*/
+	float HeightfieldChunkTree::computeHeight(unsigned int x, unsigned int z, unsigned int lod) const
+	{
+		unsigned int step = 1u << lod;
+		unsigned int x0 = computeCellStart(x, xSize, step);
+		unsigned int z0 = computeCellStart(z, zSize, step);
+		unsigned int x1 = std::min(x0 + step, xSize - 1);
+		unsigned int z1 = std::min(z0 + step, zSize - 1);
+
+		return interpolateHeight(x0, z0, x1, z1, static_cast<float>(x - x0) / static_cast<float>(x1 - x0),
+				static_cast<float>(z - z0) / static_cast<float>(z1 - z0));
+	}
+
+	/**
+	* @return First coordinate of the cell containing the coordinate. Last cell is shortened when it exceeds the heightfield.
+	*/
+	unsigned int HeightfieldChunkTree::computeCellStart(unsigned int coordinate, unsigned int size, unsigned int step) const
+	{
+		return std::min(coordinate / step * step, (size - 2) / step * step);
+	}
+
+	/**
+	* Interpolates the height in the cell (x0, z0) - (x1, z1) split in two triangles by the diagonal (x0, z0) - (x1, z1)
+	* @param u Relative position in the cell on X axis [0, 1]
+	* @param v Relative position in the cell on Z axis [0, 1]
+	*/
+	float HeightfieldChunkTree::interpolateHeight(unsigned int x0, unsigned int z0, unsigned int x1, unsigned int z1, float u, float v) const
+	{
+		float height00 = heightfieldPoints[x0 + xSize * z0].Y;
+		float height11 = heightfieldPoints[x1 + xSize * z1].Y;
+		if(u >= v)
+		{
+			float height10 = heightfieldPoints[x1 + xSize * z0].Y;
+			return height00 + u * (height10 - height00) + v * (height11 - height10);
+		}
+
+		float height01 = heightfieldPoints[x0 + xSize * z1].Y;
+		return height00 + v * (height01 - height00) + u * (height11 - height01);
+	}
+
+	void HeightfieldChunkTree::buildChunksVertices()
+	{
+		unsigned int borderVerticesCount = chunkSize + 1;
+		unsigned int chunkVerticesCount = getChunkVerticesCount();
+		chunksVertices.resize(getChunksCount() * chunkVerticesCount);
+		chunksVerticesSource.resize(getChunksCount() * chunkVerticesCount);
+		chunksBox.resize(getChunksCount());
+
+		//one job by chunk
+		JobService::instance()->run(getChunksCount(), [&](unsigned int chunkIndex) {
+			unsigned int xChunk = chunkIndex % xChunksCount;
+			unsigned int zChunk = chunkIndex / xChunksCount;
+			unsigned int firstVertex = chunkIndex * chunkVerticesCount;
+
+			for(unsigned int z=0; z<borderVerticesCount; ++z)
+			{
+				unsigned int sourceZ = std::min(zChunk * chunkSize + z, zSize - 1);
+				for(unsigned int x=0; x<borderVerticesCount; ++x)
+				{
+					unsigned int sourceX = std::min(xChunk * chunkSize + x, xSize - 1);
+					chunksVerticesSource[firstVertex + x + borderVerticesCount * z] = sourceX + xSize * sourceZ;
+				}
+			}
+
+			//skirts: borders on Z min, Z max, X min and X max. No skirt on the heightfield borders.
+			unsigned int firstSkirtVertex = firstVertex + borderVerticesCount * borderVerticesCount;
+			bool isLastXChunk = (xChunk + 1) * chunkSize >= xSize - 1;
+			bool isLastZChunk = (zChunk + 1) * chunkSize >= zSize - 1;
+			float skirtsDepth[4] = {zChunk==0 ? 0.0f : skirtDepth, isLastZChunk ? 0.0f : skirtDepth,
+					xChunk==0 ? 0.0f : skirtDepth, isLastXChunk ? 0.0f : skirtDepth};
+			for(unsigned int i=0; i<borderVerticesCount; ++i)
+			{
+				chunksVerticesSource[firstSkirtVertex + i] = chunksVerticesSource[firstVertex + i];
+				chunksVerticesSource[firstSkirtVertex + borderVerticesCount + i] = chunksVerticesSource[firstVertex + i + borderVerticesCount * chunkSize];
+				chunksVerticesSource[firstSkirtVertex + 2 * borderVerticesCount + i] = chunksVerticesSource[firstVertex + borderVerticesCount * i];
+				chunksVerticesSource[firstSkirtVertex + 3 * borderVerticesCount + i] = chunksVerticesSource[firstVertex + chunkSize + borderVerticesCount * i];
+			}
+
+			for(unsigned int i=0; i<chunkVerticesCount; ++i)
+			{
+				chunksVertices[firstVertex + i] = heightfieldPoints[chunksVerticesSource[firstVertex + i]];
+			}
+			for(unsigned int side=0; side<4; ++side)
+			{
+				for(unsigned int i=0; i<borderVerticesCount; ++i)
+				{
+					chunksVertices[firstSkirtVertex + side * borderVerticesCount + i].Y -= skirtsDepth[side];
+				}
+			}
+
+			chunksBox[chunkIndex] = AABBox<float>(&chunksVertices[firstVertex], chunkVerticesCount);
+		});
+	}
+
+	void HeightfieldChunkTree::buildLodsIndices()
+	{
+		unsigned int borderVerticesCount = chunkSize + 1;
+		lodsIndicesOffset.resize(numberLods);
+		lodsIndicesCount.resize(numberLods);
+
+		for(unsigned int lod=0; lod<numberLods; ++lod)
+		{
+			unsigned int step = 1u << lod;
+			lodsIndicesOffset[lod] = lodsIndices.size();
+
+			//same triangles as a strip of rows: (x, z+1), (x, z), (x+1, z+1), (x+1, z)
+			for(unsigned int z=0; z<chunkSize; z+=step)
+			{
+				for(unsigned int x=0; x<chunkSize; x+=step)
+				{
+					unsigned int vertex00 = x + borderVerticesCount * z;
+					unsigned int vertex10 = (x + step) + borderVerticesCount * z;
+					unsigned int vertex01 = x + borderVerticesCount * (z + step);
+					unsigned int vertex11 = (x + step) + borderVerticesCount * (z + step);
+
+					lodsIndices.insert(lodsIndices.end(), {vertex01, vertex00, vertex11});
+					lodsIndices.insert(lodsIndices.end(), {vertex11, vertex00, vertex10});
+				}
+			}
+
+			//skirts facing outside of the chunk
+			addSkirtIndices(0, 0, 1, step, false);
+			addSkirtIndices(1, borderVerticesCount * chunkSize, 1, step, true);
+			addSkirtIndices(2, 0, borderVerticesCount, step, true);
+			addSkirtIndices(3, chunkSize, borderVerticesCount, step, false);
+
+			lodsIndicesCount[lod] = lodsIndices.size() - lodsIndicesOffset[lod];
+		}
+	}
+
+	/**
+	* @param side Side of the skirt: Z min, Z max, X min or X max
+	* @param borderFirstVertex First chunk vertex of the border
+	* @param borderVertexStride Distance between two consecutive vertices of the border
+	* @param reverseWinding Skirts of Z max and X min borders face the opposite direction of their axis: winding must be reversed
+	*/
+	void HeightfieldChunkTree::addSkirtIndices(unsigned int side, unsigned int borderFirstVertex, unsigned int borderVertexStride, unsigned int step,
+			bool reverseWinding)
+	{
+		unsigned int borderVerticesCount = chunkSize + 1;
+		unsigned int skirtFirstVertex = borderVerticesCount * borderVerticesCount + side * borderVerticesCount;
+
+		for(unsigned int i=0; i<chunkSize; i+=step)
+		{
+			unsigned int border0 = borderFirstVertex + i * borderVertexStride;
+			unsigned int border1 = borderFirstVertex + (i + step) * borderVertexStride;
+			unsigned int skirt0 = skirtFirstVertex + i;
+			unsigned int skirt1 = skirtFirstVertex + i + step;
+
+			if(reverseWinding)
+			{
+				lodsIndices.insert(lodsIndices.end(), {border0, border1, skirt0});
+				lodsIndices.insert(lodsIndices.end(), {border1, skirt1, skirt0});
+			}else
+			{
+				lodsIndices.insert(lodsIndices.end(), {border0, skirt0, border1});
+				lodsIndices.insert(lodsIndices.end(), {border1, skirt0, skirt1});
+			}
+		}
+	}
+
+	/**
+	* Builds the node covering the chunks [xChunkStart, xChunkEnd[ x [zChunkStart, zChunkEnd[
+	*/
+	void HeightfieldChunkTree::buildQuadtree(unsigned int nodeIndex, unsigned int xChunkStart, unsigned int zChunkStart, unsigned int xChunkEnd,
+			unsigned int zChunkEnd)
+	{
+		if(xChunkEnd - xChunkStart==1 && zChunkEnd - zChunkStart==1)
+		{
+			unsigned int chunkIndex = xChunkStart + xChunksCount * zChunkStart;
+			nodes[nodeIndex] = {chunksBox[chunkIndex], 0, 0, chunkIndex};
+			return;
+		}
+
+		unsigned int xChunkMiddle = (xChunkStart + xChunkEnd + 1) / 2;
+		unsigned int zChunkMiddle = (zChunkStart + zChunkEnd + 1) / 2;
+		unsigned int xBounds[3] = {xChunkStart, xChunkMiddle, xChunkEnd};
+		unsigned int zBounds[3] = {zChunkStart, zChunkMiddle, zChunkEnd};
+
+		unsigned int firstChild = nodes.size();
+		unsigned int childrenCount = 0;
+		for(unsigned int zHalf=0; zHalf<2; ++zHalf)
+		{
+			for(unsigned int xHalf=0; xHalf<2; ++xHalf)
+			{
+				if(xBounds[xHalf]!=xBounds[xHalf + 1] && zBounds[zHalf]!=zBounds[zHalf + 1])
+				{
+					childrenCount++;
+				}
+			}
+		}
+		nodes.resize(nodes.size() + childrenCount);
+
+		unsigned int childIndex = firstChild;
+		AABBox<float> box = AABBox<float>::initMergeableAABBox();
+		for(unsigned int zHalf=0; zHalf<2; ++zHalf)
+		{
+			for(unsigned int xHalf=0; xHalf<2; ++xHalf)
+			{
+				if(xBounds[xHalf]!=xBounds[xHalf + 1] && zBounds[zHalf]!=zBounds[zHalf + 1])
+				{
+					buildQuadtree(childIndex, xBounds[xHalf], zBounds[zHalf], xBounds[xHalf + 1], zBounds[zHalf + 1]);
+					box = box.merge(nodes[childIndex].box);
+					childIndex++;
+				}
+			}
+		}
+
+		nodes[nodeIndex] = {box, firstChild, childrenCount, 0};
+	}
+
+	/**
+	* Selects the chunks colliding with the frustum. Level of detail increases by one each time the distance to the view position doubles.
+	* @param frustum Frustum in the heightfield space
+	* @param viewPosition View position in the heightfield space
+	* @param lodDistance Distance from which the first level of detail is replaced by the second one
+	*/
+	void HeightfieldChunkTree::selectChunks(const Frustum<float> &frustum, const Point3<float> &viewPosition, float lodDistance,
+			std::vector<HeightfieldChunkSelection> &selectedChunks) const
+	{
+		selectedChunks.clear();
+
+		std::vector<unsigned int> nodesToVisit;
+		nodesToVisit.push_back(0);
+		while(!nodesToVisit.empty())
+		{
+			const QuadtreeNode &node = nodes[nodesToVisit.back()];
+			nodesToVisit.pop_back();
+
+			if(frustum.collideWithAABBox(node.box))
+			{
+				if(node.childrenCount==0)
+				{
+					selectedChunks.push_back({node.chunkIndex, computeLod(node.box, viewPosition, lodDistance)});
+				}else
+				{
+					for(unsigned int i=0; i<node.childrenCount; ++i)
+					{
+						nodesToVisit.push_back(node.firstChild + i);
+					}
+				}
+			}
+		}
+	}
+
+	unsigned int HeightfieldChunkTree::computeLod(const AABBox<float> &box, const Point3<float> &viewPosition, float lodDistance) const
+	{
+		float distanceX = std::max(std::max(box.getMin().X - viewPosition.X, viewPosition.X - box.getMax().X), 0.0f);
+		float distanceY = std::max(std::max(box.getMin().Y - viewPosition.Y, viewPosition.Y - box.getMax().Y), 0.0f);
+		float distanceZ = std::max(std::max(box.getMin().Z - viewPosition.Z, viewPosition.Z - box.getMax().Z), 0.0f);
+		float distance = std::sqrt(distanceX * distanceX + distanceY * distanceY + distanceZ * distanceZ);
+
+		if(distance < lodDistance || lodDistance <= 0.0f)
+		{
+			return 0;
+		}
+		auto lod = static_cast<unsigned int>(std::log2(distance / lodDistance)) + 1;
+		return std::min(lod, numberLods - 1);
+	}
+
+	/**
+	* @param point Coordinate on X/Z axis in the heightfield space. Coordinate outside the heightfield is clamped to the heightfield.
+	* @param lod Level of detail of the geometry used to compute the height
+	* @return Height at the coordinate on the geometry of the level of detail
+	*/
+	float HeightfieldChunkTree::findHeightAt(const Point2<float> &point, unsigned int lod) const
+	{
+		if(lod >= numberLods)
+		{
+			throw std::out_of_range("Heightfield level of detail " + std::to_string(lod) + " does not exist");
+		}
+
+		float x = MathAlgorithm::clamp((point.X - heightfieldPoints[0].X) / xInterval, 0.0f, static_cast<float>(xSize - 1));
+		float z = MathAlgorithm::clamp((point.Y - heightfieldPoints[0].Z) / zInterval, 0.0f, static_cast<float>(zSize - 1));
+
+		unsigned int step = 1u << lod;
+		unsigned int x0 = computeCellStart(static_cast<unsigned int>(x), xSize, step);
+		unsigned int z0 = computeCellStart(static_cast<unsigned int>(z), zSize, step);
+		unsigned int x1 = std::min(x0 + step, xSize - 1);
+		unsigned int z1 = std::min(z0 + step, zSize - 1);
+
+		return interpolateHeight(x0, z0, x1, z1, (x - x0) / static_cast<float>(x1 - x0), (z - z0) / static_cast<float>(z1 - z0));
+	}
+
+	/**
+	* @param min Minimum coordinate on X/Z axis of the area in the heightfield space
+	* @param max Maximum coordinate on X/Z axis of the area in the heightfield space
+	* @param lod Level of detail of the triangles
+	* @param triangles [out] Points of the triangles (three points by triangle) overlapping the area. Triangles have the same winding as the displayed triangles.
+	*/
+	void HeightfieldChunkTree::findTrianglesIn(const Point2<float> &min, const Point2<float> &max, unsigned int lod, std::vector<Point3<float>> &triangles) const
+	{
+		if(lod >= numberLods)
+		{
+			throw std::out_of_range("Heightfield level of detail " + std::to_string(lod) + " does not exist");
+		}
+
+		float minX = (min.X - heightfieldPoints[0].X) / xInterval;
+		float maxX = (max.X - heightfieldPoints[0].X) / xInterval;
+		float minZ = (min.Y - heightfieldPoints[0].Z) / zInterval;
+		float maxZ = (max.Y - heightfieldPoints[0].Z) / zInterval;
+		if(maxX < 0.0f || maxZ < 0.0f || minX > static_cast<float>(xSize - 1) || minZ > static_cast<float>(zSize - 1))
+		{
+			return;
+		}
+
+		unsigned int step = 1u << lod;
+		unsigned int xStart = computeCellStart(static_cast<unsigned int>(std::max(minX, 0.0f)), xSize, step);
+		unsigned int xEnd = computeCellStart(static_cast<unsigned int>(std::min(maxX, static_cast<float>(xSize - 1))), xSize, step);
+		unsigned int zStart = computeCellStart(static_cast<unsigned int>(std::max(minZ, 0.0f)), zSize, step);
+		unsigned int zEnd = computeCellStart(static_cast<unsigned int>(std::min(maxZ, static_cast<float>(zSize - 1))), zSize, step);
+
+		for(unsigned int z0=zStart; z0<=zEnd; z0+=step)
+		{
+			unsigned int z1 = std::min(z0 + step, zSize - 1);
+			for(unsigned int x0=xStart; x0<=xEnd; x0+=step)
+			{
+				unsigned int x1 = std::min(x0 + step, xSize - 1);
+				const Point3<float> &point00 = heightfieldPoints[x0 + xSize * z0];
+				const Point3<float> &point10 = heightfieldPoints[x1 + xSize * z0];
+				const Point3<float> &point01 = heightfieldPoints[x0 + xSize * z1];
+				const Point3<float> &point11 = heightfieldPoints[x1 + xSize * z1];
+
+				triangles.insert(triangles.end(), {point01, point00, point11});
+				triangles.insert(triangles.end(), {point11, point00, point10});
+			}
+		}
+	}
+
+}
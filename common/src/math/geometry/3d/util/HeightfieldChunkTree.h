@@ -0,0 +1,99 @@
+#ifndef URCHINENGINE_HEIGHTFIELDCHUNKTREE_H
+#define URCHINENGINE_HEIGHTFIELDCHUNKTREE_H
+
+#include <vector>
+
+#include "math/algebra/point/Point2.h"
+#include "math/algebra/point/Point3.h"
+#include "math/geometry/3d/object/AABBox.h"
+#include "math/geometry/3d/object/Frustum.h"
+
+namespace urchin
+{
+
+	/**
+	* Chunk selected to be displayed with its level of detail
+	*/
+	struct HeightfieldChunkSelection
+	{
+		unsigned int chunkIndex;
+		unsigned int lod;
+	};
+
+	/**
+	* Split a heightfield in square chunks organized in a quadtree. Each level of detail 'lod' keeps one vertex out of 2^lod on
+	* both axis. All chunks have the same vertices layout: the triangles indices of a level of detail are shared by all chunks
+	* (chunk vertices are placed at chunkIndex * getChunkVerticesCount()). Chunks exceeding the heightfield repeat its last
+	* vertices (degenerated triangles).
+	* Cracks between chunks of different levels of detail are hidden by skirts: vertical triangles hanging below the chunk borders.
+	* Heights and triangles can be queried at any level of detail: queried geometry matches the displayed geometry.
+	*/
+	class HeightfieldChunkTree
+	{
+		public:
+			HeightfieldChunkTree(const std::vector<Point3<float>> &, unsigned int, unsigned int, unsigned int, unsigned int);
+
+			unsigned int getChunkSize() const;
+			unsigned int getNumberLods() const;
+			unsigned int getXChunksCount() const;
+			unsigned int getZChunksCount() const;
+			unsigned int getChunksCount() const;
+
+			unsigned int getChunkVerticesCount() const;
+			const std::vector<Point3<float>> &getChunksVertices() const;
+			const std::vector<unsigned int> &getChunksVerticesSource() const;
+			const AABBox<float> &getChunkBox(unsigned int) const;
+
+			const std::vector<unsigned int> &getLodsIndices() const;
+			unsigned int getLodIndicesOffset(unsigned int) const;
+			unsigned int getLodIndicesCount(unsigned int) const;
+			float getLodError(unsigned int) const;
+			float getSkirtDepth() const;
+
+			void selectChunks(const Frustum<float> &, const Point3<float> &, float, std::vector<HeightfieldChunkSelection> &) const;
+
+			float findHeightAt(const Point2<float> &, unsigned int) const;
+			void findTrianglesIn(const Point2<float> &, const Point2<float> &, unsigned int, std::vector<Point3<float>> &) const;
+
+		private:
+			struct QuadtreeNode
+			{
+				AABBox<float> box;
+				unsigned int firstChild, childrenCount; //children are contiguous in nodes
+				unsigned int chunkIndex; //only for leaf
+			};
+
+			void computeLodErrors();
+			float computeHeight(unsigned int, unsigned int, unsigned int) const;
+			unsigned int computeCellStart(unsigned int, unsigned int, unsigned int) const;
+			float interpolateHeight(unsigned int, unsigned int, unsigned int, unsigned int, float, float) const;
+
+			void buildChunksVertices();
+			void buildLodsIndices();
+			void addSkirtIndices(unsigned int, unsigned int, unsigned int, unsigned int, bool);
+			void buildQuadtree(unsigned int, unsigned int, unsigned int, unsigned int, unsigned int);
+			unsigned int computeLod(const AABBox<float> &, const Point3<float> &, float) const;
+
+			const std::vector<Point3<float>> &heightfieldPoints;
+			const unsigned int xSize, zSize;
+			const unsigned int chunkSize;
+			unsigned int numberLods;
+			unsigned int xChunksCount, zChunksCount;
+			float xInterval, zInterval;
+
+			std::vector<float> lodErrors;
+			float skirtDepth;
+
+			std::vector<Point3<float>> chunksVertices;
+			std::vector<unsigned int> chunksVerticesSource; //index of the heightfield point used by each chunk vertex
+			std::vector<AABBox<float>> chunksBox;
+
+			std::vector<unsigned int> lodsIndices;
+			std::vector<unsigned int> lodsIndicesOffset, lodsIndicesCount;
+
+			std::vector<QuadtreeNode> nodes;
+	};
+
+}
+
+#endif
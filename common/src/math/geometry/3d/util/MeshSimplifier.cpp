@@ -0,0 +1,301 @@
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <stdexcept>
+#include <unordered_map>
+
+#include "MeshSimplifier.h"
+
+namespace urchin
+{
+
+	MeshSimplifier::Quadric::Quadric() :
+			values()
+	{
+
+	}
+
+	/**
+	* Adds the quadric of the plane a*x + b*y + c*z + d = 0
+	*/
+	void MeshSimplifier::Quadric::addPlane(double a, double b, double c, double d, double weight)
+	{
+		values[0] += weight*a*a; values[1] += weight*a*b; values[2] += weight*a*c; values[3] += weight*a*d;
+		values[4] += weight*b*b; values[5] += weight*b*c; values[6] += weight*b*d;
+		values[7] += weight*c*c; values[8] += weight*c*d;
+		values[9] += weight*d*d;
+	}
+
+	void MeshSimplifier::Quadric::add(const Quadric &quadric)
+	{
+		for(unsigned int i=0; i<10; ++i)
+		{
+			values[i] += quadric.values[i];
+		}
+	}
+
+	/**
+	* @return Sum of the weighted square distances between the point and the planes of the quadric
+	*/
+	double MeshSimplifier::Quadric::evaluate(const Point3<float> &point) const
+	{
+		double x = point.X, y = point.Y, z = point.Z;
+		return values[0]*x*x + 2.0*values[1]*x*y + 2.0*values[2]*x*z + 2.0*values[3]*x
+				+ values[4]*y*y + 2.0*values[5]*y*z + 2.0*values[6]*y
+				+ values[7]*z*z + 2.0*values[8]*z
+				+ values[9];
+	}
+
+	/**
+	* Lowest costs on top of the priority queue
+	*/
+	bool MeshSimplifier::Collapse::operator <(const Collapse &collapse) const
+	{
+		return cost > collapse.cost;
+	}
+
+	/**
+	* @param vertices Positions of the vertices
+	* @param indices Vertex indices of the triangles (3 indices by triangle)
+	*/
+	MeshSimplifier::MeshSimplifier(const Point3<float> *vertices, unsigned int verticesCount, const unsigned int *indices, unsigned int indicesCount) :
+			positions(vertices, vertices + verticesCount),
+			quadrics(verticesCount),
+			lockedVertices(verticesCount, false),
+			removedVertices(verticesCount, false),
+			versions(verticesCount, 0),
+			vertexTriangles(verticesCount),
+			removedTriangles(indicesCount / 3, false),
+			trianglesCount(indicesCount / 3)
+	{
+		if(indicesCount % 3 != 0)
+		{
+			throw std::invalid_argument("Number of indices must be a multiple of 3: " + std::to_string(indicesCount));
+		}
+
+		triangles.reserve(trianglesCount);
+		for(unsigned int i=0; i<indicesCount; i+=3)
+		{
+			if(indices[i]>=verticesCount || indices[i+1]>=verticesCount || indices[i+2]>=verticesCount)
+			{
+				throw std::out_of_range("Triangle " + std::to_string(i/3) + " references a vertex out of range.");
+			}
+
+			unsigned int triangleIndex = triangles.size();
+			triangles.push_back({{indices[i], indices[i+1], indices[i+2]}});
+
+			//quadric of the triangle plane weighted by the triangle area
+			Vector3<float> normal = positions[indices[i]].vector(positions[indices[i+1]]).crossProduct(positions[indices[i]].vector(positions[indices[i+2]]));
+			double normalLength = std::sqrt((double)normal.squareLength());
+			Quadric triangleQuadric;
+			if(normalLength > 0.0)
+			{
+				double a = normal.X / normalLength, b = normal.Y / normalLength, c = normal.Z / normalLength;
+				double d = -(a*positions[indices[i]].X + b*positions[indices[i]].Y + c*positions[indices[i]].Z);
+				triangleQuadric.addPlane(a, b, c, d, normalLength * 0.5);
+			}
+
+			for(unsigned int corner=0; corner<3; ++corner)
+			{
+				quadrics[indices[i+corner]].add(triangleQuadric);
+				vertexTriangles[indices[i+corner]].push_back(triangleIndex);
+			}
+		}
+
+		lockBorderVertices();
+
+		for(unsigned int vertex=0; vertex<verticesCount; ++vertex)
+		{
+			collectNeighbors(vertex, neighbors);
+			for(unsigned int neighbor : neighbors)
+			{
+				pushCollapse(vertex, neighbor);
+			}
+		}
+	}
+
+	/**
+	* Locks the vertices of the edges shared by one triangle (border) or by more than two triangles (non-manifold)
+	*/
+	void MeshSimplifier::lockBorderVertices()
+	{
+		std::unordered_map<unsigned long long, unsigned int> edgesTrianglesCount;
+		for(const auto &triangle : triangles)
+		{
+			for(unsigned int corner=0; corner<3; ++corner)
+			{
+				unsigned long long vertex1 = std::min(triangle[corner], triangle[(corner + 1) % 3]);
+				unsigned long long vertex2 = std::max(triangle[corner], triangle[(corner + 1) % 3]);
+				edgesTrianglesCount[(vertex1 << 32u) | vertex2]++;
+			}
+		}
+
+		for(const auto &edgeTrianglesCount : edgesTrianglesCount)
+		{
+			if(edgeTrianglesCount.second!=2)
+			{
+				lockedVertices[edgeTrianglesCount.first >> 32u] = true;
+				lockedVertices[edgeTrianglesCount.first & 0xFFFFFFFFu] = true;
+			}
+		}
+	}
+
+	void MeshSimplifier::collectNeighbors(unsigned int vertex, std::vector<unsigned int> &vertexNeighbors) const
+	{
+		vertexNeighbors.clear();
+		for(unsigned int triangleIndex : vertexTriangles[vertex])
+		{
+			if(!removedTriangles[triangleIndex])
+			{
+				for(unsigned int triangleVertex : triangles[triangleIndex])
+				{
+					if(triangleVertex!=vertex)
+					{
+						vertexNeighbors.push_back(triangleVertex);
+					}
+				}
+			}
+		}
+
+		std::sort(vertexNeighbors.begin(), vertexNeighbors.end());
+		vertexNeighbors.erase(std::unique(vertexNeighbors.begin(), vertexNeighbors.end()), vertexNeighbors.end());
+	}
+
+	/**
+	* Adds the collapse of the vertex 'fromVertex' into the vertex 'toVertex' in the priority queue
+	*/
+	void MeshSimplifier::pushCollapse(unsigned int fromVertex, unsigned int toVertex)
+	{
+		if(!lockedVertices[fromVertex])
+		{
+			Quadric collapseQuadric = quadrics[fromVertex];
+			collapseQuadric.add(quadrics[toVertex]);
+
+			collapses.push({collapseQuadric.evaluate(positions[toVertex]), fromVertex, toVertex, versions[fromVertex], versions[toVertex]});
+		}
+	}
+
+	unsigned int MeshSimplifier::getTrianglesCount() const
+	{
+		return trianglesCount;
+	}
+
+	/**
+	* @param targetTrianglesCount Number of triangles expected. The result can contain more triangles when no more edge can be collapsed
+	* without altering the topology or flipping a triangle.
+	* @return Vertex indices of the simplified triangles (3 indices by triangle)
+	*/
+	std::vector<unsigned int> MeshSimplifier::simplify(unsigned int targetTrianglesCount)
+	{
+		while(trianglesCount > targetTrianglesCount && !collapses.empty())
+		{
+			Collapse bestCollapse = collapses.top();
+			collapses.pop();
+
+			if(removedVertices[bestCollapse.fromVertex] || removedVertices[bestCollapse.toVertex]
+					|| versions[bestCollapse.fromVertex]!=bestCollapse.fromVersion || versions[bestCollapse.toVertex]!=bestCollapse.toVersion)
+			{ //obsolete collapse
+				continue;
+			}
+
+			if(isCollapseValid(bestCollapse.fromVertex, bestCollapse.toVertex))
+			{
+				collapse(bestCollapse.fromVertex, bestCollapse.toVertex);
+			}
+		}
+
+		std::vector<unsigned int> indices;
+		indices.reserve(trianglesCount * 3);
+		for(unsigned int triangleIndex=0; triangleIndex<triangles.size(); ++triangleIndex)
+		{
+			if(!removedTriangles[triangleIndex])
+			{
+				indices.insert(indices.end(), triangles[triangleIndex].begin(), triangles[triangleIndex].end());
+			}
+		}
+		return indices;
+	}
+
+	bool MeshSimplifier::isCollapseValid(unsigned int fromVertex, unsigned int toVertex)
+	{
+		//an interior edge shares two neighbors (opposite vertices of its two triangles): more shared neighbors would create a non-manifold edge
+		collectNeighbors(fromVertex, neighbors);
+		collectNeighbors(toVertex, otherNeighbors);
+		unsigned int sharedNeighbors = 0;
+		for(unsigned int neighbor : neighbors)
+		{
+			sharedNeighbors += std::binary_search(otherNeighbors.begin(), otherNeighbors.end(), neighbor) ? 1 : 0;
+		}
+		if(sharedNeighbors > 2)
+		{
+			return false;
+		}
+
+		//moved triangles must not flip or become degenerate
+		constexpr float MIN_NORMAL_COSINE = 0.2f;
+		for(unsigned int triangleIndex : vertexTriangles[fromVertex])
+		{
+			const std::array<unsigned int, 3> &triangle = triangles[triangleIndex];
+			if(removedTriangles[triangleIndex] || std::find(triangle.begin(), triangle.end(), toVertex)!=triangle.end())
+			{ //removed triangle or triangle removed by the collapse
+				continue;
+			}
+
+			Point3<float> movedPoints[3];
+			for(unsigned int corner=0; corner<3; ++corner)
+			{
+				movedPoints[corner] = positions[triangle[corner]==fromVertex ? toVertex : triangle[corner]];
+			}
+			Vector3<float> normal = positions[triangle[0]].vector(positions[triangle[1]]).crossProduct(positions[triangle[0]].vector(positions[triangle[2]]));
+			Vector3<float> movedNormal = movedPoints[0].vector(movedPoints[1]).crossProduct(movedPoints[0].vector(movedPoints[2]));
+
+			float normalsDotProduct = normal.dotProduct(movedNormal);
+			if(normalsDotProduct <= 0.0f || normalsDotProduct * normalsDotProduct < MIN_NORMAL_COSINE * MIN_NORMAL_COSINE * normal.squareLength() * movedNormal.squareLength())
+			{
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	void MeshSimplifier::collapse(unsigned int fromVertex, unsigned int toVertex)
+	{
+		for(unsigned int triangleIndex : vertexTriangles[fromVertex])
+		{
+			if(removedTriangles[triangleIndex])
+			{
+				continue;
+			}
+
+			std::array<unsigned int, 3> &triangle = triangles[triangleIndex];
+			if(std::find(triangle.begin(), triangle.end(), toVertex)!=triangle.end())
+			{
+				removedTriangles[triangleIndex] = true;
+				trianglesCount--;
+			}else
+			{
+				std::replace(triangle.begin(), triangle.end(), fromVertex, toVertex);
+				vertexTriangles[toVertex].push_back(triangleIndex);
+			}
+		}
+
+		std::vector<unsigned int> &toVertexTriangles = vertexTriangles[toVertex];
+		toVertexTriangles.erase(std::remove_if(toVertexTriangles.begin(), toVertexTriangles.end(), [&](unsigned int triangleIndex) {
+			return removedTriangles[triangleIndex];
+		}), toVertexTriangles.end());
+		vertexTriangles[fromVertex].clear();
+		removedVertices[fromVertex] = true;
+		quadrics[toVertex].add(quadrics[fromVertex]);
+
+		//costs of the edges of 'toVertex' changed
+		versions[toVertex]++;
+		collectNeighbors(toVertex, neighbors);
+		for(unsigned int neighbor : neighbors)
+		{
+			pushCollapse(toVertex, neighbor);
+			pushCollapse(neighbor, toVertex);
+		}
+	}
+
+}
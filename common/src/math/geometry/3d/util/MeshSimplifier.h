@@ -0,0 +1,71 @@
+#ifndef URCHINENGINE_MESHSIMPLIFIER_H
+#define URCHINENGINE_MESHSIMPLIFIER_H
+
+#include <vector>
+#include <array>
+#include <queue>
+
+#include "math/algebra/point/Point3.h"
+
+namespace urchin
+{
+
+	/**
+	* Simplify a triangle mesh by successive edge collapses ordered by their quadric error (Garland-Heckbert).
+	* An edge is collapsed into one of its vertices: simplified triangles reference the original vertices and all vertex attributes
+	* (texture coordinates, weights...) stay valid. Vertices on a border are kept: texture seams (vertices duplicated because of their
+	* texture coordinates) are borders of the index topology and are not altered.
+	* Successive calls to simplify() continue the simplification: levels of detail are built from the finest to the coarsest.
+	*/
+	class MeshSimplifier
+	{
+		public:
+			MeshSimplifier(const Point3<float> *, unsigned int, const unsigned int *, unsigned int);
+
+			unsigned int getTrianglesCount() const;
+			std::vector<unsigned int> simplify(unsigned int);
+
+		private:
+			struct Quadric
+			{
+				Quadric();
+
+				void addPlane(double, double, double, double, double);
+				void add(const Quadric &);
+				double evaluate(const Point3<float> &) const;
+
+				double values[10]; //upper triangle of the symmetric matrix 4x4
+			};
+
+			struct Collapse
+			{
+				double cost;
+				unsigned int fromVertex, toVertex;
+				unsigned int fromVersion, toVersion;
+
+				bool operator <(const Collapse &) const;
+			};
+
+			void lockBorderVertices();
+			void collectNeighbors(unsigned int, std::vector<unsigned int> &) const;
+			void pushCollapse(unsigned int, unsigned int);
+			bool isCollapseValid(unsigned int, unsigned int);
+			void collapse(unsigned int, unsigned int);
+
+			std::vector<Point3<float>> positions;
+			std::vector<Quadric> quadrics;
+			std::vector<bool> lockedVertices, removedVertices;
+			std::vector<unsigned int> versions; //incremented when the collapses of a vertex become obsolete
+			std::vector<std::vector<unsigned int>> vertexTriangles; //can contain removed triangles
+
+			std::vector<std::array<unsigned int, 3>> triangles;
+			std::vector<bool> removedTriangles;
+			unsigned int trianglesCount;
+
+			std::priority_queue<Collapse> collapses;
+			std::vector<unsigned int> neighbors, otherNeighbors;
+	};
+
+}
+
+#endif
@@ -0,0 +1,358 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <string>
+#include <stdexcept>
+
+#include "OcclusionBuffer.h"
+
+namespace urchin
+{
+
+	/**
+	* @param width Width of the buffer in texels
+	* @param height Height of the buffer in texels
+	*/
+	OcclusionBuffer::OcclusionBuffer(unsigned int width, unsigned int height) :
+			width(width),
+			height(height),
+			bHasOccluder(false)
+	{
+		if(width==0 || height==0)
+		{
+			throw std::invalid_argument("Occlusion buffer size must be positive: " + std::to_string(width) + "x" + std::to_string(height));
+		}
+
+		unsigned int levelWidth = width, levelHeight = height, levelOffset = 0;
+		while(true)
+		{
+			levelsWidth.push_back(levelWidth);
+			levelsHeight.push_back(levelHeight);
+			levelsOffset.push_back(levelOffset);
+			levelOffset += levelWidth * levelHeight;
+
+			if(levelWidth==1 && levelHeight==1)
+			{
+				break;
+			}
+			levelWidth = (levelWidth + 1) / 2;
+			levelHeight = (levelHeight + 1) / 2;
+		}
+
+		depths.resize(levelOffset, 1.0f);
+	}
+
+	unsigned int OcclusionBuffer::getWidth() const
+	{
+		return width;
+	}
+
+	unsigned int OcclusionBuffer::getHeight() const
+	{
+		return height;
+	}
+
+	/**
+	* Clears the buffer (all depths on far plane) before the rasterization of the occluders
+	* @param viewProjectionMatrix Projection matrix multiplied by the view matrix
+	*/
+	void OcclusionBuffer::clear(const Matrix4<float> &viewProjectionMatrix)
+	{
+		this->viewProjectionMatrix = viewProjectionMatrix;
+		this->bHasOccluder = false;
+
+		std::fill(depths.begin(), depths.end(), 1.0f);
+	}
+
+	/**
+	* Rasterizes the triangles of an occluder in the depth buffer (level 0). Triangles are not culled: back faces are rasterized.
+	* @param modelMatrix Model matrix of the occluder
+	* @param vertices Vertices of the occluder in model space
+	* @param indices Vertices indices of the triangles (three indices per triangle)
+	*/
+	void OcclusionBuffer::rasterizeTriangles(const Matrix4<float> &modelMatrix, const Point3<float> *vertices, unsigned int verticesCount,
+			const unsigned int *indices, unsigned int indicesCount)
+	{
+		Matrix4<float> modelViewProjectionMatrix = viewProjectionMatrix * modelMatrix;
+
+		clipVertices.resize(verticesCount);
+		for(unsigned int i=0; i<verticesCount; ++i)
+		{
+			clipVertices[i] = modelViewProjectionMatrix * Point4<float>(vertices[i]);
+		}
+
+		for(unsigned int i=0; i + 2 < indicesCount; i+=3)
+		{
+			clipAndRasterizeTriangle(clipVertices[indices[i]], clipVertices[indices[i + 1]], clipVertices[indices[i + 2]]);
+		}
+
+		bHasOccluder = true;
+	}
+
+	/**
+	* Triangles crossing the near plane are clipped. Other frustum planes don't need clipping: window coordinates are clamped to the buffer.
+	*/
+	void OcclusionBuffer::clipAndRasterizeTriangle(const Point4<float> &clip0, const Point4<float> &clip1, const Point4<float> &clip2)
+	{
+		const Point4<float> *triangle[3] = {&clip0, &clip1, &clip2};
+		float nearDistances[3]; //distance to near plane in clip space (positive: in front of near plane)
+		unsigned int frontCount = 0;
+		for(unsigned int i=0; i<3; ++i)
+		{
+			nearDistances[i] = triangle[i]->Z + triangle[i]->W;
+			frontCount += nearDistances[i] > 0.0f ? 1 : 0;
+		}
+
+		if(frontCount==3)
+		{
+			rasterizeTriangle(clip0, clip1, clip2);
+		}else if(frontCount > 0)
+		{ //polygon of 3 or 4 vertices after clipping
+			Point4<float> polygon[4];
+			unsigned int polygonSize = 0;
+			for(unsigned int i=0; i<3; ++i)
+			{
+				unsigned int next = (i + 1) % 3;
+				if(nearDistances[i] > 0.0f)
+				{
+					polygon[polygonSize++] = *triangle[i];
+				}
+				if((nearDistances[i] > 0.0f) != (nearDistances[next] > 0.0f))
+				{
+					float t = nearDistances[i] / (nearDistances[i] - nearDistances[next]);
+					polygon[polygonSize++] = *triangle[i] + (*triangle[next] - *triangle[i]) * t;
+				}
+			}
+
+			for(unsigned int i=1; i + 1 < polygonSize; ++i)
+			{
+				rasterizeTriangle(polygon[0], polygon[i], polygon[i + 1]);
+			}
+		}
+	}
+
+	/**
+	* Rasterizes a triangle in front of near plane conservatively: a texel is only written when the triangle covers it entirely
+	* and the farthest depth of the triangle over the texel is kept. Therefore, texels crossed by the triangle edges are not
+	* written and the occluders are slightly eroded.
+	*/
+	void OcclusionBuffer::rasterizeTriangle(const Point4<float> &clip0, const Point4<float> &clip1, const Point4<float> &clip2)
+	{
+		const Point4<float> *triangle[3] = {&clip0, &clip1, &clip2};
+		float x[3], y[3], z[3];
+		for(unsigned int i=0; i<3; ++i)
+		{
+			float inverseW = 1.0f / triangle[i]->W;
+			x[i] = (triangle[i]->X * inverseW * 0.5f + 0.5f) * width;
+			y[i] = (triangle[i]->Y * inverseW * 0.5f + 0.5f) * height;
+			z[i] = triangle[i]->Z * inverseW * 0.5f + 0.5f;
+		}
+
+		float area = (x[1] - x[0]) * (y[2] - y[0]) - (x[2] - x[0]) * (y[1] - y[0]);
+		if(std::abs(area) < 0.00001f)
+		{ //degenerated triangle or triangle parallel to view direction
+			return;
+		}
+		if(area < 0.0f)
+		{ //counter clockwise order: edge functions are positive inside the triangle
+			std::swap(x[1], x[2]);
+			std::swap(y[1], y[2]);
+			std::swap(z[1], z[2]);
+			area = -area;
+		}
+
+		float minX = std::max(std::min(std::min(x[0], x[1]), x[2]), 0.0f);
+		float maxX = std::min(std::max(std::max(x[0], x[1]), x[2]), static_cast<float>(width) - 1.0f);
+		float minY = std::max(std::min(std::min(y[0], y[1]), y[2]), 0.0f);
+		float maxY = std::min(std::max(std::max(y[0], y[1]), y[2]), static_cast<float>(height) - 1.0f);
+		if(minX > maxX || minY > maxY)
+		{ //outside the buffer
+			return;
+		}
+		auto startX = static_cast<unsigned int>(minX), endX = static_cast<unsigned int>(maxX);
+		auto startY = static_cast<unsigned int>(minY), endY = static_cast<unsigned int>(maxY);
+
+		//edge function 'i' (edge opposite to vertex 'i'): a[i]*px + b[i]*py + c[i]
+		//the minimum of an edge function over a texel is its value at the texel center minus 'offset'
+		float a[3], b[3], c[3], offset[3];
+		for(unsigned int i=0; i<3; ++i)
+		{
+			unsigned int i1 = (i + 1) % 3, i2 = (i + 2) % 3;
+			a[i] = y[i1] - y[i2];
+			b[i] = x[i2] - x[i1];
+			c[i] = x[i1]*y[i2] - x[i2]*y[i1];
+			offset[i] = 0.5f * (std::abs(a[i]) + std::abs(b[i]));
+		}
+
+		//depth is linear in window space: depth = depthDx*px + depthDy*py + depthC
+		//the maximum of the depth over a texel is its value at the texel center plus 'depthOffset'
+		float inverseArea = 1.0f / area;
+		float depthDx = (a[0]*z[0] + a[1]*z[1] + a[2]*z[2]) * inverseArea;
+		float depthDy = (b[0]*z[0] + b[1]*z[1] + b[2]*z[2]) * inverseArea;
+		float depthC = (c[0]*z[0] + c[1]*z[1] + c[2]*z[2]) * inverseArea;
+		float depthOffset = 0.5f * (std::abs(depthDx) + std::abs(depthDy));
+
+		for(unsigned int py=startY; py<=endY; ++py)
+		{
+			float centerY = static_cast<float>(py) + 0.5f;
+			float rowEdge0 = b[0]*centerY + c[0] - offset[0], rowEdge1 = b[1]*centerY + c[1] - offset[1], rowEdge2 = b[2]*centerY + c[2] - offset[2];
+			float rowDepth = depthDy*centerY + depthC + depthOffset;
+			float *rowDepths = &depths[py * width];
+
+			//branch free loop in order to be vectorized by the compiler
+			for(unsigned int px=startX; px<=endX; ++px)
+			{
+				float centerX = static_cast<float>(px) + 0.5f;
+				float edge0 = a[0]*centerX + rowEdge0;
+				float edge1 = a[1]*centerX + rowEdge1;
+				float edge2 = a[2]*centerX + rowEdge2;
+				float farthestDepth = depthDx*centerX + rowDepth;
+
+				bool covered = (edge0 >= 0.0f) & (edge1 >= 0.0f) & (edge2 >= 0.0f) & (farthestDepth < rowDepths[px]);
+				rowDepths[px] = covered ? farthestDepth : rowDepths[px];
+			}
+		}
+	}
+
+	/**
+	* Builds the hierarchy of depths from the depth buffer. Must be called after the rasterization of all the occluders.
+	*/
+	void OcclusionBuffer::buildHierarchicalDepth()
+	{
+		for(unsigned int level=1; level<levelsOffset.size(); ++level)
+		{
+			unsigned int previousWidth = levelsWidth[level - 1], previousHeight = levelsHeight[level - 1];
+			const float *previousDepths = &depths[levelsOffset[level - 1]];
+			float *levelDepths = &depths[levelsOffset[level]];
+
+			for(unsigned int py=0; py<levelsHeight[level]; ++py)
+			{
+				unsigned int y0 = py * 2, y1 = std::min(py * 2 + 1, previousHeight - 1);
+				for(unsigned int px=0; px<levelsWidth[level]; ++px)
+				{
+					unsigned int x0 = px * 2, x1 = std::min(px * 2 + 1, previousWidth - 1);
+					levelDepths[py * levelsWidth[level] + px] = std::max(
+							std::max(previousDepths[y0 * previousWidth + x0], previousDepths[y0 * previousWidth + x1]),
+							std::max(previousDepths[y1 * previousWidth + x0], previousDepths[y1 * previousWidth + x1]));
+				}
+			}
+		}
+	}
+
+	/**
+	* @return True when at least one occluder has been rasterized since the last clear
+	*/
+	bool OcclusionBuffer::hasOccluder() const
+	{
+		return bHasOccluder;
+	}
+
+	/**
+	* @return Depth of the texel (level 0)
+	*/
+	float OcclusionBuffer::getDepth(unsigned int x, unsigned int y) const
+	{
+		if(x >= width || y >= height)
+		{
+			throw std::out_of_range("Texel (" + std::to_string(x) + ", " + std::to_string(y) + ") is outside the occlusion buffer.");
+		}
+
+		return depths[y * width + x];
+	}
+
+	/**
+	* Tests the bounding box against the hierarchy of depths. Method can be called by several threads at the same time.
+	* @return True when the bounding box is potentially visible: false when it is occluded or outside the buffer
+	*/
+	bool OcclusionBuffer::isVisible(const AABBox<float> &aabbox) const
+	{
+		if(!bHasOccluder)
+		{
+			return true;
+		}
+
+		float minX = std::numeric_limits<float>::max(), maxX = -std::numeric_limits<float>::max();
+		float minY = std::numeric_limits<float>::max(), maxY = -std::numeric_limits<float>::max();
+		float minDepth = std::numeric_limits<float>::max();
+		const Point3<float> &boxMin = aabbox.getMin();
+		const Point3<float> &boxMax = aabbox.getMax();
+		for(unsigned int i=0; i<8; ++i)
+		{
+			Point4<float> point((i & 1u) ? boxMax.X : boxMin.X, (i & 2u) ? boxMax.Y : boxMin.Y, (i & 4u) ? boxMax.Z : boxMin.Z, 1.0f);
+			Point4<float> corner = viewProjectionMatrix * point;
+			if(corner.Z + corner.W <= 0.0f)
+			{ //bounding box crosses the near plane
+				return true;
+			}
+
+			float inverseW = 1.0f / corner.W;
+			float x = (corner.X * inverseW * 0.5f + 0.5f) * width;
+			float y = (corner.Y * inverseW * 0.5f + 0.5f) * height;
+			minX = std::min(minX, x);
+			maxX = std::max(maxX, x);
+			minY = std::min(minY, y);
+			maxY = std::max(maxY, y);
+			minDepth = std::min(minDepth, corner.Z * inverseW * 0.5f + 0.5f);
+		}
+
+		if(maxX < 0.0f || minX >= static_cast<float>(width) || maxY < 0.0f || minY >= static_cast<float>(height))
+		{
+			return false;
+		}
+		auto startX = static_cast<unsigned int>(std::max(minX, 0.0f));
+		auto endX = static_cast<unsigned int>(std::min(maxX, static_cast<float>(width) - 1.0f));
+		auto startY = static_cast<unsigned int>(std::max(minY, 0.0f));
+		auto endY = static_cast<unsigned int>(std::min(maxY, static_cast<float>(height) - 1.0f));
+
+		//start on the coarsest level where the projection covers at most 4x4 texels
+		unsigned int level = 0;
+		while((endX >> level) - (startX >> level) > 3 || (endY >> level) - (startY >> level) > 3)
+		{
+			level++;
+		}
+
+		TexelArea area = {startX, startY, endX, endY};
+		for(unsigned int py=startY >> level; py<=endY >> level; ++py)
+		{
+			for(unsigned int px=startX >> level; px<=endX >> level; ++px)
+			{
+				if(isTexelVisible(level, px, py, area, minDepth))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+	/**
+	* @param area Texels area (level 0) covered by the bounding box
+	* @return True when a texel of level 0 inside the area and inside the texel (x, y) of the level is behind the depth
+	*/
+	bool OcclusionBuffer::isTexelVisible(unsigned int level, unsigned int x, unsigned int y, const TexelArea &area, float depth) const
+	{
+		if(depths[levelsOffset[level] + y * levelsWidth[level] + x] < depth)
+		{ //all texels of the sub levels are in front of the depth
+			return false;
+		}else if(level==0)
+		{
+			return true;
+		}
+
+		unsigned int subLevel = level - 1;
+		unsigned int startX = std::max(x * 2, area.startX >> subLevel), endX = std::min(std::min(x * 2 + 1, area.endX >> subLevel), levelsWidth[subLevel] - 1);
+		unsigned int startY = std::max(y * 2, area.startY >> subLevel), endY = std::min(std::min(y * 2 + 1, area.endY >> subLevel), levelsHeight[subLevel] - 1);
+		for(unsigned int subY=startY; subY<=endY; ++subY)
+		{
+			for(unsigned int subX=startX; subX<=endX; ++subX)
+			{
+				if(isTexelVisible(subLevel, subX, subY, area, depth))
+				{
+					return true;
+				}
+			}
+		}
+		return false;
+	}
+
+}
@@ -0,0 +1,58 @@
+#ifndef URCHINENGINE_OCCLUSIONBUFFER_H
+#define URCHINENGINE_OCCLUSIONBUFFER_H
+
+#include <vector>
+
+#include "math/algebra/matrix/Matrix4.h"
+#include "math/algebra/point/Point3.h"
+#include "math/algebra/point/Point4.h"
+#include "math/geometry/3d/object/AABBox.h"
+
+namespace urchin
+{
+
+	/**
+	* Low resolution depth buffer filled on CPU by the rasterization of occluder triangles.
+	* Bounding boxes are tested against a hierarchy of depths: each level stores the farthest depth of 2x2 texels of the previous
+	* level. A bounding box is occluded when its nearest depth is behind the farthest depth of all texels covered by its projection.
+	* Depths are window depths: 0.0 on near plane and 1.0 on far plane.
+	*/
+	class OcclusionBuffer
+	{
+		public:
+			OcclusionBuffer(unsigned int, unsigned int);
+
+			unsigned int getWidth() const;
+			unsigned int getHeight() const;
+
+			void clear(const Matrix4<float> &);
+			void rasterizeTriangles(const Matrix4<float> &, const Point3<float> *, unsigned int, const unsigned int *, unsigned int);
+			void buildHierarchicalDepth();
+
+			bool hasOccluder() const;
+			float getDepth(unsigned int, unsigned int) const;
+			bool isVisible(const AABBox<float> &) const;
+
+		private:
+			struct TexelArea
+			{
+				unsigned int startX, startY, endX, endY;
+			};
+
+			void clipAndRasterizeTriangle(const Point4<float> &, const Point4<float> &, const Point4<float> &);
+			void rasterizeTriangle(const Point4<float> &, const Point4<float> &, const Point4<float> &);
+			bool isTexelVisible(unsigned int, unsigned int, unsigned int, const TexelArea &, float) const;
+
+			unsigned int width, height;
+			Matrix4<float> viewProjectionMatrix;
+			bool bHasOccluder;
+
+			std::vector<float> depths; //depths of all levels (level 0: full resolution)
+			std::vector<unsigned int> levelsWidth, levelsHeight, levelsOffset;
+
+			std::vector<Point4<float>> clipVertices;
+	};
+
+}
+
+#endif
@@ -0,0 +1,59 @@
+#include "tools/ConfigKey.h"
+
+namespace urchin
+{
+
+	/**
+	* @param propertyName Name of the property. Property must exist in the properties loaded by the ConfigService.
+	*/
+	template<class T> ConfigKey<T>::ConfigKey(const std::string &propertyName) :
+			propertyName(propertyName),
+			configService(ConfigService::instance()),
+			slot(configService->registerKey(propertyName))
+	{
+
+	}
+
+	template<class T> ConfigKey<T>::ConfigKey(const ConfigKey &configKey) :
+			ConfigKey(configKey.propertyName)
+	{
+
+	}
+
+	template<class T> ConfigKey<T>::~ConfigKey()
+	{
+		configService->unregisterKey(slot);
+	}
+
+	template<class T> const std::string &ConfigKey<T>::getPropertyName() const
+	{
+		return propertyName;
+	}
+
+	template<> unsigned int ConfigKey<unsigned int>::getValue() const
+	{
+		return configService->getValuesTable()[slot].unsignedIntValue;
+	}
+
+	template<> float ConfigKey<float>::getValue() const
+	{
+		return configService->getValuesTable()[slot].floatValue;
+	}
+
+	template<> std::string ConfigKey<std::string>::getValue() const
+	{
+		return configService->getValuesTable()[slot].stringValue;
+	}
+
+	template<> bool ConfigKey<bool>::getValue() const
+	{
+		return configService->getValuesTable()[slot].boolValue;
+	}
+
+	//explicit template
+	template class ConfigKey<unsigned int>;
+	template class ConfigKey<float>;
+	template class ConfigKey<std::string>;
+	template class ConfigKey<bool>;
+
+}
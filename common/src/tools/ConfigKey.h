@@ -0,0 +1,40 @@
+#ifndef URCHINENGINE_CONFIGKEY_H
+#define URCHINENGINE_CONFIGKEY_H
+
+#include <string>
+
+#include "tools/ConfigService.h"
+
+namespace urchin
+{
+
+	/**
+	* Precompiled key on a configuration property: the property name is resolved once at construction.
+	* Reading the value is an atomic load of the current values table of the ConfigService. Therefore, values
+	* read through a key are updated on ConfigService::reloadProperties and can be read from any thread.
+	*/
+	template<class T> class ConfigKey
+	{
+		public:
+			explicit ConfigKey(const std::string &);
+			ConfigKey(const ConfigKey &);
+			~ConfigKey();
+			ConfigKey &operator=(const ConfigKey &) = delete;
+
+			const std::string &getPropertyName() const;
+			T getValue() const;
+
+		private:
+			std::string propertyName;
+			ConfigService *configService;
+			unsigned int slot;
+	};
+
+	template<> unsigned int ConfigKey<unsigned int>::getValue() const;
+	template<> float ConfigKey<float>::getValue() const;
+	template<> std::string ConfigKey<std::string>::getValue() const;
+	template<> bool ConfigKey<bool>::getValue() const;
+
+}
+
+#endif
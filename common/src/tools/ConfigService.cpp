@@ -9,9 +9,10 @@ namespace urchin
 {
 
 	ConfigService::ConfigService() :
-			Singleton<ConfigService>()
+			Singleton<ConfigService>(),
+			valuesTable(nullptr)
 	{
-
+		publishValues(std::unique_ptr<const std::vector<ConfigValue>>(new std::vector<ConfigValue>()));
 	}
 
 	void ConfigService::loadProperties(const std::string &propertiesFile, const std::map<std::string, std::string> &placeholders)
@@ -25,37 +26,203 @@ namespace urchin
 	void ConfigService::loadProperties(const std::string &propertiesFile, const std::string &workingDirectory,
 			const std::map<std::string, std::string> &placeholders)
 	{
+		LoadedPropertiesFile loadedPropertiesFile;
+		loadedPropertiesFile.propertiesFilePath = workingDirectory + propertiesFile;
+		loadedPropertiesFile.placeholders = placeholders;
+
+		std::lock_guard<std::mutex> lock(keysMutex);
+		loadPropertiesFile(loadedPropertiesFile, properties, floatProperties, unsignedIntProperties);
+		loadedPropertiesFiles.push_back(loadedPropertiesFile);
+	}
+
+	/**
+	 * Reload all the properties files previously loaded and publish the new values to the config keys.
+	 * Values read through the config keys are updated atomically: a reader sees either all old values or all new values.
+	 * When a properties file cannot be read or a property of a config key doesn't exist anymore, an exception is thrown
+	 * and the previous properties are kept.
+	 * Values read by property name should not be read concurrently to this method.
+	 */
+	void ConfigService::reloadProperties()
+	{
+		std::lock_guard<std::mutex> lock(keysMutex);
+		reloadPropertiesFiles(loadedPropertiesFiles);
+	}
+
+	/**
+	 * Remove the properties of a properties file previously loaded. Properties of the other files are reloaded.
+	 * @param workingDirectory Working directory used to load the properties file
+	 */
+	void ConfigService::unloadProperties(const std::string &propertiesFile, const std::string &workingDirectory)
+	{
+		std::lock_guard<std::mutex> lock(keysMutex);
+
 		std::string propertiesFilePath = workingDirectory + propertiesFile;
-		PropertyFileHandler propertyFileHandler(propertiesFilePath);
+		std::vector<LoadedPropertiesFile> remainingPropertiesFiles;
+		for(const auto &loadedPropertiesFile : loadedPropertiesFiles)
+		{
+			if(loadedPropertiesFile.propertiesFilePath!=propertiesFilePath)
+			{
+				remainingPropertiesFiles.push_back(loadedPropertiesFile);
+			}
+		}
+		if(remainingPropertiesFiles.size()==loadedPropertiesFiles.size())
+		{
+			throw std::invalid_argument("The properties file " + propertiesFilePath + " is not loaded.");
+		}
+
+		reloadPropertiesFiles(remainingPropertiesFiles);
+		loadedPropertiesFiles = remainingPropertiesFiles;
+	}
+
+	void ConfigService::loadPropertiesFile(const LoadedPropertiesFile &loadedPropertiesFile, std::map<std::string, std::string> &targetProperties,
+			std::map<std::string, float> &targetFloatProperties, std::map<std::string, unsigned int> &targetUnsignedIntProperties) const
+	{
+		PropertyFileHandler propertyFileHandler(loadedPropertiesFile.propertiesFilePath);
 		auto loadedProperties = propertyFileHandler.loadPropertyFile();
 
 		//replace placeholders
 		for(auto &property : loadedProperties)
 		{
-			auto itFind = placeholders.find(property.second);
-			if(itFind!=placeholders.end())
+			auto itFind = loadedPropertiesFile.placeholders.find(property.second);
+			if(itFind!=loadedPropertiesFile.placeholders.end())
 			{
 				property.second = itFind->second;
 			}
 		}
 
         //copy loaded properties into properties
-        properties.insert(loadedProperties.begin(), loadedProperties.end());
+        targetProperties.insert(loadedProperties.begin(), loadedProperties.end());
 
         //build specific maps for performance reason (numeric conversion is slow)
         for(const auto &property : loadedProperties)
         {
             if(Converter::isUnsignedInt(property.second))
             {
-                unsignedIntProperties[property.first] = Converter::toUnsignedInt(property.second);
+                targetUnsignedIntProperties[property.first] = Converter::toUnsignedInt(property.second);
             }
             if(Converter::isFloat(property.second))
             {
-                floatProperties[property.first] = Converter::toFloat(property.second);
+                targetFloatProperties[property.first] = Converter::toFloat(property.second);
             }
         }
 	}
 
+	/**
+	 * Read the properties files in temporary maps and build the new values table before replacing the current properties:
+	 * current properties stay unchanged when an exception is thrown. Keys mutex must be locked.
+	 */
+	void ConfigService::reloadPropertiesFiles(const std::vector<LoadedPropertiesFile> &propertiesFiles)
+	{
+		std::map<std::string, std::string> newProperties;
+		std::map<std::string, float> newFloatProperties;
+		std::map<std::string, unsigned int> newUnsignedIntProperties;
+		for(const auto &loadedPropertiesFile : propertiesFiles)
+		{
+			loadPropertiesFile(loadedPropertiesFile, newProperties, newFloatProperties, newUnsignedIntProperties);
+		}
+
+		std::unique_ptr<std::vector<ConfigValue>> newValues(new std::vector<ConfigValue>());
+		newValues->reserve(keyNames.size());
+		for(unsigned int slot=0; slot<keyNames.size(); ++slot)
+		{
+			if(keyReferences[slot] > 0)
+			{
+				newValues->push_back(buildConfigValue(keyNames[slot], newProperties, newFloatProperties, newUnsignedIntProperties));
+			}else
+			{
+				newValues->push_back(ConfigValue{});
+			}
+		}
+
+		properties.swap(newProperties);
+		floatProperties.swap(newFloatProperties);
+		unsignedIntProperties.swap(newUnsignedIntProperties);
+		publishValues(std::move(newValues));
+	}
+
+	ConfigService::ConfigValue ConfigService::buildConfigValue(const std::string &propertyName, const std::map<std::string, std::string> &sourceProperties,
+			const std::map<std::string, float> &sourceFloatProperties, const std::map<std::string, unsigned int> &sourceUnsignedIntProperties) const
+	{
+		auto it = sourceProperties.find(propertyName);
+		if(it==sourceProperties.end())
+		{
+			throw std::invalid_argument("The property " + propertyName + " doesn't exist.");
+		}
+
+		ConfigValue configValue;
+		configValue.stringValue = it->second;
+		configValue.boolValue = (it->second == "true");
+
+		auto itUnsignedInt = sourceUnsignedIntProperties.find(propertyName);
+		configValue.unsignedIntValue = itUnsignedInt!=sourceUnsignedIntProperties.end() ? itUnsignedInt->second : 0;
+
+		auto itFloat = sourceFloatProperties.find(propertyName);
+		configValue.floatValue = itFloat!=sourceFloatProperties.end() ? itFloat->second : 0.0f;
+
+		return configValue;
+	}
+
+	/**
+	 * Replace the values table read by the config keys. The previous tables are kept until the service destruction: a config key
+	 * can still read a previous table. Tables are published on keys registration and properties reload only.
+	 */
+	void ConfigService::publishValues(std::unique_ptr<const std::vector<ConfigValue>> newValues)
+	{
+		valuesTable.store(newValues.get(), std::memory_order_release);
+		publishedValuesTables.push_back(std::move(newValues));
+	}
+
+	/**
+	 * @return Slot of the property in the values table. Slot is stable: it's never modified by a reload of the properties.
+	 */
+	unsigned int ConfigService::registerKey(const std::string &propertyName)
+	{
+		std::lock_guard<std::mutex> lock(keysMutex);
+
+		auto itSlot = keySlots.find(propertyName);
+		if(itSlot!=keySlots.end() && keyReferences[itSlot->second] > 0)
+		{
+			keyReferences[itSlot->second]++;
+			return itSlot->second;
+		}
+
+		//values table is copied: readers of the current table are not disturbed
+		std::unique_ptr<std::vector<ConfigValue>> newValues(new std::vector<ConfigValue>(getValuesTable()));
+		ConfigValue configValue = buildConfigValue(propertyName, properties, floatProperties, unsignedIntProperties);
+
+		unsigned int slot;
+		if(itSlot!=keySlots.end())
+		{ //slot not reloaded since its last key has been destroyed
+			slot = itSlot->second;
+			(*newValues)[slot] = configValue;
+		}else
+		{
+			slot = static_cast<unsigned int>(keyNames.size());
+			newValues->push_back(configValue);
+			keyNames.push_back(propertyName);
+			keyReferences.push_back(0);
+			keySlots[propertyName] = slot;
+		}
+		keyReferences[slot]++;
+		publishValues(std::move(newValues));
+
+		return slot;
+	}
+
+	void ConfigService::unregisterKey(unsigned int slot)
+	{
+		std::lock_guard<std::mutex> lock(keysMutex);
+		keyReferences[slot]--;
+	}
+
+	/**
+	 * @return Current values table. The table stays valid until the service destruction, even after a reload.
+	 */
+	const std::vector<ConfigService::ConfigValue> &ConfigService::getValuesTable() const
+	{
+		return *valuesTable.load(std::memory_order_acquire);
+	}
+
 	bool ConfigService::isExist(const std::string &propertyName) const
 	{
 		auto it = properties.find(propertyName);
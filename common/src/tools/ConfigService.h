@@ -3,12 +3,18 @@
 
 #include <string>
 #include <map>
+#include <vector>
+#include <mutex>
+#include <memory>
+#include <atomic>
 
 #include "pattern/singleton/Singleton.h"
 
 namespace urchin
 {
 
+	template<class T> class ConfigKey;
+
 	/**
 	* Service to handle configuration properties files
 	*/
@@ -16,9 +22,12 @@ namespace urchin
 	{
 		public:
 			friend class Singleton<ConfigService>;
+			template<class T> friend class ConfigKey;
 
 			void loadProperties(const std::string &, const std::map<std::string, std::string> &placeholder={});
 			void loadProperties(const std::string &, const std::string &, const std::map<std::string, std::string> &placeholders={});
+			void reloadProperties();
+			void unloadProperties(const std::string &, const std::string &);
 
 			bool isExist(const std::string &) const;
 
@@ -29,12 +38,45 @@ namespace urchin
 			bool getBoolValue(const std::string &) const;
 		
 		private:
+			struct LoadedPropertiesFile
+			{
+				std::string propertiesFilePath;
+				std::map<std::string, std::string> placeholders;
+			};
+
+			struct ConfigValue
+			{
+				unsigned int unsignedIntValue;
+				float floatValue;
+				std::string stringValue;
+				bool boolValue;
+			};
+
 			ConfigService();
 			~ConfigService() override = default;
 
+			void loadPropertiesFile(const LoadedPropertiesFile &, std::map<std::string, std::string> &, std::map<std::string, float> &,
+					std::map<std::string, unsigned int> &) const;
+			void reloadPropertiesFiles(const std::vector<LoadedPropertiesFile> &);
+			ConfigValue buildConfigValue(const std::string &, const std::map<std::string, std::string> &, const std::map<std::string, float> &,
+					const std::map<std::string, unsigned int> &) const;
+			void publishValues(std::unique_ptr<const std::vector<ConfigValue>>);
+
+			unsigned int registerKey(const std::string &);
+			void unregisterKey(unsigned int);
+			const std::vector<ConfigValue> &getValuesTable() const;
+
 			std::map<std::string, std::string> properties;
 			std::map<std::string, float> floatProperties;
 			std::map<std::string, unsigned int> unsignedIntProperties;
+			std::vector<LoadedPropertiesFile> loadedPropertiesFiles;
+
+			mutable std::mutex keysMutex; //serialize the loads of properties files and the registrations of keys
+			std::map<std::string, unsigned int> keySlots;
+			std::vector<std::string> keyNames;
+			std::vector<unsigned int> keyReferences; //number of config keys by slot: values of unreferenced slots are not reloaded
+			std::atomic<const std::vector<ConfigValue> *> valuesTable;
+			std::vector<std::unique_ptr<const std::vector<ConfigValue>>> publishedValuesTables; //tables read by the config keys are freed with the service only
 	};
 }
 
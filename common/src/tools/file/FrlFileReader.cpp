@@ -0,0 +1,84 @@
+#include <fstream>
+#include <algorithm>
+#include <stdexcept>
+
+#include "tools/file/FrlFileReader.h"
+#include "system/FileSystem.h"
+#include "system/FileHandler.h"
+#include "libs/md5/md5.h"
+
+#define FRL_FILE_EXTENSION ".frl" //Extension for FRL files (Fast Resource Loading)
+
+namespace urchin
+{
+
+	/**
+	 * @param frlFilePath Path of the FRL file to read. A missing file is not an error: the header check will fail.
+	 */
+	FrlFileReader::FrlFileReader(const std::string &frlFilePath) :
+		offset(0)
+	{
+		if(std::ifstream(frlFilePath, std::ios::in | std::ios::binary).is_open())
+		{
+			try
+			{
+				mappedFile = std::make_shared<MemoryMappedFile>(frlFilePath);
+			}catch(std::invalid_argument &e)
+			{ //empty file: header check will fail
+				mappedFile.reset();
+			}
+		}
+	}
+
+	/**
+	 * @param resourceFilename Filename of the resource relative to the resources directory
+	 * @return Path of the FRL file caching the resource in the save directory. The FRL filename is built from the resource
+	 * filename and the MD5 of its relative path: resources having the same filename in different directories have distinct FRL files.
+	 */
+	std::string FrlFileReader::buildFrlFilePath(const std::string &resourceFilename)
+	{
+		std::string pathMd5 = std::string(MD5().digestString(const_cast<char *>(resourceFilename.c_str())));
+		return FileSystem::instance()->getSaveDirectory() + FileHandler::getFileName(resourceFilename) + "_" + pathMd5 + FRL_FILE_EXTENSION;
+	}
+
+	/**
+	 * @return True when the FRL file exists and has been written for the given version and MD5 of the resource file
+	 */
+	bool FrlFileReader::checkHeader(unsigned int version, const std::string &md5)
+	{
+		std::size_t headerSize = sizeof(unsigned int) + md5.size();
+		if(!mappedFile || mappedFile->getSize() < headerSize)
+		{
+			return false;
+		}
+
+		offset = 0;
+		return readValue<unsigned int>()==version && std::string(read(md5.size()), md5.size())==md5;
+	}
+
+	const std::shared_ptr<MemoryMappedFile> &FrlFileReader::getMappedFile() const
+	{
+		return mappedFile;
+	}
+
+	std::string FrlFileReader::readString()
+	{
+		unsigned int size;
+		const char *value = readArray<char>(size);
+		return std::string(value, size);
+	}
+
+	const char *FrlFileReader::read(std::size_t size)
+	{
+		if(size > mappedFile->getSize() - offset)
+		{
+			throw std::runtime_error("File " + mappedFile->getFilenamePath() + " is corrupted.");
+		}
+
+		const char *data = mappedFile->getData() + offset;
+		offset += size + (sizeof(unsigned int) - size % sizeof(unsigned int)) % sizeof(unsigned int);
+		offset = std::min(offset, mappedFile->getSize());
+		return data;
+	}
+
+}
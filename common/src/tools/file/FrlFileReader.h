@@ -0,0 +1,42 @@
+#ifndef URCHINENGINE_FRLFILEREADER_H
+#define URCHINENGINE_FRLFILEREADER_H
+
+#include <string>
+#include <memory>
+#include <cstring>
+
+#include "tools/file/MemoryMappedFile.h"
+
+namespace urchin
+{
+
+	/**
+	* Reader of FRL files written by FrlFileWriter. The file is memory mapped: arrays are returned as pointers on the
+	* mapped file which stay valid as long as the mapped file is referenced.
+	*/
+	class FrlFileReader
+	{
+		public:
+			explicit FrlFileReader(const std::string &);
+
+			static std::string buildFrlFilePath(const std::string &);
+
+			bool checkHeader(unsigned int, const std::string &);
+			const std::shared_ptr<MemoryMappedFile> &getMappedFile() const;
+
+			template<class T> T readValue();
+			template<class T> const T *readArray(unsigned int &);
+			std::string readString();
+
+		private:
+			const char *read(std::size_t);
+
+			std::shared_ptr<MemoryMappedFile> mappedFile;
+			std::size_t offset;
+	};
+
+	#include "FrlFileReader.inl"
+
+}
+
+#endif
@@ -0,0 +1,15 @@
+template<class T> T FrlFileReader::readValue()
+{
+	T value;
+	std::memcpy(&value, read(sizeof(T)), sizeof(T));
+	return value;
+}
+
+/**
+ * @param count [out] Number of values in the array
+ */
+template<class T> const T *FrlFileReader::readArray(unsigned int &count)
+{
+	count = readValue<unsigned int>();
+	return reinterpret_cast<const T *>(read(count * sizeof(T)));
+}
@@ -0,0 +1,52 @@
+#include <cstdio>
+#include <thread>
+
+#include "tools/file/FrlFileWriter.h"
+#include "tools/logger/Logger.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param frlFilePath Path of the FRL file to write
+	 * @param version Version of the FRL file format
+	 * @param md5 MD5 of the resource file
+	 */
+	FrlFileWriter::FrlFileWriter(const std::string &frlFilePath, unsigned int version, const std::string &md5) :
+		frlFilePath(frlFilePath),
+		tmpFrlFilePath(frlFilePath + ".tmp" + std::to_string(std::hash<std::thread::id>()(std::this_thread::get_id())))
+	{
+		file.open(tmpFrlFilePath, std::ios::out | std::ios::binary | std::ios::trunc); //on failure, next writings are ignored
+
+		writeValue(version);
+		write(md5.c_str(), md5.size());
+	}
+
+	void FrlFileWriter::writeString(const std::string &value)
+	{
+		writeArray(value.c_str(), static_cast<unsigned int>(value.size()));
+	}
+
+	/**
+	 * Replaces the FRL file by the written file. A writing failure is not fatal: the resource is simply not cached.
+	 */
+	void FrlFileWriter::commit()
+	{
+		bool writeFailed = file.fail();
+		file.close();
+		if(writeFailed || file.fail() || std::rename(tmpFrlFilePath.c_str(), frlFilePath.c_str())!=0)
+		{
+			std::remove(tmpFrlFilePath.c_str());
+			Logger::logger().logWarning("Cannot write the file " + frlFilePath + ".");
+		}
+	}
+
+	void FrlFileWriter::write(const void *data, std::size_t size)
+	{
+		static const char padding[sizeof(unsigned int)] = {};
+
+		file.write(static_cast<const char *>(data), size);
+		file.write(padding, (sizeof(unsigned int) - size % sizeof(unsigned int)) % sizeof(unsigned int));
+	}
+
+}
@@ -0,0 +1,39 @@
+#ifndef URCHINENGINE_FRLFILEWRITER_H
+#define URCHINENGINE_FRLFILEWRITER_H
+
+#include <string>
+#include <fstream>
+
+namespace urchin
+{
+
+	/**
+	* Writer of FRL files (Fast Resource Loading): binary cache of a resource file. The file starts with a version and the
+	* MD5 of the resource file. Each value is padded on 4 bytes so that the arrays can be used directly from a mapped file.
+	* The file is written in a temporary file (one per thread) and renamed by 'commit()': an interrupted writing never leaves
+	* a partial cache.
+	*/
+	class FrlFileWriter
+	{
+		public:
+			FrlFileWriter(const std::string &, unsigned int, const std::string &);
+
+			template<class T> void writeValue(const T &);
+			template<class T> void writeArray(const T *, unsigned int);
+			void writeString(const std::string &);
+
+			void commit();
+
+		private:
+			void write(const void *, std::size_t);
+
+			std::string frlFilePath;
+			std::string tmpFrlFilePath;
+			std::ofstream file;
+	};
+
+	#include "FrlFileWriter.inl"
+
+}
+
+#endif
@@ -0,0 +1,10 @@
+template<class T> void FrlFileWriter::writeValue(const T &value)
+{
+	write(&value, sizeof(T));
+}
+
+template<class T> void FrlFileWriter::writeArray(const T *values, unsigned int count)
+{
+	writeValue(count);
+	write(values, count * sizeof(T));
+}
@@ -0,0 +1,81 @@
+#include <stdexcept>
+#include <fstream>
+#ifndef _WIN32
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+#endif
+
+#include "tools/file/MemoryMappedFile.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param filenamePath Path to the file to map. An empty file cannot be mapped.
+	 */
+	MemoryMappedFile::MemoryMappedFile(const std::string &filenamePath) :
+			filenamePath(filenamePath),
+			data(nullptr),
+			dataSize(0)
+	{
+		#ifndef _WIN32
+			int fileDescriptor = open(filenamePath.c_str(), O_RDONLY);
+			struct stat fileStat = {};
+			if(fileDescriptor!=-1 && fstat(fileDescriptor, &fileStat)==0 && fileStat.st_size > 0)
+			{
+				void *mappedData = mmap(nullptr, static_cast<std::size_t>(fileStat.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+				if(mappedData!=MAP_FAILED)
+				{
+					data = static_cast<const char *>(mappedData);
+					dataSize = static_cast<std::size_t>(fileStat.st_size);
+				}
+			}
+			if(fileDescriptor!=-1)
+			{
+				close(fileDescriptor);
+			}
+		#else
+			std::ifstream file(filenamePath, std::ios::in | std::ios::binary | std::ios::ate);
+			if(file.is_open())
+			{
+				fileContent.resize(static_cast<std::size_t>(file.tellg()));
+				file.seekg(0, std::ios::beg);
+				if(!fileContent.empty() && file.read(fileContent.data(), fileContent.size()))
+				{
+					data = fileContent.data();
+					dataSize = fileContent.size();
+				}
+			}
+		#endif
+
+		if(!data)
+		{
+			throw std::invalid_argument("Cannot open or load the file " + filenamePath + ".");
+		}
+	}
+
+	MemoryMappedFile::~MemoryMappedFile()
+	{
+		#ifndef _WIN32
+			munmap(const_cast<char *>(data), dataSize);
+		#endif
+	}
+
+	const std::string &MemoryMappedFile::getFilenamePath() const
+	{
+		return filenamePath;
+	}
+
+	const char *MemoryMappedFile::getData() const
+	{
+		return data;
+	}
+
+	std::size_t MemoryMappedFile::getSize() const
+	{
+		return dataSize;
+	}
+
+}
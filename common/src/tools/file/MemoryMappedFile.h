@@ -0,0 +1,35 @@
+#ifndef URCHINENGINE_MEMORYMAPPEDFILE_H
+#define URCHINENGINE_MEMORYMAPPEDFILE_H
+
+#include <string>
+#include <vector>
+#include <cstddef>
+
+namespace urchin
+{
+
+	/**
+	* Read only file mapped in memory. On platforms without memory mapping support, the file is entirely read in memory.
+	*/
+	class MemoryMappedFile
+	{
+		public:
+			explicit MemoryMappedFile(const std::string &);
+			MemoryMappedFile(const MemoryMappedFile &) = delete;
+			MemoryMappedFile &operator=(const MemoryMappedFile &) = delete;
+			~MemoryMappedFile();
+
+			const std::string &getFilenamePath() const;
+			const char *getData() const;
+			std::size_t getSize() const;
+
+		private:
+			std::string filenamePath;
+			const char *data;
+			std::size_t dataSize;
+			std::vector<char> fileContent;
+	};
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include <stdexcept>
+#include <utility>
+
+#include "tools/image/BakedTexture.h"
+#include "tools/image/MipMapGenerator.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param width Width of the base level
+	 * @param height Height of the base level
+	 * @param levels Compressed blocks of each level starting by the base level
+	 */
+	BakedTexture::BakedTexture(BlockCompressor::BlockFormat blockFormat, unsigned int width, unsigned int height,
+			std::vector<std::vector<unsigned char>> &&levels) :
+		blockFormat(blockFormat),
+		width(width),
+		height(height),
+		levelsStorage(std::move(levels))
+	{
+		for(const auto &level : levelsStorage)
+		{
+			this->levels.push_back(level.data());
+		}
+	}
+
+	/**
+	 * @param levels Compressed blocks of each level starting by the base level. Blocks are stored in the mapped file.
+	 */
+	BakedTexture::BakedTexture(BlockCompressor::BlockFormat blockFormat, unsigned int width, unsigned int height,
+			const std::vector<const unsigned char *> &levels, std::shared_ptr<MemoryMappedFile> mappedFile) :
+		blockFormat(blockFormat),
+		width(width),
+		height(height),
+		mappedFile(std::move(mappedFile)),
+		levels(levels)
+	{
+
+	}
+
+	BlockCompressor::BlockFormat BakedTexture::getBlockFormat() const
+	{
+		return blockFormat;
+	}
+
+	unsigned int BakedTexture::getWidth() const
+	{
+		return width;
+	}
+
+	unsigned int BakedTexture::getHeight() const
+	{
+		return height;
+	}
+
+	unsigned int BakedTexture::getLevelsCount() const
+	{
+		return static_cast<unsigned int>(levels.size());
+	}
+
+	unsigned int BakedTexture::getLevelWidth(unsigned int level) const
+	{
+		return MipMapGenerator::computeLevelSize(width, level);
+	}
+
+	unsigned int BakedTexture::getLevelHeight(unsigned int level) const
+	{
+		return MipMapGenerator::computeLevelSize(height, level);
+	}
+
+	const unsigned char *BakedTexture::getLevelData(unsigned int level) const
+	{
+		return levels[level];
+	}
+
+	std::size_t BakedTexture::getLevelSize(unsigned int level) const
+	{
+		return BlockCompressor::computeCompressedSize(blockFormat, getLevelWidth(level), getLevelHeight(level));
+	}
+
+	/**
+	 * @return Memory size of all the levels (in bytes)
+	 */
+	std::size_t BakedTexture::getMemorySize() const
+	{
+		std::size_t memorySize = 0;
+		for(unsigned int level=0; level<getLevelsCount(); ++level)
+		{
+			memorySize += getLevelSize(level);
+		}
+		return memorySize;
+	}
+
+}
@@ -0,0 +1,47 @@
+#ifndef URCHINENGINE_BAKEDTEXTURE_H
+#define URCHINENGINE_BAKEDTEXTURE_H
+
+#include <vector>
+#include <memory>
+
+#include "tools/image/BlockCompressor.h"
+#include "tools/file/MemoryMappedFile.h"
+
+namespace urchin
+{
+
+	/**
+	* Texture ready to be sent to the graphic card: all mipmap levels compressed in blocks. Levels are stored in memory or
+	* in a mapped cache file.
+	*/
+	class BakedTexture
+	{
+		public:
+			BakedTexture(BlockCompressor::BlockFormat, unsigned int, unsigned int, std::vector<std::vector<unsigned char>> &&);
+			BakedTexture(BlockCompressor::BlockFormat, unsigned int, unsigned int, const std::vector<const unsigned char *> &, std::shared_ptr<MemoryMappedFile>);
+
+			BlockCompressor::BlockFormat getBlockFormat() const;
+			unsigned int getWidth() const;
+			unsigned int getHeight() const;
+
+			unsigned int getLevelsCount() const;
+			unsigned int getLevelWidth(unsigned int) const;
+			unsigned int getLevelHeight(unsigned int) const;
+			const unsigned char *getLevelData(unsigned int) const;
+			std::size_t getLevelSize(unsigned int) const;
+			std::size_t getMemorySize() const;
+
+		private:
+			BlockCompressor::BlockFormat blockFormat;
+			unsigned int width;
+			unsigned int height;
+
+			//levels are stored in the vectors or in the mapped file
+			std::vector<std::vector<unsigned char>> levelsStorage;
+			std::shared_ptr<MemoryMappedFile> mappedFile;
+			std::vector<const unsigned char *> levels;
+	};
+
+}
+
+#endif
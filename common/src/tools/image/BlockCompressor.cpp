@@ -0,0 +1,466 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <cstring>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#include "tools/image/BlockCompressor.h"
+
+#define BLOCK_TEXELS 16 //4x4 texels
+#define POWER_ITERATIONS 4
+
+namespace urchin
+{
+
+	/**
+	 * @param componentsCount Number of 8 bits components per texel: 1 (grayscale), 3 (RGB) or 4 (RGBA)
+	 * @return Blocks ordered by rows. Texels outside the image (size not multiple of 4) are copies of the image border.
+	 */
+	std::vector<unsigned char> BlockCompressor::compress(BlockFormat blockFormat, unsigned int width, unsigned int height,
+			unsigned int componentsCount, const unsigned char *texels) const
+	{
+		if(componentsCount!=1 && componentsCount!=3 && componentsCount!=4)
+		{
+			throw std::invalid_argument("Unsupported number of components for block compression: " + std::to_string(componentsCount) + ".");
+		}
+
+		std::vector<unsigned char> blocks(computeCompressedSize(blockFormat, width, height));
+		unsigned char *block = blocks.data();
+		unsigned char rgbaBlock[BLOCK_TEXELS * 4];
+
+		for(unsigned int blockY=0; blockY<height; blockY+=4)
+		{
+			for(unsigned int blockX=0; blockX<width; blockX+=4)
+			{
+				extractBlock(width, height, componentsCount, texels, blockX, blockY, rgbaBlock);
+
+				if(blockFormat==BC1)
+				{
+					compressColorBlock(rgbaBlock, block);
+				}else if(blockFormat==BC3)
+				{
+					compressChannelBlock(rgbaBlock, 3, block);
+					compressColorBlock(rgbaBlock, block + 8);
+				}else
+				{
+					compressChannelBlock(rgbaBlock, 0, block);
+					compressChannelBlock(rgbaBlock, 1, block + 8);
+				}
+
+				block += getBlockSize(blockFormat);
+			}
+		}
+
+		return blocks;
+	}
+
+	/**
+	 * @return Texels in RGBA format. For BC5 format, blue channel is 0 and alpha channel is 255.
+	 */
+	std::vector<unsigned char> BlockCompressor::decompress(BlockFormat blockFormat, unsigned int width, unsigned int height, const unsigned char *blocks) const
+	{
+		std::vector<unsigned char> texels(static_cast<std::size_t>(width) * height * 4);
+		const unsigned char *block = blocks;
+		unsigned char rgbaBlock[BLOCK_TEXELS * 4];
+
+		for(unsigned int blockY=0; blockY<height; blockY+=4)
+		{
+			for(unsigned int blockX=0; blockX<width; blockX+=4)
+			{
+				if(blockFormat==BC1)
+				{
+					decompressColorBlock(block, rgbaBlock);
+				}else if(blockFormat==BC3)
+				{
+					decompressColorBlock(block + 8, rgbaBlock);
+					decompressChannelBlock(block, 3, rgbaBlock);
+				}else
+				{
+					for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+					{
+						rgbaBlock[i*4 + 2] = 0;
+						rgbaBlock[i*4 + 3] = 255;
+					}
+					decompressChannelBlock(block, 0, rgbaBlock);
+					decompressChannelBlock(block + 8, 1, rgbaBlock);
+				}
+
+				for(unsigned int y=blockY; y<std::min(blockY + 4, height); ++y)
+				{
+					unsigned int blockWidth = std::min(blockX + 4, width) - blockX;
+					std::memcpy(&texels[(static_cast<std::size_t>(y) * width + blockX) * 4], &rgbaBlock[(y - blockY) * 16], blockWidth * 4);
+				}
+
+				block += getBlockSize(blockFormat);
+			}
+		}
+
+		return texels;
+	}
+
+	/**
+	 * @return Size of a block in bytes
+	 */
+	unsigned int BlockCompressor::getBlockSize(BlockFormat blockFormat)
+	{
+		return blockFormat==BC1 ? 8 : 16;
+	}
+
+	std::size_t BlockCompressor::computeCompressedSize(BlockFormat blockFormat, unsigned int width, unsigned int height)
+	{
+		return static_cast<std::size_t>((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(blockFormat);
+	}
+
+	/**
+	 * @param rgbaBlock [out] 4x4 texels of the block in RGBA format
+	 */
+	void BlockCompressor::extractBlock(unsigned int width, unsigned int height, unsigned int componentsCount, const unsigned char *texels,
+			unsigned int blockX, unsigned int blockY, unsigned char *rgbaBlock) const
+	{
+		for(unsigned int y=0; y<4; ++y)
+		{
+			unsigned int texelY = std::min(blockY + y, height - 1);
+			for(unsigned int x=0; x<4; ++x)
+			{
+				unsigned int texelX = std::min(blockX + x, width - 1);
+				const unsigned char *texel = texels + (static_cast<std::size_t>(texelY) * width + texelX) * componentsCount;
+				unsigned char *rgba = rgbaBlock + (y*4 + x) * 4;
+
+				rgba[0] = texel[0];
+				rgba[1] = componentsCount==1 ? texel[0] : texel[1];
+				rgba[2] = componentsCount==1 ? texel[0] : texel[2];
+				rgba[3] = componentsCount==4 ? texel[3] : 255;
+			}
+		}
+	}
+
+	/**
+	 * Compresses RGB colors of the block: end points are the extreme colors along the principal axis of the colors. End
+	 * points are then refined by a least squares fit on the chosen indices.
+	 * @param block [out] Block of 8 bytes: two colors 5:6:5 and 2 bits index per texel
+	 */
+	void BlockCompressor::compressColorBlock(const unsigned char *rgbaBlock, unsigned char *block) const
+	{
+		//principal axis of the colors (power iteration on covariance matrix)
+		float mean[3] = {0.0f, 0.0f, 0.0f};
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			for(unsigned int c=0; c<3; ++c)
+			{
+				mean[c] += rgbaBlock[i*4 + c];
+			}
+		}
+		for(float &meanValue : mean)
+		{
+			meanValue /= (float)BLOCK_TEXELS;
+		}
+
+		float covariance[6] = {0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f}; //rr, rg, rb, gg, gb, bb
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			float r = rgbaBlock[i*4 + 0] - mean[0];
+			float g = rgbaBlock[i*4 + 1] - mean[1];
+			float b = rgbaBlock[i*4 + 2] - mean[2];
+			covariance[0] += r*r;
+			covariance[1] += r*g;
+			covariance[2] += r*b;
+			covariance[3] += g*g;
+			covariance[4] += g*b;
+			covariance[5] += b*b;
+		}
+
+		float axis[3] = {1.0f, 1.0f, 1.0f};
+		for(unsigned int iteration=0; iteration<POWER_ITERATIONS; ++iteration)
+		{
+			float r = axis[0]*covariance[0] + axis[1]*covariance[1] + axis[2]*covariance[2];
+			float g = axis[0]*covariance[1] + axis[1]*covariance[3] + axis[2]*covariance[4];
+			float b = axis[0]*covariance[2] + axis[1]*covariance[4] + axis[2]*covariance[5];
+			float maxComponent = std::max(std::max(std::abs(r), std::abs(g)), std::abs(b));
+			if(maxComponent < 1.0f)
+			{ //uniform colors
+				break;
+			}
+			axis[0] = r / maxComponent;
+			axis[1] = g / maxComponent;
+			axis[2] = b / maxComponent;
+		}
+
+		//extreme colors along the axis
+		unsigned int minIndex = 0, maxIndex = 0;
+		float minProjection = std::numeric_limits<float>::max(), maxProjection = -std::numeric_limits<float>::max();
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			float projection = rgbaBlock[i*4 + 0]*axis[0] + rgbaBlock[i*4 + 1]*axis[1] + rgbaBlock[i*4 + 2]*axis[2];
+			if(projection < minProjection)
+			{
+				minProjection = projection;
+				minIndex = i;
+			}
+			if(projection > maxProjection)
+			{
+				maxProjection = projection;
+				maxIndex = i;
+			}
+		}
+
+		float maxColor[3] = {(float)rgbaBlock[maxIndex*4 + 0], (float)rgbaBlock[maxIndex*4 + 1], (float)rgbaBlock[maxIndex*4 + 2]};
+		float minColor[3] = {(float)rgbaBlock[minIndex*4 + 0], (float)rgbaBlock[minIndex*4 + 1], (float)rgbaBlock[minIndex*4 + 2]};
+		unsigned short color0 = toColor565(maxColor);
+		unsigned short color1 = toColor565(minColor);
+		unsigned int indices = 0;
+		float error = computeColorIndices(rgbaBlock, color0, color1, indices);
+
+		//least squares refinement of the end points for the chosen indices
+		if(color0!=color1)
+		{
+			const float weights[4] = {1.0f, 0.0f, 2.0f/3.0f, 1.0f/3.0f}; //weight of color0 for each index
+			float alpha2Sum = 0.0f, beta2Sum = 0.0f, alphaBetaSum = 0.0f;
+			float alphaColorSum[3] = {0.0f, 0.0f, 0.0f}, betaColorSum[3] = {0.0f, 0.0f, 0.0f};
+			for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+			{
+				float alpha = weights[(indices >> (i*2)) & 3];
+				float beta = 1.0f - alpha;
+				alpha2Sum += alpha*alpha;
+				beta2Sum += beta*beta;
+				alphaBetaSum += alpha*beta;
+				for(unsigned int c=0; c<3; ++c)
+				{
+					alphaColorSum[c] += alpha * rgbaBlock[i*4 + c];
+					betaColorSum[c] += beta * rgbaBlock[i*4 + c];
+				}
+			}
+
+			float determinant = alpha2Sum*beta2Sum - alphaBetaSum*alphaBetaSum;
+			if(std::abs(determinant) > 0.0001f)
+			{
+				float refinedColor0[3], refinedColor1[3];
+				for(unsigned int c=0; c<3; ++c)
+				{
+					refinedColor0[c] = (alphaColorSum[c]*beta2Sum - betaColorSum[c]*alphaBetaSum) / determinant;
+					refinedColor1[c] = (betaColorSum[c]*alpha2Sum - alphaColorSum[c]*alphaBetaSum) / determinant;
+				}
+
+				unsigned short refinedColor565_0 = toColor565(refinedColor0);
+				unsigned short refinedColor565_1 = toColor565(refinedColor1);
+				unsigned int refinedIndices = 0;
+				float refinedError = computeColorIndices(rgbaBlock, refinedColor565_0, refinedColor565_1, refinedIndices);
+				if(refinedError < error)
+				{
+					color0 = refinedColor565_0;
+					color1 = refinedColor565_1;
+					indices = refinedIndices;
+				}
+			}
+		}
+
+		if(color0 < color1)
+		{ //four colors mode requires color0 > color1: swap end points and their indices (0<->1, 2<->3)
+			std::swap(color0, color1);
+			indices ^= 0x55555555u;
+		}else if(color0==color1)
+		{
+			indices = 0;
+		}
+
+		block[0] = static_cast<unsigned char>(color0 & 0xFF);
+		block[1] = static_cast<unsigned char>(color0 >> 8);
+		block[2] = static_cast<unsigned char>(color1 & 0xFF);
+		block[3] = static_cast<unsigned char>(color1 >> 8);
+		for(unsigned int i=0; i<4; ++i)
+		{
+			block[4 + i] = static_cast<unsigned char>((indices >> (i*8)) & 0xFF);
+		}
+	}
+
+	/**
+	 * Compresses one channel of the block with 8 interpolated values between the minimum and maximum values.
+	 * @param block [out] Block of 8 bytes: two values and 3 bits index per texel
+	 */
+	void BlockCompressor::compressChannelBlock(const unsigned char *rgbaBlock, unsigned int channel, unsigned char *block) const
+	{
+		unsigned char minValue = 255, maxValue = 0;
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			minValue = std::min(minValue, rgbaBlock[i*4 + channel]);
+			maxValue = std::max(maxValue, rgbaBlock[i*4 + channel]);
+		}
+
+		uint64_t indices = 0;
+		if(maxValue!=minValue)
+		{
+			unsigned char palette[8];
+			computeChannelPalette(maxValue, minValue, palette);
+
+			for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+			{
+				int value = rgbaBlock[i*4 + channel];
+				uint64_t bestIndex = 0;
+				int bestDistance = 256;
+				for(unsigned int paletteIndex=0; paletteIndex<8; ++paletteIndex)
+				{
+					int distance = std::abs(value - palette[paletteIndex]);
+					if(distance < bestDistance)
+					{
+						bestDistance = distance;
+						bestIndex = paletteIndex;
+					}
+				}
+				indices |= bestIndex << (i*3);
+			}
+		}
+
+		block[0] = maxValue;
+		block[1] = minValue;
+		for(unsigned int i=0; i<6; ++i)
+		{
+			block[2 + i] = static_cast<unsigned char>((indices >> (i*8)) & 0xFF);
+		}
+	}
+
+	/**
+	 * @param rgbaBlock [out] 4x4 texels of the block in RGBA format
+	 */
+	void BlockCompressor::decompressColorBlock(const unsigned char *block, unsigned char *rgbaBlock) const
+	{
+		auto color0 = static_cast<unsigned short>(block[0] | (block[1] << 8));
+		auto color1 = static_cast<unsigned short>(block[2] | (block[3] << 8));
+		unsigned char palette[16];
+		computeColorPalette(color0, color1, palette);
+
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			unsigned int index = (block[4 + i/4] >> ((i%4)*2)) & 3;
+			std::memcpy(rgbaBlock + i*4, palette + index*4, 4);
+		}
+	}
+
+	/**
+	 * @param rgbaBlock [out] 4x4 texels of the block where only the given channel is written
+	 */
+	void BlockCompressor::decompressChannelBlock(const unsigned char *block, unsigned int channel, unsigned char *rgbaBlock) const
+	{
+		unsigned char palette[8];
+		computeChannelPalette(block[0], block[1], palette);
+
+		uint64_t indices = 0;
+		for(unsigned int i=0; i<6; ++i)
+		{
+			indices |= static_cast<uint64_t>(block[2 + i]) << (i*8);
+		}
+
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			rgbaBlock[i*4 + channel] = palette[(indices >> (i*3)) & 7];
+		}
+	}
+
+	/**
+	 * @param indices [out] 2 bits index per texel of the nearest palette color
+	 * @return Sum of the square distances between the texels and their palette color
+	 */
+	float BlockCompressor::computeColorIndices(const unsigned char *rgbaBlock, unsigned short color0, unsigned short color1, unsigned int &indices) const
+	{
+		unsigned char palette[16];
+		computeColorPalette(std::max(color0, color1), std::min(color0, color1), palette);
+		bool swapped = color0 < color1;
+		unsigned int paletteSize = color0==color1 ? 1 : 4; //identical colors are encoded with index 0 only
+
+		float error = 0.0f;
+		indices = 0;
+		for(unsigned int i=0; i<BLOCK_TEXELS; ++i)
+		{
+			unsigned int bestIndex = 0;
+			int bestDistance = std::numeric_limits<int>::max();
+			for(unsigned int paletteIndex=0; paletteIndex<paletteSize; ++paletteIndex)
+			{
+				int r = rgbaBlock[i*4 + 0] - palette[paletteIndex*4 + 0];
+				int g = rgbaBlock[i*4 + 1] - palette[paletteIndex*4 + 1];
+				int b = rgbaBlock[i*4 + 2] - palette[paletteIndex*4 + 2];
+				int distance = r*r + g*g + b*b;
+				if(distance < bestDistance)
+				{
+					bestDistance = distance;
+					bestIndex = paletteIndex;
+				}
+			}
+
+			error += (float)bestDistance;
+			indices |= (swapped ? (bestIndex ^ 1) : bestIndex) << (i*2);
+		}
+
+		return error;
+	}
+
+	unsigned short BlockCompressor::toColor565(const float *rgb) const
+	{
+		auto r = static_cast<unsigned short>(std::lround(std::min(std::max(rgb[0], 0.0f), 255.0f) * 31.0f / 255.0f));
+		auto g = static_cast<unsigned short>(std::lround(std::min(std::max(rgb[1], 0.0f), 255.0f) * 63.0f / 255.0f));
+		auto b = static_cast<unsigned short>(std::lround(std::min(std::max(rgb[2], 0.0f), 255.0f) * 31.0f / 255.0f));
+		return static_cast<unsigned short>((r << 11) | (g << 5) | b);
+	}
+
+	void BlockCompressor::fromColor565(unsigned short color, unsigned char *rgba) const
+	{
+		unsigned int r = (color >> 11) & 0x1F;
+		unsigned int g = (color >> 5) & 0x3F;
+		unsigned int b = color & 0x1F;
+		rgba[0] = static_cast<unsigned char>((r << 3) | (r >> 2));
+		rgba[1] = static_cast<unsigned char>((g << 2) | (g >> 4));
+		rgba[2] = static_cast<unsigned char>((b << 3) | (b >> 2));
+		rgba[3] = 255;
+	}
+
+	/**
+	 * @param palette [out] Four RGBA colors. When color0 > color1, colors are interpolated in thirds (four colors mode),
+	 * otherwise in half with a transparent black color (three colors mode).
+	 */
+	void BlockCompressor::computeColorPalette(unsigned short color0, unsigned short color1, unsigned char *palette) const
+	{
+		fromColor565(color0, palette);
+		fromColor565(color1, palette + 4);
+
+		for(unsigned int c=0; c<3; ++c)
+		{
+			unsigned int value0 = palette[c], value1 = palette[4 + c];
+			if(color0 > color1)
+			{
+				palette[8 + c] = static_cast<unsigned char>((2*value0 + value1 + 1) / 3);
+				palette[12 + c] = static_cast<unsigned char>((value0 + 2*value1 + 1) / 3);
+			}else
+			{
+				palette[8 + c] = static_cast<unsigned char>((value0 + value1) / 2);
+				palette[12 + c] = 0;
+			}
+		}
+		palette[11] = 255;
+		palette[15] = color0 > color1 ? 255 : 0;
+	}
+
+	/**
+	 * @param palette [out] Eight values. When value0 > value1, six values are interpolated, otherwise four values are
+	 * interpolated and completed by 0 and 255.
+	 */
+	void BlockCompressor::computeChannelPalette(unsigned char value0, unsigned char value1, unsigned char *palette) const
+	{
+		palette[0] = value0;
+		palette[1] = value1;
+		if(value0 > value1)
+		{
+			for(unsigned int i=1; i<7; ++i)
+			{
+				palette[i+1] = static_cast<unsigned char>(((7-i)*value0 + i*value1 + 3) / 7);
+			}
+		}else
+		{
+			for(unsigned int i=1; i<5; ++i)
+			{
+				palette[i+1] = static_cast<unsigned char>(((5-i)*value0 + i*value1 + 2) / 5);
+			}
+			palette[6] = 0;
+			palette[7] = 255;
+		}
+	}
+
+}
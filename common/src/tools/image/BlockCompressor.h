@@ -0,0 +1,49 @@
+#ifndef URCHINENGINE_BLOCKCOMPRESSOR_H
+#define URCHINENGINE_BLOCKCOMPRESSOR_H
+
+#include <vector>
+#include <cstddef>
+
+namespace urchin
+{
+
+	/**
+	* Compressor of images in blocks of 4x4 texels understood by the graphic cards:
+	*  - BC1 (DXT1): RGB colors on 8 bytes per block,
+	*  - BC3 (DXT5): RGB colors (as BC1) and alpha on 16 bytes per block,
+	*  - BC5 (RGTC2): red and green channels on 16 bytes per block (e.g.: two components of a normal).
+	* Colors are compressed with end points on the principal axis of the block colors.
+	*/
+	class BlockCompressor
+	{
+		public:
+			enum BlockFormat
+			{
+				BC1,
+				BC3,
+				BC5
+			};
+
+			std::vector<unsigned char> compress(BlockFormat, unsigned int, unsigned int, unsigned int, const unsigned char *) const;
+			std::vector<unsigned char> decompress(BlockFormat, unsigned int, unsigned int, const unsigned char *) const;
+
+			static unsigned int getBlockSize(BlockFormat);
+			static std::size_t computeCompressedSize(BlockFormat, unsigned int, unsigned int);
+
+		private:
+			void extractBlock(unsigned int, unsigned int, unsigned int, const unsigned char *, unsigned int, unsigned int, unsigned char *) const;
+			void compressColorBlock(const unsigned char *, unsigned char *) const;
+			void compressChannelBlock(const unsigned char *, unsigned int, unsigned char *) const;
+			void decompressColorBlock(const unsigned char *, unsigned char *) const;
+			void decompressChannelBlock(const unsigned char *, unsigned int, unsigned char *) const;
+
+			float computeColorIndices(const unsigned char *, unsigned short, unsigned short, unsigned int &) const;
+			unsigned short toColor565(const float *) const;
+			void fromColor565(unsigned short, unsigned char *) const;
+			void computeColorPalette(unsigned short, unsigned short, unsigned char *) const;
+			void computeChannelPalette(unsigned char, unsigned char, unsigned char *) const;
+	};
+
+}
+
+#endif
@@ -0,0 +1,92 @@
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+#include "tools/image/MipMapGenerator.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param width Width of the base level
+	 * @param height Height of the base level
+	 * @param componentsCount Number of 8 bits components per texel
+	 * @param texels Texels of the base level
+	 * @return Texels of each level after the base level, until the level of size 1x1
+	 */
+	std::vector<std::vector<unsigned char>> MipMapGenerator::generate(unsigned int width, unsigned int height, unsigned int componentsCount,
+			const std::vector<unsigned char> &texels) const
+	{
+		if(texels.size()!=static_cast<std::size_t>(width) * height * componentsCount)
+		{
+			throw std::invalid_argument("Texels size doesn't match the image size: " + std::to_string(texels.size()) + ".");
+		}
+
+		unsigned int levelsCount = computeLevelsCount(width, height);
+		std::vector<std::vector<unsigned char>> levels;
+		levels.reserve(levelsCount - 1);
+
+		const std::vector<unsigned char> *previousLevel = &texels;
+		for(unsigned int level=1; level<levelsCount; ++level)
+		{
+			levels.push_back(downsample(*previousLevel, computeLevelSize(width, level-1), computeLevelSize(height, level-1), componentsCount));
+			previousLevel = &levels.back();
+		}
+
+		return levels;
+	}
+
+	/**
+	 * @return Number of levels (base level included) until the level of size 1x1
+	 */
+	unsigned int MipMapGenerator::computeLevelsCount(unsigned int width, unsigned int height)
+	{
+		unsigned int levelsCount = 1;
+		for(unsigned int size = std::max(width, height); size > 1; size >>= 1)
+		{
+			levelsCount++;
+		}
+		return levelsCount;
+	}
+
+	/**
+	 * @return Width or height of the level from the width or height of the base level
+	 */
+	unsigned int MipMapGenerator::computeLevelSize(unsigned int baseSize, unsigned int level)
+	{
+		return std::max(1u, baseSize >> level);
+	}
+
+	/**
+	 * Averages each block of 2x2 texels. For an odd size, the last texels of the row/column are clamped.
+	 */
+	std::vector<unsigned char> MipMapGenerator::downsample(const std::vector<unsigned char> &texels, unsigned int width, unsigned int height,
+			unsigned int componentsCount) const
+	{
+		unsigned int downWidth = std::max(1u, width / 2);
+		unsigned int downHeight = std::max(1u, height / 2);
+		std::vector<unsigned char> downTexels(static_cast<std::size_t>(downWidth) * downHeight * componentsCount);
+
+		std::size_t rowSize = static_cast<std::size_t>(width) * componentsCount;
+		for(unsigned int y=0; y<downHeight; ++y)
+		{
+			const unsigned char *row0 = texels.data() + std::min(y*2, height-1) * rowSize;
+			const unsigned char *row1 = texels.data() + std::min(y*2+1, height-1) * rowSize;
+			unsigned char *downRow = downTexels.data() + static_cast<std::size_t>(y) * downWidth * componentsCount;
+
+			for(unsigned int x=0; x<downWidth; ++x)
+			{
+				unsigned int offset0 = std::min(x*2, width-1) * componentsCount;
+				unsigned int offset1 = std::min(x*2+1, width-1) * componentsCount;
+				for(unsigned int c=0; c<componentsCount; ++c)
+				{
+					unsigned int sum = row0[offset0 + c] + row0[offset1 + c] + row1[offset0 + c] + row1[offset1 + c];
+					downRow[x*componentsCount + c] = static_cast<unsigned char>((sum + 2) / 4);
+				}
+			}
+		}
+
+		return downTexels;
+	}
+
+}
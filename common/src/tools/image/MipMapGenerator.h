@@ -0,0 +1,27 @@
+#ifndef URCHINENGINE_MIPMAPGENERATOR_H
+#define URCHINENGINE_MIPMAPGENERATOR_H
+
+#include <vector>
+
+namespace urchin
+{
+
+	/**
+	* Generator of the mipmap levels of an image on the CPU. Each level is computed from the previous one with a 2x2 box
+	* filter: result is equivalent to the mipmaps generated by the graphic drivers.
+	*/
+	class MipMapGenerator
+	{
+		public:
+			std::vector<std::vector<unsigned char>> generate(unsigned int, unsigned int, unsigned int, const std::vector<unsigned char> &) const;
+
+			static unsigned int computeLevelsCount(unsigned int, unsigned int);
+			static unsigned int computeLevelSize(unsigned int, unsigned int);
+
+		private:
+			std::vector<unsigned char> downsample(const std::vector<unsigned char> &, unsigned int, unsigned int, unsigned int) const;
+	};
+
+}
+
+#endif
@@ -0,0 +1,95 @@
+#include <stdexcept>
+#include <utility>
+
+#include "tools/image/TextureBaker.h"
+#include "tools/image/MipMapGenerator.h"
+#include "tools/file/FrlFileReader.h"
+#include "tools/file/FrlFileWriter.h"
+
+#define TEXTURE_FRL_FILE_VERSION 1
+
+namespace urchin
+{
+
+	/**
+	 * @param componentsCount Number of 8 bits components per texel: 1 (grayscale), 3 (RGB) or 4 (RGBA)
+	 * @param texels Texels of the base level
+	 */
+	std::unique_ptr<BakedTexture> TextureBaker::bake(BlockCompressor::BlockFormat blockFormat, unsigned int width, unsigned int height,
+			unsigned int componentsCount, const std::vector<unsigned char> &texels) const
+	{
+		std::vector<std::vector<unsigned char>> mipMaps = MipMapGenerator().generate(width, height, componentsCount, texels);
+
+		BlockCompressor blockCompressor;
+		std::vector<std::vector<unsigned char>> levels;
+		levels.reserve(mipMaps.size() + 1);
+		levels.push_back(blockCompressor.compress(blockFormat, width, height, componentsCount, texels.data()));
+		for(unsigned int level=1; level<=mipMaps.size(); ++level)
+		{
+			unsigned int levelWidth = MipMapGenerator::computeLevelSize(width, level);
+			unsigned int levelHeight = MipMapGenerator::computeLevelSize(height, level);
+			levels.push_back(blockCompressor.compress(blockFormat, levelWidth, levelHeight, componentsCount, mipMaps[level-1].data()));
+		}
+
+		return std::make_unique<BakedTexture>(blockFormat, width, height, std::move(levels));
+	}
+
+	/**
+	 * @param frlFilePath Path of the cache file
+	 * @param md5 MD5 of the source image file
+	 * @return Baked texture stored in the cache file or null if the cache file doesn't exist or is outdated
+	 */
+	std::unique_ptr<BakedTexture> TextureBaker::loadBakedTexture(const std::string &frlFilePath, const std::string &md5,
+			BlockCompressor::BlockFormat blockFormat) const
+	{
+		FrlFileReader frlFileReader(frlFilePath);
+		if(!frlFileReader.checkHeader(TEXTURE_FRL_FILE_VERSION, md5))
+		{
+			return nullptr;
+		}
+
+		auto fileBlockFormat = static_cast<BlockCompressor::BlockFormat>(frlFileReader.readValue<unsigned int>());
+		if(fileBlockFormat!=blockFormat)
+		{
+			return nullptr;
+		}
+		auto width = frlFileReader.readValue<unsigned int>();
+		auto height = frlFileReader.readValue<unsigned int>();
+
+		auto levelsCount = frlFileReader.readValue<unsigned int>();
+		std::vector<const unsigned char *> levels;
+		for(unsigned int level=0; level<levelsCount; ++level)
+		{
+			unsigned int levelSize;
+			levels.push_back(frlFileReader.readArray<unsigned char>(levelSize));
+			if(levelSize!=BlockCompressor::computeCompressedSize(blockFormat, MipMapGenerator::computeLevelSize(width, level),
+					MipMapGenerator::computeLevelSize(height, level)))
+			{
+				throw std::runtime_error("File " + frlFilePath + " is corrupted.");
+			}
+		}
+
+		return std::make_unique<BakedTexture>(blockFormat, width, height, levels, frlFileReader.getMappedFile());
+	}
+
+	/**
+	 * @param frlFilePath Path of the cache file
+	 * @param md5 MD5 of the source image file
+	 */
+	void TextureBaker::writeBakedTexture(const std::string &frlFilePath, const std::string &md5, const BakedTexture &bakedTexture) const
+	{
+		FrlFileWriter frlFileWriter(frlFilePath, TEXTURE_FRL_FILE_VERSION, md5);
+		frlFileWriter.writeValue(static_cast<unsigned int>(bakedTexture.getBlockFormat()));
+		frlFileWriter.writeValue(bakedTexture.getWidth());
+		frlFileWriter.writeValue(bakedTexture.getHeight());
+
+		frlFileWriter.writeValue(bakedTexture.getLevelsCount());
+		for(unsigned int level=0; level<bakedTexture.getLevelsCount(); ++level)
+		{
+			frlFileWriter.writeArray(bakedTexture.getLevelData(level), static_cast<unsigned int>(bakedTexture.getLevelSize(level)));
+		}
+
+		frlFileWriter.commit();
+	}
+
+}
@@ -0,0 +1,29 @@
+#ifndef URCHINENGINE_TEXTUREBAKER_H
+#define URCHINENGINE_TEXTUREBAKER_H
+
+#include <string>
+#include <vector>
+#include <memory>
+
+#include "tools/image/BakedTexture.h"
+#include "tools/image/BlockCompressor.h"
+
+namespace urchin
+{
+
+	/**
+	* Baker of textures: computes the mipmap levels on the CPU and compresses them in blocks. Baked textures are cached in
+	* FRL files (Fast Resource Loading) identified by the MD5 of the source image file.
+	*/
+	class TextureBaker
+	{
+		public:
+			std::unique_ptr<BakedTexture> bake(BlockCompressor::BlockFormat, unsigned int, unsigned int, unsigned int, const std::vector<unsigned char> &) const;
+
+			std::unique_ptr<BakedTexture> loadBakedTexture(const std::string &, const std::string &, BlockCompressor::BlockFormat) const;
+			void writeBakedTexture(const std::string &, const std::string &, const BakedTexture &) const;
+	};
+
+}
+
+#endif
@@ -46,6 +46,8 @@ namespace urchin
 
 	void Logger::log(CriticalityLevel criticalityLevel, const std::string &toLog)
 	{
+		std::lock_guard<std::mutex> lock(logMutex);
+
 		#ifdef _DEBUG
 			write(prefix(criticalityLevel) + toLog + "\n");
 		#else
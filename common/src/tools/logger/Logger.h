@@ -5,6 +5,7 @@
 #include <sstream>
 #include <memory>
 #include <iostream>
+#include <mutex>
 
 namespace urchin
 {
@@ -39,6 +40,7 @@ namespace urchin
 			virtual void write(const std::string &) = 0;
 
             bool bHasFailure;
+			std::mutex logMutex; //logs can be written by the loading threads
 			static std::unique_ptr<Logger> instance;
 	};
 
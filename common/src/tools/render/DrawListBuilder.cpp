@@ -0,0 +1,150 @@
+#include <algorithm>
+
+#include "DrawListBuilder.h"
+
+namespace urchin
+{
+
+	DrawListBuilder::DrawListBuilder() :
+			statistics()
+	{
+
+	}
+
+	void DrawListBuilder::clear()
+	{
+		items.clear();
+	}
+
+	/**
+	* @param shaderKey Key of the shader used to draw the item
+	* @param materialKey Key of the material (textures, material uniforms...) used to draw the item
+	* @param meshKey Key of the vertex data. Instanceable items with the same mesh key must share the same vertex data.
+	* @param meshVariant Variant of the mesh drawn with the same vertex data (e.g.: level of detail): variants are drawn separately
+	* without binding the mesh again
+	* @param transform Transform of the instance
+	* @param itemId Identifier of the item returned in the commands and in the instances
+	* @param instanceable False when the item cannot be drawn with other items (e.g.: item with specific uniforms)
+	*/
+	void DrawListBuilder::addItem(std::size_t shaderKey, std::size_t materialKey, std::size_t meshKey, unsigned int meshVariant,
+			const Matrix4<float> &transform, unsigned int itemId, bool instanceable)
+	{
+		items.push_back({shaderKey, materialKey, meshKey, meshVariant, transform, itemId, instanceable});
+	}
+
+	/**
+	* Sorts the added items and creates the draw commands. Relative order of items with identical keys is kept.
+	*/
+	void DrawListBuilder::build()
+	{
+		drawCommands.clear();
+		instancesTransform.clear();
+		instancesItemId.clear();
+		statistics = DrawListStatistics();
+		statistics.nbItems = items.size();
+
+		sortedItems.resize(items.size());
+		for(unsigned int i=0; i<items.size(); ++i)
+		{
+			sortedItems[i] = i;
+		}
+		std::stable_sort(sortedItems.begin(), sortedItems.end(), [&](unsigned int index1, unsigned int index2) {
+			const DrawItem &item1 = items[index1];
+			const DrawItem &item2 = items[index2];
+			if(item1.shaderKey!=item2.shaderKey)
+			{
+				return item1.shaderKey < item2.shaderKey;
+			}
+			if(item1.materialKey!=item2.materialKey)
+			{
+				return item1.materialKey < item2.materialKey;
+			}
+			if(item1.meshKey!=item2.meshKey)
+			{
+				return item1.meshKey < item2.meshKey;
+			}
+			return item1.meshVariant < item2.meshVariant;
+		});
+
+		const DrawItem *previousItem = nullptr;
+		unsigned int firstInstance = 0;
+		for(unsigned int sortedItem : sortedItems)
+		{
+			const DrawItem &item = items[sortedItem];
+
+			bool shaderChanged = !previousItem || previousItem->shaderKey!=item.shaderKey;
+			bool materialChanged = shaderChanged || previousItem->materialKey!=item.materialKey;
+			bool meshChanged = materialChanged || previousItem->meshKey!=item.meshKey;
+			bool meshVariantChanged = meshChanged || previousItem->meshVariant!=item.meshVariant;
+			bool mergeWithPrevious = !meshVariantChanged && previousItem->instanceable && item.instanceable;
+
+			if(previousItem && !mergeWithPrevious)
+			{
+				addDrawCommand(instancesItemId[firstInstance], firstInstance, instancesItemId.size() - firstInstance);
+				firstInstance = instancesItemId.size();
+			}
+
+			//material uniforms are program states: material is bound again when the shader change (same for the mesh to keep commands simple)
+			if(shaderChanged)
+			{
+				addBindCommand(DrawCommand::BIND_SHADER, item.shaderKey, item.itemId);
+			}
+			if(materialChanged)
+			{
+				addBindCommand(DrawCommand::BIND_MATERIAL, item.materialKey, item.itemId);
+			}
+			if(meshChanged)
+			{
+				addBindCommand(DrawCommand::BIND_MESH, item.meshKey, item.itemId);
+			}
+
+			instancesTransform.push_back(item.transform);
+			instancesItemId.push_back(item.itemId);
+			previousItem = &item;
+		}
+
+		if(previousItem)
+		{
+			addDrawCommand(instancesItemId[firstInstance], firstInstance, instancesItemId.size() - firstInstance);
+		}
+	}
+
+	void DrawListBuilder::addBindCommand(DrawCommand::CommandType type, std::size_t key, unsigned int itemId)
+	{
+		drawCommands.push_back({type, key, itemId, 0, 0});
+		statistics.nbStateChanges++;
+	}
+
+	void DrawListBuilder::addDrawCommand(unsigned int itemId, unsigned int firstInstance, unsigned int instancesCount)
+	{
+		drawCommands.push_back({DrawCommand::DRAW_INSTANCES, 0, itemId, firstInstance, instancesCount});
+		statistics.nbDrawCommands++;
+	}
+
+	const std::vector<DrawCommand> &DrawListBuilder::getDrawCommands() const
+	{
+		return drawCommands;
+	}
+
+	/**
+	* @return Transforms of the instances. Instances of a draw command are in range [firstInstance, firstInstance + instancesCount[.
+	*/
+	const std::vector<Matrix4<float>> &DrawListBuilder::getInstancesTransform() const
+	{
+		return instancesTransform;
+	}
+
+	/**
+	* @return Item identifiers of the instances (same order as the instances transform)
+	*/
+	const std::vector<unsigned int> &DrawListBuilder::getInstancesItemId() const
+	{
+		return instancesItemId;
+	}
+
+	const DrawListStatistics &DrawListBuilder::getStatistics() const
+	{
+		return statistics;
+	}
+
+}
@@ -0,0 +1,86 @@
+#ifndef URCHINENGINE_DRAWLISTBUILDER_H
+#define URCHINENGINE_DRAWLISTBUILDER_H
+
+#include <vector>
+#include <cstddef>
+
+#include "math/algebra/matrix/Matrix4.h"
+
+namespace urchin
+{
+
+	/**
+	* Command of a draw list. Bind commands change the state used by the following draw commands.
+	*/
+	struct DrawCommand
+	{
+		enum CommandType
+		{
+			BIND_SHADER = 0,
+			BIND_MATERIAL,
+			BIND_MESH,
+			DRAW_INSTANCES
+		};
+
+		CommandType type;
+		std::size_t key; //shader, material or mesh key (bind commands only)
+		unsigned int itemId; //item of the first instance affected by the command
+		unsigned int firstInstance; //index of the first instance in the instances data (draw commands only)
+		unsigned int instancesCount; //draw commands only
+	};
+
+	/**
+	* Statistics of the last built draw list
+	*/
+	struct DrawListStatistics
+	{
+		unsigned int nbItems;
+		unsigned int nbDrawCommands;
+		unsigned int nbStateChanges; //bind commands
+	};
+
+	/**
+	* Build a list of draw commands minimizing the state changes. Items are sorted by shader, material, mesh keys and mesh variants:
+	* consecutive instanceable items sharing the same keys and variant are merged into one instanced draw command. The transforms of
+	* the instances are packed in the order of the draw commands.
+	* Keys are opaque values (e.g.: address of the resource): the builder doesn't depend on the graphic API.
+	*/
+	class DrawListBuilder
+	{
+		public:
+			DrawListBuilder();
+
+			void clear();
+			void addItem(std::size_t, std::size_t, std::size_t, unsigned int, const Matrix4<float> &, unsigned int, bool);
+			void build();
+
+			const std::vector<DrawCommand> &getDrawCommands() const;
+			const std::vector<Matrix4<float>> &getInstancesTransform() const;
+			const std::vector<unsigned int> &getInstancesItemId() const;
+			const DrawListStatistics &getStatistics() const;
+
+		private:
+			struct DrawItem
+			{
+				std::size_t shaderKey, materialKey, meshKey;
+				unsigned int meshVariant;
+				Matrix4<float> transform;
+				unsigned int itemId;
+				bool instanceable;
+			};
+
+			void addBindCommand(DrawCommand::CommandType, std::size_t, unsigned int);
+			void addDrawCommand(unsigned int, unsigned int, unsigned int);
+
+			std::vector<DrawItem> items;
+			std::vector<unsigned int> sortedItems;
+
+			std::vector<DrawCommand> drawCommands;
+			std::vector<Matrix4<float>> instancesTransform;
+			std::vector<unsigned int> instancesItemId;
+			DrawListStatistics statistics;
+	};
+
+}
+
+#endif
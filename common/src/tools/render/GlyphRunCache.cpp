@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+#include "GlyphRunCache.h"
+
+#define NUM_LETTERS 256
+#define NUM_LETTERS_BY_LINE 16
+
+namespace urchin
+{
+
+	/**
+	* @param capacity Maximum number of glyph runs kept in the cache
+	*/
+	GlyphRunCache::GlyphRunCache(const FontMetrics &fontMetrics, unsigned int capacity) :
+			fontMetrics(fontMetrics),
+			capacity(capacity),
+			layoutsCount(0)
+	{
+		if(fontMetrics.glyphs.size()!=NUM_LETTERS || fontMetrics.atlasDimension==0)
+		{
+			throw std::invalid_argument("Invalid font metrics: " + std::to_string(fontMetrics.glyphs.size()) + " glyphs in an atlas of dimension "
+					+ std::to_string(fontMetrics.atlasDimension));
+		}
+	}
+
+	/**
+	* @param maxLength Maximum length of the lines in pixel: longer lines are cut on the last space. No cut when negative.
+	*/
+	std::shared_ptr<const GlyphRun> GlyphRunCache::getGlyphRun(const std::string &text, int maxLength)
+	{
+		std::string key = std::to_string(maxLength) + "|" + text;
+
+		auto itFind = cachedRunsByKey.find(key);
+		if(itFind!=cachedRunsByKey.end())
+		{
+			cachedRuns.splice(cachedRuns.begin(), cachedRuns, itFind->second);
+			return itFind->second->second;
+		}
+
+		std::shared_ptr<const GlyphRun> glyphRun = layout(text, maxLength);
+		if(capacity > 0)
+		{
+			if(cachedRuns.size() >= capacity)
+			{ //evict the least recently used glyph run: still valid for its users thanks to the shared pointer
+				cachedRunsByKey.erase(cachedRuns.back().first);
+				cachedRuns.pop_back();
+			}
+			cachedRuns.emplace_front(key, glyphRun);
+			cachedRunsByKey[key] = cachedRuns.begin();
+		}
+
+		return glyphRun;
+	}
+
+	unsigned int GlyphRunCache::getCachedRunsCount() const
+	{
+		return cachedRuns.size();
+	}
+
+	/**
+	* @return Number of texts laid out since the creation of the cache
+	*/
+	unsigned int GlyphRunCache::getLayoutsCount() const
+	{
+		return layoutsCount;
+	}
+
+	std::shared_ptr<GlyphRun> GlyphRunCache::layout(const std::string &text, int maxLength)
+	{
+		layoutsCount++;
+
+		std::vector<std::string> lines;
+		unsigned int numLetters = 0;
+		std::stringstream cutTextStream((maxLength>0) ? cutText(text, maxLength) : text);
+		std::string line;
+		while (std::getline(cutTextStream, line, '\n'))
+		{
+			lines.push_back(line);
+			numLetters += line.size();
+		}
+
+		auto glyphRun = std::make_shared<GlyphRun>();
+		glyphRun->positions.reserve(numLetters * 4);
+		glyphRun->texCoords.reserve(numLetters * 4);
+		glyphRun->quadsCount = numLetters;
+
+		auto atlasDimension = (float)fontMetrics.atlasDimension;
+		unsigned int width = 0;
+		int offsetY = 0;
+		for (const auto &cutTextLine : lines)
+		{
+			int offsetX = 0;
+			for (char charLetter : cutTextLine)
+			{
+				auto letter = static_cast<unsigned char>(charLetter);
+				const GlyphMetrics &glyph = fontMetrics.glyphs[letter];
+
+				float s = (float)(letter % NUM_LETTERS_BY_LINE) / (float)NUM_LETTERS_BY_LINE;
+				float t = (float)(letter / NUM_LETTERS_BY_LINE) / (float)NUM_LETTERS_BY_LINE;
+
+				glyphRun->positions.emplace_back(Point2<int>(offsetX, -glyph.shift + offsetY));
+				glyphRun->positions.emplace_back(Point2<int>(glyph.width + offsetX, -glyph.shift + offsetY));
+				glyphRun->positions.emplace_back(Point2<int>(glyph.width + offsetX, glyph.height - glyph.shift + offsetY));
+				glyphRun->positions.emplace_back(Point2<int>(offsetX, glyph.height - glyph.shift + offsetY));
+
+				glyphRun->texCoords.emplace_back(Point2<float>(s, t));
+				glyphRun->texCoords.emplace_back(Point2<float>(s + (float)glyph.width / atlasDimension, t));
+				glyphRun->texCoords.emplace_back(Point2<float>(s + (float)glyph.width / atlasDimension, t + (float)glyph.height / atlasDimension));
+				glyphRun->texCoords.emplace_back(Point2<float>(s, t + (float)glyph.height / atlasDimension));
+
+				offsetX += glyph.width + static_cast<int>(fontMetrics.spaceBetweenLetters);
+				width = std::max(width, static_cast<unsigned int>(offsetX) - fontMetrics.spaceBetweenLetters);
+			}
+			offsetY += static_cast<int>(fontMetrics.spaceBetweenLines);
+		}
+
+		auto linesCount = std::max(1u, static_cast<unsigned int>(lines.size())); //empty text has the height of one line
+		glyphRun->width = width;
+		glyphRun->height = linesCount * fontMetrics.height + (linesCount - 1) * fontMetrics.spaceBetweenLines;
+
+		return glyphRun;
+	}
+
+	/**
+	* @return Text with the last space of too long lines replaced by a line break
+	*/
+	std::string GlyphRunCache::cutText(const std::string &constText, int maxLength) const
+	{
+		std::string text(constText);
+
+		int lineLength = 0;
+		unsigned int indexLastSpace = 0;
+		int lengthFromLastSpace = 0;
+
+		for(unsigned int numLetter=0; numLetter<text.size(); numLetter++)
+		{
+			auto letter = static_cast<unsigned char>(text[numLetter]);
+
+			if(letter=='\n')
+			{
+				lineLength = 0;
+				lengthFromLastSpace = 0;
+			}else if(letter==' ')
+			{
+				indexLastSpace = numLetter;
+				lengthFromLastSpace = 0;
+			}
+
+			int lengthLetter = fontMetrics.glyphs[letter].width + static_cast<int>(fontMetrics.spaceBetweenLetters);
+			if(lineLength + lengthLetter >= maxLength)
+			{ //cut line
+				text[indexLastSpace] = '\n';
+				lineLength = lengthFromLastSpace;
+			}else
+			{
+				lineLength += lengthLetter;
+				lengthFromLastSpace += lengthLetter;
+			}
+		}
+
+		return text;
+	}
+
+}
@@ -0,0 +1,76 @@
+#ifndef URCHINENGINE_GLYPHRUNCACHE_H
+#define URCHINENGINE_GLYPHRUNCACHE_H
+
+#include <string>
+#include <vector>
+#include <list>
+#include <memory>
+#include <unordered_map>
+
+#include "math/algebra/point/Point2.h"
+
+namespace urchin
+{
+
+	struct GlyphMetrics
+	{
+		int width;
+		int height;
+		int shift;
+	};
+
+	/**
+	* Metrics of a font whose 256 letters are stored in an atlas of 16x16 cells
+	*/
+	struct FontMetrics
+	{
+		std::vector<GlyphMetrics> glyphs; //by letter
+		unsigned int spaceBetweenLetters;
+		unsigned int spaceBetweenLines;
+		unsigned int height;
+		unsigned int atlasDimension;
+	};
+
+	/**
+	* Text laid out in quads: four corners by letter (top left, top right, bottom right, bottom left). Positions are relative
+	* to the top left corner of the text.
+	*/
+	struct GlyphRun
+	{
+		std::vector<Point2<int>> positions;
+		std::vector<Point2<float>> texCoords;
+		unsigned int quadsCount;
+		unsigned int width;
+		unsigned int height;
+	};
+
+	/**
+	* Lay out texts of a font in glyph runs. The most recently used glyph runs are kept: a text displayed again is not laid
+	* out a second time and its glyph run is shared.
+	*/
+	class GlyphRunCache
+	{
+		public:
+			GlyphRunCache(const FontMetrics &, unsigned int);
+
+			std::shared_ptr<const GlyphRun> getGlyphRun(const std::string &, int maxLength = -1);
+
+			unsigned int getCachedRunsCount() const;
+			unsigned int getLayoutsCount() const;
+
+		private:
+			std::shared_ptr<GlyphRun> layout(const std::string &, int);
+			std::string cutText(const std::string &, int) const;
+
+			const FontMetrics fontMetrics;
+			const unsigned int capacity;
+
+			typedef std::pair<std::string, std::shared_ptr<const GlyphRun>> CachedRun;
+			std::list<CachedRun> cachedRuns; //most recently used first
+			std::unordered_map<std::string, std::list<CachedRun>::iterator> cachedRunsByKey;
+			unsigned int layoutsCount;
+	};
+
+}
+
+#endif
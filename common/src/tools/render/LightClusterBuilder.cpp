@@ -0,0 +1,264 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "LightClusterBuilder.h"
+
+#define PARALLEL_MIN_LIGHTS 64
+
+namespace urchin
+{
+
+	/**
+	* @param gridSizeX Number of clusters on screen X axis
+	* @param gridSizeY Number of clusters on screen Y axis
+	* @param gridSizeZ Number of clusters on view depth
+	*/
+	LightClusterBuilder::LightClusterBuilder(unsigned int gridSizeX, unsigned int gridSizeY, unsigned int gridSizeZ) :
+			gridSizeX(gridSizeX),
+			gridSizeY(gridSizeY),
+			gridSizeZ(gridSizeZ),
+			tilesCount(gridSizeX * gridSizeY),
+			nearPlane(0.0f),
+			farPlane(0.0f),
+			clustersLights(gridSizeX * gridSizeY * gridSizeZ),
+			slicesOverlaps(gridSizeZ),
+			statistics()
+	{
+		if(gridSizeX==0 || gridSizeY==0 || gridSizeZ==0)
+		{
+			throw std::invalid_argument("Invalid light cluster grid size: " + std::to_string(gridSizeX) + "x" + std::to_string(gridSizeY)
+					+ "x" + std::to_string(gridSizeZ));
+		}
+
+		clusters.resize(clustersLights.size(), {0, 0});
+	}
+
+	unsigned int LightClusterBuilder::getGridSizeX() const
+	{
+		return gridSizeX;
+	}
+
+	unsigned int LightClusterBuilder::getGridSizeY() const
+	{
+		return gridSizeY;
+	}
+
+	unsigned int LightClusterBuilder::getGridSizeZ() const
+	{
+		return gridSizeZ;
+	}
+
+	/**
+	* Compute the view space bounds of the clusters
+	* @param projectionMatrix Symmetric perspective projection matrix
+	* @param nearPlane Depth of the first slice of clusters
+	* @param farPlane Depth of the last slice of clusters. Lights farther are ignored.
+	*/
+	void LightClusterBuilder::onProjectionUpdate(const Matrix4<float> &projectionMatrix, float nearPlane, float farPlane)
+	{
+		if(nearPlane <= 0.0f || farPlane <= nearPlane)
+		{
+			throw std::invalid_argument("Invalid near/far planes for light clusters: " + std::to_string(nearPlane) + "/" + std::to_string(farPlane));
+		}
+
+		this->nearPlane = nearPlane;
+		this->farPlane = farPlane;
+
+		slicesMinDepth.resize(gridSizeZ);
+		slicesMaxDepth.resize(gridSizeZ);
+		for(unsigned int z=0; z<gridSizeZ; ++z)
+		{
+			slicesMinDepth[z] = nearPlane * std::pow(farPlane / nearPlane, (float)z / (float)gridSizeZ);
+			slicesMaxDepth[z] = nearPlane * std::pow(farPlane / nearPlane, (float)(z + 1) / (float)gridSizeZ);
+		}
+
+		//view space coordinate at depth 'd' of a normalized device coordinate 'ndc': ndc * d / projectionScale
+		clustersCenterX.resize(tilesCount * gridSizeZ);
+		clustersHalfSizeX.resize(tilesCount * gridSizeZ);
+		clustersCenterY.resize(tilesCount * gridSizeZ);
+		clustersHalfSizeY.resize(tilesCount * gridSizeZ);
+		for(unsigned int z=0; z<gridSizeZ; ++z)
+		{
+			for(unsigned int y=0; y<gridSizeY; ++y)
+			{
+				float ndcMinY = -1.0f + 2.0f * (float)y / (float)gridSizeY;
+				float ndcMaxY = -1.0f + 2.0f * (float)(y + 1) / (float)gridSizeY;
+
+				for(unsigned int x=0; x<gridSizeX; ++x)
+				{
+					float ndcMinX = -1.0f + 2.0f * (float)x / (float)gridSizeX;
+					float ndcMaxX = -1.0f + 2.0f * (float)(x + 1) / (float)gridSizeX;
+
+					float minX = std::min(ndcMinX * slicesMinDepth[z], ndcMinX * slicesMaxDepth[z]) / projectionMatrix.a11;
+					float maxX = std::max(ndcMaxX * slicesMinDepth[z], ndcMaxX * slicesMaxDepth[z]) / projectionMatrix.a11;
+					float minY = std::min(ndcMinY * slicesMinDepth[z], ndcMinY * slicesMaxDepth[z]) / projectionMatrix.a22;
+					float maxY = std::max(ndcMaxY * slicesMinDepth[z], ndcMaxY * slicesMaxDepth[z]) / projectionMatrix.a22;
+
+					unsigned int clusterIndex = z * tilesCount + y * gridSizeX + x;
+					clustersCenterX[clusterIndex] = (minX + maxX) / 2.0f;
+					clustersHalfSizeX[clusterIndex] = (maxX - minX) / 2.0f;
+					clustersCenterY[clusterIndex] = (minY + maxY) / 2.0f;
+					clustersHalfSizeY[clusterIndex] = (maxY - minY) / 2.0f;
+				}
+			}
+		}
+	}
+
+	float LightClusterBuilder::getNearPlane() const
+	{
+		return nearPlane;
+	}
+
+	float LightClusterBuilder::getFarPlane() const
+	{
+		return farPlane;
+	}
+
+	/**
+	* @param lights Spheres of influence of the lights in view space (camera looking toward negative Z). The light index
+	* stored in the clusters is the index in this vector.
+	*/
+	void LightClusterBuilder::buildClusters(const std::vector<Sphere<float>> &lights)
+	{
+		if(slicesMinDepth.empty())
+		{
+			throw std::runtime_error("Projection must be defined before building the light clusters.");
+		}
+
+		statistics = LightClusterStatistics();
+		statistics.nbLights = lights.size();
+
+		lightsFirstSlice.resize(lights.size());
+		lightsLastSlice.resize(lights.size());
+		for(unsigned int i=0; i<lights.size(); ++i)
+		{
+			float depth = -lights[i].getCenterOfMass().Z;
+			float radius = lights[i].getRadius();
+			if(depth + radius < nearPlane || depth - radius > farPlane)
+			{ //outside the clusters: empty range of slices
+				lightsFirstSlice[i] = 1;
+				lightsLastSlice[i] = 0;
+			}else
+			{
+				lightsFirstSlice[i] = computeSlice(depth - radius);
+				lightsLastSlice[i] = computeSlice(depth + radius);
+			}
+		}
+
+		//slices are independent: one job by slice
+		if(lights.size() >= PARALLEL_MIN_LIGHTS)
+		{
+			if(!jobPool)
+			{
+				jobPool = std::make_unique<JobPool>();
+			}
+			jobPool->run(gridSizeZ, [&](unsigned int z) {
+				assignSliceLights(z, lights);
+			});
+		}else
+		{
+			for(unsigned int z=0; z<gridSizeZ; ++z)
+			{
+				assignSliceLights(z, lights);
+			}
+		}
+
+		lightIndices.clear();
+		for(unsigned int i=0; i<clustersLights.size(); ++i)
+		{
+			const std::vector<unsigned int> &clusterLights = clustersLights[i];
+			clusters[i] = {static_cast<unsigned int>(lightIndices.size()), static_cast<unsigned int>(clusterLights.size())};
+			lightIndices.insert(lightIndices.end(), clusterLights.begin(), clusterLights.end());
+
+			statistics.maxClusterLights = std::max(statistics.maxClusterLights, static_cast<unsigned int>(clusterLights.size()));
+		}
+		statistics.nbLightIndices = lightIndices.size();
+	}
+
+	unsigned int LightClusterBuilder::computeSlice(float depth) const
+	{
+		if(depth <= nearPlane)
+		{
+			return 0;
+		}
+
+		auto slice = static_cast<unsigned int>(std::log(depth / nearPlane) / std::log(farPlane / nearPlane) * (float)gridSizeZ);
+		return std::min(slice, gridSizeZ - 1);
+	}
+
+	void LightClusterBuilder::assignSliceLights(unsigned int z, const std::vector<Sphere<float>> &lights)
+	{
+		for(unsigned int tile=0; tile<tilesCount; ++tile)
+		{
+			clustersLights[z * tilesCount + tile].clear();
+		}
+
+		const float *centerX = &clustersCenterX[z * tilesCount];
+		const float *halfSizeX = &clustersHalfSizeX[z * tilesCount];
+		const float *centerY = &clustersCenterY[z * tilesCount];
+		const float *halfSizeY = &clustersHalfSizeY[z * tilesCount];
+		slicesOverlaps[z].resize(tilesCount);
+		unsigned int *overlaps = slicesOverlaps[z].data();
+		unsigned int nbTiles = tilesCount; //local copy: compiler cannot know that the writes in overlaps don't modify the member
+
+		for(unsigned int i=0; i<lights.size(); ++i)
+		{
+			if(z < lightsFirstSlice[i] || z > lightsLastSlice[i])
+			{
+				continue;
+			}
+
+			float lightX = lights[i].getCenterOfMass().X;
+			float lightY = lights[i].getCenterOfMass().Y;
+			float depth = -lights[i].getCenterOfMass().Z;
+			float distanceZ = std::max(std::max(slicesMinDepth[z] - depth, depth - slicesMaxDepth[z]), 0.0f);
+			float remainingSquareRadius = lights[i].getRadius() * lights[i].getRadius() - distanceZ * distanceZ;
+			if(remainingSquareRadius < 0.0f)
+			{
+				continue;
+			}
+
+			//sphere/box tests on contiguous arrays without branch (max(d, 0) = (d + |d|) / 2): loop is vectorized by the compiler
+			for(unsigned int tile=0; tile<nbTiles; ++tile)
+			{
+				float distanceX = std::abs(lightX - centerX[tile]) - halfSizeX[tile];
+				float distanceY = std::abs(lightY - centerY[tile]) - halfSizeY[tile];
+				distanceX = (distanceX + std::abs(distanceX)) * 0.5f;
+				distanceY = (distanceY + std::abs(distanceY)) * 0.5f;
+				overlaps[tile] = static_cast<unsigned int>(distanceX * distanceX + distanceY * distanceY <= remainingSquareRadius);
+			}
+
+			for(unsigned int tile=0; tile<nbTiles; ++tile)
+			{
+				if(overlaps[tile])
+				{
+					clustersLights[z * tilesCount + tile].push_back(i);
+				}
+			}
+		}
+	}
+
+	/**
+	* @return Light indices range of each cluster
+	*/
+	const std::vector<LightCluster> &LightClusterBuilder::getClusters() const
+	{
+		return clusters;
+	}
+
+	/**
+	* @return Light indices of all clusters. Indices of a cluster are in range [offset, offset + count[.
+	*/
+	const std::vector<unsigned int> &LightClusterBuilder::getLightIndices() const
+	{
+		return lightIndices;
+	}
+
+	const LightClusterStatistics &LightClusterBuilder::getStatistics() const
+	{
+		return statistics;
+	}
+
+}
@@ -0,0 +1,82 @@
+#ifndef URCHINENGINE_LIGHTCLUSTERBUILDER_H
+#define URCHINENGINE_LIGHTCLUSTERBUILDER_H
+
+#include <vector>
+#include <memory>
+
+#include "math/algebra/matrix/Matrix4.h"
+#include "math/geometry/3d/object/Sphere.h"
+#include "tools/thread/JobPool.h"
+
+namespace urchin
+{
+
+	/**
+	* Range of a cluster in the light indices
+	*/
+	struct LightCluster
+	{
+		unsigned int offset;
+		unsigned int count;
+	};
+
+	/**
+	* Statistics of the last built clusters
+	*/
+	struct LightClusterStatistics
+	{
+		unsigned int nbLights;
+		unsigned int nbLightIndices; //sum of the lights of all clusters
+		unsigned int maxClusterLights;
+	};
+
+	/**
+	* Assign lights to the clusters of the view frustum. The frustum is split in a grid of clusters: uniformly on X and Y
+	* in screen space and exponentially on the view depth. A light is assigned to all clusters intersecting its sphere of influence.
+	* Clusters are indexed by (z * gridSizeY + y) * gridSizeX + x. Result is stored in flat buffers: each cluster references
+	* a range of the light indices buffer.
+	*/
+	class LightClusterBuilder
+	{
+		public:
+			LightClusterBuilder(unsigned int, unsigned int, unsigned int);
+
+			unsigned int getGridSizeX() const;
+			unsigned int getGridSizeY() const;
+			unsigned int getGridSizeZ() const;
+
+			void onProjectionUpdate(const Matrix4<float> &, float, float);
+			float getNearPlane() const;
+			float getFarPlane() const;
+
+			void buildClusters(const std::vector<Sphere<float>> &);
+
+			const std::vector<LightCluster> &getClusters() const;
+			const std::vector<unsigned int> &getLightIndices() const;
+			const LightClusterStatistics &getStatistics() const;
+
+		private:
+			unsigned int computeSlice(float) const;
+			void assignSliceLights(unsigned int, const std::vector<Sphere<float>> &);
+
+			const unsigned int gridSizeX, gridSizeY, gridSizeZ;
+			const unsigned int tilesCount; //clusters by slice
+			float nearPlane, farPlane;
+
+			//view space bounds of the clusters (structure of arrays): X/Y center and half size by cluster, Z bounds by slice
+			std::vector<float> clustersCenterX, clustersHalfSizeX, clustersCenterY, clustersHalfSizeY;
+			std::vector<float> slicesMinDepth, slicesMaxDepth;
+
+			std::vector<unsigned int> lightsFirstSlice, lightsLastSlice;
+			std::vector<std::vector<unsigned int>> clustersLights; //lights by cluster, filled by one job for each slice
+			std::vector<std::vector<unsigned int>> slicesOverlaps;
+			std::unique_ptr<JobPool> jobPool;
+
+			std::vector<LightCluster> clusters;
+			std::vector<unsigned int> lightIndices;
+			LightClusterStatistics statistics;
+	};
+
+}
+
+#endif
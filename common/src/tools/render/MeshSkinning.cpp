@@ -0,0 +1,104 @@
+#include <map>
+
+#include "tools/render/MeshSkinning.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param verticesWeights Index of the first weight and number of weights of each vertex
+	 * @param weights Weights of all the vertices
+	 */
+	std::vector<WeightGroup> MeshSkinning::buildWeightGroups(const std::vector<std::pair<unsigned int, unsigned int>> &verticesWeights, const Weight *weights)
+	{
+		std::map<unsigned int, std::vector<unsigned int>> vertexIndicesByWeightCount;
+		for(unsigned int i=0; i<verticesWeights.size(); ++i)
+		{
+			vertexIndicesByWeightCount[verticesWeights[i].second].push_back(i);
+		}
+
+		std::vector<WeightGroup> weightGroups;
+		weightGroups.reserve(vertexIndicesByWeightCount.size());
+		for(const auto &vertexIndicesOfWeightCount : vertexIndicesByWeightCount)
+		{
+			WeightGroup weightGroup;
+			weightGroup.weightCount = vertexIndicesOfWeightCount.first;
+			weightGroup.vertexIndices = vertexIndicesOfWeightCount.second;
+
+			std::size_t groupSize = weightGroup.weightCount * weightGroup.vertexIndices.size();
+			weightGroup.bones.resize(groupSize);
+			weightGroup.biases.resize(groupSize);
+			weightGroup.biasedPosX.resize(groupSize);
+			weightGroup.biasedPosY.resize(groupSize);
+			weightGroup.biasedPosZ.resize(groupSize);
+
+			for(unsigned int w=0; w<weightGroup.weightCount; ++w)
+			{
+				for(unsigned int v=0; v<weightGroup.vertexIndices.size(); ++v)
+				{
+					const Weight &weight = weights[verticesWeights[weightGroup.vertexIndices[v]].first + w];
+					std::size_t groupIndex = w * weightGroup.vertexIndices.size() + v;
+
+					weightGroup.bones[groupIndex] = static_cast<unsigned int>(weight.bone);
+					weightGroup.biases[groupIndex] = weight.bias;
+					weightGroup.biasedPosX[groupIndex] = weight.pos.X * weight.bias;
+					weightGroup.biasedPosY[groupIndex] = weight.pos.Y * weight.bias;
+					weightGroup.biasedPosZ[groupIndex] = weight.pos.Z * weight.bias;
+				}
+			}
+
+			weightGroups.push_back(std::move(weightGroup));
+		}
+
+		return weightGroups;
+	}
+
+	/**
+	 * @return Transformation matrix of a bone: rotation and translation of the bone
+	 */
+	Matrix4<float> MeshSkinning::computeBoneMatrix(const Point3<float> &bonePosition, const Quaternion<float> &boneOrientation)
+	{
+		Matrix4<float> boneMatrix = boneOrientation.toMatrix4();
+		boneMatrix.a14 = bonePosition.X;
+		boneMatrix.a24 = bonePosition.Y;
+		boneMatrix.a34 = bonePosition.Z;
+		return boneMatrix;
+	}
+
+	/**
+	 * Compute the skinned vertices. This method is thread-safe.
+	 * @param boneMatrices Bone matrices computed by computeBoneMatrix()
+	 * @param vertices [out] Skinned vertices
+	 */
+	void MeshSkinning::computeVertices(const std::vector<WeightGroup> &weightGroups, const std::vector<Matrix4<float>> &boneMatrices, Point3<float> *vertices)
+	{
+		for(const auto &weightGroup : weightGroups)
+		{
+			const auto groupSize = static_cast<unsigned int>(weightGroup.vertexIndices.size());
+			const unsigned int *bones = weightGroup.bones.data();
+			const float *biases = weightGroup.biases.data();
+			const float *biasedPosX = weightGroup.biasedPosX.data();
+			const float *biasedPosY = weightGroup.biasedPosY.data();
+			const float *biasedPosZ = weightGroup.biasedPosZ.data();
+
+			for(unsigned int v=0; v<groupSize; ++v)
+			{
+				//the sum of all biases should be 1.0: vertex = sum of (boneMatrix * weightPosition) * bias
+				float x = 0.0f, y = 0.0f, z = 0.0f;
+				for(unsigned int w=0, i=v; w<weightGroup.weightCount; ++w, i+=groupSize)
+				{
+					const Matrix4<float> &m = boneMatrices[bones[i]];
+					x += m.a11 * biasedPosX[i] + m.a12 * biasedPosY[i] + m.a13 * biasedPosZ[i] + m.a14 * biases[i];
+					y += m.a21 * biasedPosX[i] + m.a22 * biasedPosY[i] + m.a23 * biasedPosZ[i] + m.a24 * biases[i];
+					z += m.a31 * biasedPosX[i] + m.a32 * biasedPosY[i] + m.a33 * biasedPosZ[i] + m.a34 * biases[i];
+				}
+
+				Point3<float> &vertex = vertices[weightGroup.vertexIndices[v]];
+				vertex.X = x;
+				vertex.Y = y;
+				vertex.Z = z;
+			}
+		}
+	}
+
+}
@@ -0,0 +1,48 @@
+#ifndef URCHINENGINE_MESHSKINNING_H
+#define URCHINENGINE_MESHSKINNING_H
+
+#include <vector>
+#include <utility>
+
+#include "math/algebra/point/Point3.h"
+#include "math/algebra/matrix/Matrix4.h"
+#include "math/algebra/Quaternion.h"
+
+namespace urchin
+{
+
+	struct Weight
+	{
+		int bone; //index of the bone
+		float bias; //contribution of the vertex weight
+		Point3<float> pos; //coordinates of the vertex weight
+	};
+
+	/**
+	 * Weights of the vertices having the same number of weights, stored in a structure of arrays layout.
+	 * Data of weight 'w' for the vertex at position 'v' in the group is stored at index: w * vertexIndices.size() + v
+	 */
+	struct WeightGroup
+	{
+		unsigned int weightCount; //number of weights of each vertex of the group
+		std::vector<unsigned int> vertexIndices;
+		std::vector<unsigned int> bones;
+		std::vector<float> biases;
+		std::vector<float> biasedPosX, biasedPosY, biasedPosZ; //weight position multiplied by the bias
+	};
+
+	/**
+	* Skinning of the mesh vertices on CPU. Vertices are regrouped by number of weights: the weights of a group are read
+	* from contiguous arrays and the inner loop can be vectorized by the compiler.
+	*/
+	class MeshSkinning
+	{
+		public:
+			static std::vector<WeightGroup> buildWeightGroups(const std::vector<std::pair<unsigned int, unsigned int>> &, const Weight *);
+			static Matrix4<float> computeBoneMatrix(const Point3<float> &, const Quaternion<float> &);
+			static void computeVertices(const std::vector<WeightGroup> &, const std::vector<Matrix4<float>> &, Point3<float> *);
+	};
+
+}
+
+#endif
@@ -0,0 +1,154 @@
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+
+#include "StreamingPatchGrid.h"
+#include "math/algorithm/MathAlgorithm.h"
+
+namespace urchin
+{
+
+	/**
+	* @param origin Minimum X/Z point of the first patch
+	* @param patchSize Size of the patches on X/Z axis
+	* @param streamingDistance Patches nearer than this distance from the view position are kept in memory
+	*/
+	StreamingPatchGrid::StreamingPatchGrid(const Point2<float> &origin, const Point2<float> &patchSize, unsigned int patchQuantityX,
+			unsigned int patchQuantityZ, float streamingDistance) :
+			origin(origin),
+			patchSize(patchSize),
+			patchQuantityX(patchQuantityX),
+			patchQuantityZ(patchQuantityZ),
+			streamingDistance(streamingDistance)
+	{
+		if(patchSize.X <= 0.0f || patchSize.Y <= 0.0f || patchQuantityX==0 || patchQuantityZ==0 || streamingDistance < 0.0f)
+		{
+			throw std::invalid_argument("Invalid streaming patch grid: " + std::to_string(patchQuantityX) + "x" + std::to_string(patchQuantityZ)
+					+ " patches of size " + std::to_string(patchSize.X) + "x" + std::to_string(patchSize.Y) + " streamed at distance " + std::to_string(streamingDistance));
+		}
+
+		//an interval of length L overlaps at most floor(L / size) + 2 patches
+		auto slotsCountX = std::min(patchQuantityX, static_cast<unsigned int>(2.0f * streamingDistance / patchSize.X) + 2);
+		auto slotsCountZ = std::min(patchQuantityZ, static_cast<unsigned int>(2.0f * streamingDistance / patchSize.Y) + 2);
+		unsigned int slotsCount = slotsCountX * slotsCountZ;
+
+		slotsPatch.resize(slotsCount, -1);
+		slotsState.resize(slotsCount, FREE);
+		freeSlots.reserve(slotsCount);
+		for(unsigned int i=0; i<slotsCount; ++i)
+		{
+			freeSlots.push_back(slotsCount - 1 - i);
+		}
+		residentPatches.reserve(slotsCount);
+		missingPatches.reserve(slotsCount);
+	}
+
+	unsigned int StreamingPatchGrid::getSlotsCount() const
+	{
+		return slotsPatch.size();
+	}
+
+	/**
+	* @return Patch index stored in the slot or -1 when the slot is free
+	*/
+	int StreamingPatchGrid::getSlotPatch(unsigned int slotIndex) const
+	{
+		return slotsPatch[slotIndex];
+	}
+
+	bool StreamingPatchGrid::isSlotReady(unsigned int slotIndex) const
+	{
+		return slotsState[slotIndex]==READY;
+	}
+
+	bool StreamingPatchGrid::isSlotBuilding(unsigned int slotIndex) const
+	{
+		return slotsState[slotIndex]==BUILDING;
+	}
+
+	/**
+	* Free the slots of the patches out of the streaming distance and request the missing patches, nearest first. Patches
+	* without free slot are requested in a next update. Slots of the patches in build are freed only once built.
+	* @param viewPosition X/Z view position
+	* @param requests [out] Patches to build: they must be notified with onPatchBuilt() once built
+	*/
+	void StreamingPatchGrid::update(const Point2<float> &viewPosition, std::vector<StreamingPatchRequest> &requests)
+	{
+		requests.clear();
+		float squareStreamingDistance = streamingDistance * streamingDistance;
+
+		for(unsigned int slotIndex=0; slotIndex<slotsPatch.size(); ++slotIndex)
+		{
+			if(slotsState[slotIndex]==READY)
+			{
+				auto patchIndex = static_cast<unsigned int>(slotsPatch[slotIndex]);
+				if(computeSquareDistance(patchIndex % patchQuantityX, patchIndex / patchQuantityX, viewPosition) > squareStreamingDistance)
+				{
+					residentPatches.erase(patchIndex);
+					slotsPatch[slotIndex] = -1;
+					slotsState[slotIndex] = FREE;
+					freeSlots.push_back(slotIndex);
+				}
+			}
+		}
+
+		auto computeIndex = [&](float position, float start, float size, unsigned int quantity) {
+			return MathAlgorithm::clamp(static_cast<int>(std::floor((position - start) / size)), 0, static_cast<int>(quantity) - 1);
+		};
+		int minX = computeIndex(viewPosition.X - streamingDistance, origin.X, patchSize.X, patchQuantityX);
+		int maxX = computeIndex(viewPosition.X + streamingDistance, origin.X, patchSize.X, patchQuantityX);
+		int minZ = computeIndex(viewPosition.Y - streamingDistance, origin.Y, patchSize.Y, patchQuantityZ);
+		int maxZ = computeIndex(viewPosition.Y + streamingDistance, origin.Y, patchSize.Y, patchQuantityZ);
+
+		missingPatches.clear();
+		for(int z=minZ; z<=maxZ; ++z)
+		{
+			for(int x=minX; x<=maxX; ++x)
+			{
+				unsigned int patchIndex = static_cast<unsigned int>(z) * patchQuantityX + static_cast<unsigned int>(x);
+				float squareDistance = computeSquareDistance(static_cast<unsigned int>(x), static_cast<unsigned int>(z), viewPosition);
+				if(squareDistance <= squareStreamingDistance && residentPatches.find(patchIndex)==residentPatches.end())
+				{
+					missingPatches.push_back({patchIndex, squareDistance});
+				}
+			}
+		}
+
+		std::sort(missingPatches.begin(), missingPatches.end(), [](const PatchDistance &left, const PatchDistance &right) {
+			return left.squareDistance < right.squareDistance || (left.squareDistance==right.squareDistance && left.patchIndex < right.patchIndex);
+		});
+
+		for(unsigned int i=0; i<missingPatches.size() && !freeSlots.empty(); ++i)
+		{
+			unsigned int slotIndex = freeSlots.back();
+			freeSlots.pop_back();
+
+			slotsPatch[slotIndex] = static_cast<int>(missingPatches[i].patchIndex);
+			slotsState[slotIndex] = BUILDING;
+			residentPatches[missingPatches[i].patchIndex] = slotIndex;
+			requests.push_back({missingPatches[i].patchIndex, slotIndex});
+		}
+	}
+
+	void StreamingPatchGrid::onPatchBuilt(unsigned int slotIndex)
+	{
+		if(slotsState[slotIndex]!=BUILDING)
+		{
+			throw std::invalid_argument("Slot " + std::to_string(slotIndex) + " has no patch in build.");
+		}
+
+		slotsState[slotIndex] = READY;
+	}
+
+	float StreamingPatchGrid::computeSquareDistance(unsigned int xIndex, unsigned int zIndex, const Point2<float> &viewPosition) const
+	{
+		float minX = origin.X + (float)xIndex * patchSize.X;
+		float minZ = origin.Y + (float)zIndex * patchSize.Y;
+
+		float distanceX = std::max(std::max(minX - viewPosition.X, viewPosition.X - (minX + patchSize.X)), 0.0f);
+		float distanceZ = std::max(std::max(minZ - viewPosition.Y, viewPosition.Y - (minZ + patchSize.Y)), 0.0f);
+		return distanceX * distanceX + distanceZ * distanceZ;
+	}
+
+}
@@ -0,0 +1,71 @@
+#ifndef URCHINENGINE_STREAMINGPATCHGRID_H
+#define URCHINENGINE_STREAMINGPATCHGRID_H
+
+#include <vector>
+#include <unordered_map>
+
+#include "math/algebra/point/Point2.h"
+
+namespace urchin
+{
+
+	/**
+	* Patch to build in a slot
+	*/
+	struct StreamingPatchRequest
+	{
+		unsigned int patchIndex;
+		unsigned int slotIndex;
+	};
+
+	/**
+	* Select the patches of a regular grid to keep in memory around a view position. Patches are stored in a fixed number of
+	* slots: enough to contain all patches at streaming distance of any position. Memory is therefore bounded by the streaming
+	* distance and not by the grid size. Patches are indexed by row: zIndex * patchQuantityX + xIndex.
+	* Life of a slot: free, building (requested to the caller), ready (built by the caller) and free again when the patch is
+	* out of the streaming distance.
+	*/
+	class StreamingPatchGrid
+	{
+		public:
+			StreamingPatchGrid(const Point2<float> &, const Point2<float> &, unsigned int, unsigned int, float);
+
+			unsigned int getSlotsCount() const;
+			int getSlotPatch(unsigned int) const;
+			bool isSlotReady(unsigned int) const;
+			bool isSlotBuilding(unsigned int) const;
+
+			void update(const Point2<float> &, std::vector<StreamingPatchRequest> &);
+			void onPatchBuilt(unsigned int);
+
+		private:
+			enum SlotState
+			{
+				FREE,
+				BUILDING,
+				READY
+			};
+
+			struct PatchDistance
+			{
+				unsigned int patchIndex;
+				float squareDistance;
+			};
+
+			float computeSquareDistance(unsigned int, unsigned int, const Point2<float> &) const;
+
+			const Point2<float> origin;
+			const Point2<float> patchSize;
+			const unsigned int patchQuantityX, patchQuantityZ;
+			const float streamingDistance;
+
+			std::vector<int> slotsPatch;
+			std::vector<SlotState> slotsState;
+			std::vector<unsigned int> freeSlots;
+			std::unordered_map<unsigned int, unsigned int> residentPatches; //patch index to slot index
+			std::vector<PatchDistance> missingPatches;
+	};
+
+}
+
+#endif
@@ -0,0 +1,161 @@
+#include <algorithm>
+#include <limits>
+
+#include "TextBatch.h"
+
+#define FLOATS_BY_VERTEX 4
+#define VERTICES_BY_QUAD 6
+
+namespace urchin
+{
+
+	TextBatch::TextBatch() :
+			segmentsCount(0),
+			firstDirtyVertex(0),
+			endDirtyVertex(0),
+			tessellatedRunsCount(0)
+	{
+
+	}
+
+	void TextBatch::beginFrame()
+	{
+		entries.clear();
+		segmentsCount = 0;
+	}
+
+	/**
+	* Start a new segment: next glyph runs are not merged in the draw ranges of the previous glyph runs
+	* @return Index of the segment
+	*/
+	unsigned int TextBatch::beginSegment()
+	{
+		return segmentsCount++;
+	}
+
+	/**
+	* @param textureId Texture of the font used to lay out the glyph run
+	* @param position Position of the top left corner of the text
+	*/
+	void TextBatch::addGlyphRun(unsigned int textureId, const std::shared_ptr<const GlyphRun> &glyphRun, const Point2<int> &position)
+	{
+		if(segmentsCount==0)
+		{
+			beginSegment();
+		}
+
+		entries.push_back({segmentsCount - 1, textureId, glyphRun, position, 0});
+	}
+
+	void TextBatch::build()
+	{
+		unsigned int verticesCount = 0;
+		for(auto &entry : entries)
+		{
+			entry.firstVertex = verticesCount;
+			verticesCount += entry.glyphRun->quadsCount * VERTICES_BY_QUAD;
+		}
+		vertices.resize(verticesCount * FLOATS_BY_VERTEX); //vertices of unchanged glyph runs are kept
+
+		firstDirtyVertex = std::numeric_limits<unsigned int>::max();
+		endDirtyVertex = 0;
+		tessellatedRunsCount = 0;
+		drawRanges.clear();
+		for(unsigned int i=0; i<entries.size(); ++i)
+		{
+			const BatchEntry &entry = entries[i];
+			unsigned int entryVerticesCount = entry.glyphRun->quadsCount * VERTICES_BY_QUAD;
+			if(entryVerticesCount==0)
+			{
+				continue;
+			}
+
+			bool isUnchanged = i < previousEntries.size() && previousEntries[i].glyphRun==entry.glyphRun
+					&& previousEntries[i].position==entry.position && previousEntries[i].firstVertex==entry.firstVertex;
+			if(!isUnchanged)
+			{
+				tessellate(entry);
+				firstDirtyVertex = std::min(firstDirtyVertex, entry.firstVertex);
+				endDirtyVertex = std::max(endDirtyVertex, entry.firstVertex + entryVerticesCount);
+				tessellatedRunsCount++;
+			}
+
+			if(!drawRanges.empty() && drawRanges.back().segment==entry.segment && drawRanges.back().textureId==entry.textureId)
+			{
+				drawRanges.back().verticesCount += entryVerticesCount;
+			}else
+			{
+				drawRanges.push_back({entry.segment, entry.textureId, entry.firstVertex, entryVerticesCount});
+			}
+		}
+
+		previousEntries.swap(entries);
+	}
+
+	void TextBatch::tessellate(const BatchEntry &entry)
+	{
+		static const unsigned int quadCorners[VERTICES_BY_QUAD] = {0, 1, 2, 0, 2, 3};
+
+		const GlyphRun &glyphRun = *entry.glyphRun;
+		float *vertex = &vertices[entry.firstVertex * FLOATS_BY_VERTEX];
+		for(unsigned int quad=0; quad<glyphRun.quadsCount; ++quad)
+		{
+			for(unsigned int quadCorner : quadCorners)
+			{
+				unsigned int corner = quad * 4 + quadCorner;
+				*vertex++ = (float)(glyphRun.positions[corner].X + entry.position.X);
+				*vertex++ = (float)(glyphRun.positions[corner].Y + entry.position.Y);
+				*vertex++ = glyphRun.texCoords[corner].X;
+				*vertex++ = glyphRun.texCoords[corner].Y;
+			}
+		}
+	}
+
+	/**
+	* @return Vertices of the batch: position X/Y and texture coordinates S/T by vertex
+	*/
+	const std::vector<float> &TextBatch::getVertices() const
+	{
+		return vertices;
+	}
+
+	unsigned int TextBatch::getVerticesCount() const
+	{
+		return vertices.size() / FLOATS_BY_VERTEX;
+	}
+
+	/**
+	* @return Ranges of vertices to draw ordered by segment: consecutive glyph runs of a same segment and texture are merged
+	*/
+	const std::vector<TextBatchDrawRange> &TextBatch::getDrawRanges() const
+	{
+		return drawRanges;
+	}
+
+	/**
+	* @return True when vertices changed during the last build
+	*/
+	bool TextBatch::hasDirtyVertices() const
+	{
+		return endDirtyVertex > 0;
+	}
+
+	unsigned int TextBatch::getFirstDirtyVertex() const
+	{
+		return hasDirtyVertices() ? firstDirtyVertex : 0;
+	}
+
+	unsigned int TextBatch::getDirtyVerticesCount() const
+	{
+		return hasDirtyVertices() ? endDirtyVertex - firstDirtyVertex : 0;
+	}
+
+	/**
+	* @return Number of glyph runs tessellated during the last build
+	*/
+	unsigned int TextBatch::getTessellatedRunsCount() const
+	{
+		return tessellatedRunsCount;
+	}
+
+}
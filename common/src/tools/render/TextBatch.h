@@ -0,0 +1,76 @@
+#ifndef URCHINENGINE_TEXTBATCH_H
+#define URCHINENGINE_TEXTBATCH_H
+
+#include <vector>
+#include <memory>
+
+#include "math/algebra/point/Point2.h"
+#include "tools/render/GlyphRunCache.h"
+
+namespace urchin
+{
+
+	/**
+	* Vertices of the batch to draw with a texture
+	*/
+	struct TextBatchDrawRange
+	{
+		unsigned int segment;
+		unsigned int textureId;
+		unsigned int firstVertex;
+		unsigned int verticesCount;
+	};
+
+	/**
+	* Batch the glyph runs of several texts in one vertex stream. Each vertex has four floats: position X/Y and texture
+	* coordinates S/T. Each quad is drawn with two triangles (six vertices).
+	* Glyph runs are grouped in segments: glyph runs drawn at the same time (e.g.: texts of a window drawn over the window).
+	* Draw ranges never overlap two segments.
+	* The glyph runs are added in display order at each frame. The vertex stream is retained between the frames: only the
+	* glyph runs whose geometry changed (other glyph run, position or place in the stream) are tessellated again and their
+	* vertices define the dirty range to upload.
+	*/
+	class TextBatch
+	{
+		public:
+			TextBatch();
+
+			void beginFrame();
+			unsigned int beginSegment();
+			void addGlyphRun(unsigned int, const std::shared_ptr<const GlyphRun> &, const Point2<int> &);
+			void build();
+
+			const std::vector<float> &getVertices() const;
+			unsigned int getVerticesCount() const;
+			const std::vector<TextBatchDrawRange> &getDrawRanges() const;
+
+			bool hasDirtyVertices() const;
+			unsigned int getFirstDirtyVertex() const;
+			unsigned int getDirtyVerticesCount() const;
+			unsigned int getTessellatedRunsCount() const;
+
+		private:
+			struct BatchEntry
+			{
+				unsigned int segment;
+				unsigned int textureId;
+				std::shared_ptr<const GlyphRun> glyphRun; //shared pointer: a glyph run address cannot be reused while the entry exists
+				Point2<int> position;
+				unsigned int firstVertex;
+			};
+
+			void tessellate(const BatchEntry &);
+
+			std::vector<BatchEntry> entries, previousEntries;
+			unsigned int segmentsCount;
+
+			std::vector<float> vertices;
+			std::vector<TextBatchDrawRange> drawRanges;
+
+			unsigned int firstDirtyVertex, endDirtyVertex;
+			unsigned int tessellatedRunsCount;
+	};
+
+}
+
+#endif
@@ -0,0 +1,16 @@
+#include "tools/resource/ResourceCache.h"
+
+namespace urchin
+{
+
+	ResourceCacheStatistics::ResourceCacheStatistics() :
+			hits(0),
+			misses(0),
+			evictions(0),
+			residentBytes(0),
+			cachedBytes(0)
+	{
+
+	}
+
+}
@@ -0,0 +1,76 @@
+#ifndef URCHINENGINE_RESOURCECACHE_H
+#define URCHINENGINE_RESOURCECACHE_H
+
+#include <map>
+#include <list>
+#include <vector>
+#include <string>
+#include <typeindex>
+
+namespace urchin
+{
+
+	struct ResourceCacheStatistics
+	{
+		ResourceCacheStatistics();
+
+		unsigned long hits; //resources requested and found in the cache
+		unsigned long misses; //resources added
+		unsigned long evictions; //unreferenced resources removed because of the cache budget
+		std::size_t residentBytes; //memory of all the resources (referenced or cached)
+		std::size_t cachedBytes; //memory of the unreferenced resources kept in cache
+	};
+
+	/**
+	 * Bookkeeping of resources by name. A resource which is not referenced anymore is kept in cache when its type has a
+	 * cache budget: it can be requested again without being reloaded. When the memory of the cached resources of a type
+	 * exceeds its budget, the least recently used resources are removed. Referenced resources are never removed.
+	 * This class is not thread-safe and doesn't destroy the resources: removed resources are returned to the caller.
+	 * @param T Pointer on a resource providing its memory size through 'getMemorySize()'
+	 */
+	template<class T> class ResourceCache
+	{
+		public:
+			T acquire(const std::string &);
+			void add(const std::string &, T, std::type_index, std::vector<T> &);
+			void remove(const std::string &);
+			void release(const std::string &, T, std::vector<T> &);
+
+			void setBudget(std::type_index, std::size_t, std::vector<T> &);
+			void purge(std::vector<T> &);
+
+			std::vector<std::string> getResourceNames() const;
+			ResourceCacheStatistics getStatistics() const;
+			ResourceCacheStatistics getStatistics(std::type_index) const;
+
+		private:
+			struct ResourceEntry
+			{
+				T resource;
+				std::type_index type;
+				bool isCached;
+				std::size_t cachedSize;
+				typename std::list<std::string>::iterator cacheIterator;
+			};
+
+			struct TypeCache
+			{
+				TypeCache();
+
+				std::size_t budget;
+				std::list<std::string> cachedResources; //most recently used at front
+				ResourceCacheStatistics statistics;
+			};
+
+			void uncache(ResourceEntry &);
+			void evict(TypeCache &, std::vector<T> &);
+
+			std::map<std::string, ResourceEntry> resources;
+			std::map<std::type_index, TypeCache> typeCaches;
+	};
+
+	#include "ResourceCache.inl"
+
+}
+
+#endif
@@ -0,0 +1,197 @@
+template<class T> ResourceCache<T>::TypeCache::TypeCache() :
+		budget(0)
+{
+
+}
+
+/**
+ * @return Resource marked as referenced or null if the resource is not in the cache
+ */
+template<class T> T ResourceCache<T>::acquire(const std::string &name)
+{
+	auto it = resources.find(name);
+	if(it==resources.end())
+	{
+		return nullptr;
+	}
+
+	ResourceEntry &entry = it->second;
+	if(entry.isCached)
+	{
+		uncache(entry);
+	}
+	typeCaches[entry.type].statistics.hits++;
+
+	return entry.resource;
+}
+
+/**
+ * Add a referenced resource. A resource of the same name is replaced: it is returned for destruction when it is kept in
+ * cache, otherwise it should be destroyed on its last release.
+ * @param replacedResources [out] Replaced resource to destroy
+ */
+template<class T> void ResourceCache<T>::add(const std::string &name, T resource, std::type_index type, std::vector<T> &replacedResources)
+{
+	auto it = resources.find(name);
+	if(it!=resources.end())
+	{
+		if(it->second.resource==resource)
+		{
+			return;
+		}
+		if(it->second.isCached)
+		{
+			uncache(it->second);
+			replacedResources.push_back(it->second.resource);
+		}
+		resources.erase(it);
+	}
+
+	resources.insert(std::make_pair(name, ResourceEntry{resource, type, false, 0, std::list<std::string>::iterator()}));
+	typeCaches[type].statistics.misses++;
+}
+
+template<class T> void ResourceCache<T>::remove(const std::string &name)
+{
+	auto it = resources.find(name);
+	if(it!=resources.end())
+	{
+		if(it->second.isCached)
+		{
+			uncache(it->second);
+		}
+		resources.erase(it);
+	}
+}
+
+/**
+ * Mark the resource as not referenced anymore: the resource is kept in cache as the most recently used resource of its type.
+ * @param evictedResources [out] Resources to destroy: the released resource when it has been replaced and the evicted resources
+ */
+template<class T> void ResourceCache<T>::release(const std::string &name, T resource, std::vector<T> &evictedResources)
+{
+	auto it = resources.find(name);
+	if(it==resources.end() || it->second.resource!=resource)
+	{ //resource replaced
+		evictedResources.push_back(resource);
+		return;
+	}
+
+	ResourceEntry &entry = it->second;
+	TypeCache &typeCache = typeCaches[entry.type];
+	typeCache.cachedResources.push_front(it->first);
+	entry.isCached = true;
+	entry.cachedSize = resource->getMemorySize();
+	entry.cacheIterator = typeCache.cachedResources.begin();
+	typeCache.statistics.cachedBytes += entry.cachedSize;
+
+	evict(typeCache, evictedResources);
+}
+
+/**
+ * @param budget Memory (in bytes) of the unreferenced resources of the type kept in cache. Zero disables the cache.
+ * @param evictedResources [out] Resources to destroy
+ */
+template<class T> void ResourceCache<T>::setBudget(std::type_index type, std::size_t budget, std::vector<T> &evictedResources)
+{
+	TypeCache &typeCache = typeCaches[type];
+	typeCache.budget = budget;
+	evict(typeCache, evictedResources);
+}
+
+/**
+ * Remove all the unreferenced resources kept in cache. These removals are not counted as evictions.
+ * @param evictedResources [out] Resources to destroy
+ */
+template<class T> void ResourceCache<T>::purge(std::vector<T> &evictedResources)
+{
+	for(auto &typeCache : typeCaches)
+	{
+		std::size_t budget = typeCache.second.budget;
+		typeCache.second.budget = 0;
+		evict(typeCache.second, evictedResources);
+		typeCache.second.budget = budget;
+	}
+}
+
+template<class T> std::vector<std::string> ResourceCache<T>::getResourceNames() const
+{
+	std::vector<std::string> resourceNames;
+	resourceNames.reserve(resources.size());
+	for(const auto &resource : resources)
+	{
+		resourceNames.push_back(resource.first);
+	}
+	return resourceNames;
+}
+
+/**
+ * @return Statistics of all types of resources
+ */
+template<class T> ResourceCacheStatistics ResourceCache<T>::getStatistics() const
+{
+	ResourceCacheStatistics statistics;
+	for(const auto &typeCache : typeCaches)
+	{
+		statistics.hits += typeCache.second.statistics.hits;
+		statistics.misses += typeCache.second.statistics.misses;
+		statistics.evictions += typeCache.second.statistics.evictions;
+		statistics.cachedBytes += typeCache.second.statistics.cachedBytes;
+	}
+	for(const auto &resource : resources)
+	{
+		statistics.residentBytes += resource.second.resource->getMemorySize();
+	}
+
+	return statistics;
+}
+
+template<class T> ResourceCacheStatistics ResourceCache<T>::getStatistics(std::type_index type) const
+{
+	ResourceCacheStatistics statistics;
+	auto itTypeCache = typeCaches.find(type);
+	if(itTypeCache!=typeCaches.end())
+	{
+		statistics = itTypeCache->second.statistics;
+	}
+	for(const auto &resource : resources)
+	{
+		if(resource.second.type==type)
+		{
+			statistics.residentBytes += resource.second.resource->getMemorySize();
+		}
+	}
+
+	return statistics;
+}
+
+template<class T> void ResourceCache<T>::uncache(ResourceEntry &entry)
+{
+	TypeCache &typeCache = typeCaches[entry.type];
+	typeCache.cachedResources.erase(entry.cacheIterator);
+	typeCache.statistics.cachedBytes -= entry.cachedSize;
+	entry.isCached = false;
+	entry.cachedSize = 0;
+}
+
+/**
+ * Remove the least recently used resources of the cache until the cache fits in its budget. A type without budget
+ * doesn't keep any resource: an unreferenced resource is immediately removed and it is not counted as an eviction.
+ * @param evictedResources [out] Removed resources to destroy
+ */
+template<class T> void ResourceCache<T>::evict(TypeCache &typeCache, std::vector<T> &evictedResources)
+{
+	while(!typeCache.cachedResources.empty() && (typeCache.budget==0 || typeCache.statistics.cachedBytes > typeCache.budget))
+	{
+		auto it = resources.find(typeCache.cachedResources.back());
+		T resource = it->second.resource;
+		uncache(it->second);
+		resources.erase(it);
+
+		if(typeCache.budget!=0)
+		{
+			typeCache.statistics.evictions++;
+		}
+		evictedResources.push_back(resource);
+	}
+}
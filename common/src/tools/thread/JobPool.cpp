@@ -0,0 +1,137 @@
+#include <algorithm>
+
+#include "JobPool.h"
+
+namespace urchin
+{
+
+	/**
+	 * Create a pool with one worker less than the number of hardware threads: the thread calling run() executes jobs too.
+	 */
+	JobPool::JobPool() :
+			JobPool(std::max(1u, std::thread::hardware_concurrency()) - 1)
+	{
+
+	}
+
+	JobPool::JobPool(unsigned int numberWorkers) :
+			running(false),
+			batchId(0),
+			activeWorkers(0),
+			stopWorkers(false),
+			job(nullptr),
+			jobCount(0),
+			nextJobIndex(0)
+	{
+		workers.reserve(numberWorkers);
+		for(unsigned int i=0; i<numberWorkers; ++i)
+		{
+			workers.emplace_back(&JobPool::workerLoop, this);
+		}
+	}
+
+	JobPool::~JobPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(batchMutex);
+			stopWorkers = true;
+		}
+		batchStarted.notify_all();
+
+		for(auto &worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	unsigned int JobPool::getNumberWorkers() const
+	{
+		return static_cast<unsigned int>(workers.size());
+	}
+
+	/**
+	 * Execute the job for each index in [0, jobCount) and wait the end of all jobs. Jobs are executed in any order and
+	 * concurrently: they must be independent. Idle threads take the next job: small jobs balance the load between the threads.
+	 * When the pool is already running jobs (call from another thread or from a job), jobs are executed by the calling thread.
+	 * The first exception thrown by a job is rethrown once all jobs are finished.
+	 */
+	void JobPool::run(unsigned int jobCount, const std::function<void(unsigned int)> &job)
+	{
+		bool isRunning = false;
+		if(jobCount <= 1 || workers.empty() || !running.compare_exchange_strong(isRunning, true))
+		{
+			for(unsigned int jobIndex=0; jobIndex<jobCount; ++jobIndex)
+			{
+				job(jobIndex);
+			}
+			return;
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(batchMutex);
+			this->job = &job;
+			this->jobCount = jobCount;
+			this->nextJobIndex = 0;
+			this->jobException = nullptr;
+			this->activeWorkers = static_cast<unsigned int>(workers.size());
+			this->batchId++;
+		}
+		batchStarted.notify_all();
+
+		executeJobs();
+
+		std::unique_lock<std::mutex> lock(batchMutex);
+		batchDone.wait(lock, [&]{ return activeWorkers==0; });
+		this->job = nullptr;
+		running = false;
+
+		if(jobException)
+		{
+			std::rethrow_exception(jobException);
+		}
+	}
+
+	void JobPool::workerLoop()
+	{
+		unsigned long lastBatchId = 0;
+		while(true)
+		{
+			{
+				std::unique_lock<std::mutex> lock(batchMutex);
+				batchStarted.wait(lock, [&]{ return stopWorkers || batchId!=lastBatchId; });
+				if(stopWorkers)
+				{
+					return;
+				}
+				lastBatchId = batchId;
+			}
+
+			executeJobs();
+
+			{
+				std::lock_guard<std::mutex> lock(batchMutex);
+				activeWorkers--;
+			}
+			batchDone.notify_one();
+		}
+	}
+
+	void JobPool::executeJobs()
+	{
+		for(unsigned int jobIndex = nextJobIndex++; jobIndex < jobCount; jobIndex = nextJobIndex++)
+		{
+			try
+			{
+				(*job)(jobIndex);
+			}catch(...)
+			{
+				std::lock_guard<std::mutex> lock(batchMutex);
+				if(!jobException)
+				{
+					jobException = std::current_exception();
+				}
+			}
+		}
+	}
+
+}
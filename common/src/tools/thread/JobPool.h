@@ -0,0 +1,50 @@
+#ifndef URCHINENGINE_JOBPOOL_H
+#define URCHINENGINE_JOBPOOL_H
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <atomic>
+#include <functional>
+#include <exception>
+
+namespace urchin
+{
+
+	/**
+	* Pool of worker threads executing a batch of independent jobs. Threads are created once and reused for each batch.
+	*/
+	class JobPool
+	{
+		public:
+			JobPool();
+			explicit JobPool(unsigned int);
+			~JobPool();
+
+			unsigned int getNumberWorkers() const;
+
+			void run(unsigned int, const std::function<void(unsigned int)> &);
+
+		private:
+			void workerLoop();
+			void executeJobs();
+
+			std::vector<std::thread> workers;
+
+			std::atomic<bool> running;
+			std::mutex batchMutex;
+			std::condition_variable batchStarted, batchDone;
+			unsigned long batchId;
+			unsigned int activeWorkers;
+			bool stopWorkers;
+
+			const std::function<void(unsigned int)> *job;
+			unsigned int jobCount;
+			std::atomic<unsigned int> nextJobIndex;
+			std::exception_ptr jobException;
+	};
+
+}
+
+#endif
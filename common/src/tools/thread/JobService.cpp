@@ -0,0 +1,19 @@
+#include "JobService.h"
+
+namespace urchin
+{
+
+	unsigned int JobService::getNumberWorkers() const
+	{
+		return jobPool.getNumberWorkers();
+	}
+
+	/**
+	* Execute the job for each index in [0, jobCount) and wait the end of all jobs. See JobPool::run().
+	*/
+	void JobService::run(unsigned int jobCount, const std::function<void(unsigned int)> &job)
+	{
+		jobPool.run(jobCount, job);
+	}
+
+}
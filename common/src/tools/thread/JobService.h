@@ -0,0 +1,33 @@
+#ifndef URCHINENGINE_JOBSERVICE_H
+#define URCHINENGINE_JOBSERVICE_H
+
+#include <functional>
+
+#include "pattern/singleton/Singleton.h"
+#include "tools/thread/JobPool.h"
+
+namespace urchin
+{
+
+	/**
+	* Job pool shared by the engines for their heavy computations (terrain generation...): avoid to create threads for each computation
+	*/
+	class JobService : public Singleton<JobService>
+	{
+		public:
+			friend class Singleton<JobService>;
+
+			unsigned int getNumberWorkers() const;
+
+			void run(unsigned int, const std::function<void(unsigned int)> &);
+
+		private:
+			JobService() = default;
+			~JobService() override = default;
+
+			JobPool jobPool;
+	};
+
+}
+
+#endif
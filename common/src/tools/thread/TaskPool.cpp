@@ -0,0 +1,85 @@
+#include <algorithm>
+
+#include "TaskPool.h"
+
+namespace urchin
+{
+
+	/**
+	 * Create a pool with one worker per hardware thread: the thread submitting the tasks doesn't execute them.
+	 */
+	TaskPool::TaskPool() :
+			TaskPool(std::max(1u, std::thread::hardware_concurrency()))
+	{
+
+	}
+
+	TaskPool::TaskPool(unsigned int numberWorkers) :
+			stopWorkers(false)
+	{
+		workers.reserve(numberWorkers);
+		for(unsigned int i=0; i<std::max(1u, numberWorkers); ++i)
+		{
+			workers.emplace_back(&TaskPool::workerLoop, this);
+		}
+	}
+
+	/**
+	 * Tasks already submitted are executed before the workers stop.
+	 */
+	TaskPool::~TaskPool()
+	{
+		{
+			std::lock_guard<std::mutex> lock(tasksMutex);
+			stopWorkers = true;
+		}
+		taskSubmitted.notify_all();
+
+		for(auto &worker : workers)
+		{
+			worker.join();
+		}
+	}
+
+	unsigned int TaskPool::getNumberWorkers() const
+	{
+		return static_cast<unsigned int>(workers.size());
+	}
+
+	/**
+	 * @return Future of the task. An exception thrown by the task is rethrown by std::future::get().
+	 */
+	std::future<void> TaskPool::submit(const std::function<void()> &task)
+	{
+		std::packaged_task<void()> packagedTask(task);
+		std::future<void> future = packagedTask.get_future();
+		{
+			std::lock_guard<std::mutex> lock(tasksMutex);
+			tasks.push_back(std::move(packagedTask));
+		}
+		taskSubmitted.notify_one();
+
+		return future;
+	}
+
+	void TaskPool::workerLoop()
+	{
+		while(true)
+		{
+			std::packaged_task<void()> task;
+			{
+				std::unique_lock<std::mutex> lock(tasksMutex);
+				taskSubmitted.wait(lock, [&]{ return stopWorkers || !tasks.empty(); });
+				if(tasks.empty())
+				{
+					return;
+				}
+				task = std::move(tasks.front());
+				tasks.pop_front();
+			}
+
+			task();
+		}
+	}
+
+}
@@ -0,0 +1,43 @@
+#ifndef URCHINENGINE_TASKPOOL_H
+#define URCHINENGINE_TASKPOOL_H
+
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <future>
+
+namespace urchin
+{
+
+	/**
+	* Pool of worker threads executing asynchronous tasks in their submission order. Unlike JobPool, the submitting thread
+	* doesn't wait: the end of each task is given by its future.
+	*/
+	class TaskPool
+	{
+		public:
+			TaskPool();
+			explicit TaskPool(unsigned int);
+			~TaskPool();
+
+			unsigned int getNumberWorkers() const;
+
+			std::future<void> submit(const std::function<void()> &);
+
+		private:
+			void workerLoop();
+
+			std::vector<std::thread> workers;
+
+			std::mutex tasksMutex;
+			std::condition_variable taskSubmitted;
+			std::deque<std::packaged_task<void()>> tasks;
+			bool stopWorkers;
+	};
+
+}
+
+#endif
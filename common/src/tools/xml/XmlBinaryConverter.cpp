@@ -0,0 +1,242 @@
+#include <stdexcept>
+#include <cstring>
+
+#include "tools/xml/XmlBinaryConverter.h"
+#include "io/Converter.h"
+#include "io/StringUtil.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param xmlFilenamePath Path to the XML file to convert
+	 * @param binaryFilenamePath Path to the binary file to create
+	 */
+	void XmlBinaryConverter::xmlToBinary(const std::string &xmlFilenamePath, const std::string &binaryFilenamePath)
+	{
+		TiXmlDocument doc(xmlFilenamePath.c_str());
+		if(!doc.LoadFile() || !doc.RootElement())
+		{
+			throw std::invalid_argument("Cannot open or load the file " + xmlFilenamePath + ".");
+		}
+
+		clear();
+		addElement(doc.RootElement());
+
+		for(unsigned int sectionElement = elements[0].firstChild; sectionElement!=XML_BINARY_NO_INDEX; sectionElement = elements[sectionElement].nextSibling)
+		{
+			XmlBinaryDocument::Section section = {};
+			section.name = elements[sectionElement].name;
+			section.element = sectionElement;
+			for(unsigned int record = elements[sectionElement].firstChild; record!=XML_BINARY_NO_INDEX; record = elements[record].nextSibling)
+			{
+				section.recordCount++;
+			}
+			sections.push_back(section);
+		}
+
+		writeBinaryFile(binaryFilenamePath);
+		clear();
+	}
+
+	/**
+	 * @param binaryFilenamePath Path to the binary file to convert
+	 * @param xmlFilenamePath Path to the XML file to create
+	 */
+	void XmlBinaryConverter::binaryToXml(const std::string &binaryFilenamePath, const std::string &xmlFilenamePath) const
+	{
+		XmlBinaryDocument binaryDocument(binaryFilenamePath);
+
+		TiXmlDocument doc;
+		doc.LinkEndChild(new TiXmlDeclaration("1.0", "", ""));
+		doc.LinkEndChild(toXmlElement(binaryDocument, binaryDocument.getRootElement()));
+
+		if(!doc.SaveFile(xmlFilenamePath))
+		{
+			throw std::invalid_argument("Cannot save the file " + xmlFilenamePath + ".");
+		}
+	}
+
+	/**
+	 * Add the element and its descendants in pre-order
+	 * @return Index of the added element
+	 */
+	unsigned int XmlBinaryConverter::addElement(const TiXmlElement *xmlElement)
+	{
+		auto elementIndex = static_cast<unsigned int>(elements.size());
+		elements.emplace_back();
+
+		XmlBinaryDocument::Element element = {};
+		element.name = addString(xmlElement->ValueStr());
+		element.value = XML_BINARY_NO_INDEX;
+		element.firstChild = XML_BINARY_NO_INDEX;
+		element.nextSibling = XML_BINARY_NO_INDEX;
+
+		element.firstAttribute = static_cast<unsigned int>(attributes.size());
+		for(const TiXmlAttribute *xmlAttribute = xmlElement->FirstAttribute(); xmlAttribute!=nullptr; xmlAttribute = xmlAttribute->Next())
+		{
+			XmlBinaryDocument::Attribute attribute = {};
+			attribute.name = addString(xmlAttribute->NameTStr());
+			attribute.value = addString(xmlAttribute->ValueStr());
+			attributes.push_back(attribute);
+			element.attributeCount++;
+		}
+
+		element.firstFloat = static_cast<unsigned int>(floats.size());
+		const char *text = xmlElement->GetText();
+		if(text)
+		{
+			element.value = addString(text);
+			addFloatValues(text, element);
+		}
+
+		unsigned int previousChild = XML_BINARY_NO_INDEX;
+		for(const TiXmlElement *xmlChild = xmlElement->FirstChildElement(); xmlChild!=nullptr; xmlChild = xmlChild->NextSiblingElement())
+		{
+			unsigned int child = addElement(xmlChild);
+			if(previousChild==XML_BINARY_NO_INDEX)
+			{
+				element.firstChild = child;
+			}else
+			{
+				elements[previousChild].nextSibling = child;
+			}
+			previousChild = child;
+		}
+
+		elements[elementIndex] = element;
+		return elementIndex;
+	}
+
+	/**
+	 * Store the text value as floats when the text is a list of floats
+	 */
+	void XmlBinaryConverter::addFloatValues(const std::string &text, XmlBinaryDocument::Element &element)
+	{
+		std::vector<std::string> stringValues;
+		StringUtil::split(text, FLOAT_DELIMITOR, stringValues);
+
+		for(const auto &stringValue : stringValues)
+		{
+			if(!Converter::isFloat(stringValue))
+			{
+				return;
+			}
+		}
+
+		for(const auto &stringValue : stringValues)
+		{
+			floats.push_back(Converter::toFloat(stringValue));
+		}
+		element.floatCount = static_cast<unsigned int>(stringValues.size());
+	}
+
+	/**
+	 * @return Index of the string in the string table. Identical strings share the same index.
+	 */
+	unsigned int XmlBinaryConverter::addString(const std::string &str)
+	{
+		auto itFind = stringIndexes.find(str);
+		if(itFind!=stringIndexes.end())
+		{
+			return itFind->second;
+		}
+
+		auto stringIndex = static_cast<unsigned int>(stringOffsets.size());
+		stringOffsets.push_back(static_cast<unsigned int>(stringData.size()));
+		stringData.insert(stringData.end(), str.begin(), str.end());
+		stringData.push_back('\0');
+		stringIndexes[str] = stringIndex;
+
+		return stringIndex;
+	}
+
+	void XmlBinaryConverter::clear()
+	{
+		sections.clear();
+		elements.clear();
+		attributes.clear();
+		floats.clear();
+		stringOffsets.clear();
+		stringData.clear();
+		stringIndexes.clear();
+	}
+
+	void XmlBinaryConverter::writeBinaryFile(const std::string &binaryFilenamePath) const
+	{
+		auto alignedSize = [](std::size_t size) {
+			return static_cast<unsigned int>((size + sizeof(unsigned int) - 1) & ~(sizeof(unsigned int) - 1));
+		};
+
+		XmlBinaryDocument::Header header = {};
+		std::memcpy(header.magic, XML_BINARY_MAGIC, sizeof(header.magic));
+		header.version = XML_BINARY_VERSION;
+		header.sectionCount = static_cast<unsigned int>(sections.size());
+		header.sectionOffset = alignedSize(sizeof(header));
+		header.elementCount = static_cast<unsigned int>(elements.size());
+		header.elementOffset = header.sectionOffset + alignedSize(sections.size() * sizeof(XmlBinaryDocument::Section));
+		header.attributeCount = static_cast<unsigned int>(attributes.size());
+		header.attributeOffset = header.elementOffset + alignedSize(elements.size() * sizeof(XmlBinaryDocument::Element));
+		header.floatCount = static_cast<unsigned int>(floats.size());
+		header.floatOffset = header.attributeOffset + alignedSize(attributes.size() * sizeof(XmlBinaryDocument::Attribute));
+		header.stringCount = static_cast<unsigned int>(stringOffsets.size());
+		header.stringOffset = header.floatOffset + alignedSize(floats.size() * sizeof(float));
+		header.stringDataSize = static_cast<unsigned int>(stringData.size());
+		header.stringDataOffset = header.stringOffset + alignedSize(stringOffsets.size() * sizeof(unsigned int));
+
+		std::ofstream file(binaryFilenamePath, std::ios::out | std::ios::binary | std::ios::trunc);
+		if(!file.is_open())
+		{
+			throw std::invalid_argument("Cannot save the file " + binaryFilenamePath + ".");
+		}
+
+		file.write(reinterpret_cast<const char *>(&header), sizeof(header));
+		file.seekp(header.sectionOffset);
+		writeTable(file, sections);
+		file.seekp(header.elementOffset);
+		writeTable(file, elements);
+		file.seekp(header.attributeOffset);
+		writeTable(file, attributes);
+		file.seekp(header.floatOffset);
+		writeTable(file, floats);
+		file.seekp(header.stringOffset);
+		writeTable(file, stringOffsets);
+		file.seekp(header.stringDataOffset);
+		writeTable(file, stringData);
+
+		if(!file.good())
+		{
+			throw std::invalid_argument("Cannot save the file " + binaryFilenamePath + ".");
+		}
+	}
+
+	template<class T> void XmlBinaryConverter::writeTable(std::ofstream &file, const std::vector<T> &table) const
+	{
+		file.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(T));
+	}
+
+	TiXmlElement *XmlBinaryConverter::toXmlElement(const XmlBinaryDocument &binaryDocument, unsigned int element) const
+	{
+		auto *xmlElement = new TiXmlElement(binaryDocument.getName(element));
+
+		const XmlBinaryDocument::Element &elementRecord = binaryDocument.elements[element];
+		for(unsigned int i=0; i<elementRecord.attributeCount; ++i)
+		{
+			const XmlBinaryDocument::Attribute &attribute = binaryDocument.attributes[elementRecord.firstAttribute + i];
+			xmlElement->SetAttribute(binaryDocument.getString(attribute.name), binaryDocument.getString(attribute.value));
+		}
+
+		if(binaryDocument.getValue(element))
+		{
+			xmlElement->LinkEndChild(new TiXmlText(binaryDocument.getValue(element)));
+		}
+
+		for(unsigned int child = binaryDocument.getFirstChild(element); child!=XML_BINARY_NO_INDEX; child = binaryDocument.getNextSibling(child))
+		{
+			xmlElement->LinkEndChild(toXmlElement(binaryDocument, child));
+		}
+
+		return xmlElement;
+	}
+
+}
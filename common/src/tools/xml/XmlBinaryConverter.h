@@ -0,0 +1,47 @@
+#ifndef URCHINENGINE_XMLBINARYCONVERTER_H
+#define URCHINENGINE_XMLBINARYCONVERTER_H
+
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+
+#include "libs/tinyxml/tinyxml.h"
+#include "tools/xml/XmlBinaryDocument.h"
+
+namespace urchin
+{
+
+	/**
+	* Converter between XML files and binary XML files (see XmlBinaryDocument).
+	* Comments are not kept in binary files and text values are trimmed.
+	*/
+	class XmlBinaryConverter
+	{
+		public:
+			void xmlToBinary(const std::string &, const std::string &);
+			void binaryToXml(const std::string &, const std::string &) const;
+
+		private:
+			unsigned int addElement(const TiXmlElement *);
+			void addFloatValues(const std::string &, XmlBinaryDocument::Element &);
+			unsigned int addString(const std::string &);
+			void clear();
+
+			void writeBinaryFile(const std::string &) const;
+			template<class T> void writeTable(std::ofstream &, const std::vector<T> &) const;
+
+			TiXmlElement *toXmlElement(const XmlBinaryDocument &, unsigned int) const;
+
+			std::vector<XmlBinaryDocument::Section> sections;
+			std::vector<XmlBinaryDocument::Element> elements;
+			std::vector<XmlBinaryDocument::Attribute> attributes;
+			std::vector<float> floats;
+			std::vector<unsigned int> stringOffsets;
+			std::vector<char> stringData;
+			std::map<std::string, unsigned int> stringIndexes;
+	};
+
+}
+
+#endif
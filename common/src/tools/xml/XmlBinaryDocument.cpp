@@ -0,0 +1,234 @@
+#include <stdexcept>
+#include <cstring>
+#include <fstream>
+
+#include "tools/xml/XmlBinaryDocument.h"
+
+namespace urchin
+{
+
+	/**
+	 * @param filenamePath Path to the binary file
+	 */
+	XmlBinaryDocument::XmlBinaryDocument(const std::string &filenamePath) :
+			mappedFile(filenamePath),
+			data(mappedFile.getData())
+	{
+		if(mappedFile.getSize() < sizeof(Header) || std::memcmp(data, XML_BINARY_MAGIC, sizeof(Header::magic))!=0)
+		{
+			throw std::invalid_argument("File " + filenamePath + " is not a binary XML file.");
+		}
+
+		header = reinterpret_cast<const Header *>(data);
+		if(header->version!=XML_BINARY_VERSION)
+		{
+			throw std::invalid_argument("Binary XML file " + filenamePath + " has an unsupported version: " + std::to_string(header->version) + ".");
+		}
+
+		checkTable(header->sectionOffset, header->sectionCount, sizeof(Section));
+		checkTable(header->elementOffset, header->elementCount, sizeof(Element));
+		checkTable(header->attributeOffset, header->attributeCount, sizeof(Attribute));
+		checkTable(header->floatOffset, header->floatCount, sizeof(float));
+		checkTable(header->stringOffset, header->stringCount, sizeof(unsigned int));
+		checkTable(header->stringDataOffset, header->stringDataSize, sizeof(char));
+		if(header->elementCount==0)
+		{
+			throw std::invalid_argument("Binary XML file " + filenamePath + " has no root element.");
+		}
+
+		sections = reinterpret_cast<const Section *>(data + header->sectionOffset);
+		elements = reinterpret_cast<const Element *>(data + header->elementOffset);
+		attributes = reinterpret_cast<const Attribute *>(data + header->attributeOffset);
+		floats = reinterpret_cast<const float *>(data + header->floatOffset);
+		stringOffsets = reinterpret_cast<const unsigned int *>(data + header->stringOffset);
+		stringData = data + header->stringDataOffset;
+
+		checkRecords();
+	}
+
+	bool XmlBinaryDocument::isBinaryFile(const std::string &filenamePath)
+	{
+		std::ifstream file(filenamePath, std::ios::in | std::ios::binary);
+		char magic[sizeof(Header::magic)];
+		return file.read(magic, sizeof(magic)) && std::memcmp(magic, XML_BINARY_MAGIC, sizeof(magic))==0;
+	}
+
+	void XmlBinaryDocument::checkTable(unsigned int offset, unsigned int count, std::size_t recordSize) const
+	{
+		if(offset % sizeof(unsigned int)!=0 || offset > mappedFile.getSize() || count * recordSize > mappedFile.getSize() - offset)
+		{
+			throwCorruptedFile();
+		}
+	}
+
+	/**
+	 * Check the indices and offsets of all records once: accessors don't need any bound check
+	 */
+	void XmlBinaryDocument::checkRecords() const
+	{
+		//each string is terminated inside the string data when the last character is a terminator
+		if(header->stringCount > 0 && (header->stringDataSize==0 || stringData[header->stringDataSize - 1]!='\0'))
+		{
+			throwCorruptedFile();
+		}
+		for(unsigned int i=0; i<header->stringCount; ++i)
+		{
+			checkIndex(stringOffsets[i], header->stringDataSize);
+		}
+
+		for(unsigned int i=0; i<header->sectionCount; ++i)
+		{
+			checkIndex(sections[i].name, header->stringCount);
+			checkIndex(sections[i].element, header->elementCount);
+		}
+
+		for(unsigned int i=0; i<header->elementCount; ++i)
+		{
+			const Element &element = elements[i];
+			checkIndex(element.name, header->stringCount);
+			if(element.value!=XML_BINARY_NO_INDEX)
+			{
+				checkIndex(element.value, header->stringCount);
+			}
+
+			//elements are stored in pre-order: following the children and the siblings cannot loop
+			if(element.firstChild!=XML_BINARY_NO_INDEX && (element.firstChild <= i || element.firstChild >= header->elementCount))
+			{
+				throwCorruptedFile();
+			}
+			if(element.nextSibling!=XML_BINARY_NO_INDEX && (element.nextSibling <= i || element.nextSibling >= header->elementCount))
+			{
+				throwCorruptedFile();
+			}
+
+			checkRange(element.firstAttribute, element.attributeCount, header->attributeCount);
+			checkRange(element.firstFloat, element.floatCount, header->floatCount);
+		}
+
+		for(unsigned int i=0; i<header->attributeCount; ++i)
+		{
+			checkIndex(attributes[i].name, header->stringCount);
+			checkIndex(attributes[i].value, header->stringCount);
+		}
+	}
+
+	void XmlBinaryDocument::checkIndex(unsigned int index, unsigned int count) const
+	{
+		if(index >= count)
+		{
+			throwCorruptedFile();
+		}
+	}
+
+	void XmlBinaryDocument::checkRange(unsigned int first, unsigned int rangeCount, unsigned int count) const
+	{
+		if(first > count || rangeCount > count - first)
+		{
+			throwCorruptedFile();
+		}
+	}
+
+	void XmlBinaryDocument::throwCorruptedFile() const
+	{
+		throw std::invalid_argument("Binary XML file " + mappedFile.getFilenamePath() + " is corrupted.");
+	}
+
+	const char *XmlBinaryDocument::getString(unsigned int stringIndex) const
+	{
+		if(stringIndex==XML_BINARY_NO_INDEX)
+		{
+			return nullptr;
+		}
+		return stringData + stringOffsets[stringIndex];
+	}
+
+	unsigned int XmlBinaryDocument::getRootElement() const
+	{
+		return 0;
+	}
+
+	unsigned int XmlBinaryDocument::getSectionCount() const
+	{
+		return header->sectionCount;
+	}
+
+	const char *XmlBinaryDocument::getSectionName(unsigned int sectionIndex) const
+	{
+		return getString(sections[sectionIndex].name);
+	}
+
+	unsigned int XmlBinaryDocument::getSectionElement(unsigned int sectionIndex) const
+	{
+		return sections[sectionIndex].element;
+	}
+
+	/**
+	 * @return Number of children elements of the section element
+	 */
+	unsigned int XmlBinaryDocument::getSectionRecordCount(unsigned int sectionIndex) const
+	{
+		return sections[sectionIndex].recordCount;
+	}
+
+	const char *XmlBinaryDocument::getName(unsigned int element) const
+	{
+		return getString(elements[element].name);
+	}
+
+	/**
+	 * @return Text value of the element or null if element doesn't have text
+	 */
+	const char *XmlBinaryDocument::getValue(unsigned int element) const
+	{
+		return getString(elements[element].value);
+	}
+
+	/**
+	 * @param floatCount [out] Number of floats: zero if the text value is not a list of floats
+	 * @return Floats of the text value
+	 */
+	const float *XmlBinaryDocument::getFloatValues(unsigned int element, unsigned int &floatCount) const
+	{
+		floatCount = elements[element].floatCount;
+		return floats + elements[element].firstFloat;
+	}
+
+	/**
+	 * @return Attribute value if exist otherwise null
+	 */
+	const char *XmlBinaryDocument::getAttributeValue(unsigned int element, const char *attributeName) const
+	{
+		const Element &elementRecord = elements[element];
+		for(unsigned int i=0; i<elementRecord.attributeCount; ++i)
+		{
+			const Attribute &attribute = attributes[elementRecord.firstAttribute + i];
+			if(std::strcmp(getString(attribute.name), attributeName)==0)
+			{
+				return getString(attribute.value);
+			}
+		}
+		return nullptr;
+	}
+
+	/**
+	 * @return First child element or XML_BINARY_NO_INDEX if element doesn't have child
+	 */
+	unsigned int XmlBinaryDocument::getFirstChild(unsigned int element) const
+	{
+		return elements[element].firstChild;
+	}
+
+	/**
+	 * @return Next sibling element or XML_BINARY_NO_INDEX if element is the last child
+	 */
+	unsigned int XmlBinaryDocument::getNextSibling(unsigned int element) const
+	{
+		return elements[element].nextSibling;
+	}
+
+	const std::string &XmlBinaryDocument::getFilenamePath() const
+	{
+		return mappedFile.getFilenamePath();
+	}
+
+}
@@ -0,0 +1,103 @@
+#ifndef URCHINENGINE_XMLBINARYDOCUMENT_H
+#define URCHINENGINE_XMLBINARYDOCUMENT_H
+
+#include <string>
+#include <vector>
+
+#include "tools/file/MemoryMappedFile.h"
+
+namespace urchin
+{
+
+	/**
+	* Read only XML document stored in a binary versioned file. The file is memory mapped: names, values and attributes are
+	* read directly from the mapped memory and numeric values are stored as floats to avoid any text conversion.
+	* File layout: header, section table (one section per child of the root element), element table, attribute table,
+	* float table and string table. Binary files are created by XmlBinaryConverter.
+	*/
+	class XmlBinaryDocument
+	{
+		#define XML_BINARY_MAGIC "URCHBXML"
+		#define XML_BINARY_VERSION 1
+		#define XML_BINARY_NO_INDEX 0xFFFFFFFFu
+
+		public:
+			friend class XmlBinaryConverter;
+
+			explicit XmlBinaryDocument(const std::string &);
+
+			static bool isBinaryFile(const std::string &);
+
+			unsigned int getRootElement() const;
+			unsigned int getSectionCount() const;
+			const char *getSectionName(unsigned int) const;
+			unsigned int getSectionElement(unsigned int) const;
+			unsigned int getSectionRecordCount(unsigned int) const;
+
+			const char *getName(unsigned int) const;
+			const char *getValue(unsigned int) const;
+			const float *getFloatValues(unsigned int, unsigned int &) const;
+			const char *getAttributeValue(unsigned int, const char *) const;
+			unsigned int getFirstChild(unsigned int) const;
+			unsigned int getNextSibling(unsigned int) const;
+
+			const std::string &getFilenamePath() const;
+
+		private:
+			struct Header
+			{
+				char magic[8];
+				unsigned int version;
+				unsigned int sectionCount, sectionOffset;
+				unsigned int elementCount, elementOffset;
+				unsigned int attributeCount, attributeOffset;
+				unsigned int floatCount, floatOffset;
+				unsigned int stringCount, stringOffset;
+				unsigned int stringDataSize, stringDataOffset;
+			};
+
+			struct Section
+			{
+				unsigned int name;
+				unsigned int element;
+				unsigned int recordCount;
+			};
+
+			struct Element
+			{
+				unsigned int name;
+				unsigned int value;
+				unsigned int firstChild;
+				unsigned int nextSibling;
+				unsigned int firstAttribute, attributeCount;
+				unsigned int firstFloat, floatCount;
+			};
+
+			struct Attribute
+			{
+				unsigned int name;
+				unsigned int value;
+			};
+
+			void checkTable(unsigned int, unsigned int, std::size_t) const;
+			void checkRecords() const;
+			void checkIndex(unsigned int, unsigned int) const;
+			void checkRange(unsigned int, unsigned int, unsigned int) const;
+			void throwCorruptedFile() const;
+			const char *getString(unsigned int) const;
+
+			MemoryMappedFile mappedFile;
+			const char *data;
+
+			const Header *header;
+			const Section *sections;
+			const Element *elements;
+			const Attribute *attributes;
+			const float *floats;
+			const unsigned int *stringOffsets;
+			const char *stringData;
+	};
+
+}
+
+#endif
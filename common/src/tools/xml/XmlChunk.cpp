@@ -7,7 +7,9 @@ namespace urchin
 {
 
 	XmlChunk::XmlChunk(TiXmlElement *chunk) :
-			chunk(chunk)
+			chunk(chunk),
+			binaryDocument(nullptr),
+			binaryElement(0)
 	{
 
 	}
@@ -18,16 +20,60 @@ namespace urchin
 
 	}
 
+	/**
+	 * Read only chunk backed by a binary XML document
+	 */
+	XmlChunk::XmlChunk(const XmlBinaryDocument *binaryDocument, unsigned int binaryElement) :
+			chunk(nullptr),
+			binaryDocument(binaryDocument),
+			binaryElement(binaryElement)
+	{
+
+	}
+
 	TiXmlElement *XmlChunk::getChunk() const
 	{
 		return chunk;
 	}
 
+	/**
+	 * @return Float values stored in the binary document when the chunk value is a list of the expected number of floats, null otherwise
+	 */
+	const float *XmlChunk::getBinaryFloatValues(unsigned int expectedFloatCount) const
+	{
+		if(binaryDocument)
+		{
+			unsigned int floatCount;
+			const float *floatValues = binaryDocument->getFloatValues(binaryElement, floatCount);
+			if(floatCount==expectedFloatCount)
+			{
+				return floatValues;
+			}
+		}
+		return nullptr;
+	}
+
+	std::string XmlChunk::getName() const
+	{
+		if(binaryDocument)
+		{
+			return binaryDocument->getName(binaryElement);
+		}
+
+		return chunk->ValueStr();
+	}
+
 	/**
 	 * @return Attribute value if exist otherwise an empty string
 	 */
 	std::string XmlChunk::getAttributeValue(const std::string &attributeName) const
 	{
+		if(binaryDocument)
+		{
+			const char *attributeValue = binaryDocument->getAttributeValue(binaryElement, attributeName.c_str());
+			return attributeValue ? attributeValue : "";
+		}
+
 		return *chunk->ToElement()->Attribute(attributeName);
 	}
 
@@ -38,6 +84,12 @@ namespace urchin
 
 	std::string XmlChunk::getStringValue() const
 	{
+		if(binaryDocument)
+		{
+			const char *value = binaryDocument->getValue(binaryElement);
+			return value ? value : "";
+		}
+
 		if(!chunk->FirstChild())
 		{
 			return "";
@@ -76,6 +128,12 @@ namespace urchin
 
 	float XmlChunk::getFloatValue() const
 	{
+		const float *floatValues = getBinaryFloatValues(1);
+		if(floatValues)
+		{
+			return floatValues[0];
+		}
+
 		return Converter::toFloat(getStringValue());
 	}
 
@@ -123,6 +181,12 @@ namespace urchin
 
 	Point2<float> XmlChunk::getPoint2Value() const
 	{
+		const float *floatValues = getBinaryFloatValues(2);
+		if(floatValues)
+		{
+			return Point2<float>(floatValues[0], floatValues[1]);
+		}
+
 		return Converter::toPoint2(getStringValue());
 	}
 
@@ -135,6 +199,12 @@ namespace urchin
 
 	Point3<float> XmlChunk::getPoint3Value() const
 	{
+		const float *floatValues = getBinaryFloatValues(3);
+		if(floatValues)
+		{
+			return Point3<float>(floatValues[0], floatValues[1], floatValues[2]);
+		}
+
 		return Converter::toPoint3(getStringValue());
 	}
 
@@ -147,6 +217,12 @@ namespace urchin
 
 	Point4<float> XmlChunk::getPoint4Value() const
 	{
+		const float *floatValues = getBinaryFloatValues(4);
+		if(floatValues)
+		{
+			return Point4<float>(floatValues[0], floatValues[1], floatValues[2], floatValues[3]);
+		}
+
 		return Converter::toPoint4(getStringValue());
 	}
 
@@ -160,6 +236,12 @@ namespace urchin
 
 	Vector2<float> XmlChunk::getVector2Value() const
 	{
+		const float *floatValues = getBinaryFloatValues(2);
+		if(floatValues)
+		{
+			return Vector2<float>(floatValues[0], floatValues[1]);
+		}
+
 		return Converter::toVector2(getStringValue());
 	}
 
@@ -172,6 +254,12 @@ namespace urchin
 
 	Vector3<float> XmlChunk::getVector3Value() const
 	{
+		const float *floatValues = getBinaryFloatValues(3);
+		if(floatValues)
+		{
+			return Vector3<float>(floatValues[0], floatValues[1], floatValues[2]);
+		}
+
 		return Converter::toVector3(getStringValue());
 	}
 
@@ -184,6 +272,12 @@ namespace urchin
 
 	Vector4<float> XmlChunk::getVector4Value() const
 	{
+		const float *floatValues = getBinaryFloatValues(4);
+		if(floatValues)
+		{
+			return Vector4<float>(floatValues[0], floatValues[1], floatValues[2], floatValues[3]);
+		}
+
 		return Converter::toVector4(getStringValue());
 	}
 
@@ -194,4 +288,46 @@ namespace urchin
 		setStringValue(std::to_string(value.X) + FLOAT_DELIMITOR + std::to_string(value.Y) + FLOAT_DELIMITOR + std::to_string(value.Z)
 			+ FLOAT_DELIMITOR + std::to_string(value.W));
 	}
+
+	/**
+	 * @param textValues [out] Text values of the chunk and of all its descendants in document order
+	 */
+	void XmlChunk::getTextValues(std::vector<std::string> &textValues) const
+	{
+		if(binaryDocument)
+		{
+			getBinaryTextValues(binaryElement, textValues);
+		}else
+		{
+			getTextValues(chunk, textValues);
+		}
+	}
+
+	void XmlChunk::getTextValues(const TiXmlElement *element, std::vector<std::string> &textValues)
+	{
+		for(const TiXmlNode *child = element->FirstChild(); child!=nullptr; child = child->NextSibling())
+		{
+			if(child->Type()==TiXmlNode::TEXT)
+			{
+				textValues.push_back(child->ValueStr());
+			}else if(child->Type()==TiXmlNode::ELEMENT)
+			{
+				getTextValues(child->ToElement(), textValues);
+			}
+		}
+	}
+
+	void XmlChunk::getBinaryTextValues(unsigned int element, std::vector<std::string> &textValues) const
+	{
+		const char *value = binaryDocument->getValue(element);
+		if(value)
+		{
+			textValues.emplace_back(value);
+		}
+
+		for(unsigned int child = binaryDocument->getFirstChild(element); child!=XML_BINARY_NO_INDEX; child = binaryDocument->getNextSibling(child))
+		{
+			getBinaryTextValues(child, textValues);
+		}
+	}
 }
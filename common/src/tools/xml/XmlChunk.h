@@ -6,6 +6,7 @@
 
 #include "libs/tinyxml/tinyxml.h"
 #include "tools/xml/XmlAttribute.h"
+#include "tools/xml/XmlBinaryDocument.h"
 #include "math/algebra/point/Point2.h"
 #include "math/algebra/point/Point3.h"
 #include "math/algebra/point/Point4.h"
@@ -30,6 +31,9 @@ namespace urchin
 
 			explicit XmlChunk(TiXmlElement *);
 			explicit XmlChunk(const TiXmlElement *);
+			XmlChunk(const XmlBinaryDocument *, unsigned int);
+
+			std::string getName() const;
 
 			std::string getAttributeValue(const std::string &) const;
 			void setAttribute(const XmlAttribute &);
@@ -70,10 +74,17 @@ namespace urchin
 			Vector4<float> getVector4Value() const;
 			void setVector4Value(const Vector4<float> &);
 
+			void getTextValues(std::vector<std::string> &) const;
+
 		private:
 			TiXmlElement *getChunk() const;
+			const float *getBinaryFloatValues(unsigned int) const;
+			static void getTextValues(const TiXmlElement *, std::vector<std::string> &);
+			void getBinaryTextValues(unsigned int, std::vector<std::string> &) const;
 
 			TiXmlElement *chunk;
+			const XmlBinaryDocument *binaryDocument;
+			unsigned int binaryElement;
 	};
 
 }
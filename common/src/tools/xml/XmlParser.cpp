@@ -16,7 +16,8 @@ namespace urchin
 	/**
 	 * @param workingDirectory Override the default working directory
 	 */
-	XmlParser::XmlParser(const std::string &filename, const std::string &workingDirectory)
+	XmlParser::XmlParser(const std::string &filename, const std::string &workingDirectory) :
+			binaryDocument(nullptr)
 	{
 		this->filenamePath = workingDirectory + filename;
 		this->doc = new TiXmlDocument(filenamePath.c_str());
@@ -28,6 +29,28 @@ namespace urchin
 		}
 	}
 
+	/**
+	 * @param doc Document already loaded. Parser takes the ownership of the document.
+	 */
+	XmlParser::XmlParser(TiXmlDocument *doc, std::string filenamePath) :
+			doc(doc),
+			binaryDocument(nullptr),
+			filenamePath(std::move(filenamePath))
+	{
+
+	}
+
+	/**
+	 * @param binaryDocument Binary XML document which must remain valid during the parser life
+	 */
+	XmlParser::XmlParser(const XmlBinaryDocument &binaryDocument) :
+			doc(nullptr),
+			binaryDocument(&binaryDocument),
+			filenamePath(binaryDocument.getFilenamePath())
+	{
+
+	}
+
 	XmlParser::~XmlParser()
 	{
 		delete doc;
@@ -35,6 +58,11 @@ namespace urchin
 
 	std::shared_ptr<XmlChunk> XmlParser::getRootChunk() const
 	{
+		if(binaryDocument)
+		{
+			return std::make_shared<XmlChunk>(binaryDocument, binaryDocument->getRootElement());
+		}
+
 		const TiXmlNode *rootNode = doc->FirstChild()->NextSibling();
 		if(rootNode->Type()==TiXmlNode::ELEMENT)
 		{
@@ -55,6 +83,12 @@ namespace urchin
 	{
 		std::vector<std::shared_ptr<XmlChunk>> chunks;
 
+		if(binaryDocument)
+		{
+			getBinaryChunks(chunkName, attribute, parent, chunks);
+			return chunks;
+		}
+
 		const TiXmlNode *firstChild;
 		if(!parent)
 		{
@@ -114,6 +148,29 @@ namespace urchin
 		return chunks[0];
 	}
 
+	void XmlParser::getBinaryChunks(const std::string &chunkName, const XmlAttribute &attribute, const std::shared_ptr<XmlChunk> &parent,
+			std::vector<std::shared_ptr<XmlChunk>> &chunks) const
+	{
+		unsigned int parentElement = parent ? parent->binaryElement : binaryDocument->getRootElement();
+		for(unsigned int child = binaryDocument->getFirstChild(parentElement); child!=XML_BINARY_NO_INDEX; child = binaryDocument->getNextSibling(child))
+		{
+			if(chunkName==binaryDocument->getName(child))
+			{
+				if(!attribute.getAttributeName().empty())
+				{
+					const char *attributeValue = binaryDocument->getAttributeValue(child, attribute.getAttributeName().c_str());
+					if(attributeValue && attribute.getAttributeValue()==attributeValue)
+					{
+						chunks.push_back(std::make_shared<XmlChunk>(binaryDocument, child));
+					}
+				}else
+				{
+					chunks.push_back(std::make_shared<XmlChunk>(binaryDocument, child));
+				}
+			}
+		}
+	}
+
 	std::string XmlParser::getChunkDescription(const std::string &chunkName, const XmlAttribute &attribute) const
 	{
 		if(attribute.getAttributeName().empty())
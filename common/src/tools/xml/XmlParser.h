@@ -8,6 +8,7 @@
 #include "libs/tinyxml/tinyxml.h"
 #include "tools/xml/XmlAttribute.h"
 #include "tools/xml/XmlChunk.h"
+#include "tools/xml/XmlBinaryDocument.h"
 
 namespace urchin
 {
@@ -18,8 +19,11 @@ namespace urchin
 	class XmlParser
 	{
 		public:
+			friend class XmlStreamParser;
+
 			explicit XmlParser(const std::string &);
 			XmlParser(const std::string &, const std::string &);
+			explicit XmlParser(const XmlBinaryDocument &);
 			~XmlParser();
 
 			std::shared_ptr<XmlChunk> getRootChunk() const;
@@ -27,9 +31,13 @@ namespace urchin
 			std::shared_ptr<XmlChunk> getUniqueChunk(bool, const std::string &, const XmlAttribute & = XmlAttribute(), const std::shared_ptr<XmlChunk> &parent = std::shared_ptr<XmlChunk>()) const;
 		
 		private:
+			XmlParser(TiXmlDocument *, std::string);
+
+			void getBinaryChunks(const std::string &, const XmlAttribute &, const std::shared_ptr<XmlChunk> &, std::vector<std::shared_ptr<XmlChunk>> &) const;
 			std::string getChunkDescription(const std::string &, const XmlAttribute &) const;
 
 			TiXmlDocument *doc;
+			const XmlBinaryDocument *binaryDocument;
 			std::string filenamePath;
 	};
 
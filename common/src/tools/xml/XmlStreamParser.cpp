@@ -0,0 +1,399 @@
+#include <stdexcept>
+#include <cstring>
+
+#include "tools/xml/XmlStreamParser.h"
+#include "system/FileSystem.h"
+
+namespace urchin
+{
+
+	constexpr unsigned int XmlStreamParser::BUFFER_SIZE;
+
+	XmlStreamParser::XmlStreamParser(const std::string &filename) :
+		XmlStreamParser(filename, FileSystem::instance()->getResourcesDirectory())
+	{
+
+	}
+
+	/**
+	 * @param workingDirectory Override the default working directory
+	 */
+	XmlStreamParser::XmlStreamParser(const std::string &filename, const std::string &workingDirectory) :
+			filenamePath(workingDirectory + filename),
+			file(filenamePath, std::ios::in | std::ios::binary),
+			buffer(BUFFER_SIZE),
+			bufferPosition(0),
+			bufferSize(0),
+			eventType(END_DOCUMENT),
+			depth(0),
+			isEmptyElement(false),
+			isCapturing(false),
+			chunkParser(new TiXmlDocument(), filenamePath)
+	{
+		if(!file.is_open())
+		{
+			throw std::invalid_argument("Cannot open or load the file " + filenamePath + ".");
+		}
+	}
+
+	/**
+	 * Move to the next start or end element. Text, comments, CDATA and declarations are skipped.
+	 * An empty element (<chunkName/>) generates a start and an end element.
+	 */
+	XmlStreamParser::EventType XmlStreamParser::next()
+	{
+		if(eventType==START_ELEMENT && isEmptyElement)
+		{
+			eventType = END_ELEMENT;
+			isEmptyElement = false;
+			return eventType;
+		}
+		if(eventType==END_ELEMENT)
+		{
+			depth--;
+		}
+
+		char c;
+		while(readChar(c))
+		{
+			if(c!='<')
+			{
+				continue;
+			}
+
+			if(!readChar(c))
+			{
+				break;
+			}
+
+			if(c=='?')
+			{
+				readUntil("?>");
+			}else if(c=='!')
+			{
+				char c1;
+				if(!readChar(c1))
+				{
+					break;
+				}
+
+				if(c1=='-')
+				{
+					char c2;
+					if(!readChar(c2))
+					{
+						break;
+					}
+					if(c2=='-')
+					{
+						readUntil("-->");
+					}else if(c2!='>')
+					{
+						readUntil(">");
+					}
+				}else if(c1=='[')
+				{
+					readUntil("]]>");
+				}else if(c1!='>')
+				{
+					readUntil(">");
+				}
+			}else if(c=='/')
+			{
+				readEndTag();
+				eventType = END_ELEMENT;
+				return eventType;
+			}else
+			{
+				readStartTag(c);
+				depth++;
+				eventType = START_ELEMENT;
+				return eventType;
+			}
+		}
+
+		if(depth!=0)
+		{
+			throw std::invalid_argument("Unexpected end of file " + filenamePath + ": tag " + name + " not closed.");
+		}
+
+		eventType = END_DOCUMENT;
+		return eventType;
+	}
+
+	/**
+	 * Move to the next child element of an element. Descendants of the children which are not read are skipped.
+	 * @param parentDepth Depth of the parent element (0 for the root element)
+	 * @return True when positioned on the start of a child element, false when the end of the parent element is reached
+	 */
+	bool XmlStreamParser::nextChildElement(unsigned int parentDepth)
+	{
+		while(true)
+		{
+			EventType event = next();
+			if(event==END_DOCUMENT || (event==END_ELEMENT && depth==parentDepth))
+			{
+				return false;
+			}else if(event==START_ELEMENT && depth==parentDepth + 1)
+			{
+				return true;
+			}
+		}
+	}
+
+	XmlStreamParser::EventType XmlStreamParser::getEventType() const
+	{
+		return eventType;
+	}
+
+	const std::string &XmlStreamParser::getName() const
+	{
+		return name;
+	}
+
+	unsigned int XmlStreamParser::getDepth() const
+	{
+		return depth;
+	}
+
+	/**
+	 * @return Attribute value of the current start element if exist otherwise an empty string
+	 */
+	std::string XmlStreamParser::getAttributeValue(const std::string &attributeName) const
+	{
+		for(const auto &attribute : attributes)
+		{
+			if(attribute.first==attributeName)
+			{
+				return attribute.second;
+			}
+		}
+		return "";
+	}
+
+	/**
+	 * Read the current start element with all its descendants. After this call, the parser is positioned on the end of the element.
+	 * @return Chunk valid until the next call of this method. Children chunks must be queried with the chunk parser.
+	 */
+	std::shared_ptr<XmlChunk> XmlStreamParser::readChunk()
+	{
+		if(eventType!=START_ELEMENT)
+		{
+			throw std::domain_error("Impossible to read a chunk outside a start element in file " + filenamePath + ".");
+		}
+
+		if(!isEmptyElement)
+		{
+			unsigned int chunkDepth = depth;
+			isCapturing = true;
+			while(!(next()==END_ELEMENT && depth==chunkDepth))
+			{
+				if(eventType==END_DOCUMENT)
+				{
+					throw std::invalid_argument("Unexpected end of file " + filenamePath + ": tag not closed.");
+				}
+			}
+			isCapturing = false;
+		}else
+		{
+			next();
+		}
+
+		TiXmlDocument *chunkDocument = chunkParser.doc;
+		chunkDocument->Clear();
+		chunkDocument->Parse(chunkContent.c_str());
+		if(chunkDocument->Error() || !chunkDocument->RootElement())
+		{
+			throw std::invalid_argument("Impossible to parse chunk " + name + " in file " + filenamePath + ": " + chunkDocument->ErrorDesc());
+		}
+
+		return std::make_shared<XmlChunk>(chunkDocument->RootElement());
+	}
+
+	/**
+	 * @return Parser to query the children of the chunks returned by readChunk()
+	 */
+	const XmlParser &XmlStreamParser::getChunkParser() const
+	{
+		return chunkParser;
+	}
+
+	bool XmlStreamParser::readChar(char &c)
+	{
+		if(bufferPosition==bufferSize)
+		{
+			file.read(buffer.data(), BUFFER_SIZE);
+			bufferSize = static_cast<unsigned int>(file.gcount());
+			bufferPosition = 0;
+			if(bufferSize==0)
+			{
+				return false;
+			}
+		}
+
+		c = buffer[bufferPosition++];
+		if(isCapturing)
+		{
+			chunkContent.push_back(c);
+		}
+		return true;
+	}
+
+	/**
+	 * Skip characters until the end sequence is read (included)
+	 */
+	void XmlStreamParser::readUntil(const char *endSequence)
+	{
+		std::size_t endSequenceSize = std::strlen(endSequence);
+		std::size_t matchSize = 0;
+
+		char c;
+		while(matchSize < endSequenceSize)
+		{
+			if(!readChar(c))
+			{
+				throw std::invalid_argument("Unexpected end of file " + filenamePath + ": " + endSequence + " expected.");
+			}
+
+			if(c==endSequence[matchSize])
+			{
+				matchSize++;
+			}else
+			{ //fall back on the longest prefix of the end sequence which ends the characters read (e.g.: "]]]>" for "]]>")
+				std::size_t fallbackSize = matchSize;
+				while(fallbackSize > 0 && !(endSequence[fallbackSize - 1]==c
+						&& std::strncmp(endSequence, endSequence + matchSize - fallbackSize + 1, fallbackSize - 1)==0))
+				{
+					fallbackSize--;
+				}
+				matchSize = fallbackSize;
+			}
+		}
+	}
+
+	/**
+	 * Read a start tag. Attributes are only decoded when the tag is not read as part of a chunk.
+	 * @param firstNameChar First character of the tag name (character following '<')
+	 */
+	void XmlStreamParser::readStartTag(char firstNameChar)
+	{
+		bool isChunkStart = !isCapturing;
+		if(isChunkStart)
+		{ //start tag is kept in case the chunk is read
+			chunkContent.assign(1, '<');
+			chunkContent.push_back(firstNameChar);
+			isCapturing = true;
+
+			name.assign(1, firstNameChar);
+			attributes.clear();
+		}
+
+		enum {TAG_NAME, BEFORE_ATTRIBUTE, ATTRIBUTE_NAME, BEFORE_VALUE, ATTRIBUTE_VALUE} state = TAG_NAME;
+		char quote = 0;
+		char previous = firstNameChar;
+		std::string attributeName, attributeValue;
+
+		char c;
+		while(readChar(c))
+		{
+			if(state==ATTRIBUTE_VALUE)
+			{
+				if(c==quote)
+				{
+					if(isChunkStart)
+					{
+						attributes.emplace_back(attributeName, decodeEntities(attributeValue));
+					}
+					state = BEFORE_ATTRIBUTE;
+				}else if(isChunkStart)
+				{
+					attributeValue.push_back(c);
+				}
+			}else if(c=='>')
+			{
+				isEmptyElement = (previous=='/');
+				isCapturing = !isChunkStart;
+				return;
+			}else if(state==BEFORE_VALUE)
+			{
+				if(c=='"' || c=='\'')
+				{
+					quote = c;
+					attributeValue.clear();
+					state = ATTRIBUTE_VALUE;
+				}
+			}else if(c==' ' || c=='\t' || c=='\n' || c=='\r')
+			{
+				if(state==TAG_NAME || state==ATTRIBUTE_NAME)
+				{
+					state = (state==TAG_NAME) ? BEFORE_ATTRIBUTE : BEFORE_VALUE;
+				}
+			}else if(c=='=')
+			{
+				state = BEFORE_VALUE;
+			}else if(c!='/')
+			{
+				if(state==TAG_NAME && isChunkStart)
+				{
+					name.push_back(c);
+				}else if(state==BEFORE_ATTRIBUTE)
+				{
+					attributeName.assign(1, c);
+					state = ATTRIBUTE_NAME;
+				}else if(state==ATTRIBUTE_NAME)
+				{
+					attributeName.push_back(c);
+				}
+			}
+			previous = c;
+		}
+
+		throw std::invalid_argument("Unexpected end of file " + filenamePath + " in tag " + name + ".");
+	}
+
+	void XmlStreamParser::readEndTag()
+	{
+		char c;
+		while(readChar(c) && c!='>')
+		{
+			//skip end tag name: well-formed document is expected
+		}
+	}
+
+	std::string XmlStreamParser::decodeEntities(const std::string &value)
+	{
+		if(value.find('&')==std::string::npos)
+		{
+			return value;
+		}
+
+		static const std::pair<std::string, char> entities[] = {{"&amp;", '&'}, {"&lt;", '<'}, {"&gt;", '>'}, {"&quot;", '"'}, {"&apos;", '\''}};
+
+		std::string decodedValue;
+		decodedValue.reserve(value.size());
+		for(std::size_t i=0; i<value.size(); ++i)
+		{
+			bool isEntity = false;
+			if(value[i]=='&')
+			{
+				for(const auto &entity : entities)
+				{
+					if(value.compare(i, entity.first.size(), entity.first)==0)
+					{
+						decodedValue.push_back(entity.second);
+						i += entity.first.size() - 1;
+						isEntity = true;
+						break;
+					}
+				}
+			}
+
+			if(!isEntity)
+			{
+				decodedValue.push_back(value[i]);
+			}
+		}
+		return decodedValue;
+	}
+
+}
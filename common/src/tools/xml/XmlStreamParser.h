@@ -0,0 +1,72 @@
+#ifndef URCHINENGINE_XMLSTREAMPARSER_H
+#define URCHINENGINE_XMLSTREAMPARSER_H
+
+#include <string>
+#include <memory>
+#include <vector>
+#include <fstream>
+#include <utility>
+
+#include "tools/xml/XmlParser.h"
+#include "tools/xml/XmlChunk.h"
+
+namespace urchin
+{
+
+	/**
+	* XML pull parser: the file is read incrementally and only the chunk currently read is kept in memory.
+	* Depth of the root element is 1.
+	*/
+	class XmlStreamParser
+	{
+		public:
+			enum EventType
+			{
+				START_ELEMENT,
+				END_ELEMENT,
+				END_DOCUMENT
+			};
+
+			explicit XmlStreamParser(const std::string &);
+			XmlStreamParser(const std::string &, const std::string &);
+
+			EventType next();
+			bool nextChildElement(unsigned int);
+
+			EventType getEventType() const;
+			const std::string &getName() const;
+			unsigned int getDepth() const;
+			std::string getAttributeValue(const std::string &) const;
+
+			std::shared_ptr<XmlChunk> readChunk();
+			const XmlParser &getChunkParser() const;
+
+		private:
+			static constexpr unsigned int BUFFER_SIZE = 65536;
+
+			bool readChar(char &);
+			void readUntil(const char *);
+			void readStartTag(char);
+			void readEndTag();
+			static std::string decodeEntities(const std::string &);
+
+			std::string filenamePath;
+			std::ifstream file;
+			std::vector<char> buffer;
+			unsigned int bufferPosition;
+			unsigned int bufferSize;
+
+			EventType eventType;
+			std::string name;
+			unsigned int depth;
+			bool isEmptyElement;
+			std::vector<std::pair<std::string, std::string>> attributes;
+
+			bool isCapturing;
+			std::string chunkContent;
+			XmlParser chunkParser;
+	};
+
+}
+
+#endif
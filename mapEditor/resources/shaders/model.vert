@@ -4,11 +4,11 @@ layout(location=0) in vec3 vertexPosition;
 layout(location=1) in vec2 texCoord;
 layout(location=2) in vec3 normal;
 layout(location=3) in vec3 tangent;
+layout(location=4) in mat4 mModel; //per instance
+layout(location=8) in mat3 mNormal; //per instance
 
 uniform mat4 mProjection;
 uniform mat4 mView;
-uniform mat4 mModel;
-uniform mat3 mNormal;
 
 out vec3 t, b, n;
 out vec2 textCoordinates;
@@ -1,9 +1,9 @@
 #version 440
 
 layout(location=0) in vec3 vertexPosition;
+layout(location=4) in mat4 mModel; //per instance
 
 uniform mat4 mView;
-uniform mat4 mModel;
 uniform mat4 mProjection;
 
 invariant gl_Position;
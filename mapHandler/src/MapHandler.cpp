@@ -32,13 +32,32 @@ namespace urchin
 		delete map;
 	}
 
+	/**
+	 * @param filename Map file: XML file or binary file created by XmlBinaryConverter
+	 */
 	void MapHandler::loadMapFromFile(const std::string &filename, LoadCallback &loadCallback)
 	{
-		XmlParser xmlParser(filename);
+		std::string filenamePath = FileSystem::instance()->getResourcesDirectory() + filename;
+		if(XmlBinaryDocument::isBinaryFile(filenamePath))
+		{
+			XmlBinaryDocument binaryDocument(filenamePath);
+			this->relativeWorkingDirectory = XmlParser(binaryDocument).getRootChunk()->getAttributeValue(WORKING_DIR_ATTR);
+
+			map->loadFrom(binaryDocument, loadCallback);
+			return;
+		}
+
+		XmlStreamParser streamParser(filename);
+		if(!streamParser.nextChildElement(0))
+		{
+			throw std::invalid_argument("Impossible to get root element in map file: " + filename);
+		}
 
-		this->relativeWorkingDirectory = xmlParser.getRootChunk()->getAttributeValue(WORKING_DIR_ATTR);
+		this->relativeWorkingDirectory = streamParser.getAttributeValue(WORKING_DIR_ATTR);
 
-		map->loadFrom(xmlParser.getRootChunk(), xmlParser, loadCallback);
+		XmlStreamParser preloadParser(filename);
+		map->preloadMedias(preloadParser);
+		map->loadFrom(streamParser, loadCallback);
 	}
 
 	void MapHandler::writeMapOnFile(const std::string &filename) const
@@ -57,8 +76,19 @@ namespace urchin
 	 */
 	std::string MapHandler::getRelativeWorkingDirectory(const std::string &filename)
 	{
-		XmlParser xmlParser(filename, "");
-		return xmlParser.getRootChunk()->getAttributeValue(WORKING_DIR_ATTR);
+		if(XmlBinaryDocument::isBinaryFile(filename))
+		{
+			XmlBinaryDocument binaryDocument(filename);
+			return XmlParser(binaryDocument).getRootChunk()->getAttributeValue(WORKING_DIR_ATTR);
+		}
+
+		XmlStreamParser streamParser(filename, "");
+		if(!streamParser.nextChildElement(0))
+		{
+			throw std::invalid_argument("Impossible to get root element in map file: " + filename);
+		}
+
+		return streamParser.getAttributeValue(WORKING_DIR_ATTR);
 	}
 
 	/**
@@ -45,109 +45,240 @@ namespace urchin
 		delete sceneAI;
 	}
 
-	void Map::loadFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser, LoadCallback &loadCallback)
-	{
-		if(physicsWorld && !physicsWorld->isPaused())
-		{ //to avoid miss of collision between objects just loaded and on objects not loaded yet
-			throw std::runtime_error("Physics world should be paused while loading map.");
+	/**
+	 * Load the map in one pass: each entity is built as soon as its chunk is read. The resources should be preloaded
+	 * beforehand with preloadMedias(XmlStreamParser &).
+	 * @param streamParser Parser positioned on the start of the scene element
+	 */
+	void Map::loadFrom(XmlStreamParser &streamParser, LoadCallback &loadCallback)
+	{
+		checkLoadingAllowed();
+
+		std::set<std::string> loadedTags;
+		unsigned int sceneDepth = streamParser.getDepth();
+		while(streamParser.nextChildElement(sceneDepth))
+		{
+			std::string listTag = streamParser.getName();
+			addLoadedTag(listTag, loadedTags);
+
+			if(listTag==AI_ELEMENTS_TAG)
+			{
+				loadSceneAIFrom(streamParser.readChunk(), streamParser.getChunkParser());
+			}else
+			{
+				unsigned int listDepth = streamParser.getDepth();
+				while(streamParser.nextChildElement(listDepth))
+				{
+					loadSceneEntityFrom(listTag, streamParser.readChunk(), streamParser.getChunkParser());
+				}
+			}
+
+			executeLoadCallback(listTag, loadedTags, loadCallback);
 		}
 
-        if(aiManager && !aiManager->isPaused())
-        { //to avoid compute path based on a world with missing objects
-            throw std::runtime_error("AI manager should be paused while loading map.");
-        }
+		MediaManager::instance()->releasePreloadedMedias();
+		checkMandatoryTags(loadedTags);
+	}
 
-		loadSceneObjectsFrom(chunk, xmlParser);
-		loadCallback.execute(LoadCallback::OBJECTS);
+	/**
+	 * Load the map from a binary document: entities are built directly from the mapped memory.
+	 * All the resources referenced by the document are preloaded in background while the entities are built.
+	 */
+	void Map::loadFrom(const XmlBinaryDocument &binaryDocument, LoadCallback &loadCallback)
+	{
+		checkLoadingAllowed();
 
-		loadSceneLightsFrom(chunk, xmlParser);
-		loadCallback.execute(LoadCallback::LIGHTS);
+		preloadMedias(std::make_shared<XmlChunk>(&binaryDocument, binaryDocument.getRootElement()));
 
-		loadSceneTerrainFrom(chunk, xmlParser);
-		loadSceneWaterFrom(chunk, xmlParser);
-		loadCallback.execute(LoadCallback::LANDSCAPE);
+		XmlParser xmlParser(binaryDocument);
+		std::set<std::string> loadedTags;
+		for(unsigned int sectionIndex=0; sectionIndex<binaryDocument.getSectionCount(); ++sectionIndex)
+		{
+			std::string listTag = binaryDocument.getSectionName(sectionIndex);
+			addLoadedTag(listTag, loadedTags);
 
-		loadSceneSoundsFrom(chunk, xmlParser);
-		loadCallback.execute(LoadCallback::SOUNDS);
+			unsigned int listElement = binaryDocument.getSectionElement(sectionIndex);
+			if(listTag==AI_ELEMENTS_TAG)
+			{
+				loadSceneAIFrom(std::make_shared<XmlChunk>(&binaryDocument, listElement), xmlParser);
+			}else
+			{
+				unsigned int record = binaryDocument.getFirstChild(listElement);
+				for(unsigned int recordIndex=0; recordIndex<binaryDocument.getSectionRecordCount(sectionIndex); ++recordIndex)
+				{
+					loadSceneEntityFrom(listTag, std::make_shared<XmlChunk>(&binaryDocument, record), xmlParser);
+					record = binaryDocument.getNextSibling(record);
+				}
+			}
+
+			executeLoadCallback(listTag, loadedTags, loadCallback);
+		}
 
-		loadSceneAIFrom(chunk, xmlParser);
-		loadCallback.execute(LoadCallback::AI);
+		MediaManager::instance()->releasePreloadedMedias();
+		checkMandatoryTags(loadedTags);
 	}
 
-	void Map::loadSceneObjectsFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser)
+	/**
+	 * Pre-scan the map file to preload in background the resources referenced by all the entities: the resources are loaded
+	 * while the entities are built by the parser of the map.
+	 * @param preloadParser Parser of the map file positioned before the root element. It must be distinct from the parser used to load the map.
+	 */
+	void Map::preloadMedias(XmlStreamParser &preloadParser) const
 	{
-		std::shared_ptr<XmlChunk> objectsListChunk = xmlParser.getUniqueChunk(true, OBJECTS_TAG, XmlAttribute(), chunk);
-		std::vector<std::shared_ptr<XmlChunk>> objectsChunk = xmlParser.getChunks(OBJECT_TAG, XmlAttribute(), objectsListChunk);
+		if(!preloadParser.nextChildElement(0))
+		{
+			return;
+		}
 
-		for (const auto &objectChunk : objectsChunk)
+		unsigned int sceneDepth = preloadParser.getDepth();
+		while(preloadParser.nextChildElement(sceneDepth))
 		{
-			auto *sceneObject = new SceneObject();
-			sceneObject->loadFrom(objectChunk, xmlParser);
+			unsigned int listDepth = preloadParser.getDepth();
+			while(preloadParser.nextChildElement(listDepth))
+			{
+				preloadMedias(preloadParser.readChunk());
+			}
+		}
+	}
 
-			addSceneObject(sceneObject);
+	/**
+	 * Preload the resources referenced by the chunk and its descendants. Any value is a candidate: values which are not
+	 * a filename of a resource loadable in background are ignored by the media manager.
+	 */
+	void Map::preloadMedias(const std::shared_ptr<XmlChunk> &chunk) const
+	{
+		std::vector<std::string> textValues;
+		chunk->getTextValues(textValues);
+		for(const auto &textValue : textValues)
+		{
+			MediaManager::instance()->preloadMedia(textValue);
 		}
 	}
 
-	void Map::loadSceneLightsFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser)
+	void Map::checkLoadingAllowed() const
 	{
-		std::shared_ptr<XmlChunk> lightsListChunk = xmlParser.getUniqueChunk(true, LIGHTS_TAG, XmlAttribute(), chunk);
-		std::vector<std::shared_ptr<XmlChunk>> lightsChunk = xmlParser.getChunks(LIGHT_TAG, XmlAttribute(), lightsListChunk);
+		if(physicsWorld && !physicsWorld->isPaused())
+		{ //to avoid miss of collision between objects just loaded and on objects not loaded yet
+			throw std::runtime_error("Physics world should be paused while loading map.");
+		}
 
-		for (const auto &lightChunk : lightsChunk)
-		{
-			auto *sceneLight = new SceneLight();
-			sceneLight->loadFrom(lightChunk, xmlParser);
+        if(aiManager && !aiManager->isPaused())
+        { //to avoid compute path based on a world with missing objects
+            throw std::runtime_error("AI manager should be paused while loading map.");
+        }
+	}
 
-			addSceneLight(sceneLight);
+	void Map::addLoadedTag(const std::string &listTag, std::set<std::string> &loadedTags) const
+	{
+		if(!loadedTags.insert(listTag).second)
+		{
+			throw std::invalid_argument("More than one tag found for " + listTag + ".");
 		}
 	}
 
-	void Map::loadSceneTerrainFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser)
+	void Map::checkMandatoryTags(const std::set<std::string> &loadedTags) const
 	{
-		std::shared_ptr<XmlChunk> terrainsListChunk = xmlParser.getUniqueChunk(true, TERRAINS_TAG, XmlAttribute(), chunk);
-		std::vector<std::shared_ptr<XmlChunk>> terrainsChunk = xmlParser.getChunks(TERRAIN_TAG, XmlAttribute(), terrainsListChunk);
+		for(const std::string &mandatoryTag : {OBJECTS_TAG, LIGHTS_TAG, TERRAINS_TAG, WATERS_TAG, SOUND_ELEMENTS_TAG, AI_ELEMENTS_TAG})
+		{
+			if(loadedTags.find(mandatoryTag)==loadedTags.end())
+			{
+				throw std::invalid_argument("The tag " + mandatoryTag + " wasn't found in map file.");
+			}
+		}
+	}
 
-		for (const auto &terrainChunk : terrainsChunk)
+	/**
+	 * @param listTag Tag of the list containing the entity
+	 */
+	void Map::loadSceneEntityFrom(const std::string &listTag, const std::shared_ptr<XmlChunk> &entityChunk, const XmlParser &xmlParser)
+	{
+		const std::string entityTag = entityChunk->getName();
+		if(listTag==OBJECTS_TAG && entityTag==OBJECT_TAG)
+		{
+			loadSceneObjectFrom(entityChunk, xmlParser);
+		}else if(listTag==LIGHTS_TAG && entityTag==LIGHT_TAG)
+		{
+			loadSceneLightFrom(entityChunk, xmlParser);
+		}else if(listTag==TERRAINS_TAG && entityTag==TERRAIN_TAG)
+		{
+			loadSceneTerrainFrom(entityChunk, xmlParser);
+		}else if(listTag==WATERS_TAG && entityTag==WATER_TAG)
+		{
+			loadSceneWaterFrom(entityChunk, xmlParser);
+		}else if(listTag==SOUND_ELEMENTS_TAG && entityTag==SOUND_ELEMENT_TAG)
 		{
-			auto *sceneTerrain = new SceneTerrain();
-			sceneTerrain->loadFrom(terrainChunk, xmlParser);
+			loadSceneSoundFrom(entityChunk, xmlParser);
+		}
+	}
 
-			addSceneTerrain(sceneTerrain);
+	/**
+	 * @param loadedTags Tags of the lists already loaded (current list included)
+	 */
+	void Map::executeLoadCallback(const std::string &listTag, const std::set<std::string> &loadedTags, LoadCallback &loadCallback) const
+	{
+		if(listTag==OBJECTS_TAG)
+		{
+			loadCallback.execute(LoadCallback::OBJECTS);
+		}else if(listTag==LIGHTS_TAG)
+		{
+			loadCallback.execute(LoadCallback::LIGHTS);
+		}else if(listTag==TERRAINS_TAG || listTag==WATERS_TAG)
+		{ //landscape is loaded once both terrains and waters are loaded, whatever their order in the file
+			if(loadedTags.find(TERRAINS_TAG)!=loadedTags.end() && loadedTags.find(WATERS_TAG)!=loadedTags.end())
+			{
+				loadCallback.execute(LoadCallback::LANDSCAPE);
+			}
+		}else if(listTag==SOUND_ELEMENTS_TAG)
+		{
+			loadCallback.execute(LoadCallback::SOUNDS);
+		}else if(listTag==AI_ELEMENTS_TAG)
+		{
+			loadCallback.execute(LoadCallback::AI);
 		}
 	}
 
-	void Map::loadSceneWaterFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser)
+	void Map::loadSceneObjectFrom(const std::shared_ptr<XmlChunk> &objectChunk, const XmlParser &xmlParser)
 	{
-		std::shared_ptr<XmlChunk> watersListChunk = xmlParser.getUniqueChunk(true, WATERS_TAG, XmlAttribute(), chunk);
-		std::vector<std::shared_ptr<XmlChunk>> watersChunk = xmlParser.getChunks(WATER_TAG, XmlAttribute(), watersListChunk);
+		auto *sceneObject = new SceneObject();
+		sceneObject->loadFrom(objectChunk, xmlParser);
 
-		for (const auto &waterChunk : watersChunk)
-		{
-			auto *sceneWater = new SceneWater();
-			sceneWater->loadFrom(waterChunk, xmlParser);
+		addSceneObject(sceneObject);
+	}
 
-			addSceneWater(sceneWater);
-		}
+	void Map::loadSceneLightFrom(const std::shared_ptr<XmlChunk> &lightChunk, const XmlParser &xmlParser)
+	{
+		auto *sceneLight = new SceneLight();
+		sceneLight->loadFrom(lightChunk, xmlParser);
+
+		addSceneLight(sceneLight);
 	}
 
-	void Map::loadSceneSoundsFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser)
+	void Map::loadSceneTerrainFrom(const std::shared_ptr<XmlChunk> &terrainChunk, const XmlParser &xmlParser)
 	{
-		std::shared_ptr<XmlChunk> soundElementsListChunk = xmlParser.getUniqueChunk(true, SOUND_ELEMENTS_TAG, XmlAttribute(), chunk);
-		std::vector<std::shared_ptr<XmlChunk>> soundElementsChunk = xmlParser.getChunks(SOUND_ELEMENT_TAG, XmlAttribute(), soundElementsListChunk);
+		auto *sceneTerrain = new SceneTerrain();
+		sceneTerrain->loadFrom(terrainChunk, xmlParser);
 
-		for (const auto &soundElementChunk : soundElementsChunk)
-		{
-			auto *sceneSound = new SceneSound();
-			sceneSound->loadFrom(soundElementChunk, xmlParser);
+		addSceneTerrain(sceneTerrain);
+	}
 
-			addSceneSound(sceneSound);
-		}
+	void Map::loadSceneWaterFrom(const std::shared_ptr<XmlChunk> &waterChunk, const XmlParser &xmlParser)
+	{
+		auto *sceneWater = new SceneWater();
+		sceneWater->loadFrom(waterChunk, xmlParser);
+
+		addSceneWater(sceneWater);
 	}
 
-	void Map::loadSceneAIFrom(const std::shared_ptr<XmlChunk> &chunk, const XmlParser &xmlParser)
+	void Map::loadSceneSoundFrom(const std::shared_ptr<XmlChunk> &soundElementChunk, const XmlParser &xmlParser)
 	{
-		std::shared_ptr<XmlChunk> aiElementsListChunk = xmlParser.getUniqueChunk(true, AI_ELEMENTS_TAG, XmlAttribute(), chunk);
+		auto *sceneSound = new SceneSound();
+		sceneSound->loadFrom(soundElementChunk, xmlParser);
+
+		addSceneSound(sceneSound);
+	}
 
+	void Map::loadSceneAIFrom(const std::shared_ptr<XmlChunk> &aiElementsListChunk, const XmlParser &xmlParser)
+	{
 		auto *sceneAI = new SceneAI();
 		sceneAI->loadFrom(aiElementsListChunk, xmlParser);
 
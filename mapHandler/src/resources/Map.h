@@ -3,6 +3,7 @@
 
 #include <string>
 #include <list>
+#include <set>
 #include <utility>
 
 #include "UrchinCommon.h"
@@ -76,12 +77,20 @@ namespace urchin
 			void refreshMap();
 
 		private:
-			void loadFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &, LoadCallback &);
-			void loadSceneObjectsFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
-			void loadSceneLightsFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
+			void loadFrom(XmlStreamParser &, LoadCallback &);
+			void loadFrom(const XmlBinaryDocument &, LoadCallback &);
+			void preloadMedias(XmlStreamParser &) const;
+			void preloadMedias(const std::shared_ptr<XmlChunk> &) const;
+			void checkLoadingAllowed() const;
+			void addLoadedTag(const std::string &, std::set<std::string> &) const;
+			void checkMandatoryTags(const std::set<std::string> &) const;
+			void loadSceneEntityFrom(const std::string &, const std::shared_ptr<XmlChunk> &, const XmlParser &);
+			void executeLoadCallback(const std::string &, const std::set<std::string> &, LoadCallback &) const;
+			void loadSceneObjectFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
+			void loadSceneLightFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
 			void loadSceneTerrainFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
 			void loadSceneWaterFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
-			void loadSceneSoundsFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
+			void loadSceneSoundFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
 			void loadSceneAIFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &);
 
 			void writeOn(const std::shared_ptr<XmlChunk> &, XmlWriter &) const;
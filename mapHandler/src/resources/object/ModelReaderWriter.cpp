@@ -111,6 +111,9 @@ namespace urchin
 		{
 			model->setProduceShadow(true);
 		}
+
+		std::shared_ptr<XmlChunk> occluderChunk = xmlParser.getUniqueChunk(false, OCCLUDER_TAG, XmlAttribute(), modelChunk);
+		model->setOccluder(occluderChunk && occluderChunk->getBoolValue());
 	}
 
 	void ModelReaderWriter::writeFlagsOn(const std::shared_ptr<XmlChunk> &modelChunk, const Model *model, XmlWriter &xmlWriter) const
@@ -120,6 +123,12 @@ namespace urchin
 			std::shared_ptr<XmlChunk> produceShadowChunk = xmlWriter.createChunk(PRODUCE_SHADOW_TAG, XmlAttribute(), modelChunk);
 			produceShadowChunk->setBoolValue(model->isProduceShadow());
 		}
+
+		if(model->isOccluder())
+		{
+			std::shared_ptr<XmlChunk> occluderChunk = xmlWriter.createChunk(OCCLUDER_TAG, XmlAttribute(), modelChunk);
+			occluderChunk->setBoolValue(model->isOccluder());
+		}
 	}
 
 }
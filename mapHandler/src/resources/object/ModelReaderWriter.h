@@ -22,6 +22,7 @@ namespace urchin
 		#define POSITION_TAG "position"
 		#define SCALE_TAG "scale"
 		#define PRODUCE_SHADOW_TAG "produceShadow"
+		#define OCCLUDER_TAG "occluder"
 
 		public:
 			Model *loadFrom(const std::shared_ptr<XmlChunk> &, const XmlParser &) const;
@@ -6,10 +6,10 @@ namespace urchin
 {
 
 	ConstraintSolverManager::ConstraintSolverManager() :
-			constraintSolverIteration(ConfigService::instance()->getUnsignedIntValue("constraintSolver.constraintSolverIteration")),
-			biasFactor(ConfigService::instance()->getFloatValue("constraintSolver.biasFactor")),
-			useWarmStarting(ConfigService::instance()->getBoolValue("constraintSolver.useWarmStarting")),
-			restitutionVelocityThreshold(ConfigService::instance()->getFloatValue("constraintSolver.restitutionVelocityThreshold"))
+			constraintSolverIteration("constraintSolver.constraintSolverIteration"),
+			biasFactor("constraintSolver.biasFactor"),
+			useWarmStarting("constraintSolver.useWarmStarting"),
+			restitutionVelocityThreshold("constraintSolver.restitutionVelocityThreshold")
 	{
 		unsigned int constraintSolvingPoolSize = ConfigService::instance()->getUnsignedIntValue("constraintSolver.constraintSolvingPoolSize");
 		constraintSolvingPool = new FixedSizePool<ConstraintSolving>("constraintSolvingPool", sizeof(ConstraintSolving), constraintSolvingPoolSize);
@@ -38,7 +38,8 @@ namespace urchin
 		setupConstraints(manifoldResults, dt);
 
 		//iterative constraint solver
-		for(unsigned int i=0; i<constraintSolverIteration; ++i)
+		unsigned int nbIteration = constraintSolverIteration.getValue();
+		for(unsigned int i=0; i<nbIteration; ++i)
 		{
 			solveConstraints();
 		}
@@ -54,7 +55,10 @@ namespace urchin
 		}
 		constraintsSolving.clear();
 
-		//setup constraints solving
+		//setup constraints solving: config values are read once for all contacts
+		bool warmStarting = useWarmStarting.getValue();
+		float depthBiasFactor = biasFactor.getValue();
+		float restitutionThreshold = restitutionVelocityThreshold.getValue();
 		for (auto &manifoldResult : manifoldResults)
 		{
 			for(unsigned int j=0; j< manifoldResult.getNumContactPoints(); ++j)
@@ -73,10 +77,10 @@ namespace urchin
 				const CommonSolvingData &commonSolvingData = fillCommonSolvingData(manifoldResult, contact);
 				constraintSolving->setCommonData(commonSolvingData);
 
-				const ImpulseSolvingData &impulseSolvingData = fillImpulseSolvingData(commonSolvingData, dt);
+				const ImpulseSolvingData &impulseSolvingData = fillImpulseSolvingData(commonSolvingData, dt, depthBiasFactor, restitutionThreshold);
 				constraintSolving->setImpulseData(impulseSolvingData);
 
-				if(useWarmStarting)
+				if(warmStarting)
 				{
 					const Vector3<float> normalImpulseVector = contact.getAccumulatedSolvingData().accNormalImpulse * commonSolvingData.contactNormal;
 					applyImpulse(constraintSolving->getBody1(), constraintSolving->getBody2(), commonSolvingData, normalImpulseVector);
@@ -127,7 +131,12 @@ namespace urchin
 		return commonSolvingData;
 	}
 
-	ImpulseSolvingData ConstraintSolverManager::fillImpulseSolvingData(const CommonSolvingData &commonData, float dt) const
+	/**
+	 * @param depthBiasFactor Percentage of the penetration depth corrected by the bias
+	 * @param restitutionThreshold Relative velocity below which the collision is treated as inelastic
+	 */
+	ImpulseSolvingData ConstraintSolverManager::fillImpulseSolvingData(const CommonSolvingData &commonData, float dt, float depthBiasFactor,
+			float restitutionThreshold) const
 	{
 		ImpulseSolvingData impulseSolvingData;
 
@@ -155,9 +164,9 @@ namespace urchin
 		float restitution = std::max(commonData.body1->getRestitution(), commonData.body2->getRestitution());
 
 		float normalRelativeVelocity = computeRelativeVelocity(commonData).dotProduct(commonData.contactNormal);
-		float depthBias = biasFactor * invDeltaTime * commonData.depth;
+		float depthBias = depthBiasFactor * invDeltaTime * commonData.depth;
 		float restitutionBias = 0.0f;
-		if(normalRelativeVelocity > restitutionVelocityThreshold)
+		if(normalRelativeVelocity > restitutionThreshold)
 		{
 			restitutionBias =  -restitution * normalRelativeVelocity;
 		}
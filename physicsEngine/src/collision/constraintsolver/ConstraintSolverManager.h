@@ -29,7 +29,7 @@ namespace urchin
 			void solveConstraints();
 
 			CommonSolvingData fillCommonSolvingData(const ManifoldResult &, const ManifoldContactPoint &);
-			ImpulseSolvingData fillImpulseSolvingData(const CommonSolvingData &, float) const;
+			ImpulseSolvingData fillImpulseSolvingData(const CommonSolvingData &, float, float, float) const;
 
 			void solveNormalConstraint(ConstraintSolving *);
 			void solveTangentConstraint(ConstraintSolving *);
@@ -41,10 +41,10 @@ namespace urchin
 			std::vector<ConstraintSolving *> constraintsSolving;
 			FixedSizePool<ConstraintSolving> *constraintSolvingPool;
 
-			const unsigned int constraintSolverIteration;
-			const float biasFactor;
-			const bool useWarmStarting;
-			const float restitutionVelocityThreshold;
+			const ConfigKey<unsigned int> constraintSolverIteration;
+			const ConfigKey<float> biasFactor;
+			const ConfigKey<bool> useWarmStarting;
+			const ConfigKey<float> restitutionVelocityThreshold;
 	};
 
 }
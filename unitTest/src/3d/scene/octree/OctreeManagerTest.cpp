@@ -0,0 +1,139 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "3d/scene/octree/OctreeManagerTest.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+TestOctreeable::TestOctreeable(const Point3<float> &center, float size)
+{
+	moveTo(center, size);
+}
+
+void TestOctreeable::moveTo(const Point3<float> &center, float size)
+{
+	Vector3<float> halfSizes(size / 2.0f, size / 2.0f, size / 2.0f);
+	aabbox = AABBox<float>(center.translate(-halfSizes), center.translate(halfSizes));
+	notifyOctreeableMove();
+}
+
+const AABBox<float> &TestOctreeable::getAABBox() const
+{
+	return aabbox;
+}
+
+const Transform<float> &TestOctreeable::getTransform() const
+{
+	return transform;
+}
+
+void OctreeManagerTest::moveToSiblingNode()
+{ //octree of size 1.0 with one level of children: the octreeable moves in an empty sibling node
+	TestOctreeable octreeable(Point3<float>(0.25f, 0.25f, 0.25f), 0.1f);
+	OctreeManager<TestOctreeable> octreeManager(0.3f);
+	octreeManager.addOctreeable(&octreeable);
+	refresh(octreeManager);
+
+	octreeable.moveTo(Point3<float>(0.75f, 0.25f, 0.25f), 0.1f);
+	refresh(octreeManager);
+
+	AssertHelper::assertTrue(octreeable.getOctree()->getParent() == &octreeManager.getMainOctree());
+	AssertHelper::assertPoint3FloatEquals(octreeable.getOctree()->getAABBox().getMin(), Point3<float>(0.5f, 0.0f, 0.0f));
+	AssertHelper::assertUnsignedInt(octreeManager.getMainOctree().getChildren().size(), 8);
+	AssertHelper::assertUnsignedInt(octreeManager.getAllOctreeables().size(), 1);
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(0.75f, 0.25f, 0.25f)).size(), 1);
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(0.25f, 0.25f, 0.25f)).size(), 0);
+}
+
+void OctreeManagerTest::moveToParentNode()
+{ //octree of size 1.0 with two levels of children: the octreeable grows and doesn't fit anymore in its node
+	TestOctreeable octreeable(Point3<float>(0.125f, 0.125f, 0.125f), 0.05f);
+	OctreeManager<TestOctreeable> octreeManager(0.2f);
+	octreeManager.addOctreeable(&octreeable);
+	refresh(octreeManager);
+	AssertHelper::assertPoint3FloatEquals(octreeable.getOctree()->getAABBox().getMax(), Point3<float>(0.25f, 0.25f, 0.25f));
+
+	octreeable.moveTo(Point3<float>(0.25f, 0.25f, 0.25f), 0.4f);
+	refresh(octreeManager);
+
+	AssertHelper::assertTrue(octreeable.getOctree()->getParent() == &octreeManager.getMainOctree());
+	AssertHelper::assertPoint3FloatEquals(octreeable.getOctree()->getAABBox().getMax(), Point3<float>(0.5f, 0.5f, 0.5f));
+	AssertHelper::assertTrue(octreeable.getOctree()->isLeaf());
+	AssertHelper::assertUnsignedInt(octreeManager.getMainOctree().getChildren().size(), 8);
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(0.25f, 0.25f, 0.25f)).size(), 1);
+}
+
+void OctreeManagerTest::moveToChildNode()
+{
+	TestOctreeable octreeable(Point3<float>(0.25f, 0.25f, 0.25f), 0.4f);
+	OctreeManager<TestOctreeable> octreeManager(0.2f);
+	octreeManager.addOctreeable(&octreeable);
+	refresh(octreeManager);
+	AssertHelper::assertPoint3FloatEquals(octreeable.getOctree()->getAABBox().getMax(), Point3<float>(0.5f, 0.5f, 0.5f));
+
+	octreeable.moveTo(Point3<float>(0.125f, 0.125f, 0.125f), 0.05f);
+	refresh(octreeManager);
+
+	AssertHelper::assertPoint3FloatEquals(octreeable.getOctree()->getAABBox().getMax(), Point3<float>(0.25f, 0.25f, 0.25f));
+	AssertHelper::assertTrue(octreeable.getOctree()->getParent()->getParent() == &octreeManager.getMainOctree());
+	AssertHelper::assertTrue(octreeable.getOctree()->getParent()->getOctreeables().empty());
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(0.125f, 0.125f, 0.125f)).size(), 1);
+}
+
+void OctreeManagerTest::moveOutOfAndIntoOverflowNode()
+{ //a static octreeable stays in the octree: the octree is not rebuilt when the other octreeable leaves it
+	TestOctreeable staticOctreeable(Point3<float>(0.75f, 0.75f, 0.75f), 0.1f);
+	TestOctreeable octreeable(Point3<float>(0.25f, 0.25f, 0.25f), 0.1f);
+	OctreeManager<TestOctreeable> octreeManager(0.3f);
+	octreeManager.addOctreeable(&staticOctreeable);
+	octreeManager.addOctreeable(&octreeable);
+	refresh(octreeManager);
+
+	octreeable.moveTo(Point3<float>(10.0f, 10.0f, 10.0f), 0.1f);
+	refresh(octreeManager);
+
+	AssertHelper::assertTrue(octreeable.getOctree() != nullptr);
+	AssertHelper::assertTrue(octreeable.getOctree()->getParent() == nullptr);
+	AssertHelper::assertTrue(octreeable.getOctree() != &octreeManager.getMainOctree());
+	AssertHelper::assertTrue(staticOctreeable.getOctree()->getParent() == &octreeManager.getMainOctree());
+	AssertHelper::assertUnsignedInt(octreeManager.getAllOctreeables().size(), 2);
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(10.0f, 10.0f, 10.0f)).size(), 1);
+
+	octreeable.moveTo(Point3<float>(0.25f, 0.25f, 0.25f), 0.1f);
+	refresh(octreeManager);
+
+	AssertHelper::assertTrue(octreeable.getOctree()->getParent() == &octreeManager.getMainOctree());
+	AssertHelper::assertPoint3FloatEquals(octreeable.getOctree()->getAABBox().getMin(), Point3<float>(0.0f, 0.0f, 0.0f));
+	AssertHelper::assertUnsignedInt(octreeManager.getAllOctreeables().size(), 2);
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(10.0f, 10.0f, 10.0f)).size(), 0);
+	AssertHelper::assertUnsignedInt(findOctreeablesAround(octreeManager, Point3<float>(0.25f, 0.25f, 0.25f)).size(), 1);
+}
+
+void OctreeManagerTest::refresh(OctreeManager<TestOctreeable> &octreeManager) const
+{
+	octreeManager.refreshOctreeables();
+	octreeManager.postRefreshOctreeables();
+}
+
+std::vector<TestOctreeable *> OctreeManagerTest::findOctreeablesAround(const OctreeManager<TestOctreeable> &octreeManager, const Point3<float> &point) const
+{
+	Vector3<float> halfSizes(0.01f, 0.01f, 0.01f);
+	AABBox<float> aroundBox(point.translate(-halfSizes), point.translate(halfSizes));
+
+	std::vector<TestOctreeable *> octreeables;
+	octreeManager.getOctreeablesIn(aroundBox, octreeables);
+	return octreeables;
+}
+
+CppUnit::Test *OctreeManagerTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("OctreeManagerTest");
+
+	suite->addTest(new CppUnit::TestCaller<OctreeManagerTest>("moveToSiblingNode", &OctreeManagerTest::moveToSiblingNode));
+	suite->addTest(new CppUnit::TestCaller<OctreeManagerTest>("moveToParentNode", &OctreeManagerTest::moveToParentNode));
+	suite->addTest(new CppUnit::TestCaller<OctreeManagerTest>("moveToChildNode", &OctreeManagerTest::moveToChildNode));
+	suite->addTest(new CppUnit::TestCaller<OctreeManagerTest>("moveOutOfAndIntoOverflowNode", &OctreeManagerTest::moveOutOfAndIntoOverflowNode));
+
+	return suite;
+}
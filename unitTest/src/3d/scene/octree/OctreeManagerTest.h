@@ -0,0 +1,41 @@
+#ifndef URCHINENGINE_OCTREEMANAGERTEST_H
+#define URCHINENGINE_OCTREEMANAGERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+#include "scene/renderer3d/octree/OctreeManager.h"
+#include "scene/renderer3d/octree/Octreeable.h"
+using namespace urchin;
+
+class TestOctreeable : public Octreeable<TestOctreeable>
+{
+	public:
+		TestOctreeable(const Point3<float> &, float);
+
+		void moveTo(const Point3<float> &, float);
+
+		const AABBox<float> &getAABBox() const override;
+		const Transform<float> &getTransform() const override;
+
+	private:
+		AABBox<float> aabbox;
+		Transform<float> transform;
+};
+
+class OctreeManagerTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void moveToSiblingNode();
+		void moveToParentNode();
+		void moveToChildNode();
+		void moveOutOfAndIntoOverflowNode();
+
+	private:
+		void refresh(OctreeManager<TestOctreeable> &) const;
+		std::vector<TestOctreeable *> findOctreeablesAround(const OctreeManager<TestOctreeable> &, const Point3<float> &) const;
+};
+
+#endif
@@ -2,10 +2,31 @@
 #include <cppunit/ui/text/TestRunner.h>
 
 #include "system/FileHandlerTest.h"
+#include "tools/ConfigKeyTest.h"
+#include "tools/XmlStreamParserTest.h"
+#include "tools/XmlBinaryConverterTest.h"
+#include "tools/JobPoolTest.h"
+#include "tools/TaskPoolTest.h"
+#include "tools/BlockCompressorTest.h"
+#include "tools/TextureBakerTest.h"
+#include "tools/DrawListBuilderTest.h"
+#include "tools/LightClusterBuilderTest.h"
+#include "tools/StreamingPatchGridTest.h"
+#include "tools/GlyphRunCacheTest.h"
+#include "tools/TextBatchTest.h"
+#include "tools/MeshSkinningTest.h"
+#include "tools/ResourceCacheTest.h"
+#include "3d/scene/octree/OctreeManagerTest.h"
 #include "math/algebra/QuaternionTest.h"
+#include "math/algebra/QuantizedQuaternionTest.h"
+#include "math/algebra/TransformTest.h"
 #include "math/geometry/OrthogonalProjectionTest.h"
 #include "math/geometry/ClosestPointTest.h"
 #include "math/geometry/AABBoxCollisionTest.h"
+#include "math/geometry/AABBoxArrayTest.h"
+#include "math/geometry/OcclusionBufferTest.h"
+#include "math/geometry/MeshSimplifierTest.h"
+#include "math/geometry/HeightfieldChunkTreeTest.h"
 #include "math/geometry/LineSegment2DCollisionTest.h"
 #include "math/geometry/ResizeConvexHull3DTest.h"
 #include "math/geometry/ResizePolygon2DServiceTest.h"
@@ -43,13 +64,46 @@ int main()
 	//system - file
 	runner.addTest(FileHandlerTest::suite());
 
+	//tools - config
+	runner.addTest(ConfigKeyTest::suite());
+
+	//tools - xml
+	runner.addTest(XmlStreamParserTest::suite());
+	runner.addTest(XmlBinaryConverterTest::suite());
+
+	//tools - thread
+	runner.addTest(JobPoolTest::suite());
+	runner.addTest(TaskPoolTest::suite());
+
+	//tools - image
+	runner.addTest(BlockCompressorTest::suite());
+	runner.addTest(TextureBakerTest::suite());
+	runner.addTest(DrawListBuilderTest::suite());
+	runner.addTest(LightClusterBuilderTest::suite());
+	runner.addTest(StreamingPatchGridTest::suite());
+	runner.addTest(GlyphRunCacheTest::suite());
+	runner.addTest(TextBatchTest::suite());
+	runner.addTest(MeshSkinningTest::suite());
+
+	//tools - resource
+	runner.addTest(ResourceCacheTest::suite());
+
+	//3d - octree
+	runner.addTest(OctreeManagerTest::suite());
+
 	//math - algebra
 	runner.addTest(QuaternionTest::suite());
+	runner.addTest(QuantizedQuaternionTest::suite());
+	runner.addTest(TransformTest::suite());
 
 	//math - geometry
 	runner.addTest(OrthogonalProjectionTest::suite());
 	runner.addTest(ClosestPointTest::suite());
 	runner.addTest(AABBoxCollissionTest::suite());
+	runner.addTest(AABBoxArrayTest::suite());
+	runner.addTest(OcclusionBufferTest::suite());
+	runner.addTest(MeshSimplifierTest::suite());
+	runner.addTest(HeightfieldChunkTreeTest::suite());
 	runner.addTest(LineSegment2DCollisionTest::suite());
 	runner.addTest(ResizeConvexHull3DTest::suite());
 	runner.addTest(ResizePolygon2DServiceTest::suite());
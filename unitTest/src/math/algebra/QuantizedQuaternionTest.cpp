@@ -0,0 +1,57 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "QuantizedQuaternionTest.h"
+#include "math/algebra/MathValue.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+void QuantizedQuaternionTest::identity()
+{
+	Quaternion<float> quaternion = QuantizedQuaternion<float>().toQuaternion();
+
+	AssertHelper::assertQuaternionFloatEquals(quaternion, Quaternion<float>(), 0.0001);
+}
+
+void QuantizedQuaternionTest::largestComponentX()
+{
+	Quaternion<float> rotation(Vector3<float>(1.0, 0.0, 0.0), PI_VALUE * 0.9);
+
+	Quaternion<float> quaternion = QuantizedQuaternion<float>(rotation).toQuaternion();
+
+	AssertHelper::assertQuaternionFloatEquals(quaternion, rotation, 0.0001);
+}
+
+void QuantizedQuaternionTest::negativeLargestComponent()
+{
+	Quaternion<float> rotation(-0.1, 0.2, -0.9, 0.3);
+	rotation = rotation.normalize();
+
+	Quaternion<float> quaternion = QuantizedQuaternion<float>(rotation).toQuaternion();
+
+	AssertHelper::assertQuaternionFloatEquals(quaternion, Quaternion<float>(-rotation.X, -rotation.Y, -rotation.Z, -rotation.W), 0.0001);
+}
+
+void QuantizedQuaternionTest::arbitraryRotations()
+{
+	for(unsigned int i=0; i<100; ++i)
+	{
+		Vector3<float> axis = Vector3<float>(std::sin((float)i), std::cos((float)i * 1.7f), 0.5f - (float)(i % 7) / 7.0f).normalize();
+		Quaternion<float> rotation(axis, (float)i * 0.13f);
+
+		Quaternion<float> quaternion = QuantizedQuaternion<float>(rotation).toQuaternion();
+
+		AssertHelper::assertFloatEquals(std::abs(quaternion.dotProduct(rotation)), 1.0, 0.00001);
+	}
+}
+
+CppUnit::Test *QuantizedQuaternionTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("QuantizedQuaternionTest");
+
+	suite->addTest(new CppUnit::TestCaller<QuantizedQuaternionTest>("identity", &QuantizedQuaternionTest::identity));
+	suite->addTest(new CppUnit::TestCaller<QuantizedQuaternionTest>("largestComponentX", &QuantizedQuaternionTest::largestComponentX));
+	suite->addTest(new CppUnit::TestCaller<QuantizedQuaternionTest>("negativeLargestComponent", &QuantizedQuaternionTest::negativeLargestComponent));
+	suite->addTest(new CppUnit::TestCaller<QuantizedQuaternionTest>("arbitraryRotations", &QuantizedQuaternionTest::arbitraryRotations));
+
+	return suite;
+}
@@ -0,0 +1,19 @@
+#ifndef URCHINENGINE_QUANTIZEDQUATERNIONTEST_H
+#define URCHINENGINE_QUANTIZEDQUATERNIONTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class QuantizedQuaternionTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void identity();
+		void largestComponentX();
+		void negativeLargestComponent();
+		void arbitraryRotations();
+};
+
+#endif
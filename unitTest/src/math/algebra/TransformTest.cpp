@@ -0,0 +1,79 @@
+#include <cppunit/extensions/HelperMacros.h>
+
+#include "TransformTest.h"
+#include "math/algebra/MathValue.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+void TransformTest::transformMatrix()
+{
+	Transform<float> transform(Point3<float>(1.0, 2.0, 3.0), Quaternion<float>(Vector3<float>(0.0, 1.0, 0.0), PI_VALUE/2.0), 2.0);
+
+	Point3<float> transformedPoint = (transform.getTransformMatrix() * Point4<float>(1.0, 0.0, 0.0, 1.0)).toPoint3();
+
+	AssertHelper::assertPoint3FloatEquals(transformedPoint, Point3<float>(1.0, 2.0, 1.0));
+}
+
+void TransformTest::transformMatrixAfterPositionUpdate()
+{
+	Transform<float> transform(Point3<float>(1.0, 2.0, 3.0), Quaternion<float>(Vector3<float>(0.0, 1.0, 0.0), PI_VALUE/2.0), 2.0);
+	transform.getTransformMatrix();
+
+	transform.setPosition(Point3<float>(-1.0, 0.0, 0.0));
+	Point3<float> transformedPoint = (transform.getTransformMatrix() * Point4<float>(1.0, 0.0, 0.0, 1.0)).toPoint3();
+
+	AssertHelper::assertPoint3FloatEquals(transformedPoint, Point3<float>(-1.0, 0.0, -2.0));
+}
+
+void TransformTest::transformMatrixAfterOrientationAndScaleUpdate()
+{
+	Transform<float> transform(Point3<float>(1.0, 2.0, 3.0));
+	transform.getTransformMatrix();
+
+	transform.setOrientation(Quaternion<float>(Vector3<float>(0.0, 0.0, 1.0), PI_VALUE/2.0));
+	transform.setScale(3.0);
+	Matrix4<float> expectedMatrix = transform.getPositionMatrix() * transform.getScaleMatrix() * transform.getOrientationMatrix();
+
+	for(unsigned int i=0; i<16; ++i)
+	{
+		AssertHelper::assertFloatEquals(transform.getTransformMatrix()(i), expectedMatrix(i));
+	}
+}
+
+void TransformTest::composeTransforms()
+{
+	Transform<float> transform1(Point3<float>(1.0, 2.0, 3.0), Quaternion<float>(Vector3<float>(0.0, 1.0, 0.0), PI_VALUE/2.0), 2.0);
+	Transform<float> transform2(Point3<float>(-1.0, 0.5, 2.0), Quaternion<float>(Vector3<float>(1.0, 0.0, 0.0), PI_VALUE/4.0), 0.5);
+
+	Matrix4<float> composedMatrix = (transform1 * transform2).getTransformMatrix();
+	Matrix4<float> expectedMatrix = transform1.getTransformMatrix() * transform2.getTransformMatrix();
+
+	for(unsigned int i=0; i<16; ++i)
+	{
+		AssertHelper::assertFloatEquals(composedMatrix(i), expectedMatrix(i));
+	}
+}
+
+void TransformTest::inverseTransform()
+{
+	Transform<float> transform(Point3<float>(1.0, 2.0, 3.0), Quaternion<float>(Vector3<float>(1.0, 1.0, 0.0).normalize(), PI_VALUE/3.0), 2.0);
+
+	Transform<float> identityTransform = transform * transform.inverse();
+
+	AssertHelper::assertPoint3FloatEquals(identityTransform.getPosition(), Point3<float>(0.0, 0.0, 0.0));
+	AssertHelper::assertQuaternionFloatEquals(identityTransform.getOrientation(), Quaternion<float>());
+	AssertHelper::assertFloatEquals(identityTransform.getScale(), 1.0);
+}
+
+CppUnit::Test *TransformTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("TransformTest");
+
+	suite->addTest(new CppUnit::TestCaller<TransformTest>("transformMatrix", &TransformTest::transformMatrix));
+	suite->addTest(new CppUnit::TestCaller<TransformTest>("transformMatrixAfterPositionUpdate", &TransformTest::transformMatrixAfterPositionUpdate));
+	suite->addTest(new CppUnit::TestCaller<TransformTest>("transformMatrixAfterOrientationAndScaleUpdate", &TransformTest::transformMatrixAfterOrientationAndScaleUpdate));
+	suite->addTest(new CppUnit::TestCaller<TransformTest>("composeTransforms", &TransformTest::composeTransforms));
+	suite->addTest(new CppUnit::TestCaller<TransformTest>("inverseTransform", &TransformTest::inverseTransform));
+
+	return suite;
+}
@@ -0,0 +1,20 @@
+#ifndef URCHINENGINE_TRANSFORMTEST_H
+#define URCHINENGINE_TRANSFORMTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class TransformTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void transformMatrix();
+		void transformMatrixAfterPositionUpdate();
+		void transformMatrixAfterOrientationAndScaleUpdate();
+		void composeTransforms();
+		void inverseTransform();
+};
+
+#endif
@@ -0,0 +1,123 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "math/geometry/AABBoxArrayTest.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+void AABBoxArrayTest::frustumWithBoxes()
+{
+	std::vector<AABBox<float>> boxes = buildBoxesGrid();
+	AABBoxArray<float> boxesArray(boxes);
+	Frustum<float> frustum(90.0f, 1.0f, 0.01f, 6.0f);
+
+	std::vector<unsigned int> collideIndices;
+	frustum.collideWithAABBoxes(boxesArray, collideIndices);
+
+	std::vector<unsigned int> expectedCollideIndices;
+	for(unsigned int i=0; i<boxes.size(); ++i)
+	{
+		if(frustum.collideWithAABBox(boxes[i]))
+		{
+			expectedCollideIndices.push_back(i);
+		}
+	}
+	AssertHelper::assertTrue(!expectedCollideIndices.empty() && expectedCollideIndices.size() < boxes.size());
+	AssertHelper::assertTrue(collideIndices==expectedCollideIndices);
+}
+
+void AABBoxArrayTest::aabboxWithBoxes()
+{
+	std::vector<AABBox<float>> boxes = buildBoxesGrid();
+	AABBoxArray<float> boxesArray(boxes);
+	AABBox<float> box(Point3<float>(-1.5, -1.5, -3.5), Point3<float>(1.5, 0.5, -0.5));
+
+	std::vector<unsigned int> collideIndices;
+	box.collideWithAABBoxes(boxesArray, collideIndices);
+
+	std::vector<unsigned int> expectedCollideIndices;
+	for(unsigned int i=0; i<boxes.size(); ++i)
+	{
+		if(box.collideWithAABBox(boxes[i]))
+		{
+			expectedCollideIndices.push_back(i);
+		}
+	}
+	AssertHelper::assertUnsignedInt(collideIndices.size(), 4*3*4);
+	AssertHelper::assertTrue(collideIndices==expectedCollideIndices);
+}
+
+void AABBoxArrayTest::obboxWithBoxes()
+{
+	std::vector<AABBox<float>> boxes = buildBoxesGrid();
+	AABBoxArray<float> boxesArray(boxes);
+	OBBox<float> obbox(Vector3<float>(2.3f, 0.6f, 1.7f), Point3<float>(0.35f, -0.7f, -4.15f),
+			Quaternion<float>(Vector3<float>(0.3f, 1.0f, 0.2f).normalize(), 0.7f));
+
+	std::vector<unsigned int> collideIndices;
+	obbox.collideWithAABBoxes(boxesArray, collideIndices);
+
+	std::vector<unsigned int> expectedCollideIndices;
+	for(unsigned int i=0; i<boxes.size(); ++i)
+	{
+		if(obbox.collideWithAABBox(boxes[i]))
+		{
+			expectedCollideIndices.push_back(i);
+		}
+	}
+	AssertHelper::assertTrue(!expectedCollideIndices.empty() && expectedCollideIndices.size() < boxes.size());
+	AssertHelper::assertTrue(collideIndices==expectedCollideIndices);
+}
+
+void AABBoxArrayTest::rayWithBoxes()
+{
+	std::vector<AABBox<float>> boxes = buildBoxesGrid();
+	AABBoxArray<float> boxesArray(boxes);
+	Ray<float> ray(Point3<float>(-4.5, -3.8, 0.5), Point3<float>(3.5, 2.8, -6.5));
+
+	std::vector<unsigned int> collideIndices;
+	boxesArray.collideWithRay(ray, collideIndices);
+
+	std::vector<unsigned int> expectedCollideIndices;
+	for(unsigned int i=0; i<boxes.size(); ++i)
+	{
+		if(boxes[i].collideWithRay(ray))
+		{
+			expectedCollideIndices.push_back(i);
+		}
+	}
+	AssertHelper::assertTrue(!expectedCollideIndices.empty());
+	AssertHelper::assertTrue(collideIndices==expectedCollideIndices);
+}
+
+/**
+ * @return Grid of 10x10x10 boxes of size 0.8 (more than one batch of boxes)
+ */
+std::vector<AABBox<float>> AABBoxArrayTest::buildBoxesGrid() const
+{
+	std::vector<AABBox<float>> boxes;
+	for(int x=-5; x<5; ++x)
+	{
+		for(int y=-5; y<5; ++y)
+		{
+			for(int z=-10; z<0; ++z)
+			{
+				boxes.emplace_back(AABBox<float>(Point3<float>(x+0.1f, y+0.1f, z+0.1f), Point3<float>(x+0.9f, y+0.9f, z+0.9f)));
+			}
+		}
+	}
+	return boxes;
+}
+
+CppUnit::Test *AABBoxArrayTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("AABBoxArrayTest");
+
+	suite->addTest(new CppUnit::TestCaller<AABBoxArrayTest>("frustumWithBoxes", &AABBoxArrayTest::frustumWithBoxes));
+	suite->addTest(new CppUnit::TestCaller<AABBoxArrayTest>("aabboxWithBoxes", &AABBoxArrayTest::aabboxWithBoxes));
+	suite->addTest(new CppUnit::TestCaller<AABBoxArrayTest>("obboxWithBoxes", &AABBoxArrayTest::obboxWithBoxes));
+	suite->addTest(new CppUnit::TestCaller<AABBoxArrayTest>("rayWithBoxes", &AABBoxArrayTest::rayWithBoxes));
+
+	return suite;
+}
@@ -0,0 +1,23 @@
+#ifndef URCHINENGINE_AABBOXARRAYTEST_H
+#define URCHINENGINE_AABBOXARRAYTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+using namespace urchin;
+
+class AABBoxArrayTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void frustumWithBoxes();
+		void aabboxWithBoxes();
+		void obboxWithBoxes();
+		void rayWithBoxes();
+
+	private:
+		std::vector<AABBox<float>> buildBoxesGrid() const;
+};
+
+#endif
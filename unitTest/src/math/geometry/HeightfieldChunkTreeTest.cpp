@@ -0,0 +1,164 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "math/geometry/HeightfieldChunkTreeTest.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+void HeightfieldChunkTreeTest::chunksLayout()
+{
+	std::vector<Point3<float>> heightfield = buildHeightfield(10, 10);
+
+	HeightfieldChunkTree chunkTree(heightfield, 10, 10, 4, 8);
+
+	AssertHelper::assertUnsignedInt(chunkTree.getNumberLods(), 3); //lod 2: one quad by chunk
+	AssertHelper::assertUnsignedInt(chunkTree.getChunksCount(), 9);
+	AssertHelper::assertUnsignedInt(chunkTree.getChunkVerticesCount(), 5 * 5 + 4 * 5);
+	AssertHelper::assertUnsignedInt(chunkTree.getChunksVertices().size(), 9 * 45);
+	AssertHelper::assertPoint3FloatEquals(chunkTree.getChunksVertices()[45 * 4], heightfield[4 + 10 * 4]); //first vertex of chunk (1, 1)
+	AssertHelper::assertUnsignedInt(chunkTree.getChunksVerticesSource()[45 * 8 + 24], 99); //last grid vertex of chunk (2, 2) clamped to the heightfield
+	AssertHelper::assertFloatEquals(chunkTree.getChunkBox(8).getMax().X, heightfield[99].X);
+}
+
+void HeightfieldChunkTreeTest::lodsIndices()
+{
+	std::vector<Point3<float>> heightfield = buildHeightfield(10, 10);
+
+	HeightfieldChunkTree chunkTree(heightfield, 10, 10, 4, 3);
+
+	AssertHelper::assertUnsignedInt(chunkTree.getLodIndicesOffset(0), 0);
+	AssertHelper::assertUnsignedInt(chunkTree.getLodIndicesCount(0), (16 * 2 + 4 * 4 * 2) * 3);
+	AssertHelper::assertUnsignedInt(chunkTree.getLodIndicesOffset(1), chunkTree.getLodIndicesCount(0));
+	AssertHelper::assertUnsignedInt(chunkTree.getLodIndicesCount(1), (4 * 2 + 4 * 2 * 2) * 3);
+	AssertHelper::assertUnsignedInt(chunkTree.getLodIndicesCount(2), (1 * 2 + 4 * 1 * 2) * 3);
+	for(unsigned int index : chunkTree.getLodsIndices())
+	{
+		AssertHelper::assertTrue(index < chunkTree.getChunkVerticesCount());
+	}
+}
+
+void HeightfieldChunkTreeTest::skirtsFacingOutside()
+{
+	std::vector<Point3<float>> heightfield = buildHeightfield(10, 10);
+	heightfield[4 + 10 * 4].Y = 2.0f;
+
+	HeightfieldChunkTree chunkTree(heightfield, 10, 10, 4, 3);
+
+	//chunk (1, 1) has skirts on all borders. Displayed triangles are clockwise seen from outside: (v1 - v0) x (v2 - v0) points inside.
+	const Point3<float> *vertices = &chunkTree.getChunksVertices()[4 * chunkTree.getChunkVerticesCount()];
+	const AABBox<float> &chunkBox = chunkTree.getChunkBox(4);
+	Point3<float> chunkCenter((chunkBox.getMin().X + chunkBox.getMax().X) / 2.0f, 0.0f, (chunkBox.getMin().Z + chunkBox.getMax().Z) / 2.0f);
+	unsigned int gridIndicesCount = 16 * 2 * 3;
+	unsigned int skirtTrianglesCount = 0;
+	for(unsigned int i=gridIndicesCount; i<chunkTree.getLodIndicesCount(0); i+=3)
+	{
+		const unsigned int *triangle = &chunkTree.getLodsIndices()[i];
+		Vector3<float> normal = vertices[triangle[0]].vector(vertices[triangle[1]]).crossProduct(vertices[triangle[0]].vector(vertices[triangle[2]]));
+		if(normal.squareLength() > 0.0f)
+		{
+			Vector3<float> outside = chunkCenter.vector(vertices[triangle[0]]);
+			AssertHelper::assertTrue(normal.X * outside.X + normal.Z * outside.Z < 0.0f);
+			skirtTrianglesCount++;
+		}
+	}
+	AssertHelper::assertUnsignedInt(skirtTrianglesCount, 4 * 4 * 2);
+	AssertHelper::assertTrue(chunkTree.getSkirtDepth() >= chunkTree.getLodError(2));
+}
+
+void HeightfieldChunkTreeTest::heightAtLod()
+{
+	std::vector<Point3<float>> heightfield = buildHeightfield(10, 10);
+	heightfield[1 + 10 * 1].Y = 1.0f;
+
+	HeightfieldChunkTree chunkTree(heightfield, 10, 10, 4, 3);
+
+	Point2<float> spikePoint(heightfield[11].X, heightfield[11].Z);
+	AssertHelper::assertFloatEquals(chunkTree.findHeightAt(spikePoint, 0), 1.0f);
+	AssertHelper::assertFloatEquals(chunkTree.findHeightAt(spikePoint + Point2<float>(0.5f, 0.25f), 0), 0.5f);
+	AssertHelper::assertFloatEquals(chunkTree.findHeightAt(spikePoint, 1), 0.0f); //spike vertex is skipped
+	AssertHelper::assertFloatEquals(chunkTree.findHeightAt(Point2<float>(-100.0f, -100.0f), 0), 0.0f);
+	AssertHelper::assertFloatEquals(chunkTree.getLodError(0), 0.0f);
+	AssertHelper::assertFloatEquals(chunkTree.getLodError(1), 1.0f);
+}
+
+void HeightfieldChunkTreeTest::trianglesInArea()
+{
+	std::vector<Point3<float>> heightfield = buildHeightfield(10, 10);
+	HeightfieldChunkTree chunkTree(heightfield, 10, 10, 4, 3);
+
+	std::vector<Point3<float>> triangles;
+	chunkTree.findTrianglesIn(Point2<float>(-100.0f, -100.0f), Point2<float>(100.0f, 100.0f), 0, triangles);
+	AssertHelper::assertUnsignedInt(triangles.size(), 9 * 9 * 2 * 3);
+
+	triangles.clear();
+	chunkTree.findTrianglesIn(Point2<float>(-100.0f, -100.0f), Point2<float>(100.0f, 100.0f), 1, triangles);
+	AssertHelper::assertUnsignedInt(triangles.size(), 5 * 5 * 2 * 3); //last cell shortened to the heightfield border
+	AssertHelper::assertPoint3FloatEquals(triangles.back(), heightfield[9 + 10 * 8]);
+
+	triangles.clear();
+	chunkTree.findTrianglesIn(Point2<float>(heightfield[0].X, heightfield[0].Z), Point2<float>(heightfield[0].X + 0.5f, heightfield[0].Z + 0.5f), 0, triangles);
+	AssertHelper::assertUnsignedInt(triangles.size(), 2 * 3);
+
+	triangles.clear();
+	chunkTree.findTrianglesIn(Point2<float>(100.0f, 100.0f), Point2<float>(200.0f, 200.0f), 0, triangles);
+	AssertHelper::assertUnsignedInt(triangles.size(), 0);
+}
+
+void HeightfieldChunkTreeTest::selectVisibleChunks()
+{
+	std::vector<Point3<float>> heightfield = buildHeightfield(10, 10);
+	HeightfieldChunkTree chunkTree(heightfield, 10, 10, 4, 3);
+
+	std::vector<HeightfieldChunkSelection> selectedChunks;
+	Frustum<float> frustum(90.0f, 1.0f, 0.01f, 100.0f); //view toward Z negative from origin
+	chunkTree.selectChunks(frustum, Point3<float>(0.0f, 0.0f, 0.0f), 2.0f, selectedChunks);
+
+	std::vector<bool> isSelected(chunkTree.getChunksCount(), false);
+	for(const auto &selectedChunk : selectedChunks)
+	{
+		isSelected[selectedChunk.chunkIndex] = true;
+		if(selectedChunk.chunkIndex==0 || selectedChunk.chunkIndex==4)
+		{ //view position in chunk 4 and at 0.5 * sqrt(2) of chunk 0
+			AssertHelper::assertUnsignedInt(selectedChunk.lod, 0);
+		}
+	}
+	AssertHelper::assertTrue(isSelected[0] && isSelected[1] && isSelected[2] && isSelected[4]);
+	AssertHelper::assertTrue(!isSelected[5] && !isSelected[6] && !isSelected[7] && !isSelected[8]); //chunks behind the view
+
+	chunkTree.selectChunks(frustum, Point3<float>(0.0f, 0.0f, 10.0f), 2.0f, selectedChunks);
+	for(const auto &selectedChunk : selectedChunks)
+	{ //distance from 6.5 to 10.5: lod 2
+		AssertHelper::assertUnsignedInt(selectedChunk.lod, 2);
+	}
+}
+
+/**
+* @return Flat heightfield centered on origin with a distance of 1 between points
+*/
+std::vector<Point3<float>> HeightfieldChunkTreeTest::buildHeightfield(unsigned int xSize, unsigned int zSize) const
+{
+	std::vector<Point3<float>> heightfield;
+	for(unsigned int z=0; z<zSize; ++z)
+	{
+		for(unsigned int x=0; x<xSize; ++x)
+		{
+			heightfield.emplace_back(Point3<float>((float)x - (float)(xSize - 1) / 2.0f, 0.0f, (float)z - (float)(zSize - 1) / 2.0f));
+		}
+	}
+	return heightfield;
+}
+
+CppUnit::Test *HeightfieldChunkTreeTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("HeightfieldChunkTreeTest");
+
+	suite->addTest(new CppUnit::TestCaller<HeightfieldChunkTreeTest>("chunksLayout", &HeightfieldChunkTreeTest::chunksLayout));
+	suite->addTest(new CppUnit::TestCaller<HeightfieldChunkTreeTest>("lodsIndices", &HeightfieldChunkTreeTest::lodsIndices));
+	suite->addTest(new CppUnit::TestCaller<HeightfieldChunkTreeTest>("skirtsFacingOutside", &HeightfieldChunkTreeTest::skirtsFacingOutside));
+	suite->addTest(new CppUnit::TestCaller<HeightfieldChunkTreeTest>("heightAtLod", &HeightfieldChunkTreeTest::heightAtLod));
+	suite->addTest(new CppUnit::TestCaller<HeightfieldChunkTreeTest>("trianglesInArea", &HeightfieldChunkTreeTest::trianglesInArea));
+	suite->addTest(new CppUnit::TestCaller<HeightfieldChunkTreeTest>("selectVisibleChunks", &HeightfieldChunkTreeTest::selectVisibleChunks));
+
+	return suite;
+}
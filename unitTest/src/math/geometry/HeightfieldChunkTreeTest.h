@@ -0,0 +1,26 @@
+#ifndef URCHINENGINE_HEIGHTFIELDCHUNKTREETEST_H
+#define URCHINENGINE_HEIGHTFIELDCHUNKTREETEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include <vector>
+#include "UrchinCommon.h"
+using namespace urchin;
+
+class HeightfieldChunkTreeTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void chunksLayout();
+		void lodsIndices();
+		void skirtsFacingOutside();
+		void heightAtLod();
+		void trianglesInArea();
+		void selectVisibleChunks();
+
+	private:
+		std::vector<Point3<float>> buildHeightfield(unsigned int, unsigned int) const;
+};
+
+#endif
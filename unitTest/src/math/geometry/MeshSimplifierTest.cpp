@@ -0,0 +1,176 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <map>
+#include "UrchinCommon.h"
+
+#include "math/geometry/MeshSimplifierTest.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+void MeshSimplifierTest::noSimplificationRequired()
+{
+	std::vector<Point3<float>> vertices;
+	std::vector<unsigned int> indices;
+	buildGrid(4, vertices, indices);
+
+	MeshSimplifier meshSimplifier(vertices.data(), vertices.size(), indices.data(), indices.size());
+	std::vector<unsigned int> simplifiedIndices = meshSimplifier.simplify(32);
+
+	AssertHelper::assertUnsignedInt(simplifiedIndices.size(), indices.size());
+	for(unsigned int i=0; i<indices.size(); ++i)
+	{
+		AssertHelper::assertUnsignedInt(simplifiedIndices[i], indices[i]);
+	}
+}
+
+void MeshSimplifierTest::simplifyPlane()
+{
+	std::vector<Point3<float>> vertices;
+	std::vector<unsigned int> indices;
+	buildGrid(10, vertices, indices);
+
+	MeshSimplifier meshSimplifier(vertices.data(), vertices.size(), indices.data(), indices.size());
+	std::vector<unsigned int> simplifiedIndices = meshSimplifier.simplify(50);
+
+	AssertHelper::assertTrue(simplifiedIndices.size() / 3 <= 50);
+	AssertHelper::assertUnsignedInt(meshSimplifier.getTrianglesCount(), simplifiedIndices.size() / 3);
+	AssertHelper::assertFloatEquals(computeArea(vertices, simplifiedIndices), 100.0f); //border is kept
+	for(unsigned int i=0; i<simplifiedIndices.size(); i+=3)
+	{ //no flipped triangle
+		Vector3<float> normal = vertices[simplifiedIndices[i]].vector(vertices[simplifiedIndices[i+1]])
+				.crossProduct(vertices[simplifiedIndices[i]].vector(vertices[simplifiedIndices[i+2]]));
+		AssertHelper::assertTrue(normal.Z > 0.0f);
+	}
+}
+
+void MeshSimplifierTest::simplifyCube()
+{
+	std::vector<Point3<float>> vertices;
+	std::vector<unsigned int> indices;
+	buildCube(4, vertices, indices);
+
+	MeshSimplifier meshSimplifier(vertices.data(), vertices.size(), indices.data(), indices.size());
+	std::vector<unsigned int> simplifiedIndices = meshSimplifier.simplify(12);
+
+	AssertHelper::assertUnsignedInt(simplifiedIndices.size(), 12 * 3);
+	for(unsigned int index : simplifiedIndices)
+	{ //only cube corners remain
+		AssertHelper::assertFloatEquals(std::abs(vertices[index].X), 1.0f);
+		AssertHelper::assertFloatEquals(std::abs(vertices[index].Y), 1.0f);
+		AssertHelper::assertFloatEquals(std::abs(vertices[index].Z), 1.0f);
+	}
+}
+
+void MeshSimplifierTest::successiveSimplifications()
+{
+	std::vector<Point3<float>> vertices;
+	std::vector<unsigned int> indices;
+	buildCube(8, vertices, indices);
+
+	MeshSimplifier meshSimplifier(vertices.data(), vertices.size(), indices.data(), indices.size());
+	std::vector<unsigned int> simplifiedIndices1 = meshSimplifier.simplify(384);
+	std::vector<unsigned int> simplifiedIndices2 = meshSimplifier.simplify(96);
+
+	AssertHelper::assertUnsignedInt(indices.size() / 3, 768);
+	AssertHelper::assertUnsignedInt(simplifiedIndices1.size() / 3, 384);
+	AssertHelper::assertUnsignedInt(simplifiedIndices2.size() / 3, 96);
+	AssertHelper::assertFloatEquals(computeArea(vertices, simplifiedIndices2), 24.0f);
+}
+
+/**
+ * Grid of size x size quads on plane z=0 with normals toward +Z
+ */
+void MeshSimplifierTest::buildGrid(unsigned int size, std::vector<Point3<float>> &vertices, std::vector<unsigned int> &indices) const
+{
+	for(unsigned int y=0; y<=size; ++y)
+	{
+		for(unsigned int x=0; x<=size; ++x)
+		{
+			vertices.emplace_back(Point3<float>((float)x, (float)y, 0.0f));
+		}
+	}
+
+	for(unsigned int y=0; y<size; ++y)
+	{
+		for(unsigned int x=0; x<size; ++x)
+		{
+			unsigned int index = y * (size + 1) + x;
+			indices.insert(indices.end(), {index, index + 1, index + size + 1});
+			indices.insert(indices.end(), {index + 1, index + size + 2, index + size + 1});
+		}
+	}
+}
+
+/**
+ * Closed cube from -1 to 1 with faces subdivided in size x size quads. Vertices on cube edges are shared by the faces.
+ */
+void MeshSimplifierTest::buildCube(unsigned int size, std::vector<Point3<float>> &vertices, std::vector<unsigned int> &indices) const
+{
+	std::map<std::tuple<int, int, int>, unsigned int> verticesIndex;
+	auto vertexIndex = [&](const Point3<float> &point) {
+		std::tuple<int, int, int> key((int)std::lround(point.X * 1000.0f), (int)std::lround(point.Y * 1000.0f), (int)std::lround(point.Z * 1000.0f));
+		auto itVertex = verticesIndex.find(key);
+		if(itVertex!=verticesIndex.end())
+		{
+			return itVertex->second;
+		}
+		unsigned int index = vertices.size();
+		vertices.push_back(point);
+		verticesIndex[key] = index;
+		return index;
+	};
+
+	for(unsigned int axis=0; axis<3; ++axis)
+	{
+		for(float side : {-1.0f, 1.0f})
+		{
+			for(unsigned int v=0; v<size; ++v)
+			{
+				for(unsigned int u=0; u<size; ++u)
+				{
+					unsigned int quadIndices[4];
+					for(unsigned int corner=0; corner<4; ++corner)
+					{
+						float faceU = -1.0f + 2.0f * (float)(u + (corner==1 || corner==2 ? 1 : 0)) / (float)size;
+						float faceV = -1.0f + 2.0f * (float)(v + (corner>=2 ? 1 : 0)) / (float)size;
+						Point3<float> point;
+						point[axis] = side;
+						point[(axis + 1) % 3] = faceU;
+						point[(axis + 2) % 3] = faceV;
+						quadIndices[corner] = vertexIndex(point);
+					}
+
+					if(side > 0.0f)
+					{ //counter-clockwise seen from outside
+						indices.insert(indices.end(), {quadIndices[0], quadIndices[1], quadIndices[2], quadIndices[0], quadIndices[2], quadIndices[3]});
+					}else
+					{
+						indices.insert(indices.end(), {quadIndices[0], quadIndices[2], quadIndices[1], quadIndices[0], quadIndices[3], quadIndices[2]});
+					}
+				}
+			}
+		}
+	}
+}
+
+float MeshSimplifierTest::computeArea(const std::vector<Point3<float>> &vertices, const std::vector<unsigned int> &indices) const
+{
+	float area = 0.0f;
+	for(unsigned int i=0; i<indices.size(); i+=3)
+	{
+		area += vertices[indices[i]].vector(vertices[indices[i+1]]).crossProduct(vertices[indices[i]].vector(vertices[indices[i+2]])).length() / 2.0f;
+	}
+	return area;
+}
+
+CppUnit::Test *MeshSimplifierTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("MeshSimplifierTest");
+
+	suite->addTest(new CppUnit::TestCaller<MeshSimplifierTest>("noSimplificationRequired", &MeshSimplifierTest::noSimplificationRequired));
+	suite->addTest(new CppUnit::TestCaller<MeshSimplifierTest>("simplifyPlane", &MeshSimplifierTest::simplifyPlane));
+	suite->addTest(new CppUnit::TestCaller<MeshSimplifierTest>("simplifyCube", &MeshSimplifierTest::simplifyCube));
+	suite->addTest(new CppUnit::TestCaller<MeshSimplifierTest>("successiveSimplifications", &MeshSimplifierTest::successiveSimplifications));
+
+	return suite;
+}
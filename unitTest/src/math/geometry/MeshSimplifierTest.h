@@ -0,0 +1,26 @@
+#ifndef URCHINENGINE_MESHSIMPLIFIERTEST_H
+#define URCHINENGINE_MESHSIMPLIFIERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include <vector>
+#include "UrchinCommon.h"
+using namespace urchin;
+
+class MeshSimplifierTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void noSimplificationRequired();
+		void simplifyPlane();
+		void simplifyCube();
+		void successiveSimplifications();
+
+	private:
+		void buildGrid(unsigned int, std::vector<Point3<float>> &, std::vector<unsigned int> &) const;
+		void buildCube(unsigned int, std::vector<Point3<float>> &, std::vector<unsigned int> &) const;
+		float computeArea(const std::vector<Point3<float>> &, const std::vector<unsigned int> &) const;
+};
+
+#endif
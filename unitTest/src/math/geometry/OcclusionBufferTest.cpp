@@ -0,0 +1,107 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "math/geometry/OcclusionBufferTest.h"
+#include "AssertHelper.h"
+using namespace urchin;
+
+void OcclusionBufferTest::noOccluder()
+{
+	OcclusionBuffer occlusionBuffer(64, 32);
+	occlusionBuffer.clear(Matrix4<float>());
+	occlusionBuffer.buildHierarchicalDepth();
+
+	AssertHelper::assertTrue(!occlusionBuffer.hasOccluder());
+	AssertHelper::assertFloatEquals(occlusionBuffer.getDepth(10, 10), 1.0f);
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.1f, -0.1f, 0.5f), Point3<float>(0.1f, 0.1f, 0.6f))));
+}
+
+void OcclusionBufferTest::boxBehindOccluder()
+{ //identity view projection matrix: window coordinates are directly deduced from the points coordinates
+	OcclusionBuffer occlusionBuffer(64, 32);
+	occlusionBuffer.clear(Matrix4<float>());
+	rasterizeQuad(occlusionBuffer, Point3<float>(-0.8f, -0.8f, 0.0f), Point3<float>(0.8f, -0.8f, 0.0f),
+			Point3<float>(0.8f, 0.8f, 0.0f), Point3<float>(-0.8f, 0.8f, 0.0f));
+	occlusionBuffer.buildHierarchicalDepth();
+
+	AssertHelper::assertTrue(occlusionBuffer.hasOccluder());
+	AssertHelper::assertFloatEquals(occlusionBuffer.getDepth(40, 10), 0.5f);
+	AssertHelper::assertFloatEquals(occlusionBuffer.getDepth(1, 1), 1.0f);
+	AssertHelper::assertFloatEquals(occlusionBuffer.getDepth(32, 16), 1.0f); //texel crossed by the diagonal edge shared by the two triangles
+	AssertHelper::assertTrue(!occlusionBuffer.isVisible(AABBox<float>(Point3<float>(0.2f, -0.6f, 0.5f), Point3<float>(0.6f, -0.2f, 0.9f))));
+	AssertHelper::assertTrue(!occlusionBuffer.isVisible(AABBox<float>(Point3<float>(0.1f, -0.7f, 0.1f), Point3<float>(0.7f, -0.1f, 0.2f))));
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.2f, -0.2f, 0.5f), Point3<float>(0.2f, 0.2f, 0.9f)))); //behind texels partially covered
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.2f, -0.2f, -0.5f), Point3<float>(0.2f, 0.2f, -0.2f))));
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.2f, -0.2f, -0.1f), Point3<float>(0.2f, 0.2f, 0.5f))));
+}
+
+void OcclusionBufferTest::boxPartiallyBehindOccluder()
+{
+	OcclusionBuffer occlusionBuffer(64, 32);
+	occlusionBuffer.clear(Matrix4<float>());
+	rasterizeQuad(occlusionBuffer, Point3<float>(-1.0f, -1.0f, 0.0f), Point3<float>(0.0f, -1.0f, 0.0f),
+			Point3<float>(0.0f, 1.0f, 0.0f), Point3<float>(-1.0f, 1.0f, 0.0f));
+	occlusionBuffer.buildHierarchicalDepth();
+
+	AssertHelper::assertTrue(!occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.9f, 0.2f, 0.5f), Point3<float>(-0.6f, 0.9f, 0.9f))));
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.5f, -0.5f, 0.5f), Point3<float>(0.5f, 0.5f, 0.9f))));
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(0.2f, -0.5f, 0.5f), Point3<float>(0.5f, 0.5f, 0.9f))));
+	AssertHelper::assertTrue(!occlusionBuffer.isVisible(AABBox<float>(Point3<float>(1.5f, -0.5f, 0.5f), Point3<float>(2.0f, 0.5f, 0.9f)))); //outside the buffer
+}
+
+void OcclusionBufferTest::farthestDepthOfTexels()
+{ //occluder inclined along X axis: window depth from 0.2 (x=0) to 0.6 (x=64)
+	OcclusionBuffer occlusionBuffer(64, 32);
+	occlusionBuffer.clear(Matrix4<float>());
+	rasterizeQuad(occlusionBuffer, Point3<float>(-1.0f, -1.0f, -0.6f), Point3<float>(1.0f, -1.0f, 0.2f),
+			Point3<float>(1.0f, 1.0f, 0.2f), Point3<float>(-1.0f, 1.0f, -0.6f));
+	occlusionBuffer.buildHierarchicalDepth();
+
+	AssertHelper::assertFloatEquals(occlusionBuffer.getDepth(40, 4), 0.2f + 0.4f * 41.0f / 64.0f); //depth on the right side of the texel
+}
+
+void OcclusionBufferTest::occluderCrossingNearPlane()
+{ //camera at origin looking at Z- and wall inclined from the bottom behind camera (z=4) to the top in front of camera (z=-6)
+	OcclusionBuffer occlusionBuffer(64, 64);
+	occlusionBuffer.clear(buildPerspectiveMatrix());
+	rasterizeQuad(occlusionBuffer, Point3<float>(-10.0f, -10.0f, 4.0f), Point3<float>(10.0f, -10.0f, 4.0f),
+			Point3<float>(10.0f, 10.0f, -6.0f), Point3<float>(-10.0f, 10.0f, -6.0f));
+	occlusionBuffer.buildHierarchicalDepth();
+
+	AssertHelper::assertTrue(occlusionBuffer.getDepth(40, 24) < 1.0f);
+	AssertHelper::assertTrue(!occlusionBuffer.isVisible(AABBox<float>(Point3<float>(2.0f, -4.0f, -20.0f), Point3<float>(4.0f, -2.0f, -15.0f))));
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-0.1f, -0.1f, -0.8f), Point3<float>(0.1f, 0.1f, -0.6f))));
+	AssertHelper::assertTrue(occlusionBuffer.isVisible(AABBox<float>(Point3<float>(-1.0f, -1.0f, -2.0f), Point3<float>(1.0f, 1.0f, 1.0f)))); //crossing near plane
+}
+
+Matrix4<float> OcclusionBufferTest::buildPerspectiveMatrix() const
+{ //field of view of 90 degrees, near plane at 0.1 and far plane at 100.0
+	float near = 0.1f, far = 100.0f;
+	return Matrix4<float>(
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, (far + near) / (near - far), (2.0f * far * near) / (near - far),
+			0.0f, 0.0f, -1.0f, 0.0f);
+}
+
+void OcclusionBufferTest::rasterizeQuad(OcclusionBuffer &occlusionBuffer, const Point3<float> &p1, const Point3<float> &p2,
+		const Point3<float> &p3, const Point3<float> &p4) const
+{
+	std::vector<Point3<float>> vertices = {p1, p2, p3, p4};
+	std::vector<unsigned int> indices = {0, 1, 2, 0, 2, 3};
+	occlusionBuffer.rasterizeTriangles(Matrix4<float>(), vertices.data(), vertices.size(), indices.data(), indices.size());
+}
+
+CppUnit::Test *OcclusionBufferTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("OcclusionBufferTest");
+
+	suite->addTest(new CppUnit::TestCaller<OcclusionBufferTest>("noOccluder", &OcclusionBufferTest::noOccluder));
+	suite->addTest(new CppUnit::TestCaller<OcclusionBufferTest>("boxBehindOccluder", &OcclusionBufferTest::boxBehindOccluder));
+	suite->addTest(new CppUnit::TestCaller<OcclusionBufferTest>("boxPartiallyBehindOccluder", &OcclusionBufferTest::boxPartiallyBehindOccluder));
+	suite->addTest(new CppUnit::TestCaller<OcclusionBufferTest>("farthestDepthOfTexels", &OcclusionBufferTest::farthestDepthOfTexels));
+	suite->addTest(new CppUnit::TestCaller<OcclusionBufferTest>("occluderCrossingNearPlane", &OcclusionBufferTest::occluderCrossingNearPlane));
+
+	return suite;
+}
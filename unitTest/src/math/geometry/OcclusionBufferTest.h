@@ -0,0 +1,25 @@
+#ifndef URCHINENGINE_OCCLUSIONBUFFERTEST_H
+#define URCHINENGINE_OCCLUSIONBUFFERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+using namespace urchin;
+
+class OcclusionBufferTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void noOccluder();
+		void boxBehindOccluder();
+		void boxPartiallyBehindOccluder();
+		void farthestDepthOfTexels();
+		void occluderCrossingNearPlane();
+
+	private:
+		Matrix4<float> buildPerspectiveMatrix() const;
+		void rasterizeQuad(OcclusionBuffer &, const Point3<float> &, const Point3<float> &, const Point3<float> &, const Point3<float> &) const;
+};
+
+#endif
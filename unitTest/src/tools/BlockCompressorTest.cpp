@@ -0,0 +1,128 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <cstdlib>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/BlockCompressorTest.h"
+using namespace urchin;
+
+void BlockCompressorTest::compressUniformColor()
+{
+	std::vector<unsigned char> texels;
+	for(unsigned int i=0; i<16; ++i)
+	{
+		texels.insert(texels.end(), {200, 100, 50});
+	}
+
+	BlockCompressor blockCompressor;
+	std::vector<unsigned char> blocks = blockCompressor.compress(BlockCompressor::BC1, 4, 4, 3, texels.data());
+	std::vector<unsigned char> decompressedTexels = blockCompressor.decompress(BlockCompressor::BC1, 4, 4, blocks.data());
+
+	AssertHelper::assertUnsignedInt(blocks.size(), 8);
+	AssertHelper::assertTrue(computeMaxError(texels, 3, decompressedTexels, 3) <= 4);
+	AssertHelper::assertUnsignedInt(decompressedTexels[3], 255);
+}
+
+void BlockCompressorTest::compressColorGradient()
+{
+	std::vector<unsigned char> texels;
+	for(unsigned int y=0; y<16; ++y)
+	{
+		for(unsigned int x=0; x<16; ++x)
+		{
+			texels.insert(texels.end(), {(unsigned char)(x*16), (unsigned char)(255 - x*16), (unsigned char)(40 + x*8)});
+		}
+	}
+
+	BlockCompressor blockCompressor;
+	std::vector<unsigned char> blocks = blockCompressor.compress(BlockCompressor::BC1, 16, 16, 3, texels.data());
+	std::vector<unsigned char> decompressedTexels = blockCompressor.decompress(BlockCompressor::BC1, 16, 16, blocks.data());
+
+	AssertHelper::assertUnsignedInt(blocks.size(), 16 * 8);
+	AssertHelper::assertTrue(computeMaxError(texels, 3, decompressedTexels, 3) <= 8);
+}
+
+void BlockCompressorTest::compressAlphaGradient()
+{
+	std::vector<unsigned char> texels;
+	for(unsigned int y=0; y<8; ++y)
+	{
+		for(unsigned int x=0; x<8; ++x)
+		{
+			texels.insert(texels.end(), {30, 60, 90, (unsigned char)(x*30)});
+		}
+	}
+
+	BlockCompressor blockCompressor;
+	std::vector<unsigned char> blocks = blockCompressor.compress(BlockCompressor::BC3, 8, 8, 4, texels.data());
+	std::vector<unsigned char> decompressedTexels = blockCompressor.decompress(BlockCompressor::BC3, 8, 8, blocks.data());
+
+	AssertHelper::assertUnsignedInt(blocks.size(), 4 * 16);
+	AssertHelper::assertTrue(computeMaxError(texels, 4, decompressedTexels, 4) <= 7);
+}
+
+void BlockCompressorTest::compressTwoChannels()
+{
+	std::vector<unsigned char> texels;
+	for(unsigned int i=0; i<16; ++i)
+	{
+		texels.insert(texels.end(), {(unsigned char)(i*4), (unsigned char)(200 - i*3), 77});
+	}
+
+	BlockCompressor blockCompressor;
+	std::vector<unsigned char> blocks = blockCompressor.compress(BlockCompressor::BC5, 4, 4, 3, texels.data());
+	std::vector<unsigned char> decompressedTexels = blockCompressor.decompress(BlockCompressor::BC5, 4, 4, blocks.data());
+
+	AssertHelper::assertUnsignedInt(blocks.size(), 16);
+	AssertHelper::assertTrue(computeMaxError(texels, 3, decompressedTexels, 2) <= 5);
+	AssertHelper::assertUnsignedInt(decompressedTexels[2], 0);
+}
+
+void BlockCompressorTest::compressImageSizeNotMultipleOf4()
+{
+	std::vector<unsigned char> texels;
+	for(unsigned int i=0; i<6*5; ++i)
+	{
+		texels.push_back((unsigned char)(i*8));
+	}
+
+	BlockCompressor blockCompressor;
+	std::vector<unsigned char> blocks = blockCompressor.compress(BlockCompressor::BC1, 6, 5, 1, texels.data());
+	std::vector<unsigned char> decompressedTexels = blockCompressor.decompress(BlockCompressor::BC1, 6, 5, blocks.data());
+
+	AssertHelper::assertUnsignedInt(blocks.size(), 2 * 2 * 8);
+	AssertHelper::assertUnsignedInt(decompressedTexels.size(), 6 * 5 * 4);
+	AssertHelper::assertTrue(computeMaxError(texels, 1, decompressedTexels, 1) <= 20);
+}
+
+/**
+ * @return Maximum difference between the texels on the first components of each texel
+ */
+unsigned int BlockCompressorTest::computeMaxError(const std::vector<unsigned char> &texels, unsigned int componentsCount,
+		const std::vector<unsigned char> &rgbaTexels, unsigned int comparedComponentsCount) const
+{
+	unsigned int maxError = 0;
+	for(unsigned int i=0; i<texels.size() / componentsCount; ++i)
+	{
+		for(unsigned int c=0; c<comparedComponentsCount; ++c)
+		{
+			auto error = (unsigned int)std::abs(texels[i*componentsCount + c] - rgbaTexels[i*4 + c]);
+			maxError = std::max(maxError, error);
+		}
+	}
+	return maxError;
+}
+
+CppUnit::Test *BlockCompressorTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("BlockCompressorTest");
+
+	suite->addTest(new CppUnit::TestCaller<BlockCompressorTest>("compressUniformColor", &BlockCompressorTest::compressUniformColor));
+	suite->addTest(new CppUnit::TestCaller<BlockCompressorTest>("compressColorGradient", &BlockCompressorTest::compressColorGradient));
+	suite->addTest(new CppUnit::TestCaller<BlockCompressorTest>("compressAlphaGradient", &BlockCompressorTest::compressAlphaGradient));
+	suite->addTest(new CppUnit::TestCaller<BlockCompressorTest>("compressTwoChannels", &BlockCompressorTest::compressTwoChannels));
+	suite->addTest(new CppUnit::TestCaller<BlockCompressorTest>("compressImageSizeNotMultipleOf4", &BlockCompressorTest::compressImageSizeNotMultipleOf4));
+
+	return suite;
+}
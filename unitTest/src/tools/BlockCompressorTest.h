@@ -0,0 +1,23 @@
+#ifndef URCHINENGINE_BLOCKCOMPRESSORTEST_H
+#define URCHINENGINE_BLOCKCOMPRESSORTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include <vector>
+
+class BlockCompressorTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void compressUniformColor();
+		void compressColorGradient();
+		void compressAlphaGradient();
+		void compressTwoChannels();
+		void compressImageSizeNotMultipleOf4();
+
+	private:
+		unsigned int computeMaxError(const std::vector<unsigned char> &, unsigned int, const std::vector<unsigned char> &, unsigned int) const;
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <fstream>
+#include <cstdio>
+#include <cstdlib>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/ConfigKeyTest.h"
+using namespace urchin;
+
+#define PROPERTIES_TEST_FILE "urchinConfigKeyTest.properties"
+
+void ConfigKeyTest::readValues()
+{
+	ConfigKey<unsigned int> iterationKey("constraintSolver.constraintSolverIteration");
+	ConfigKey<float> biasFactorKey("constraintSolver.biasFactor");
+	ConfigKey<bool> warmStartingKey("constraintSolver.useWarmStarting");
+	ConfigKey<std::string> enableKey("profiler.physicsEnable");
+
+	AssertHelper::assertUnsignedInt(iterationKey.getValue(), ConfigService::instance()->getUnsignedIntValue("constraintSolver.constraintSolverIteration"));
+	AssertHelper::assertFloatEquals(biasFactorKey.getValue(), ConfigService::instance()->getFloatValue("constraintSolver.biasFactor"));
+	AssertHelper::assertTrue(warmStartingKey.getValue() == ConfigService::instance()->getBoolValue("constraintSolver.useWarmStarting"));
+	AssertHelper::assertTrue(enableKey.getValue() == "false");
+}
+
+void ConfigKeyTest::readValuesAfterReload()
+{
+	std::string workingDirectory = getTemporaryDirectory();
+	writePropertiesFile(workingDirectory, "configKeyTest.value = 2");
+	ConfigService::instance()->loadProperties(PROPERTIES_TEST_FILE, workingDirectory);
+	{
+		ConfigKey<unsigned int> valueKey("configKeyTest.value");
+		unsigned int valueBeforeReload = valueKey.getValue();
+
+		writePropertiesFile(workingDirectory, "configKeyTest.value = 5");
+		ConfigService::instance()->reloadProperties();
+
+		AssertHelper::assertUnsignedInt(valueBeforeReload, 2);
+		AssertHelper::assertUnsignedInt(valueKey.getValue(), 5);
+		AssertHelper::assertUnsignedInt(ConfigService::instance()->getUnsignedIntValue("configKeyTest.value"), 5);
+	}
+
+	ConfigService::instance()->unloadProperties(PROPERTIES_TEST_FILE, workingDirectory);
+	std::remove((workingDirectory + PROPERTIES_TEST_FILE).c_str());
+	AssertHelper::assertTrue(!ConfigService::instance()->isExist("configKeyTest.value"));
+}
+
+void ConfigKeyTest::keepValuesOnFailedReload()
+{
+	std::string workingDirectory = getTemporaryDirectory();
+	writePropertiesFile(workingDirectory, "configKeyTest.value = 2");
+	ConfigService::instance()->loadProperties(PROPERTIES_TEST_FILE, workingDirectory);
+	{
+		ConfigKey<unsigned int> valueKey("configKeyTest.value");
+
+		writePropertiesFile(workingDirectory, "configKeyTest.otherValue = 5");
+		try
+		{
+			ConfigService::instance()->reloadProperties();
+			AssertHelper::assertTrue(false, "Exception expected on missing property");
+		}catch(const std::invalid_argument &)
+		{
+			//expected
+		}
+
+		AssertHelper::assertUnsignedInt(valueKey.getValue(), 2);
+		AssertHelper::assertUnsignedInt(ConfigService::instance()->getUnsignedIntValue("configKeyTest.value"), 2);
+		AssertHelper::assertTrue(ConfigService::instance()->isExist("constraintSolver.biasFactor"));
+	}
+
+	ConfigService::instance()->unloadProperties(PROPERTIES_TEST_FILE, workingDirectory);
+	std::remove((workingDirectory + PROPERTIES_TEST_FILE).c_str());
+}
+
+std::string ConfigKeyTest::getTemporaryDirectory() const
+{
+	const char *temporaryDirectory = std::getenv("TMPDIR");
+	if(temporaryDirectory==nullptr)
+	{
+		temporaryDirectory = std::getenv("TEMP");
+	}
+	return (temporaryDirectory==nullptr) ? "/tmp/" : std::string(temporaryDirectory) + "/";
+}
+
+void ConfigKeyTest::writePropertiesFile(const std::string &workingDirectory, const std::string &content) const
+{
+	std::ofstream(workingDirectory + PROPERTIES_TEST_FILE) << content << std::endl;
+}
+
+CppUnit::Test *ConfigKeyTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("ConfigKeyTest");
+
+	suite->addTest(new CppUnit::TestCaller<ConfigKeyTest>("readValues", &ConfigKeyTest::readValues));
+	suite->addTest(new CppUnit::TestCaller<ConfigKeyTest>("readValuesAfterReload", &ConfigKeyTest::readValuesAfterReload));
+	suite->addTest(new CppUnit::TestCaller<ConfigKeyTest>("keepValuesOnFailedReload", &ConfigKeyTest::keepValuesOnFailedReload));
+
+	return suite;
+}
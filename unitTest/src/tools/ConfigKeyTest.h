@@ -0,0 +1,22 @@
+#ifndef URCHINENGINE_CONFIGKEYTEST_H
+#define URCHINENGINE_CONFIGKEYTEST_H
+
+#include <string>
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+
+class ConfigKeyTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void readValues();
+		void readValuesAfterReload();
+		void keepValuesOnFailedReload();
+
+	private:
+		std::string getTemporaryDirectory() const;
+		void writePropertiesFile(const std::string &, const std::string &) const;
+};
+
+#endif
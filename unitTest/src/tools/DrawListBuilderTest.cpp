@@ -0,0 +1,164 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/DrawListBuilderTest.h"
+using namespace urchin;
+
+void DrawListBuilderTest::emptyDrawList()
+{
+	DrawListBuilder drawListBuilder;
+
+	drawListBuilder.build();
+
+	AssertHelper::assertUnsignedInt(drawListBuilder.getDrawCommands().size(), 0);
+	AssertHelper::assertUnsignedInt(drawListBuilder.getInstancesTransform().size(), 0);
+}
+
+void DrawListBuilderTest::mergeIdenticalMeshes()
+{
+	DrawListBuilder drawListBuilder;
+	drawListBuilder.addItem(1, 10, 100, 0, buildTranslation(0.0, 0.0, 0.0), 0, true);
+	drawListBuilder.addItem(1, 10, 200, 0, buildTranslation(1.0, 0.0, 0.0), 1, true);
+	drawListBuilder.addItem(1, 10, 100, 0, buildTranslation(2.0, 0.0, 0.0), 2, true);
+	drawListBuilder.addItem(1, 10, 100, 0, buildTranslation(3.0, 0.0, 0.0), 3, true);
+
+	drawListBuilder.build();
+
+	const std::vector<DrawCommand> &drawCommands = drawListBuilder.getDrawCommands();
+	AssertHelper::assertUnsignedInt(drawCommands.size(), 6);
+	assertBindCommand(drawCommands[0], DrawCommand::BIND_SHADER, 1);
+	assertBindCommand(drawCommands[1], DrawCommand::BIND_MATERIAL, 10);
+	assertBindCommand(drawCommands[2], DrawCommand::BIND_MESH, 100);
+	assertDrawCommand(drawCommands[3], 0, 3);
+	assertBindCommand(drawCommands[4], DrawCommand::BIND_MESH, 200);
+	assertDrawCommand(drawCommands[5], 3, 1);
+	AssertHelper::assertUnsignedInt(drawCommands[4].itemId, 1);
+	AssertHelper::assertUnsignedInt(drawCommands[5].itemId, 1);
+
+	const std::vector<unsigned int> &instancesItemId = drawListBuilder.getInstancesItemId();
+	AssertHelper::assertUnsignedInt(instancesItemId[0], 0);
+	AssertHelper::assertUnsignedInt(instancesItemId[1], 2);
+	AssertHelper::assertUnsignedInt(instancesItemId[2], 3);
+	AssertHelper::assertUnsignedInt(instancesItemId[3], 1);
+	AssertHelper::assertFloatEquals(drawListBuilder.getInstancesTransform()[1](0, 3), 2.0);
+	AssertHelper::assertFloatEquals(drawListBuilder.getInstancesTransform()[3](0, 3), 1.0);
+	AssertHelper::assertUnsignedInt(drawListBuilder.getStatistics().nbDrawCommands, 2);
+}
+
+void DrawListBuilderTest::sortByMaterial()
+{
+	DrawListBuilder drawListBuilder;
+	drawListBuilder.addItem(1, 20, 100, 0, Matrix4<float>(), 0, true);
+	drawListBuilder.addItem(1, 10, 300, 0, Matrix4<float>(), 1, true);
+	drawListBuilder.addItem(1, 20, 200, 0, Matrix4<float>(), 2, true);
+	drawListBuilder.addItem(1, 10, 300, 0, Matrix4<float>(), 3, true);
+
+	drawListBuilder.build();
+
+	const std::vector<DrawCommand> &drawCommands = drawListBuilder.getDrawCommands();
+	AssertHelper::assertUnsignedInt(drawCommands.size(), 9);
+	assertBindCommand(drawCommands[0], DrawCommand::BIND_SHADER, 1);
+	assertBindCommand(drawCommands[1], DrawCommand::BIND_MATERIAL, 10);
+	assertBindCommand(drawCommands[2], DrawCommand::BIND_MESH, 300);
+	assertDrawCommand(drawCommands[3], 0, 2);
+	assertBindCommand(drawCommands[4], DrawCommand::BIND_MATERIAL, 20);
+	assertBindCommand(drawCommands[5], DrawCommand::BIND_MESH, 100);
+	assertDrawCommand(drawCommands[6], 2, 1);
+	assertBindCommand(drawCommands[7], DrawCommand::BIND_MESH, 200);
+	assertDrawCommand(drawCommands[8], 3, 1);
+	AssertHelper::assertUnsignedInt(drawListBuilder.getStatistics().nbStateChanges, 6);
+}
+
+void DrawListBuilderTest::notInstanceableItems()
+{
+	DrawListBuilder drawListBuilder;
+	drawListBuilder.addItem(1, 10, 100, 0, Matrix4<float>(), 0, false);
+	drawListBuilder.addItem(1, 10, 100, 0, Matrix4<float>(), 1, false);
+	drawListBuilder.addItem(1, 10, 100, 0, Matrix4<float>(), 2, true);
+
+	drawListBuilder.build();
+
+	const std::vector<DrawCommand> &drawCommands = drawListBuilder.getDrawCommands();
+	AssertHelper::assertUnsignedInt(drawCommands.size(), 6);
+	assertBindCommand(drawCommands[2], DrawCommand::BIND_MESH, 100);
+	assertDrawCommand(drawCommands[3], 0, 1);
+	assertDrawCommand(drawCommands[4], 1, 1);
+	assertDrawCommand(drawCommands[5], 2, 1);
+	AssertHelper::assertUnsignedInt(drawCommands[4].itemId, 1);
+}
+
+void DrawListBuilderTest::rebindMaterialOnShaderChange()
+{
+	DrawListBuilder drawListBuilder;
+	drawListBuilder.addItem(2, 10, 100, 0, Matrix4<float>(), 0, true);
+	drawListBuilder.addItem(1, 10, 100, 0, Matrix4<float>(), 1, true);
+
+	drawListBuilder.build();
+
+	const std::vector<DrawCommand> &drawCommands = drawListBuilder.getDrawCommands();
+	AssertHelper::assertUnsignedInt(drawCommands.size(), 8);
+	assertBindCommand(drawCommands[0], DrawCommand::BIND_SHADER, 1);
+	assertDrawCommand(drawCommands[3], 0, 1);
+	assertBindCommand(drawCommands[4], DrawCommand::BIND_SHADER, 2);
+	assertBindCommand(drawCommands[5], DrawCommand::BIND_MATERIAL, 10);
+	assertBindCommand(drawCommands[6], DrawCommand::BIND_MESH, 100);
+	assertDrawCommand(drawCommands[7], 1, 1);
+	AssertHelper::assertUnsignedInt(drawCommands[7].itemId, 0);
+}
+
+void DrawListBuilderTest::drawMeshVariantsSeparately()
+{
+	DrawListBuilder drawListBuilder;
+	drawListBuilder.addItem(1, 10, 100, 1, Matrix4<float>(), 0, true);
+	drawListBuilder.addItem(1, 10, 100, 0, Matrix4<float>(), 1, true);
+	drawListBuilder.addItem(1, 10, 101, 0, Matrix4<float>(), 2, true);
+	drawListBuilder.addItem(1, 10, 100, 1, Matrix4<float>(), 3, true);
+
+	drawListBuilder.build();
+
+	const std::vector<DrawCommand> &drawCommands = drawListBuilder.getDrawCommands();
+	AssertHelper::assertUnsignedInt(drawCommands.size(), 7);
+	assertBindCommand(drawCommands[2], DrawCommand::BIND_MESH, 100);
+	assertDrawCommand(drawCommands[3], 0, 1);
+	AssertHelper::assertUnsignedInt(drawCommands[3].itemId, 1);
+	assertDrawCommand(drawCommands[4], 1, 2); //mesh not bound again for the second variant
+	AssertHelper::assertUnsignedInt(drawCommands[4].itemId, 0);
+	assertBindCommand(drawCommands[5], DrawCommand::BIND_MESH, 101);
+	assertDrawCommand(drawCommands[6], 3, 1);
+}
+
+void DrawListBuilderTest::assertBindCommand(const DrawCommand &drawCommand, DrawCommand::CommandType type, std::size_t key)
+{
+	AssertHelper::assertInt(drawCommand.type, type);
+	AssertHelper::assertUnsignedInt(drawCommand.key, key);
+}
+
+void DrawListBuilderTest::assertDrawCommand(const DrawCommand &drawCommand, unsigned int firstInstance, unsigned int instancesCount)
+{
+	AssertHelper::assertInt(drawCommand.type, DrawCommand::DRAW_INSTANCES);
+	AssertHelper::assertUnsignedInt(drawCommand.firstInstance, firstInstance);
+	AssertHelper::assertUnsignedInt(drawCommand.instancesCount, instancesCount);
+}
+
+Matrix4<float> DrawListBuilderTest::buildTranslation(float x, float y, float z)
+{
+	Matrix4<float> translation;
+	translation.buildTranslation(x, y, z);
+	return translation;
+}
+
+CppUnit::Test *DrawListBuilderTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("DrawListBuilderTest");
+
+	suite->addTest(new CppUnit::TestCaller<DrawListBuilderTest>("emptyDrawList", &DrawListBuilderTest::emptyDrawList));
+	suite->addTest(new CppUnit::TestCaller<DrawListBuilderTest>("mergeIdenticalMeshes", &DrawListBuilderTest::mergeIdenticalMeshes));
+	suite->addTest(new CppUnit::TestCaller<DrawListBuilderTest>("sortByMaterial", &DrawListBuilderTest::sortByMaterial));
+	suite->addTest(new CppUnit::TestCaller<DrawListBuilderTest>("notInstanceableItems", &DrawListBuilderTest::notInstanceableItems));
+	suite->addTest(new CppUnit::TestCaller<DrawListBuilderTest>("rebindMaterialOnShaderChange", &DrawListBuilderTest::rebindMaterialOnShaderChange));
+	suite->addTest(new CppUnit::TestCaller<DrawListBuilderTest>("drawMeshVariantsSeparately", &DrawListBuilderTest::drawMeshVariantsSeparately));
+
+	return suite;
+}
@@ -0,0 +1,26 @@
+#ifndef URCHINENGINE_DRAWLISTBUILDERTEST_H
+#define URCHINENGINE_DRAWLISTBUILDERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class DrawListBuilderTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void emptyDrawList();
+		void mergeIdenticalMeshes();
+		void sortByMaterial();
+		void notInstanceableItems();
+		void rebindMaterialOnShaderChange();
+		void drawMeshVariantsSeparately();
+
+	private:
+		urchin::Matrix4<float> buildTranslation(float, float, float);
+		void assertBindCommand(const urchin::DrawCommand &, urchin::DrawCommand::CommandType, std::size_t);
+		void assertDrawCommand(const urchin::DrawCommand &, unsigned int, unsigned int);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/GlyphRunCacheTest.h"
+using namespace urchin;
+
+void GlyphRunCacheTest::layoutText()
+{
+	GlyphRunCache glyphRunCache(buildFontMetrics(), 16);
+
+	std::shared_ptr<const GlyphRun> glyphRun = glyphRunCache.getGlyphRun("ag");
+
+	AssertHelper::assertUnsignedInt(glyphRun->quadsCount, 2);
+	AssertHelper::assertUnsignedInt(glyphRun->width, 22);
+	AssertHelper::assertUnsignedInt(glyphRun->height, 12);
+	AssertHelper::assertPoint2IntEquals(glyphRun->positions[0], Point2<int>(0, 0));
+	AssertHelper::assertPoint2IntEquals(glyphRun->positions[2], Point2<int>(10, 12));
+	AssertHelper::assertPoint2IntEquals(glyphRun->positions[4], Point2<int>(12, 3)); //'g' shifted below the line
+	AssertHelper::assertPoint2FloatEquals(glyphRun->texCoords[0], Point2<float>(1.0f / 16.0f, 6.0f / 16.0f)); //'a' is letter 97 in atlas
+	AssertHelper::assertPoint2FloatEquals(glyphRun->texCoords[2], Point2<float>(1.0f / 16.0f + 10.0f / 256.0f, 6.0f / 16.0f + 12.0f / 256.0f));
+}
+
+void GlyphRunCacheTest::layoutMultiLinesText()
+{
+	GlyphRunCache glyphRunCache(buildFontMetrics(), 16);
+
+	std::shared_ptr<const GlyphRun> glyphRun = glyphRunCache.getGlyphRun("a\nb");
+
+	AssertHelper::assertUnsignedInt(glyphRun->quadsCount, 2);
+	AssertHelper::assertUnsignedInt(glyphRun->height, 12 + 20 + 12);
+	AssertHelper::assertPoint2IntEquals(glyphRun->positions[4], Point2<int>(0, 20));
+}
+
+void GlyphRunCacheTest::cutLongLines()
+{
+	GlyphRunCache glyphRunCache(buildFontMetrics(), 16);
+
+	std::shared_ptr<const GlyphRun> glyphRun = glyphRunCache.getGlyphRun("aa aa", 30);
+
+	AssertHelper::assertUnsignedInt(glyphRun->quadsCount, 4); //space replaced by a line break
+	AssertHelper::assertUnsignedInt(glyphRun->width, 22);
+	AssertHelper::assertPoint2IntEquals(glyphRun->positions[8], Point2<int>(0, 20));
+}
+
+void GlyphRunCacheTest::shareCachedRuns()
+{
+	GlyphRunCache glyphRunCache(buildFontMetrics(), 16);
+
+	std::shared_ptr<const GlyphRun> glyphRun1 = glyphRunCache.getGlyphRun("fps: 60");
+	std::shared_ptr<const GlyphRun> glyphRun2 = glyphRunCache.getGlyphRun("fps: 60");
+	std::shared_ptr<const GlyphRun> cutGlyphRun = glyphRunCache.getGlyphRun("fps: 60", 30);
+
+	AssertHelper::assertTrue(glyphRun1==glyphRun2);
+	AssertHelper::assertTrue(glyphRun1!=cutGlyphRun);
+	AssertHelper::assertUnsignedInt(glyphRunCache.getLayoutsCount(), 2);
+}
+
+void GlyphRunCacheTest::evictLeastRecentlyUsedRun()
+{
+	GlyphRunCache glyphRunCache(buildFontMetrics(), 2);
+
+	std::shared_ptr<const GlyphRun> glyphRunB = glyphRunCache.getGlyphRun("b");
+	glyphRunCache.getGlyphRun("a");
+	glyphRunCache.getGlyphRun("b");
+	glyphRunCache.getGlyphRun("c"); //evict "a"
+	AssertHelper::assertUnsignedInt(glyphRunCache.getCachedRunsCount(), 2);
+	AssertHelper::assertUnsignedInt(glyphRunCache.getLayoutsCount(), 3);
+
+	AssertHelper::assertTrue(glyphRunCache.getGlyphRun("b")==glyphRunB);
+	AssertHelper::assertUnsignedInt(glyphRunCache.getLayoutsCount(), 3);
+	glyphRunCache.getGlyphRun("a");
+	AssertHelper::assertUnsignedInt(glyphRunCache.getLayoutsCount(), 4);
+}
+
+FontMetrics GlyphRunCacheTest::buildFontMetrics()
+{
+	FontMetrics fontMetrics;
+	fontMetrics.glyphs.resize(256, {10, 12, 0});
+	fontMetrics.glyphs['g'].shift = -3;
+	fontMetrics.spaceBetweenLetters = 2;
+	fontMetrics.spaceBetweenLines = 20;
+	fontMetrics.height = 12;
+	fontMetrics.atlasDimension = 256;
+	return fontMetrics;
+}
+
+CppUnit::Test *GlyphRunCacheTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("GlyphRunCacheTest");
+
+	suite->addTest(new CppUnit::TestCaller<GlyphRunCacheTest>("layoutText", &GlyphRunCacheTest::layoutText));
+	suite->addTest(new CppUnit::TestCaller<GlyphRunCacheTest>("layoutMultiLinesText", &GlyphRunCacheTest::layoutMultiLinesText));
+	suite->addTest(new CppUnit::TestCaller<GlyphRunCacheTest>("cutLongLines", &GlyphRunCacheTest::cutLongLines));
+	suite->addTest(new CppUnit::TestCaller<GlyphRunCacheTest>("shareCachedRuns", &GlyphRunCacheTest::shareCachedRuns));
+	suite->addTest(new CppUnit::TestCaller<GlyphRunCacheTest>("evictLeastRecentlyUsedRun", &GlyphRunCacheTest::evictLeastRecentlyUsedRun));
+
+	return suite;
+}
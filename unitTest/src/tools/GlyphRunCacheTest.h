@@ -0,0 +1,23 @@
+#ifndef URCHINENGINE_GLYPHRUNCACHETEST_H
+#define URCHINENGINE_GLYPHRUNCACHETEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class GlyphRunCacheTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void layoutText();
+		void layoutMultiLinesText();
+		void cutLongLines();
+		void shareCachedRuns();
+		void evictLeastRecentlyUsedRun();
+
+	private:
+		urchin::FontMetrics buildFontMetrics();
+};
+
+#endif
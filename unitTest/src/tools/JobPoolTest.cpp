@@ -0,0 +1,90 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <stdexcept>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/JobPoolTest.h"
+using namespace urchin;
+
+void JobPoolTest::executeAllJobs()
+{
+	JobPool jobPool(3);
+	std::vector<unsigned int> jobExecutions(1000, 0);
+
+	jobPool.run(static_cast<unsigned int>(jobExecutions.size()), [&](unsigned int jobIndex) {
+		jobExecutions[jobIndex]++;
+	});
+
+	for(unsigned int jobExecution : jobExecutions)
+	{
+		AssertHelper::assertUnsignedInt(jobExecution, 1);
+	}
+}
+
+void JobPoolTest::executeSeveralBatches()
+{
+	JobPool jobPool(2);
+	std::atomic<unsigned int> sum(0);
+
+	for(unsigned int batch=0; batch<50; ++batch)
+	{
+		jobPool.run(10, [&](unsigned int jobIndex) {
+			sum += jobIndex;
+		});
+	}
+
+	AssertHelper::assertUnsignedInt(sum, 50 * 45);
+}
+
+void JobPoolTest::rethrowJobException()
+{
+	JobPool jobPool(2);
+	std::atomic<unsigned int> executedJobs(0);
+
+	try
+	{
+		jobPool.run(20, [&](unsigned int jobIndex) {
+			executedJobs++;
+			if(jobIndex==7)
+			{
+				throw std::runtime_error("job failure");
+			}
+		});
+		AssertHelper::assertTrue(false, "Exception expected");
+	}catch(const std::runtime_error &e)
+	{
+		AssertHelper::assertTrue(std::string(e.what())=="job failure");
+	}
+
+	AssertHelper::assertUnsignedInt(executedJobs, 20);
+}
+
+void JobPoolTest::executeNestedJobs()
+{
+	JobPool jobPool(2);
+	std::vector<std::atomic<unsigned int>> jobExecutions(10 * 10);
+
+	jobPool.run(10, [&](unsigned int jobIndex) {
+		jobPool.run(10, [&](unsigned int nestedJobIndex) { //pool is running: nested jobs executed by the calling thread
+			jobExecutions[jobIndex * 10 + nestedJobIndex]++;
+		});
+	});
+
+	for(const auto &jobExecution : jobExecutions)
+	{
+		AssertHelper::assertUnsignedInt(jobExecution, 1);
+	}
+}
+
+CppUnit::Test *JobPoolTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("JobPoolTest");
+
+	suite->addTest(new CppUnit::TestCaller<JobPoolTest>("executeAllJobs", &JobPoolTest::executeAllJobs));
+	suite->addTest(new CppUnit::TestCaller<JobPoolTest>("executeSeveralBatches", &JobPoolTest::executeSeveralBatches));
+	suite->addTest(new CppUnit::TestCaller<JobPoolTest>("rethrowJobException", &JobPoolTest::rethrowJobException));
+	suite->addTest(new CppUnit::TestCaller<JobPoolTest>("executeNestedJobs", &JobPoolTest::executeNestedJobs));
+
+	return suite;
+}
@@ -0,0 +1,18 @@
+#ifndef URCHINENGINE_JOBPOOLTEST_H
+#define URCHINENGINE_JOBPOOLTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+
+class JobPoolTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void executeAllJobs();
+		void executeSeveralBatches();
+		void rethrowJobException();
+		void executeNestedJobs();
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/LightClusterBuilderTest.h"
+using namespace urchin;
+
+void LightClusterBuilderTest::lightInOneCluster()
+{
+	LightClusterBuilder lightClusterBuilder = buildLightClusterBuilder();
+	std::vector<Sphere<float>> lights = {Sphere<float>(0.1f, Point3<float>(1.25f, -1.25f, -5.0f))};
+
+	lightClusterBuilder.buildClusters(lights);
+
+	const std::vector<LightCluster> &clusters = lightClusterBuilder.getClusters();
+	AssertHelper::assertUnsignedInt(clusters.size(), 4*4*4);
+	AssertHelper::assertUnsignedInt(clusters[22].count, 1); //cluster x=2, y=1, z=1
+	AssertHelper::assertUnsignedInt(lightClusterBuilder.getLightIndices()[clusters[22].offset], 0);
+	AssertHelper::assertUnsignedInt(lightClusterBuilder.getStatistics().nbLightIndices, 1);
+}
+
+void LightClusterBuilderTest::lightInSeveralClusters()
+{
+	LightClusterBuilder lightClusterBuilder = buildLightClusterBuilder();
+	std::vector<Sphere<float>> lights = {
+			Sphere<float>(0.1f, Point3<float>(1.25f, -1.25f, -5.0f)),
+			Sphere<float>(1.0f, Point3<float>(0.0f, 0.0f, -5.0f))};
+
+	lightClusterBuilder.buildClusters(lights);
+
+	const std::vector<LightCluster> &clusters = lightClusterBuilder.getClusters();
+	const std::vector<unsigned int> &lightIndices = lightClusterBuilder.getLightIndices();
+	AssertHelper::assertUnsignedInt(clusters[21].count, 1); //cluster x=1, y=1, z=1
+	AssertHelper::assertUnsignedInt(lightIndices[clusters[21].offset], 1);
+	AssertHelper::assertUnsignedInt(clusters[22].count, 2); //cluster x=2, y=1, z=1
+	AssertHelper::assertUnsignedInt(lightIndices[clusters[22].offset], 0);
+	AssertHelper::assertUnsignedInt(lightIndices[clusters[22].offset + 1], 1);
+	AssertHelper::assertUnsignedInt(clusters[25].count, 1); //cluster x=1, y=2, z=1
+	AssertHelper::assertUnsignedInt(clusters[26].count, 1); //cluster x=2, y=2, z=1
+	AssertHelper::assertUnsignedInt(lightClusterBuilder.getStatistics().nbLightIndices, 5);
+	AssertHelper::assertUnsignedInt(lightClusterBuilder.getStatistics().maxClusterLights, 2);
+}
+
+void LightClusterBuilderTest::lightOutsideClusters()
+{
+	LightClusterBuilder lightClusterBuilder = buildLightClusterBuilder();
+	std::vector<Sphere<float>> lights = {
+			Sphere<float>(1.0f, Point3<float>(0.0f, 0.0f, 5.0f)), //behind camera
+			Sphere<float>(1.0f, Point3<float>(0.0f, 0.0f, -150.0f)), //beyond far plane
+			Sphere<float>(1.0f, Point3<float>(20.0f, 0.0f, -5.0f))}; //outside view frustum
+
+	lightClusterBuilder.buildClusters(lights);
+
+	AssertHelper::assertUnsignedInt(lightClusterBuilder.getLightIndices().size(), 0);
+}
+
+void LightClusterBuilderTest::manyLightsInOneCluster()
+{
+	LightClusterBuilder lightClusterBuilder = buildLightClusterBuilder();
+	std::vector<Sphere<float>> lights(200, Sphere<float>(0.1f, Point3<float>(1.25f, -1.25f, -5.0f)));
+
+	lightClusterBuilder.buildClusters(lights);
+
+	const std::vector<LightCluster> &clusters = lightClusterBuilder.getClusters();
+	AssertHelper::assertUnsignedInt(clusters[22].count, 200);
+	for(unsigned int i=0; i<200; ++i)
+	{
+		AssertHelper::assertUnsignedInt(lightClusterBuilder.getLightIndices()[clusters[22].offset + i], i);
+	}
+	AssertHelper::assertUnsignedInt(lightClusterBuilder.getStatistics().nbLightIndices, 200);
+}
+
+/**
+ * @return Builder of 4x4x4 clusters for a projection with a field of view of 90 degrees, a near plane at 1 and a far plane at 100
+ */
+LightClusterBuilder LightClusterBuilderTest::buildLightClusterBuilder()
+{
+	Matrix4<float> projectionMatrix(
+			1.0f, 0.0f, 0.0f, 0.0f,
+			0.0f, 1.0f, 0.0f, 0.0f,
+			0.0f, 0.0f, -101.0f/99.0f, -200.0f/99.0f,
+			0.0f, 0.0f, -1.0f, 0.0f);
+
+	LightClusterBuilder lightClusterBuilder(4, 4, 4);
+	lightClusterBuilder.onProjectionUpdate(projectionMatrix, 1.0f, 100.0f);
+	return lightClusterBuilder;
+}
+
+CppUnit::Test *LightClusterBuilderTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("LightClusterBuilderTest");
+
+	suite->addTest(new CppUnit::TestCaller<LightClusterBuilderTest>("lightInOneCluster", &LightClusterBuilderTest::lightInOneCluster));
+	suite->addTest(new CppUnit::TestCaller<LightClusterBuilderTest>("lightInSeveralClusters", &LightClusterBuilderTest::lightInSeveralClusters));
+	suite->addTest(new CppUnit::TestCaller<LightClusterBuilderTest>("lightOutsideClusters", &LightClusterBuilderTest::lightOutsideClusters));
+	suite->addTest(new CppUnit::TestCaller<LightClusterBuilderTest>("manyLightsInOneCluster", &LightClusterBuilderTest::manyLightsInOneCluster));
+
+	return suite;
+}
@@ -0,0 +1,22 @@
+#ifndef URCHINENGINE_LIGHTCLUSTERBUILDERTEST_H
+#define URCHINENGINE_LIGHTCLUSTERBUILDERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class LightClusterBuilderTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void lightInOneCluster();
+		void lightInSeveralClusters();
+		void lightOutsideClusters();
+		void manyLightsInOneCluster();
+
+	private:
+		urchin::LightClusterBuilder buildLightClusterBuilder();
+};
+
+#endif
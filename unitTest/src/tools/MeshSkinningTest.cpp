@@ -0,0 +1,155 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/MeshSkinningTest.h"
+using namespace urchin;
+
+void MeshSkinningTest::groupVerticesByWeightsCount()
+{
+	std::vector<Weight> weights;
+	std::vector<std::pair<unsigned int, unsigned int>> verticesWeights = buildVerticesWeights(weights);
+
+	std::vector<WeightGroup> weightGroups = MeshSkinning::buildWeightGroups(verticesWeights, weights.data());
+
+	AssertHelper::assertUnsignedInt(weightGroups.size(), 4);
+	AssertHelper::assertUnsignedInt(weightGroups[1].weightCount, 2);
+	AssertHelper::assertUnsignedInt(weightGroups[1].vertexIndices.size(), 2);
+	AssertHelper::assertUnsignedInt(weightGroups[1].vertexIndices[0], 1);
+	AssertHelper::assertUnsignedInt(weightGroups[1].vertexIndices[1], 5);
+	AssertHelper::assertUnsignedInt(weightGroups[1].bones[1 * 2 + 1], 2); //second weight of vertex 5
+	AssertHelper::assertFloatEquals(weightGroups[1].biases[1 * 2 + 1], 0.25f);
+	AssertHelper::assertFloatEquals(weightGroups[1].biasedPosY[1 * 2 + 1], 0.25f * 3.0f);
+}
+
+void MeshSkinningTest::skinVerticesAsQuaternionSkinning()
+{
+	std::vector<TestBone> skeleton = buildSkeleton();
+
+	std::vector<Point3<float>> vertices = skinWithWeightGroups(skeleton);
+	std::vector<Point3<float>> expectedVertices = skinWithQuaternions(skeleton);
+
+	AssertHelper::assertUnsignedInt(vertices.size(), expectedVertices.size());
+	for(std::size_t i=0; i<vertices.size(); ++i)
+	{
+		AssertHelper::assertPoint3FloatEquals(vertices[i], expectedVertices[i], 0.0001);
+	}
+}
+
+void MeshSkinningTest::skinNormalsAsQuaternionSkinning()
+{
+	std::vector<TestBone> skeleton = buildSkeleton();
+
+	std::vector<Vector3<float>> normals = computeNormals(skinWithWeightGroups(skeleton));
+	std::vector<Vector3<float>> expectedNormals = computeNormals(skinWithQuaternions(skeleton));
+
+	for(std::size_t i=0; i<normals.size(); ++i)
+	{
+		AssertHelper::assertVector3FloatEquals(normals[i], expectedNormals[i], 0.0001);
+	}
+}
+
+std::vector<MeshSkinningTest::TestBone> MeshSkinningTest::buildSkeleton()
+{
+	std::vector<TestBone> skeleton;
+	skeleton.push_back({Point3<float>(0.0f, 0.0f, 0.0f), Quaternion<float>()});
+	skeleton.push_back({Point3<float>(1.0f, 2.0f, -1.0f), Quaternion<float>(Vector3<float>(0.0f, 1.0f, 0.0f), 0.7f)});
+	skeleton.push_back({Point3<float>(-2.0f, 0.5f, 3.0f), Quaternion<float>(Vector3<float>(1.0f, 1.0f, 0.0f).normalize(), -1.2f)});
+	skeleton.push_back({Point3<float>(0.5f, -1.0f, 0.0f), Quaternion<float>(Vector3<float>(0.0f, 0.0f, 1.0f), 2.5f)});
+	return skeleton;
+}
+
+/**
+ * @param weights [out] Weights of the vertices
+ * @return Index of the first weight and number of weights of each vertex (six vertices having between one and four weights)
+ */
+std::vector<std::pair<unsigned int, unsigned int>> MeshSkinningTest::buildVerticesWeights(std::vector<Weight> &weights)
+{
+	weights = {
+		{0, 1.0f, Point3<float>(0.0f, 0.0f, 0.0f)}, //vertex 0
+		{1, 0.6f, Point3<float>(1.0f, 0.0f, 0.0f)}, {2, 0.4f, Point3<float>(0.5f, -1.0f, 2.0f)}, //vertex 1
+		{1, 0.5f, Point3<float>(0.0f, 1.0f, 0.0f)}, {3, 0.3f, Point3<float>(1.0f, 1.0f, 1.0f)}, {0, 0.2f, Point3<float>(0.0f, 1.0f, 0.5f)}, //vertex 2
+		{0, 0.1f, Point3<float>(1.0f, 1.0f, 0.0f)}, {1, 0.2f, Point3<float>(2.0f, 0.0f, -1.0f)}, {2, 0.3f, Point3<float>(0.0f, 2.0f, 1.0f)}, {3, 0.4f, Point3<float>(1.5f, 0.5f, 0.0f)}, //vertex 3
+		{3, 1.0f, Point3<float>(2.0f, 0.0f, 1.0f)}, //vertex 4
+		{0, 0.75f, Point3<float>(2.0f, 1.0f, 0.0f)}, {2, 0.25f, Point3<float>(-1.0f, 3.0f, 0.0f)} //vertex 5
+	};
+
+	return {{0, 1}, {1, 2}, {3, 3}, {6, 4}, {10, 1}, {11, 2}};
+}
+
+std::vector<Point3<float>> MeshSkinningTest::skinWithWeightGroups(const std::vector<TestBone> &skeleton)
+{
+	std::vector<Weight> weights;
+	std::vector<std::pair<unsigned int, unsigned int>> verticesWeights = buildVerticesWeights(weights);
+	std::vector<WeightGroup> weightGroups = MeshSkinning::buildWeightGroups(verticesWeights, weights.data());
+
+	std::vector<Matrix4<float>> boneMatrices;
+	for(const auto &bone : skeleton)
+	{
+		boneMatrices.push_back(MeshSkinning::computeBoneMatrix(bone.pos, bone.orient));
+	}
+
+	std::vector<Point3<float>> vertices(verticesWeights.size());
+	MeshSkinning::computeVertices(weightGroups, boneMatrices, vertices.data());
+	return vertices;
+}
+
+/**
+ * Skinning algorithm used before the weights were regrouped in structure of arrays
+ */
+std::vector<Point3<float>> MeshSkinningTest::skinWithQuaternions(const std::vector<TestBone> &skeleton)
+{
+	std::vector<Weight> weights;
+	std::vector<std::pair<unsigned int, unsigned int>> verticesWeights = buildVerticesWeights(weights);
+
+	std::vector<Point3<float>> vertices;
+	for(const auto &vertexWeights : verticesWeights)
+	{
+		Point3<float> vertex(0.0f, 0.0f, 0.0f);
+		for(unsigned int j=0; j<vertexWeights.second; ++j)
+		{
+			const Weight &weight = weights[vertexWeights.first + j];
+			const TestBone &bone = skeleton[weight.bone];
+
+			Point3<float> weightedPosition = bone.orient.rotatePoint(weight.pos);
+			vertex += (bone.pos + weightedPosition) * weight.bias;
+		}
+		vertices.push_back(vertex);
+	}
+	return vertices;
+}
+
+std::vector<Vector3<float>> MeshSkinningTest::computeNormals(const std::vector<Point3<float>> &vertices)
+{
+	const unsigned int triangles[4][3] = {{0, 1, 2}, {1, 3, 2}, {1, 4, 3}, {3, 5, 2}};
+
+	std::vector<Vector3<float>> normals(vertices.size(), Vector3<float>(0.0f, 0.0f, 0.0f));
+	for(const auto &triangle : triangles)
+	{
+		Vector3<float> firstEdge = vertices[triangle[0]].vector(vertices[triangle[1]]);
+		Vector3<float> secondEdge = vertices[triangle[0]].vector(vertices[triangle[2]]);
+		Vector3<float> triangleNormal = firstEdge.crossProduct(secondEdge).normalize();
+		for(unsigned int vertexIndex : triangle)
+		{
+			normals[vertexIndex] += triangleNormal;
+		}
+	}
+
+	for(auto &normal : normals)
+	{
+		normal = normal.normalize();
+	}
+	return normals;
+}
+
+CppUnit::Test *MeshSkinningTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("MeshSkinningTest");
+
+	suite->addTest(new CppUnit::TestCaller<MeshSkinningTest>("groupVerticesByWeightsCount", &MeshSkinningTest::groupVerticesByWeightsCount));
+	suite->addTest(new CppUnit::TestCaller<MeshSkinningTest>("skinVerticesAsQuaternionSkinning", &MeshSkinningTest::skinVerticesAsQuaternionSkinning));
+	suite->addTest(new CppUnit::TestCaller<MeshSkinningTest>("skinNormalsAsQuaternionSkinning", &MeshSkinningTest::skinNormalsAsQuaternionSkinning));
+
+	return suite;
+}
@@ -0,0 +1,32 @@
+#ifndef URCHINENGINE_MESHSKINNINGTEST_H
+#define URCHINENGINE_MESHSKINNINGTEST_H
+
+#include <vector>
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class MeshSkinningTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void groupVerticesByWeightsCount();
+		void skinVerticesAsQuaternionSkinning();
+		void skinNormalsAsQuaternionSkinning();
+
+	private:
+		struct TestBone
+		{
+			urchin::Point3<float> pos;
+			urchin::Quaternion<float> orient;
+		};
+
+		std::vector<TestBone> buildSkeleton();
+		std::vector<std::pair<unsigned int, unsigned int>> buildVerticesWeights(std::vector<urchin::Weight> &);
+		std::vector<urchin::Point3<float>> skinWithWeightGroups(const std::vector<TestBone> &);
+		std::vector<urchin::Point3<float>> skinWithQuaternions(const std::vector<TestBone> &);
+		std::vector<urchin::Vector3<float>> computeNormals(const std::vector<urchin::Point3<float>> &);
+};
+
+#endif
@@ -0,0 +1,127 @@
+#include <typeindex>
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/ResourceCacheTest.h"
+using namespace urchin;
+
+void ResourceCacheTest::evictLeastRecentlyUsedResource()
+{
+	TestResource resource1(100), resource2(100), resource3(100);
+	std::type_index type(typeid(TestResource));
+	std::vector<TestResource *> removedResources;
+	ResourceCache<TestResource *> resourceCache;
+	resourceCache.setBudget(type, 250, removedResources);
+	resourceCache.add("r1", &resource1, type, removedResources);
+	resourceCache.add("r2", &resource2, type, removedResources);
+	resourceCache.add("r3", &resource3, type, removedResources);
+
+	resourceCache.release("r1", &resource1, removedResources);
+	resourceCache.release("r2", &resource2, removedResources);
+	TestResource *acquiredResource = resourceCache.acquire("r1");
+	resourceCache.release("r1", &resource1, removedResources); //r1 becomes the most recently used resource
+	resourceCache.release("r3", &resource3, removedResources);
+
+	AssertHelper::assertTrue(acquiredResource==&resource1);
+	AssertHelper::assertUnsignedInt(removedResources.size(), 1);
+	AssertHelper::assertTrue(removedResources[0]==&resource2);
+	AssertHelper::assertTrue(resourceCache.acquire("r2")==nullptr);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).hits, 1);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).misses, 3);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).evictions, 1);
+}
+
+void ResourceCacheTest::enforceBudget()
+{
+	TestResource resource1(100), resource2(60), resource3(120);
+	std::type_index type(typeid(TestResource));
+	std::vector<TestResource *> removedResources;
+	ResourceCache<TestResource *> resourceCache;
+	resourceCache.setBudget(type, 200, removedResources);
+	resourceCache.add("r1", &resource1, type, removedResources);
+	resourceCache.add("r2", &resource2, type, removedResources);
+	resourceCache.add("r3", &resource3, type, removedResources);
+
+	resourceCache.release("r1", &resource1, removedResources);
+	resourceCache.release("r2", &resource2, removedResources);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).cachedBytes, 160);
+	resourceCache.release("r3", &resource3, removedResources);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).cachedBytes, 180);
+	AssertHelper::assertUnsignedInt(removedResources.size(), 1);
+
+	resourceCache.setBudget(type, 150, removedResources);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).cachedBytes, 120);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics(type).residentBytes, 120);
+	AssertHelper::assertUnsignedInt(removedResources.size(), 2);
+	AssertHelper::assertTrue(removedResources[1]==&resource2);
+}
+
+void ResourceCacheTest::neverEvictReferencedResources()
+{
+	TestResource resource1(100), resource2(100), resource3(100);
+	std::type_index type(typeid(TestResource));
+	std::vector<TestResource *> removedResources;
+	ResourceCache<TestResource *> resourceCache;
+	resourceCache.setBudget(type, 50, removedResources);
+	resourceCache.add("r1", &resource1, type, removedResources);
+	resourceCache.add("r2", &resource2, type, removedResources);
+	resourceCache.add("r3", &resource3, type, removedResources);
+
+	resourceCache.release("r1", &resource1, removedResources);
+	resourceCache.setBudget(type, 0, removedResources);
+	resourceCache.purge(removedResources);
+
+	AssertHelper::assertUnsignedInt(removedResources.size(), 1);
+	AssertHelper::assertTrue(removedResources[0]==&resource1);
+	AssertHelper::assertUnsignedInt(resourceCache.getResourceNames().size(), 2);
+	AssertHelper::assertUnsignedInt(resourceCache.getStatistics().residentBytes, 200);
+	AssertHelper::assertTrue(resourceCache.acquire("r2")==&resource2);
+	AssertHelper::assertTrue(resourceCache.acquire("r3")==&resource3);
+}
+
+void ResourceCacheTest::destroyReplacedResource()
+{
+	TestResource resource1(100), resource1Bis(100), resource2(100), resource2Bis(100);
+	std::type_index type(typeid(TestResource));
+	std::vector<TestResource *> removedResources;
+	ResourceCache<TestResource *> resourceCache;
+	resourceCache.setBudget(type, 1000, removedResources);
+	resourceCache.add("r1", &resource1, type, removedResources);
+	resourceCache.add("r2", &resource2, type, removedResources);
+
+	resourceCache.release("r1", &resource1, removedResources);
+	resourceCache.add("r1", &resource1Bis, type, removedResources); //cached resource replaced
+	resourceCache.add("r2", &resource2Bis, type, removedResources); //referenced resource replaced
+	AssertHelper::assertUnsignedInt(removedResources.size(), 1);
+	AssertHelper::assertTrue(removedResources[0]==&resource1);
+
+	resourceCache.release("r2", &resource2, removedResources);
+	AssertHelper::assertUnsignedInt(removedResources.size(), 2);
+	AssertHelper::assertTrue(removedResources[1]==&resource2);
+	AssertHelper::assertTrue(resourceCache.acquire("r2")==&resource2Bis);
+}
+
+ResourceCacheTest::TestResource::TestResource(unsigned int memorySize) :
+		memorySize(memorySize)
+{
+
+}
+
+unsigned int ResourceCacheTest::TestResource::getMemorySize() const
+{
+	return memorySize;
+}
+
+CppUnit::Test *ResourceCacheTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("ResourceCacheTest");
+
+	suite->addTest(new CppUnit::TestCaller<ResourceCacheTest>("evictLeastRecentlyUsedResource", &ResourceCacheTest::evictLeastRecentlyUsedResource));
+	suite->addTest(new CppUnit::TestCaller<ResourceCacheTest>("enforceBudget", &ResourceCacheTest::enforceBudget));
+	suite->addTest(new CppUnit::TestCaller<ResourceCacheTest>("neverEvictReferencedResources", &ResourceCacheTest::neverEvictReferencedResources));
+	suite->addTest(new CppUnit::TestCaller<ResourceCacheTest>("destroyReplacedResource", &ResourceCacheTest::destroyReplacedResource));
+
+	return suite;
+}
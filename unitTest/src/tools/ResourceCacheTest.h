@@ -0,0 +1,28 @@
+#ifndef URCHINENGINE_RESOURCECACHETEST_H
+#define URCHINENGINE_RESOURCECACHETEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class ResourceCacheTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void evictLeastRecentlyUsedResource();
+		void enforceBudget();
+		void neverEvictReferencedResources();
+		void destroyReplacedResource();
+
+	private:
+		struct TestResource
+		{
+			explicit TestResource(unsigned int);
+			unsigned int getMemorySize() const;
+
+			unsigned int memorySize;
+		};
+};
+
+#endif
@@ -0,0 +1,92 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/StreamingPatchGridTest.h"
+using namespace urchin;
+
+void StreamingPatchGridTest::slotsBoundedByDistance()
+{
+	StreamingPatchGrid hugeGrid(Point2<float>(0.0, 0.0), Point2<float>(10.0, 10.0), 1000, 1000, 25.0);
+	StreamingPatchGrid smallGrid(Point2<float>(0.0, 0.0), Point2<float>(10.0, 10.0), 3, 3, 25.0);
+
+	AssertHelper::assertUnsignedInt(hugeGrid.getSlotsCount(), 7 * 7);
+	AssertHelper::assertUnsignedInt(smallGrid.getSlotsCount(), 3 * 3);
+}
+
+void StreamingPatchGridTest::nearestPatchesFirst()
+{
+	StreamingPatchGrid grid(Point2<float>(-50.0, -50.0), Point2<float>(10.0, 10.0), 10, 10, 12.0);
+	std::vector<StreamingPatchRequest> requests;
+
+	grid.update(Point2<float>(5.0, 5.0), requests);
+
+	AssertHelper::assertUnsignedInt(requests.size(), 9); //view patch and its 8 neighbors
+	AssertHelper::assertUnsignedInt(requests[0].patchIndex, 55);
+	AssertHelper::assertUnsignedInt(requests[1].patchIndex, 45);
+	AssertHelper::assertUnsignedInt(requests[8].patchIndex, 66);
+	for(const auto &request : requests)
+	{
+		AssertHelper::assertTrue(grid.isSlotBuilding(request.slotIndex));
+		AssertHelper::assertInt(grid.getSlotPatch(request.slotIndex), static_cast<int>(request.patchIndex));
+	}
+}
+
+void StreamingPatchGridTest::residentPatchesNotRequested()
+{
+	StreamingPatchGrid grid(Point2<float>(0.0, 0.0), Point2<float>(10.0, 10.0), 100, 100, 20.0);
+	std::vector<StreamingPatchRequest> requests;
+	grid.update(Point2<float>(505.0, 505.0), requests);
+	AssertHelper::assertUnsignedInt(requests.size(), 21); //5x5 patches without corners
+	buildRequests(grid, requests);
+
+	grid.update(Point2<float>(505.0, 505.0), requests);
+	AssertHelper::assertUnsignedInt(requests.size(), 0);
+
+	grid.update(Point2<float>(515.0, 505.0), requests); //move to next patch on X
+	AssertHelper::assertUnsignedInt(requests.size(), 5);
+	for(const auto &request : requests)
+	{
+		AssertHelper::assertTrue(request.patchIndex % 100 >= 52);
+	}
+}
+
+void StreamingPatchGridTest::recycleSlotsOutOfDistance()
+{
+	StreamingPatchGrid grid(Point2<float>(0.0, 0.0), Point2<float>(10.0, 10.0), 100, 100, 20.0);
+	std::vector<StreamingPatchRequest> requests;
+	grid.update(Point2<float>(105.0, 105.0), requests);
+	std::vector<StreamingPatchRequest> firstRequests = requests;
+	buildRequests(grid, requests);
+
+	grid.update(Point2<float>(805.0, 805.0), requests); //far away: all slots recycled
+	AssertHelper::assertUnsignedInt(requests.size(), firstRequests.size());
+	for(unsigned int slotIndex=0; slotIndex<grid.getSlotsCount(); ++slotIndex)
+	{
+		AssertHelper::assertTrue(!grid.isSlotReady(slotIndex));
+	}
+
+	grid.update(Point2<float>(105.0, 105.0), requests); //patches in build: slots cannot be recycled yet
+	AssertHelper::assertUnsignedInt(requests.size(), grid.getSlotsCount() - firstRequests.size());
+}
+
+void StreamingPatchGridTest::buildRequests(StreamingPatchGrid &grid, const std::vector<StreamingPatchRequest> &requests)
+{
+	for(const auto &request : requests)
+	{
+		grid.onPatchBuilt(request.slotIndex);
+	}
+}
+
+CppUnit::Test *StreamingPatchGridTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("StreamingPatchGridTest");
+
+	suite->addTest(new CppUnit::TestCaller<StreamingPatchGridTest>("slotsBoundedByDistance", &StreamingPatchGridTest::slotsBoundedByDistance));
+	suite->addTest(new CppUnit::TestCaller<StreamingPatchGridTest>("nearestPatchesFirst", &StreamingPatchGridTest::nearestPatchesFirst));
+	suite->addTest(new CppUnit::TestCaller<StreamingPatchGridTest>("residentPatchesNotRequested", &StreamingPatchGridTest::residentPatchesNotRequested));
+	suite->addTest(new CppUnit::TestCaller<StreamingPatchGridTest>("recycleSlotsOutOfDistance", &StreamingPatchGridTest::recycleSlotsOutOfDistance));
+
+	return suite;
+}
@@ -0,0 +1,22 @@
+#ifndef URCHINENGINE_STREAMINGPATCHGRIDTEST_H
+#define URCHINENGINE_STREAMINGPATCHGRIDTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class StreamingPatchGridTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void slotsBoundedByDistance();
+		void nearestPatchesFirst();
+		void residentPatchesNotRequested();
+		void recycleSlotsOutOfDistance();
+
+	private:
+		void buildRequests(urchin::StreamingPatchGrid &, const std::vector<urchin::StreamingPatchRequest> &);
+};
+
+#endif
@@ -0,0 +1,100 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <stdexcept>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/TaskPoolTest.h"
+using namespace urchin;
+
+void TaskPoolTest::executeAllTasks()
+{
+	TaskPool taskPool(3);
+	std::vector<unsigned int> taskExecutions(200, 0);
+
+	std::vector<std::future<void>> futures;
+	for(unsigned int taskIndex=0; taskIndex<taskExecutions.size(); ++taskIndex)
+	{
+		futures.push_back(taskPool.submit([&taskExecutions, taskIndex]() {
+			taskExecutions[taskIndex]++;
+		}));
+	}
+	for(auto &future : futures)
+	{
+		future.get();
+	}
+
+	for(unsigned int taskExecution : taskExecutions)
+	{
+		AssertHelper::assertUnsignedInt(taskExecution, 1);
+	}
+}
+
+void TaskPoolTest::executeInSubmissionOrder()
+{
+	TaskPool taskPool(1);
+	std::vector<unsigned int> executionOrder;
+
+	std::future<void> lastFuture;
+	for(unsigned int taskIndex=0; taskIndex<20; ++taskIndex)
+	{
+		lastFuture = taskPool.submit([&executionOrder, taskIndex]() {
+			executionOrder.push_back(taskIndex);
+		});
+	}
+	lastFuture.get();
+
+	AssertHelper::assertUnsignedInt(static_cast<unsigned int>(executionOrder.size()), 20);
+	for(unsigned int i=0; i<executionOrder.size(); ++i)
+	{
+		AssertHelper::assertUnsignedInt(executionOrder[i], i);
+	}
+}
+
+void TaskPoolTest::rethrowTaskException()
+{
+	TaskPool taskPool(2);
+
+	std::future<void> failingFuture = taskPool.submit([]() {
+		throw std::runtime_error("task failure");
+	});
+	std::future<void> succeedingFuture = taskPool.submit([]() {});
+
+	try
+	{
+		failingFuture.get();
+		AssertHelper::assertTrue(false, "Exception expected");
+	}catch(const std::runtime_error &e)
+	{
+		AssertHelper::assertTrue(std::string(e.what())=="task failure");
+	}
+	succeedingFuture.get();
+}
+
+void TaskPoolTest::executeRemainingTasksOnDestruction()
+{
+	std::atomic<unsigned int> executedTasks(0);
+	{
+		TaskPool taskPool(1);
+		for(unsigned int taskIndex=0; taskIndex<50; ++taskIndex)
+		{
+			taskPool.submit([&executedTasks]() {
+				executedTasks++;
+			});
+		}
+	}
+
+	AssertHelper::assertUnsignedInt(executedTasks, 50);
+}
+
+CppUnit::Test *TaskPoolTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("TaskPoolTest");
+
+	suite->addTest(new CppUnit::TestCaller<TaskPoolTest>("executeAllTasks", &TaskPoolTest::executeAllTasks));
+	suite->addTest(new CppUnit::TestCaller<TaskPoolTest>("executeInSubmissionOrder", &TaskPoolTest::executeInSubmissionOrder));
+	suite->addTest(new CppUnit::TestCaller<TaskPoolTest>("rethrowTaskException", &TaskPoolTest::rethrowTaskException));
+	suite->addTest(new CppUnit::TestCaller<TaskPoolTest>("executeRemainingTasksOnDestruction", &TaskPoolTest::executeRemainingTasksOnDestruction));
+
+	return suite;
+}
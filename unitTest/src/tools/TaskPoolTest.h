@@ -0,0 +1,18 @@
+#ifndef URCHINENGINE_TASKPOOLTEST_H
+#define URCHINENGINE_TASKPOOLTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+
+class TaskPoolTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void executeAllTasks();
+		void executeInSubmissionOrder();
+		void rethrowTaskException();
+		void executeRemainingTasksOnDestruction();
+};
+
+#endif
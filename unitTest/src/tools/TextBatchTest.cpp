@@ -0,0 +1,140 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/TextBatchTest.h"
+using namespace urchin;
+
+void TextBatchTest::batchTexts()
+{
+	std::unique_ptr<GlyphRunCache> glyphRunCache = buildGlyphRunCache();
+	TextBatch textBatch;
+
+	textBatch.beginFrame();
+	textBatch.addGlyphRun(1, glyphRunCache->getGlyphRun("ab"), Point2<int>(100, 50));
+	textBatch.addGlyphRun(1, glyphRunCache->getGlyphRun("c"), Point2<int>(0, 0));
+	textBatch.addGlyphRun(2, glyphRunCache->getGlyphRun("de"), Point2<int>(0, 0));
+	textBatch.build();
+
+	AssertHelper::assertUnsignedInt(textBatch.getVerticesCount(), 5 * 6);
+	const std::vector<TextBatchDrawRange> &drawRanges = textBatch.getDrawRanges();
+	AssertHelper::assertUnsignedInt(drawRanges.size(), 2);
+	AssertHelper::assertUnsignedInt(drawRanges[0].textureId, 1);
+	AssertHelper::assertUnsignedInt(drawRanges[0].firstVertex, 0);
+	AssertHelper::assertUnsignedInt(drawRanges[0].verticesCount, 3 * 6);
+	AssertHelper::assertUnsignedInt(drawRanges[1].textureId, 2);
+	AssertHelper::assertUnsignedInt(drawRanges[1].firstVertex, 3 * 6);
+	AssertHelper::assertUnsignedInt(drawRanges[1].verticesCount, 2 * 6);
+
+	const std::vector<float> &vertices = textBatch.getVertices();
+	AssertHelper::assertFloatEquals(vertices[0], 100.0f); //first vertex translated to the text position
+	AssertHelper::assertFloatEquals(vertices[1], 50.0f);
+	AssertHelper::assertFloatEquals(vertices[2 * 4], 110.0f); //third vertex: bottom right corner of the first letter
+	AssertHelper::assertFloatEquals(vertices[2 * 4 + 1], 62.0f);
+}
+
+void TextBatchTest::splitDrawRangesBySegment()
+{
+	std::unique_ptr<GlyphRunCache> glyphRunCache = buildGlyphRunCache();
+	TextBatch textBatch;
+
+	textBatch.beginFrame();
+	unsigned int firstSegment = textBatch.beginSegment();
+	textBatch.addGlyphRun(1, glyphRunCache->getGlyphRun("ab"), Point2<int>(0, 0));
+	textBatch.addGlyphRun(1, glyphRunCache->getGlyphRun("c"), Point2<int>(0, 20));
+	unsigned int secondSegment = textBatch.beginSegment();
+	textBatch.addGlyphRun(1, glyphRunCache->getGlyphRun("de"), Point2<int>(0, 40));
+	textBatch.build();
+
+	const std::vector<TextBatchDrawRange> &drawRanges = textBatch.getDrawRanges();
+	AssertHelper::assertUnsignedInt(drawRanges.size(), 2);
+	AssertHelper::assertUnsignedInt(drawRanges[0].segment, firstSegment);
+	AssertHelper::assertUnsignedInt(drawRanges[0].verticesCount, 3 * 6);
+	AssertHelper::assertUnsignedInt(drawRanges[1].segment, secondSegment);
+	AssertHelper::assertUnsignedInt(drawRanges[1].firstVertex, 3 * 6);
+}
+
+void TextBatchTest::keepUnchangedTexts()
+{
+	std::unique_ptr<GlyphRunCache> glyphRunCache = buildGlyphRunCache();
+	std::vector<std::shared_ptr<const GlyphRun>> glyphRuns = {glyphRunCache->getGlyphRun("fps: 60"), glyphRunCache->getGlyphRun("speed: 10")};
+	TextBatch textBatch;
+
+	addTexts(textBatch, glyphRuns);
+	AssertHelper::assertUnsignedInt(textBatch.getTessellatedRunsCount(), 2);
+	AssertHelper::assertUnsignedInt(textBatch.getDirtyVerticesCount(), textBatch.getVerticesCount());
+
+	glyphRuns[0] = glyphRunCache->getGlyphRun("fps: 60"); //same text: cached glyph run
+	addTexts(textBatch, glyphRuns);
+	AssertHelper::assertUnsignedInt(textBatch.getTessellatedRunsCount(), 0);
+	AssertHelper::assertTrue(!textBatch.hasDirtyVertices());
+	AssertHelper::assertUnsignedInt(glyphRunCache->getLayoutsCount(), 2);
+}
+
+void TextBatchTest::tessellateChangedText()
+{
+	std::unique_ptr<GlyphRunCache> glyphRunCache = buildGlyphRunCache();
+	std::vector<std::shared_ptr<const GlyphRun>> glyphRuns = {glyphRunCache->getGlyphRun("title"), glyphRunCache->getGlyphRun("fps: 60"),
+			glyphRunCache->getGlyphRun("speed: 10")};
+	TextBatch textBatch;
+	addTexts(textBatch, glyphRuns);
+
+	glyphRuns[1] = glyphRunCache->getGlyphRun("fps: 59"); //same number of letters
+	addTexts(textBatch, glyphRuns);
+
+	AssertHelper::assertUnsignedInt(textBatch.getTessellatedRunsCount(), 1);
+	AssertHelper::assertUnsignedInt(textBatch.getFirstDirtyVertex(), 5 * 6);
+	AssertHelper::assertUnsignedInt(textBatch.getDirtyVerticesCount(), 7 * 6);
+}
+
+void TextBatchTest::tessellateShiftedTexts()
+{
+	std::unique_ptr<GlyphRunCache> glyphRunCache = buildGlyphRunCache();
+	std::vector<std::shared_ptr<const GlyphRun>> glyphRuns = {glyphRunCache->getGlyphRun("title"), glyphRunCache->getGlyphRun("fps: 60"),
+			glyphRunCache->getGlyphRun("speed: 10")};
+	TextBatch textBatch;
+	addTexts(textBatch, glyphRuns);
+
+	glyphRuns[1] = glyphRunCache->getGlyphRun("fps: 120"); //one more letter: next text moves in the vertex stream
+	addTexts(textBatch, glyphRuns);
+
+	AssertHelper::assertUnsignedInt(textBatch.getTessellatedRunsCount(), 2);
+	AssertHelper::assertUnsignedInt(textBatch.getFirstDirtyVertex(), 5 * 6);
+	AssertHelper::assertUnsignedInt(textBatch.getDirtyVerticesCount(), (8 + 9) * 6);
+	AssertHelper::assertUnsignedInt(textBatch.getVerticesCount(), (5 + 8 + 9) * 6);
+}
+
+void TextBatchTest::addTexts(TextBatch &textBatch, const std::vector<std::shared_ptr<const GlyphRun>> &glyphRuns)
+{
+	textBatch.beginFrame();
+	for(unsigned int i=0; i<glyphRuns.size(); ++i)
+	{
+		textBatch.addGlyphRun(1, glyphRuns[i], Point2<int>(0, static_cast<int>(i) * 20));
+	}
+	textBatch.build();
+}
+
+std::unique_ptr<GlyphRunCache> TextBatchTest::buildGlyphRunCache()
+{
+	FontMetrics fontMetrics;
+	fontMetrics.glyphs.resize(256, {10, 12, 0});
+	fontMetrics.spaceBetweenLetters = 2;
+	fontMetrics.spaceBetweenLines = 20;
+	fontMetrics.height = 12;
+	fontMetrics.atlasDimension = 256;
+	return std::make_unique<GlyphRunCache>(fontMetrics, 16);
+}
+
+CppUnit::Test *TextBatchTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("TextBatchTest");
+
+	suite->addTest(new CppUnit::TestCaller<TextBatchTest>("batchTexts", &TextBatchTest::batchTexts));
+	suite->addTest(new CppUnit::TestCaller<TextBatchTest>("splitDrawRangesBySegment", &TextBatchTest::splitDrawRangesBySegment));
+	suite->addTest(new CppUnit::TestCaller<TextBatchTest>("keepUnchangedTexts", &TextBatchTest::keepUnchangedTexts));
+	suite->addTest(new CppUnit::TestCaller<TextBatchTest>("tessellateChangedText", &TextBatchTest::tessellateChangedText));
+	suite->addTest(new CppUnit::TestCaller<TextBatchTest>("tessellateShiftedTexts", &TextBatchTest::tessellateShiftedTexts));
+
+	return suite;
+}
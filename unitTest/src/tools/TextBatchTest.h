@@ -0,0 +1,25 @@
+#ifndef URCHINENGINE_TEXTBATCHTEST_H
+#define URCHINENGINE_TEXTBATCHTEST_H
+
+#include <memory>
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+#include "UrchinCommon.h"
+
+class TextBatchTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void batchTexts();
+		void splitDrawRangesBySegment();
+		void keepUnchangedTexts();
+		void tessellateChangedText();
+		void tessellateShiftedTexts();
+
+	private:
+		void addTexts(urchin::TextBatch &, const std::vector<std::shared_ptr<const urchin::GlyphRun>> &);
+		std::unique_ptr<urchin::GlyphRunCache> buildGlyphRunCache();
+};
+
+#endif
@@ -0,0 +1,107 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <cstdio>
+#include <cstring>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/TextureBakerTest.h"
+using namespace urchin;
+
+#define CACHE_TEST_FILE "textureBakerTest.frl"
+#define MD5_TEST "0123456789abcdef0123456789abcdef"
+
+void TextureBakerTest::generateMipMaps()
+{
+	std::vector<unsigned char> texels = {
+			10, 20,  30, 40,  50, 60,  70, 80,
+			11, 21,  31, 41,  51, 61,  71, 255};
+
+	std::vector<std::vector<unsigned char>> mipMaps = MipMapGenerator().generate(4, 2, 2, texels);
+
+	AssertHelper::assertUnsignedInt(MipMapGenerator::computeLevelsCount(4, 2), 3);
+	AssertHelper::assertUnsignedInt(mipMaps.size(), 2);
+	AssertHelper::assertTrue(mipMaps[0]==std::vector<unsigned char>({21, 31, 61, 114}));
+	AssertHelper::assertTrue(mipMaps[1]==std::vector<unsigned char>({41, 73}));
+}
+
+void TextureBakerTest::generateMipMapsOddSize()
+{
+	std::vector<unsigned char> texels = {
+			0, 100, 200,
+			0, 100, 200,
+			40, 40, 40};
+
+	std::vector<std::vector<unsigned char>> mipMaps = MipMapGenerator().generate(3, 3, 1, texels);
+
+	AssertHelper::assertUnsignedInt(mipMaps.size(), 1);
+	AssertHelper::assertTrue(mipMaps[0]==std::vector<unsigned char>({50}));
+}
+
+void TextureBakerTest::bakeAllLevels()
+{
+	std::vector<unsigned char> texels(16 * 8 * 4, 128);
+
+	std::unique_ptr<BakedTexture> bakedTexture = TextureBaker().bake(BlockCompressor::BC3, 16, 8, 4, texels);
+
+	AssertHelper::assertUnsignedInt(bakedTexture->getLevelsCount(), 5);
+	AssertHelper::assertUnsignedInt(bakedTexture->getLevelWidth(2), 4);
+	AssertHelper::assertUnsignedInt(bakedTexture->getLevelHeight(2), 2);
+	AssertHelper::assertUnsignedInt(bakedTexture->getLevelSize(0), 4 * 2 * 16);
+	AssertHelper::assertUnsignedInt(bakedTexture->getLevelSize(4), 16);
+	AssertHelper::assertUnsignedInt(bakedTexture->getMemorySize(), (8 + 2 + 1 + 1 + 1) * 16);
+}
+
+void TextureBakerTest::loadBakedTextureFromCache()
+{
+	std::vector<unsigned char> texels;
+	for(unsigned int i=0; i<8*8; ++i)
+	{
+		texels.insert(texels.end(), {(unsigned char)(i*4), (unsigned char)(255 - i*2), (unsigned char)(i%8 * 30)});
+	}
+	std::string cacheFilePath = FileSystem::instance()->getResourcesDirectory() + CACHE_TEST_FILE;
+	TextureBaker textureBaker;
+	std::unique_ptr<BakedTexture> bakedTexture = textureBaker.bake(BlockCompressor::BC1, 8, 8, 3, texels);
+
+	textureBaker.writeBakedTexture(cacheFilePath, MD5_TEST, *bakedTexture);
+	std::unique_ptr<BakedTexture> cachedBakedTexture = textureBaker.loadBakedTexture(cacheFilePath, MD5_TEST, BlockCompressor::BC1);
+
+	AssertHelper::assertTrue(cachedBakedTexture!=nullptr);
+	AssertHelper::assertUnsignedInt(cachedBakedTexture->getWidth(), 8);
+	AssertHelper::assertUnsignedInt(cachedBakedTexture->getHeight(), 8);
+	AssertHelper::assertUnsignedInt(cachedBakedTexture->getLevelsCount(), bakedTexture->getLevelsCount());
+	for(unsigned int level=0; level<bakedTexture->getLevelsCount(); ++level)
+	{
+		AssertHelper::assertTrue(std::memcmp(cachedBakedTexture->getLevelData(level), bakedTexture->getLevelData(level), bakedTexture->getLevelSize(level))==0);
+	}
+
+	cachedBakedTexture.reset();
+	std::remove(cacheFilePath.c_str());
+}
+
+void TextureBakerTest::ignoreOutdatedCache()
+{
+	std::vector<unsigned char> texels(4 * 4 * 4, 200);
+	std::string cacheFilePath = FileSystem::instance()->getResourcesDirectory() + CACHE_TEST_FILE;
+	TextureBaker textureBaker;
+	textureBaker.writeBakedTexture(cacheFilePath, MD5_TEST, *textureBaker.bake(BlockCompressor::BC3, 4, 4, 4, texels));
+
+	AssertHelper::assertTrue(textureBaker.loadBakedTexture(cacheFilePath, "fedcba9876543210fedcba9876543210", BlockCompressor::BC3)==nullptr);
+	AssertHelper::assertTrue(textureBaker.loadBakedTexture(cacheFilePath, MD5_TEST, BlockCompressor::BC1)==nullptr);
+	AssertHelper::assertTrue(textureBaker.loadBakedTexture(cacheFilePath + ".missing", MD5_TEST, BlockCompressor::BC3)==nullptr);
+
+	std::remove(cacheFilePath.c_str());
+}
+
+CppUnit::Test *TextureBakerTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("TextureBakerTest");
+
+	suite->addTest(new CppUnit::TestCaller<TextureBakerTest>("generateMipMaps", &TextureBakerTest::generateMipMaps));
+	suite->addTest(new CppUnit::TestCaller<TextureBakerTest>("generateMipMapsOddSize", &TextureBakerTest::generateMipMapsOddSize));
+	suite->addTest(new CppUnit::TestCaller<TextureBakerTest>("bakeAllLevels", &TextureBakerTest::bakeAllLevels));
+	suite->addTest(new CppUnit::TestCaller<TextureBakerTest>("loadBakedTextureFromCache", &TextureBakerTest::loadBakedTextureFromCache));
+	suite->addTest(new CppUnit::TestCaller<TextureBakerTest>("ignoreOutdatedCache", &TextureBakerTest::ignoreOutdatedCache));
+
+	return suite;
+}
@@ -0,0 +1,19 @@
+#ifndef URCHINENGINE_TEXTUREBAKERTEST_H
+#define URCHINENGINE_TEXTUREBAKERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+
+class TextureBakerTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void generateMipMaps();
+		void generateMipMapsOddSize();
+		void bakeAllLevels();
+		void loadBakedTextureFromCache();
+		void ignoreOutdatedCache();
+};
+
+#endif
@@ -0,0 +1,157 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <fstream>
+#include <cstdio>
+#include <cstring>
+#include <iterator>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/XmlBinaryConverterTest.h"
+using namespace urchin;
+
+#define XML_TEST_FILE "xmlBinaryConverterTest.xml"
+#define BINARY_TEST_FILE "xmlBinaryConverterTest.bin"
+#define XML_CONVERTED_TEST_FILE "xmlBinaryConverterTestConverted.xml"
+
+void XmlBinaryConverterTest::readBinaryDocument()
+{
+	writeXmlFile();
+	std::string resourcesDirectory = FileSystem::instance()->getResourcesDirectory();
+	XmlBinaryConverter().xmlToBinary(resourcesDirectory + XML_TEST_FILE, resourcesDirectory + BINARY_TEST_FILE);
+
+	XmlBinaryDocument binaryDocument(resourcesDirectory + BINARY_TEST_FILE);
+	XmlParser xmlParser(binaryDocument);
+	std::shared_ptr<XmlChunk> objectsChunk = xmlParser.getUniqueChunk(true, "objects");
+	std::vector<std::shared_ptr<XmlChunk>> objectChunks = xmlParser.getChunks("object", XmlAttribute(), objectsChunk);
+	std::shared_ptr<XmlChunk> object2Chunk = xmlParser.getUniqueChunk(true, "object", XmlAttribute("name", "obj2"), objectsChunk);
+
+	AssertHelper::assertTrue(xmlParser.getRootChunk()->getAttributeValue("relativeWorkingDirectory")=="../");
+	AssertHelper::assertUnsignedInt(binaryDocument.getSectionCount(), 2);
+	AssertHelper::assertTrue(std::string(binaryDocument.getSectionName(0))=="objects");
+	AssertHelper::assertUnsignedInt(binaryDocument.getSectionRecordCount(0), 2);
+	AssertHelper::assertUnsignedInt(objectChunks.size(), 2);
+	AssertHelper::assertTrue(xmlParser.getUniqueChunk(true, "mesh", XmlAttribute(), objectChunks[0])->getStringValue()=="models/cube.urchinMesh");
+	AssertHelper::assertPoint3FloatEquals(xmlParser.getUniqueChunk(true, "position", XmlAttribute(), object2Chunk)->getPoint3Value(), Point3<float>(1.5f, -2.0f, 3.25f));
+	AssertHelper::assertFloatEquals(xmlParser.getUniqueChunk(true, "mass", XmlAttribute(), object2Chunk)->getFloatValue(), 0.5f);
+	AssertHelper::assertUnsignedInt(xmlParser.getUniqueChunk(true, "count", XmlAttribute(), object2Chunk)->getUnsignedIntValue(), 12);
+
+	std::vector<std::string> textValues;
+	xmlParser.getRootChunk()->getTextValues(textValues);
+	AssertHelper::assertUnsignedInt(textValues.size(), 4);
+	AssertHelper::assertTrue(textValues[0]=="models/cube.urchinMesh" && textValues[3]=="12");
+
+	removeFiles();
+}
+
+void XmlBinaryConverterTest::convertBackToXml()
+{
+	writeXmlFile();
+	std::string resourcesDirectory = FileSystem::instance()->getResourcesDirectory();
+	XmlBinaryConverter xmlBinaryConverter;
+	xmlBinaryConverter.xmlToBinary(resourcesDirectory + XML_TEST_FILE, resourcesDirectory + BINARY_TEST_FILE);
+	xmlBinaryConverter.binaryToXml(resourcesDirectory + BINARY_TEST_FILE, resourcesDirectory + XML_CONVERTED_TEST_FILE);
+
+	XmlParser xmlParser(XML_CONVERTED_TEST_FILE);
+	std::shared_ptr<XmlChunk> objectsChunk = xmlParser.getUniqueChunk(true, "objects");
+	std::shared_ptr<XmlChunk> object2Chunk = xmlParser.getUniqueChunk(true, "object", XmlAttribute("name", "obj2"), objectsChunk);
+
+	AssertHelper::assertTrue(xmlParser.getRootChunk()->getAttributeValue("relativeWorkingDirectory")=="../");
+	AssertHelper::assertUnsignedInt(xmlParser.getChunks("object", XmlAttribute(), objectsChunk).size(), 2);
+	AssertHelper::assertPoint3FloatEquals(xmlParser.getUniqueChunk(true, "position", XmlAttribute(), object2Chunk)->getPoint3Value(), Point3<float>(1.5f, -2.0f, 3.25f));
+	AssertHelper::assertTrue(xmlParser.getUniqueChunk(true, "lights").get()!=nullptr);
+
+	removeFiles();
+}
+
+void XmlBinaryConverterTest::rejectXmlFile()
+{
+	writeXmlFile();
+	std::string resourcesDirectory = FileSystem::instance()->getResourcesDirectory();
+
+	AssertHelper::assertTrue(!XmlBinaryDocument::isBinaryFile(resourcesDirectory + XML_TEST_FILE));
+	try
+	{
+		XmlBinaryDocument binaryDocument(resourcesDirectory + XML_TEST_FILE);
+		AssertHelper::assertTrue(false, "Exception expected on XML file");
+	}catch(const std::invalid_argument &)
+	{
+		//expected
+	}
+
+	removeFiles();
+}
+
+void XmlBinaryConverterTest::rejectCorruptedBinaryFile()
+{
+	writeXmlFile();
+	std::string resourcesDirectory = FileSystem::instance()->getResourcesDirectory();
+	XmlBinaryConverter().xmlToBinary(resourcesDirectory + XML_TEST_FILE, resourcesDirectory + BINARY_TEST_FILE);
+	std::string binaryContent = readBinaryFile();
+
+	std::string unterminatedStringContent(binaryContent);
+	unterminatedStringContent.back() = 'x'; //last string terminator
+	AssertHelper::assertTrue(isBinaryFileRejected(unterminatedStringContent));
+
+	std::string invalidChildContent(binaryContent);
+	unsigned int elementOffset;
+	std::memcpy(&elementOffset, &binaryContent[24], sizeof(elementOffset)); //header: magic, version, section count/offset, element count/offset
+	unsigned int invalidChild = 1000;
+	std::memcpy(&invalidChildContent[elementOffset + 2 * sizeof(unsigned int)], &invalidChild, sizeof(invalidChild)); //first child of root element
+	AssertHelper::assertTrue(isBinaryFileRejected(invalidChildContent));
+
+	removeFiles();
+}
+
+std::string XmlBinaryConverterTest::readBinaryFile() const
+{
+	std::ifstream file(FileSystem::instance()->getResourcesDirectory() + BINARY_TEST_FILE, std::ios::in | std::ios::binary);
+	return std::string((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+}
+
+bool XmlBinaryConverterTest::isBinaryFileRejected(const std::string &binaryContent) const
+{
+	std::string binaryFilenamePath = FileSystem::instance()->getResourcesDirectory() + BINARY_TEST_FILE;
+	std::ofstream(binaryFilenamePath, std::ios::out | std::ios::binary | std::ios::trunc) << binaryContent;
+	try
+	{
+		XmlBinaryDocument binaryDocument(binaryFilenamePath);
+		return false;
+	}catch(const std::invalid_argument &)
+	{
+		return true;
+	}
+}
+
+void XmlBinaryConverterTest::writeXmlFile() const
+{
+	std::ofstream(FileSystem::instance()->getResourcesDirectory() + XML_TEST_FILE) << "<?xml version=\"1.0\" ?>\n"
+			"<scene relativeWorkingDirectory=\"../\">\n"
+			"	<objects>\n"
+			"		<object name=\"obj1\"><mesh>models/cube.urchinMesh</mesh></object>\n"
+			"		<!-- comment -->\n"
+			"		<object name=\"obj2\"><position>1.5 -2.0 3.25</position><mass>0.5</mass><count>12</count></object>\n"
+			"	</objects>\n"
+			"	<lights/>\n"
+			"</scene>\n";
+}
+
+void XmlBinaryConverterTest::removeFiles() const
+{
+	std::string resourcesDirectory = FileSystem::instance()->getResourcesDirectory();
+	std::remove((resourcesDirectory + XML_TEST_FILE).c_str());
+	std::remove((resourcesDirectory + BINARY_TEST_FILE).c_str());
+	std::remove((resourcesDirectory + XML_CONVERTED_TEST_FILE).c_str());
+}
+
+CppUnit::Test *XmlBinaryConverterTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("XmlBinaryConverterTest");
+
+	suite->addTest(new CppUnit::TestCaller<XmlBinaryConverterTest>("readBinaryDocument", &XmlBinaryConverterTest::readBinaryDocument));
+	suite->addTest(new CppUnit::TestCaller<XmlBinaryConverterTest>("convertBackToXml", &XmlBinaryConverterTest::convertBackToXml));
+	suite->addTest(new CppUnit::TestCaller<XmlBinaryConverterTest>("rejectXmlFile", &XmlBinaryConverterTest::rejectXmlFile));
+	suite->addTest(new CppUnit::TestCaller<XmlBinaryConverterTest>("rejectCorruptedBinaryFile", &XmlBinaryConverterTest::rejectCorruptedBinaryFile));
+
+	return suite;
+}
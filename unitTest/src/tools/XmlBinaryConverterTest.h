@@ -0,0 +1,25 @@
+#ifndef URCHINENGINE_XMLBINARYCONVERTERTEST_H
+#define URCHINENGINE_XMLBINARYCONVERTERTEST_H
+
+#include <string>
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+
+class XmlBinaryConverterTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void readBinaryDocument();
+		void convertBackToXml();
+		void rejectXmlFile();
+		void rejectCorruptedBinaryFile();
+
+	private:
+		void writeXmlFile() const;
+		std::string readBinaryFile() const;
+		bool isBinaryFileRejected(const std::string &) const;
+		void removeFiles() const;
+};
+
+#endif
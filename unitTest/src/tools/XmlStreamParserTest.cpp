@@ -0,0 +1,147 @@
+#include <cppunit/TestSuite.h>
+#include <cppunit/TestCaller.h>
+#include <fstream>
+#include <cstdio>
+#include "UrchinCommon.h"
+
+#include "AssertHelper.h"
+#include "tools/XmlStreamParserTest.h"
+using namespace urchin;
+
+#define XML_TEST_FILE "xmlStreamParserTest.xml"
+
+void XmlStreamParserTest::readElements()
+{
+	writeXmlFile("<?xml version=\"1.0\" ?>\n<!-- comment with <tag> -->\n<root><a><b/></a><c>text</c></root>");
+	XmlStreamParser streamParser(XML_TEST_FILE);
+
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::START_ELEMENT && streamParser.getName()=="root");
+	AssertHelper::assertUnsignedInt(streamParser.getDepth(), 1);
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::START_ELEMENT && streamParser.getName()=="a");
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::START_ELEMENT && streamParser.getName()=="b");
+	AssertHelper::assertUnsignedInt(streamParser.getDepth(), 3);
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::END_ELEMENT);
+	AssertHelper::assertUnsignedInt(streamParser.getDepth(), 3);
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::END_ELEMENT);
+	AssertHelper::assertUnsignedInt(streamParser.getDepth(), 2);
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::START_ELEMENT && streamParser.getName()=="c");
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::END_ELEMENT);
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::END_ELEMENT);
+	AssertHelper::assertUnsignedInt(streamParser.getDepth(), 1);
+	AssertHelper::assertTrue(streamParser.next()==XmlStreamParser::END_DOCUMENT);
+
+	removeXmlFile();
+}
+
+void XmlStreamParserTest::readAttributes()
+{
+	writeXmlFile("<root first=\"a &amp; b\" second='1 > 0'/>");
+	XmlStreamParser streamParser(XML_TEST_FILE);
+
+	AssertHelper::assertTrue(streamParser.nextChildElement(0));
+	AssertHelper::assertTrue(streamParser.getAttributeValue("first")=="a & b");
+	AssertHelper::assertTrue(streamParser.getAttributeValue("second")=="1 > 0");
+	AssertHelper::assertTrue(streamParser.getAttributeValue("third").empty());
+
+	removeXmlFile();
+}
+
+void XmlStreamParserTest::readChunks()
+{
+	writeXmlFile("<root><objects><object name=\"obj1\"><value>1</value></object><object name=\"obj2\"><value>2</value></object></objects></root>");
+	XmlStreamParser streamParser(XML_TEST_FILE);
+
+	AssertHelper::assertTrue(streamParser.nextChildElement(0));
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="objects");
+	unsigned int nbObjects = 0;
+	while(streamParser.nextChildElement(2))
+	{
+		std::shared_ptr<XmlChunk> objectChunk = streamParser.readChunk();
+		std::shared_ptr<XmlChunk> valueChunk = streamParser.getChunkParser().getUniqueChunk(true, "value", XmlAttribute(), objectChunk);
+
+		nbObjects++;
+		AssertHelper::assertTrue(objectChunk->getAttributeValue("name")=="obj" + std::to_string(nbObjects));
+		AssertHelper::assertUnsignedInt(valueChunk->getUnsignedIntValue(), nbObjects);
+
+		std::vector<std::string> textValues;
+		objectChunk->getTextValues(textValues);
+		AssertHelper::assertUnsignedInt(textValues.size(), 1);
+		AssertHelper::assertTrue(textValues[0]==std::to_string(nbObjects));
+	}
+
+	AssertHelper::assertUnsignedInt(nbObjects, 2);
+	AssertHelper::assertTrue(!streamParser.nextChildElement(0));
+
+	removeXmlFile();
+}
+
+void XmlStreamParserTest::skipUnreadChildren()
+{
+	writeXmlFile("<root><a><a1><a2/></a1></a><b><b1/></b><c/></root>");
+	XmlStreamParser streamParser(XML_TEST_FILE);
+
+	AssertHelper::assertTrue(streamParser.nextChildElement(0));
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="a");
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="b");
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="c");
+	AssertHelper::assertTrue(!streamParser.nextChildElement(1));
+
+	removeXmlFile();
+}
+
+void XmlStreamParserTest::skipRepeatedEndSequenceCharacters()
+{
+	writeXmlFile("<root><!-- comment ---><a/><![CDATA[x]]]]><b/><!><c/></root>");
+	XmlStreamParser streamParser(XML_TEST_FILE);
+
+	AssertHelper::assertTrue(streamParser.nextChildElement(0));
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="a");
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="b");
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="c");
+	AssertHelper::assertTrue(!streamParser.nextChildElement(1));
+
+	removeXmlFile();
+}
+
+void XmlStreamParserTest::rejectTruncatedFile()
+{
+	writeXmlFile("<root><a/><!-- comment -");
+	XmlStreamParser streamParser(XML_TEST_FILE);
+
+	AssertHelper::assertTrue(streamParser.nextChildElement(0));
+	AssertHelper::assertTrue(streamParser.nextChildElement(1) && streamParser.getName()=="a");
+	try
+	{
+		streamParser.nextChildElement(1);
+		AssertHelper::assertTrue(false, "Exception expected on truncated file");
+	}catch(const std::invalid_argument &)
+	{
+		//expected
+	}
+
+	removeXmlFile();
+}
+
+void XmlStreamParserTest::writeXmlFile(const std::string &content) const
+{
+	std::ofstream(FileSystem::instance()->getResourcesDirectory() + XML_TEST_FILE) << content;
+}
+
+void XmlStreamParserTest::removeXmlFile() const
+{
+	std::remove((FileSystem::instance()->getResourcesDirectory() + XML_TEST_FILE).c_str());
+}
+
+CppUnit::Test *XmlStreamParserTest::suite()
+{
+	CppUnit::TestSuite *suite = new CppUnit::TestSuite("XmlStreamParserTest");
+
+	suite->addTest(new CppUnit::TestCaller<XmlStreamParserTest>("readElements", &XmlStreamParserTest::readElements));
+	suite->addTest(new CppUnit::TestCaller<XmlStreamParserTest>("readAttributes", &XmlStreamParserTest::readAttributes));
+	suite->addTest(new CppUnit::TestCaller<XmlStreamParserTest>("readChunks", &XmlStreamParserTest::readChunks));
+	suite->addTest(new CppUnit::TestCaller<XmlStreamParserTest>("skipUnreadChildren", &XmlStreamParserTest::skipUnreadChildren));
+	suite->addTest(new CppUnit::TestCaller<XmlStreamParserTest>("skipRepeatedEndSequenceCharacters", &XmlStreamParserTest::skipRepeatedEndSequenceCharacters));
+	suite->addTest(new CppUnit::TestCaller<XmlStreamParserTest>("rejectTruncatedFile", &XmlStreamParserTest::rejectTruncatedFile));
+
+	return suite;
+}
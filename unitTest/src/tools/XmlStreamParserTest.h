@@ -0,0 +1,24 @@
+#ifndef URCHINENGINE_XMLSTREAMPARSERTEST_H
+#define URCHINENGINE_XMLSTREAMPARSERTEST_H
+
+#include <cppunit/TestFixture.h>
+#include <cppunit/Test.h>
+
+class XmlStreamParserTest : public CppUnit::TestFixture
+{
+	public:
+		static CppUnit::Test *suite();
+
+		void readElements();
+		void readAttributes();
+		void readChunks();
+		void skipUnreadChildren();
+		void skipRepeatedEndSequenceCharacters();
+		void rejectTruncatedFile();
+
+	private:
+		void writeXmlFile(const std::string &) const;
+		void removeXmlFile() const;
+};
+
+#endif